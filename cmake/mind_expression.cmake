@@ -26,6 +26,11 @@ if (MS_BUILD_GRPC)
     include(${CMAKE_SOURCE_DIR}/cmake/external_libs/libevent.cmake)
 endif()
 
+# The e2e dump and TFReaderOp compress with zlib, gRPC already brings it in
+if (NOT MS_BUILD_GRPC)
+    include(${CMAKE_SOURCE_DIR}/cmake/external_libs/zlib.cmake)
+endif()
+
 include(${CMAKE_SOURCE_DIR}/cmake/external_libs/pybind11.cmake)
 MESSAGE("go to link flatbuffers")
 include(${CMAKE_SOURCE_DIR}/cmake/external_libs/flatbuffers.cmake)
@@ -90,6 +90,15 @@ install(
         COMPONENT mindspore
 )
 
+file(GLOB_RECURSE ZLIB_LIB_LIST
+    ${zlib_LIBPATH}/libz.so*
+)
+install(
+    FILES ${ZLIB_LIB_LIST}
+    DESTINATION ${INSTALL_LIB_DIR}
+    COMPONENT mindspore
+)
+
 if (ENABLE_MINDDATA)
     install(
         TARGETS _c_dataengine _c_mindrecord
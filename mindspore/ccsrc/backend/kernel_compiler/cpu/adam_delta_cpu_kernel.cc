@@ -14,7 +14,6 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/adam_delta_cpu_kernel.h"
-#include <thread>
 #include <vector>
 #include <string>
 #include <memory>
@@ -24,7 +23,6 @@
 namespace mindspore {
 namespace kernel {
 constexpr size_t kAdamDeltaInputSize = 9;
-constexpr size_t kUsedThreadNum = 23;
 namespace {
 struct ComputeParam {
   float *delta_{nullptr};
@@ -135,39 +133,18 @@ bool AdamDeltaCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   auto grad = reinterpret_cast<float *>(inputs[8]->addr);
   auto delta = reinterpret_cast<float *>(outputs[0]->addr);
   lr = lr * std::sqrt(1 - beta2_power) / (1 - beta1_power);
-  size_t thread_num = kUsedThreadNum;
-  if (elem_num_ < thread_num) {
-    thread_num = elem_num_;
-  }
-  std::vector<std::thread> threads;
-  std::vector<std::shared_ptr<ComputeParam>> thread_params;
-  threads.reserve(thread_num);
-
-  size_t end = 0;
-  size_t offset = elem_num_ / thread_num;
-  size_t left = elem_num_ % thread_num;
-  for (size_t i = 0; i < thread_num; ++i) {
-    auto params = std::make_shared<ComputeParam>();
-    params->delta_ = delta;
-    params->m_ = m;
-    params->v_ = v;
-    params->grad_ = grad;
-    params->beta1_ = beta1;
-    params->beta2_ = beta2;
-    params->use_nesterov_ = use_nesterov_;
-    params->lr_ = lr;
-    params->epsilon_ = epsilon;
-    size_t start = end;
-    end = start + offset;
-    if (i < left) {
-      end += 1;
-    }
-    threads.emplace_back(std::thread(ComputeWeightDelta, params, start, end));
-    thread_params.emplace_back(params);
-  }
-  for (size_t i = 0; i < thread_num; ++i) {
-    threads[i].join();
-  }
+  auto params = std::make_shared<ComputeParam>();
+  params->delta_ = delta;
+  params->m_ = m;
+  params->v_ = v;
+  params->grad_ = grad;
+  params->beta1_ = beta1;
+  params->beta2_ = beta2;
+  params->use_nesterov_ = use_nesterov_;
+  params->lr_ = lr;
+  params->epsilon_ = epsilon;
+  auto task = [params](size_t start, size_t end) { ComputeWeightDelta(params, start, end); };
+  CPUKernelUtils::ParallelFor(task, elem_num_);
   return true;
 }
 }  // namespace kernel
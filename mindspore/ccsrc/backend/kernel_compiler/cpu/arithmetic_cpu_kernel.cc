@@ -13,9 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cmath>
 #include <string>
-#include <thread>
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -23,66 +23,42 @@ namespace mindspore {
 namespace kernel {
 template <typename T>
 void ArithmeticCPUKernel::AssignAdd(T *input1, const T *input2, T *out, size_t start, size_t end) {
+  broadcast_iterator_.Run(input1, input2, out, start, end, [](T x, T y) { return x + y; });
   for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] + input2[i];
     input1[i] = out[i];
   }
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Add(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] + input2[i];
-  }
+  broadcast_iterator_.Run(input1, input2, out, start, end, [](T x, T y) { return x + y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Sub(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] - input2[idx[1]];
-  }
+  broadcast_iterator_.Run(input1, input2, out, start, end, [](T x, T y) { return x - y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Mul(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] * input2[i];
-  }
+  broadcast_iterator_.Run(input1, input2, out, start, end, [](T x, T y) { return x * y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::RealDiv(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto div_number = input2[idx[1]];
-    if (div_number == 0) {
-      MS_LOG(EXCEPTION) << "Cannot divided by 0!";
-    }
-    out[i] = input1[idx[0]] / div_number;
-  }
+  broadcast_iterator_.Run(input1, input2, out, start, end, [](T x, T y) { return x / y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Pow(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto x = static_cast<double>(input1[idx[0]]);
-    auto y = static_cast<double>(input2[idx[1]]);
-    out[i] = static_cast<T>(std::pow(x, y));
-  }
+  broadcast_iterator_.Run(input1, input2, out, start, end, [](T x, T y) {
+    return static_cast<T>(std::pow(static_cast<double>(x), static_cast<double>(y)));
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Less(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] < input2[idx[1]];
-  }
+  broadcast_iterator_.Run(input1, input2, out, start, end, [](T x, T y) { return x < y; });
 }
 
 void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -112,17 +88,7 @@ void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (output_shape_.size() == 0) {
     output_shape_.insert(output_shape_.begin(), 1);
   }
-  size_t l = input_shape0_.size();
-  for (size_t i = 0; i < output_shape_.size() - l; ++i) {
-    input_shape0_.insert(input_shape0_.begin(), 1);
-  }
-  l = input_shape1_.size();
-  for (size_t i = 0; i < output_shape_.size() - l; ++i) {
-    input_shape1_.insert(input_shape1_.begin(), 1);
-  }
-  CPUKernelUtils::GetElementNumEveryDim(input_shape0_, &input_element_num0_);
-  CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
-  CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_iterator_ = BroadcastIterator(input_shape0_, input_shape1_, output_shape_);
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
@@ -132,10 +98,12 @@ void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                  const std::vector<kernel::AddressPtr> & /*workspace*/,
                                  const std::vector<kernel::AddressPtr> &outputs) {
-  if (dtype_ == kNumberTypeInt32 || dtype_ == kNumberTypeInt16) {
+  if (dtype_ == kNumberTypeInt32) {
     LaunchKernel<int>(inputs, outputs);
-  } else if (dtype_ == kNumberTypeFloat32 || dtype_ == kNumberTypeFloat16 || dtype_ == kNumberTypeFloat64) {
+  } else if (dtype_ == kNumberTypeFloat32) {
     LaunchKernel<float>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat64) {
+    LaunchKernel<double>(inputs, outputs);
   } else if (dtype_ == kNumberTypeInt64) {
     LaunchKernel<int64_t>(inputs, outputs);
   } else {
@@ -144,35 +112,13 @@ bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   return true;
 }
 
-void ArithmeticCPUKernel::GenIndex(size_t num, std::vector<size_t> *idx) {
-  std::vector<size_t> tmp;
-  for (size_t i = 0; i < output_shape_.size() - 1; ++i) {
-    if (output_element_num_[i] > num) {
-      tmp.push_back(0);
-    } else {
-      tmp.push_back(num / output_element_num_[i]);
-      num %= output_element_num_[i];
-    }
-  }
-  tmp.push_back(num);
-  size_t idx0 = 0;
-  size_t idx1 = 0;
-  for (size_t k = 0; k < tmp.size() - 1; ++k) {
-    if (input_shape0_[k] > 1) {
-      idx0 += tmp[k] * input_element_num0_[k];
-    }
-    if (input_shape1_[k] > 1) {
-      idx1 += tmp[k] * input_element_num1_[k];
-    }
-  }
-  if (input_shape0_[tmp.size() - 1] > 1) {
-    idx0 += tmp[tmp.size() - 1];
-  }
-  if (input_shape1_[tmp.size() - 1] > 1) {
-    idx1 += tmp[tmp.size() - 1];
+template <typename T>
+void ArithmeticCPUKernel::CheckDivisor(const std::vector<AddressPtr> &inputs) {
+  const T *input2 = reinterpret_cast<T *>(inputs[1]->addr);
+  size_t lens = inputs[1]->size / sizeof(T);
+  if (std::find(input2, input2 + lens, static_cast<T>(0)) != input2 + lens) {
+    MS_LOG(EXCEPTION) << "Cannot divided by 0!";
   }
-  idx->push_back(idx0);
-  idx->push_back(idx1);
 }
 
 template <typename T>
@@ -182,29 +128,8 @@ void ArithmeticCPUKernel::LaunchLess(const std::vector<AddressPtr> &inputs, cons
   bool *output = reinterpret_cast<bool *>(outputs[0]->addr);
 
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(bool)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    threads.emplace_back(std::thread(&ArithmeticCPUKernel::Less<T>, this, input1, input2, output, start, end));
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  auto task = [this, input1, input2, output](size_t start, size_t end) { Less<T>(input1, input2, output, start, end); };
+  CPUKernelUtils::ParallelFor(task, lens);
 }
 
 template <typename T>
@@ -218,43 +143,28 @@ void ArithmeticCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, co
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
 
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(T)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == ADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Add<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == SUB) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Sub<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == MUL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Mul<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == REALDIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::RealDiv<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == POW) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Pow<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == ASSIGNADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::AssignAdd<T>, this, input1, input2, output, start, end));
-    } else {
-      MS_LOG(EXCEPTION) << "Not support " << operate_type_;
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  CTask task;
+  if (operate_type_ == ADD) {
+    task = [this, input1, input2, output](size_t start, size_t end) { Add<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == SUB) {
+    task = [this, input1, input2, output](size_t start, size_t end) { Sub<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == MUL) {
+    task = [this, input1, input2, output](size_t start, size_t end) { Mul<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == REALDIV) {
+    CheckDivisor<T>(inputs);
+    task = [this, input1, input2, output](size_t start, size_t end) {
+      RealDiv<T>(input1, input2, output, start, end);
+    };
+  } else if (operate_type_ == POW) {
+    task = [this, input1, input2, output](size_t start, size_t end) { Pow<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == ASSIGNADD) {
+    task = [this, input1, input2, output](size_t start, size_t end) {
+      AssignAdd<T>(input1, input2, output, start, end);
+    };
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << operate_type_;
   }
+  CPUKernelUtils::ParallelFor(task, lens);
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -37,7 +37,8 @@ class ArithmeticCPUKernel : public CPUKernel {
   void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
 
  private:
-  void GenIndex(size_t num, std::vector<size_t> *tmp);
+  template <typename T>
+  void CheckDivisor(const std::vector<AddressPtr> &inputs);
   template <typename T>
   void Sub(const T *input1, const T *input2, T *out, size_t start, size_t end);
   template <typename T>
@@ -54,10 +55,8 @@ class ArithmeticCPUKernel : public CPUKernel {
   void Less(const T *input1, const T *input2, bool *out, size_t start, size_t end);
   std::vector<size_t> input_shape0_;
   std::vector<size_t> input_shape1_;
-  std::vector<size_t> input_element_num0_;
-  std::vector<size_t> input_element_num1_;
   std::vector<size_t> output_shape_;
-  std::vector<size_t> output_element_num_;
+  BroadcastIterator broadcast_iterator_;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
 };
@@ -99,6 +98,21 @@ MS_REG_CPU_KERNEL(
 MS_REG_CPU_KERNEL(
   Less, KernelAttr().AddInputAttr(kNumberTypeInt64).AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeBool),
   ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  Sub,
+  KernelAttr().AddInputAttr(kNumberTypeFloat64).AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeFloat64),
+  ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  Pow,
+  KernelAttr().AddInputAttr(kNumberTypeFloat64).AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeFloat64),
+  ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  RealDiv,
+  KernelAttr().AddInputAttr(kNumberTypeFloat64).AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeFloat64),
+  ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  Less, KernelAttr().AddInputAttr(kNumberTypeFloat64).AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeBool),
+  ArithmeticCPUKernel);
 MS_REG_CPU_KERNEL(
   AssignAdd, KernelAttr().AddInputAttr(kNumberTypeInt32).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
   ArithmeticCPUKernel);
@@ -79,5 +79,77 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   }
   std::reverse(element_num->begin(), element_num->end());
 }
+
+void CPUKernelUtils::ParallelFor(const CTask &task, size_t count, size_t grain) {
+  CPUThreadPool::GetInstance().ParallelFor(count, grain, task);
+}
+
+BroadcastIterator::BroadcastIterator(std::vector<size_t> input_shape_a, std::vector<size_t> input_shape_b,
+                                     std::vector<size_t> output_shape) {
+  size_t ndim = output_shape.size();
+  if (input_shape_a.size() > ndim || input_shape_b.size() > ndim) {
+    MS_LOG(EXCEPTION) << "Input rank " << input_shape_a.size() << " and " << input_shape_b.size()
+                      << " can not be broadcast to output rank " << ndim;
+  }
+  (void)input_shape_a.insert(input_shape_a.begin(), ndim - input_shape_a.size(), 1);
+  (void)input_shape_b.insert(input_shape_b.begin(), ndim - input_shape_b.size(), 1);
+  // Keep the non trivial output dims, each one tagged with whether input a and b walk along it.
+  std::vector<size_t> dims;
+  std::vector<bool> along_a;
+  std::vector<bool> along_b;
+  for (size_t i = 0; i < ndim; ++i) {
+    if ((input_shape_a[i] != output_shape[i] && input_shape_a[i] != 1) ||
+        (input_shape_b[i] != output_shape[i] && input_shape_b[i] != 1)) {
+      MS_LOG(EXCEPTION) << "Dim " << i << " of input shape " << input_shape_a[i] << " and " << input_shape_b[i]
+                        << " can not be broadcast to " << output_shape[i];
+    }
+    if (output_shape[i] == 1) {
+      continue;
+    }
+    bool walk_a = input_shape_a[i] != 1;
+    bool walk_b = input_shape_b[i] != 1;
+    if (!dims.empty() && along_a.back() == walk_a && along_b.back() == walk_b) {
+      dims.back() *= output_shape[i];
+      continue;
+    }
+    dims.push_back(output_shape[i]);
+    along_a.push_back(walk_a);
+    along_b.push_back(walk_b);
+  }
+  if (dims.empty()) {
+    mode_ = kSameShape;
+    return;
+  }
+  if (dims.size() == 1) {
+    if (along_a[0] && along_b[0]) {
+      mode_ = kSameShape;
+      return;
+    }
+    if (!along_a[0] && along_b[0]) {
+      mode_ = kScalarA;
+      return;
+    }
+    if (along_a[0] && !along_b[0]) {
+      mode_ = kScalarB;
+      return;
+    }
+  }
+  mode_ = kGeneral;
+  shape_ = dims;
+  strides_a_.resize(dims.size(), 0);
+  strides_b_.resize(dims.size(), 0);
+  size_t stride_a = 1;
+  size_t stride_b = 1;
+  for (size_t i = dims.size(); i > 0; --i) {
+    if (along_a[i - 1]) {
+      strides_a_[i - 1] = stride_a;
+      stride_a *= dims[i - 1];
+    }
+    if (along_b[i - 1]) {
+      strides_b_[i - 1] = stride_b;
+      stride_b *= dims[i - 1];
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -15,12 +15,14 @@
  */
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
 #include "backend/kernel_compiler/kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "ir/anf.h"
 
@@ -101,6 +103,110 @@ class CPUKernelUtils {
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  static void ParallelFor(const CTask &task, size_t count, size_t grain = kDefaultGrainSize);
+};
+
+// Walks the output of a broadcast binary op with strides computed once. Output dims of size 1 are dropped and
+// neighbouring dims that broadcast the same way are merged, so the innermost loop reads each input either
+// contiguously or as a single repeated value and can be vectorized by the compiler.
+class BroadcastIterator {
+ public:
+  BroadcastIterator() = default;
+  BroadcastIterator(std::vector<size_t> input_shape_a, std::vector<size_t> input_shape_b,
+                    std::vector<size_t> output_shape);
+  ~BroadcastIterator() = default;
+
+  // Compute out[i] = op(a, b) for the output positions in [start, end).
+  template <typename T, typename S, typename Op>
+  void Run(const T *input_a, const T *input_b, S *output, size_t start, size_t end, const Op &op) const {
+    if (mode_ == kSameShape) {
+      InnerLoop(input_a + start, input_b + start, output + start, end - start, 1, 1, op);
+      return;
+    }
+    if (mode_ == kScalarA) {
+      InnerLoop(input_a, input_b + start, output + start, end - start, 0, 1, op);
+      return;
+    }
+    if (mode_ == kScalarB) {
+      InnerLoop(input_a + start, input_b, output + start, end - start, 1, 0, op);
+      return;
+    }
+    size_t ndim = shape_.size();
+    std::vector<size_t> index(ndim, 0);
+    size_t pos_a = 0;
+    size_t pos_b = 0;
+    size_t remain = start;
+    for (size_t i = ndim; i > 0; --i) {
+      index[i - 1] = remain % shape_[i - 1];
+      remain /= shape_[i - 1];
+      pos_a += index[i - 1] * strides_a_[i - 1];
+      pos_b += index[i - 1] * strides_b_[i - 1];
+    }
+    size_t last = ndim - 1;
+    size_t inner_size = shape_[last];
+    size_t inner_stride_a = strides_a_[last];
+    size_t inner_stride_b = strides_b_[last];
+    size_t pos = start;
+    while (pos < end) {
+      size_t num = std::min(inner_size - index[last], end - pos);
+      InnerLoop(input_a + pos_a, input_b + pos_b, output + pos, num, inner_stride_a, inner_stride_b, op);
+      pos += num;
+      index[last] += num;
+      pos_a += num * inner_stride_a;
+      pos_b += num * inner_stride_b;
+      if (index[last] < inner_size) {
+        break;
+      }
+      index[last] = 0;
+      pos_a -= inner_size * inner_stride_a;
+      pos_b -= inner_size * inner_stride_b;
+      for (size_t i = last; i > 0; --i) {
+        size_t dim = i - 1;
+        index[dim]++;
+        pos_a += strides_a_[dim];
+        pos_b += strides_b_[dim];
+        if (index[dim] < shape_[dim]) {
+          break;
+        }
+        pos_a -= shape_[dim] * strides_a_[dim];
+        pos_b -= shape_[dim] * strides_b_[dim];
+        index[dim] = 0;
+      }
+    }
+  }
+
+ private:
+  enum BroadcastMode { kSameShape, kScalarA, kScalarB, kGeneral };
+
+  template <typename T, typename S, typename Op>
+  static void InnerLoop(const T *input_a, const T *input_b, S *output, size_t num, size_t stride_a, size_t stride_b,
+                        const Op &op) {
+    if (stride_a == 1 && stride_b == 1) {
+      for (size_t i = 0; i < num; ++i) {
+        output[i] = op(input_a[i], input_b[i]);
+      }
+    } else if (stride_a == 1) {
+      const T value_b = input_b[0];
+      for (size_t i = 0; i < num; ++i) {
+        output[i] = op(input_a[i], value_b);
+      }
+    } else if (stride_b == 1) {
+      const T value_a = input_a[0];
+      for (size_t i = 0; i < num; ++i) {
+        output[i] = op(value_a, input_b[i]);
+      }
+    } else {
+      const S value = op(input_a[0], input_b[0]);
+      for (size_t i = 0; i < num; ++i) {
+        output[i] = value;
+      }
+    }
+  }
+
+  BroadcastMode mode_{kSameShape};
+  std::vector<size_t> shape_;
+  std::vector<size_t> strides_a_;
+  std::vector<size_t> strides_b_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <algorithm>
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kChunksPerThread = 4;
+thread_local bool in_parallel_task = false;
+
+void BindCore(size_t core_id) {
+#ifdef __linux__
+  auto core_num = std::thread::hardware_concurrency();
+  if (core_num == 0) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(core_id % core_num, &cpu_set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+    MS_LOG(WARNING) << "Bind cpu thread pool worker to core " << core_id << " failed.";
+  }
+#endif
+}
+}  // namespace
+
+CPUThreadPool &CPUThreadPool::GetInstance() {
+  static CPUThreadPool instance;
+  return instance;
+}
+
+CPUThreadPool::~CPUThreadPool() { StopWorkers(); }
+
+void CPUThreadPool::StartWorkers(size_t worker_num) {
+  exit_ = false;
+  bind_core_ = common::GetEnv("MS_CPU_BIND_CORE") == "1";
+  workers_.reserve(worker_num);
+  for (size_t i = 0; i < worker_num; ++i) {
+    workers_.emplace_back(&CPUThreadPool::WorkerLoop, this, i, generation_);
+  }
+  MS_LOG(INFO) << "Cpu thread pool started " << worker_num << " workers, bind core: " << bind_core_;
+}
+
+void CPUThreadPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exit_ = true;
+  }
+  task_cond_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+void CPUThreadPool::SetThreadNum(size_t thread_num) {
+  std::lock_guard<std::mutex> launch_lock(launch_mutex_);
+  config_thread_num_ = thread_num;
+  // An explicit setting wins until the context value is changed again.
+  auto context = MsContext::GetInstance();
+  if (context != nullptr) {
+    context_thread_num_ = context->get_param<uint32_t>(MS_CTX_CPU_THREAD_NUM);
+  }
+  StopWorkers();
+}
+
+void CPUThreadPool::SyncThreadNum() {
+  auto context = MsContext::GetInstance();
+  if (context != nullptr) {
+    auto context_thread_num = context->get_param<uint32_t>(MS_CTX_CPU_THREAD_NUM);
+    if (context_thread_num != context_thread_num_) {
+      context_thread_num_ = context_thread_num;
+      config_thread_num_ = context_thread_num;
+      StopWorkers();
+    }
+  }
+  size_t thread_num = config_thread_num_ == 0 ? std::thread::hardware_concurrency() : config_thread_num_;
+  thread_num = std::max(thread_num, static_cast<size_t>(1));
+  if (workers_.size() + 1 != thread_num) {
+    StopWorkers();
+    StartWorkers(thread_num - 1);
+  }
+}
+
+void CPUThreadPool::WorkerLoop(size_t worker_id, uint64_t generation) {
+  in_parallel_task = true;
+  if (bind_core_) {
+    // The launching thread keeps core 0 of its own schedule, workers take the following ones.
+    BindCore(worker_id + 1);
+  }
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this, generation] { return exit_ || generation_ != generation; });
+      if (exit_) {
+        return;
+      }
+      generation = generation_;
+      if (task_ == nullptr) {
+        continue;
+      }
+      ++active_workers_;
+    }
+    RunChunks();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --active_workers_;
+    }
+    done_cond_.notify_all();
+  }
+}
+
+void CPUThreadPool::RunChunks() {
+  while (true) {
+    size_t chunk = next_chunk_.fetch_add(1);
+    if (chunk >= chunk_num_) {
+      return;
+    }
+    size_t start = chunk * chunk_size_;
+    size_t end = std::min(start + chunk_size_, count_);
+    try {
+      (*task_)(start, end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (exception_ == nullptr) {
+        exception_ = std::current_exception();
+      }
+    }
+    if (finished_chunk_.fetch_add(1) + 1 == chunk_num_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_cond_.notify_all();
+    }
+  }
+}
+
+void CPUThreadPool::ParallelFor(size_t count, size_t grain, const CTask &task) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max(grain, static_cast<size_t>(1));
+  size_t max_chunk_num = (count + grain - 1) / grain;
+  if (in_parallel_task || max_chunk_num <= 1) {
+    task(0, count);
+    return;
+  }
+  std::unique_lock<std::mutex> launch_lock(launch_mutex_, std::try_to_lock);
+  if (!launch_lock.owns_lock()) {
+    task(0, count);
+    return;
+  }
+  SyncThreadNum();
+  size_t chunk_num = std::min(max_chunk_num, GetThreadNum() * kChunksPerThread);
+  if (workers_.empty() || chunk_num <= 1) {
+    task(0, count);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    chunk_size_ = (count + chunk_num - 1) / chunk_num;
+    chunk_num_ = (count + chunk_size_ - 1) / chunk_size_;
+    next_chunk_ = 0;
+    finished_chunk_ = 0;
+    exception_ = nullptr;
+    ++generation_;
+  }
+  task_cond_.notify_all();
+  in_parallel_task = true;
+  RunChunks();
+  in_parallel_task = false;
+  std::exception_ptr exception = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cond_.wait(lock, [this] { return finished_chunk_ == chunk_num_ && active_workers_ == 0; });
+    task_ = nullptr;
+    std::swap(exception, exception_);
+  }
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
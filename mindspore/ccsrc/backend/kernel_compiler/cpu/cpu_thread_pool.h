@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_THREAD_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+using CTask = std::function<void(size_t start, size_t end)>;
+constexpr size_t kDefaultGrainSize = 128;
+
+// Persistent intra-op thread pool shared by all cpu kernels. The calling thread always takes part in the work,
+// so a pool of n threads keeps n - 1 workers alive between launches.
+class CPUThreadPool {
+ public:
+  ~CPUThreadPool();
+  CPUThreadPool(const CPUThreadPool &) = delete;
+  CPUThreadPool &operator=(const CPUThreadPool &) = delete;
+
+  static CPUThreadPool &GetInstance();
+  // Split [0, count) into chunks of at least grain elements and run task on them in parallel. Nested calls from a
+  // task, and calls made while another launch is in flight, run serially on the calling thread.
+  void ParallelFor(size_t count, size_t grain, const CTask &task);
+  // Total number of threads including the caller, 0 means the number of hardware threads.
+  void SetThreadNum(size_t thread_num);
+  size_t GetThreadNum() const { return workers_.size() + 1; }
+
+ private:
+  CPUThreadPool() = default;
+  void SyncThreadNum();
+  void StartWorkers(size_t worker_num);
+  void StopWorkers();
+  void WorkerLoop(size_t worker_id, uint64_t generation);
+  void RunChunks();
+
+  std::mutex launch_mutex_;
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable done_cond_;
+  std::vector<std::thread> workers_;
+  bool exit_{false};
+  bool bind_core_{false};
+  size_t config_thread_num_{0};
+  uint32_t context_thread_num_{UINT32_MAX};
+  uint64_t generation_{0};
+  size_t active_workers_{0};
+  const CTask *task_{nullptr};
+  size_t count_{0};
+  size_t chunk_size_{0};
+  size_t chunk_num_{0};
+  std::atomic<size_t> next_chunk_{0};
+  std::atomic<size_t> finished_chunk_{0};
+  std::exception_ptr exception_{nullptr};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_THREAD_POOL_H_
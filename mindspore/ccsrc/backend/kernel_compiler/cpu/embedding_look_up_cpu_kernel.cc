@@ -13,7 +13,6 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <thread>
 #include <string>
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
@@ -92,32 +91,24 @@ void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
   auto indices_addr = reinterpret_cast<T *>(inputs[1]->addr);
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  const size_t kMaxThreadNum = 16;
-  size_t thread_num = indices_lens_ / 10000 + 1;
-  thread_num = thread_num > kMaxThreadNum ? kMaxThreadNum : thread_num;
-  std::thread threads[kMaxThreadNum];
-  size_t task_proc_lens = (indices_lens_ + thread_num - 1) / thread_num;
-  size_t i;
-  size_t task_offset = 0;
-  MS_LOG(DEBUG) << "indices_lens_: " << indices_lens_ << " one task proc lens:" << task_proc_lens;
-  for (i = 0; i < thread_num; i++) {
-    if (task_offset >= indices_lens_) {
-      break;
-    }
-    MS_LOG(DEBUG) << "task_offset: " << task_offset << " task_proc_lenss:" << task_proc_lens;
-    threads[i] = std::thread(LookUpTableTask<T>, input_addr, indices_addr + task_offset,
-                             output_addr + task_offset * outer_dim_size_, task_proc_lens, outer_dim_size_, offset_,
-                             first_dim_size_);
-    task_offset += task_proc_lens;
-    if (task_offset + task_proc_lens > indices_lens_) {
-      task_proc_lens = indices_lens_ - task_offset;
-    }
-  }
-  for (size_t j = 0; j < i; j++) {
-    threads[j].join();
-  }
+  LookUpRows<T>(input_addr, indices_addr, output_addr, indices_lens_);
 }
 
+template <typename T>
+void EmbeddingLookUpCPUKernel::LookUpRows(const float *input_addr, const T *indices_addr, float *output_addr,
+                                          size_t indices_lens) const {
+  auto task = [this, input_addr, indices_addr, output_addr](size_t start, size_t end) {
+    LookUpTableTask<T>(input_addr, indices_addr + start, output_addr + start * outer_dim_size_, end - start,
+                       outer_dim_size_, offset_, first_dim_size_);
+  };
+  CPUKernelUtils::ParallelFor(task, indices_lens);
+}
+
+template void EmbeddingLookUpCPUKernel::LookUpRows<int>(const float *input_addr, const int *indices_addr,
+                                                        float *output_addr, size_t indices_lens) const;
+template void EmbeddingLookUpCPUKernel::LookUpRows<int64_t>(const float *input_addr, const int64_t *indices_addr,
+                                                            float *output_addr, size_t indices_lens) const;
+
 bool EmbeddingLookUpCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                       const std::vector<kernel::AddressPtr> & /*workspace*/,
                                       const std::vector<kernel::AddressPtr> &outputs) {
@@ -36,6 +36,9 @@ class EmbeddingLookUpCPUKernel : public CPUKernel {
 
  protected:
   void CheckParam(const CNodePtr &kernel_node);
+  // Reads only members set at init, so concurrent calls with different indices are safe.
+  template <typename T>
+  void LookUpRows(const float *input_addr, const T *indices_addr, float *output_addr, size_t indices_lens) const;
   int64_t offset_{0};
   size_t indices_lens_{1};
   size_t first_dim_size_{1};
@@ -72,6 +72,10 @@ bool EmbeddingLookUpPSKernel::Execute(const std::vector<AddressPtr> &inputs, con
   return Launch(inputs, workspace, outputs);
 }
 
+void EmbeddingLookUpPSKernel::LookUp(const float *table, const int *ids, size_t ids_num, float *output) const {
+  LookUpRows<int>(table, ids, output, ids_num);
+}
+
 const std::vector<size_t> &EmbeddingLookUpPSKernel::input_sizes() const { return input_shape_; }
 
 const std::vector<size_t> &EmbeddingLookUpPSKernel::output_sizes() const { return GetOutputSizeList(); }
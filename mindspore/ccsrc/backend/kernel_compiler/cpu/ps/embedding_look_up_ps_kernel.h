@@ -36,6 +36,12 @@ class EmbeddingLookUpPSKernel : public EmbeddingLookUpCPUKernel, public PServerK
   bool Execute(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
                const std::vector<AddressPtr> &outputs) override;
 
+  // Look up the rows of ids in table without going through ReInit, so lookups on one table can run concurrently.
+  void LookUp(const float *table, const int *ids, size_t ids_num, float *output) const;
+  size_t outer_dim_size() const { return outer_dim_size_; }
+  // First row of the table that this server holds
+  int64_t offset() const { return offset_; }
+
   const std::vector<size_t> &input_sizes() const override;
   const std::vector<size_t> &output_sizes() const override;
   const std::vector<size_t> &workspace_sizes() const override;
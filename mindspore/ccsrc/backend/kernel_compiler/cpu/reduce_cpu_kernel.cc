@@ -16,6 +16,7 @@
 
 #include <string>
 #include <vector>
+#include <limits>
 #include <algorithm>
 #include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
@@ -25,7 +26,92 @@ namespace kernel {
 const size_t kReduceTypeMax = 0;
 const size_t kReduceTypeMean = 1;
 const size_t kReduceTypeSum = 2;
-const size_t kMaxDim = 100;
+const size_t kReduceTypeMin = 3;
+const size_t kReduceTypeProd = 4;
+const size_t kReduceTypeAll = 5;
+const size_t kReduceTypeAny = 6;
+// Elements of input each parallel chunk should at least cover.
+const size_t kReduceGrainSize = 16384;
+// Number of independent accumulators used on a contiguous run, which breaks the dependency chain of the reduction.
+const size_t kReduceUnrollSize = 8;
+
+namespace {
+// float16 is accumulated in float, other types in themselves.
+template <typename T>
+struct ReduceAccType {
+  using type = T;
+};
+template <>
+struct ReduceAccType<float16> {
+  using type = float;
+};
+
+template <typename A>
+struct ReduceSumOp {
+  static A Init() { return static_cast<A>(0); }
+  A operator()(A x, A y) const { return x + y; }
+};
+
+template <typename A>
+struct ReduceMaxOp {
+  static A Init() { return std::numeric_limits<A>::lowest(); }
+  A operator()(A x, A y) const { return x > y ? x : y; }
+};
+
+template <typename A>
+struct ReduceMinOp {
+  static A Init() { return std::numeric_limits<A>::max(); }
+  A operator()(A x, A y) const { return x < y ? x : y; }
+};
+
+template <typename A>
+struct ReduceProdOp {
+  static A Init() { return static_cast<A>(1); }
+  A operator()(A x, A y) const { return x * y; }
+};
+
+struct ReduceAllOp {
+  static bool Init() { return true; }
+  bool operator()(bool x, bool y) const { return x && y; }
+};
+
+struct ReduceAnyOp {
+  static bool Init() { return false; }
+  bool operator()(bool x, bool y) const { return x || y; }
+};
+
+template <typename T, typename A, typename Op>
+A ReduceContiguous(const T *input, size_t num) {
+  Op op;
+  A partial[kReduceUnrollSize];
+  for (size_t j = 0; j < kReduceUnrollSize; ++j) {
+    partial[j] = Op::Init();
+  }
+  size_t i = 0;
+  for (; i + kReduceUnrollSize <= num; i += kReduceUnrollSize) {
+    for (size_t j = 0; j < kReduceUnrollSize; ++j) {
+      partial[j] = op(partial[j], static_cast<A>(input[i + j]));
+    }
+  }
+  A acc = Op::Init();
+  for (size_t j = 0; j < kReduceUnrollSize; ++j) {
+    acc = op(acc, partial[j]);
+  }
+  for (; i < num; ++i) {
+    acc = op(acc, static_cast<A>(input[i]));
+  }
+  return acc;
+}
+
+template <typename T, typename A>
+T ReduceFinalize(A acc, bool is_mean, size_t num) {
+  if (is_mean) {
+    return static_cast<T>(acc / static_cast<A>(num));
+  }
+  return static_cast<T>(acc);
+}
+}  // namespace
+
 void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
@@ -35,9 +121,18 @@ void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     reduce_type_ = kReduceTypeMean;
   } else if (kernel_name == "ReduceSum") {
     reduce_type_ = kReduceTypeSum;
+  } else if (kernel_name == "ReduceMin") {
+    reduce_type_ = kReduceTypeMin;
+  } else if (kernel_name == "ReduceProd") {
+    reduce_type_ = kReduceTypeProd;
+  } else if (kernel_name == "ReduceAll") {
+    reduce_type_ = kReduceTypeAll;
+  } else if (kernel_name == "ReduceAny") {
+    reduce_type_ = kReduceTypeAny;
   } else {
     MS_LOG(EXCEPTION) << "Array reduce kernel type " << kernel_name << " is not supported.";
   }
+  dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   CheckAxis(kernel_node);
   if (shape_.empty()) {
@@ -56,36 +151,234 @@ void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     MS_LOG(EXCEPTION) << "stride_ must greater than zero.";
   }
   left_dims_ = left_dims_ / stride_;
+  SimplifyShape();
 }
+
 bool ReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspaces*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
-  size_t out_float_size = left_dims_ * sizeof(float);
-  size_t in_float_size = stride_ * out_float_size;
-  if (inputs[0]->size != in_float_size || outputs[0]->size != out_float_size) {
+  if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat32) {
+    LaunchKernel<float>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat64) {
+    LaunchKernel<double>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeInt32) {
+    LaunchKernel<int>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeInt64) {
+    LaunchKernel<int64_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeBool) {
+    LaunchLogicalKernel(inputs, outputs);
+  } else {
+    MS_LOG(EXCEPTION) << "Reduce kernel data type " << TypeIdLabel(dtype_) << " is not supported.";
+  }
+  return true;
+}
+
+template <typename T>
+void ReduceCPUKernel::CheckDataSize(const std::vector<AddressPtr> &inputs,
+                                    const std::vector<AddressPtr> &outputs) const {
+  size_t out_size = left_dims_ * sizeof(T);
+  size_t in_size = stride_ * out_size;
+  if (inputs[0]->size != in_size || outputs[0]->size != out_size) {
     MS_LOG(EXCEPTION) << "invalid input or output data size!";
   }
-  auto input = reinterpret_cast<float *>(inputs[0]->addr);
-  auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  int size = inputs[0]->size / sizeof(float);
-  std::vector<float> new_input(IntToSize(size), 0.0);
-  std::vector<size_t> transpose_axis;
-  for (size_t i = 0; i < shape_.size(); ++i) {
-    bool insert = true;
-    for (size_t j = 0; j < axis_.size(); ++j) {
-      if (axis_[j] == i) {
-        insert = false;
+}
+
+template <typename T>
+void ReduceCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
+  using A = typename ReduceAccType<T>::type;
+  CheckDataSize<T>(inputs, outputs);
+  auto input = reinterpret_cast<T *>(inputs[0]->addr);
+  auto output = reinterpret_cast<T *>(outputs[0]->addr);
+  if (reduce_type_ == kReduceTypeMax) {
+    Reduce<T, A, ReduceMaxOp<A>>(input, output, false);
+  } else if (reduce_type_ == kReduceTypeMin) {
+    Reduce<T, A, ReduceMinOp<A>>(input, output, false);
+  } else if (reduce_type_ == kReduceTypeSum) {
+    Reduce<T, A, ReduceSumOp<A>>(input, output, false);
+  } else if (reduce_type_ == kReduceTypeMean) {
+    Reduce<T, A, ReduceSumOp<A>>(input, output, true);
+  } else if (reduce_type_ == kReduceTypeProd) {
+    Reduce<T, A, ReduceProdOp<A>>(input, output, false);
+  } else {
+    MS_LOG(EXCEPTION) << "ReduceAll and ReduceAny only support bool input.";
+  }
+}
+
+void ReduceCPUKernel::LaunchLogicalKernel(const std::vector<AddressPtr> &inputs,
+                                          const std::vector<AddressPtr> &outputs) {
+  CheckDataSize<bool>(inputs, outputs);
+  auto input = reinterpret_cast<bool *>(inputs[0]->addr);
+  auto output = reinterpret_cast<bool *>(outputs[0]->addr);
+  if (reduce_type_ == kReduceTypeAll) {
+    Reduce<bool, bool, ReduceAllOp>(input, output, false);
+  } else if (reduce_type_ == kReduceTypeAny) {
+    Reduce<bool, bool, ReduceAnyOp>(input, output, false);
+  } else {
+    MS_LOG(EXCEPTION) << "Bool input only supports ReduceAll and ReduceAny.";
+  }
+}
+
+template <typename T, typename A, typename Op>
+void ReduceCPUKernel::Reduce(const T *input, T *output, bool is_mean) const {
+  if (inner_reduced_ && kept_shape_.empty() && reduced_shape_.empty() && inner_size_ > kReduceGrainSize) {
+    ReduceFull<T, A, Op>(input, output, is_mean);
+    return;
+  }
+  size_t grain = std::max<size_t>(1, kReduceGrainSize / stride_);
+  if (inner_reduced_) {
+    CPUKernelUtils::ParallelFor(
+      [this, input, output, is_mean](size_t start, size_t end) {
+        ReduceInnerAxis<T, A, Op>(input, output, is_mean, start, end);
+      },
+      left_dims_, grain);
+  } else {
+    CPUKernelUtils::ParallelFor(
+      [this, input, output, is_mean](size_t start, size_t end) {
+        ReduceOuterAxis<T, A, Op>(input, output, is_mean, start, end);
+      },
+      left_dims_, grain);
+  }
+}
+
+template <typename T, typename A, typename Op>
+void ReduceCPUKernel::ReduceInnerAxis(const T *input, T *output, bool is_mean, size_t start, size_t end) const {
+  Op op;
+  for (size_t i = start; i < end; ++i) {
+    const T *base = input + KeptOffset(i);
+    A acc = Op::Init();
+    ForEachReducedOffset(
+      [&acc, &op, base, this](size_t offset) { acc = op(acc, ReduceContiguous<T, A, Op>(base + offset, inner_size_)); });
+    output[i] = ReduceFinalize<T, A>(acc, is_mean, stride_);
+  }
+}
+
+template <typename T, typename A, typename Op>
+void ReduceCPUKernel::ReduceOuterAxis(const T *input, T *output, bool is_mean, size_t start, size_t end) const {
+  Op op;
+  std::vector<A> acc(std::min(inner_size_, end - start));
+  size_t i = start;
+  while (i < end) {
+    size_t row = i / inner_size_;
+    size_t col = i % inner_size_;
+    size_t num = std::min(inner_size_ - col, end - i);
+    const T *base = input + KeptOffset(row) + col;
+    std::fill(acc.begin(), acc.begin() + num, Op::Init());
+    ForEachReducedOffset([&acc, &op, base, num](size_t offset) {
+      const T *in = base + offset;
+      for (size_t k = 0; k < num; ++k) {
+        acc[k] = op(acc[k], static_cast<A>(in[k]));
+      }
+    });
+    for (size_t k = 0; k < num; ++k) {
+      output[i + k] = ReduceFinalize<T, A>(acc[k], is_mean, stride_);
+    }
+    i += num;
+  }
+}
+
+template <typename T, typename A, typename Op>
+void ReduceCPUKernel::ReduceFull(const T *input, T *output, bool is_mean) const {
+  size_t block_num = (inner_size_ + kReduceGrainSize - 1) / kReduceGrainSize;
+  std::vector<A> partial(block_num, Op::Init());
+  CPUKernelUtils::ParallelFor(
+    [this, input, &partial](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        size_t offset = i * kReduceGrainSize;
+        partial[i] = ReduceContiguous<T, A, Op>(input + offset, std::min(kReduceGrainSize, inner_size_ - offset));
+      }
+    },
+    block_num, 1);
+  Op op;
+  A acc = Op::Init();
+  for (auto value : partial) {
+    acc = op(acc, value);
+  }
+  output[0] = ReduceFinalize<T, A>(acc, is_mean, stride_);
+}
+
+template <typename Func>
+void ReduceCPUKernel::ForEachReducedOffset(const Func &func) const {
+  size_t dims = reduced_shape_.size();
+  if (dims == 0) {
+    func(0);
+    return;
+  }
+  std::vector<size_t> index(dims, 0);
+  size_t offset = 0;
+  while (true) {
+    func(offset);
+    size_t dim = dims;
+    while (true) {
+      --dim;
+      offset += reduced_strides_[dim];
+      if (++index[dim] < reduced_shape_[dim]) {
         break;
       }
+      offset -= reduced_strides_[dim] * reduced_shape_[dim];
+      index[dim] = 0;
+      if (dim == 0) {
+        return;
+      }
+    }
+  }
+}
+
+size_t ReduceCPUKernel::KeptOffset(size_t index) const {
+  size_t offset = 0;
+  for (size_t i = kept_shape_.size(); i > 0; --i) {
+    offset += (index % kept_shape_[i - 1]) * kept_strides_[i - 1];
+    index /= kept_shape_[i - 1];
+  }
+  return offset;
+}
+
+void ReduceCPUKernel::SimplifyShape() {
+  std::vector<bool> reduced(shape_.size(), false);
+  for (auto axis : axis_) {
+    reduced[axis] = true;
+  }
+  // Collapsed dims from the innermost outwards, size-1 dims are dropped and neighbouring dims that are both
+  // reduced or both kept are merged, since they are walked as a single contiguous dim.
+  std::vector<size_t> sizes;
+  std::vector<size_t> strides;
+  std::vector<bool> flags;
+  size_t stride = 1;
+  for (size_t i = shape_.size(); i > 0; --i) {
+    size_t dim = shape_[i - 1];
+    if (dim == 1) {
+      continue;
     }
-    if (insert) {
-      transpose_axis.push_back(i);
+    if (!flags.empty() && flags.back() == reduced[i - 1]) {
+      sizes.back() *= dim;
+    } else {
+      sizes.push_back(dim);
+      strides.push_back(stride);
+      flags.push_back(reduced[i - 1]);
+    }
+    stride *= dim;
+  }
+  kept_shape_.clear();
+  kept_strides_.clear();
+  reduced_shape_.clear();
+  reduced_strides_.clear();
+  if (sizes.empty()) {
+    inner_size_ = 1;
+    inner_reduced_ = false;
+    return;
+  }
+  inner_size_ = sizes[0];
+  inner_reduced_ = flags[0];
+  for (size_t i = sizes.size() - 1; i > 0; --i) {
+    if (flags[i]) {
+      reduced_shape_.push_back(sizes[i]);
+      reduced_strides_.push_back(strides[i]);
+    } else {
+      kept_shape_.push_back(sizes[i]);
+      kept_strides_.push_back(strides[i]);
     }
   }
-  (void)transpose_axis.insert(transpose_axis.end(), axis_.begin(), axis_.end());
-  Transpose(size, input, shape_, transpose_axis, SizeToInt(shape_.size()), &new_input[0]);
-  ConvertDataToOutput(&new_input[0], output);
-  return true;
 }
 
 void ReduceCPUKernel::CheckAxis(const CNodePtr &kernel_node) {
@@ -124,57 +417,8 @@ void ReduceCPUKernel::CheckAxis(const CNodePtr &kernel_node) {
   } else {
     MS_LOG(EXCEPTION) << "Attribute axis type is invalid.";
   }
-}
-
-void ReduceCPUKernel::ConvertDataToOutput(const float *new_input, float *output) {
-  if (reduce_type_ == kReduceTypeMax) {
-    for (size_t i = 0; i < left_dims_; ++i) {
-      float value = new_input[i * stride_];
-      for (size_t k = 0; k < stride_; ++k) {
-        if (value < new_input[i * stride_ + k]) {
-          value = new_input[i * stride_ + k];
-        }
-      }
-      output[i] = value;
-    }
-  } else {
-    for (size_t i = 0; i < left_dims_; ++i) {
-      float value = 0.0;
-      for (size_t k = 0; k < stride_; ++k) {
-        value += new_input[i * stride_ + k];
-      }
-      if (reduce_type_ == kReduceTypeMean) {
-        output[i] = value / stride_;
-      } else {
-        output[i] = value;
-      }
-    }
-  }
-}
-void ReduceCPUKernel::Transpose(const int size, const float *input, const std::vector<size_t> &input_shape,
-                                const std::vector<size_t> &input_axis, const int shape_size, float *output) {
-  int pos_array[kMaxDim];
-  int size_offset[kMaxDim];
-  size_offset[0] = size / SizeToInt(input_shape[0]);
-  for (int i = 1; i < shape_size; i++) {
-    size_offset[i] = size_offset[i - 1] / SizeToInt(input_shape[i]);
-  }
-  for (int position = 0; position < size; position += 1) {
-    int temp_position = position;
-    pos_array[0] = temp_position / size_offset[0];
-    for (int i = 1; i < shape_size; i++) {
-      temp_position -= pos_array[i - 1] * size_offset[i - 1];
-      pos_array[i] = temp_position / size_offset[i];
-    }
-    int new_position = pos_array[SizeToInt(input_axis[shape_size - 1])];
-    int new_position_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      new_position_size *= SizeToInt(input_shape[SizeToInt(input_axis[j + 1])]);
-      new_position += pos_array[SizeToInt(input_axis[j])] * new_position_size;
-    }
-    output[new_position] = input[position];
-  }
-  return;
+  std::sort(axis_.begin(), axis_.end());
+  axis_.erase(std::unique(axis_.begin(), axis_.end()), axis_.end());
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -32,22 +32,57 @@ class ReduceCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  void Transpose(const int size, const float *input, const std::vector<size_t> &input_shape,
-                 const std::vector<size_t> &input_axis, const int shape_size, float *output);
-  void ConvertDataToOutput(const float *input, float *output);
+  template <typename T>
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  void LaunchLogicalKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  template <typename T>
+  void CheckDataSize(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) const;
+  template <typename T, typename A, typename Op>
+  void Reduce(const T *input, T *output, bool is_mean) const;
+  template <typename T, typename A, typename Op>
+  void ReduceInnerAxis(const T *input, T *output, bool is_mean, size_t start, size_t end) const;
+  template <typename T, typename A, typename Op>
+  void ReduceOuterAxis(const T *input, T *output, bool is_mean, size_t start, size_t end) const;
+  template <typename T, typename A, typename Op>
+  void ReduceFull(const T *input, T *output, bool is_mean) const;
+  template <typename Func>
+  void ForEachReducedOffset(const Func &func) const;
+  size_t KeptOffset(size_t index) const;
   void CheckAxis(const CNodePtr &kernel_node);
+  void SimplifyShape();
   size_t reduce_type_ = 0;
+  TypeId dtype_{kTypeUnknown};
   std::vector<size_t> axis_;
   std::vector<size_t> shape_;
   size_t left_dims_ = 1;
   size_t stride_ = 1;
+  // The input viewed as collapsed dims: the innermost dim is contiguous and either reduced or kept, the others
+  // are split into kept dims walked by the output and reduced dims walked for every output element.
+  size_t inner_size_ = 1;
+  bool inner_reduced_ = false;
+  std::vector<size_t> kept_shape_;
+  std::vector<size_t> kept_strides_;
+  std::vector<size_t> reduced_shape_;
+  std::vector<size_t> reduced_strides_;
 };
-MS_REG_CPU_KERNEL(ReduceMean, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
-                  ReduceCPUKernel);
-MS_REG_CPU_KERNEL(ReduceMax, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
-                  ReduceCPUKernel);
-MS_REG_CPU_KERNEL(ReduceSum, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
-                  ReduceCPUKernel);
+
+#define MS_REG_CPU_REDUCE_KERNEL(OPNAME, T) \
+  MS_REG_CPU_KERNEL(OPNAME, KernelAttr().AddInputAttr(T).AddOutputAttr(T), ReduceCPUKernel);
+
+#define MS_REG_CPU_REDUCE_NUMBER_KERNEL(OPNAME)           \
+  MS_REG_CPU_REDUCE_KERNEL(OPNAME, kNumberTypeFloat16) \
+  MS_REG_CPU_REDUCE_KERNEL(OPNAME, kNumberTypeFloat32) \
+  MS_REG_CPU_REDUCE_KERNEL(OPNAME, kNumberTypeFloat64) \
+  MS_REG_CPU_REDUCE_KERNEL(OPNAME, kNumberTypeInt32)   \
+  MS_REG_CPU_REDUCE_KERNEL(OPNAME, kNumberTypeInt64)
+
+MS_REG_CPU_REDUCE_NUMBER_KERNEL(ReduceMean);
+MS_REG_CPU_REDUCE_NUMBER_KERNEL(ReduceMax);
+MS_REG_CPU_REDUCE_NUMBER_KERNEL(ReduceSum);
+MS_REG_CPU_REDUCE_NUMBER_KERNEL(ReduceMin);
+MS_REG_CPU_REDUCE_NUMBER_KERNEL(ReduceProd);
+MS_REG_CPU_REDUCE_KERNEL(ReduceAll, kNumberTypeBool);
+MS_REG_CPU_REDUCE_KERNEL(ReduceAny, kNumberTypeBool);
 }  // namespace kernel
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_CPU_KERNEL_H_
@@ -191,6 +191,10 @@ void SparseApplyAdamCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
   input_params.lr_ = lr;
   input_params.epsilon_ = epsilon;
   MultiThreadCompute<T>(ComputeWeight<T>, &input_params, total_dim_size);
+  // Every row decays, a delta checkpoint has to save these in full
+  for (auto param : std::vector<const void *>{var, m, v}) {
+    checkpoint::DirtyRowTracker::GetInstance().MarkAll(param);
+  }
 }
 
 bool SparseApplyAdamCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -151,6 +151,7 @@ void SparseApplyProximalAdagradCPUKernel::LaunchKernel(const std::vector<kernel:
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
   MultiThreadCompute<T>(ComputeProximalAdagrad<T>, &input_params, unique_sparse_grad.indices_size_);
+  MarkChangedRows<T>({var, accum}, var_first_dim_size_, unique_sparse_grad);
 }
 
 bool SparseApplyProximalAdagradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
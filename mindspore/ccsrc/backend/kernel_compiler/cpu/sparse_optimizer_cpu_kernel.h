@@ -18,12 +18,12 @@
 
 #include <vector>
 #include <memory>
-#include <thread>
 #include <unordered_map>
 #include <algorithm>
 #include <utility>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "utils/checkpoint/dirty_row_tracker.h"
 
 namespace mindspore {
 namespace kernel {
@@ -120,18 +120,17 @@ class SparseOptimizerCPUKernel : public CPUKernel {
   template <typename T>
   void MultiThreadCompute(const MultiThreadComputeFunc<T> &func, MultiThreadComputeParams<T> *params,
                           size_t total_compute_size) const {
-    const size_t kThreadNum = 24;
-    std::vector<std::thread> threads;
-    threads.reserve(kThreadNum);
-    size_t start = 0;
-    size_t once_compute_size = (total_compute_size + kThreadNum - 1) / kThreadNum;
-    while (start < total_compute_size) {
-      size_t end = (start + once_compute_size) > total_compute_size ? total_compute_size : (start + once_compute_size);
-      threads.emplace_back(std::thread(func, params, start, end));
-      start += once_compute_size;
-    }
-    for (size_t i = 0; i < threads.size(); ++i) {
-      threads[i].join();
+    auto task = [&func, params](size_t start, size_t end) { func(params, start, end); };
+    CPUKernelUtils::ParallelFor(task, total_compute_size, 1);
+  }
+
+  // Lets a delta checkpoint save only the rows of the parameters that the optimizer changed
+  template <typename T>
+  void MarkChangedRows(const std::vector<const void *> &params, size_t row_num,
+                       const SparseGradient<T> &unique_sparse_grad) const {
+    auto &tracker = checkpoint::DirtyRowTracker::GetInstance();
+    for (auto param : params) {
+      tracker.MarkRows(param, row_num, unique_sparse_grad.indices_, unique_sparse_grad.indices_size_);
     }
   }
 
@@ -169,8 +168,6 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     }
     size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
     size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-    std::vector<std::thread> threads;
-    threads.reserve(param.thread_num_);
     segments.reserve(param.thread_num_);
 
     size_t current_indices_offset = 0;
@@ -184,14 +181,15 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
       segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
       segments[i]->indices_size_ = indices_size;
-      threads.emplace_back(
-        std::thread(CalculateEachBucketSize<T>, segments[i], param.max_index_, segment_bucket_sizes[i].get()));
       current_indices_offset += indices_size;
     }
 
-    for (size_t i = 0; i < param.thread_num_; ++i) {
-      threads[i].join();
-    }
+    auto task = [&param, &segments, &segment_bucket_sizes](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        CalculateEachBucketSize<T>(segments[i], param.max_index_, segment_bucket_sizes[i].get());
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, param.thread_num_, 1);
   }
 
   template <typename T>
@@ -259,17 +257,16 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       }
       each_thread_buckets.emplace_back(thread_buckets);
     }
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
-    current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads.emplace_back(
-        std::thread(CopySegmentIndicesToBucket<T>, param, segments[i], current_indices_offset, each_thread_buckets[i]));
-      current_indices_offset += segments[i]->indices_size_;
-    }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
+    std::vector<size_t> segment_offsets(thread_num, 0);
+    for (size_t i = 1; i < thread_num; ++i) {
+      segment_offsets[i] = segment_offsets[i - 1] + segments[i - 1]->indices_size_;
     }
+    auto task = [&param, &segments, &segment_offsets, &each_thread_buckets](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        CopySegmentIndicesToBucket<T>(param, segments[i], segment_offsets[i], each_thread_buckets[i]);
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, thread_num, 1);
   }
 
   template <typename T>
@@ -377,8 +374,6 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
     auto &reduced_buckets = *reduced_buckets_ptr;
     size_t thread_num = buckets.size();
-    std::vector<std::thread> threads;
-    threads.reserve(thread_num);
 
     size_t current_indices_offset = 0;
     for (size_t i = 0; i < thread_num; ++i) {
@@ -386,16 +381,18 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
       reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
       reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-      if (param.use_sort_reduce_) {
-        threads.emplace_back(std::thread(SortAndReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      } else {
-        threads.emplace_back(std::thread(ReduceBucketSparseGradient<T>, param, buckets[i], reduced_buckets[i]));
-      }
       current_indices_offset += buckets[i]->indices_size_;
     }
-    for (size_t i = 0; i < thread_num; ++i) {
-      threads[i].join();
-    }
+    auto task = [&param, &buckets, &reduced_buckets](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        if (param.use_sort_reduce_) {
+          SortAndReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
+        } else {
+          ReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
+        }
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, thread_num, 1);
   }
 
   template <typename T>
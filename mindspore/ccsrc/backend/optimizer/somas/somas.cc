@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <fstream>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <numeric>
@@ -32,6 +33,7 @@
 #include "runtime/device/ascend/ascend_stream_assign.h"
 #endif
 #include "backend/optimizer/common/helper.h"
+#include "common/thread_pool.h"
 #include "utils/ms_context.h"
 #include "debug/common.h"
 
@@ -573,7 +575,7 @@ static bool LifetimeOverlap(lifetime_t lifetime1, lifetime_t lifetime2) {
   return (std::max(end1, end2) - std::min(start1, start2) <= end2 - start2 + end1 - start1);
 }
 
-static bool Subset(std::set<SomasStreamPtr> streamSet1, std::set<SomasStreamPtr> streamSet2) {
+static bool Subset(const std::set<SomasStreamPtr> &streamSet1, const std::set<SomasStreamPtr> &streamSet2) {
   for (auto stream : streamSet1) {
     if (streamSet2.count(stream) == 0) {
       return false;
@@ -582,199 +584,232 @@ static bool Subset(std::set<SomasStreamPtr> streamSet1, std::set<SomasStreamPtr>
   return true;
 }
 
-static void EraseSet(std::set<SomasStreamPtr> *streamSet, std::set<SomasStreamPtr> removeStreamsSet) {
+static void EraseSet(std::set<SomasStreamPtr> *streamSet, const std::set<SomasStreamPtr> &removeStreamsSet) {
   for (auto stream : removeStreamsSet) {
     streamSet->erase(stream);
   }
 }
 
-static bool ValidSubset(std::set<SomasStreamPtr> destStreams, std::set<SomasStreamPtr> ancestorsAndSelf,
-                        SomasTensorPtr ancestorTensor, SomasTensorPtr tensor) {
-  MS_EXCEPTION_IF_NULL(ancestorTensor);
-  MS_EXCEPTION_IF_NULL(tensor);
-  for (auto stream : destStreams) {
-    if (ancestorsAndSelf.count(stream) == 0) {
-      return false;
+// The rows of the conflict matrix are computed by several threads, so the maps are read without operator[]
+template <typename Map>
+static size_t FindOrZero(const Map &map, const typename Map::key_type &key) {
+  auto iter = map.find(key);
+  return iter == map.end() ? 0 : iter->second;
+}
+
+// A tensor of an ancestor stream that may reuse memory with a tensor of the stream. The tensor of the stream has to
+// start after start_limit when check_start is set, and its node has to wait for each stream in waits up to a node of
+// at least the given order
+struct ReuseCandidate {
+  size_t id;
+  bool check_start;
+  size_t start_limit;
+  std::vector<std::pair<int64_t, size_t>> waits;
+};
+
+// The tensors of the ancestor streams of a stream that may reuse memory with the tensors of the stream. The checks
+// that do not depend on the tensor of the stream are done once here, not once per pair
+static std::vector<ReuseCandidate> GetReuseCandidates(const SomasStreamPtr &stream) {
+  MS_EXCEPTION_IF_NULL(stream);
+  std::vector<ReuseCandidate> candidates;
+  auto can_be_reused = [](const SomasTensorPtr &ancestor_tensor) {
+    return ancestor_tensor->GetAlignedSize() != 0 && !ancestor_tensor->IsLifelong() &&
+           !ancestor_tensor->IsSemiLifelongEnd() && !ancestor_tensor->IsRefOverlap();
+  };
+
+  // Ancestor stream groups
+  const std::set<SomasStreamPtr> &ancestors = stream->ancestor_streams_group_;
+  std::set<SomasStreamPtr> group_and_self = ancestors;
+  group_and_self.insert(stream);
+  for (const auto &ancestor_stream : ancestors) {
+    for (const auto &ancestor_tensor : ancestor_stream->tensors_) {
+      if (!can_be_reused(ancestor_tensor)) continue;
+      if (!ancestor_tensor->IsBetweenStreams() || Subset(ancestor_tensor->destinationStreams_, ancestors)) {
+        candidates.push_back({ancestor_tensor->GetId(), false, 0, {}});
+      } else if (Subset(ancestor_tensor->destinationStreams_, group_and_self)) {
+        size_t start_limit = FindOrZero(ancestor_tensor->max_destination_id_, stream);
+        candidates.push_back({ancestor_tensor->GetId(), true, start_limit, {}});
+      }
     }
+  }
 
-    if (stream != tensor->GetSourceStream()) {
-      MS_EXCEPTION_IF_NULL(tensor->GetSourceStream());
-      if (tensor->GetSourceStream()->ancestor_streams_group_.count(stream) == 0 &&
-          ancestorTensor->max_destination_id_[stream] >
-            tensor->GetSourceNode()->anc_stream_max_order_[stream->GetId()]) {
-        return false;
+  // Ancestor streams (no groups)
+  auto ancestors_no_groups = stream->ancestor_streams_;
+  EraseSet(&ancestors_no_groups, stream->ancestor_streams_group_);
+  std::set<SomasStreamPtr> ancestors_and_self = stream->ancestor_streams_;
+  ancestors_and_self.insert(stream);
+  for (const auto &ancestor_stream : ancestors_no_groups) {
+    for (const auto &ancestor_tensor : ancestor_stream->tensors_) {
+      if (!can_be_reused(ancestor_tensor)) continue;
+      if (!ancestor_tensor->IsBetweenStreams()) {
+        ReuseCandidate candidate{ancestor_tensor->GetId(), false, 0, {}};
+        candidate.waits.emplace_back(ancestor_stream->GetId(), ancestor_tensor->lifetime_.end_);
+        candidates.push_back(candidate);
+        continue;
       }
-    } else {
-      if (ancestorTensor->max_destination_id_[stream] >= tensor->lifetime_.start_) {
-        return false;
+      // ancestor tensor goes to another stream (might go to same stream also), it has to be used up in each of them
+      if (!Subset(ancestor_tensor->destinationStreams_, ancestors_and_self)) continue;
+      ReuseCandidate candidate{ancestor_tensor->GetId(), false, 0, {}};
+      for (const auto &dest_stream : ancestor_tensor->destinationStreams_) {
+        size_t max_destination_id = FindOrZero(ancestor_tensor->max_destination_id_, dest_stream);
+        if (dest_stream == stream) {
+          candidate.check_start = true;
+          candidate.start_limit = max_destination_id;
+        } else if (stream->ancestor_streams_group_.count(dest_stream) == 0) {
+          candidate.waits.emplace_back(dest_stream->GetId(), max_destination_id);
+        }
       }
+      candidates.push_back(candidate);
     }
   }
-  return true;
+  return candidates;
 }
 
-void Somas::ComputeConflictPairs() {
-  if (tensors_list_.empty()) {
-    MS_LOG(INFO) << "No Tensor for Conflict computing";
-    return;
+static bool CanReuse(const ReuseCandidate &candidate, size_t start,
+                     const std::unordered_map<int64_t, size_t> &anc_stream_max_order) {
+  if (candidate.check_start && candidate.start_limit >= start) {
+    return false;
   }
+  for (const auto &wait : candidate.waits) {
+    if (wait.second > FindOrZero(anc_stream_max_order, wait.first)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  MS_LOG(INFO) << "Start Preprocessing Conflicts";
-  PreprocessingConflicts();
-  MS_LOG(INFO) << "End Preprocessing Conflicts";
-
-  MS_LOG(INFO) << "Start Array Initialization";
-  cannot_reuse_ =
-    std::make_shared<Array>(tensors_list_.back()->GetId() + 1,
-                            tensors_list_.back()->GetId() + 1);  // array size is (max_id + 1) x (max_id + 1)
-  MS_LOG(INFO) << "End Array Initialization";
-
-  MS_LOG(INFO) << "Start Conflict Computing";
+// Lifetime and flags of a tensor of a stream, packed for the same-stream loop that visits every pair of its tensors
+struct StreamTensor {
+  size_t id;
+  lifetime_t lifetime;
+  bool reusable;  // not empty, lifelong nor ref overlap
+  bool between_streams;
+  bool semi_lifelong_start;
+  bool semi_lifelong_end;
+};
+
+static std::vector<StreamTensor> GetStreamTensors(const SomasStreamPtr &stream) {
+  std::vector<StreamTensor> stream_tensors;
+  for (const auto &tensor : stream->tensors_) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    bool reusable = tensor->GetAlignedSize() != 0 && !tensor->IsLifelong() && !tensor->IsRefOverlap();
+    stream_tensors.push_back({tensor->GetId(), tensor->lifetime_, reusable, tensor->IsBetweenStreams(),
+                              tensor->IsSemiLifelongStart(), tensor->IsSemiLifelongEnd()});
+  }
+  return stream_tensors;
+}
 
+// Clear the row of a tensor in the conflict matrix for the tensors it may reuse memory with, return how many
+static size_t ComputeConflictRow(const SomasStreamPtr &stream, size_t position,
+                                 const std::vector<ReuseCandidate> &candidates,
+                                 const std::vector<StreamTensor> &stream_tensors, ConflictMatrix *cannot_reuse) {
+  const auto &tensor = stream->tensors_[position];
   size_t count_reuse = 0;
 
-  // Loop for ancestor stream groups reuse
-  for (auto stream : streams_list_) {
-    std::set<SomasStreamPtr> ancestors = stream->ancestor_streams_group_;
-
-    std::set<SomasStreamPtr> ancestors_and_self = ancestors;
-    ancestors_and_self.insert(stream);
-
-    for (auto ancestor_stream : ancestors) {
-      for (auto ancestor_tensor : ancestor_stream->tensors_) {
-        if (ancestor_tensor->GetAlignedSize() == 0) continue;
-        if (ancestor_tensor->IsLifelong()) continue;
-        if (ancestor_tensor->IsSemiLifelongEnd()) continue;
-        if (ancestor_tensor->IsRefOverlap()) continue;
-
-        if (!ancestor_tensor->IsBetweenStreams() || Subset(ancestor_tensor->destinationStreams_, ancestors)) {
-          for (auto tensor : stream->tensors_) {
-            if (tensor->IsGap()) continue;
-            if (tensor->GetAlignedSize() == 0) continue;
-            if (tensor->IsLifelong()) continue;
-            if (tensor->IsSemiLifelongStart()) continue;
-            if (tensor->IsRefOverlap()) continue;
-
-            (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-            (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
-            count_reuse++;
-          }
-        } else {
-          for (auto tensor : stream->tensors_) {
-            if (Subset(ancestor_tensor->destinationStreams_, ancestors_and_self) &&
-                ancestor_tensor->max_destination_id_[tensor->GetSourceStream()] < tensor->lifetime_.start_) {
-              if (tensor->IsGap()) continue;
-              if (tensor->GetAlignedSize() == 0) continue;
-              if (tensor->IsLifelong()) continue;
-              if (tensor->IsSemiLifelongStart()) continue;
-              if (tensor->IsRefOverlap()) continue;
-
-              (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-              (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
-              count_reuse++;
-            }
-          }
-        }
+  // Ancestor streams
+  if (!tensor->IsGap() && tensor->GetAlignedSize() != 0 && !tensor->IsLifelong() && !tensor->IsSemiLifelongStart() &&
+      !tensor->IsRefOverlap()) {
+    MS_EXCEPTION_IF_NULL(tensor->GetSourceNode());
+    const auto &anc_stream_max_order = tensor->GetSourceNode()->anc_stream_max_order_;
+    for (const auto &candidate : candidates) {
+      if (CanReuse(candidate, tensor->lifetime_.start_, anc_stream_max_order)) {
+        cannot_reuse->Reset(tensor->GetId(), candidate.id);
+        count_reuse++;
       }
     }
   }
 
-  // Loop for ancestor streams (no groups)
-  for (auto stream : streams_list_) {
-    auto ancestors_no_groups = stream->ancestor_streams_;
-    EraseSet(&ancestors_no_groups, stream->ancestor_streams_group_);
-
-    for (auto ancestor_stream : ancestors_no_groups) {
-      for (auto ancestor_tensor : ancestor_stream->tensors_) {
-        if (ancestor_tensor->GetAlignedSize() == 0) continue;
-        if (ancestor_tensor->IsLifelong()) continue;
-        if (ancestor_tensor->IsSemiLifelongEnd()) continue;
-        if (ancestor_tensor->IsRefOverlap()) continue;
-
-        if (!ancestor_tensor->IsBetweenStreams()) {
-          for (auto tensor : stream->tensors_) {
-            if (tensor->IsGap()) continue;
-            if (tensor->GetAlignedSize() == 0) continue;
-            if (tensor->IsLifelong()) continue;
-            if (tensor->IsSemiLifelongStart()) continue;
-            if (tensor->IsRefOverlap()) continue;
-
-            size_t max_ancestor_order = tensor->GetSourceNode()->anc_stream_max_order_[ancestor_stream->GetId()];
-
-            if (ancestor_tensor->lifetime_.end_ <= max_ancestor_order) {
-              (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-              (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
-              count_reuse++;
-            }
-          }
-        } else {  // ancestor tensor goes to another stream (might go to same stream also)
-          std::set<SomasStreamPtr> dest_streams = ancestor_tensor->destinationStreams_;
-          std::set<SomasStreamPtr> ancestors = stream->ancestor_streams_;
-
-          std::set<SomasStreamPtr> ancestors_and_self = ancestors;
-          ancestors_and_self.insert(stream);
-
-          for (auto tensor : stream->tensors_) {
-            if (tensor->IsGap()) continue;
-            if (tensor->GetAlignedSize() == 0) continue;
-            if (tensor->IsLifelong()) continue;
-            if (tensor->IsSemiLifelongStart()) continue;
-            if (tensor->IsRefOverlap()) continue;
-
-            if (ValidSubset(dest_streams, ancestors_and_self, ancestor_tensor, tensor)) {
-              (*cannot_reuse_)(ancestor_tensor->GetId(), tensor->GetId()) = 0;
-              (*cannot_reuse_)(tensor->GetId(), ancestor_tensor->GetId()) = 0;
-              count_reuse++;
-            }
-          }
-        }
-      }
+  // Same stream
+  const auto &tensor1 = stream_tensors[position];
+  if (!tensor1.reusable) {
+    return count_reuse;
+  }
+  for (const auto &tensor2 : stream_tensors) {
+    if (tensor2.id >= tensor1.id) break;  // keep only when tensors kept sorted in tensors-vector of each stream
+    if (!tensor2.reusable) continue;
+
+    // Between streams extra safety
+    if (tensor1.between_streams && tensor2.between_streams) continue;
+
+    // Check lifetime overlap
+    const lifetime_t &lifetime1 = tensor1.lifetime;
+    const lifetime_t &lifetime2 = tensor2.lifetime;
+
+    if (!LifetimeOverlap(lifetime1, lifetime2)) {
+      // Between-streams extra safety
+      if (tensor1.between_streams && lifetime1.end_ < lifetime2.start_) continue;
+      if (tensor2.between_streams && lifetime2.end_ < lifetime1.start_) continue;
+
+      // Semi-lifelong extra safety
+      if (lifetime1.end_ < lifetime2.start_ && (tensor2.semi_lifelong_start || tensor1.semi_lifelong_end)) continue;
+      if (lifetime2.end_ < lifetime1.start_ && (tensor1.semi_lifelong_start || tensor2.semi_lifelong_end)) continue;
+
+      // If arrived here, allow reuse
+      cannot_reuse->Reset(tensor1.id, tensor2.id);
+      count_reuse++;
     }
   }
+  return count_reuse;
+}
 
-  // Loop for same stream
-  for (auto stream : streams_list_) {
-    MS_EXCEPTION_IF_NULL(stream);
-    for (auto tensor1 : stream->tensors_) {
-      if (tensor1->GetAlignedSize() == 0) continue;
-      if (tensor1->IsLifelong()) continue;
-      if (tensor1->IsRefOverlap()) continue;
-
-      for (auto tensor2 : stream->tensors_) {
-        if (tensor2->GetId() >= tensor1->GetId())
-          break;  // keep only when tensors kept sorted in tensors-vector of each stream, otherwise remove
-
-        if (tensor2->GetAlignedSize() == 0) continue;
-        if (tensor2->IsLifelong()) continue;
-        if (tensor2->IsRefOverlap()) continue;
-
-        // Between streams extra safety
-        if (tensor1->IsBetweenStreams() && tensor2->IsBetweenStreams()) continue;
-
-        // Check lifetime overlap
-        lifetime_t lifetime1 = tensor1->lifetime_;
-        lifetime_t lifetime2 = tensor2->lifetime_;
-
-        if (!LifetimeOverlap(lifetime1, lifetime2)) {
-          // Between-streams extra safety
-          if (tensor1->IsBetweenStreams() && lifetime1.end_ < lifetime2.start_) continue;
-          if (tensor2->IsBetweenStreams() && lifetime2.end_ < lifetime1.start_) continue;
-
-          // Semi-lifelong extra safety
-          if (lifetime1.end_ < lifetime2.start_ && (tensor2->IsSemiLifelongStart() || tensor1->IsSemiLifelongEnd()))
-            continue;
-          if (lifetime2.end_ < lifetime1.start_ && (tensor1->IsSemiLifelongStart() || tensor2->IsSemiLifelongEnd()))
-            continue;
-
-          // If arrived here, allow reuse
-          (*cannot_reuse_)(tensor2->GetId(), tensor1->GetId()) = 0;
-          (*cannot_reuse_)(tensor1->GetId(), tensor2->GetId()) = 0;
-          count_reuse++;
+static void RunConflictTasks(size_t num, const std::function<void(size_t, size_t)> &func) {
+  // Every task takes one item out of kDefaultMaxThreadNum, so the expensive items at either end are spread
+  std::vector<Task> tasks;
+  for (size_t task = 0; task < std::min(num, static_cast<size_t>(kDefaultMaxThreadNum)); task++) {
+    tasks.emplace_back([task, num, &func]() -> int {
+      try {
+        for (size_t item = task; item < num; item += kDefaultMaxThreadNum) {
+          func(task, item);
         }
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Somas conflict task " << task << " failed: " << e.what();
+        return mindspore::FAIL;
       }
-    }
+      return mindspore::SUCCESS;
+    });
+  }
+  if (!ThreadPool::GetInstance()->LaunchMultipleTask(tasks)) {
+    MS_LOG(EXCEPTION) << "Somas conflict computing failed.";
+  }
+}
+
+void Somas::ComputeConflictPairs() {
+  if (tensors_list_.empty()) {
+    MS_LOG(INFO) << "No Tensor for Conflict computing";
+    return;
   }
 
+  MS_LOG(INFO) << "Start Preprocessing Conflicts";
+  PreprocessingConflicts();
+  MS_LOG(INFO) << "End Preprocessing Conflicts";
+
+  MS_LOG(INFO) << "Start Array Initialization";
+  cannot_reuse_ = std::make_shared<ConflictMatrix>(tensors_list_.back()->GetId() + 1);  // size is max_id + 1
+  MS_LOG(INFO) << "End Array Initialization";
+
+  MS_LOG(INFO) << "Start Conflict Computing";
+  // Each tensor of a stream owns its row and only clears bits in it, the rows are computed in parallel and the
+  // matrix is made symmetric afterwards
+  std::vector<std::vector<ReuseCandidate>> streams_candidates;
+  std::vector<std::vector<StreamTensor>> streams_tensors;
+  std::vector<std::pair<size_t, size_t>> rows;  // index of the stream, position of the tensor in the stream
+  for (size_t i = 0; i < streams_list_.size(); i++) {
+    streams_candidates.push_back(GetReuseCandidates(streams_list_[i]));
+    streams_tensors.push_back(GetStreamTensors(streams_list_[i]));
+    for (size_t position = 0; position < streams_list_[i]->tensors_.size(); position++) {
+      rows.emplace_back(i, position);
+    }
+  }
+  std::vector<size_t> task_reuse(kDefaultMaxThreadNum, 0);
+  auto compute_row = [this, &rows, &streams_candidates, &streams_tensors, &task_reuse](size_t task, size_t row) {
+    size_t stream = rows[row].first;
+    task_reuse[task] += ComputeConflictRow(streams_list_[stream], rows[row].second, streams_candidates[stream],
+                                           streams_tensors[stream], cannot_reuse_.get());
+  };
+  RunConflictTasks(rows.size(), compute_row);
+  RunConflictTasks(cannot_reuse_->Bands(), [this](size_t, size_t band) { cannot_reuse_->SymmetrizeBand(band); });
+  size_t count_reuse = std::accumulate(task_reuse.begin(), task_reuse.end(), size_t(0));
+
   MS_LOG(INFO) << "End Conflict Computing";
   MS_LOG(INFO) << "Found " << count_reuse << " tensor pairs of allowed reusability";
 }
@@ -795,13 +830,13 @@ bool Somas::Assign(const session::KernelGraph *graph) {
     // Keep all constraints for first tensor in list
     size_t tid_0 = ref_node_list[0];
     for (SomasTensorPtr tensor : tensors_list_) {
-      if ((*cannot_reuse_)(tid_0, tensor->GetId()) == 1) {
+      if ((*cannot_reuse_)(tid_0, tensor->GetId())) {
         continue;
       }
       for (size_t tid : ref_node_list) {
-        if ((*cannot_reuse_)(tid, tensor->GetId()) == 1) {
-          (*cannot_reuse_)(tid_0, tensor->GetId()) = 1;
-          (*cannot_reuse_)(tensor->GetId(), tid_0) = 1;
+        if ((*cannot_reuse_)(tid, tensor->GetId())) {
+          cannot_reuse_->Set(tid_0, tensor->GetId());
+          cannot_reuse_->Set(tensor->GetId(), tid_0);
           break;
         }
       }
@@ -921,22 +956,16 @@ bool Somas::Assign(const session::KernelGraph *graph) {
   for (auto ref_overlap_list : ref_overlap_constraints_) {
     for (size_t tid_1 : ref_overlap_list) {
       for (size_t tid_2 : ref_overlap_list) {
-        (*cannot_reuse_)(tid_1, tid_2) = 0;
-        (*cannot_reuse_)(tid_2, tid_1) = 0;
+        cannot_reuse_->Reset(tid_1, tid_2);
+        cannot_reuse_->Reset(tid_2, tid_1);
       }
     }
   }
   MS_LOG(INFO) << "End Solving Preprocessing for Ref Overlap";
 
   // Compute number of constraints for each tensor
-  for (auto tensor1 : tensors_list_) {
-    size_t count_constraints = 0;
-    for (auto tensor2 : tensors_list_) {
-      if ((*cannot_reuse_)(tensor1->GetId(), tensor2->GetId()) == 1) {
-        count_constraints++;
-      }
-    }
-    tensor1->num_constraints_ = count_constraints;
+  for (auto tensor : tensors_list_) {
+    tensor->num_constraints_ = cannot_reuse_->CountRow(tensor->GetId());
   }
 
   // Preprocessing contiguous gaps
@@ -957,13 +986,10 @@ bool Somas::Assign(const session::KernelGraph *graph) {
     // Update conflicts to conflicts of neighbour
     size_t front_neighbour_id = contiguous_list[1];
     size_t back_neighbour_id = contiguous_list[contiguous_list.size() - 2];
-    for (SomasTensorPtr tensor : tensors_list_) {
-      MS_EXCEPTION_IF_NULL(tensor);
-      (*cannot_reuse_)(tensor->GetId(), front_gap_id) = (*cannot_reuse_)(tensor->GetId(), front_neighbour_id);
-      (*cannot_reuse_)(front_gap_id, tensor->GetId()) = (*cannot_reuse_)(front_neighbour_id, tensor->GetId());
-      (*cannot_reuse_)(tensor->GetId(), back_gap_id) = (*cannot_reuse_)(tensor->GetId(), back_neighbour_id);
-      (*cannot_reuse_)(back_gap_id, tensor->GetId()) = (*cannot_reuse_)(back_neighbour_id, tensor->GetId());
-    }
+    cannot_reuse_->CopyColumn(front_gap_id, front_neighbour_id);
+    cannot_reuse_->CopyRow(front_gap_id, front_neighbour_id);
+    cannot_reuse_->CopyColumn(back_gap_id, back_neighbour_id);
+    cannot_reuse_->CopyRow(back_gap_id, back_neighbour_id);
     SomasTensorPtr front_neighbour = tensors_map_[front_neighbour_id];
     SomasTensorPtr back_neighbour = tensors_map_[back_neighbour_id];
     MS_EXCEPTION_IF_NULL(front_neighbour);
@@ -69,7 +69,7 @@ class Somas {
   SomasSolverPrePtr somas_solver_;
 
   // Constraints
-  std::shared_ptr<Array> cannot_reuse_;
+  std::shared_ptr<ConflictMatrix> cannot_reuse_;
 
   // Contiguous list
   std::vector<vector<size_t>> contiguous_tensors_list_;
@@ -143,9 +143,9 @@ class FootPrint : public std::enable_shared_from_this<FootPrint> {
   void Destroy();
   const size_t getOffset() { return m_offset_; }
   void setOffset(const size_t &offset) { m_offset_ = offset; }
-  bool findOffset(const std::shared_ptr<Array> &constraints, const BlockTensor &block, size_t *offset);
-  void ConstrainedBLocks(const std::shared_ptr<Array> &constraints, const BlockTensor &b1, const BlockTensor &b2,
-                         vector<Interval> *oInterval_l);
+  bool findOffset(const std::shared_ptr<ConflictMatrix> &constraints, const BlockTensor &block, size_t *offset);
+  void ConstrainedBLocks(const std::shared_ptr<ConflictMatrix> &constraints, const BlockTensor &b1,
+                         const BlockTensor &b2, vector<Interval> *oInterval_l);
   void Merge(vector<Interval> *l_interval, stack<Interval> *l_merged);
   bool findFirst(stack<Interval> *merged, const BlockTensor &block, size_t *offset);
   size_t Result();
@@ -167,7 +167,7 @@ class FastHeuristic {
   void setAlignment(const size_t &a) { m_alignment_ = a; }
   void Destroy();
   bool Eval(vector<BlockTensor> *block_tensors_v, std::shared_ptr<FootPrint> foot_print,
-            const std::shared_ptr<Array> &pConstraints);
+            const std::shared_ptr<ConflictMatrix> &pConstraints);
 
  private:
   size_t m_alignment_;
@@ -169,16 +169,14 @@ bool SomasSolverCore::Verify(const size_t &upperbound) {
       t2 = t2_.second;
       if (t1->index_ == t2->index_) continue;
       bool blifelong = (t1->lifelong_ || t2->lifelong_) && (t1->index_ != t2->index_);
-      const size_t continuous = 2;
-      const size_t conflict = 1;
-      if ((*constraints_)(t1->index_, t2->index_) == continuous) {  // continuous constraint
+      if (t1->left_ == t2) {  // continuous constraint
         // t1 must be continous to t2
         bool bcontinuous = t1->offset_ == (t2->offset_ + t2->size_);
         if (!bcontinuous) {
           MS_LOG(WARNING) << "Continuous constraint violation in tensors " << t1->index_ << " and" << t2->index_;
           retval = false;
         }
-      } else if (blifelong || (*constraints_)(t1->index_, t2->index_) == conflict) {  // conflict constraint
+      } else if (blifelong || (*constraints_)(t1->index_, t2->index_)) {  // conflict constraint
         size_t t1_ub = t1->offset_ + t1->size_;
         size_t t2_ub = t2->offset_ + t2->size_;
         bool b_overlap_lb = ((t2->offset_ >= t1->offset_) && (t2->offset_ < t1_ub));
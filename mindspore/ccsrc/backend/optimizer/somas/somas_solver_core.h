@@ -33,7 +33,7 @@ class SomasSolverCore {
  public:
   /// Interface Function: receive parameters, creates the model to solve and then save the result
   SomasSolverCore(const std::unordered_map<size_t, SomasSolverTensorDescPtr> &tensors,
-                  const std::shared_ptr<Array> &constraints)
+                  const std::shared_ptr<ConflictMatrix> &constraints)
       : tensors_(tensors),
         constraints_(constraints),
         upperbound_(SIZE_MAX),
@@ -69,7 +69,7 @@ class SomasSolverCore {
  private:
   std::unordered_map<size_t, SomasSolverTensorDescPtr> tensors_;
   vector<BlockTensor> block_tensors_;
-  std::shared_ptr<Array> constraints_;
+  std::shared_ptr<ConflictMatrix> constraints_;
   size_t upperbound_{0};
   size_t timing_{0};
   size_t lifelongmemory_{0};
@@ -14,6 +14,7 @@
  * limitations under the License.
 */
 
+#include <bitset>
 #include <cstdio>
 #include <fstream>
 #include <memory>
@@ -25,9 +26,56 @@
 
 namespace mindspore {
 namespace somas {
+// Swaps the off diagonal quarters of ever smaller blocks
+void ConflictMatrix::TransposeBlock(uint64_t *block) {
+  uint64_t mask = 0x00000000FFFFFFFFULL;
+  for (size_t width = 32; width != 0; width >>= 1, mask ^= (mask << width)) {
+    for (size_t k = 0; k < kWordBits; k = ((k | width) + 1) & ~width) {
+      uint64_t swap = ((block[k] >> width) ^ block[k | width]) & mask;
+      block[k] ^= swap << width;
+      block[k | width] ^= swap;
+    }
+  }
+}
+
+size_t ConflictMatrix::CountRow(size_t i) const {
+  size_t count = 0;
+  for (size_t w = i * words_; w < (i + 1) * words_; w++) {
+    count += std::bitset<kWordBits>(bits_[w]).count();
+  }
+  return count;
+}
+
+void ConflictMatrix::SymmetrizeBand(size_t band) {
+  uint64_t block[kWordBits];
+  uint64_t mirror[kWordBits];
+  size_t row_begin = band * kWordBits;
+  size_t row_end = std::min(size_, row_begin + kWordBits);
+  for (size_t other = band; other < words_; other++) {
+    size_t other_begin = other * kWordBits;
+    size_t other_end = std::min(size_, other_begin + kWordBits);
+    // Rows past the end are zero, they only meet the unused bits of the last word
+    for (size_t k = 0; k < kWordBits; k++) {
+      block[k] = row_begin + k < row_end ? bits_[(row_begin + k) * words_ + other] : 0;
+      mirror[k] = other_begin + k < other_end ? bits_[(other_begin + k) * words_ + band] : 0;
+    }
+    TransposeBlock(block);
+    TransposeBlock(mirror);
+    for (size_t k = row_begin; k < row_end; k++) {
+      bits_[k * words_ + other] &= mirror[k - row_begin];
+    }
+    if (other == band) {
+      continue;
+    }
+    for (size_t k = other_begin; k < other_end; k++) {
+      bits_[k * words_ + band] &= block[k - other_begin];
+    }
+  }
+}
+
 Status SomasSolverPre::Solving(const session::KernelGraph *graph,
                                std::unordered_map<size_t, SomasSolverTensorDescPtr> *ptensors,
-                               std::shared_ptr<Array> pConstraints, const vector<vector<size_t>> &continuous_v,
+                               std::shared_ptr<ConflictMatrix> pConstraints, const vector<vector<size_t>> &continuous_v,
                                bool bVerifySolution, bool ball, SortingType sorting, FittingType fitting,
                                AlgorithmType algorithm) {
   Status retval = SUCCESS;
@@ -60,8 +108,6 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph,
           return FAILED;
         }
 
-        const size_t continuous = 2;
-        (*pConstraints)(index2, index1) = continuous;
         if (tensors[index1]->right_)
           MS_LOG(WARNING) << "Warning:tensor " << index1
                           << " already has a right tensor (id: " << tensors[index1]->right_->index_;
@@ -104,7 +150,8 @@ Status SomasSolverPre::Solving(const session::KernelGraph *graph,
 
 void SomasSolverPre::Log(const session::KernelGraph *graph,
                          const unordered_map<size_t, SomasSolverTensorDescPtr> &tensors,
-                         const std::shared_ptr<Array> &pConstraints, const vector<vector<size_t>> &continuous_v) {
+                         const std::shared_ptr<ConflictMatrix> &pConstraints,
+                         const vector<vector<size_t>> &continuous_v) {
   MS_LOG(INFO) << "SomasSolver::Log Writing somas-input.txt..";
 
   auto context_ptr = MsContext::GetInstance();
@@ -143,7 +190,8 @@ void SomasSolverPre::Log(const session::KernelGraph *graph,
     for (auto &t2 : tensors) {
       size_t idx1 = t1.first;
       size_t idx2 = t2.first;
-      if ((idx1 != idx2) && (*pConstraints)(idx1, idx2) == 1) {
+      // A continuous pair is constrained by its position, not by a conflict
+      if ((idx1 != idx2) && (*pConstraints)(idx1, idx2) && t1.second->left_ != t2.second) {
         ofs_1 << "C " << idx1 << " " << idx2 << std::endl;
       }
     }
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <map>
@@ -57,36 +58,71 @@ enum FittingType {
   kNumFittingTypes
 };
 
-class Array {
+// Square matrix with one bit per pair of tensors, the bit is set when the two tensors can not share memory. Each row
+// is a run of 64 bit words, so a graph of n tensors takes n * n / 8 bytes where a matrix of int took 32 times that.
+// Continuous tensors are not kept in the matrix, they are linked by the left_ and right_ of their descriptors.
+class ConflictMatrix {
  public:
-  Array(const size_t &rows, const size_t &cols) : rows_(rows), cols_(cols) {
-    conflicts_array_ = std::make_unique<int[]>(rows * cols);
-    for (uint32_t i = 0; i < rows * cols; i++) {
-      conflicts_array_[i] = 1;
+  // All pairs start in conflict
+  explicit ConflictMatrix(size_t size)
+      : size_(size), words_((size + kWordBits - 1) / kWordBits), bits_(size * words_, ~uint64_t(0)) {
+    if (size_ % kWordBits != 0) {
+      uint64_t tail_mask = (uint64_t(1) << (size_ % kWordBits)) - 1;
+      for (size_t i = 0; i < size_; i++) {
+        bits_[i * words_ + words_ - 1] &= tail_mask;
+      }
     }
   }
 
-  Array(const Array &array) : rows_(array.rows_), cols_(array.cols_) {
-    conflicts_array_ = std::make_unique<int[]>(array.rows_ * array.cols_);
-    for (uint32_t i = 0; i < array.rows_ * array.cols_; i++) {
-      conflicts_array_[i] = array.conflicts_array_[i];
-    }
+  ConflictMatrix(const ConflictMatrix &) = default;
+  ConflictMatrix &operator=(const ConflictMatrix &) = delete;
+
+  bool operator()(size_t i, size_t j) const {
+    assert(i < size_ && j < size_);
+    return ((bits_[i * words_ + j / kWordBits] >> (j % kWordBits)) & 1) != 0;
   }
 
-  Array &operator=(const Array &array) { return *this; }
+  void Set(size_t i, size_t j) { bits_[i * words_ + j / kWordBits] |= uint64_t(1) << (j % kWordBits); }
+  void Reset(size_t i, size_t j) { bits_[i * words_ + j / kWordBits] &= ~(uint64_t(1) << (j % kWordBits)); }
+
+  // Number of tensors the tensor of row i is in conflict with
+  size_t CountRow(size_t i) const;
+
+  // Give row i the conflicts of row j
+  void CopyRow(size_t i, size_t j) {
+    (void)std::copy(bits_.begin() + j * words_, bits_.begin() + (j + 1) * words_, bits_.begin() + i * words_);
+  }
 
-  int &operator()(const size_t &i, const size_t &j) {
-    assert((i * cols_ + j) < (rows_ * cols_));
-    return conflicts_array_[i * cols_ + j];
+  // Give column i the conflicts of column j
+  void CopyColumn(size_t i, size_t j) {
+    for (size_t k = 0; k < size_; k++) {
+      if ((*this)(k, j)) {
+        Set(k, i);
+      } else {
+        Reset(k, i);
+      }
+    }
   }
 
-  const size_t &Rows() { return rows_; }
-  const size_t &Cols() { return cols_; }
+  // Make the matrix symmetric by keeping a pair in conflict only when its mirror pair is in conflict too. The rows are
+  // handled in bands of 64, band b also handles the columns of the bands after it, so different bands can be
+  // symmetrized at the same time by different threads
+  void SymmetrizeBand(size_t band);
+  size_t Bands() const { return words_; }
+
+  size_t Rows() const { return size_; }
+  size_t Cols() const { return size_; }
+
+  static constexpr size_t kWordBits = 64;
+
+  // Transpose a 64 x 64 block of bits, bit j of word i moves to bit i of word j
+  static void TransposeBlock(uint64_t *block);
 
  private:
-  const size_t rows_;
-  const size_t cols_;
-  std::unique_ptr<int[]> conflicts_array_;
+
+  const size_t size_;
+  const size_t words_;  // per row
+  std::vector<uint64_t> bits_;
 };
 
 struct SomasSolverTensorDesc {
@@ -140,14 +176,14 @@ class SomasSolverPre {
   size_t GetMaxOffset() { return max_offset_; }
 
   Status Solving(const session::KernelGraph *graph, std::unordered_map<size_t, SomasSolverTensorDescPtr> *tensors,
-                 std::shared_ptr<Array> pConstraints, const vector<vector<size_t>> &continuous_v,
+                 std::shared_ptr<ConflictMatrix> pConstraints, const vector<vector<size_t>> &continuous_v,
                  bool bVerifySolution,  // true -> Check continuous and non overlapping constraints solution
                  bool ball = true,      // true -> run full set of heuristics, false -> run single heuristic specified
                  SortingType sorting = kGreaterSizeSmallerIndex, FittingType fitting = kBest,
                  AlgorithmType algorithm = kManyObjects);
 
   void Log(const session::KernelGraph *graph, const unordered_map<size_t, SomasSolverTensorDescPtr> &tensors,
-           const std::shared_ptr<Array> &pConstraints_v, const vector<vector<size_t>> &continuous_v);
+           const std::shared_ptr<ConflictMatrix> &pConstraints_v, const vector<vector<size_t>> &continuous_v);
 
  private:
   size_t max_offset_;
@@ -93,8 +93,8 @@ class SomasTensor {
 
   // Accessors
   const size_t &GetId() { return id_; }
-  SomasNodePtr GetSourceNode() const { return source_node_; }
-  SomasStreamPtr GetSourceStream() const { return source_stream_; }
+  const SomasNodePtr &GetSourceNode() const { return source_node_; }
+  const SomasStreamPtr &GetSourceStream() const { return source_stream_; }
   const size_t &GetOriginalSize() { return original_size_; }
   const size_t &GetAlignedSize() { return aligned_size_; }
   bool IsLifelong() { return lifelong_value_ == kLifeLongGraphAll; }
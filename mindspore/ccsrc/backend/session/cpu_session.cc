@@ -175,6 +175,18 @@ void CPUSession::RunOpImpl(const OpRunInfo &op_run_info, const GraphInfo &graph_
   BuildOpImpl(op_run_info, graph_info, *input_tensors, tensors_mask);
   EraseValueNodeTensor(tensors_mask, input_tensors);
 
+  // An op that has run before only points its launch plan at the new tensors
+  auto plan_iter = run_op_plans_.find(graph_info);
+  if (plan_iter != run_op_plans_.end() && plan_iter->second != nullptr) {
+    if (runtime_.RunLaunchPlan(plan_iter->second.get(), *input_tensors, outputs)) {
+      return;
+    }
+    // The inputs no longer fit the plan, it is made again from this run
+    runtime_.ReleaseLaunchPlan(plan_iter->second.get());
+    (void)run_op_plans_.erase(plan_iter);
+    plan_iter = run_op_plans_.end();
+  }
+
   auto kernel_graph = run_op_graphs_[graph_info];
   MS_EXCEPTION_IF_NULL(kernel_graph);
 
@@ -196,6 +208,9 @@ void CPUSession::RunOpImpl(const OpRunInfo &op_run_info, const GraphInfo &graph_
 
   std::vector<tensor::TensorPtr> output_tensors;
   SetOutputFlags(*outputs, &output_tensors);
+  if (plan_iter == run_op_plans_.end()) {
+    run_op_plans_[graph_info] = runtime_.CreateLaunchPlan(kernel_graph.get());
+  }
   MS_LOG(INFO) << "Run Op end";
 }
 
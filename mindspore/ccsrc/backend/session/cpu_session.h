@@ -18,6 +18,7 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include "backend/session/session_basic.h"
 #include "backend/session/kernel_graph.h"
@@ -51,6 +52,8 @@ class CPUSession : public SessionBasic {
   void SetOutputFlags(const VectorRef &base_ref, std::vector<tensor::TensorPtr> *outputs_tensors);
   void SyncValueNodeDeviceAddr(const std::shared_ptr<KernelGraph> &kernel_graph);
   device::cpu::CPUKernelRuntime runtime_;
+  // Launch plans of the single op graphs by graph info, nullptr for graphs that always take the full path
+  std::unordered_map<GraphInfo, device::cpu::CPULaunchPlanPtr> run_op_plans_;
 };
 MS_REG_SESSION(kCPUDevice, CPUSession);
 }  // namespace session
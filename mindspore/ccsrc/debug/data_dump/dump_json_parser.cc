@@ -16,6 +16,7 @@
 #include "debug/data_dump/dump_json_parser.h"
 #include <fstream>
 #include "utils/log_adapter.h"
+#include "debug/data_dump/dump_writer.h"
 #include "debug/common.h"
 #include "utils/ms_context.h"
 #include "utils/convert_utils_base.h"
@@ -35,6 +36,14 @@ constexpr auto kSupportDevice = "support_device";
 constexpr auto kEnable = "enable";
 constexpr auto kOpDebugMode = "op_debug_mode";
 constexpr auto kTransFlag = "trans_flag";
+constexpr auto kKernelsRegex = "kernels_regex";
+constexpr auto kIterationInterval = "iteration_interval";
+constexpr auto kAsyncWrite = "async_write";
+constexpr auto kWriterThreads = "writer_threads";
+constexpr auto kBufferSizeMb = "buffer_size_mb";
+constexpr auto kCompression = "compression";
+constexpr auto kWhenFull = "when_full";
+constexpr auto kMaxWriterThreads = 64;
 constexpr auto kDumpInputAndOutput = 0;
 constexpr auto kDumpInputOnly = 1;
 constexpr auto kDumpOutputOnly = 2;
@@ -123,15 +132,7 @@ bool DumpJsonParser::DumpToFile(const std::string &filename, const void *data, s
     MS_LOG(ERROR) << "Get real path failed.";
     return false;
   }
-  std::ofstream fd;
-  fd.open(realpath.value(), std::ios::binary | std::ios::out);
-  if (!fd.is_open()) {
-    MS_LOG(ERROR) << "Open file " << realpath.value() << " fail.";
-    return false;
-  }
-  (void)fd.write(reinterpret_cast<const char *>(data), SizeToLong(len));
-  fd.close();
-  return true;
+  return DumpWriter::GetInstance().Write(realpath.value(), data, len);
 }
 
 void DumpJsonParser::ParseCommonDumpSetting(const nlohmann::json &content) {
@@ -151,6 +152,12 @@ void DumpJsonParser::ParseCommonDumpSetting(const nlohmann::json &content) {
   ParseInputOutput(*input_output);
   ParseKernels(*kernels);
   ParseSupportDevice(*support_device);
+
+  // kernels_regex is optional
+  auto kernels_regex = common_dump_settings->find(kKernelsRegex);
+  if (kernels_regex != common_dump_settings->end()) {
+    ParseKernelsRegex(*kernels_regex);
+  }
 }
 
 void DumpJsonParser::ParseAsyncDumpSetting(const nlohmann::json &content) {
@@ -180,6 +187,12 @@ void DumpJsonParser::ParseE2eDumpSetting(const nlohmann::json &content) {
 
   e2e_dump_enabled_ = ParseEnable(*e2e_dump_enable);
   trans_flag_ = ParseEnable(*trans_flag);
+
+  auto iteration_interval = e2e_dump_setting->find(kIterationInterval);
+  if (iteration_interval != e2e_dump_setting->end()) {
+    ParseIterationInterval(*iteration_interval);
+  }
+  ParseDumpWriter(*e2e_dump_setting);
 }
 
 void CheckJsonUnsignedType(const nlohmann::json &content, const std::string &key) {
@@ -200,6 +213,12 @@ void CheckJsonArrayType(const nlohmann::json &content, const std::string &key) {
   }
 }
 
+void CheckJsonBooleanType(const nlohmann::json &content, const std::string &key) {
+  if (!content.is_boolean()) {
+    MS_LOG(EXCEPTION) << "Dump Json Parse Failed." << key << " should be boolean type";
+  }
+}
+
 void DumpJsonParser::ParseDumpMode(const nlohmann::json &content) {
   CheckJsonUnsignedType(content, kDumpMode);
   dump_mode_ = content;
@@ -259,6 +278,73 @@ void DumpJsonParser::ParseKernels(const nlohmann::json &content) {
   }
 }
 
+void DumpJsonParser::ParseKernelsRegex(const nlohmann::json &content) {
+  CheckJsonArrayType(content, kKernelsRegex);
+  for (const auto &pattern : content) {
+    CheckJsonStringType(pattern, kKernelsRegex);
+    std::string pattern_str = pattern;
+    MS_LOG(INFO) << "Need dump kernels match:" << pattern_str;
+    try {
+      kernels_regex_.emplace_back(pattern_str, std::regex::ECMAScript | std::regex::optimize);
+    } catch (const std::regex_error &e) {
+      MS_LOG(EXCEPTION) << "Dump Json Parse Failed. Invalid kernels_regex " << pattern_str << ": " << e.what();
+    }
+  }
+}
+
+void DumpJsonParser::ParseIterationInterval(const nlohmann::json &content) {
+  CheckJsonUnsignedType(content, kIterationInterval);
+  iteration_interval_ = content;
+}
+
+void DumpJsonParser::ParseDumpWriter(const nlohmann::json &content) {
+  // The writer settings are optional, the tensors are written synchronously and uncompressed by default
+  DumpWriterConfig config;
+  auto async_write = content.find(kAsyncWrite);
+  if (async_write != content.end()) {
+    CheckJsonBooleanType(*async_write, kAsyncWrite);
+    config.async = *async_write;
+  }
+  auto writer_threads = content.find(kWriterThreads);
+  if (writer_threads != content.end()) {
+    CheckJsonUnsignedType(*writer_threads, kWriterThreads);
+    config.num_threads = *writer_threads;
+    if (config.num_threads == 0 || config.num_threads > kMaxWriterThreads) {
+      MS_LOG(EXCEPTION) << "Dump Json Parse Failed. writer_threads should be in [1, " << kMaxWriterThreads << "]";
+    }
+  }
+  auto buffer_size_mb = content.find(kBufferSizeMb);
+  if (buffer_size_mb != content.end()) {
+    CheckJsonUnsignedType(*buffer_size_mb, kBufferSizeMb);
+    size_t size_mb = *buffer_size_mb;
+    if (size_mb == 0) {
+      MS_LOG(EXCEPTION) << "Dump Json Parse Failed. buffer_size_mb should be greater than 0";
+    }
+    config.buffer_size = size_mb << 20;
+  }
+  auto compression = content.find(kCompression);
+  if (compression != content.end()) {
+    CheckJsonStringType(*compression, kCompression);
+    std::string compression_str = *compression;
+    if (compression_str == "zlib") {
+      config.compression = DumpCompression::kZlib;
+    } else if (compression_str != "none") {
+      MS_LOG(EXCEPTION) << "Dump Json Parse Failed. compression should be none or zlib, but got:" << compression_str;
+    }
+  }
+  auto when_full = content.find(kWhenFull);
+  if (when_full != content.end()) {
+    CheckJsonStringType(*when_full, kWhenFull);
+    std::string when_full_str = *when_full;
+    if (when_full_str == "drop") {
+      config.full_policy = DumpFullPolicy::kDrop;
+    } else if (when_full_str != "block") {
+      MS_LOG(EXCEPTION) << "Dump Json Parse Failed. when_full should be block or drop, but got:" << when_full_str;
+    }
+  }
+  DumpWriter::GetInstance().Init(config);
+}
+
 void DumpJsonParser::ParseSupportDevice(const nlohmann::json &content) {
   CheckJsonArrayType(content, kSupportDevice);
   for (const auto &device : content) {
@@ -296,6 +382,8 @@ void DumpJsonParser::JsonConfigToString() {
   cur_config.append(net_name_);
   cur_config.append(" iteration:");
   cur_config.append(std::to_string(iteration_));
+  cur_config.append(" iteration_interval:");
+  cur_config.append(std::to_string(iteration_interval_));
   cur_config.append(" input_output:");
   cur_config.append(std::to_string(input_output_));
   cur_config.append("e2e_enable:");
@@ -338,7 +426,32 @@ bool DumpJsonParser::NeedDump(const std::string &op_full_name) const {
     return true;
   }
   auto iter = kernels_.find(op_full_name);
-  return iter != kernels_.end();
+  if (iter != kernels_.end()) {
+    return true;
+  }
+  if (kernels_regex_.empty()) {
+    return false;
+  }
+  // The same kernels are asked for on every dumped step, the regex is run once per kernel
+  std::lock_guard<std::mutex> guard(regex_match_lock_);
+  auto match_iter = regex_match_cache_.find(op_full_name);
+  if (match_iter != regex_match_cache_.end()) {
+    return match_iter->second;
+  }
+  bool match = std::any_of(kernels_regex_.begin(), kernels_regex_.end(), [&op_full_name](const std::regex &pattern) {
+    return std::regex_search(op_full_name, pattern);
+  });
+  (void)regex_match_cache_.emplace(op_full_name, match);
+  return match;
+}
+
+bool DumpJsonParser::IsDumpIter(uint32_t iter) const {
+  if (iteration_interval_ == 0) {
+    return iteration_ == 0 || iter == iteration_;
+  }
+  // With an interval the dump starts at iteration, or at the first one, and repeats every interval steps
+  uint32_t first_iter = iteration_ == 0 ? 1 : iteration_;
+  return iter >= first_iter && (iter - first_iter) % iteration_interval_ == 0;
 }
 
 void DumpJsonParser::MatchKernel(const std::string &kernel_name) {
@@ -21,6 +21,9 @@
 #include <map>
 #include <set>
 #include <mutex>
+#include <regex>
+#include <unordered_map>
+#include <vector>
 #include "nlohmann/json.hpp"
 #include "utils/ms_utils.h"
 #include "backend/session/kernel_graph.h"
@@ -35,6 +38,8 @@ class DumpJsonParser {
   void Parse();
   static bool DumpToFile(const std::string &filename, const void *data, size_t len);
   bool NeedDump(const std::string &op_full_name) const;
+  // Whether iteration iter is dumped, by the iteration and iteration_interval settings
+  bool IsDumpIter(uint32_t iter) const;
   void MatchKernel(const std::string &kernel_name);
   void PrintUnusedKernel();
 
@@ -44,6 +49,7 @@ class DumpJsonParser {
   std::string path() const { return path_; }
   std::string net_name() const { return net_name_; }
   uint32_t iteration() const { return iteration_; }
+  uint32_t iteration_interval() const { return iteration_interval_; }
   uint32_t input_output() const { return input_output_; }
   uint32_t op_debug_mode() const { return op_debug_mode_; }
   bool trans_flag() const { return trans_flag_; }
@@ -67,7 +73,11 @@ class DumpJsonParser {
   std::string net_name_;
   uint32_t iteration_{0};
   uint32_t input_output_{0};
+  uint32_t iteration_interval_{0};
   std::map<std::string, uint32_t> kernels_;
+  std::vector<std::regex> kernels_regex_;
+  mutable std::mutex regex_match_lock_;
+  mutable std::unordered_map<std::string, bool> regex_match_cache_;
   std::set<uint32_t> support_devices_;
   uint32_t op_debug_mode_{0};
   bool trans_flag_{false};
@@ -87,6 +97,9 @@ class DumpJsonParser {
   void ParseIteration(const nlohmann::json &content);
   void ParseInputOutput(const nlohmann::json &content);
   void ParseKernels(const nlohmann::json &content);
+  void ParseKernelsRegex(const nlohmann::json &content);
+  void ParseIterationInterval(const nlohmann::json &content);
+  void ParseDumpWriter(const nlohmann::json &content);
   void ParseSupportDevice(const nlohmann::json &content);
   bool ParseEnable(const nlohmann::json &content);
   void ParseOpDebugMode(const nlohmann::json &content);
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "debug/data_dump/dump_writer.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+
+namespace {
+// gzwrite takes an unsigned length, larger tensors are written in pieces
+constexpr size_t kGzipWriteChunk = 1 << 30;
+constexpr auto kGzipSuffix = ".gz";
+// Level 1, the dump has to keep up with training more than it has to be small
+constexpr auto kGzipWriteMode = "wb1";
+}  // namespace
+
+namespace mindspore {
+DumpWriter::~DumpWriter() {
+  Flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  not_empty_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void DumpWriter::Init(const DumpWriterConfig &config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!workers_.empty()) {
+    MS_LOG(WARNING) << "Dump writer is already initialized.";
+    return;
+  }
+  config_ = config;
+  if (!config_.async) {
+    return;
+  }
+  config_.num_threads = std::max<uint32_t>(config_.num_threads, 1);
+  for (uint32_t i = 0; i < config_.num_threads; ++i) {
+    workers_.emplace_back(&DumpWriter::WorkerLoop, this);
+  }
+  MS_LOG(INFO) << "Async dump writer started, threads:" << config_.num_threads
+               << " buffer size:" << config_.buffer_size;
+}
+
+bool DumpWriter::Write(const std::string &file_path, const void *data, size_t len) {
+  if (!config_.async || len > config_.buffer_size) {
+    return WriteFile(file_path, reinterpret_cast<const char *>(data), len, config_.compression);
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (used_bytes_ + len > config_.buffer_size) {
+    if (config_.full_policy == DumpFullPolicy::kDrop) {
+      MS_LOG(INFO) << "The dump writer falls behind, drop " << file_path;
+      ++dropped_;
+      return true;
+    }
+    not_full_.wait(lock, [this, len]() { return used_bytes_ + len <= config_.buffer_size; });
+  }
+  used_bytes_ += len;
+  auto buffer = TakeBuffer(len);
+  lock.unlock();
+
+  // The copy is the only part of the write left on the step
+  (void)memcpy(buffer.data.get(), data, len);
+
+  lock.lock();
+  ++pending_writes_[epoch_];
+  tasks_.push_back({file_path, std::move(buffer), len, epoch_});
+  lock.unlock();
+  not_empty_.notify_one();
+  return true;
+}
+
+uint64_t DumpWriter::EndIteration(uint32_t iteration) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto dropped = dropped_;
+  ReportDropped("iteration " + std::to_string(iteration));
+  auto last_epoch = epoch_++;
+  idle_.wait(lock, [this, last_epoch]() {
+    return pending_writes_.empty() || pending_writes_.begin()->first >= last_epoch;
+  });
+  return dropped;
+}
+
+void DumpWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this]() { return tasks_.empty() && writing_ == 0; });
+  ReportDropped("the last iteration");
+}
+
+void DumpWriter::ReportDropped(const std::string &when) {
+  if (dropped_ == 0) {
+    return;
+  }
+  MS_LOG(WARNING) << "The dump writer dropped " << dropped_ << " tensors of " << when
+                  << ", raise buffer_size_mb or set when_full to block to keep them.";
+  dropped_ = 0;
+}
+
+DumpWriter::Buffer DumpWriter::TakeBuffer(size_t len) {
+  auto iter = std::find_if(free_buffers_.begin(), free_buffers_.end(),
+                           [len](const Buffer &buffer) { return buffer.capacity >= len; });
+  if (iter == free_buffers_.end()) {
+    Buffer buffer;
+    buffer.data = std::make_unique<char[]>(len);
+    buffer.capacity = len;
+    return buffer;
+  }
+  Buffer buffer = std::move(*iter);
+  (void)free_buffers_.erase(iter);
+  free_bytes_ -= buffer.capacity;
+  return buffer;
+}
+
+void DumpWriter::RecycleBuffer(Buffer buffer) {
+  // Buffers are kept for the next step as long as they fit into the budget together with the ones in use,
+  // the smallest ones go first
+  while (!free_buffers_.empty() && used_bytes_ + free_bytes_ + buffer.capacity > config_.buffer_size) {
+    auto smallest = std::min_element(free_buffers_.begin(), free_buffers_.end(), [](const Buffer &a, const Buffer &b) {
+      return a.capacity < b.capacity;
+    });
+    if (smallest->capacity >= buffer.capacity) {
+      return;
+    }
+    free_bytes_ -= smallest->capacity;
+    (void)free_buffers_.erase(smallest);
+  }
+  if (used_bytes_ + free_bytes_ + buffer.capacity > config_.buffer_size) {
+    return;
+  }
+  free_bytes_ += buffer.capacity;
+  free_buffers_.push_back(std::move(buffer));
+}
+
+void DumpWriter::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    not_empty_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+    if (tasks_.empty()) {
+      return;
+    }
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+    ++writing_;
+    lock.unlock();
+
+    (void)WriteFile(task.file_path, task.buffer.data.get(), task.len, config_.compression);
+
+    lock.lock();
+    --writing_;
+    used_bytes_ -= task.len;
+    RecycleBuffer(std::move(task.buffer));
+    not_full_.notify_all();
+    auto pending = pending_writes_.find(task.epoch);
+    if (pending != pending_writes_.end() && --pending->second == 0) {
+      (void)pending_writes_.erase(pending);
+      idle_.notify_all();
+    }
+  }
+}
+
+bool DumpWriter::WriteFile(const std::string &file_path, const char *data, size_t len, DumpCompression compression) {
+  if (compression == DumpCompression::kZlib) {
+    std::string gz_path = file_path + kGzipSuffix;
+    gzFile gz_file = gzopen(gz_path.c_str(), kGzipWriteMode);
+    if (gz_file == nullptr) {
+      MS_LOG(ERROR) << "Open file " << gz_path << " fail.";
+      return false;
+    }
+    for (size_t offset = 0; offset < len; offset += kGzipWriteChunk) {
+      auto chunk = static_cast<unsigned>(std::min(kGzipWriteChunk, len - offset));
+      if (gzwrite(gz_file, data + offset, chunk) != static_cast<int>(chunk)) {
+        MS_LOG(ERROR) << "Write file " << gz_path << " fail.";
+        (void)gzclose(gz_file);
+        return false;
+      }
+    }
+    return gzclose(gz_file) == Z_OK;
+  }
+  std::ofstream fd;
+  fd.open(file_path, std::ios::binary | std::ios::out);
+  if (!fd.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_path << " fail.";
+    return false;
+  }
+  (void)fd.write(data, SizeToLong(len));
+  fd.close();
+  return true;
+}
+}  // namespace mindspore
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_DUMP_WRITER_H_
+#define MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_DUMP_WRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+enum class DumpCompression { kNone, kZlib };
+
+// What an async write does when the buffers are full
+enum class DumpFullPolicy { kBlock, kDrop };
+
+struct DumpWriterConfig {
+  bool async{false};
+  uint32_t num_threads{2};
+  size_t buffer_size{512 << 20};
+  DumpCompression compression{DumpCompression::kNone};
+  DumpFullPolicy full_policy{DumpFullPolicy::kBlock};
+};
+
+// Writes the tensor files of the e2e dump. In async mode the data is copied into a bounded pool of host buffers and
+// the compression and the file I/O are done by background threads, so a dumped step only pays for the copy.
+class DumpWriter {
+ public:
+  static DumpWriter &GetInstance() {
+    static DumpWriter instance;
+    return instance;
+  }
+
+  void Init(const DumpWriterConfig &config);
+  // Compressed files get a .gz suffix. A dropped write returns true, it is counted and reported instead
+  bool Write(const std::string &file_path, const void *data, size_t len);
+  // Closes the writes of a dumped iteration and reports the tensors it dropped. Waits for the writes of the iteration
+  // before, so at most one iteration is in flight. Returns the number of dropped tensors
+  uint64_t EndIteration(uint32_t iteration);
+  // Waits until every queued write is on disk
+  void Flush();
+
+ private:
+  struct Buffer {
+    std::unique_ptr<char[]> data;
+    size_t capacity{0};
+  };
+  struct Task {
+    std::string file_path;
+    Buffer buffer;
+    size_t len{0};
+    uint64_t epoch{0};
+  };
+
+  DumpWriter() = default;
+  ~DumpWriter();
+  DISABLE_COPY_AND_ASSIGN(DumpWriter)
+
+  Buffer TakeBuffer(size_t len);
+  void RecycleBuffer(Buffer buffer);
+  void WorkerLoop();
+  void ReportDropped(const std::string &when);
+  static bool WriteFile(const std::string &file_path, const char *data, size_t len, DumpCompression compression);
+
+  DumpWriterConfig config_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::condition_variable idle_;
+  std::deque<Task> tasks_;
+  std::vector<Buffer> free_buffers_;
+  // Bytes of the queued and in-flight writes, and the capacity kept in free_buffers_
+  size_t used_bytes_{0};
+  size_t free_bytes_{0};
+  size_t writing_{0};
+  // The writes not yet on disk per epoch, an epoch is the span between two EndIteration calls
+  uint64_t epoch_{0};
+  std::map<uint64_t, size_t> pending_writes_;
+  uint64_t dropped_{0};
+  bool stop_{false};
+  std::vector<std::thread> workers_;
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_DUMP_WRITER_H_
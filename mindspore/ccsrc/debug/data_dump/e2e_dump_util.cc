@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "debug/data_dump/dump_json_parser.h"
+#include "debug/data_dump/dump_writer.h"
 #include "common/trans.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "utils/ms_context.h"
@@ -318,10 +319,8 @@ bool E2eDumpUtil::DumpData(const session::KernelGraph *graph, uint32_t device_id
   }
   MS_LOG(INFO) << "E2e dump data start";
 
-  if (dump_json_parser.iteration() != 0) {
-    if (dump_json_parser.cur_dump_iter() != dump_json_parser.iteration()) {
-      return true;
-    }
+  if (!dump_json_parser.IsDumpIter(dump_json_parser.cur_dump_iter())) {
+    return true;
   }
   MS_LOG(INFO) << "Start e2e dump. Current iteration is " << dump_json_parser.cur_dump_iter();
   auto physical_device = ConvertPhysicalDeviceId(device_id);
@@ -336,6 +335,7 @@ bool E2eDumpUtil::DumpData(const session::KernelGraph *graph, uint32_t device_id
   DumpInput(graph, dump_path, debugger);
   DumpOutput(graph, dump_path, debugger);
   DumpParametersAndConst(graph, dump_path, debugger);
+  (void)DumpWriter::GetInstance().EndIteration(dump_json_parser.cur_dump_iter());
   return true;
 }
 }  // namespace mindspore
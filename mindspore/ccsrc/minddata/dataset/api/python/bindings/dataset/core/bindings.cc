@@ -49,6 +49,14 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
                     .def("get_callback_timeout", &ConfigManager::callback_timeout)
                     .def("set_callback_timeout", &ConfigManager::set_callback_timeout)
+                    .def("get_lock_free_connector", &ConfigManager::lock_free_connector)
+                    .def("set_lock_free_connector", &ConfigManager::set_lock_free_connector)
+                    .def("get_mindrecord_mmap", &ConfigManager::mindrecord_mmap)
+                    .def("set_mindrecord_mmap", &ConfigManager::set_mindrecord_mmap)
+                    .def("get_enable_autotune", &ConfigManager::enable_autotune)
+                    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+                    .def("get_autotune_interval", &ConfigManager::autotune_interval)
+                    .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
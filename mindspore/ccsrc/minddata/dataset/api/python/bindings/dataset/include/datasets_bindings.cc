@@ -300,26 +300,26 @@ PYBIND_REGISTER(
       .def(py::init([](py::list dataset_files, std::shared_ptr<SchemaObj> schema, std::optional<py::list> columns_list,
                        std::optional<int64_t> num_samples, int32_t shuffle, std::optional<int32_t> num_shards,
                        std::optional<int32_t> shard_id, bool shard_equal_rows,
-                       std::optional<std::shared_ptr<CacheClient>> cc) {
+                       std::optional<std::shared_ptr<CacheClient>> cc, std::string compression_type, bool verify_crc) {
         if (!num_samples) {
           *num_samples = 0;
         }
         std::shared_ptr<TFRecordNode> tfrecord = std::make_shared<TFRecordNode>(
           toStringVector(dataset_files), schema, toStringVector(columns_list), *num_samples, toShuffleMode(shuffle),
-          *num_shards, *shard_id, shard_equal_rows, toDatasetCache(std::move(cc)));
+          *num_shards, *shard_id, shard_equal_rows, toDatasetCache(std::move(cc)), compression_type, verify_crc);
         THROW_IF_ERROR(tfrecord->ValidateParams());
         return tfrecord;
       }))
       .def(py::init([](py::list dataset_files, std::string schema, std::optional<py::list> columns_list,
                        std::optional<int64_t> num_samples, int32_t shuffle, std::optional<int32_t> num_shards,
                        std::optional<int32_t> shard_id, bool shard_equal_rows,
-                       std::optional<std::shared_ptr<CacheClient>> cc) {
+                       std::optional<std::shared_ptr<CacheClient>> cc, std::string compression_type, bool verify_crc) {
         if (!num_samples) {
           *num_samples = 0;
         }
         std::shared_ptr<TFRecordNode> tfrecord = std::make_shared<TFRecordNode>(
           toStringVector(dataset_files), schema, toStringVector(columns_list), *num_samples, toShuffleMode(shuffle),
-          *num_shards, *shard_id, shard_equal_rows, toDatasetCache(std::move(cc)));
+          *num_shards, *shard_id, shard_equal_rows, toDatasetCache(std::move(cc)), compression_type, verify_crc);
         THROW_IF_ERROR(tfrecord->ValidateParams());
         return tfrecord;
       }));
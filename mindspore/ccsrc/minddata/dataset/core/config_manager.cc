@@ -40,7 +40,11 @@ ConfigManager::ConfigManager()
       cache_host_(kCfgDefaultCacheHost),
       cache_port_(kCfgDefaultCachePort),
       num_connections_(kDftNumConnections),
-      prefetch_size_(kDftPrefetchSize) {
+      prefetch_size_(kDftPrefetchSize),
+      lock_free_connector_(kCfgLockFreeConnector),
+      mindrecord_mmap_(kCfgMindRecordMmap),
+      enable_autotune_(kCfgEnableAutoTune),
+      autotune_interval_(kCfgAutoTuneInterval) {
   auto env_cache_host = std::getenv("MS_CACHE_HOST");
   auto env_cache_port = std::getenv("MS_CACHE_PORT");
   if (env_cache_host != nullptr) {
@@ -80,6 +84,10 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_cache_port(j.value("cachePort", cache_port_));
   set_num_connections(j.value("numConnections", num_connections_));
   set_prefetch_size(j.value("prefetchSize", prefetch_size_));
+  set_lock_free_connector(j.value("lockFreeConnector", lock_free_connector_));
+  set_mindrecord_mmap(j.value("mindrecordMmap", mindrecord_mmap_));
+  set_enable_autotune(j.value("enableAutoTune", enable_autotune_));
+  set_autotune_interval(j.value("autoTuneInterval", autotune_interval_));
   return Status::OK();
 }
 
@@ -136,5 +144,13 @@ void ConfigManager::set_cache_port(int32_t cache_port) { cache_port_ = cache_por
 void ConfigManager::set_num_connections(int32_t num_connections) { num_connections_ = num_connections; }
 
 void ConfigManager::set_prefetch_size(int32_t prefetch_size) { prefetch_size_ = prefetch_size; }
+
+void ConfigManager::set_lock_free_connector(bool lock_free) { lock_free_connector_ = lock_free; }
+
+void ConfigManager::set_mindrecord_mmap(bool mmap) { mindrecord_mmap_ = mmap; }
+
+void ConfigManager::set_enable_autotune(bool enable) { enable_autotune_ = enable; }
+
+void ConfigManager::set_autotune_interval(uint32_t interval) { autotune_interval_ = interval; }
 }  // namespace dataset
 }  // namespace mindspore
@@ -159,6 +159,38 @@ class ConfigManager {
   // @return The timeout DSWaitedCallback would wait for before raising an error
   int32_t callback_timeout() const { return callback_timout_; }
 
+  // setter function
+  // @param lock_free - Whether connectors created from now on use lock free queues
+  void set_lock_free_connector(bool lock_free);
+
+  // getter function
+  // @return Whether operator and worker connectors use lock free queues
+  bool lock_free_connector() const { return lock_free_connector_; }
+
+  // setter function
+  // @param mmap - Whether MindRecord files opened from now on are mapped into memory instead of read per row
+  void set_mindrecord_mmap(bool mmap);
+
+  // getter function
+  // @return Whether MindRecord files are mapped into memory
+  bool mindrecord_mmap() const { return mindrecord_mmap_; }
+
+  // setter function
+  // @param enable - Whether pipelines launched from now on adjust their workers to the consumer while they run
+  void set_enable_autotune(bool enable);
+
+  // getter function
+  // @return Whether pipelines are autotuned
+  bool enable_autotune() const { return enable_autotune_; }
+
+  // setter function
+  // @param interval - The time in milliseconds between two adjustments of an autotuned pipeline
+  void set_autotune_interval(uint32_t interval);
+
+  // getter function
+  // @return The time in milliseconds between two adjustments of an autotuned pipeline
+  uint32_t autotune_interval() const { return autotune_interval_; }
+
  private:
   int32_t rows_per_buffer_;
   int32_t num_parallel_workers_;
@@ -171,6 +203,10 @@ class ConfigManager {
   int32_t cache_port_;
   int32_t num_connections_;
   int32_t prefetch_size_;
+  bool lock_free_connector_;
+  bool mindrecord_mmap_;
+  bool enable_autotune_;
+  uint32_t autotune_interval_;
 
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
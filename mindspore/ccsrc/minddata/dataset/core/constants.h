@@ -89,6 +89,10 @@ constexpr uint32_t kCfgMonitorSamplingInterval = 10;
 constexpr uint32_t kCfgCallbackTimeout = 60;  // timeout value for callback in seconds
 constexpr int32_t kCfgDefaultCachePort = 50052;
 constexpr char kCfgDefaultCacheHost[] = "127.0.0.1";
+constexpr bool kCfgLockFreeConnector = false;
+constexpr bool kCfgMindRecordMmap = false;
+constexpr bool kCfgEnableAutoTune = false;
+constexpr uint32_t kCfgAutoTuneInterval = 1000;  // time between two autotune adjustments in milliseconds
 constexpr int32_t kDftPrefetchSize = 20;
 constexpr int32_t kDftNumConnections = 12;
 
@@ -115,6 +115,17 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor that borrows read-only memory owned by someone else instead of copying it. The tensor
+  /// keeps owner alive and never frees src. It must not be modified: MapOp copies it before running ops on it.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor, must be numeric
+  /// \param[in] src pointer to the source data, aligned to the size of type
+  /// \param[in] owner object that keeps src valid for the lifetime of the tensor
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromBorrowedMemory(const TensorShape &shape, const DataType &type, const uchar *src,
+                                         std::shared_ptr<void> owner, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -304,6 +315,10 @@ class Tensor {
   /// \return bool - true if tensor is not empty
   bool HasData() const { return data_ != nullptr; }
 
+  /// Check if the tensor borrows read-only memory, see CreateFromBorrowedMemory
+  /// \return bool - true if the data is borrowed
+  bool IsBorrowed() const { return data_owner_ != nullptr; }
+
   /// Reshape the tensor. The given shape should have the same number of elements in the Tensor
   /// \param shape
   virtual Status Reshape(const TensorShape &shape);
@@ -684,6 +699,8 @@ class Tensor {
   CharAllocPtr data_allocator_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  /// owner of borrowed data_, data_ is not freed by this tensor when set
+  std::shared_ptr<void> data_owner_ = nullptr;
 
  private:
 #ifdef ENABLE_ANDROID
@@ -740,8 +757,8 @@ inline Tensor::TensorIterator<std::string_view> Tensor::end<std::string_view>()
 /// \param[out] out output argument to hold the created Tensor
 /// \return Status Code
 template <>
-inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::string> &items, const TensorShape &shape,
-                                                    TensorPtr *out) {
+inline Status Tensor::CreateFromVector<std::string_view>(const std::vector<std::string_view> &items,
+                                                         const TensorShape &shape, TensorPtr *out) {
   CHECK_FAIL_RETURN_UNEXPECTED(
     items.size() == shape.NumOfElements(),
     "Number of elements in the vector does not match the number of elements of the shape required");
@@ -753,7 +770,7 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
       return (*out)->Reshape(shape);
     }
   }
-  auto length_sum = [](dsize_t sum, const std::string &s) { return s.length() + sum; };
+  auto length_sum = [](dsize_t sum, const std::string_view &s) { return s.length() + sum; };
   dsize_t total_length = std::accumulate(items.begin(), items.end(), 0, length_sum);
 
   // total bytes needed = offset array + strings
@@ -773,8 +790,11 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
     // total bytes are reduced by kOffsetSize
     num_bytes -= kOffsetSize;
     // insert actual string
-    int ret_code = memcpy_s((*out)->data_ + offset, num_bytes, common::SafeCStr(str), str.length() + 1);
-    if (ret_code != 0) MS_LOG(ERROR) << "Cannot copy string into Tensor";
+    if (!str.empty()) {
+      int ret_code = memcpy_s((*out)->data_ + offset, num_bytes, str.data(), str.length());
+      if (ret_code != 0) MS_LOG(ERROR) << "Cannot copy string into Tensor";
+    }
+    (*out)->data_[offset + str.length()] = '\0';
     //  next string will be stored right after the current one.
     offset = offset + str.length() + 1;
     // total bytes are reduced by the length of the string
@@ -791,6 +811,14 @@ inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::strin
   }
   return Status::OK();
 }
+
+/// Create a Tensor from a given list of strings, see the list of string views above.
+template <>
+inline Status Tensor::CreateFromVector<std::string>(const std::vector<std::string> &items, const TensorShape &shape,
+                                                    TensorPtr *out) {
+  std::vector<std::string_view> views(items.begin(), items.end());
+  return CreateFromVector<std::string_view>(views, shape, out);
+}
 /// Create a string scalar Tensor from the given value.
 /// \param[in] item value
 /// \param[out] out Created tensor
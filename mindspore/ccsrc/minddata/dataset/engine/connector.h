@@ -21,6 +21,7 @@
 #include <utility>
 #include <vector>
 #include "minddata/dataset/util/task_manager.h"
+#include "minddata/dataset/util/lock_free_queue.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
@@ -71,7 +72,8 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
+  // @param lock_free Use LockFreeQueue instead of the mutex based Queue for the internal queues.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
       : num_producers_(n_producers), num_consumers_(n_consumers) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
@@ -84,7 +86,11 @@ class Connector {
 
     // Initialize the queues_ to have num_producers_ number of queues.
     // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    if (lock_free) {
+      queues_.template Init<LockFreeQueue<T>>(num_producers_, queue_capacity);
+    } else {
+      queues_.Init(num_producers_, queue_capacity);
+    }
   }
 
   // Destructor of Connector
@@ -40,7 +40,8 @@ class DataBuffer {
     kDeBFlagEOF = 1,         // The buffer is an eof end-of-data msg
     kDeBFlagEOE = 1u << 1,   // The buffer is an eoe end-of-epoch msg
     kDeBFlagWait = 1u << 2,  // The buffer is an control signal for workers to suspend operations
-    kDeBFlagQuit = 1u << 3   // The buffer is a control signal for workers to quit
+    kDeBFlagQuit = 1u << 3,  // The buffer is a control signal for workers to quit
+    kDeBFlagActiveProducers = 1u << 4  // The buffer is a control signal that id() producers are active from now on
   };
 
   // Name: Constructor #1
@@ -70,6 +71,10 @@ class DataBuffer {
 
   bool quit() const { return (static_cast<uint32_t>(buffer_flags_) & static_cast<uint32_t>(kDeBFlagQuit)); }
 
+  bool active_producers() const {
+    return (static_cast<uint32_t>(buffer_flags_) & static_cast<uint32_t>(kDeBFlagActiveProducers));
+  }
+
   // Simple getter funcs
   int32_t id() const { return buffer_id_; }
 
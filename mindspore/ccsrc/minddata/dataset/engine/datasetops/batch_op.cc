@@ -25,6 +25,7 @@
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/engine/perf/dataset_op_tracing.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
 
 namespace mindspore {
@@ -75,9 +76,7 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       out_col_names_(out_col),
       batch_size_func_(batch_size_func),
       batch_map_func_(batch_map_func),
-      pad_info_(pad_map) {
-  worker_queues_.Init(num_workers, op_queue_size);
-}
+      pad_info_(pad_map) {}
 // if PYTHON is disabled. per_batch_map can't be used
 #else
 BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size, int32_t num_workers,
@@ -87,9 +86,7 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       drop_(drop),
       pad_(pad),
       in_col_names_(cols_to_map),
-      pad_info_(pad_map) {
-  worker_queues_.Init(num_workers, op_queue_size);
-}
+      pad_info_(pad_map) {}
 #endif
 
 Status BatchOp::operator()() {
@@ -109,8 +106,7 @@ Status BatchOp::operator()() {
       table->emplace_back(new_row);
       // if # of rows is enough to make 1 batch (1 batch is buffer), send it to worker_queue
       if (table->size() == static_cast<size_t>(cur_batch_size)) {
-        RETURN_IF_NOT_OK(worker_queues_[cnt % num_workers_]->EmplaceBack(
-          std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
+        RETURN_IF_NOT_OK(AddToNextWorker(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num)));
         cnt++;
         table = std::make_unique<TensorQTable>();
         RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
@@ -119,29 +115,37 @@ Status BatchOp::operator()() {
     }
     // Reminder logic, execute only when there is a remainder (table is non empty) and don't drop
     if (drop_ == false && table->empty() == false) {
-      RETURN_IF_NOT_OK(worker_queues_[cnt % num_workers_]->EmplaceBack(
-        std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
+      RETURN_IF_NOT_OK(AddToNextWorker(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num)));
       cnt++;
     }
     table = std::make_unique<TensorQTable>();  // this drops when drop == true
     // end of the current epoch, batch_num should start from 0 again
     batch_num = 0;
     epoch_num++;
-    RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
+    RETURN_IF_NOT_OK(AddToNextWorker(nullptr, CBatchInfo(batchCtrl::kEOE)));
+    cnt++;
     RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }  // end of eof_handled() == false
-  RETURN_IF_NOT_OK(
-    worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOF))));
+  RETURN_IF_NOT_OK(AddToNextWorker(nullptr, CBatchInfo(batchCtrl::kEOF)));
   // EOF received, send quit signal (an empty buffer) to all workers
   for (int32_t ind = 0; ind < num_workers_; ind++) {
-    RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
+    RETURN_IF_NOT_OK(worker_queues_[ind]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
   }
   return Status::OK();
 }
 
+Status BatchOp::AddToNextWorker(std::unique_ptr<TensorQTable> table, CBatchInfo info) {
+  int32_t new_active = 0;
+  int32_t worker_id = NextWorker(&new_active);
+  if (new_active > 0) {
+    // The worker passes this on to the output connector ahead of the batch
+    RETURN_IF_NOT_OK(worker_queues_[worker_id]->EmplaceBack(
+      std::make_pair(nullptr, CBatchInfo(0, new_active, 0, batchCtrl::kActiveWorkers))));
+  }
+  return worker_queues_[worker_id]->EmplaceBack(std::make_pair(std::move(table), info));
+}
+
 void BatchOp::Print(std::ostream &out, bool show_all) const {
   if (!show_all) {
     // Call the super class for displaying any common 1-liner info
@@ -217,6 +221,12 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
 
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
+  std::shared_ptr<DatasetOpTracing> profiling_node;
+  if (tree_->GetProfilingManager()->IsProfilingEnable()) {
+    std::shared_ptr<Tracing> node;
+    RETURN_IF_NOT_OK(tree_->GetProfilingManager()->GetTracingNode(kDatasetOpTracingName, &node));
+    profiling_node = std::dynamic_pointer_cast<DatasetOpTracing>(node);
+  }
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
   RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
   while (table_pair.second.ctrl_ != batchCtrl::kQuit) {
@@ -224,9 +234,17 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kEOF) {
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
+    } else if (table_pair.second.ctrl_ == batchCtrl::kActiveWorkers) {
+      RETURN_IF_NOT_OK(out_connector_->Add(
+        workerId, std::make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagActiveProducers)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       std::unique_ptr<DataBuffer> db = nullptr;
+      int64_t start_time = profiling_node != nullptr ? ProfilingTime::GetCurMicroSecond() : 0;
       RETURN_IF_NOT_OK(MakeBatchedBuffer(std::move(table_pair), &db));
+      if (profiling_node != nullptr) {
+        RETURN_IF_NOT_OK(
+          profiling_node->Record(NameWithID(), workerId, start_time, ProfilingTime::GetCurMicroSecond()));
+      }
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::move(db)));
     }
     RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
@@ -252,6 +270,8 @@ Status BatchOp::LaunchThreadsAndInitOp() {
   if (tree_ == nullptr) {
     return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Pipeline init failed, Execution tree not set.");
   }
+  // The workers are known only now, ParallelOp::ReserveWorkers() may have added some
+  worker_queues_.Init(num_workers_, oc_queue_size_);
   RETURN_IF_NOT_OK(worker_queues_.Register(tree_->AllTasks()));
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_, std::bind(&BatchOp::WorkerEntry, this, std::placeholders::_1)));
   return Status::OK();
@@ -134,7 +134,7 @@ class BatchOp : public ParallelOp {
 #endif
   };
 
-  enum batchCtrl : int8_t { kNoCtrl = 0, kEOE = 1, kEOF = 2, kQuit = 3 };
+  enum batchCtrl : int8_t { kNoCtrl = 0, kEOE = 1, kEOF = 2, kQuit = 3, kActiveWorkers = 4 };
 
   // Parameters associate with one batch.
   // This struct is used for both internal control and python callback.
@@ -148,7 +148,7 @@ class BatchOp : public ParallelOp {
     int64_t epoch_num_;        // i-th epoch. i starts from 0
     int64_t batch_num_;        // i-th batch since the start of current epoch. i starts from 0
     int64_t total_batch_num_;  // i-th batch since the start of first epoch. i starts from 0
-    batchCtrl ctrl_;           // No control=0, EOE=1, EOF=2, Quit=3
+    batchCtrl ctrl_;           // No control=0, EOE=1, EOF=2, Quit=3, ActiveWorkers=4 (count in batch_num_)
     const int64_t get_batch_num() const { return batch_num_; }
     const int64_t get_epoch_num() const { return epoch_num_; }
   };
@@ -227,6 +227,9 @@ class BatchOp : public ParallelOp {
 
   int64_t GetTreeBatchSize() override;
 
+  // The master hands out batches round robin, so the number of active workers can be changed while it runs
+  bool ActiveWorkersAdjustable() const override { return true; }
+
  protected:
   Status ComputeColMap() override;
 
@@ -263,6 +266,10 @@ class BatchOp : public ParallelOp {
   // @return int32_t, 1
   int32_t num_consumers() const override { return 1; }
 
+  // hand a batch or control message to the next of the active workers
+  // @return Status - The error code return
+  Status AddToNextWorker(std::unique_ptr<TensorQTable> table, CBatchInfo info);
+
   // get the batch size for next batch
   // @return Status - The error code return
   Status GetBatchSize(int32_t *batch_size, CBatchInfo info);
@@ -27,6 +27,7 @@
 #include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
 #include "minddata/dataset/engine/datasetops/map_op/gpu_map_job.h"
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/engine/perf/dataset_op_tracing.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -160,8 +161,8 @@ Status MapOp::operator()() {
   // Synchronize with TaskManager
   TaskManager::FindMe()->Post();
   RETURN_IF_NOT_OK(rc);
-  // num_buffers received, including eoe, num_epoch, num_step of current epoch
-  int64_t num_buf = 0, ep_step = 0, total_step = 0;
+  // num_epoch, num_step of current epoch
+  int64_t ep_step = 0, total_step = 0;
 
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
@@ -185,7 +186,7 @@ Status MapOp::operator()() {
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
 
       // Push map worker job to the corresponding worker's queue
-      RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
+      RETURN_IF_NOT_OK(AddToNextWorker(std::move(worker_job)));
 
       RETURN_IF_NOT_OK(callback_manager_.StepEnd(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
@@ -200,24 +201,35 @@ Status MapOp::operator()() {
     }
     // Propagate the eoe buffer to worker
     std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
-    RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
+    RETURN_IF_NOT_OK(AddToNextWorker(std::move(worker_job)));
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(&buff, 0));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
   std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
-  RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
+  RETURN_IF_NOT_OK(AddToNextWorker(std::move(worker_job)));
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
     auto quit = std::make_unique<MapWorkerJob>(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagQuit));
-    RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(quit)));
+    RETURN_IF_NOT_OK(local_queues_[wkr_id]->Add(std::move(quit)));
   }
 
   return Status::OK();
 }
 
+Status MapOp::AddToNextWorker(std::unique_ptr<MapWorkerJob> worker_job) {
+  int32_t new_active = 0;
+  int32_t worker_id = NextWorker(&new_active);
+  if (new_active > 0) {
+    // The worker passes this on to the output connector ahead of the job
+    RETURN_IF_NOT_OK(local_queues_[worker_id]->Add(std::make_unique<MapWorkerJob>(
+      std::make_unique<DataBuffer>(new_active, DataBuffer::kDeBFlagActiveProducers))));
+  }
+  return local_queues_[worker_id]->Add(std::move(worker_job));
+}
+
 // Private function for worker/thread to loop continuously. It comprises the main
 // logic of MapOp: getting the data from previous Op, validating user specified column names,
 // applying a list of TensorOps to each of the data, process the results and then
@@ -226,6 +238,12 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   // Handshake with TaskManager that thread creation is successful.
   TaskManager::FindMe()->Post();
 
+  std::shared_ptr<DatasetOpTracing> profiling_node;
+  if (tree_->GetProfilingManager()->IsProfilingEnable()) {
+    std::shared_ptr<Tracing> node;
+    RETURN_IF_NOT_OK(tree_->GetProfilingManager()->GetTracingNode(kDatasetOpTracingName, &node));
+    profiling_node = std::dynamic_pointer_cast<DatasetOpTracing>(node);
+  }
   std::unique_ptr<DataBuffer> in_buffer;
   std::vector<std::shared_ptr<MapJob>> job_list;
   // Fetch next data buffer and map job list
@@ -252,6 +270,8 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
         RETURN_IF_NOT_OK(EofReceived(worker_id));
       } else if (in_buffer->quit()) {
         break;
+      } else if (in_buffer->active_producers()) {
+        RETURN_IF_NOT_OK(out_connector_->Add(static_cast<int>(worker_id), std::move(in_buffer)));
       }
       RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_buffer, &job_list));
       continue;
@@ -259,7 +279,11 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     CHECK_FAIL_RETURN_UNEXPECTED(in_buffer->NumRows() * in_buffer->NumCols() != 0, "MapOp got an empty DataBuffer.");
     std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
+    int64_t start_time = profiling_node != nullptr ? ProfilingTime::GetCurMicroSecond() : 0;
     RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), new_tensor_table.get(), job_list));
+    if (profiling_node != nullptr) {
+      RETURN_IF_NOT_OK(profiling_node->Record(NameWithID(), worker_id, start_time, ProfilingTime::GetCurMicroSecond()));
+    }
     // Replace the TensorTable in DataBuffer with the new one.
     in_buffer->set_tensor_table(std::move(new_tensor_table));
     // Push the buffer onto the connector for next operator to consume.
@@ -284,9 +308,17 @@ Status MapOp::WorkerCompute(DataBuffer *in_buffer, TensorQTable *new_tensor_tabl
     // cur_row      : A vector of Tensors holding all the cols from DataBuffer.
     TensorRow to_process, cur_row;
     RETURN_IF_NOT_OK(in_buffer->PopRow(&cur_row));
-    // From the current row, select the Tensor that need to be passed to TensorOp
-    (void)std::transform(to_process_indices_.begin(), to_process_indices_.end(), std::back_inserter(to_process),
-                         [&cur_row](const auto &it) { return std::move(cur_row[it]); });
+    // From the current row, select the Tensor that need to be passed to TensorOp. TensorOps may modify their input in
+    // place, so a tensor over borrowed read-only memory is copied first.
+    for (const auto &it : to_process_indices_) {
+      std::shared_ptr<Tensor> tensor = std::move(cur_row[it]);
+      if (tensor != nullptr && tensor->IsBorrowed()) {
+        std::shared_ptr<Tensor> copied;
+        RETURN_IF_NOT_OK(Tensor::CreateFromTensor(tensor, &copied));
+        tensor = std::move(copied);
+      }
+      to_process.push_back(std::move(tensor));
+    }
     job_input_table.push_back(std::move(to_process));
     original_table.push_back(std::move(cur_row));
   }
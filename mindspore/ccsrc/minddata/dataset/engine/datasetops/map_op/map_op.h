@@ -200,6 +200,9 @@ class MapOp : public ParallelOp {
 
   const auto &TFuncs() const { return tfuncs_; }
 
+  // The master hands out buffers round robin, so the number of active workers can be changed while it runs
+  bool ActiveWorkersAdjustable() const override { return true; }
+
  private:
   // A unit of job for map worker thread.
   // MapWorkerJob holds a list of MapJob where each MapJob can be a CpuMapJob, GpuMapJob or DvppMapJob.
@@ -212,6 +215,9 @@ class MapOp : public ParallelOp {
   // A helper function to create jobs for workers.
   Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job);
 
+  // A helper function that hands a job to the next of the active workers
+  Status AddToNextWorker(std::unique_ptr<MapWorkerJob> worker_job);
+
   // A helper function that fetch worker map job from local queues and extract the data and map job list
   Status FetchNextWork(uint32_t worker_id, std::unique_ptr<DataBuffer> *db,
                        std::vector<std::shared_ptr<MapJob>> *job_list);
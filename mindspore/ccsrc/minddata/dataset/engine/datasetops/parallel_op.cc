@@ -20,6 +20,7 @@
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 
@@ -33,7 +34,10 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size, std::shar
       worker_connector_size_(1),
       worker_connector_(nullptr),
       num_workers_paused_(0),
-      epoch_sync_flag_(false) {}
+      epoch_sync_flag_(false),
+      target_workers_(num_workers),
+      active_workers_(num_workers),
+      next_worker_(0) {}
 
 // Creates the internal worker connector for the parallel op if the derived class wants to use it
 Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
@@ -45,7 +49,8 @@ Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
   // Instantiate the worker connector.  This is the internal connector, not the operators
   // output connector.  It has single master consuming from it (num producers is 1), and the number
   // of workers is the defined count from the op.
-  worker_connector_ = std::make_unique<DbConnector>(num_workers_, num_producers_, worker_connector_size);
+  worker_connector_ = std::make_unique<DbConnector>(num_workers_, num_producers_, worker_connector_size,
+                                                    GlobalContext::config_manager()->lock_free_connector());
 
   return Status::OK();
 }
@@ -77,6 +82,31 @@ Status ParallelOp::RegisterWorkerConnectors() {
   return Status::OK();
 }
 
+void ParallelOp::ReserveWorkers(int32_t max_workers) {
+  if (max_workers <= num_workers_) {
+    return;
+  }
+  // The master still hands work to the workers the op was built with, it announces that with its first job
+  num_workers_ = max_workers;
+  num_producers_ = max_workers;
+  active_workers_ = max_workers;
+}
+
+int32_t ParallelOp::NextWorker(int32_t *new_active) {
+  *new_active = 0;
+  // A new count only takes effect at the start of a round, so the consumers can follow it
+  if (next_worker_ == 0) {
+    int32_t target = target_workers_;
+    if (target != active_workers_) {
+      active_workers_ = target;
+      *new_active = target;
+    }
+  }
+  int32_t worker_id = next_worker_;
+  next_worker_ = (next_worker_ + 1) % active_workers_;
+  return worker_id;
+}
+
 Status ParallelOp::WaitForWorkers() {
   num_workers_paused_ = 0;
   for (int32_t i = 0; i < num_workers_; i++) {
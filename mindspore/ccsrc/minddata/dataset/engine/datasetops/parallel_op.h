@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -112,6 +113,23 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  /// \brief Whether the master of the op hands out work round robin and follows SetActiveWorkers().
+  virtual bool ActiveWorkersAdjustable() const { return false; }
+
+  /// \brief Launches max_workers threads instead of num_workers() when that is more, so SetActiveWorkers() can go
+  ///     above the num_workers the op was built with. Only the workers it was built with get work until then, the
+  ///     others stay idle. Must be called before the tree is prepared.
+  /// \param[in] max_workers The number of threads to launch.
+  void ReserveWorkers(int32_t max_workers);
+
+  /// \brief Sets how many of the workers get work while the op runs, from 1 to num_workers(). The master applies
+  ///     it when it starts its next round over the workers, the other workers stay idle until they get work again.
+  /// \param[in] n The number of workers that get work.
+  void SetActiveWorkers(int32_t n) { target_workers_ = std::min(std::max(n, 1), num_workers_); }
+
+  /// \brief The number of workers that get work, as last set by SetActiveWorkers().
+  int32_t active_workers() const { return target_workers_; }
+
  protected:
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
@@ -125,6 +143,14 @@ class ParallelOp : public DatasetOp {
   /// \return Status
   Status WaitForWorkers() override;
 
+  /// \brief Picks the worker for the next job of a master that hands out work round robin over the active workers.
+  /// \param[out] new_active Set to the new number of active workers when it takes effect with this job, 0 otherwise.
+  ///     Worker 0 gets the job then, and the master has to send it a kDeBFlagActiveProducers buffer with id
+  ///     *new_active ahead of the job. The worker pushes that buffer to out_connector_ before its output of the job,
+  ///     so the consumers know from which point on only the first *new_active queues are filled.
+  /// \return The id of the worker.
+  int32_t NextWorker(int32_t *new_active);
+
   // Wait post used to perform the pausing logic
   WaitPost wait_for_workers_post_;
 
@@ -139,6 +165,11 @@ class ParallelOp : public DatasetOp {
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;        // The internal connector for worker threads
   QueueList<std::unique_ptr<IOBlock>> io_block_queues_;  // queues of IOBlocks
+
+ private:
+  std::atomic_int target_workers_;  // The number of workers to hand work out to, set by SetActiveWorkers()
+  int32_t active_workers_;          // The number of workers the master hands work out to
+  int32_t next_worker_;             // The worker of the next job
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -138,6 +138,9 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
   shard_reader_ = std::make_unique<ShardReader>();
+  if (GlobalContext::config_manager()->mindrecord_mmap()) {
+    shard_reader_->SetReadMode(mindrecord::ShardReadMode::kMmap);
+  }
   auto rc = shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_, operators_,
                                 num_padded_);
 
@@ -278,7 +281,7 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
     int32_t row_id = buffer_id * rows_per_buffer_ + i;
-    auto rc = shard_reader_->GetNextById(row_id, worker_id);
+    auto rc = shard_reader_->GetNextRefById(row_id, worker_id);
     auto task_type = rc.first;
     auto tupled_buffer = rc.second;
     if (task_type == mindrecord::TaskType::kPaddedTask) {
@@ -289,8 +292,8 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
     if (tupled_buffer.empty()) break;
     if (task_type == mindrecord::TaskType::kCommonTask) {
       for (const auto &tupled_row : tupled_buffer) {
-        std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-        mindrecord::json columns_json = std::get<1>(tupled_row);
+        const mindrecord::ShardBlobRef &columns_blob = std::get<0>(tupled_row);
+        const mindrecord::json &columns_json = std::get<1>(tupled_row);
         TensorRow tensor_row;
         RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, columns_blob, columns_json, task_type));
         tensor_table->push_back(std::move(tensor_row));
@@ -303,7 +306,7 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobRef &columns_blob,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   for (uint32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -345,8 +348,9 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       }
     } else {
       auto has_column =
-        shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr, &n_bytes,
-                                           &column_data_type, &column_data_type_size, &column_shape);
+        shard_column->GetColumnValueByName(column_name, columns_blob.data, columns_blob.size, columns_json, &data,
+                                           &data_ptr, &n_bytes, &column_data_type, &column_data_type_size,
+                                           &column_shape);
       if (has_column == MSRStatus::FAILED) {
         RETURN_STATUS_UNEXPECTED("Invalid data, failed to retrieve data from mindrecord reader.");
       }
@@ -365,17 +369,28 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
     } else if (column.hasShape()) {
       auto new_shape = TensorShape(column.shape());
       RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      RETURN_IF_NOT_OK(CreateTensorFromBlob(new_shape, type, data, columns_blob, &tensor));
     } else {
       std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
       auto new_shape = TensorShape(shapeDetails);
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      RETURN_IF_NOT_OK(CreateTensorFromBlob(new_shape, type, data, columns_blob, &tensor));
     }
     tensor_row->push_back(std::move(tensor));
   }
   return Status::OK();
 }
 
+Status MindRecordOp::CreateTensorFromBlob(const TensorShape &shape, const DataType &type, const unsigned char *data,
+                                          const mindrecord::ShardBlobRef &columns_blob,
+                                          std::shared_ptr<Tensor> *tensor) {
+  bool in_blob = columns_blob.owner != nullptr && data >= columns_blob.data &&
+                 data < columns_blob.data + columns_blob.size;
+  if (in_blob && type.IsNumeric() && reinterpret_cast<uintptr_t>(data) % type.SizeInBytes() == 0) {
+    return Tensor::CreateFromBorrowedMemory(shape, type, data, columns_blob.owner, tensor);
+  }
+  return Tensor::CreateFromMemory(shape, type, data, tensor);
+}
+
 // Class functor operator () override.
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
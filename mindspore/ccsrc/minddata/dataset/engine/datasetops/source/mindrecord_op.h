@@ -219,9 +219,19 @@ class MindRecordOp : public ParallelOp {
   // @param tensor_row - the tensor row to put the parsed data in
   // @param columns_blob - the blob data received from the reader
   // @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, const mindrecord::ShardBlobRef &columns_blob,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
+  // Creates a numeric tensor over the blob data without a copy when the data lies in the blob and is aligned for the
+  // type, otherwise copies it
+  // @param shape - the shape of the tensor
+  // @param type - the type of the tensor
+  // @param data - the column data, either in the blob or in a decompressed buffer
+  // @param columns_blob - the blob data received from the reader
+  // @param tensor - the created tensor
+  Status CreateTensorFromBlob(const TensorShape &shape, const DataType &type, const unsigned char *data,
+                              const mindrecord::ShardBlobRef &columns_blob, std::shared_ptr<Tensor> *tensor);
+
   // Private function for computing the assignment of the column name map.
   // @return - Status
   Status ComputeColMap() override;
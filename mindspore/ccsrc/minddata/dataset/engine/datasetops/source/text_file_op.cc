@@ -132,7 +132,8 @@ Status TextFileOp::Init() {
 
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
 
-  jagged_buffer_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
+  jagged_buffer_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_,
+                                                               GlobalContext::config_manager()->lock_free_connector());
   return Status::OK();
 }
 
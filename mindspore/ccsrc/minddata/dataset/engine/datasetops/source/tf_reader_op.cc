@@ -16,9 +16,9 @@
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 
 #include <algorithm>
-#include <fstream>
 #include <future>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -39,7 +39,6 @@
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/wait_post.h"
-#include "utils/system/crc32c.h"
 
 namespace mindspore {
 namespace dataset {
@@ -48,7 +47,9 @@ TFReaderOp::Builder::Builder()
       builder_num_devices_(1),
       builder_total_rows_(0),
       builder_equal_rows_per_shard_(false),
-      builder_sampler_(nullptr) {
+      builder_sampler_(nullptr),
+      builder_compression_type_(TFRecordCompression::kAuto),
+      builder_verify_crc_(false) {
   std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
   builder_num_workers_ = config_manager->num_parallel_workers();
   builder_worker_connector_size_ = config_manager->worker_connector_size();
@@ -58,26 +59,12 @@ TFReaderOp::Builder::Builder()
   builder_data_schema_ = std::make_unique<DataSchema>();
 }
 
-bool TFReaderOp::ValidateFirstRowCrc(const std::string &filename) {
-  std::ifstream reader;
-  reader.open(filename);
-  if (!reader) {
-    return false;
-  }
-
-  // read data
-  int64_t record_length = 0;
-  (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-  // read crc from file
-  uint32_t masked_crc = 0;
-  (void)reader.read(reinterpret_cast<char *>(&masked_crc), static_cast<std::streamsize>(sizeof(uint32_t)));
-
-  // generate crc from data
-  uint32_t generated_crc =
-    system::Crc32c::GetMaskCrc32cValue(reinterpret_cast<char *>(&record_length), sizeof(int64_t));
-
-  return masked_crc == generated_crc;
+bool TFReaderOp::ValidateFirstRowCrc(const std::string &filename, TFRecordCompression compression_type) {
+  TFRecordReader reader;
+  std::string record;
+  bool eof = false;
+  // checks the crc of the length and of the data of the first record
+  return reader.Open(filename, compression_type).IsOk() && reader.ReadRecord(&record, true, &eof).IsOk() && !eof;
 }
 
 Status TFReaderOp::Builder::ValidateInputs() const {
@@ -94,8 +81,9 @@ Status TFReaderOp::Builder::ValidateInputs() const {
   }
 
   std::vector<std::string> invalid_files(builder_dataset_files_list_.size());
-  auto it = std::copy_if(builder_dataset_files_list_.begin(), builder_dataset_files_list_.end(), invalid_files.begin(),
-                         [](const std::string &filename) { return !ValidateFirstRowCrc(filename); });
+  auto it = std::copy_if(
+    builder_dataset_files_list_.begin(), builder_dataset_files_list_.end(), invalid_files.begin(),
+    [this](const std::string &filename) { return !ValidateFirstRowCrc(filename, builder_compression_type_); });
   invalid_files.resize(std::distance(invalid_files.begin(), it));
 
   if (!invalid_files.empty()) {
@@ -123,7 +111,7 @@ Status TFReaderOp::Builder::Build(std::shared_ptr<TFReaderOp> *out_tf_reader_op)
     builder_num_workers_, builder_worker_connector_size_, builder_rows_per_buffer_, builder_total_rows_,
     builder_dataset_files_list_, std::move(builder_data_schema_), builder_op_connector_size_, builder_columns_to_load_,
     builder_shuffle_files_, builder_num_devices_, builder_device_id_, builder_equal_rows_per_shard_,
-    std::move(builder_sampler_));
+    std::move(builder_sampler_), builder_compression_type_, builder_verify_crc_);
 
   RETURN_IF_NOT_OK(new_tf_reader_op->Init());
   *out_tf_reader_op = std::move(new_tf_reader_op);
@@ -134,7 +122,8 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
                        int64_t total_num_rows, std::vector<std::string> dataset_files_list,
                        std::unique_ptr<DataSchema> data_schema, int32_t op_connector_size,
                        std::vector<std::string> columns_to_load, bool shuffle_files, int32_t num_device,
-                       int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<SamplerRT> sampler)
+                       int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<SamplerRT> sampler,
+                       TFRecordCompression compression_type, bool verify_crc)
     : ParallelOp(num_workers, op_connector_size, std::move(sampler)),
       device_id_(device_id),
       num_devices_(num_device),
@@ -150,7 +139,9 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       load_jagged_connector_(true),
       num_rows_(0),
       num_rows_per_shard_(0),
-      equal_rows_per_shard_(equal_rows_per_shard) {
+      equal_rows_per_shard_(equal_rows_per_shard),
+      compression_type_(compression_type),
+      verify_crc_(verify_crc) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -202,7 +193,8 @@ Status TFReaderOp::Init() {
   // parallel op base.
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
 
-  jagged_buffer_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
+  jagged_buffer_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_,
+                                                               GlobalContext::config_manager()->lock_free_connector());
 
   // temporary: make size large enough to hold all files + EOE to avoid hangs
   int32_t safe_queue_size = static_cast<int32_t>(std::ceil(dataset_files_list_.size() / num_workers_)) + 1;
@@ -218,7 +210,7 @@ Status TFReaderOp::CalculateNumRowsPerShard() {
 
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
     std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
+    int64_t num = CountTotalRowsSectioned(file, 0, 1, compression_type_);
     filename_numrows_[it.value()] = num;
     num_rows_ += num;
   }
@@ -565,47 +557,44 @@ Status TFReaderOp::PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock
 // Reads a tf_file file and loads the data into multiple buffers.
 Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_offset, const int64_t end_offset,
                             const int32_t &worker_id) {
-  std::ifstream reader;
-  reader.open(filename);
-  if (!reader) {
-    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+  TFRecordReader reader;
+  RETURN_IF_NOT_OK(reader.Open(filename, compression_type_));
+
+  // rows before start_offset are skipped by seeking instead of reading them
+  int64_t rows_left = std::numeric_limits<int64_t>::max();
+  if (start_offset != kInvalidOffset) {
+    std::shared_ptr<const TFRecordIndex> index;
+    RETURN_IF_NOT_OK(TFRecordIndex::Get(filename, compression_type_, &index));
+    int64_t start_row = std::min(start_offset, index->NumRows());
+    RETURN_IF_NOT_OK(reader.Seek(index->RowOffset(start_row)));
+    rows_left = std::min(end_offset, index->NumRows()) - start_row;
   }
 
   int64_t rows_read = 0;
-  int64_t rows_total = 0;
   std::unique_ptr<DataBuffer> current_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> new_tensor_table = std::make_unique<TensorQTable>();
+  // reused for every record, so reading a row does not allocate
+  std::string serialized_example;
+  dataengine::Example tf_file;
 
-  while (reader.peek() != EOF) {
+  for (; rows_left > 0; rows_left--) {
     if (!load_jagged_connector_) {
       break;
     }
     RETURN_IF_INTERRUPTED();
 
-    // read length
-    int64_t record_length = 0;
-    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-    // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Invalid file, failed to parse tfrecord file : " + serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &new_tensor_table, rows_read));
-      rows_read++;
+    bool eof = false;
+    RETURN_IF_NOT_OK(reader.ReadRecord(&serialized_example, verify_crc_, &eof));
+    if (eof) {
+      break;
     }
-
-    // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-    rows_total++;
+    if (!tf_file.ParseFromString(serialized_example)) {
+      std::string errMsg = "Invalid file, failed to parse tfrecord file : " + filename + " at offset " +
+                           std::to_string(reader.Tell() - static_cast<int64_t>(serialized_example.size())) + ".";
+      RETURN_STATUS_UNEXPECTED(errMsg);
+    }
+    RETURN_IF_NOT_OK(LoadExample(&tf_file, &new_tensor_table, rows_read));
+    rows_read++;
 
     if (rows_read == rows_per_buffer_) {
       current_buffer->set_tensor_table(std::move(new_tensor_table));
@@ -867,20 +856,16 @@ Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengin
 }
 
 Status TFReaderOp::CreateSchema(const std::string tf_file, std::vector<std::string> columns_to_load) {
-  std::ifstream reader;
-  reader.open(tf_file);
-
-  // read length
-  int64_t record_length = 0;
-  (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-  // ignore crc header
-  (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+  TFRecordReader reader;
+  RETURN_IF_NOT_OK(reader.Open(tf_file, compression_type_));
 
   // read serialized Example
   std::string serialized_example;
-  serialized_example.resize(record_length);
-  (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
+  bool eof = false;
+  RETURN_IF_NOT_OK(reader.ReadRecord(&serialized_example, verify_crc_, &eof));
+  if (eof) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, no record in tfrecord file: " + tf_file);
+  }
 
   dataengine::Example example;
   if (!example.ParseFromString(serialized_example)) {
@@ -935,7 +920,7 @@ Status TFReaderOp::CreateSchema(const std::string tf_file, std::vector<std::stri
 }
 
 Status TFReaderOp::CountTotalRows(int64_t *out_total_rows, const std::vector<std::string> &filenames, int64_t threads,
-                                  bool estimate) {
+                                  bool estimate, TFRecordCompression compression_type) {
   try {
     if (threads > filenames.size()) {
       threads = filenames.size();
@@ -957,10 +942,12 @@ Status TFReaderOp::CountTotalRows(int64_t *out_total_rows, const std::vector<std
 
       if (estimate) {
         // Parse a single file for each chunk with estimate mode on
-        async_results.push_back(std::async(std::launch::async, &CountTotalRowsSectioned, filenames, begin, begin + 1));
+        async_results.push_back(
+          std::async(std::launch::async, &CountTotalRowsSectioned, filenames, begin, begin + 1, compression_type));
       } else {
         // Parse the whole chunk with estimate mode off
-        async_results.push_back(std::async(std::launch::async, &CountTotalRowsSectioned, filenames, begin, end));
+        async_results.push_back(
+          std::async(std::launch::async, &CountTotalRowsSectioned, filenames, begin, end, compression_type));
       }
 
       begin = end;
@@ -987,31 +974,17 @@ Status TFReaderOp::CountTotalRows(int64_t *out_total_rows, const std::vector<std
   return Status::OK();
 }
 
-int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &filenames, int64_t begin, int64_t end) {
+int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &filenames, int64_t begin, int64_t end,
+                                            TFRecordCompression compression_type) {
   int64_t rows_read = 0;
   for (int i = begin; i < end; i++) {
-    std::ifstream reader;
-    reader.open(filenames[i]);
-    if (!reader) {
-      MS_LOG(DEBUG) << "TFReader operator failed to open file " << filenames[i] << ".";
-    }
-
-    while (reader.peek() != EOF) {
-      // read length
-      int64_t record_length = 0;
-      (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-      // ignore crc header
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      // ignore tf_file contents
-      (void)reader.ignore(static_cast<std::streamsize>(record_length));
-
-      // ignore crc footer
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      rows_read++;
+    std::shared_ptr<const TFRecordIndex> index;
+    Status rc = TFRecordIndex::Get(filenames[i], compression_type, &index);
+    if (rc.IsError()) {
+      MS_LOG(DEBUG) << "TFReader operator failed to index file " << filenames[i] << ": " << rc.ToString();
+      continue;
     }
+    rows_read += index->NumRows();
   }
 
   return rows_read;
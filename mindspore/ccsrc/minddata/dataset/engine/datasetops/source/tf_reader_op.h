@@ -31,6 +31,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_reader.h"
 
 namespace dataengine {
 class Example;
@@ -161,6 +162,20 @@ class TFReaderOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetCompressionType(TFRecordCompression compression_type) {
+      builder_compression_type_ = compression_type;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetVerifyCrc(bool verify_crc) {
+      builder_verify_crc_ = verify_crc;
+      return *this;
+    }
+
    private:
     std::unique_ptr<DataSchema> builder_data_schema_;
     std::shared_ptr<SamplerRT> builder_sampler_;
@@ -175,6 +190,8 @@ class TFReaderOp : public ParallelOp {
     std::vector<std::string> builder_columns_to_load_;
     bool builder_shuffle_files_;
     bool builder_equal_rows_per_shard_;
+    TFRecordCompression builder_compression_type_;
+    bool builder_verify_crc_;
   };
 
   // Constructor of TFReaderOp (2)
@@ -190,10 +207,13 @@ class TFReaderOp : public ParallelOp {
   // @param shuffle_files - whether or not to shuffle the files before reading data.
   // @param equal_rows_per_shard - whether or not to get equal rows for each process.
   // @param sampler - allow a sampler.  Only valid if a cache exists in ascendent tree nodes
+  // @param compression_type - how the files are compressed, kAuto decides by the first bytes of each file.
+  // @param verify_crc - whether to check the crc of every record that is read.
   TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64_t rows_per_buffer, int64_t total_num_rows,
              std::vector<std::string> dataset_files_list, std::unique_ptr<DataSchema> data_schema,
              int32_t op_connector_size, std::vector<std::string> columns_to_load, bool shuffle_files,
-             int32_t num_devices, int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<SamplerRT> sampler);
+             int32_t num_devices, int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<SamplerRT> sampler,
+             TFRecordCompression compression_type = TFRecordCompression::kAuto, bool verify_crc = false);
 
   // Default destructor
   ~TFReaderOp() = default;
@@ -221,16 +241,19 @@ class TFReaderOp : public ParallelOp {
   // Getter method
   int64_t rows_per_buffer() const { return rows_per_buffer_; }
 
-  // Reads all the provided tf_file files and counts the total number of rows. filenames will
-  // first be sectioned into equal parts, then sections are read in parallel. If threads is
-  // greater than the number of files, threads will be clamped to the number of files.
+  // Counts the total number of rows of all the provided tf_file files. The rows of a file are counted
+  // by its record index, so only files that are not indexed yet are read. filenames will first be
+  // sectioned into equal parts, then sections are indexed in parallel. If threads is greater than
+  // the number of files, threads will be clamped to the number of files.
   // @param out_total_tows - output parameter which contains the total number of rows
   // @param filenames - a list of tf_file filenames.
   // @param threads - number of threads to use to read the tf_file files.
   // @param estimate - estimate mode, under this mode each threads will sample a single file from each chunk
+  // @param compression_type - how the files are compressed.
   // @return Status - the error code returned.
   static Status CountTotalRows(int64_t *out_total_rows, const std::vector<std::string> &filenames, int64_t threads = 1,
-                               bool estimate = false);
+                               bool estimate = false,
+                               TFRecordCompression compression_type = TFRecordCompression::kAuto);
 
   // Base-class override for NodePass visitor acceptor.
   // @param p - Pointer to the NodePass to be accepted.
@@ -257,7 +280,8 @@ class TFReaderOp : public ParallelOp {
   // before providing their own implementations.
   Status PrepareNodePostAction() override;
 
-  static bool ValidateFirstRowCrc(const std::string &filename);
+  static bool ValidateFirstRowCrc(const std::string &filename,
+                                  TFRecordCompression compression_type = TFRecordCompression::kAuto);
 
  private:
   // The entry point for when workers are launched.
@@ -294,7 +318,8 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock> &&io_block);
 
-  // Reads a tf_file file and loads the data into multiple buffers.
+  // Reads a tf_file file and loads the data into multiple buffers. The reader seeks to the first row
+  // of the range through the record index of the file.
   // @param filename - the tf_file file to read.
   // @param start_offset - the start offset of file.
   // @param end_offset - the end offset of file.
@@ -359,13 +384,14 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status CreateSchema(const std::string tf_file, std::vector<std::string> columns_to_load);
 
-  // Meant to be called async. Will read files in the range [begin, end) and return the total rows
+  // Meant to be called async. Will index files in the range [begin, end) and return the total rows
   // @param filenames - a list of tf data filenames.
   // @param begin - index of first file to read.
   // @param end - one greater than the index of the last file to read.
+  // @param compression_type - how the files are compressed.
   // @return int63_t - the total number of rows of files read.
   static int64_t CountTotalRowsSectioned(const std::vector<std::string> &filenames, const int64_t begin,
-                                         const int64_t end);
+                                         const int64_t end, TFRecordCompression compression_type);
   // Fill IO block queue if shuffle is true
   // @param i_keys - shuffle keys.
   // @return Status - the error code returned.
@@ -416,6 +442,8 @@ class TFReaderOp : public ParallelOp {
   int64_t num_rows_;
   int64_t num_rows_per_shard_;
   bool equal_rows_per_shard_;
+  TFRecordCompression compression_type_;
+  bool verify_crc_;
 };
 }  // namespace dataset
 }  // namespace mindspore
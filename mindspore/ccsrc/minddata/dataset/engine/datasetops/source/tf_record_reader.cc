@@ -0,0 +1,444 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_record_reader.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "./securec.h"
+#include "utils/ms_utils.h"
+#include "utils/system/crc32c.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr size_t kBlockSize = 256 * 1024;
+constexpr size_t kLengthSize = sizeof(uint64_t);
+constexpr size_t kCrcSize = sizeof(uint32_t);
+constexpr size_t kHeaderSize = kLengthSize + kCrcSize;
+constexpr int64_t kOffsetSize = sizeof(int64_t);
+// Larger lengths can only come from a corrupted or wrongly decompressed file
+constexpr uint64_t kMaxRecordLength = 1ULL << 40;
+constexpr char kSidecarMagic[8] = {'M', 'S', 'T', 'F', 'I', 'D', 'X', '1'};
+
+struct SidecarHeader {
+  char magic[8];
+  int32_t compression;
+  int32_t reserved;
+  int64_t file_size;
+  int64_t mtime;
+  int64_t num_rows;
+};
+
+// Offsets depend on how the file is decompressed, so the indexes are cached per file and compression
+std::string IndexCacheKey(const std::string &filename, TFRecordCompression compression) {
+  return std::to_string(static_cast<int>(compression)) + ":" + filename;
+}
+
+std::mutex index_cache_mutex;
+std::unordered_map<std::string, std::shared_ptr<const TFRecordIndex>> index_cache;
+}  // namespace
+
+struct TFRecordReader::InflateState {
+  z_stream stream;
+  std::vector<char> input;
+  bool initialized = false;
+};
+
+TFRecordReader::TFRecordReader()
+    : compression_(TFRecordCompression::kNone), file_(nullptr), buffer_pos_(0), buffer_size_(0), offset_(0) {}
+
+TFRecordReader::~TFRecordReader() {
+  if (inflate_ != nullptr && inflate_->initialized) {
+    (void)inflateEnd(&inflate_->stream);
+  }
+  if (file_ != nullptr) {
+    (void)fclose(file_);
+  }
+}
+
+TFRecordCompression TFRecordReader::ResolveCompression(const std::string &filename, TFRecordCompression compression) {
+  if (compression != TFRecordCompression::kAuto) {
+    return compression;
+  }
+  unsigned char header[kHeaderSize] = {0};
+  size_t size = 0;
+  FILE *file = fopen(filename.c_str(), "rb");
+  if (file != nullptr) {
+    size = fread(header, 1, kHeaderSize, file);
+    (void)fclose(file);
+  }
+  // A plain file starts with the length of its first record and the crc of that length, a compressed stream matches
+  // it only by chance. Otherwise the gzip magic, or a zlib header of a deflate stream
+  uint32_t crc = 0;
+  (void)memcpy_s(&crc, sizeof(crc), header + kLengthSize, kCrcSize);
+  if (size == kHeaderSize && system::Crc32c::GetMaskCrc32cValue(reinterpret_cast<char *>(header), kLengthSize) == crc) {
+    return TFRecordCompression::kNone;
+  }
+  if (size >= 2 && header[0] == 0x1f && header[1] == 0x8b) {
+    return TFRecordCompression::kGzip;
+  }
+  bool deflate = (header[0] & 0x0f) == Z_DEFLATED && (header[0] >> 4) <= 7;
+  if (size >= 2 && deflate && (header[0] * 256 + header[1]) % 31 == 0) {
+    return TFRecordCompression::kZlib;
+  }
+  return TFRecordCompression::kNone;
+}
+
+Status TFRecordReader::Open(const std::string &filename, TFRecordCompression compression) {
+  if (file_ != nullptr) {
+    RETURN_STATUS_UNEXPECTED("TFRecordReader is already open on file: " + filename_);
+  }
+  filename_ = filename;
+  compression_ = ResolveCompression(filename, compression);
+  file_ = fopen(filename.c_str(), "rb");
+  if (file_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+  }
+  buffer_.resize(kBlockSize);
+  if (compression_ != TFRecordCompression::kNone) {
+    inflate_ = std::make_unique<InflateState>();
+    inflate_->input.resize(kBlockSize);
+  }
+  return Rewind();
+}
+
+Status TFRecordReader::Rewind() {
+  if (fseeko(file_, 0, SEEK_SET) != 0) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to seek in file: " + filename_);
+  }
+  buffer_pos_ = 0;
+  buffer_size_ = 0;
+  offset_ = 0;
+  if (inflate_ == nullptr) {
+    return Status::OK();
+  }
+  z_stream *stream = &inflate_->stream;
+  if (inflate_->initialized) {
+    (void)inflateEnd(stream);
+    inflate_->initialized = false;
+  }
+  (void)memset_s(stream, sizeof(z_stream), 0, sizeof(z_stream));
+  // 16 asks zlib for the gzip wrapper instead of the zlib one
+  int window_bits = compression_ == TFRecordCompression::kGzip ? MAX_WBITS + 16 : MAX_WBITS;
+  if (inflateInit2(stream, window_bits) != Z_OK) {
+    RETURN_STATUS_UNEXPECTED("Failed to initialize zlib for file: " + filename_);
+  }
+  inflate_->initialized = true;
+  return Status::OK();
+}
+
+Status TFRecordReader::Fill(size_t *size) {
+  buffer_pos_ = 0;
+  buffer_size_ = 0;
+  if (inflate_ == nullptr) {
+    buffer_size_ = fread(buffer_.data(), 1, buffer_.size(), file_);
+    if (buffer_size_ == 0 && ferror(file_)) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, failed to read file: " + filename_);
+    }
+    *size = buffer_size_;
+    return Status::OK();
+  }
+
+  z_stream *stream = &inflate_->stream;
+  stream->next_out = reinterpret_cast<Bytef *>(buffer_.data());
+  stream->avail_out = static_cast<uInt>(buffer_.size());
+  while (stream->avail_out == buffer_.size()) {
+    if (stream->avail_in == 0) {
+      size_t input_size = fread(inflate_->input.data(), 1, inflate_->input.size(), file_);
+      if (input_size == 0) {
+        if (ferror(file_)) {
+          RETURN_STATUS_UNEXPECTED("Invalid file, failed to read file: " + filename_);
+        }
+        break;
+      }
+      stream->next_in = reinterpret_cast<Bytef *>(inflate_->input.data());
+      stream->avail_in = static_cast<uInt>(input_size);
+    }
+    int ret = inflate(stream, Z_NO_FLUSH);
+    if (ret == Z_STREAM_END) {
+      // gzip files may hold several members one after the other
+      if (inflateReset(stream) != Z_OK) {
+        RETURN_STATUS_UNEXPECTED("Failed to reset zlib for file: " + filename_);
+      }
+    } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, failed to decompress file: " + filename_ + ", zlib error " +
+                               std::to_string(ret) + ".");
+    }
+  }
+  buffer_size_ = buffer_.size() - stream->avail_out;
+  *size = buffer_size_;
+  return Status::OK();
+}
+
+Status TFRecordReader::ReadBytes(char *dst, size_t size, size_t *read_size) {
+  size_t done = 0;
+  while (done < size) {
+    if (buffer_pos_ == buffer_size_) {
+      size_t filled = 0;
+      RETURN_IF_NOT_OK(Fill(&filled));
+      if (filled == 0) {
+        break;
+      }
+    }
+    size_t count = std::min(size - done, buffer_size_ - buffer_pos_);
+    (void)memcpy_s(dst + done, size - done, buffer_.data() + buffer_pos_, count);
+    buffer_pos_ += count;
+    done += count;
+  }
+  offset_ += static_cast<int64_t>(done);
+  *read_size = done;
+  return Status::OK();
+}
+
+Status TFRecordReader::SkipBytes(int64_t size) {
+  int64_t buffered = static_cast<int64_t>(buffer_size_ - buffer_pos_);
+  if (size <= buffered) {
+    buffer_pos_ += static_cast<size_t>(size);
+    offset_ += size;
+    return Status::OK();
+  }
+  if (inflate_ == nullptr) {
+    // The end of the file is checked by the next read, or against the file size when indexing
+    offset_ += size;
+    buffer_pos_ = 0;
+    buffer_size_ = 0;
+    if (fseeko(file_, offset_, SEEK_SET) != 0) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, failed to seek in file: " + filename_);
+    }
+    return Status::OK();
+  }
+  while (size > 0) {
+    if (buffer_pos_ == buffer_size_) {
+      size_t filled = 0;
+      RETURN_IF_NOT_OK(Fill(&filled));
+      if (filled == 0) {
+        RETURN_STATUS_UNEXPECTED("Invalid file, unexpected end of file: " + filename_);
+      }
+    }
+    size_t count = static_cast<size_t>(std::min(size, static_cast<int64_t>(buffer_size_ - buffer_pos_)));
+    buffer_pos_ += count;
+    offset_ += static_cast<int64_t>(count);
+    size -= static_cast<int64_t>(count);
+  }
+  return Status::OK();
+}
+
+Status TFRecordReader::Seek(int64_t offset) {
+  if (file_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("TFRecordReader is not open.");
+  }
+  if (offset < offset_) {
+    int64_t buffer_start = offset_ - static_cast<int64_t>(buffer_pos_);
+    if (offset >= buffer_start) {
+      buffer_pos_ = static_cast<size_t>(offset - buffer_start);
+      offset_ = offset;
+      return Status::OK();
+    }
+    if (inflate_ == nullptr) {
+      buffer_pos_ = 0;
+      buffer_size_ = 0;
+      offset_ = offset;
+      if (fseeko(file_, offset_, SEEK_SET) != 0) {
+        RETURN_STATUS_UNEXPECTED("Invalid file, failed to seek in file: " + filename_);
+      }
+      return Status::OK();
+    }
+    RETURN_IF_NOT_OK(Rewind());
+  }
+  return SkipBytes(offset - offset_);
+}
+
+Status TFRecordReader::ReadRecord(std::string *record, bool verify_crc, bool *eof) {
+  char header[kHeaderSize];
+  size_t read_size = 0;
+  RETURN_IF_NOT_OK(ReadBytes(header, kHeaderSize, &read_size));
+  *eof = read_size == 0;
+  if (*eof) {
+    return Status::OK();
+  }
+  if (read_size != kHeaderSize) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, truncated record header in file: " + filename_);
+  }
+  uint64_t length = 0;
+  uint32_t crc = 0;
+  (void)memcpy_s(&length, sizeof(length), header, kLengthSize);
+  (void)memcpy_s(&crc, sizeof(crc), header + kLengthSize, kCrcSize);
+  if (verify_crc && system::Crc32c::GetMaskCrc32cValue(header, kLengthSize) != crc) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, crc of record length mismatch at offset " +
+                             std::to_string(offset_ - kHeaderSize) + " of file: " + filename_);
+  }
+  if (length > kMaxRecordLength) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, corrupted record length at offset " +
+                             std::to_string(offset_ - kHeaderSize) + " of file: " + filename_);
+  }
+
+  record->resize(length);
+  RETURN_IF_NOT_OK(ReadBytes(&(*record)[0], length, &read_size));
+  uint32_t data_crc = 0;
+  size_t crc_size = 0;
+  if (read_size == length) {
+    RETURN_IF_NOT_OK(ReadBytes(reinterpret_cast<char *>(&data_crc), kCrcSize, &crc_size));
+  }
+  if (read_size != length || crc_size != kCrcSize) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, truncated record in file: " + filename_);
+  }
+  if (verify_crc && system::Crc32c::GetMaskCrc32cValue(record->data(), length) != data_crc) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, crc of record data mismatch at offset " +
+                             std::to_string(offset_ - kHeaderSize - length - kCrcSize) + " of file: " + filename_);
+  }
+  return Status::OK();
+}
+
+Status TFRecordReader::SkipRecord(bool *eof) {
+  char header[kHeaderSize];
+  size_t read_size = 0;
+  RETURN_IF_NOT_OK(ReadBytes(header, kHeaderSize, &read_size));
+  *eof = read_size == 0;
+  if (*eof) {
+    return Status::OK();
+  }
+  uint64_t length = 0;
+  (void)memcpy_s(&length, sizeof(length), header, kLengthSize);
+  if (read_size != kHeaderSize || length > kMaxRecordLength) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, corrupted record header in file: " + filename_);
+  }
+  return SkipBytes(static_cast<int64_t>(length + kCrcSize));
+}
+
+Status TFRecordIndex::Get(const std::string &filename, TFRecordCompression compression,
+                          std::shared_ptr<const TFRecordIndex> *index) {
+  RETURN_UNEXPECTED_IF_NULL(index);
+  compression = TFRecordReader::ResolveCompression(filename, compression);
+  struct stat file_stat;
+  if (stat(filename.c_str(), &file_stat) != 0) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+  }
+  int64_t file_size = static_cast<int64_t>(file_stat.st_size);
+  int64_t mtime = static_cast<int64_t>(file_stat.st_mtime);
+  std::string cache_key = IndexCacheKey(filename, compression);
+  {
+    std::lock_guard<std::mutex> lock(index_cache_mutex);
+    auto it = index_cache.find(cache_key);
+    if (it != index_cache.end() && it->second->file_size_ == file_size && it->second->mtime_ == mtime) {
+      *index = it->second;
+      return Status::OK();
+    }
+  }
+
+  // Files are indexed by one thread each, so two threads rarely build the same index and the lock is not held here
+  std::shared_ptr<const TFRecordIndex> new_index = LoadSidecar(filename, compression, file_size, mtime);
+  if (new_index == nullptr) {
+    RETURN_IF_NOT_OK(Build(filename, compression, file_size, mtime, &new_index));
+    if (common::GetEnv("MINDDATA_TFRECORD_INDEX") == "true") {
+      new_index->WriteSidecar(filename, compression);
+    }
+  }
+  std::lock_guard<std::mutex> lock(index_cache_mutex);
+  index_cache[cache_key] = new_index;
+  *index = std::move(new_index);
+  return Status::OK();
+}
+
+Status TFRecordIndex::Build(const std::string &filename, TFRecordCompression compression, int64_t file_size,
+                            int64_t mtime, std::shared_ptr<const TFRecordIndex> *index) {
+  TFRecordReader reader;
+  RETURN_IF_NOT_OK(reader.Open(filename, compression));
+  std::vector<int64_t> offsets;
+  bool eof = false;
+  while (true) {
+    offsets.push_back(reader.Tell());
+    RETURN_IF_NOT_OK(reader.SkipRecord(&eof));
+    if (eof) {
+      break;
+    }
+  }
+  // Plain files skip records by seeking, so a truncated last record only shows here
+  if (compression == TFRecordCompression::kNone && offsets.back() != file_size) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, truncated record in file: " + filename);
+  }
+  *index = std::make_shared<const TFRecordIndex>(file_size, mtime, std::move(offsets));
+  return Status::OK();
+}
+
+std::shared_ptr<const TFRecordIndex> TFRecordIndex::LoadSidecar(const std::string &filename,
+                                                                TFRecordCompression compression, int64_t file_size,
+                                                                int64_t mtime) {
+  std::string path = SidecarPath(filename);
+  struct stat sidecar_stat;
+  if (stat(path.c_str(), &sidecar_stat) != 0) {
+    return nullptr;
+  }
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return nullptr;
+  }
+  // A compressed file can hold far more rows than bytes, so the row count is checked against the size of the sidecar,
+  // which holds exactly one offset per row and one for the end
+  int64_t offsets_size = static_cast<int64_t>(sidecar_stat.st_size) - static_cast<int64_t>(sizeof(SidecarHeader));
+  int64_t offset_num = offsets_size / kOffsetSize;
+  std::shared_ptr<const TFRecordIndex> index = nullptr;
+  SidecarHeader header;
+  if (fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, kSidecarMagic, sizeof(kSidecarMagic)) == 0 &&
+      header.compression == static_cast<int32_t>(compression) && header.file_size == file_size &&
+      header.mtime == mtime && offset_num > 0 && offsets_size % kOffsetSize == 0 &&
+      header.num_rows == offset_num - 1) {
+    std::vector<int64_t> offsets(offset_num);
+    if (fread(offsets.data(), sizeof(int64_t), offsets.size(), file) == offsets.size() && offsets.front() == 0 &&
+        std::is_sorted(offsets.begin(), offsets.end()) &&
+        (compression != TFRecordCompression::kNone || offsets.back() == file_size)) {
+      index = std::make_shared<const TFRecordIndex>(file_size, mtime, std::move(offsets));
+    }
+  }
+  (void)fclose(file);
+  if (index == nullptr) {
+    MS_LOG(INFO) << "Ignore stale or invalid tfrecord index file: " << path;
+  }
+  return index;
+}
+
+void TFRecordIndex::WriteSidecar(const std::string &filename, TFRecordCompression compression) const {
+  // Writes to a private file and renames it, so readers never see a partial index
+  std::string path = SidecarPath(filename);
+  std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+  FILE *file = fopen(tmp_path.c_str(), "wb");
+  if (file == nullptr) {
+    MS_LOG(INFO) << "Failed to create tfrecord index file: " << path;
+    return;
+  }
+  SidecarHeader header;
+  (void)memset_s(&header, sizeof(header), 0, sizeof(header));
+  (void)memcpy_s(header.magic, sizeof(header.magic), kSidecarMagic, sizeof(kSidecarMagic));
+  header.compression = static_cast<int32_t>(compression);
+  header.file_size = file_size_;
+  header.mtime = mtime_;
+  header.num_rows = NumRows();
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(offsets_.data(), sizeof(int64_t), offsets_.size(), file) == offsets_.size();
+  ok = fclose(file) == 0 && ok;
+  if (!ok || rename(tmp_path.c_str(), path.c_str()) != 0) {
+    MS_LOG(INFO) << "Failed to write tfrecord index file: " << path;
+    (void)remove(tmp_path.c_str());
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_READER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_READER_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Compression of a tfrecord file. kAuto decides by the first bytes of the file, whatever its name: a valid
+///     record header means no compression, then the gzip magic or a zlib header.
+enum class TFRecordCompression { kAuto = 0, kNone = 1, kGzip = 2, kZlib = 3 };
+
+/// \brief Reads the records of a tfrecord file in order, through a block buffer.
+/// \note Offsets are positions in the uncompressed record stream, for plain files they are file offsets.
+class TFRecordReader {
+ public:
+  TFRecordReader();
+
+  ~TFRecordReader();
+
+  /// \brief Opens a file for reading from its first record.
+  /// \param[in] filename The tfrecord file.
+  /// \param[in] compression How the file is compressed.
+  /// \return Status The error code returned
+  Status Open(const std::string &filename, TFRecordCompression compression);
+
+  /// \brief Reads the next record. The storage of record is reused, so callers should pass the same string again.
+  /// \param[out] record The serialized record.
+  /// \param[in] verify_crc Whether to check the crc of the length and of the data.
+  /// \param[out] eof Set to true instead of reading when there are no records left.
+  /// \return Status The error code returned
+  Status ReadRecord(std::string *record, bool verify_crc, bool *eof);
+
+  /// \brief Steps over the next record without copying it.
+  /// \param[out] eof Set to true when there are no records left.
+  /// \return Status The error code returned
+  Status SkipRecord(bool *eof);
+
+  /// \brief Moves to the record that starts at offset. Plain files seek, compressed streams can only be inflated
+  ///     forward, so going backwards restarts from the beginning.
+  /// \param[in] offset The offset of a record, as returned by Tell() or TFRecordIndex.
+  /// \return Status The error code returned
+  Status Seek(int64_t offset);
+
+  /// \brief Offset of the next record.
+  int64_t Tell() const { return offset_; }
+
+  /// \brief Resolves kAuto by reading the first bytes of a file.
+  static TFRecordCompression ResolveCompression(const std::string &filename, TFRecordCompression compression);
+
+ private:
+  struct InflateState;
+
+  // Refills the buffer once it has been consumed, *size is 0 at the end of the stream.
+  Status Fill(size_t *size);
+
+  Status ReadBytes(char *dst, size_t size, size_t *read_size);
+
+  Status SkipBytes(int64_t size);
+
+  Status Rewind();
+
+  std::string filename_;
+  TFRecordCompression compression_;
+  FILE *file_;
+  std::unique_ptr<InflateState> inflate_;
+  std::vector<char> buffer_;
+  size_t buffer_pos_;
+  size_t buffer_size_;
+  int64_t offset_;
+};
+
+/// \brief The offsets of all records of a tfrecord file, so readers can seek to a row and rows are counted without
+///     reading the file. Indexes are kept in memory for the life of the process and loaded from a sidecar file
+///     "<file>.msidx" when one exists. Setting the environment variable MINDDATA_TFRECORD_INDEX to "true" also writes
+///     the sidecar files of newly indexed files, where the directory allows it.
+class TFRecordIndex {
+ public:
+  TFRecordIndex(int64_t file_size, int64_t mtime, std::vector<int64_t> offsets)
+      : file_size_(file_size), mtime_(mtime), offsets_(std::move(offsets)) {}
+
+  ~TFRecordIndex() = default;
+
+  /// \brief Gets the index of a file, building it on first use. Indexes of files that changed are rebuilt.
+  /// \param[in] filename The tfrecord file.
+  /// \param[in] compression How the file is compressed.
+  /// \param[out] index The index.
+  /// \return Status The error code returned
+  static Status Get(const std::string &filename, TFRecordCompression compression,
+                    std::shared_ptr<const TFRecordIndex> *index);
+
+  /// \brief Path of the sidecar index file of a tfrecord file.
+  static std::string SidecarPath(const std::string &filename) { return filename + ".msidx"; }
+
+  int64_t NumRows() const { return static_cast<int64_t>(offsets_.size()) - 1; }
+
+  /// \brief Offset of a row, row NumRows() is the end of the stream.
+  int64_t RowOffset(int64_t row) const { return offsets_[row]; }
+
+ private:
+  static Status Build(const std::string &filename, TFRecordCompression compression, int64_t file_size,
+                      int64_t mtime, std::shared_ptr<const TFRecordIndex> *index);
+
+  static std::shared_ptr<const TFRecordIndex> LoadSidecar(const std::string &filename,
+                                                          TFRecordCompression compression, int64_t file_size,
+                                                          int64_t mtime);
+
+  void WriteSidecar(const std::string &filename, TFRecordCompression compression) const;
+
+  int64_t file_size_;
+  int64_t mtime_;
+  std::vector<int64_t> offsets_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_READER_H_
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DB_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DB_CONNECTOR_H_
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include "minddata/dataset/engine/connector.h"
@@ -34,8 +35,11 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
-  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+  // @param lock_free Use lock free ring buffers for the internal queues.
+  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity, lock_free),
+        end_of_file_(false),
+        active_producers_(n_producers) {}
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -56,6 +60,9 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param worker_id The id of a worker thread calling this method.
   // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
   // @param retry_if_eoe A flag to allow the same thread invoke pop() again if the current pop returns eoe buffer.
+  // @note A producer whose op hands out work to fewer workers from some point on pushes an active producers buffer
+  // at that point into queue 0. Pops that find it continue round robin over the first id() queues only, and the
+  // buffer itself is not returned.
   Status PopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe = false) noexcept {
     if (result == nullptr) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
@@ -68,6 +75,10 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
         *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
       } else {
         RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+        while (*result != nullptr && (*result)->active_producers()) {
+          active_producers_ = std::min(std::max((*result)->id(), 1), num_producers_);
+          RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+        }
         if (*result == nullptr) {
           return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                         "[ERROR] nullptr detected when getting data from db connector");
@@ -76,7 +87,7 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
         if ((*result)->eof()) {
           end_of_file_ = true;
         }
-        pop_from_ = (pop_from_ + 1) % num_producers_;
+        pop_from_ = (pop_from_ + 1) % active_producers_;
       }
       // Do not increment expect_consumer_ when result is eoe and retry_if_eoe is set.
       if (!((*result)->eoe() && retry_if_eoe)) {
@@ -91,6 +102,8 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
  private:
   // A flag to indicate the end of stream has been encountered.
   bool end_of_file_;
+  // The number of queues popped round robin, the first active_producers_ ones.
+  int32_t active_producers_;
 };
 }  // namespace dataset
 }  // namespace mindspore
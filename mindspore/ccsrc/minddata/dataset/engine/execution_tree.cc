@@ -164,6 +164,11 @@ Status ExecutionTree::Launch() {
     RETURN_IF_NOT_OK(profiling_manager_->LaunchMonitor());
   }
 
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    auto_tune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune Thread launched", std::ref(*auto_tune_)));
+  }
+
   std::ostringstream ss;
   ss << *this;
   MS_LOG(DEBUG) << "Printing the tree before launch tasks:\n" << ss.str();
@@ -240,6 +245,11 @@ Status ExecutionTree::Prepare(int32_t num_epochs) {
   // Post optimization compulsory transformation
   RETURN_IF_NOT_OK(this->PrepareTreePostAction());
 
+  // The workers an autotuned tree may grow to are launched with it, so they must be known before the connectors
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    AutoTune::ReserveWorkers(this);
+  }
+
   // Existing transformation implementation, will be removed later
   RETURN_IF_NOT_OK(this->PrepareDeprecated());
   return Status::OK();
@@ -29,6 +29,7 @@
 #endif
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/util/status.h"
+#include "mindspore/ccsrc/minddata/dataset/engine/perf/auto_tune.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/perf/profiling.h"
 namespace mindspore {
 namespace dataset {
@@ -279,6 +280,7 @@ class ExecutionTree {
   TreeState tree_state_;                                 // Tracking the current tree state
   int32_t num_epochs_;                                   // Total number of epochs to run for this tree
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::unique_ptr<AutoTune> auto_tune_;                  // Adjusts the workers while the tree runs, when enabled
   bool optimize_;                                        // Flag to enable optional optimizations
   std::function<OptPass(OptPass)> pre_pass_override_;    // function ptr that overrides pre pass, called in PrePrepare()
 };
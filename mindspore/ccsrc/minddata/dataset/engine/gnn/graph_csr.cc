@@ -0,0 +1,502 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_csr.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+// Appends 8 byte aligned arrays, each after its number of elements, to the words of an image
+class ImageWriter {
+ public:
+  explicit ImageWriter(std::vector<int64_t> *words) : words_(words), size_(0) { words_->clear(); }
+
+  void Put(int64_t value) { *Reserve<int64_t>(1) = value; }
+
+  template <typename T>
+  T *PutArray(int64_t count) {
+    Put(count);
+    return Reserve<T>(count);
+  }
+
+  template <typename T>
+  void PutArray(const std::vector<T> &values) {
+    T *dst = PutArray<T>(static_cast<int64_t>(values.size()));
+    if (!values.empty()) {
+      (void)memcpy(dst, values.data(), values.size() * sizeof(T));
+    }
+  }
+
+ private:
+  // The returned memory is zeroed, and valid until the next call
+  template <typename T>
+  T *Reserve(int64_t count) {
+    int64_t start = size_;
+    size_ += (count * static_cast<int64_t>(sizeof(T)) + 7) / 8 * 8;
+    words_->resize(size_ / 8, 0);
+    return reinterpret_cast<T *>(reinterpret_cast<uint8_t *>(words_->data()) + start);
+  }
+
+  std::vector<int64_t> *words_;
+  int64_t size_;
+};
+
+// Reads what ImageWriter wrote, without copying the arrays
+class ImageReader {
+ public:
+  ImageReader(const uint8_t *image, int64_t size) : image_(image), size_(size), pos_(0) {}
+
+  Status Get(int64_t *value) {
+    CHECK_FAIL_RETURN_UNEXPECTED(pos_ + 8 <= size_, "Graph image is truncated.");
+    (void)memcpy(value, image_ + pos_, sizeof(int64_t));
+    pos_ += 8;
+    return Status::OK();
+  }
+
+  template <typename T>
+  Status GetArray(const T **data, int64_t *count) {
+    RETURN_IF_NOT_OK(Get(count));
+    CHECK_FAIL_RETURN_UNEXPECTED(*count >= 0 && *count <= (size_ - pos_) / static_cast<int64_t>(sizeof(T)),
+                                 "Graph image is truncated.");
+    *data = reinterpret_cast<const T *>(image_ + pos_);
+    pos_ += (*count * static_cast<int64_t>(sizeof(T)) + 7) / 8 * 8;
+    return Status::OK();
+  }
+
+ private:
+  const uint8_t *image_;
+  int64_t size_;
+  int64_t pos_;
+};
+
+Status GetEdgeWeight(const std::shared_ptr<Edge> &edge, FeatureType weight_feature, float *weight) {
+  std::shared_ptr<Feature> feature;
+  if (!edge->GetFeatures(weight_feature, &feature).IsOk()) {
+    *weight = 1.0;
+    return Status::OK();
+  }
+  std::shared_ptr<Tensor> value = feature->Value();
+  CHECK_FAIL_RETURN_UNEXPECTED(value != nullptr && value->Size() == 1,
+                               "The weight of edge " + std::to_string(edge->id()) + " is not a scalar.");
+  std::vector<dsize_t> index(value->Rank(), 0);
+  double w = 0;
+  if (value->type().IsFloat()) {
+    RETURN_IF_NOT_OK(value->GetItemAt<double>(&w, index));
+  } else if (value->type().IsSignedInt()) {
+    int64_t v = 0;
+    RETURN_IF_NOT_OK(value->GetItemAt<int64_t>(&v, index));
+    w = static_cast<double>(v);
+  } else if (value->type().IsUnsignedInt()) {
+    uint64_t v = 0;
+    RETURN_IF_NOT_OK(value->GetItemAt<uint64_t>(&v, index));
+    w = static_cast<double>(v);
+  } else {
+    RETURN_STATUS_UNEXPECTED("The weight of edge " + std::to_string(edge->id()) + " is not a number.");
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(w >= 0, "The weight of edge " + std::to_string(edge->id()) + " is negative.");
+  *weight = static_cast<float>(w);
+  return Status::OK();
+}
+
+// Vose's alias method, prob and alias are relative to the start of the weights
+void BuildAliasTable(const float *weights, int64_t num, float *prob, int32_t *alias) {
+  double total = std::accumulate(weights, weights + num, 0.0);
+  std::vector<double> scaled(num);
+  std::vector<int32_t> smaller;
+  std::vector<int32_t> larger;
+  for (int64_t i = 0; i < num; ++i) {
+    // Without any weight all neighbors are equally likely
+    scaled[i] = total > 0 ? weights[i] * num / total : 1.0;
+    scaled[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
+  }
+  while (!smaller.empty() && !larger.empty()) {
+    int32_t small = smaller.back();
+    smaller.pop_back();
+    int32_t large = larger.back();
+    larger.pop_back();
+    prob[small] = static_cast<float>(scaled[small]);
+    alias[small] = large;
+    scaled[large] = scaled[large] + scaled[small] - 1.0;
+    scaled[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
+  }
+  // Left overs are 1 up to rounding
+  for (int32_t i : smaller) {
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+  for (int32_t i : larger) {
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+}
+}  // namespace
+
+GraphCsr::GraphCsr()
+    : num_nodes_(0),
+      weighted_(false),
+      contiguous_(false) {
+  adjacency_slot_.fill(-1);
+}
+
+GraphCsr::~GraphCsr() { Reset(); }
+
+void GraphCsr::Reset() {
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  num_nodes_ = 0;
+  weighted_ = false;
+  contiguous_ = false;
+  ids_ = Array<NodeIdType>();
+  adjacency_.clear();
+  adjacency_slot_.fill(-1);
+  features_.clear();
+}
+
+Status GraphCsr::Build(const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+                       const std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> &edges,
+                       const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_features,
+                       FeatureType weight_feature) {
+  Reset();
+  CHECK_FAIL_RETURN_UNEXPECTED(nodes.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                               "Too many nodes for a graph image: " + std::to_string(nodes.size()));
+  std::vector<NodeIdType> ids;
+  ids.reserve(nodes.size());
+  for (const auto &node : nodes) {
+    ids.push_back(node.first);
+  }
+  std::sort(ids.begin(), ids.end());
+  auto index_of = [&ids](NodeIdType id, int32_t *index) {
+    auto itr = std::lower_bound(ids.begin(), ids.end(), id);
+    CHECK_FAIL_RETURN_UNEXPECTED(itr != ids.end() && *itr == id, "Invalid node id:" + std::to_string(id));
+    *index = static_cast<int32_t>(itr - ids.begin());
+    return Status::OK();
+  };
+
+  // Every edge makes its destination a neighbor of its source, of the type of the destination
+  struct Link {
+    int32_t src;
+    int32_t dst;
+    float weight;
+    bool operator<(const Link &other) const {
+      return src != other.src ? src < other.src : (dst != other.dst ? dst < other.dst : weight < other.weight);
+    }
+  };
+  std::map<NodeType, std::vector<Link>> links;
+  for (const auto &edge : edges) {
+    std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> ends;
+    RETURN_IF_NOT_OK(edge.second->GetNode(&ends));
+    CHECK_FAIL_RETURN_UNEXPECTED(ends.first != nullptr && ends.second != nullptr,
+                                 "Edge " + std::to_string(edge.first) + " is not connected.");
+    Link link{0, 0, 1.0};
+    RETURN_IF_NOT_OK(index_of(ends.first->id(), &link.src));
+    RETURN_IF_NOT_OK(index_of(ends.second->id(), &link.dst));
+    if (weight_feature != kNoWeightFeature) {
+      RETURN_IF_NOT_OK(GetEdgeWeight(edge.second, weight_feature, &link.weight));
+    }
+    links[ends.second->type()].push_back(link);
+  }
+
+  // Only numeric features whose values all look like the default go into columns
+  std::map<FeatureType, std::shared_ptr<Tensor>> columns;
+  for (const auto &item : default_features) {
+    std::shared_ptr<Tensor> default_value = item.second->Value();
+    if (default_value == nullptr || !default_value->type().IsNumeric()) {
+      continue;
+    }
+    bool uniform = true;
+    for (const auto &node : nodes) {
+      std::shared_ptr<Feature> feature;
+      if (node.second->GetFeatures(item.first, &feature).IsOk() &&
+          (feature->Value()->type() != default_value->type() || feature->Value()->shape() != default_value->shape())) {
+        uniform = false;
+        break;
+      }
+    }
+    if (uniform) {
+      columns[item.first] = default_value;
+    } else {
+      MS_LOG(INFO) << "Node feature " << item.first << " differs in shape or type between nodes, it is not kept in "
+                   << "a column.";
+    }
+  }
+
+  int64_t num_nodes = static_cast<int64_t>(ids.size());
+  ImageWriter writer(&buffer_);
+  writer.Put(weight_feature != kNoWeightFeature ? 1 : 0);
+  writer.Put(static_cast<int64_t>(links.size()));
+  writer.Put(static_cast<int64_t>(columns.size()));
+  writer.PutArray(ids);
+
+  for (auto &item : links) {
+    std::vector<Link> &type_links = item.second;
+    std::sort(type_links.begin(), type_links.end());
+    int64_t num_links = static_cast<int64_t>(type_links.size());
+    writer.Put(item.first);
+    std::vector<int64_t> offsets(num_nodes + 1, 0);
+    for (const auto &link : type_links) {
+      offsets[link.src + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    writer.PutArray(offsets);
+    int32_t *neighbors = writer.PutArray<int32_t>(num_links);
+    for (int64_t i = 0; i < num_links; ++i) {
+      neighbors[i] = type_links[i].dst;
+    }
+    if (weight_feature == kNoWeightFeature) {
+      writer.PutArray<float>(0);
+      writer.PutArray<float>(0);
+      writer.PutArray<int32_t>(0);
+      continue;
+    }
+    std::vector<float> weights(num_links);
+    std::transform(type_links.begin(), type_links.end(), weights.begin(), [](const Link &link) { return link.weight; });
+    std::vector<float> alias_prob(num_links);
+    std::vector<int32_t> alias_index(num_links);
+    for (int64_t i = 0; i < num_nodes; ++i) {
+      BuildAliasTable(&weights[offsets[i]], offsets[i + 1] - offsets[i], &alias_prob[offsets[i]],
+                      &alias_index[offsets[i]]);
+    }
+    writer.PutArray(weights);
+    writer.PutArray(alias_prob);
+    writer.PutArray(alias_index);
+  }
+  links.clear();
+
+  for (const auto &item : columns) {
+    const std::shared_ptr<Tensor> &default_value = item.second;
+    int64_t row_bytes = default_value->SizeInBytes();
+    std::vector<dsize_t> shape = default_value->shape().AsVector();
+    writer.Put(item.first);
+    writer.Put(static_cast<int64_t>(default_value->type().value()));
+    writer.PutArray(std::vector<int64_t>(shape.begin(), shape.end()));
+    uint8_t *present = writer.PutArray<uint8_t>(num_nodes);
+    for (int64_t i = 0; i < num_nodes; ++i) {
+      std::shared_ptr<Feature> feature;
+      present[i] = nodes.at(ids[i])->GetFeatures(item.first, &feature).IsOk() ? 1 : 0;
+    }
+    uint8_t *values = writer.PutArray<uint8_t>(num_nodes * row_bytes);
+    for (int64_t i = 0; i < num_nodes; ++i) {
+      std::shared_ptr<Feature> feature;
+      if (nodes.at(ids[i])->GetFeatures(item.first, &feature).IsOk() && row_bytes > 0) {
+        (void)memcpy(values + i * row_bytes, feature->Value()->GetBuffer(), row_bytes);
+      }
+    }
+  }
+
+  Status rc = Parse(reinterpret_cast<const uint8_t *>(buffer_.data()), buffer_.size() * sizeof(int64_t));
+  if (rc.IsError()) {
+    Reset();
+  }
+  return rc;
+}
+
+Status GraphCsr::Parse(const uint8_t *image, int64_t size) {
+  ImageReader reader(image, size);
+  int64_t weighted = 0;
+  int64_t num_adjacency = 0;
+  int64_t num_features = 0;
+  RETURN_IF_NOT_OK(reader.Get(&weighted));
+  RETURN_IF_NOT_OK(reader.Get(&num_adjacency));
+  RETURN_IF_NOT_OK(reader.Get(&num_features));
+  RETURN_IF_NOT_OK(reader.GetArray(&ids_.data, &ids_.size));
+  num_nodes_ = ids_.size;
+  weighted_ = weighted != 0;
+  for (int64_t i = 1; i < num_nodes_; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(ids_[i - 1] < ids_[i], "Node ids of graph image are not sorted.");
+  }
+  contiguous_ = num_nodes_ > 0 && static_cast<int64_t>(ids_[num_nodes_ - 1]) - ids_[0] == num_nodes_ - 1;
+
+  CHECK_FAIL_RETURN_UNEXPECTED(num_adjacency >= 0 && num_adjacency <= static_cast<int64_t>(adjacency_slot_.size()),
+                               "Invalid number of neighbor types in graph image.");
+  adjacency_.resize(num_adjacency);
+  for (auto &adj : adjacency_) {
+    int64_t type = 0;
+    RETURN_IF_NOT_OK(reader.Get(&type));
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      type >= std::numeric_limits<NodeType>::min() && type <= std::numeric_limits<NodeType>::max(),
+      "Invalid neighbor type in graph image: " + std::to_string(type));
+    adj.type = static_cast<NodeType>(type);
+    CHECK_FAIL_RETURN_UNEXPECTED(adjacency_slot_[static_cast<uint8_t>(adj.type)] < 0,
+                                 "Duplicate neighbor type in graph image: " + std::to_string(type));
+    adjacency_slot_[static_cast<uint8_t>(adj.type)] = static_cast<int32_t>(&adj - adjacency_.data());
+    RETURN_IF_NOT_OK(reader.GetArray(&adj.offsets.data, &adj.offsets.size));
+    RETURN_IF_NOT_OK(reader.GetArray(&adj.neighbors.data, &adj.neighbors.size));
+    RETURN_IF_NOT_OK(reader.GetArray(&adj.weights.data, &adj.weights.size));
+    RETURN_IF_NOT_OK(reader.GetArray(&adj.alias_prob.data, &adj.alias_prob.size));
+    RETURN_IF_NOT_OK(reader.GetArray(&adj.alias_index.data, &adj.alias_index.size));
+    int64_t expected = weighted_ ? adj.neighbors.size : 0;
+    CHECK_FAIL_RETURN_UNEXPECTED(adj.offsets.size == num_nodes_ + 1 && adj.offsets[0] == 0 &&
+                                   adj.offsets[num_nodes_] == adj.neighbors.size && adj.weights.size == expected &&
+                                   adj.alias_prob.size == expected && adj.alias_index.size == expected,
+                                 "Neighbors of graph image do not match its nodes.");
+    for (int64_t i = 0; i < num_nodes_; ++i) {
+      int64_t begin = adj.offsets[i];
+      int64_t degree = adj.offsets[i + 1] - begin;
+      CHECK_FAIL_RETURN_UNEXPECTED(degree >= 0, "Neighbors of graph image do not match its nodes.");
+      for (int64_t j = begin; j < begin + degree; ++j) {
+        CHECK_FAIL_RETURN_UNEXPECTED(adj.neighbors[j] >= 0 && adj.neighbors[j] < num_nodes_ &&
+                                       (!weighted_ || (adj.alias_index[j] >= 0 && adj.alias_index[j] < degree)),
+                                     "Neighbors of graph image do not match its nodes.");
+      }
+    }
+  }
+
+  for (int64_t i = 0; i < num_features; ++i) {
+    FeatureColumn column;
+    int64_t type = 0;
+    int64_t data_type = 0;
+    const int64_t *shape = nullptr;
+    int64_t rank = 0;
+    RETURN_IF_NOT_OK(reader.Get(&type));
+    RETURN_IF_NOT_OK(reader.Get(&data_type));
+    RETURN_IF_NOT_OK(reader.GetArray(&shape, &rank));
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      type >= std::numeric_limits<FeatureType>::min() && type <= std::numeric_limits<FeatureType>::max() &&
+        data_type > DataType::DE_UNKNOWN && data_type < DataType::DE_STRING,
+      "Invalid feature in graph image: " + std::to_string(type));
+    column.type = static_cast<FeatureType>(type);
+    column.data_type = DataType(static_cast<DataType::Type>(data_type));
+    column.shape.assign(shape, shape + rank);
+    column.row_bytes = column.data_type.SizeInBytes();
+    for (auto dim : column.shape) {
+      CHECK_FAIL_RETURN_UNEXPECTED(dim >= 0, "Invalid feature in graph image: " + std::to_string(type));
+      column.row_bytes *= dim;
+    }
+    RETURN_IF_NOT_OK(reader.GetArray(&column.present.data, &column.present.size));
+    RETURN_IF_NOT_OK(reader.GetArray(&column.values.data, &column.values.size));
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      column.present.size == num_nodes_ && column.values.size == num_nodes_ * column.row_bytes,
+      "Feature of graph image does not match its nodes: " + std::to_string(type));
+    features_[column.type] = std::move(column);
+  }
+  return Status::OK();
+}
+
+Status GraphCsr::GetIndex(NodeIdType id, int32_t *index) const {
+  if (contiguous_) {
+    int64_t i = static_cast<int64_t>(id) - ids_[0];
+    if (i >= 0 && i < num_nodes_) {
+      *index = static_cast<int32_t>(i);
+      return Status::OK();
+    }
+  } else {
+    const NodeIdType *end = ids_.data + num_nodes_;
+    const NodeIdType *itr = std::lower_bound(ids_.data, end, id);
+    if (itr != end && *itr == id) {
+      *index = static_cast<int32_t>(itr - ids_.data);
+      return Status::OK();
+    }
+  }
+  RETURN_STATUS_UNEXPECTED("Invalid node id:" + std::to_string(id));
+}
+
+const int32_t *GraphCsr::GetNeighbors(int32_t index, NodeType neighbor_type, int64_t *num) const {
+  const Adjacency *adj = FindAdjacency(neighbor_type);
+  if (adj == nullptr) {
+    *num = 0;
+    return nullptr;
+  }
+  int64_t begin = adj->offsets[index];
+  *num = adj->offsets[index + 1] - begin;
+  return adj->neighbors.data + begin;
+}
+
+const float *GraphCsr::GetWeights(int32_t index, NodeType neighbor_type) const {
+  const Adjacency *adj = FindAdjacency(neighbor_type);
+  if (adj == nullptr || !weighted_) {
+    return nullptr;
+  }
+  return adj->weights.data + adj->offsets[index];
+}
+
+int64_t GraphCsr::DrawNeighbor(int32_t index, NodeType neighbor_type, std::mt19937 *rnd) const {
+  const Adjacency *adj = FindAdjacency(neighbor_type);
+  int64_t begin = adj->offsets[index];
+  int64_t num = adj->offsets[index + 1] - begin;
+  std::uniform_int_distribution<int64_t> pick(0, num - 1);
+  int64_t i = pick(*rnd);
+  if (!weighted_) {
+    return i;
+  }
+  std::uniform_real_distribution<float> coin(0.0, 1.0);
+  return coin(*rnd) < adj->alias_prob[begin + i] ? i : adj->alias_index[begin + i];
+}
+
+void GraphCsr::SampleNeighbors(int32_t index, NodeType neighbor_type, int32_t samples_num, std::mt19937 *rnd,
+                               std::vector<int32_t> *scratch, NodeIdType *out) const {
+  int64_t num = 0;
+  const int32_t *neighbors = GetNeighbors(index, neighbor_type, &num);
+  if (num == 0) {
+    std::fill(out, out + samples_num, kDefaultNodeId);
+    return;
+  }
+  if (weighted_) {
+    for (int32_t i = 0; i < samples_num; ++i) {
+      out[i] = ids_[neighbors[DrawNeighbor(index, neighbor_type, rnd)]];
+    }
+    return;
+  }
+  // A partial shuffle, the drawn neighbors are moved behind the ones left
+  scratch->resize(num);
+  std::iota(scratch->begin(), scratch->end(), 0);
+  int64_t left = num;
+  for (int32_t i = 0; i < samples_num; ++i) {
+    if (left == 0) {
+      left = num;
+    }
+    std::uniform_int_distribution<int64_t> pick(0, left - 1);
+    std::swap((*scratch)[pick(*rnd)], (*scratch)[left - 1]);
+    --left;
+    out[i] = ids_[neighbors[(*scratch)[left]]];
+  }
+}
+
+bool GraphCsr::HasFeature(FeatureType feature_type, DataType *type, TensorShape *shape) const {
+  auto itr = features_.find(feature_type);
+  if (itr == features_.end()) {
+    return false;
+  }
+  if (type != nullptr) {
+    *type = itr->second.data_type;
+  }
+  if (shape != nullptr) {
+    *shape = TensorShape(itr->second.shape);
+  }
+  return true;
+}
+
+const uint8_t *GraphCsr::GetFeature(FeatureType feature_type, int32_t index, int64_t *size) const {
+  auto itr = features_.find(feature_type);
+  if (itr == features_.end() || itr->second.present[index] == 0) {
+    *size = 0;
+    return nullptr;
+  }
+  *size = itr->second.row_bytes;
+  return itr->second.values.data + index * itr->second.row_bytes;
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,179 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+
+#include <array>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// Feature type to pass when the edges carry no weight
+constexpr FeatureType kNoWeightFeature = -1;
+
+// An immutable compressed sparse row image of a graph. Nodes are kept by a dense index, the position of their id in
+// the sorted list of all node ids, so neighbors of one node and one type are a contiguous run of dense indices.
+// Per neighbor type the image holds
+//   offsets[num_nodes + 1] - the neighbors of node i are neighbors[offsets[i], offsets[i + 1]), sorted by index
+//   weights, alias_prob, alias_index - only when built with a weight feature, per neighbor. The alias tables of a
+//   node let a weighted neighbor be drawn in O(1)
+// and per node feature a row major matrix [num_nodes, feature size] plus a flag per node whether it has the feature.
+// The image is one flat block of memory, the views into it are checked once after it is built.
+class GraphCsr {
+ public:
+  GraphCsr();
+
+  ~GraphCsr();
+
+  // Build the image from the nodes and edges of a loaded graph
+  // @param nodes - All nodes by id
+  // @param edges - All edges by id, each edge makes its destination a neighbor of its source
+  // @param default_features - Default value of each node feature, only numeric features whose values all have the
+  // shape and type of the default are kept in columns
+  // @param FeatureType weight_feature - Scalar edge feature to weight the neighbors with, edges without it weigh 1.
+  // kNoWeightFeature leaves the neighbors unweighted and builds no alias tables
+  // @return Status - The error code return
+  Status Build(const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+               const std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> &edges,
+               const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_features,
+               FeatureType weight_feature = kNoWeightFeature);
+
+  // @return int32_t - Number of nodes
+  int32_t num_nodes() const { return static_cast<int32_t>(num_nodes_); }
+
+  // @return bool - Whether the neighbors are weighted and have alias tables
+  bool weighted() const { return weighted_; }
+
+  // Find the dense index of a node
+  // @param NodeIdType id - node id
+  // @param int32_t *index - Returned dense index
+  // @return Status - The error code return
+  Status GetIndex(NodeIdType id, int32_t *index) const;
+
+  // @param int32_t index - dense index
+  // @return NodeIdType - The node id at a dense index
+  NodeIdType GetId(int32_t index) const { return ids_[index]; }
+
+  // Get the neighbors of a node
+  // @param int32_t index - dense index of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int64_t *num - Returned number of neighbors
+  // @return const int32_t * - Dense indices of the neighbors in ascending order
+  const int32_t *GetNeighbors(int32_t index, NodeType neighbor_type, int64_t *num) const;
+
+  // Get the weights of the neighbors of a node, in the order of GetNeighbors
+  // @return const float * - The weights, nullptr if the graph is not weighted
+  const float *GetWeights(int32_t index, NodeType neighbor_type) const;
+
+  // Draw one neighbor of a node that has neighbors of the type, by weight if the graph is weighted
+  // @param int32_t index - dense index of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param std::mt19937 *rnd - random generator
+  // @return int64_t - Position of the neighbor in GetNeighbors
+  int64_t DrawNeighbor(int32_t index, NodeType neighbor_type, std::mt19937 *rnd) const;
+
+  // Sample neighbors of a node. Weighted graphs draw by weight with replacement, unweighted ones draw without
+  // replacement and start over when all neighbors are drawn. A node without such neighbors gets kDefaultNodeId
+  // @param int32_t index - dense index of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to sample
+  // @param std::mt19937 *rnd - random generator
+  // @param std::vector<int32_t> *scratch - buffer that is reused between calls
+  // @param NodeIdType *out - Returned ids of samples_num neighbors
+  void SampleNeighbors(int32_t index, NodeType neighbor_type, int32_t samples_num, std::mt19937 *rnd,
+                       std::vector<int32_t> *scratch, NodeIdType *out) const;
+
+  // Check whether a feature is kept in a column
+  // @param FeatureType feature_type -
+  // @param DataType *type - Returned type of the feature
+  // @param TensorShape *shape - Returned shape of the feature of one node
+  // @return bool - Whether the feature is kept in a column
+  bool HasFeature(FeatureType feature_type, DataType *type = nullptr, TensorShape *shape = nullptr) const;
+
+  // Get the value of a feature kept in a column
+  // @param FeatureType feature_type -
+  // @param int32_t index - dense index of the node
+  // @param int64_t *size - Returned size of the value in bytes
+  // @return const uint8_t * - The value, nullptr if the node does not have the feature
+  const uint8_t *GetFeature(FeatureType feature_type, int32_t index, int64_t *size) const;
+
+ private:
+  // A typed view into the image
+  template <typename T>
+  struct Array {
+    const T *data = nullptr;
+    int64_t size = 0;
+
+    const T &operator[](int64_t i) const { return data[i]; }
+  };
+
+  struct Adjacency {
+    NodeType type = 0;
+    Array<int64_t> offsets;
+    Array<int32_t> neighbors;
+    Array<float> weights;
+    Array<float> alias_prob;
+    Array<int32_t> alias_index;
+  };
+
+  struct FeatureColumn {
+    FeatureType type = 0;
+    DataType data_type;
+    std::vector<dsize_t> shape;
+    int64_t row_bytes = 0;
+    Array<uint8_t> present;
+    Array<uint8_t> values;
+  };
+
+  // Set up the views into the image and check that they fit into it
+  // @param const uint8_t *image - start of the image, 8 byte aligned
+  // @param int64_t size - size of the image in bytes
+  // @return Status - The error code return
+  Status Parse(const uint8_t *image, int64_t size);
+
+  void Reset();
+
+  const Adjacency *FindAdjacency(NodeType neighbor_type) const {
+    int32_t slot = adjacency_slot_[static_cast<uint8_t>(neighbor_type)];
+    return slot < 0 ? nullptr : &adjacency_[slot];
+  }
+
+  std::vector<int64_t> buffer_;  // Holds the image
+
+  int64_t num_nodes_;
+  bool weighted_;
+  bool contiguous_;  // Whether the sorted node ids have no gaps, then the index is id - ids_[0]
+  Array<NodeIdType> ids_;
+  std::vector<Adjacency> adjacency_;
+  std::array<int32_t, 256> adjacency_slot_;  // Position in adjacency_ by neighbor type, -1 if there is none
+  std::unordered_map<FeatureType, FeatureColumn> features_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
@@ -16,6 +16,8 @@
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <numeric>
@@ -24,6 +26,7 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
@@ -33,7 +36,8 @@ GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool
       num_workers_(num_workers),
       rnd_(GetRandomDevice()),
       random_walk_(this),
-      server_mode_(server_mode) {
+      server_mode_(server_mode),
+      edge_weight_feature_(kNoWeightFeature) {
   rnd_.seed(GetSeed());
   MS_LOG(INFO) << "num_workers:" << num_workers;
 }
@@ -77,24 +81,6 @@ Status GraphDataImpl::CreateTensorByVector(const std::vector<std::vector<T>> &da
   return Status::OK();
 }
 
-template <typename T>
-Status GraphDataImpl::ComplementVector(std::vector<std::vector<T>> *data, size_t max_size, T default_value) {
-  if (!data || data->empty()) {
-    RETURN_STATUS_UNEXPECTED("Input data is empty");
-  }
-  for (std::vector<T> &vec : *data) {
-    size_t size = vec.size();
-    if (size > max_size) {
-      RETURN_STATUS_UNEXPECTED("The max_size parameter is abnormal");
-    } else {
-      for (size_t i = 0; i < (max_size - size); ++i) {
-        vec.push_back(default_value);
-      }
-    }
-  }
-  return Status::OK();
-}
-
 Status GraphDataImpl::GetAllEdges(EdgeType edge_type, std::shared_ptr<Tensor> *out) {
   auto itr = edge_type_map_.find(edge_type);
   if (itr == edge_type_map_.end()) {
@@ -133,19 +119,31 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   CHECK_FAIL_RETURN_UNEXPECTED(!node_list.empty(), "Input node_list is empty.");
   RETURN_IF_NOT_OK(CheckNeighborType(neighbor_type));
 
-  std::vector<std::vector<NodeIdType>> neighbors;
-  size_t max_neighbor_num = 0;
-  neighbors.resize(node_list.size());
+  std::vector<int32_t> indices(node_list.size());
+  int64_t max_neighbor_num = 0;
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
-    max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
+    RETURN_IF_NOT_OK(csr_->GetIndex(node_list[i], &indices[i]));
+    int64_t num = 0;
+    (void)csr_->GetNeighbors(indices[i], neighbor_type, &num);
+    max_neighbor_num = std::max(max_neighbor_num, num);
   }
 
-  RETURN_IF_NOT_OK(ComplementVector<NodeIdType>(&neighbors, max_neighbor_num, kDefaultNodeId));
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors, DataType(DataType::DE_INT32), out));
-
+  // The node itself comes first, rows with fewer neighbors are filled with kDefaultNodeId
+  dsize_t row_size = max_neighbor_num + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(node_list.size()), row_size}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *row = reinterpret_cast<NodeIdType *>(const_cast<uchar *>(tensor->GetBuffer()));
+  for (size_t i = 0; i < node_list.size(); ++i, row += row_size) {
+    int64_t num = 0;
+    const int32_t *neighbor_index = csr_->GetNeighbors(indices[i], neighbor_type, &num);
+    row[0] = node_list[i];
+    std::transform(neighbor_index, neighbor_index + num, row + 1,
+                   [this](int32_t neighbor) { return csr_->GetId(neighbor); });
+    std::fill(row + 1 + num, row + row_size, kDefaultNodeId);
+  }
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
@@ -181,52 +179,87 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   for (const auto &type : neighbor_types) {
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
-  std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
-    for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
+  // A row holds the node, then the samples of each hop, neighbor_nums[i] for every node sampled by the hop before
+  dsize_t row_size = 1;
+  dsize_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(node_list.size()), row_size}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *data = reinterpret_cast<NodeIdType *>(const_cast<uchar *>(tensor->GetBuffer()));
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), [&](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    std::vector<int32_t> scratch;
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      NodeIdType *row = data + node_idx * row_size;
+      int32_t index = 0;
+      RETURN_IF_NOT_OK(csr_->GetIndex(node_list[node_idx], &index));
+      row[0] = node_list[node_idx];
+      const NodeIdType *input = row;
+      dsize_t input_size = 1;
+      NodeIdType *samples = row + 1;
+      for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+        const NodeIdType *hop = samples;
+        for (dsize_t j = 0; j < input_size; ++j) {
+          if (input[j] == kDefaultNodeId) {
+            std::fill(samples, samples + neighbor_nums[i], kDefaultNodeId);
+          } else {
+            RETURN_IF_NOT_OK(csr_->GetIndex(input[j], &index));
+            csr_->SampleNeighbors(index, neighbor_types[i], neighbor_nums[i], rnd, &scratch, samples);
           }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
+          samples += neighbor_nums[i];
         }
+        input = hop;
+        input_size *= neighbor_nums[i];
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  }));
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
-Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                                     size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
-                                     int32_t samples_num, std::vector<NodeIdType> *out_samples) {
+Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> &exclude_data,
+                                     int32_t samples_num, std::mt19937 *rnd, std::vector<NodeIdType> *scratch,
+                                     NodeIdType *out_samples) {
   CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
-  size_t index = *start_index;
-  for (size_t i = index; i < shuffled_ids.size(); ++i) {
-    ++index;
-    if (exclude_data.find(data[shuffled_ids[i]]) != exclude_data.end()) {
-      continue;
+  // With few samples and at least half of the data left, drawing until a node is neither excluded nor drawn
+  // already takes at most two tries per sample on average
+  const int32_t kMaxRejectionSamples = 64;
+  if (samples_num <= kMaxRejectionSamples && (samples_num + exclude_data.size()) * 2 <= data.size()) {
+    std::uniform_int_distribution<size_t> distribution(0, data.size() - 1);
+    int32_t num = 0;
+    while (num < samples_num) {
+      NodeIdType id = data[distribution(*rnd)];
+      if (!std::binary_search(exclude_data.begin(), exclude_data.end(), id) &&
+          std::find(out_samples, out_samples + num, id) == out_samples + num) {
+        out_samples[num++] = id;
+      }
     }
-    out_samples->emplace_back(data[shuffled_ids[i]]);
-    if (out_samples->size() >= samples_num) {
-      break;
+    return Status::OK();
+  }
+
+  // Otherwise shuffle the nodes that are left as they are drawn, and start over when all of them are drawn
+  scratch->clear();
+  std::copy_if(data.begin(), data.end(), std::back_inserter(*scratch), [&exclude_data](NodeIdType id) {
+    return !std::binary_search(exclude_data.begin(), exclude_data.end(), id);
+  });
+  if (scratch->empty()) {
+    std::fill(out_samples, out_samples + samples_num, kDefaultNodeId);
+    return Status::OK();
+  }
+  size_t next = 0;
+  for (int32_t i = 0; i < samples_num; ++i, ++next) {
+    if (next == scratch->size()) {
+      next = 0;
     }
+    std::uniform_int_distribution<size_t> distribution(next, scratch->size() - 1);
+    std::swap((*scratch)[next], (*scratch)[distribution(*rnd)]);
+    out_samples[i] = (*scratch)[next];
   }
-  *start_index = index;
   return Status::OK();
 }
 
@@ -237,48 +270,34 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   RETURN_IF_NOT_OK(CheckNeighborType(neg_neighbor_type));
 
   const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
-  std::vector<NodeIdType> shuffled_id(all_nodes.size());
-  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-  size_t start_index = 0;
-  bool need_shuffle = false;
-
-  std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
-  neg_neighbors_vec.resize(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
-    std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
-    std::unordered_set<NodeIdType> exclude_nodes;
-    std::transform(neighbors.begin(), neighbors.end(),
-                   std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
-                   [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
-    if (all_nodes.size() > exclude_nodes.size()) {
-      while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
-        RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
-                                        &neg_neighbors_vec[node_idx]));
-        if (start_index >= shuffled_id.size()) {
-          start_index = start_index % shuffled_id.size();
-          need_shuffle = true;
-        }
-      }
-    } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
-                    << " neg_neighbor_type:" << neg_neighbor_type;
-      // If there are no negative neighbors, they are filled with kDefaultNodeId
-      for (int32_t i = 0; i < samples_num; ++i) {
-        neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
-      }
-    }
-    if (need_shuffle) {
-      std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-      start_index = 0;
-      need_shuffle = false;
+  dsize_t row_size = samples_num + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(node_list.size()), row_size}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *data = reinterpret_cast<NodeIdType *>(const_cast<uchar *>(tensor->GetBuffer()));
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), [&](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    std::vector<NodeIdType> exclude_nodes;
+    std::vector<NodeIdType> scratch;
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      NodeIdType node_id = node_list[node_idx];
+      int32_t index = 0;
+      RETURN_IF_NOT_OK(csr_->GetIndex(node_id, &index));
+      // The neighbors and the node itself are excluded, the neighbors come in ascending order of their ids
+      int64_t num = 0;
+      const int32_t *neighbor_index = csr_->GetNeighbors(index, neg_neighbor_type, &num);
+      exclude_nodes.resize(num);
+      std::transform(neighbor_index, neighbor_index + num, exclude_nodes.begin(),
+                     [this](int32_t neighbor) { return csr_->GetId(neighbor); });
+      (void)exclude_nodes.insert(std::lower_bound(exclude_nodes.begin(), exclude_nodes.end(), node_id), node_id);
+      exclude_nodes.erase(std::unique(exclude_nodes.begin(), exclude_nodes.end()), exclude_nodes.end());
+      NodeIdType *row = data + node_idx * row_size;
+      row[0] = node_id;
+      RETURN_IF_NOT_OK(NegativeSample(all_nodes, exclude_nodes, samples_num, rnd, &scratch, row + 1));
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neg_neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  }));
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
@@ -286,9 +305,7 @@ Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
   RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
-  std::vector<std::vector<NodeIdType>> walks;
-  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
+  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(out));
   return Status::OK();
 }
 
@@ -333,20 +350,44 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
-      } else {
-        std::shared_ptr<Node> node;
-        RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
-        if (!node->GetFeatures(f_type, &feature).IsOk()) {
+    DataType column_type;
+    TensorShape column_shape = TensorShape::CreateUnknownRankShape();
+    if (csr_->HasFeature(f_type, &column_type, &column_shape) && column_type == default_feature->Value()->type() &&
+        column_shape == default_feature->Value()->shape()) {
+      // Copy the rows of the column
+      const uchar *default_value = default_feature->Value()->GetBuffer();
+      int64_t row_bytes = default_feature->Value()->SizeInBytes();
+      uchar *out_value = const_cast<uchar *>(fea_tensor->GetBuffer());
+      for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+        const uchar *value = default_value;
+        if (*node_itr != kDefaultNodeId) {
+          int32_t index = 0;
+          RETURN_IF_NOT_OK(csr_->GetIndex(*node_itr, &index));
+          int64_t size = 0;
+          const uchar *row = csr_->GetFeature(f_type, index, &size);
+          value = row != nullptr ? row : default_value;
+        }
+        if (row_bytes > 0) {
+          (void)memcpy(out_value, value, row_bytes);
+        }
+        out_value += row_bytes;
+      }
+    } else {
+      dsize_t index = 0;
+      for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+        std::shared_ptr<Feature> feature;
+        if (*node_itr == kDefaultNodeId) {
           feature = default_feature;
+        } else {
+          std::shared_ptr<Node> node;
+          RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
+          if (!node->GetFeatures(f_type, &feature).IsOk()) {
+            feature = default_feature;
+          }
         }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(nodes->shape());
@@ -480,6 +521,64 @@ Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &
 
 Status GraphDataImpl::Init() {
   RETURN_IF_NOT_OK(LoadNodeAndEdge());
+  RETURN_IF_NOT_OK(BuildCsr());
+  return Status::OK();
+}
+
+Status GraphDataImpl::InitFromMemory(const std::vector<std::shared_ptr<Node>> &nodes,
+                                     const std::vector<std::shared_ptr<Edge>> &edges) {
+  CHECK_FAIL_RETURN_UNEXPECTED(node_id_map_.empty(), "The graph is initialized already.");
+  for (const auto &node : nodes) {
+    CHECK_FAIL_RETURN_UNEXPECTED(node_id_map_.insert({node->id(), node}).second,
+                                 "Duplicate node id:" + std::to_string(node->id()));
+    node_type_map_[node->type()].push_back(node->id());
+  }
+  for (const auto &edge : edges) {
+    CHECK_FAIL_RETURN_UNEXPECTED(edge_id_map_.insert({edge->id(), edge}).second,
+                                 "Duplicate edge id:" + std::to_string(edge->id()));
+    edge_type_map_[edge->type()].push_back(edge->id());
+  }
+  RETURN_IF_NOT_OK(BuildCsr());
+  return Status::OK();
+}
+
+Status GraphDataImpl::ParallelFor(size_t num, const std::function<Status(size_t, size_t, std::mt19937 *)> &func) {
+  size_t num_chunks = (num + kGnnChunkSize - 1) / kGnnChunkSize;
+  // One draw per call, so consecutive calls differ and a seed repeats all of them
+  uint32_t seed = rnd_();
+  std::vector<Status> rc(num_chunks);
+  std::atomic<size_t> next_chunk(0);
+  auto run_chunks = [&]() {
+    for (size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+      std::seed_seq seed_seq{seed, static_cast<uint32_t>(chunk)};
+      std::mt19937 rnd(seed_seq);
+      size_t begin = chunk * kGnnChunkSize;
+      rc[chunk] = func(begin, std::min(begin + kGnnChunkSize, num), &rnd);
+    }
+  };
+
+  size_t num_threads = std::min(static_cast<size_t>(std::max(num_workers_, 1)), num_chunks);
+  if (num_threads <= 1) {
+    run_chunks();
+  } else {
+    // The calling thread takes chunks too, and the workers that did start finish the chunks if one fails to start
+    TaskGroup vg;
+    Status create_rc;
+    for (size_t i = 1; i < num_threads && create_rc.IsOk(); ++i) {
+      create_rc = vg.CreateAsyncTask("GraphSampler", [&run_chunks]() {
+        TaskManager::FindMe()->Post();
+        run_chunks();
+        return Status::OK();
+      });
+    }
+    run_chunks();
+    RETURN_IF_NOT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+    RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+    RETURN_IF_NOT_OK(create_rc);
+  }
+  for (const auto &chunk_rc : rc) {
+    RETURN_IF_NOT_OK(chunk_rc);
+  }
   return Status::OK();
 }
 
@@ -545,6 +644,29 @@ Status GraphDataImpl::LoadNodeAndEdge() {
   return Status::OK();
 }
 
+Status GraphDataImpl::BuildCsr() {
+  csr_ = std::make_unique<GraphCsr>();
+  // Features of the server live in shared memory, only their offsets are kept by the nodes
+  std::unordered_map<FeatureType, std::shared_ptr<Feature>> no_features;
+  RETURN_IF_NOT_OK(csr_->Build(node_id_map_, edge_id_map_, server_mode_ ? no_features : default_node_feature_map_,
+                               edge_weight_feature_));
+  std::vector<FeatureType> columns;
+  for (const auto &feature : default_node_feature_map_) {
+    if (!server_mode_ && csr_->HasFeature(feature.first)) {
+      columns.push_back(feature.first);
+    }
+  }
+  for (const auto &node : node_id_map_) {
+    RETURN_IF_NOT_OK(node.second->ClearNeighbors());
+    for (auto type : columns) {
+      RETURN_IF_NOT_OK(node.second->RemoveFeature(type));
+    }
+  }
+  MS_LOG(INFO) << "Graph image of " << csr_->num_nodes() << " nodes built, " << columns.size()
+               << " node features kept in columns.";
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node) {
   auto itr = node_id_map_.find(id);
   if (itr == node_id_map_.end()) {
@@ -611,163 +733,92 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
-  // Simulate a random walk starting from start node.
-  auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(NodeIdType start_node, std::mt19937 *rnd,
+                                                   std::vector<float> *probability, NodeIdType *walk_path) {
+  const GraphCsr &csr = *graph_->csr_;
+  walk_path[0] = start_node;
+  int32_t prev = -1;
+  int32_t cur = 0;
+  RETURN_IF_NOT_OK(csr.GetIndex(start_node, &cur));
+  uint32_t step = 0;
   // walk simulate
-  while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
-    auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
-
-    // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
-
+  for (; step < meta_path_.size(); ++step) {
     // break if no neighbors
-    if (cur_neighbors.empty()) {
+    int64_t num = 0;
+    const int32_t *neighbors = csr.GetNeighbors(cur, meta_path_[step], &num);
+    if (num == 0) {
       break;
     }
-
     // walk by the fist node, then by the previous 2 nodes
-    std::shared_ptr<StochasticIndex> stochastic_index;
-    if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
-    } else {
-      NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
-    }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
-    walk.push_back(next_node_id);
-  }
-
-  while (walk.size() - 1 < meta_path_.size()) {
-    walk.push_back(default_node_);
+    int32_t next = step == 0 ? neighbors[csr.DrawNeighbor(cur, meta_path_[0], rnd)]
+                             : WalkToNextNode(prev, cur, step, rnd, probability);
+    walk_path[step + 1] = csr.GetId(next);
+    prev = cur;
+    cur = next;
   }
-
-  *walk_path = std::move(walk);
+  std::fill(walk_path + step + 1, walk_path + meta_path_.size() + 1, default_node_);
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
+Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::shared_ptr<Tensor> *walks) {
+  // Walk i starts from node i % size of the node list
+  size_t num = static_cast<size_t>(num_walks_) * node_list_.size();
+  dsize_t row_size = meta_path_.size() + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(num), row_size}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *data = reinterpret_cast<NodeIdType *>(const_cast<uchar *>(tensor->GetBuffer()));
+  RETURN_IF_NOT_OK(graph_->ParallelFor(num, [&](size_t begin, size_t end, std::mt19937 *rnd) -> Status {
+    std::vector<float> probability;
+    for (size_t i = begin; i < end; ++i) {
+      RETURN_IF_NOT_OK(Node2vecWalk(node_list_[i % node_list_.size()], rnd, &probability, data + i * row_size));
     }
-  }
-  return Status::OK();
-}
-
-Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                                                         std::shared_ptr<StochasticIndex> *node_probability) {
-  // Generate alias nodes
-  std::shared_ptr<Node> node;
-  graph_->GetNodeByNodeId(node_id, &node);
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
-  *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    return Status::OK();
+  }));
+  tensor->Squeeze();
+  *walks = std::move(tensor);
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
-                                                         std::shared_ptr<StochasticIndex> *edge_probability) {
-  // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  graph_->GetNodeByNodeId(src, &src_node);
-  std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
-
-  std::shared_ptr<Node> dst_node;
-  graph_->GetNodeByNodeId(dst, &dst_node);
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
-
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
-  std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
-    if (dst_nbr == src) {
-      non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
-      continue;
+int32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(int32_t prev, int32_t cur, uint32_t step, std::mt19937 *rnd,
+                                                      std::vector<float> *probability) {
+  const GraphCsr &csr = *graph_->csr_;
+  int64_t prev_num = 0;
+  const int32_t *prev_neighbors = csr.GetNeighbors(prev, meta_path_[step - 1], &prev_num);
+  int64_t num = 0;
+  const int32_t *neighbors = csr.GetNeighbors(cur, meta_path_[step], &num);
+  const float *weights = csr.GetWeights(cur, meta_path_[step]);
+
+  // Both neighbor lists are sorted, so the common neighbors are found by merging them
+  probability->resize(num);
+  float sum_probability = 0;
+  int64_t j = 0;
+  for (int64_t i = 0; i < num; ++i) {
+    float weight = weights != nullptr ? weights[i] : 1.0;
+    while (j < prev_num && prev_neighbors[j] < neighbors[i]) {
+      ++j;
     }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    if (neighbors[i] == prev) {
+      (*probability)[i] = weight / step_home_param_;
+    } else if (j < prev_num && prev_neighbors[j] == neighbors[i]) {
       // stay close, this node connect both src and dst
-      non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
+      (*probability)[i] = weight;
     } else {
       // step far away
-      non_normalized_probability.push_back(1.0 / step_away_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
+      (*probability)[i] = weight / step_away_param_;
     }
+    sum_probability += (*probability)[i];
   }
 
-  *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
-  return Status::OK();
-}
-
-StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
-  uint32_t K = probability.size();
-  std::vector<int32_t> switch_to_large_index(K, 0);
-  std::vector<float> weight(K, .0);
-  std::vector<int32_t> smaller;
-  std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
-  float accumulate_threshold = 0.0;
-  for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
-    accumulate_threshold += threshold_one;
-    weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
-    weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
-  }
-
-  while ((!smaller.empty()) && (!larger.empty())) {
-    uint32_t small = smaller.back();
-    smaller.pop_back();
-    uint32_t large = larger.back();
-    larger.pop_back();
-    switch_to_large_index[small] = large;
-    weight[large] = weight[large] + weight[small] - 1.0;
-    weight[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
-  }
-  return StochasticIndex(switch_to_large_index, weight);
-}
-
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
-  const uint32_t size_of_index = switch_to_large_index.size();
-
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
-
-  // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
-
-  if (distribution(random_device) < weight[random_idx]) {
-    return random_idx;
+  std::uniform_real_distribution<float> distribution(0.0, sum_probability);
+  float threshold = distribution(*rnd);
+  for (int64_t i = 0; i < num - 1; ++i) {
+    threshold -= (*probability)[i];
+    if (threshold < 0) {
+      return neighbors[i];
+    }
   }
-  return switch_to_large_index[random_idx];
-}
-
-template <typename T>
-std::vector<float> GraphDataImpl::RandomWalkBase::Normalize(const std::vector<T> &non_normalized_probability) {
-  float sum_probability =
-    1.0 * std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0);
-  if (sum_probability < kGnnEpsilon) {
-    sum_probability = 1.0;
-  }
-  std::vector<float> normalized_probability;
-  std::transform(non_normalized_probability.begin(), non_normalized_probability.end(),
-                 std::back_inserter(normalized_probability), [&](T value) -> float { return value / sum_probability; });
-  return normalized_probability;
+  return neighbors[num - 1];
 }
 }  // namespace gnn
 }  // namespace dataset
@@ -17,7 +17,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <random>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -25,6 +27,7 @@
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,7 +40,8 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
-using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
+// Number of nodes a worker takes at a time in the batched queries, each such chunk has its own random generator
+const size_t kGnnChunkSize = 256;
 
 class GraphDataImpl : public GraphData {
  public:
@@ -148,8 +152,20 @@ class GraphDataImpl : public GraphData {
     return &default_edge_feature_map_;
   }
 
+  // Weight the neighbors by a scalar edge feature when sampling them, has to be set before Init
+  // @param FeatureType feature_type - type of the edge feature
+  void set_edge_weight_feature(FeatureType feature_type) { edge_weight_feature_ = feature_type; }
+
   Status Init() override;
 
+  // Initialize from nodes and edges that are already in memory instead of the dataset file
+  // @param std::vector<std::shared_ptr<Node>> nodes -
+  // @param std::vector<std::shared_ptr<Edge>> edges - Edges between the nodes, each makes its destination a neighbor
+  // of its source
+  // @return Status - The error code return
+  Status InitFromMemory(const std::vector<std::shared_ptr<Node>> &nodes,
+                        const std::vector<std::shared_ptr<Edge>> &edges);
+
   Status Stop() override { return Status::OK(); }
 
   std::string GetDataSchema() { return data_schema_.dump(); }
@@ -172,23 +188,30 @@ class GraphDataImpl : public GraphData {
 
     ~RandomWalkBase() = default;
 
-    Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
+    // Walk num_walks times from every node of the list, on the workers of the graph
+    // @param std::shared_ptr<Tensor> *walks - Returned walks, one row of meta path size + 1 nodes per walk
+    // @return Status - The error code return
+    Status SimulateWalk(std::shared_ptr<Tensor> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
-
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
-
-    Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
-
-    static StochasticIndex GenerateProbability(const std::vector<float> &probability);
-
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
-
-    template <typename T>
-    std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
+    // Simulate a random walk starting from start node
+    // @param NodeIdType start_node -
+    // @param std::mt19937 *rnd - random generator
+    // @param std::vector<float> *probability - buffer that is reused between walks
+    // @param NodeIdType *walk_path - Returned meta path size + 1 nodes of the walk
+    // @return Status - The error code return
+    Status Node2vecWalk(NodeIdType start_node, std::mt19937 *rnd, std::vector<float> *probability,
+                        NodeIdType *walk_path);
+
+    // Draw the next node of a walk that came from prev to cur, both dense indices of the graph image
+    // @param int32_t prev - previous node
+    // @param int32_t cur - current node, which has neighbors of the type of the step
+    // @param uint32_t step - index of the step in meta_path_
+    // @param std::mt19937 *rnd - random generator
+    // @param std::vector<float> *probability - buffer that is reused between steps
+    // @return int32_t - dense index of the next node
+    int32_t WalkToNextNode(int32_t prev, int32_t cur, uint32_t step, std::mt19937 *rnd,
+                           std::vector<float> *probability);
 
     GraphDataImpl *graph_;
     std::vector<NodeIdType> node_list_;
@@ -205,6 +228,10 @@ class GraphDataImpl : public GraphData {
   // @return Status - The error code return
   Status LoadNodeAndEdge();
 
+  // Build the graph image for the neighbor and feature queries, and release what it holds from the nodes
+  // @return Status - The error code return
+  Status BuildCsr();
+
   // Create Tensor By Vector
   // @param std::vector<std::vector<T>> &data -
   // @param DataType type -
@@ -213,13 +240,13 @@ class GraphDataImpl : public GraphData {
   template <typename T>
   Status CreateTensorByVector(const std::vector<std::vector<T>> &data, DataType type, std::shared_ptr<Tensor> *out);
 
-  // Complete vector
-  // @param std::vector<std::vector<T>> *data - To be completed vector
-  // @param size_t max_size - The size of the completed vector
-  // @param T default_value - Filled default
-  // @return Status - The error code return
-  template <typename T>
-  Status ComplementVector(std::vector<std::vector<T>> *data, size_t max_size, T default_value);
+  // Run a function over the indices [0, num) in chunks of kGnnChunkSize, on up to num_workers_ threads. Every chunk
+  // draws from its own random generator, seeded from rnd_ and the position of the chunk, so the results for a seed do
+  // not depend on the number of threads
+  // @param size_t num - Number of indices
+  // @param std::function func - Called with the range [begin, end) of a chunk and its random generator
+  // @return Status - The error of the first chunk that failed
+  Status ParallelFor(size_t num, const std::function<Status(size_t, size_t, std::mt19937 *)> &func);
 
   // Get the default feature of a node
   // @param FeatureType feature_type -
@@ -245,15 +272,18 @@ class GraphDataImpl : public GraphData {
   // @return Status - The error code return
   Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
 
-  // Negative sampling
-  // @param std::vector<NodeIdType> &input_data - The data set to be sampled
-  // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
+  // Negative sampling, without replacement until all nodes that are not excluded are drawn. If all nodes are
+  // excluded, the samples are filled with kDefaultNodeId
+  // @param std::vector<NodeIdType> &data - The data set to be sampled
+  // @param std::vector<NodeIdType> &exclude_data - Data to be excluded, in ascending order
   // @param int32_t samples_num -
-  // @param std::vector<NodeIdType> *out_samples - Sampling results returned
+  // @param std::mt19937 *rnd - random generator
+  // @param std::vector<NodeIdType> *scratch - buffer that is reused between calls
+  // @param NodeIdType *out_samples - Sampling results returned
   // @return Status - The error code return
-  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                        size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
-                        std::vector<NodeIdType> *out_samples);
+  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> &exclude_data,
+                        int32_t samples_num, std::mt19937 *rnd, std::vector<NodeIdType> *scratch,
+                        NodeIdType *out_samples);
 
   Status CheckSamplesNum(NodeIdType samples_num);
 
@@ -265,6 +295,8 @@ class GraphDataImpl : public GraphData {
   RandomWalkBase random_walk_;
   mindrecord::json data_schema_;
   bool server_mode_;
+  FeatureType edge_weight_feature_;
+  std::unique_ptr<GraphCsr> csr_;  // Neighbors and node features by dense index
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
 #endif
@@ -115,6 +115,16 @@ Status LocalNode::UpdateFeature(const std::shared_ptr<Feature> &feature) {
   }
 }
 
+Status LocalNode::ClearNeighbors() {
+  neighbor_nodes_.clear();
+  return Status::OK();
+}
+
+Status LocalNode::RemoveFeature(FeatureType feature_type) {
+  (void)features_.erase(feature_type);
+  return Status::OK();
+}
+
 }  // namespace gnn
 }  // namespace dataset
 }  // namespace mindspore
@@ -68,6 +68,15 @@ class LocalNode : public Node {
   // @return Status - The error code return
   Status UpdateFeature(const std::shared_ptr<Feature> &feature) override;
 
+  // Release the neighbors of node once they are kept in a GraphCsr
+  // @return Status - The error code return
+  Status ClearNeighbors() override;
+
+  // Release a feature of node once it is kept in a GraphCsr
+  // @param FeatureType feature_type - type of feature
+  // @return Status - The error code return
+  Status RemoveFeature(FeatureType feature_type) override;
+
  private:
   Status GetSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
                              std::vector<NodeIdType> *out);
@@ -29,15 +29,29 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+TFRecordCompression ToCompression(const std::string &compression_type) {
+  if (compression_type == "NONE") {
+    return TFRecordCompression::kNone;
+  } else if (compression_type == "GZIP") {
+    return TFRecordCompression::kGzip;
+  } else if (compression_type == "ZLIB") {
+    return TFRecordCompression::kZlib;
+  }
+  return TFRecordCompression::kAuto;
+}
+}  // namespace
 
 std::shared_ptr<DatasetNode> TFRecordNode::Copy() {
   std::shared_ptr<TFRecordNode> node;
   if (schema_obj_ != nullptr) {
     node = std::make_shared<TFRecordNode>(dataset_files_, schema_obj_, columns_list_, num_samples_, shuffle_,
-                                          num_shards_, shard_id_, shard_equal_rows_, cache_);
+                                          num_shards_, shard_id_, shard_equal_rows_, cache_, compression_type_,
+                                          verify_crc_);
   } else {
     node = std::make_shared<TFRecordNode>(dataset_files_, schema_path_, columns_list_, num_samples_, shuffle_,
-                                          num_shards_, shard_id_, shard_equal_rows_, cache_);
+                                          num_shards_, shard_id_, shard_equal_rows_, cache_, compression_type_,
+                                          verify_crc_);
   }
   return node;
 }
@@ -87,9 +101,13 @@ Status TFRecordNode::ValidateParams() {
     return Status(StatusCode::kSyntaxError, __LINE__, __FILE__, err_msg);
   }
 
+  RETURN_IF_NOT_OK(ValidateStringValue("TFRecordNode", compression_type_, {"AUTO", "NONE", "GZIP", "ZLIB"}));
+
+  TFRecordCompression compression = ToCompression(compression_type_);
   std::vector<std::string> invalid_files(dataset_files_.size());
-  auto it = std::copy_if(dataset_files_.begin(), dataset_files_.end(), invalid_files.begin(),
-                         [](const std::string &filename) { return !TFReaderOp::ValidateFirstRowCrc(filename); });
+  auto it = std::copy_if(
+    dataset_files_.begin(), dataset_files_.end(), invalid_files.begin(),
+    [compression](const std::string &filename) { return !TFReaderOp::ValidateFirstRowCrc(filename, compression); });
   invalid_files.resize(std::distance(invalid_files.begin(), it));
   std::string err_msg;
   if (!invalid_files.empty()) {
@@ -133,7 +151,8 @@ std::vector<std::shared_ptr<DatasetOp>> TFRecordNode::Build() {
   std::shared_ptr<TFReaderOp> tf_reader_op =
     std::make_shared<TFReaderOp>(num_workers_, worker_connector_size_, rows_per_buffer_, num_samples_, sorted_dir_files,
                                  std::move(data_schema), connector_que_size_, columns_list_, shuffle_files, num_shards_,
-                                 shard_id_, shard_equal_rows_, std::move(sampler_->Build()));
+                                 shard_id_, shard_equal_rows_, std::move(sampler_->Build()),
+                                 ToCompression(compression_type_), verify_crc_);
 
   build_status = tf_reader_op->Init();  // remove me after changing return val of Build()
   RETURN_EMPTY_IF_ERROR(build_status);
@@ -145,7 +164,7 @@ std::vector<std::shared_ptr<DatasetOp>> TFRecordNode::Build() {
     int64_t num_rows = 0;
 
     // First, get the number of rows in the dataset
-    build_status = TFReaderOp::CountTotalRows(&num_rows, sorted_dir_files);
+    build_status = TFReaderOp::CountTotalRows(&num_rows, sorted_dir_files, 1, false, ToCompression(compression_type_));
     RETURN_EMPTY_IF_ERROR(build_status);  // remove me after changing return val of Build()
 
     // Add the shuffle op after this op
@@ -181,10 +200,12 @@ Status TFRecordNode::GetDatasetSize(const std::shared_ptr<DatasetSizeGetter> &si
     // Data will be sharded by file
     std::vector<std::string> shard_file_list;
     RETURN_IF_NOT_OK(GetShardFileList(&shard_file_list));
-    RETURN_IF_NOT_OK(TFReaderOp::CountTotalRows(&num_rows, shard_file_list, 8, estimate));
+    RETURN_IF_NOT_OK(
+      TFReaderOp::CountTotalRows(&num_rows, shard_file_list, 8, estimate, ToCompression(compression_type_)));
   } else {
     // Data will be sharded by row
-    RETURN_IF_NOT_OK(TFReaderOp::CountTotalRows(&num_rows, dataset_files_, 8, estimate));
+    RETURN_IF_NOT_OK(
+      TFReaderOp::CountTotalRows(&num_rows, dataset_files_, 8, estimate, ToCompression(compression_type_)));
     num_rows = static_cast<int64_t>(ceil(num_rows / (num_shards_ * 1.0)));
   }
   *dataset_size = num_samples_ > 0 ? std::min(num_rows, num_samples_) : num_rows;
@@ -33,9 +33,11 @@ class TFRecordNode : public NonMappableSourceNode {
  public:
   /// \brief Constructor
   /// \note Parameter 'schema' is the path to the schema file
+  /// \note Parameter 'compression_type' is "AUTO" to detect the compression of each file, "NONE", "GZIP" or "ZLIB"
   TFRecordNode(const std::vector<std::string> &dataset_files, std::string schema,
                const std::vector<std::string> &columns_list, int64_t num_samples, ShuffleMode shuffle,
-               int32_t num_shards, int32_t shard_id, bool shard_equal_rows, std::shared_ptr<DatasetCache> cache)
+               int32_t num_shards, int32_t shard_id, bool shard_equal_rows, std::shared_ptr<DatasetCache> cache,
+               std::string compression_type = "AUTO", bool verify_crc = false)
       : NonMappableSourceNode(std::move(cache)),
         dataset_files_(dataset_files),
         schema_path_(schema),
@@ -44,13 +46,16 @@ class TFRecordNode : public NonMappableSourceNode {
         shuffle_(shuffle),
         num_shards_(num_shards),
         shard_id_(shard_id),
-        shard_equal_rows_(shard_equal_rows) {}
+        shard_equal_rows_(shard_equal_rows),
+        compression_type_(std::move(compression_type)),
+        verify_crc_(verify_crc) {}
 
   /// \brief Constructor
   /// \note Parameter 'schema' is shared pointer to Schema object
   TFRecordNode(const std::vector<std::string> &dataset_files, std::shared_ptr<SchemaObj> schema,
                const std::vector<std::string> &columns_list, int64_t num_samples, ShuffleMode shuffle,
-               int32_t num_shards, int32_t shard_id, bool shard_equal_rows, std::shared_ptr<DatasetCache> cache)
+               int32_t num_shards, int32_t shard_id, bool shard_equal_rows, std::shared_ptr<DatasetCache> cache,
+               std::string compression_type = "AUTO", bool verify_crc = false)
       : NonMappableSourceNode(std::move(cache)),
         dataset_files_(dataset_files),
         schema_obj_(schema),
@@ -59,7 +64,9 @@ class TFRecordNode : public NonMappableSourceNode {
         shuffle_(shuffle),
         num_shards_(num_shards),
         shard_id_(shard_id),
-        shard_equal_rows_(shard_equal_rows) {}
+        shard_equal_rows_(shard_equal_rows),
+        compression_type_(std::move(compression_type)),
+        verify_crc_(verify_crc) {}
 
   /// \brief Destructor
   ~TFRecordNode() = default;
@@ -112,6 +119,8 @@ class TFRecordNode : public NonMappableSourceNode {
   int32_t num_shards_;
   int32_t shard_id_;
   bool shard_equal_rows_;
+  std::string compression_type_;
+  bool verify_crc_;  // Whether to check the crc of every record that is read
 };
 
 }  // namespace dataset
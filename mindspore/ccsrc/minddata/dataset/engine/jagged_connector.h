@@ -29,8 +29,8 @@ namespace mindspore {
 namespace dataset {
 class JaggedConnector : public Connector<std::unique_ptr<DataBuffer>> {
  public:
-  JaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(num_producers, num_consumers, queue_capacity) {
+  JaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity, bool lock_free = false)
+      : Connector<std::unique_ptr<DataBuffer>>(num_producers, num_consumers, queue_capacity, lock_free) {
     for (int i = 0; i < num_producers; i++) {
       is_queue_finished_.push_back(false);
     }
@@ -17,8 +17,11 @@
 #include <memory>
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/kernels/image/fused_pixel_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
 
 namespace mindspore {
 namespace dataset {
@@ -47,6 +50,30 @@ Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified
     *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
     tfuncs.erase(next);
   }
+
+  // DecodeOp immediately followed by ResizeOp, JPEG images are then decoded at a reduced scale
+  for (auto decode = tfuncs.begin(); decode != tfuncs.end() && decode + 1 != tfuncs.end(); ++decode) {
+    auto resize = decode + 1;
+    if ((*decode)->Name() == kDecodeOp && (*resize)->Name() == kResizeOp &&
+        static_cast<DecodeOp *>(decode->get())->is_rgb_format()) {
+      *decode = std::static_pointer_cast<TensorOp>(
+        std::make_shared<DecodeResizeOp>(*static_cast<ResizeOp *>(resize->get())));
+      decode = tfuncs.erase(resize) - 1;
+    }
+  }
+
+  // Runs of per pixel ops (flips, Rescale, Normalize, HwcToChw, casts to float) become one FusedPixelOp
+  for (auto first = tfuncs.begin(); first != tfuncs.end(); ++first) {
+    auto fused = std::make_shared<FusedPixelOp>();
+    auto last = first;
+    while (last != tfuncs.end() && fused->Append(*last)) {
+      ++last;
+    }
+    if (fused->Worthwhile()) {
+      first = tfuncs.erase(first, last);
+      first = tfuncs.insert(first, std::static_pointer_cast<TensorOp>(fused));
+    }
+  }
   if (modified != nullptr) {
     *modified = true;
   } else {
@@ -0,0 +1,308 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/auto_tune.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+AutoTune::AutoTune(ExecutionTree *tree, int32_t cpu_budget, int64_t memory_budget)
+    : tree_(tree),
+      cpu_budget_(cpu_budget),
+      memory_budget_(memory_budget),
+      num_steps_(0),
+      over_memory_budget_(false) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  sampling_interval_ = std::max(cfg->monitor_sampling_interval(), 1);
+  autotune_interval_ = std::max(static_cast<int32_t>(cfg->autotune_interval()), sampling_interval_);
+  cpu_budget_ = CpuBudget(cpu_budget_);
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (memory_budget_ <= 0) {
+    const double kMemoryFraction = 0.8;
+    memory_budget_ = static_cast<int64_t>(kMemoryFraction * sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE));
+  }
+#endif
+}
+
+int32_t AutoTune::CpuBudget(int32_t cpu_budget) {
+  if (cpu_budget > 0) {
+    return cpu_budget;
+  }
+  return std::max(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+}
+
+void AutoTune::ReserveWorkers(ExecutionTree *tree, int32_t cpu_budget) {
+  int32_t budget = CpuBudget(cpu_budget);
+  for (auto &op : *tree) {
+    auto parallel_op = dynamic_cast<ParallelOp *>(&op);
+    if (parallel_op != nullptr && parallel_op->ActiveWorkersAdjustable()) {
+      parallel_op->ReserveWorkers(budget);
+    }
+  }
+}
+
+Status AutoTune::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+  Init();
+  int32_t elapsed = 0;
+  while (!this_thread::is_interrupted() && !(tree_->isFinished())) {
+    Sample();
+    std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
+    elapsed += sampling_interval_;
+    if (elapsed >= autotune_interval_) {
+      Step();
+      elapsed = 0;
+    }
+  }
+  LogConfiguration();
+  return Status::OK();
+}
+
+void AutoTune::Init() {
+  tunable_.clear();
+  for (auto &op : *tree_) {
+    auto parallel_op = dynamic_cast<ParallelOp *>(&op);
+    if (parallel_op != nullptr && parallel_op->ActiveWorkersAdjustable()) {
+      tunable_.push_back(parallel_op);
+    }
+  }
+  int32_t total = TotalActiveWorkers();
+  if (total <= cpu_budget_) {
+    return;
+  }
+  for (auto op : tunable_) {
+    op->SetActiveWorkers(op->active_workers() * cpu_budget_ / total);
+    MS_LOG(INFO) << "AutoTune: " << op->NameWithID() << " starts with " << op->active_workers() << " of "
+                 << op->num_workers() << " workers to fit into " << cpu_budget_ << " CPU cores.";
+  }
+}
+
+void AutoTune::Sample() {
+  DatasetOp *root = tree_->root().get();
+  for (auto &op : *tree_) {
+    if (&op == root) {
+      continue;
+    }
+    int32_t capacity = op.ConnectorCapacity();
+    // Only the queues of the active workers of an op fill up
+    auto parallel_op = dynamic_cast<ParallelOp *>(&op);
+    if (parallel_op != nullptr && parallel_op->ActiveWorkersAdjustable() && !op.inlined()) {
+      capacity = std::max(capacity * parallel_op->active_workers() / parallel_op->num_workers(), 1);
+    }
+    if (capacity <= 0) {
+      continue;
+    }
+    int32_t size = op.ConnectorSize();
+    OpStats &stats = stats_[op.id()];
+    stats.fill_sum += std::min(static_cast<double>(size) / capacity, 1.0);
+    stats.num_samples++;
+    if (size == 0) {
+      stats.empty_samples++;
+    } else if (size >= capacity) {
+      stats.full_samples++;
+    }
+  }
+}
+
+void AutoTune::Step() {
+  num_steps_++;
+  // Follow the most starved child down from the root
+  std::vector<DatasetOp *> path;
+  std::vector<double> fill;
+  DatasetOp *op = tree_->root().get();
+  while (op != nullptr && !op->Children().empty()) {
+    DatasetOp *starved = nullptr;
+    double lowest = 0;
+    for (auto &child : op->Children()) {
+      double child_fill = stats_[child->id()].AverageFill();
+      if (starved == nullptr || child_fill < lowest) {
+        starved = child.get();
+        lowest = child_fill;
+      }
+    }
+    op = starved;
+    // An inlined op has no queue of its own, its parent reads the queue of its child
+    if (!starved->inlined()) {
+      path.push_back(starved);
+      fill.push_back(lowest);
+    }
+  }
+  if (!path.empty()) {
+    OpStats &root_input = stats_[path[0]->id()];
+    if (root_input.empty_samples > 0 && root_input.full_samples > 0) {
+      root_input.bursty_steps++;
+    }
+  }
+
+  int64_t memory = ResidentMemory();
+  bool over_memory_budget = memory_budget_ > 0 && memory > memory_budget_;
+  if (over_memory_budget) {
+    // Every active worker holds buffers, give one back
+    auto largest = std::max_element(tunable_.begin(), tunable_.end(), [](ParallelOp *a, ParallelOp *b) {
+      return a->active_workers() < b->active_workers();
+    });
+    if (largest != tunable_.end() && (*largest)->active_workers() > 1) {
+      (*largest)->SetActiveWorkers((*largest)->active_workers() - 1);
+    }
+    if (!over_memory_budget_) {
+      MS_LOG(WARNING) << "AutoTune: the process uses " << memory << " bytes, more than its budget of "
+                      << memory_budget_ << " bytes. Workers are taken away until it fits.";
+    }
+  }
+  over_memory_budget_ = over_memory_budget;
+
+  int32_t bottleneck = FindBottleneck(fill);
+  if (bottleneck >= 0) {
+    OpStats &stats = stats_[path[bottleneck]->id()];
+    stats.bottleneck_steps++;
+    auto parallel_op = dynamic_cast<ParallelOp *>(path[bottleneck]);
+    bool grown = parallel_op != nullptr && parallel_op->ActiveWorkersAdjustable() && !over_memory_budget_ &&
+                 GrowWorkers(parallel_op);
+    if (!grown) {
+      stats.capped_steps++;
+    }
+  }
+
+  // Start new averages, the counts of the steps are kept for the advice
+  for (auto &item : stats_) {
+    item.second.fill_sum = 0;
+    item.second.num_samples = 0;
+    item.second.empty_samples = 0;
+    item.second.full_samples = 0;
+  }
+}
+
+bool AutoTune::GrowWorkers(ParallelOp *op) {
+  int32_t active = op->active_workers();
+  if (active >= op->num_workers()) {
+    return false;
+  }
+  if (TotalActiveWorkers() >= cpu_budget_) {
+    // An op whose output queue is backed up produces faster than it is consumed, it can spare a worker
+    ParallelOp *donor = nullptr;
+    double highest = kBackedUpFill;
+    for (auto other : tunable_) {
+      double other_fill = stats_[other->id()].AverageFill();
+      if (other != op && other->active_workers() > 1 && other_fill >= highest) {
+        donor = other;
+        highest = other_fill;
+      }
+    }
+    if (donor == nullptr) {
+      return false;
+    }
+    donor->SetActiveWorkers(donor->active_workers() - 1);
+    MS_LOG(INFO) << "AutoTune: " << donor->NameWithID() << " gives up a worker, it has " << donor->active_workers()
+                 << " active workers now.";
+  }
+  op->SetActiveWorkers(active + 1);
+  MS_LOG(INFO) << "AutoTune: " << op->NameWithID() << " is the bottleneck, it has " << op->active_workers()
+               << " active workers now.";
+  return true;
+}
+
+int32_t AutoTune::TotalActiveWorkers() const {
+  int32_t total = 0;
+  for (auto op : tunable_) {
+    total += op->active_workers();
+  }
+  return total;
+}
+
+void AutoTune::LogConfiguration() const {
+  std::ostringstream config;
+  std::ostringstream advice;
+  DatasetOp *root = tree_->root().get();
+  for (auto &op : *tree_) {
+    auto parallel_op = dynamic_cast<ParallelOp *>(&op);
+    bool tunable = parallel_op != nullptr && parallel_op->ActiveWorkersAdjustable();
+    int32_t workers = tunable ? parallel_op->active_workers() : op.num_workers();
+    config << "\n  " << op.NameWithID() << ": num_parallel_workers " << workers;
+    if (&op != root && !op.inlined()) {
+      config << ", connector capacity " << op.ConnectorCapacity();
+    }
+    auto itr = stats_.find(op.id());
+    if (itr == stats_.end()) {
+      continue;
+    }
+    const OpStats &stats = itr->second;
+    if (stats.bottleneck_steps > 0) {
+      config << ", the bottleneck in " << stats.bottleneck_steps << " steps";
+    }
+    std::string steps = std::to_string(stats.capped_steps) + " of " + std::to_string(num_steps_) + " steps";
+    if (stats.capped_steps > 0 && tunable && workers == op.num_workers()) {
+      advice << "\n  " << op.NameWithID() << " was the bottleneck with all its workers in " << steps
+             << ", raise its num_parallel_workers above " << workers << ".";
+    } else if (stats.capped_steps > 0 && tunable) {
+      advice << "\n  " << op.NameWithID() << " was the bottleneck at the CPU or memory budget in " << steps << ".";
+    } else if (stats.capped_steps > 0 && op.Children().empty()) {
+      advice << "\n  " << op.NameWithID() << " reads too slowly in " << steps
+             << ", raise its num_parallel_workers above " << workers << " or its rows_per_buffer.";
+    } else if (stats.capped_steps > 0) {
+      advice << "\n  " << op.NameWithID() << " was the bottleneck in " << steps
+             << ", raise its num_parallel_workers above " << workers << ".";
+    }
+    if (stats.bursty_steps > 0) {
+      advice << "\n  The output queue of " << op.NameWithID() << " ran both empty and full in "
+             << stats.bursty_steps << " of " << num_steps_ << " steps, raise the prefetch size above "
+             << GlobalContext::config_manager()->op_connector_size() << ".";
+    }
+  }
+  MS_LOG(INFO) << "AutoTune: final configuration after " << num_steps_ << " steps:" << config.str();
+  if (!advice.str().empty()) {
+    MS_LOG(WARNING) << "AutoTune: settings that can not be tuned while the pipeline runs:" << advice.str();
+  }
+}
+
+int32_t AutoTune::FindBottleneck(const std::vector<double> &fill) {
+  if (fill.empty() || fill[0] >= kStarvedFill) {
+    return -1;
+  }
+  // The first op that does not keep up with a backed up queue, or the leaf when the whole path waits for it
+  for (size_t i = 0; i + 1 < fill.size(); ++i) {
+    if (fill[i + 1] >= kBackedUpFill) {
+      return static_cast<int32_t>(i);
+    }
+  }
+  return static_cast<int32_t>(fill.size()) - 1;
+}
+
+int64_t AutoTune::ResidentMemory() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  std::ifstream statm("/proc/self/statm");
+  int64_t size = 0;
+  int64_t resident = 0;
+  if (statm >> size >> resident) {
+    return resident * sysconf(_SC_PAGESIZE);
+  }
+#endif
+  return 0;
+}
+}  // namespace dataset
+}  // namespace mindspore
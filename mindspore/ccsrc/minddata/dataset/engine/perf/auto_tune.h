@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class ExecutionTree;
+
+/// \brief Adjusts a running pipeline to the speed of its consumer. The fill of the output queue of every op is
+///     sampled every monitor sampling interval. Every autotune interval the path of the tree that starves the root is
+///     searched for its bottleneck, the op that keeps its consumer waiting while the queue it reads is backed up.
+///     Map and batch ops start with their num_parallel_workers and get one more active worker when they are the
+///     bottleneck, up to the CPU budget, as long as the active workers of all such ops fit into that budget and the
+///     process stays in its memory budget.
+///     When the tree stops, the configuration it ended with is logged so it can be frozen, together with advice for
+///     the settings that are fixed once the tree is built.
+class AutoTune {
+ public:
+  /// \brief A queue whose average fill is below this starves its consumer.
+  static constexpr double kStarvedFill = 0.2;
+
+  /// \brief A queue whose average fill is at least this is backed up, its consumer does not keep up.
+  static constexpr double kBackedUpFill = 0.5;
+
+  /// \brief Constructor
+  /// \param[in] tree The tree to tune.
+  /// \param[in] cpu_budget Most active workers of all tunable ops together, 0 for the number of CPU cores.
+  /// \param[in] memory_budget Most resident memory of the process in bytes, 0 for 80% of the physical memory.
+  explicit AutoTune(ExecutionTree *tree, int32_t cpu_budget = 0, int64_t memory_budget = 0);
+
+  ~AutoTune() = default;
+
+  /// \brief Main loop, the entry point of the autotune task.
+  /// \return Status The error code returned
+  Status operator()();
+
+  /// \brief Lets the tunable ops of a tree that is not prepared yet launch enough workers to grow to the CPU budget.
+  /// \param[in] tree The tree to tune.
+  /// \param[in] cpu_budget Most active workers of all tunable ops together, 0 for the number of CPU cores.
+  static void ReserveWorkers(ExecutionTree *tree, int32_t cpu_budget = 0);
+
+  /// \brief Finds the tunable ops and fits their active workers into the CPU budget, in proportion to their workers.
+  void Init();
+
+  /// \brief Samples the fill of the output queues of all ops but the root.
+  void Sample();
+
+  /// \brief Makes at most one adjustment from the samples since the last step and starts new averages.
+  void Step();
+
+  /// \brief Logs the configuration the tree runs with, and advice for the settings that can not be tuned.
+  void LogConfiguration() const;
+
+  /// \brief Finds the bottleneck on a path of the tree.
+  /// \param[in] fill The average fill of the output queues along the path, fill[0] is the queue the root reads, the
+  ///     last one the queue of a leaf.
+  /// \return The index of the first op from the root that reads a backed up queue, the leaf when no queue on the
+  ///     path is backed up, and -1 when the root is not starved.
+  static int32_t FindBottleneck(const std::vector<double> &fill);
+
+  /// \brief Resident memory of the process in bytes, 0 where it is not known.
+  static int64_t ResidentMemory();
+
+ private:
+  // Samples of the output queue of an op since the last step, and what the steps found for it
+  struct OpStats {
+    double fill_sum = 0;
+    int32_t num_samples = 0;
+    int32_t empty_samples = 0;
+    int32_t full_samples = 0;
+    int32_t bottleneck_steps = 0;  // Steps the op was the bottleneck
+    int32_t capped_steps = 0;      // Steps the op was the bottleneck and could not get another worker
+    int32_t bursty_steps = 0;      // Steps its queue was both empty and full, while the root read it
+
+    double AverageFill() const { return num_samples == 0 ? 1.0 : fill_sum / num_samples; }
+  };
+
+  static int32_t CpuBudget(int32_t cpu_budget);
+
+  int32_t TotalActiveWorkers() const;
+
+  // Gives op one more worker, taken from a tunable op with a backed up output queue when the CPU budget is used up
+  bool GrowWorkers(ParallelOp *op);
+
+  ExecutionTree *tree_;
+  int32_t cpu_budget_;
+  int64_t memory_budget_;
+  int32_t sampling_interval_;
+  int32_t autotune_interval_;
+  int32_t num_steps_;
+  bool over_memory_budget_;
+  std::map<int32_t, OpStats> stats_;  // By op id
+  std::vector<ParallelOp *> tunable_;  // The ops whose active workers can be adjusted
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
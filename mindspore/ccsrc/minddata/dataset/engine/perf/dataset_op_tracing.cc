@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <fstream>
+#include <string>
+#include "minddata/dataset/engine/perf/dataset_op_tracing.h"
+#include "minddata/dataset/util/path.h"
+#include "mindspore/core/utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+
+Status DatasetOpTracing::Record(const std::string &op_name, const int32_t worker_id, const int64_t start,
+                                const int64_t end) {
+  // Format: "op-name worker-id start end"
+  // Example:
+  // MapOp(ID:2) 1 1605168470123456 1605168470125456 - Worker 1 of the map op with id 2 worked on a buffer for 2ms.
+  std::string data =
+    op_name + " " + std::to_string(worker_id) + " " + std::to_string(start) + " " + std::to_string(end);
+  std::lock_guard<std::mutex> lock(mux_);
+  value_.emplace_back(std::move(data));
+  return Status::OK();
+}
+
+Status DatasetOpTracing::SaveToFile() {
+  std::lock_guard<std::mutex> lock(mux_);
+  if (value_.empty()) {
+    return Status::OK();
+  }
+
+  std::ofstream handle(file_path_, std::ios::trunc);
+  if (!handle.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Profiling file can not be opened.");
+  }
+  for (const auto &value : value_) {
+    handle << value << "\n";
+  }
+  handle.close();
+
+  return Status::OK();
+}
+
+Status DatasetOpTracing::Init(const std::string &dir_path, const std::string &device_id) {
+  file_path_ = (Path(dir_path) / Path("dataset_op_execute_timestamp_" + device_id + ".txt")).toString();
+  return Status::OK();
+}
+
+Status DatasetOpTracing::ChangeFileMode() {
+  std::lock_guard<std::mutex> lock(mux_);
+  if (value_.empty()) {
+    return Status::OK();
+  }
+
+  if (chmod(common::SafeCStr(file_path_), S_IRUSR | S_IWUSR) == -1) {
+    std::string err_str = "Change file mode failed," + file_path_;
+    return Status(StatusCode::kUnexpectedError, err_str);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_DATASET_OP_TRACING_H
+#define MINDSPORE_DATASET_OP_TRACING_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "minddata/dataset/engine/perf/profiling.h"
+
+namespace mindspore {
+namespace dataset {
+// Records when the workers of the dataset ops work on a buffer, so the pipeline can be laid on the timeline of the
+// kernels. The times are taken from the same host clock as the CPU op profiler.
+class DatasetOpTracing : public Tracing {
+ public:
+  // Constructor
+  DatasetOpTracing() = default;
+
+  // Destructor
+  ~DatasetOpTracing() override = default;
+
+  // Record tracing data, the workers of all ops record into the same node
+  // @param op_name - Name of the op with its id
+  // @param worker_id - Id of the worker that did the work
+  // @param start - Start time in us
+  // @param end - End time in us
+  // @return Status - The error code return
+  Status Record(const std::string &op_name, const int32_t worker_id, const int64_t start, const int64_t end);
+
+  std::string Name() const override { return kDatasetOpTracingName; };
+
+  // Save tracing data to file
+  // @return Status - The error code return
+  Status SaveToFile() override;
+
+  Status Init(const std::string &dir_path, const std::string &device_id) override;
+
+  Status ChangeFileMode() override;
+
+ private:
+  std::mutex mux_;
+  std::vector<std::string> value_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_DATASET_OP_TRACING_H
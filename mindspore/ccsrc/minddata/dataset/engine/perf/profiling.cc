@@ -25,6 +25,7 @@
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/connector_throughput.h"
 #include "minddata/dataset/engine/perf/dataset_iterator_tracing.h"
+#include "minddata/dataset/engine/perf/dataset_op_tracing.h"
 #include "minddata/dataset/util/log_adapter.h"
 
 namespace mindspore {
@@ -79,6 +80,10 @@ Status ProfilingManager::Initialize() {
   std::shared_ptr<Tracing> dataset_iterator_tracing = std::make_shared<DatasetIteratorTracing>();
   RETURN_IF_NOT_OK(RegisterTracingNode(dataset_iterator_tracing));
 
+  // dataset_op node records the work of the map and batch workers
+  std::shared_ptr<Tracing> dataset_op_tracing = std::make_shared<DatasetOpTracing>();
+  RETURN_IF_NOT_OK(RegisterTracingNode(dataset_op_tracing));
+
   std::shared_ptr<Sampling> connector_size_sampling = std::make_shared<ConnectorSize>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(connector_size_sampling));
 
@@ -181,5 +186,12 @@ int64_t ProfilingTime::GetCurMilliSecond() {
   using std::chrono::steady_clock;
   return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
 }
+
+int64_t ProfilingTime::GetCurMicroSecond() {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::system_clock;
+  return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
 }  // namespace dataset
 }  // namespace mindspore
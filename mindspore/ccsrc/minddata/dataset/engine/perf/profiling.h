@@ -31,6 +31,7 @@ class ExecutionTree;
 
 const char kDeviceQueueTracingName[] = "Device_Queue_Tracing";
 const char kDatasetIteratorTracingName[] = "Dataset_Iterator_Tracing";
+const char kDatasetOpTracingName[] = "Dataset_Op_Tracing";
 const char kConnectorSizeSamplingName[] = "Connector_Size_Sampling";
 const char kConnectorThroughputSamplingName[] = "Connector_Throughput_Sampling";
 
@@ -145,6 +146,9 @@ enum ProfilingTimeSubType {
 class ProfilingTime {
  public:
   static int64_t GetCurMilliSecond();
+
+  // Microseconds of the system clock, the clock the CPU op profiler stamps the kernels with
+  static int64_t GetCurMicroSecond();
 };
 }  // namespace dataset
 }  // namespace mindspore
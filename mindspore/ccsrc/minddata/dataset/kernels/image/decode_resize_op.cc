@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+Status DecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (!IsNonEmptyJPEG(input)) {
+    DecodeOp op(true);
+    std::shared_ptr<Tensor> decoded;
+    RETURN_IF_NOT_OK(op.Compute(input, &decoded));
+    return ResizeOp::Compute(decoded, output);
+  }
+  int h_in = 0;
+  int w_in = 0;
+  RETURN_IF_NOT_OK(GetJpegImageInfo(input, &w_in, &h_in));
+  // The output size follows from the full size, the scaled size is rounded
+  int32_t output_h = 0;
+  int32_t output_w = 0;
+  RETURN_IF_NOT_OK(GetOutputSize(h_in, w_in, &output_h, &output_w));
+  std::shared_ptr<Tensor> decoded;
+  RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, 0, 0, 0, 0, JpegScaleNum(w_in, h_in, output_w, output_h)));
+  return Resize(decoded, output, output_h, output_w, 0.0, 0.0, interpolation_);
+}
+
+Status DecodeResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  int32_t output_h = size2_ != 0 ? size1_ : -1;
+  int32_t output_w = size2_ != 0 ? size2_ : -1;
+  if (inputs[0].Rank() == 1) outputs.emplace_back(TensorShape({output_h, output_w, 3}));
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+
+Status DecodeResizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_UINT8);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
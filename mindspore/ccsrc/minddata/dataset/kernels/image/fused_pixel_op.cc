@@ -0,0 +1,282 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_pixel_op.h"
+
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kNumRgbChannels = 3;
+
+// Writes one channel of a row, src points at the channel of the first pixel to read and step is the distance between
+// pixels, negative to read the row backwards.
+template <typename T>
+void AffineChannelRow(const T *src, int64_t step, int64_t width, float scale, float shift, float *dst) {
+  for (int64_t x = 0; x < width; ++x) {
+    dst[x] = static_cast<float>(src[x * step]) * scale + shift;
+  }
+}
+
+// Writes a row of interleaved pixels, src points at the first pixel to read.
+template <typename T>
+void AffineInterleavedRow(const T *src, int64_t step, int64_t width, int64_t channels, const float *scale,
+                          const float *shift, float *dst) {
+  if (channels == kNumRgbChannels) {
+    for (int64_t x = 0; x < width; ++x) {
+      const T *pixel = src + x * step;
+      dst[x * kNumRgbChannels] = static_cast<float>(pixel[0]) * scale[0] + shift[0];
+      dst[x * kNumRgbChannels + 1] = static_cast<float>(pixel[1]) * scale[1] + shift[1];
+      dst[x * kNumRgbChannels + 2] = static_cast<float>(pixel[2]) * scale[2] + shift[2];
+    }
+    return;
+  }
+  // Without Normalize all channels share one scale and shift
+  for (int64_t x = 0; x < width; ++x) {
+    const T *pixel = src + x * step;
+    for (int64_t c = 0; c < channels; ++c) {
+      dst[x * channels + c] = static_cast<float>(pixel[c]) * scale[0] + shift[0];
+    }
+  }
+}
+
+Status ToFloat16Row(const float *src, int64_t size, bool check_range, float16 *dst) {
+  if (check_range) {
+    const float float16_max = static_cast<float>(std::numeric_limits<float16>::max());
+    const float float16_min = static_cast<float>(std::numeric_limits<float16>::lowest());
+    for (int64_t i = 0; i < size; ++i) {
+      if (src[i] > float16_max || src[i] < float16_min) {
+        RETURN_STATUS_UNEXPECTED("Value " + std::to_string(src[i]) + " is outside of valid float16 range [" +
+                                 std::to_string(float16_max) + ", " + std::to_string(float16_min) + "].");
+      }
+    }
+  }
+  for (int64_t i = 0; i < size; ++i) {
+    dst[i] = float16(src[i]);
+  }
+  return Status::OK();
+}
+
+// The single pass over an image of shape <H,W,C>. Output rows are written in order, each from one source row that
+// stays in cache while its channels are written.
+template <typename T, typename O>
+Status FusedPixelPass(const T *src, int64_t height, int64_t width, int64_t channels, bool flip_h, bool flip_v,
+                      const float *scale, const float *shift, bool to_chw, bool check_fp16_range, O *dst) {
+  const int64_t row_size = width * channels;
+  const int64_t plane = height * width;
+  // Pixels of a flipped row are read from its end
+  const int64_t step = flip_h ? -channels : channels;
+  const int64_t first = flip_h ? (width - 1) * channels : 0;
+  std::vector<float> row_buffer;
+  if (!std::is_same<O, float>::value) {
+    row_buffer.resize(to_chw ? width : row_size);
+  }
+  for (int64_t y = 0; y < height; ++y) {
+    const T *src_row = src + (flip_v ? height - 1 - y : y) * row_size + first;
+    if (to_chw) {
+      for (int64_t c = 0; c < channels; ++c) {
+        const int64_t k = channels == kNumRgbChannels ? c : 0;
+        O *dst_row = dst + c * plane + y * width;
+        if constexpr (std::is_same<O, float>::value) {
+          AffineChannelRow(src_row + c, step, width, scale[k], shift[k], dst_row);
+        } else {
+          AffineChannelRow(src_row + c, step, width, scale[k], shift[k], row_buffer.data());
+          RETURN_IF_NOT_OK(ToFloat16Row(row_buffer.data(), width, check_fp16_range, dst_row));
+        }
+      }
+    } else {
+      O *dst_row = dst + y * row_size;
+      if constexpr (std::is_same<O, float>::value) {
+        AffineInterleavedRow(src_row, step, width, channels, scale, shift, dst_row);
+      } else {
+        AffineInterleavedRow(src_row, step, width, channels, scale, shift, row_buffer.data());
+        RETURN_IF_NOT_OK(ToFloat16Row(row_buffer.data(), row_size, check_fp16_range, dst_row));
+      }
+    }
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status FusedPixelPass(const T *src, int64_t height, int64_t width, int64_t channels, bool flip_h, bool flip_v,
+                      const float *scale, const float *shift, bool to_chw, bool check_fp16_range,
+                      const std::shared_ptr<Tensor> &output) {
+  if (output->type() == DataType::DE_FLOAT16) {
+    return FusedPixelPass(src, height, width, channels, flip_h, flip_v, scale, shift, to_chw, check_fp16_range,
+                          &(*output->begin<float16>()));
+  }
+  return FusedPixelPass(src, height, width, channels, flip_h, flip_v, scale, shift, to_chw, false,
+                        &(*output->begin<float>()));
+}
+}  // namespace
+
+FusedPixelOp::FusedPixelOp()
+    : scale_(kNumRgbChannels, 1.0f),
+      shift_(kNumRgbChannels, 0.0f),
+      has_affine_(false),
+      per_channel_(false),
+      to_chw_(false),
+      cast_(false),
+      out_type_(DataType::DE_FLOAT32),
+      check_fp16_range_(false) {}
+
+void FusedPixelOp::AppendAffine(const std::vector<float> &scale, const std::vector<float> &shift) {
+  for (int64_t c = 0; c < kNumRgbChannels; ++c) {
+    scale_[c] = scale_[c] * scale[c];
+    shift_[c] = shift_[c] * scale[c] + shift[c];
+  }
+  has_affine_ = true;
+}
+
+bool FusedPixelOp::Append(const std::shared_ptr<TensorOp> &op) {
+  if (op == nullptr) {
+    return false;
+  }
+  const std::string name = op->Name();
+  // Flips and affine ops work on <H,W,C> images, so they have to come before HwcToChw and before any cast
+  const bool before_layout = !to_chw_ && !cast_;
+  if (name == kRescaleOp && before_layout) {
+    auto rescale = std::static_pointer_cast<RescaleOp>(op);
+    AppendAffine(std::vector<float>(kNumRgbChannels, rescale->rescale()),
+                 std::vector<float>(kNumRgbChannels, rescale->shift()));
+  } else if (name == kNormalizeOp && before_layout) {
+    auto normalize = std::static_pointer_cast<NormalizeOp>(op);
+    const std::shared_ptr<Tensor> &mean = normalize->mean();
+    const std::shared_ptr<Tensor> &std_dev = normalize->std_dev();
+    if (mean == nullptr || std_dev == nullptr || mean->type() != DataType::DE_FLOAT32 ||
+        std_dev->type() != DataType::DE_FLOAT32 || mean->Size() != kNumRgbChannels ||
+        std_dev->Size() != kNumRgbChannels) {
+      return false;
+    }
+    std::vector<float> scale(kNumRgbChannels);
+    std::vector<float> shift(kNumRgbChannels);
+    auto mean_itr = mean->begin<float>();
+    auto std_itr = std_dev->begin<float>();
+    for (int64_t c = 0; c < kNumRgbChannels; ++c, ++mean_itr, ++std_itr) {
+      // Same arithmetic as Normalize in image_utils
+      scale[c] = static_cast<float>(1.0 / *std_itr);
+      shift[c] = -*mean_itr / *std_itr;
+    }
+    AppendAffine(scale, shift);
+    per_channel_ = true;
+  } else if (name == kRandomHorizontalFlipOp && before_layout) {
+    horizontal_flips_.push_back(std::static_pointer_cast<RandomHorizontalFlipOp>(op));
+    is_deterministic_ = false;
+  } else if (name == kRandomVerticalFlipOp && before_layout) {
+    vertical_flips_.push_back(std::static_pointer_cast<RandomVerticalFlipOp>(op));
+    is_deterministic_ = false;
+  } else if (name == kHwcToChwOp && !to_chw_) {
+    to_chw_ = true;
+  } else if (name == kTypeCastOp && has_affine_) {
+    // The affine ops already produce float32, a cast back from float16 would lose the precision on its way
+    DataType type = std::static_pointer_cast<TypeCastOp>(op)->type();
+    if (type == DataType::DE_FLOAT16) {
+      out_type_ = type;
+    } else if (type != DataType::DE_FLOAT32 || out_type_ != DataType::DE_FLOAT32) {
+      return false;
+    }
+    cast_ = true;
+  } else if (name == kToFloat16Op && has_affine_ && out_type_ == DataType::DE_FLOAT32) {
+    out_type_ = DataType(DataType::DE_FLOAT16);
+    check_fp16_range_ = true;
+    cast_ = true;
+  } else {
+    return false;
+  }
+  ops_.push_back(op);
+  return true;
+}
+
+Status FusedPixelOp::ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> in = input;
+  for (auto &op : ops_) {
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(op->Compute(in, &out));
+    in = std::move(out);
+  }
+  *output = std::move(in);
+  return Status::OK();
+}
+
+Status FusedPixelOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (!has_affine_ || input->Rank() != 3 ||
+      (input->type() != DataType::DE_UINT8 && input->type() != DataType::DE_FLOAT32)) {
+    return ComputeUnfused(input, output);
+  }
+  const int64_t height = input->shape()[0];
+  const int64_t width = input->shape()[1];
+  const int64_t channels = input->shape()[2];
+  if ((per_channel_ && channels != kNumRgbChannels) || (to_chw_ && channels != 1 && channels != kNumRgbChannels)) {
+    // Let the original ops report the error
+    return ComputeUnfused(input, output);
+  }
+  bool flip_h = false;
+  bool flip_v = false;
+  for (auto &flip : horizontal_flips_) {
+    flip_h ^= flip->NextFlip();
+  }
+  for (auto &flip : vertical_flips_) {
+    flip_v ^= flip->NextFlip();
+  }
+  TensorShape out_shape = to_chw_ ? TensorShape({channels, height, width}) : input->shape();
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, out_type_, &out));
+  if (input->type() == DataType::DE_UINT8) {
+    RETURN_IF_NOT_OK(FusedPixelPass(reinterpret_cast<const uint8_t *>(input->GetBuffer()), height, width, channels,
+                                    flip_h, flip_v, scale_.data(), shift_.data(), to_chw_, check_fp16_range_, out));
+  } else {
+    RETURN_IF_NOT_OK(FusedPixelPass(reinterpret_cast<const float *>(input->GetBuffer()), height, width, channels,
+                                    flip_h, flip_v, scale_.data(), shift_.data(), to_chw_, check_fp16_range_, out));
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
+Status FusedPixelOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  if (to_chw_ && inputs[0].Rank() == 3) {
+    outputs[0] = TensorShape{inputs[0][2], inputs[0][0], inputs[0][1]};
+  }
+  return Status::OK();
+}
+
+Status FusedPixelOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  if (has_affine_) {
+    outputs[0] = out_type_;
+  }
+  return Status::OK();
+}
+
+void FusedPixelOp::Print(std::ostream &out) const {
+  out << Name() << ":";
+  for (auto &op : ops_) {
+    out << " " << op->Name();
+  }
+  out << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
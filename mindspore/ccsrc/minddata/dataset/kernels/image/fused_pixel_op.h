@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_PIXEL_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_PIXEL_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/random_vertical_flip_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Runs a chain of consecutive flips, per channel affine ops (Rescale, Normalize), HwcToChw and casts to a
+///     float type as one op. Each output element is written once, straight into the final layout and type, instead
+///     of one full image pass and one allocation per op. Built by TensorOpFusionPass.
+/// \note Images the single pass does not support, e.g. not rank 3 or not uint8/float32, run the original ops.
+///     The affine ops are folded into one scale and shift per channel, so results may differ from the unfused ops
+///     by float rounding.
+class FusedPixelOp : public TensorOp {
+ public:
+  FusedPixelOp();
+
+  ~FusedPixelOp() override = default;
+
+  /// \brief Adds op at the end of the chain.
+  /// \param[in] op The op that follows the ops already in the chain.
+  /// \return false when op can not be fused after the ops already in the chain, the chain is unchanged then.
+  bool Append(const std::shared_ptr<TensorOp> &op);
+
+  /// \brief Whether running the chain fused saves work over running its ops, i.e. it replaces at least two ops
+  ///     and produces floats.
+  bool Worthwhile() const { return ops_.size() > 1 && has_affine_; }
+
+  /// \brief Number of ops in the chain.
+  size_t NumOps() const { return ops_.size(); }
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kFusedPixelOp; }
+
+ private:
+  // Runs the original ops one after the other
+  Status ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  // Folds y = x * scale + shift, per channel when the vectors have 3 elements, into the chain
+  void AppendAffine(const std::vector<float> &scale, const std::vector<float> &shift);
+
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+  // Every flip op still draws for every image, two flips of the same direction cancel out
+  std::vector<std::shared_ptr<RandomHorizontalFlipOp>> horizontal_flips_;
+  std::vector<std::shared_ptr<RandomVerticalFlipOp>> vertical_flips_;
+  // Scale and shift of the three channels, all equal unless per_channel_
+  std::vector<float> scale_;
+  std::vector<float> shift_;
+  bool has_affine_;
+  bool per_channel_;
+  bool to_chw_;
+  bool cast_;
+  DataType out_type_;
+  bool check_fp16_range_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_PIXEL_OP_H_
@@ -282,8 +282,29 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
   throw std::runtime_error(jpeg_last_error_msg);
 }
 
+int JpegScaleNum(int width, int height, int target_width, int target_height) {
+  // libjpeg-turbo can scale by any multiple of 1/8, but only 1/8, 1/4 and 1/2 have its fast reduced size inverse DCTs,
+  // the other scales are barely faster than a full decode and resample the image once more
+  for (int scale_num = 1; scale_num < kJpegScaleDenom; scale_num *= 2) {
+    if (static_cast<int64_t>(width) * scale_num >= static_cast<int64_t>(target_width) * kJpegScaleDenom &&
+        static_cast<int64_t>(height) * scale_num >= static_cast<int64_t>(target_height) * kJpegScaleDenom) {
+      return scale_num;
+    }
+  }
+  return kJpegScaleDenom;
+}
+
+// Maps the range [*begin, *begin + *size) of full size pixels to the range of scaled pixels it touches
+static void JpegScaleRange(unsigned int full_size, unsigned int scaled_size, int *begin, int *size) {
+  int64_t end = *begin + *size;
+  int64_t scaled_begin = static_cast<int64_t>(*begin) * scaled_size / full_size;
+  int64_t scaled_end = std::min<int64_t>((end * scaled_size + full_size - 1) / full_size, scaled_size);
+  *begin = static_cast<int>(scaled_begin);
+  *size = static_cast<int>(std::max<int64_t>(scaled_end - scaled_begin, 1));
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_num) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -297,6 +318,10 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    if (scale_num > 0 && scale_num < kJpegScaleDenom) {
+      cinfo.scale_num = scale_num;
+      cinfo.scale_denom = kJpegScaleDenom;
+    }
     jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -304,9 +329,12 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
     crop_w = cinfo.output_width;
     crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError("Crop window is not valid");
+  } else if (cinfo.output_width != cinfo.image_width || cinfo.output_height != cinfo.image_height) {
+    JpegScaleRange(cinfo.image_width, cinfo.output_width, &crop_x, &crop_w);
+    JpegScaleRange(cinfo.image_height, cinfo.output_height, &crop_y, &crop_h);
   }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
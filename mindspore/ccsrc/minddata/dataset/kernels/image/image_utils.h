@@ -96,8 +96,27 @@ bool IsNonEmptyJPEG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Denominator of the scales libjpeg can decode at, scales are multiples of 1/8.
+constexpr int kJpegScaleDenom = 8;
+
+/// \brief Returns the smallest of the scales 1/8, 1/4, 1/2 and 1 at which an image of width x height is still at
+///     least target_width x target_height, in units of 1/kJpegScaleDenom. libjpeg scales while it does the inverse
+///     DCT, which is far cheaper than decoding at full size and resizing the result.
+/// \param width: width of the image, or of the part of it to decode
+/// \param height: height of the image, or of the part of it to decode
+/// \param target_width: width the decoded image is resized to
+/// \param target_height: height the decoded image is resized to
+/// \return kJpegScaleDenom when the image has to be decoded at full size
+int JpegScaleNum(int width, int height, int target_width, int target_height);
+
+/// \brief Decodes a JPEG image, or only a crop window of it.
+/// \param input: Tensor containing the not decoded image 1D bytes
+/// \param output: Decoded image Tensor of shape <H,W,C> and type DE_UINT8. Pixel order is RGB
+/// \param x, y, w, h: crop window in pixels of the full size image, all 0 decodes the whole image
+/// \param scale_num: decodes at scale_num / kJpegScaleDenom of the full size, see JpegScaleNum. A scaled crop window
+///     covers all the scaled pixels the window touches, so it can be up to one pixel larger than w, h scaled.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_num = kJpegScaleDenom);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -37,6 +37,10 @@ class NormalizeOp : public TensorOp {
 
   std::string Name() const override { return kNormalizeOp; }
 
+  const std::shared_ptr<Tensor> &mean() const { return mean_; }
+
+  const std::shared_ptr<Tensor> &std_dev() const { return std_; }
+
  private:
   std::shared_ptr<Tensor> mean_;
   std::shared_ptr<Tensor> std_;
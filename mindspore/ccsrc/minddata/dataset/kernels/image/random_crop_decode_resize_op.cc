@@ -47,8 +47,10 @@ Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, s
     int crop_width = 0;
     (void)GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width);
 
+    // Decode straight at the smallest scale that is still at least the target size
+    int scale_num = JpegScaleNum(crop_width, crop_height, target_width_, target_height_);
     std::shared_ptr<Tensor> decoded;
-    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height));
+    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height, scale_num));
     return Resize(decoded, output, target_height_, target_width_, 0.0, 0.0, interpolation_);
   }
 }
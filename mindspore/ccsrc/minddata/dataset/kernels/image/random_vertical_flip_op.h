@@ -43,6 +43,9 @@ class RandomVerticalFlipOp : public TensorOp {
 
   std::string Name() const override { return kRandomVerticalFlipOp; }
 
+  // Draws whether the next image is flipped, for ops that do the flip themselves
+  bool NextFlip() { return distribution_(rnd_); }
+
  private:
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
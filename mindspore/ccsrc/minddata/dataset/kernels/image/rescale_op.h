@@ -41,6 +41,10 @@ class RescaleOp : public TensorOp {
 
   std::string Name() const override { return kRescaleOp; }
 
+  float rescale() const { return rescale_; }
+
+  float shift() const { return shift_; }
+
  private:
   float rescale_;
   float shift_;
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/double_array_trie.h"
+
+#include <algorithm>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kNumCodes = 257;
+
+// Code of the byte at a depth of a word, 0 past its end
+inline int32_t CodeAt(std::string_view word, size_t depth) {
+  return depth < word.size() ? static_cast<unsigned char>(word[depth]) + 1 : 0;
+}
+}  // namespace
+
+DoubleArrayTrie::DoubleArrayTrie() { Build({}); }
+
+void DoubleArrayTrie::Build(std::vector<std::pair<std::string_view, int32_t>> words) {
+  // The words of a subtree are a range of the sorted words, a word sorts before the words it is a prefix of
+  std::sort(words.begin(), words.end());
+  base_.assign(kNumCodes, 0);
+  check_.assign(kNumCodes, -1);
+  check_[kRoot] = kRoot;
+  next_free_ = 1;
+
+  struct Subtree {
+    int32_t node;
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+  std::vector<Subtree> pending = {{kRoot, 0, words.size(), 0}};
+  std::vector<int32_t> codes;
+  std::vector<std::pair<size_t, size_t>> ranges;
+  while (!pending.empty()) {
+    Subtree subtree = pending.back();
+    pending.pop_back();
+    codes.clear();
+    ranges.clear();
+    for (size_t i = subtree.begin; i < subtree.end;) {
+      int32_t code = CodeAt(words[i].first, subtree.depth);
+      size_t j = i + 1;
+      while (j < subtree.end && CodeAt(words[j].first, subtree.depth) == code) {
+        ++j;
+      }
+      codes.push_back(code);
+      ranges.emplace_back(i, j);
+      i = j;
+    }
+    if (codes.empty()) {
+      continue;
+    }
+    int32_t base = Place(codes, subtree.node);
+    for (size_t k = 0; k < codes.size(); ++k) {
+      int32_t child = base + codes[k];
+      if (codes[k] == 0) {
+        base_[child] = -words[ranges[k].first].second - 1;
+      } else {
+        pending.push_back({child, ranges[k].first, ranges[k].second, subtree.depth + 1});
+      }
+    }
+  }
+
+  size_t size = check_.size();
+  while (size > 1 && check_[size - 1] < 0) {
+    --size;
+  }
+  base_.resize(size);
+  check_.resize(size);
+  base_.shrink_to_fit();
+  check_.shrink_to_fit();
+}
+
+int32_t DoubleArrayTrie::Place(const std::vector<int32_t> &codes, int32_t parent) {
+  // The first child takes a free position at or after next_free_, the others have to fit with it
+  size_t pos = std::max(next_free_, static_cast<size_t>(codes[0]) + 1);
+  int32_t base = 0;
+  while (true) {
+    Grow(pos + kNumCodes);
+    if (check_[pos] >= 0) {
+      ++pos;
+      continue;
+    }
+    base = static_cast<int32_t>(pos) - codes[0];
+    bool fits =
+      std::all_of(codes.begin() + 1, codes.end(), [this, base](int32_t code) { return check_[base + code] < 0; });
+    if (fits) {
+      break;
+    }
+    ++pos;
+  }
+  base_[parent] = base;
+  for (int32_t code : codes) {
+    check_[base + code] = parent;
+  }
+  while (next_free_ < check_.size() && check_[next_free_] >= 0) {
+    ++next_free_;
+  }
+  return base;
+}
+
+void DoubleArrayTrie::Grow(size_t size) {
+  if (size > check_.size()) {
+    size_t new_size = std::max(size, check_.size() * 2);
+    base_.resize(new_size, 0);
+    check_.resize(new_size, -1);
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
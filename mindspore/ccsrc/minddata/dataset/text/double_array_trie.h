@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+
+// A trie over a set of byte strings in two arrays. The children of node s are at base_[s] + code, with code 1 to 256
+// for a byte and 0 for the end of a word, and t is a child of s if check_[t] == s. The end of a word holds the value
+// of the word in its base, as -value - 1. Following a byte is two array reads, so the longest word that starts a
+// text is found in one pass over the text.
+class DoubleArrayTrie {
+ public:
+  static constexpr int32_t kRoot = 0;
+
+  // An empty trie
+  DoubleArrayTrie();
+
+  ~DoubleArrayTrie() = default;
+
+  // Build the trie, replacing what it held
+  // @param std::vector<std::pair<std::string_view, int32_t>> words - unique words and their values, values >= 0
+  void Build(std::vector<std::pair<std::string_view, int32_t>> words);
+
+  // Follow the bytes of a text down from a node
+  // @param std::string_view text - bytes to follow
+  // @param int32_t *node - the node to start from, returned node the text leads to
+  // @return bool - false if no word continues with the text, then the node is undefined
+  bool Follow(std::string_view text, int32_t *node) const {
+    for (unsigned char c : text) {
+      int64_t t = static_cast<int64_t>(base_[*node]) + c + 1;
+      if (t >= static_cast<int64_t>(check_.size()) || check_[t] != *node) {
+        return false;
+      }
+      *node = static_cast<int32_t>(t);
+    }
+    return true;
+  }
+
+  // @param int32_t node - a node returned by Follow
+  // @return int32_t - value of the word that ends at the node, -1 if no word ends there
+  int32_t Value(int32_t node) const {
+    int32_t t = base_[node];
+    return t < static_cast<int32_t>(check_.size()) && check_[t] == node ? -base_[t] - 1 : -1;
+  }
+
+ private:
+  // Find a base at which the children with the codes are free, and take their positions for the parent
+  // @param std::vector<int32_t> &codes - codes of the children in ascending order
+  // @param int32_t parent - parent node
+  // @return int32_t - the base
+  int32_t Place(const std::vector<int32_t> &codes, int32_t parent);
+
+  void Grow(size_t size);
+
+  std::vector<int32_t> base_;
+  std::vector<int32_t> check_;  // Parent of each position, -1 for a free one
+  size_t next_free_ = 1;        // No position below is free
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
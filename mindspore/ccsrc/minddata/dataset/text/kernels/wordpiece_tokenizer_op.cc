@@ -33,29 +33,38 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
       unknown_token_(unknown_token),
-      with_offsets_(with_offsets) {}
-
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "Out of range");
-  *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
+      with_offsets_(with_offsets) {
+  if (vocab_ != nullptr) {
+    std::vector<std::pair<std::string_view, int32_t>> words(vocab_->size());
+    for (size_t pos = 0; pos < words.size(); ++pos) {
+      words[pos] = {vocab_->word(pos), static_cast<int32_t>(pos)};
     }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
-      *out_found = true;
+    trie_.Build(std::move(words));
+  }
+}
+
+void WordpieceTokenizerOp::LookupWord(std::string_view input_token, const RuneStrArray &runes, size_t start,
+                                      int32_t *out_pos, size_t *out_end) const {
+  *out_pos = -1;
+  int32_t node = DoubleArrayTrie::kRoot;
+  if (start > 0 && !trie_.Follow(suffix_indicator_, &node)) {
+    return;
+  }
+  for (size_t i = start; i < runes.size(); ++i) {
+    if (!trie_.Follow(input_token.substr(runes[i].offset, runes[i].len), &node)) {
       break;
     }
+    int32_t pos = trie_.Value(node);
+    if (pos >= 0) {
+      *out_pos = pos;
+      *out_end = i + 1;
+    }
   }
-  return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
-                                          std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+Status WordpieceTokenizerOp::FoundNoToken(std::string_view input_token, const uint32_t &basic_start,
+                                          std::vector<std::string_view> *out_tokens,
+                                          std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
   out_tokens->clear();
   offsets_start->push_back(basic_start);
@@ -69,19 +78,9 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
-                                        std::vector<std::string> *out_tokens) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= input_token.size(), "Out of range");
-  std::string subword = input_token.substr(start, end - start);
-  if (start > 0) {
-    subword = suffix_indicator_ + subword;
-  }
-  out_tokens->emplace_back(subword);
-  return Status::OK();
-}
-
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
-                                       std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+Status WordpieceTokenizerOp::GetTokens(std::string_view input_token, const uint32_t &basic_start,
+                                       std::vector<std::string_view> *out_tokens,
+                                       std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > max_bytes_per_token_) {
     offsets_start->push_back(basic_start);
@@ -98,39 +97,40 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
     RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
   }
-  int end = 0;
-  for (int start = 0; start < input_token.size();) {
-    bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
-    if (found) {
-      RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
-      offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
-      offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
-      start = end;
-    } else {
+  for (size_t start = 0; start < runes.size();) {
+    int32_t pos = -1;
+    size_t end = 0;
+    LookupWord(input_token, runes, start, &pos, &end);
+    if (pos < 0) {
       return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
     }
+    out_tokens->emplace_back(vocab_->word(pos));
+    offsets_start->push_back(static_cast<uint32_t>(basic_start + runes[start].offset));
+    offsets_limit->push_back(static_cast<uint32_t>(basic_start + runes[end - 1].offset + runes[end - 1].len));
+    start = end;
   }
   return Status::OK();
 }
 
 Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
   if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("The input tensor should be scalar or 1-D string tensor.");
   }
   dsize_t count = 0;
-  std::vector<std::string> out_tokens;
+  std::vector<std::string_view> out_tokens;
   std::vector<uint32_t> offsets_start, offsets_limit;
+  std::vector<std::string_view> temp_tokens;  // The tokens of one word, reused between words
   std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
-    std::vector<std::string> temp_tokens;
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count, 0}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, &temp_tokens, &offsets_start, &offsets_limit));
     out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    temp_tokens.clear();
     count++;
   }
   if (out_tokens.empty()) {
@@ -138,7 +138,7 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
     offsets_start.push_back(0);
     offsets_limit.push_back(0);
   }
-  Tensor::CreateFromVector(out_tokens, &token_tensor);
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(out_tokens, &token_tensor));
   output->push_back(token_tensor);
   if (with_offsets_) {
     RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_start, &offsets_start_tensor));
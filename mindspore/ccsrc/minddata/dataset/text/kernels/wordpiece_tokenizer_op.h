@@ -24,6 +24,7 @@
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/text/double_array_trie.h"
 #include "minddata/dataset/text/vocab.h"
 #include "minddata/dataset/util/status.h"
 
@@ -47,13 +48,20 @@ class WordpieceTokenizerOp : public TensorOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
-                    std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+  // The tokens are views of the words of the vocab, of the unknown token or of the input, so no string is built for
+  // a token
+  Status FoundNoToken(std::string_view input_token, const uint32_t &basic_start,
+                      std::vector<std::string_view> *out_tokens, std::vector<uint32_t> *offsets_start,
+                      std::vector<uint32_t> *offsets_limit) const;
+  // Find the longest word of the vocab that starts at a rune of the token, after the suffix indicator if it is not the
+  // first rune. The vocab is searched in its trie, in one pass over the runes
+  // @param const RuneStrArray &runes - runes of the token
+  // @param size_t start - index of the first rune
+  // @param int32_t *out_pos - Returned position of the word in the vocab, -1 if no word is found
+  // @param size_t *out_end - Returned index of the rune after the word
+  void LookupWord(std::string_view input_token, const RuneStrArray &runes, size_t start, int32_t *out_pos,
+                  size_t *out_end) const;
+  Status GetTokens(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string_view> *out_tokens,
                    std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
@@ -64,6 +72,7 @@ class WordpieceTokenizerOp : public TensorOp {
   const bool with_offsets_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  DoubleArrayTrie trie_;  // The words of the vocab, with their positions in it
 };
 }  // namespace dataset
 }  // namespace mindspore
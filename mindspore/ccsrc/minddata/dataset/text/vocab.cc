@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <fstream>
+#include <functional>
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
@@ -28,11 +29,71 @@
 
 namespace mindspore {
 namespace dataset {
-Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) { word2id_ = std::move(word2id); }
+Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) {
+  size_t length = 0;
+  for (const auto &p : word2id) {
+    length += p.first.size();
+  }
+  arena_.reserve(length);
+  words_.reserve(word2id.size());
+  for (const auto &p : word2id) {
+    Insert(p.first, p.second);
+  }
+}
+
+WordIdType Vocab::Lookup(std::string_view word) const {
+  int32_t pos = Find(word, std::hash<std::string_view>()(word));
+  return pos < 0 ? kNoTokenExists : words_[pos].id;
+}
+
+const std::unordered_map<WordType, WordIdType> Vocab::vocab() const {
+  std::unordered_map<WordType, WordIdType> word2id;
+  word2id.reserve(words_.size());
+  for (size_t pos = 0; pos < words_.size(); ++pos) {
+    word2id.emplace(word(pos), words_[pos].id);
+  }
+  return word2id;
+}
+
+int32_t Vocab::Find(std::string_view word, size_t hash) const {
+  if (slots_.empty()) {
+    return -1;
+  }
+  size_t mask = slots_.size() - 1;
+  for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    int32_t pos = slots_[slot];
+    if (pos < 0 || (words_[pos].hash == hash && this->word(pos) == word)) {
+      return pos;
+    }
+  }
+}
+
+void Vocab::Insert(std::string_view word, WordIdType id) {
+  const size_t kMinSlots = 16;
+  if ((words_.size() + 1) * 2 > slots_.size()) {
+    Rehash(std::max(slots_.size() * 2, kMinSlots));
+  }
+  size_t hash = std::hash<std::string_view>()(word);
+  words_.push_back({hash, arena_.size(), word.size(), id});
+  (void)arena_.append(word.data(), word.size());
+  size_t mask = slots_.size() - 1;
+  size_t slot = hash & mask;
+  while (slots_[slot] >= 0) {
+    slot = (slot + 1) & mask;
+  }
+  slots_[slot] = static_cast<int32_t>(words_.size() - 1);
+}
 
-WordIdType Vocab::Lookup(const WordType &word) const {
-  auto itr = word2id_.find(word);
-  return itr == word2id_.end() ? kNoTokenExists : itr->second;
+void Vocab::Rehash(size_t num_slots) {
+  slots_.assign(num_slots, -1);
+  size_t mask = num_slots - 1;
+  for (size_t pos = 0; pos < words_.size(); ++pos) {
+    size_t slot = words_[pos].hash & mask;
+    while (slots_[slot] >= 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = static_cast<int32_t>(pos);
+  }
 }
 
 #ifdef ENABLE_PYTHON
@@ -69,8 +130,8 @@ Status Vocab::BuildFromPyDict(const py::dict &words, std::shared_ptr<Vocab> *voc
 #endif
 
 void Vocab::append_word(const std::string &word) {
-  if (word2id_.find(word) == word2id_.end()) {
-    word2id_[word] = word2id_.size();
+  if (Find(word, std::hash<std::string_view>()(word)) < 0) {
+    Insert(word, static_cast<WordIdType>(words_.size()));
   }
 }
 
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_H_
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +38,8 @@ namespace py = pybind11;
 using WordIdType = int32_t;
 using WordType = std::string;
 
+// Words are kept back to back in one string, and found through an open addressing hash table over their positions,
+// so a word is looked up by a string_view without building a std::string for it.
 class Vocab {
  public:
 #ifdef ENABLE_PYTHON
@@ -91,11 +94,10 @@ class Vocab {
                                  const std::vector<WordType> &special_tokens, bool prepend_special,
                                  std::shared_ptr<Vocab> *vocab);
 
-  // Lookup the id of a word, if word doesn't exist in vocab, return default_id
-  // @param const WordType word - word to look up
-  // @param WordIdType default_id - word id to return to user when its not in the vocab
+  // Lookup the id of a word, if word doesn't exist in vocab, return kNoTokenExists
+  // @param std::string_view word - word to look up
   // @return WordIdType, word_id
-  WordIdType Lookup(const WordType &word) const;
+  WordIdType Lookup(std::string_view word) const;
 
   // constructor, shouldn't be called directly, can't be private due to std::make_unique()
   // @param std::unordered_map<WordType, WordIdType> map - sanitized word2id map
@@ -108,7 +110,21 @@ class Vocab {
   void append_word(const std::string &word);
 
   // return a read-only vocab
-  const std::unordered_map<WordType, WordIdType> vocab() { return word2id_; }
+  const std::unordered_map<WordType, WordIdType> vocab() const;
+
+  // @return size_t - number of words
+  size_t size() const { return words_.size(); }
+
+  // Get a word by its position, words keep the order they were added in. The view is invalidated by append_word
+  // @param size_t pos - position, less than size()
+  // @return std::string_view - the word
+  std::string_view word(size_t pos) const {
+    return std::string_view(arena_.data() + words_[pos].offset, words_[pos].length);
+  }
+
+  // @param size_t pos - position, less than size()
+  // @return WordIdType - the id of the word at a position
+  WordIdType id(size_t pos) const { return words_[pos].id; }
 
   // destructor
   ~Vocab() = default;
@@ -116,7 +132,26 @@ class Vocab {
   static const WordIdType kNoTokenExists;
 
  private:
-  std::unordered_map<WordType, WordIdType> word2id_;
+  struct Entry {
+    size_t hash;
+    size_t offset;  // In arena_
+    size_t length;
+    WordIdType id;
+  };
+
+  // Find the position of a word in words_
+  // @return int32_t - position, -1 if the word is not in the vocab
+  int32_t Find(std::string_view word, size_t hash) const;
+
+  // Add a word that is not in the vocab
+  void Insert(std::string_view word, WordIdType id);
+
+  // Rebuild the table with a number of slots, a power of 2
+  void Rehash(size_t num_slots);
+
+  std::string arena_;           // All words back to back
+  std::vector<Entry> words_;    // In the order they were added
+  std::vector<int32_t> slots_;  // Position in words_ or -1, linear probing, at most half full
 };
 
 }  // namespace dataset
@@ -0,0 +1,212 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "minddata/dataset/util/queue.h"
+
+namespace mindspore {
+namespace dataset {
+// Number of failed attempts a producer or consumer makes before it parks on the condition variable.
+constexpr int kLockFreeQueueSpinCount = 256;
+// Attempts beyond this count yield the cpu between retries.
+constexpr int kLockFreeQueueYieldAfter = 32;
+
+// A bounded multi-producer multi-consumer ring buffer. Each slot carries a sequence number that tells whether it is
+// ready for the next producer or consumer, so Add and PopFront only do a compare-and-swap on the shared position.
+// A thread that finds the queue full (or empty) spins for a bounded number of attempts and then parks on the same
+// interruptible condition variables as Queue, which keeps Register and interrupt handling unchanged. Wakeups are
+// only issued when a thread is actually parked.
+//
+// A single producer and a single consumer (the layout a Connector uses for each of its queues) never contend on the
+// compare-and-swap, so the same queue serves as an SPSC ring at no extra cost.
+//
+// EmplaceBack is not virtual. Use it through a LockFreeQueue, not through a Queue pointer.
+template <typename T>
+class LockFreeQueue : public Queue<T> {
+ public:
+  using typename Queue<T>::pointer;
+
+  explicit LockFreeQueue(int sz) : Queue<T>(sz, nullptr), cells_(std::make_unique<Cell[]>(sz)) {
+    for (size_t i = 0; i < this->sz_; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MS_LOG(DEBUG) << "Create lock free Q with uuid " << this->my_name_ << " of size " << this->sz_ << ".";
+  }
+
+  ~LockFreeQueue() override { ResetQue(); }
+
+  size_t size() const override {
+    size_t tail = enqueue_pos_.load();
+    size_t head = dequeue_pos_.load();
+    return (tail > head) ? tail - head : 0;
+  }
+
+  size_t capacity() const override { return this->sz_; }
+
+  bool empty() const override { return size() == 0; }
+
+  // Producer
+  using Queue<T>::Add;
+
+  Status Add(T &&ele) noexcept override {
+    return Produce([&ele](T *slot) { *slot = std::forward<T>(ele); });
+  }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    return Produce([&args...](T *slot) { *slot = T(std::forward<Ts>(args)...); });
+  }
+
+  // Consumer
+  Status PopFront(pointer p) override {
+    for (int attempt = 0;; ++attempt) {
+      if (TryPop(p)) {
+        WakeUp(&waiting_producers_, &this->full_cv_);
+        return Status::OK();
+      }
+      if (attempt < kLockFreeQueueSpinCount) {
+        Relax(attempt);
+        continue;
+      }
+      Status rc = Park(&waiting_consumers_, &this->empty_cv_, [this]() -> bool { return !empty(); });
+      if (rc.IsError()) {
+        this->full_cv_.Interrupt();
+        return rc;
+      }
+      attempt = 0;
+    }
+  }
+
+  // Not safe to call while other threads are adding or popping.
+  void ResetQue() noexcept override {
+    T val;
+    while (TryPop(&val)) {
+      MS_LOG(DEBUG) << "Address of val: " << &val;
+    }
+    this->empty_cv_.ResetIntrpState();
+    this->full_cv_.ResetIntrpState();
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T data;
+  };
+
+  template <typename F>
+  Status Produce(const F &store) noexcept {
+    for (int attempt = 0;; ++attempt) {
+      if (TryPush(store)) {
+        WakeUp(&waiting_consumers_, &this->empty_cv_);
+        return Status::OK();
+      }
+      if (attempt < kLockFreeQueueSpinCount) {
+        Relax(attempt);
+        continue;
+      }
+      Status rc = Park(&waiting_producers_, &this->full_cv_, [this]() -> bool { return size() < capacity(); });
+      if (rc.IsError()) {
+        this->empty_cv_.Interrupt();
+        return rc;
+      }
+      attempt = 0;
+    }
+  }
+
+  template <typename F>
+  bool TryPush(const F &store) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell *cell = &cells_[pos % this->sz_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      if (seq == pos) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          store(&cell->data);
+          cell->seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (seq < pos) {
+        // The slot still holds the element from the previous lap, so the queue is full.
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool TryPop(pointer p) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell *cell = &cells_[pos % this->sz_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      if (seq == pos + 1) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          *p = std::move(cell->data);
+          cell->seq.store(pos + this->sz_, std::memory_order_release);
+          return true;
+        }
+      } else if (seq < pos + 1) {
+        // Nothing has been published to this slot yet, so the queue is empty.
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static void Relax(int attempt) {
+    if (attempt >= kLockFreeQueueYieldAfter) {
+      std::this_thread::yield();
+    }
+  }
+
+  // The waiter registers itself before it checks the predicate, and the other side makes its change visible before
+  // it checks for waiters. The two fences guarantee that at least one of them sees the other, so no wakeup is lost.
+  template <typename Pred>
+  Status Park(std::atomic<int> *waiters, CondVar *cv, const Pred &pred) {
+    std::unique_lock<std::mutex> lock(this->mux_);
+    waiters->fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Status rc = cv->Wait(&lock, pred);
+    waiters->fetch_sub(1);
+    return rc;
+  }
+
+  void WakeUp(std::atomic<int> *waiters, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> lock(this->mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  std::unique_ptr<Cell[]> cells_;
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+  alignas(64) std::atomic<int> waiting_producers_{0};
+  std::atomic<int> waiting_consumers_{0};
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_QUEUE_H_
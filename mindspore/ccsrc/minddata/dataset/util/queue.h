@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -57,19 +58,24 @@ class Queue {
 
   virtual ~Queue() { ResetQue(); }
 
-  size_t size() const {
+  virtual size_t size() const {
     size_t v = tail_ - head_;
     return (v >= 0) ? v : 0;
   }
 
-  size_t capacity() const { return sz_; }
+  virtual size_t capacity() const { return sz_; }
 
-  bool empty() const { return head_ == tail_; }
+  virtual bool empty() const { return head_ == tail_; }
 
   void Reset() { ResetQue(); }
 
   // Producer
+  // Not virtual so that queues of move-only types still compile. A derived queue gets a copy through Add(T &&).
   Status Add(const_reference ele) noexcept {
+    if (!own_storage_) {
+      T copy(ele);
+      return Add(std::move(copy));
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -84,7 +90,7 @@ class Queue {
     return rc;
   }
 
-  Status Add(T &&ele) noexcept {
+  virtual Status Add(T &&ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -116,7 +122,7 @@ class Queue {
   }
 
   // Consumer
-  Status PopFront(pointer p) {
+  virtual Status PopFront(pointer p) {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when empty
     Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
@@ -131,7 +137,7 @@ class Queue {
     return rc;
   }
 
-  void ResetQue() noexcept {
+  virtual void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, drain them. We won't call PopFront directly
     // because we have got the lock already. We will deadlock if we call PopFront
@@ -159,7 +165,16 @@ class Queue {
     }
   }
 
- private:
+ protected:
+  // For derived queues that manage their own storage. No array is allocated here.
+  Queue(int sz, std::nullptr_t)
+      : sz_(sz),
+        arr_(Services::GetAllocator<T>()),
+        head_(0),
+        tail_(0),
+        my_name_(Services::GetUniqueID()),
+        own_storage_(false) {}
+
   size_t sz_;
   MemGuard<T, Allocator<T>> arr_;
   size_t head_;
@@ -168,6 +183,7 @@ class Queue {
   std::mutex mux_;
   CondVar empty_cv_;
   CondVar full_cv_;
+  bool own_storage_ = true;
 };
 
 // A container of queues with [] operator accessors.  Basically this is a wrapper over of a vector of queues
@@ -177,10 +193,13 @@ class QueueList {
  public:
   QueueList() {}
 
+  // @tparam Q The queue type to create, which is Queue<T> or a queue derived from it.
+  template <typename Q = Queue<T>>
   void Init(int num_queues, int capacity) {
+    static_assert(std::is_base_of<Queue<T>, Q>::value, "Q must be derived from Queue<T>.");
     queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      queue_list_.emplace_back(std::make_unique<Q>(capacity));
     }
   }
 
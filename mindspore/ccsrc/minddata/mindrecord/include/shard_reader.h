@@ -20,6 +20,7 @@
 #include <dirent.h>
 #include <signal.h>
 #if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
 #include <sys/prctl.h>
 #endif
 #include <sys/stat.h>
@@ -65,6 +66,45 @@ using TASK_RETURN_CONTENT =
   std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
+/// \brief how blob data is fetched from the shard files
+enum class ShardReadMode {
+  kStream,  // seek and read into a new buffer for every row
+  kMmap     // map each shard file once and hand out slices of the mapping
+};
+
+/// \brief blob data of one row, valid for as long as owner is alive
+struct ShardBlobRef {
+  const uint8_t *data = nullptr;
+  uint64_t size = 0;
+  std::shared_ptr<void> owner;  // keeps the mapping or the buffer behind data alive
+};
+
+using TASK_RETURN_REF = std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<ShardBlobRef, json>>>>;
+
+/// \brief a shard file mapped read-only, shared by every row read from it
+class ShardMappedFile {
+ public:
+  ShardMappedFile(uint8_t *addr, uint64_t size) : addr_(addr), size_(size) {}
+
+  ~ShardMappedFile();
+
+  ShardMappedFile(const ShardMappedFile &) = delete;
+
+  ShardMappedFile &operator=(const ShardMappedFile &) = delete;
+
+  /// \brief map a whole file
+  /// \return the mapping, or nullptr if the file cannot be mapped
+  static std::shared_ptr<ShardMappedFile> Map(const std::string &file_path);
+
+  uint8_t *GetAddr() const { return addr_; }
+
+  uint64_t GetSize() const { return size_; }
+
+ private:
+  uint8_t *addr_;
+  uint64_t size_;
+};
+
 class ShardReader {
  public:
   ShardReader();
@@ -183,6 +223,11 @@ class ShardReader {
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
                                                                                        const int32_t &consumer_id);
 
+  /// \brief return a row by id without copying the blob when the reader is in mmap mode
+  /// \return a batch of blob references and image data
+  std::pair<TaskType, std::vector<std::tuple<ShardBlobRef, json>>> GetNextRefById(const int64_t &task_id,
+                                                                                  const int32_t &consumer_id);
+
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<std::vector<uint8_t>>, pybind11::object>> GetNextPy();
@@ -199,6 +244,13 @@ class ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set how blob data is read, must be called before Open
+  /// \return null
+  void SetReadMode(ShardReadMode read_mode) { read_mode_ = read_mode; }
+
+  /// \brief get how blob data is read
+  ShardReadMode GetReadMode() const { return read_mode_; }
+
   /// \brief get all classes
   MSRStatus GetAllClasses(const std::string &category_field, std::set<std::string> &categories);
 
@@ -270,6 +322,9 @@ class ShardReader {
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
+  /// \brief reference one row by one task, reading it through the stream if its shard is not mapped
+  TASK_RETURN_REF ConsumerOneTaskRef(int task_id, uint32_t consumer_id);
+
   /// \brief get labels from binary file
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
     int shard_id, const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &label_offsets);
@@ -297,6 +352,7 @@ class ShardReader {
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files_;                    // mapping per shard in mmap mode
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -309,6 +365,7 @@ class ShardReader {
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
   bool interrupt_ = false;    // reader interrupted
+  ShardReadMode read_mode_ = ShardReadMode::kStream;
 
   int num_padded_;  // number of padding samples
 
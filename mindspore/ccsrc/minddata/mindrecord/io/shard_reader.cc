@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <fcntl.h>
 #include <algorithm>
+#include <cerrno>
 #include <thread>
 
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
@@ -209,9 +211,52 @@ MSRStatus ShardReader::Open(int n_consumer) {
     MS_LOG(INFO) << "Open shard file successfully.";
   }
 
+  mapped_files_.clear();
+  if (read_mode_ == ShardReadMode::kMmap) {
+    for (const auto &file : file_paths_) {
+      auto mapped_file = ShardMappedFile::Map(file);
+      if (mapped_file == nullptr) {
+        MS_LOG(WARNING) << "Failed to map shard file: " << file << ", it will be read through the file stream.";
+      }
+      mapped_files_.push_back(mapped_file);
+    }
+  }
+
   return SUCCESS;
 }
 
+ShardMappedFile::~ShardMappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (addr_ != nullptr && munmap(addr_, size_) != 0) {
+    MS_LOG(ERROR) << "Failed to unmap shard file, errno: " << errno << ".";
+  }
+#endif
+}
+
+std::shared_ptr<ShardMappedFile> ShardMappedFile::Map(const std::string &file_path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(common::SafeCStr(file_path), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<uint64_t>(file_stat.st_size);
+  // Read-only: the mapping is shared by every epoch, so what borrows from it must never write to it.
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // the mapping keeps its own reference to the file
+  if (addr == MAP_FAILED) {
+    return nullptr;
+  }
+  return std::make_shared<ShardMappedFile>(static_cast<uint8_t *>(addr), size);
+#else
+  return nullptr;
+#endif
+}
+
 void ShardReader::FileStreamsOperator() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
@@ -225,6 +270,8 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  // Rows handed out by reference keep their own mapping alive
+  mapped_files_.clear();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -1244,6 +1291,61 @@ std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardRe
   return std::move(ret.second);
 }
 
+std::pair<TaskType, std::vector<std::tuple<ShardBlobRef, json>>> ShardReader::GetNextRefById(
+  const int64_t &task_id, const int32_t &consumer_id) {
+  if (interrupt_) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobRef, json>>());
+  }
+  auto ret = ConsumerOneTaskRef(task_id, consumer_id);
+  if (SUCCESS != ret.first) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobRef, json>>());
+  }
+  return std::move(ret.second);
+}
+
+TASK_RETURN_REF ShardReader::ConsumerOneTaskRef(int task_id, uint32_t consumer_id) {
+  if (task_id >= static_cast<int>(tasks_.Size())) {
+    return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobRef, json>>()));
+  }
+  auto task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+  auto task_type = std::get<0>(task);
+  auto shard_id = std::get<0>(std::get<1>(task));
+  std::shared_ptr<ShardMappedFile> mapped_file;
+  if (task_type == TaskType::kCommonTask && shard_id >= 0 && shard_id < static_cast<int>(mapped_files_.size())) {
+    mapped_file = mapped_files_[shard_id];
+  }
+
+  // Shard is not mapped, read the row through the stream and let the reference own the buffer
+  if (mapped_file == nullptr) {
+    auto ret = ConsumerOneTask(task_id, consumer_id);
+    std::vector<std::tuple<ShardBlobRef, json>> batch;
+    for (auto &row : ret.second.second) {
+      auto buffer = std::make_shared<std::vector<uint8_t>>(std::move(std::get<0>(row)));
+      ShardBlobRef blob{buffer->data(), buffer->size(), buffer};
+      batch.emplace_back(std::move(blob), std::move(std::get<1>(row)));
+    }
+    return std::make_pair(ret.first, std::make_pair(ret.second.first, std::move(batch)));
+  }
+
+  auto group_id = std::get<1>(std::get<1>(task));
+  auto addr = std::get<2>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  if (SUCCESS != ret.first) {
+    return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobRef, json>>()));
+  }
+  const std::shared_ptr<Page> &page = ret.second;
+  auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
+  if (addr[1] < addr[0] || file_offset + (addr[1] - addr[0]) > mapped_file->GetSize()) {
+    MS_LOG(ERROR) << "Blob of task " << task_id << " is out of the range of shard file " << shard_id << ".";
+    return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<ShardBlobRef, json>>()));
+  }
+
+  ShardBlobRef blob{mapped_file->GetAddr() + file_offset, addr[1] - addr[0], mapped_file};
+  std::vector<std::tuple<ShardBlobRef, json>> batch;
+  batch.emplace_back(std::move(blob), std::move(std::get<3>(task)));
+  return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
+}
+
 std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> ShardReader::UnCompressBlob(
   const std::vector<uint8_t> &raw_blob_data) {
   auto loaded_columns = selected_columns_.size() == 0 ? shard_column_->GetColumnName() : selected_columns_;
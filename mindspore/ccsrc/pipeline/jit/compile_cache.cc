@@ -0,0 +1,272 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "debug/common.h"
+#include "debug/dump_proto.h"
+#include "frontend/parallel/context.h"
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "load_mindir/load_model.h"
+#include "proto/mind_ir.pb.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+#include "utils/system/sha256.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+// Changes whenever the cached graphs can not be read by a build any more
+constexpr char kCompileCacheVersion[] = "1.1.0";
+
+bool HasAction(const std::vector<ActionItem> &actions, const std::string &name) {
+  return std::any_of(actions.begin(), actions.end(), [&name](const ActionItem &item) { return item.first == name; });
+}
+
+bool SameTensorInfo(const tensor::TensorPtr &a, const tensor::TensorPtr &b) {
+  return a != nullptr && b != nullptr && a->data_type() == b->data_type() && a->shape() == b->shape();
+}
+
+// The anf_ir proto keeps the type and shape of a constant tensor only, its data is hashed on its own
+void HashConstant(const ValuePtr &value, std::ostringstream *buffer) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (value->isa<tensor::Tensor>()) {
+    auto tensor = value->cast<tensor::TensorPtr>();
+    std::string data(static_cast<const char *>(tensor->data_c()), tensor->data().nbytes());
+    *buffer << "const " << tensor->GetShapeAndDataTypeInfo() << " " << system::sha256::GetHashFromString(data) << "\n";
+  } else if (value->isa<ValueSequeue>()) {
+    for (auto &element : value->cast<ValueSequeuePtr>()->value()) {
+      HashConstant(element, buffer);
+    }
+  } else if (value->isa<ValueDictionary>()) {
+    for (auto &item : value->cast<ValueDictionaryPtr>()->value()) {
+      HashConstant(item.second, buffer);
+    }
+  }
+}
+}  // namespace
+
+bool CompileCache::Enabled(const std::vector<ActionItem> &actions) {
+  if (common::GetEnv(kCompileCacheDirEnv).empty()) {
+    return false;
+  }
+  // The graph of a parallel mode carries strategies and layouts that are not kept in MindIR
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode != parallel::STAND_ALONE && parallel_mode != parallel::DATA_PARALLEL) {
+    return false;
+  }
+  return HasAction(actions, "symbol_resolve") && HasAction(actions, "validate") && HasAction(actions, "task_emit");
+}
+
+void CompileCache::ComputeKey(const ResourcePtr &resource) {
+  MS_EXCEPTION_IF_NULL(resource);
+  auto func_graph = resource->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+
+  std::ostringstream buffer;
+  buffer << "version " << kCompileCacheVersion << "\n";
+  buffer << "device_target " << context->get_param<std::string>(MS_CTX_DEVICE_TARGET) << "\n";
+  buffer << "execution_mode " << context->get_param<int>(MS_CTX_EXECUTION_MODE) << "\n";
+  buffer << "enable_graph_kernel " << context->get_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL) << "\n";
+  buffer << "enable_sparse " << context->get_param<bool>(MS_CTX_ENABLE_SPARSE) << "\n";
+  buffer << "enable_auto_mixed_precision " << context->get_param<bool>(MS_CTX_ENABLE_AUTO_MIXED_PRECISION) << "\n";
+  buffer << "enable_loop_sink " << context->get_param<bool>(MS_CTX_ENABLE_LOOP_SINK) << "\n";
+  buffer << "enable_task_sink " << context->get_param<bool>(MS_CTX_ENABLE_TASK_SINK) << "\n";
+  buffer << "parallel_mode " << parallel::ParallelContext::GetInstance()->parallel_mode() << "\n";
+  for (auto &arg : resource->args_spec()) {
+    MS_EXCEPTION_IF_NULL(arg);
+    buffer << "arg " << arg->ToString() << "\n";
+  }
+  weights_.clear();
+  for (auto &node : func_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param == nullptr || !param->has_default()) {
+      continue;
+    }
+    auto tensor = param->default_param()->cast<tensor::TensorPtr>();
+    MS_EXCEPTION_IF_NULL(tensor);
+    weights_[param->name()] = param;
+    buffer << "weight " << param->name() << " " << tensor->GetShapeAndDataTypeInfo() << "\n";
+  }
+  // The anf_ir proto of a graph lists its nodes and constants, graphs it uses are referenced by name
+  auto manager = resource->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  for (auto &graph : manager->func_graphs()) {
+    buffer << GetFuncGraphProtoString(graph);
+    for (auto &node : TopoSort(graph->get_return())) {
+      if (node->isa<ValueNode>()) {
+        HashConstant(GetValueNode(node), &buffer);
+      }
+    }
+  }
+  key_ = system::sha256::GetHashFromString(buffer.str());
+}
+
+bool CompileCache::Load(const ResourcePtr &resource) {
+  if (key_.empty()) {
+    return false;
+  }
+  try {
+    return LoadGraph(resource);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Load compile cache " << CachePath() << " failed, the graph is compiled again: " << e.what();
+  }
+  return false;
+}
+
+bool CompileCache::LoadGraph(const ResourcePtr &resource) {
+  std::ifstream ifs(CachePath(), std::ios::in | std::ios::binary);
+  if (!ifs.good()) {
+    MS_LOG(INFO) << "Compile cache miss for key " << key_ << ".";
+    return false;
+  }
+  std::string buffer((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  ifs.close();
+  mind_ir::ModelProto model;
+  if (!model.ParseFromString(buffer) || model.doc_string() != key_) {
+    MS_LOG(WARNING) << "Compile cache " << CachePath() << " is broken, the graph is compiled again.";
+    return false;
+  }
+  auto func_graph = ConvertStreamToFuncGraph(buffer.data(), buffer.size());
+  if (func_graph == nullptr) {
+    MS_LOG(WARNING) << "Compile cache " << CachePath() << " can not be converted, the graph is compiled again.";
+    return false;
+  }
+
+  // The loader puts the weights, in the order of the parameter protos, before the inputs. Bind them to the weights
+  // of the resolved graph and put them back behind the inputs
+  const auto &graph_proto = model.graph();
+  size_t num_weights = static_cast<size_t>(graph_proto.parameter_size());
+  auto params = func_graph->parameters();
+  if (params.size() < num_weights) {
+    return false;
+  }
+  std::vector<AnfNodePtr> inputs(params.begin() + num_weights, params.end());
+  std::vector<AnfNodePtr> weights;
+  for (size_t i = 0; i < num_weights; ++i) {
+    auto itr = weights_.find(graph_proto.parameter(static_cast<int>(i)).doc_string());
+    auto param = params[i]->cast<ParameterPtr>();
+    if (itr == weights_.end() || param == nullptr) {
+      MS_LOG(WARNING) << "Compile cache " << CachePath() << " uses an unknown weight, the graph is compiled again.";
+      return false;
+    }
+    auto tensor = itr->second->default_param()->cast<tensor::TensorPtr>();
+    if (!SameTensorInfo(param->default_param()->cast<tensor::TensorPtr>(), tensor)) {
+      MS_LOG(WARNING) << "Compile cache " << CachePath() << " has another shape for weight " << itr->first
+                      << ", the graph is compiled again.";
+      return false;
+    }
+    param->set_name(itr->first);
+    param->set_default_param(tensor);
+    param->set_abstract(tensor->ToAbstract());
+    weights.push_back(param);
+  }
+  inputs.insert(inputs.end(), weights.begin(), weights.end());
+  func_graph->set_parameters(inputs);
+  func_graph->set_hyper_param_count(num_weights);
+  func_graph->set_attrs(resource->func_graph()->attrs());
+
+  auto manager = resource->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->AddFuncGraph(func_graph, true);
+  manager->KeepRoots({func_graph});
+  resource->set_func_graph(func_graph);
+  MS_LOG(INFO) << "Compile cache hit for key " << key_ << ", the graph is loaded from " << CachePath() << ".";
+  return true;
+}
+
+void CompileCache::Save(const ResourcePtr &resource) {
+  if (key_.empty()) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(resource);
+  auto func_graph = resource->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  // MindIR keeps one graph without the order of its side effects
+  if (resource->manager()->func_graphs().size() != 1 || func_graph->has_flag(GRAPH_FLAG_HAS_EFFECT)) {
+    MS_LOG(INFO) << "Graph " << func_graph->ToString() << " is not kept in the compile cache.";
+    return;
+  }
+  auto path = Common::GetRealPath(CachePath());
+  if (!path.has_value()) {
+    MS_LOG(WARNING) << "Get real path of compile cache " << CachePath() << " failed.";
+    return;
+  }
+
+  mind_ir::ModelProto model;
+  try {
+    if (!model.ParseFromString(GetBinaryProtoString(func_graph))) {
+      MS_LOG(WARNING) << "Export graph " << func_graph->ToString() << " to the compile cache failed.";
+      return;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Export graph " << func_graph->ToString() << " to the compile cache failed: " << e.what();
+    return;
+  }
+  // The weights are exported in the order of the parameters, keep their names instead of their data
+  model.set_doc_string(key_);
+  auto graph_proto = model.mutable_graph();
+  int index = 0;
+  for (auto &node : func_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param == nullptr || !param->has_default() || index >= graph_proto->parameter_size()) {
+      continue;
+    }
+    auto param_proto = graph_proto->mutable_parameter(index++);
+    param_proto->clear_raw_data();
+    param_proto->set_doc_string(param->name());
+  }
+
+  // Write to a file of its own first, so a process that loads the cache never sees a part of it. The temp name is
+  // unique per process and save, processes and threads compiling the same graph do not write into each other's file
+  static std::atomic<uint64_t> temp_index{0};
+  std::string temp_path = path.value() + "." + std::to_string(getpid()) + "." + std::to_string(temp_index++) + ".tmp";
+  std::ofstream ofs(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open() || !model.SerializeToOstream(&ofs)) {
+    MS_LOG(WARNING) << "Write compile cache " << temp_path << " failed.";
+    ofs.close();
+    (void)std::remove(temp_path.c_str());
+    return;
+  }
+  ofs.close();
+  if (ofs.fail()) {
+    MS_LOG(WARNING) << "Write compile cache " << temp_path << " failed.";
+    (void)std::remove(temp_path.c_str());
+    return;
+  }
+  if (std::rename(temp_path.c_str(), path.value().c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename compile cache " << temp_path << " failed.";
+    (void)std::remove(temp_path.c_str());
+    return;
+  }
+  MS_LOG(INFO) << "Graph " << func_graph->ToString() << " is kept in the compile cache " << path.value() << ".";
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ir/anf.h"
+#include "pipeline/jit/action.h"
+#include "pipeline/jit/resource.h"
+
+namespace mindspore {
+namespace pipeline {
+// Environment variable naming the directory of the compile cache, the cache is off when it is not set
+constexpr char kCompileCacheDirEnv[] = "MS_COMPILE_CACHE_DIR";
+
+// Keeps the graphs that the frontend optimized across processes. After symbol_resolve the resolved graphs, the
+// arguments, the weights and the context options are hashed into a key. When a MindIR file of that key is in the
+// cache directory, the optimized graph is loaded from it and the actions up to validate are skipped. Otherwise the
+// graph that passed validate is written to the cache. The files hold no weight data, the weights of a loaded graph
+// are bound by name to the parameters of the resolved one.
+class CompileCache {
+ public:
+  explicit CompileCache(const std::string &dir) : dir_(dir) {}
+
+  ~CompileCache() = default;
+
+  // Whether the cache is set up and the actions run from symbol_resolve through validate into task_emit
+  static bool Enabled(const std::vector<ActionItem> &actions);
+
+  // Hash the resolved graphs into the key, call after symbol_resolve
+  void ComputeKey(const ResourcePtr &resource);
+
+  // Replace the graph of the resource by the cached one, false when there is none
+  bool Load(const ResourcePtr &resource);
+
+  // Write the graph of the resource to the cache, call after validate
+  void Save(const ResourcePtr &resource);
+
+  const std::string &key() const { return key_; }
+
+ private:
+  std::string CachePath() const { return dir_ + "/" + key_ + ".mindir"; }
+
+  bool LoadGraph(const ResourcePtr &resource);
+
+  std::string dir_;
+  std::string key_;
+  std::map<std::string, ParameterPtr> weights_;  // Weights of the resolved graph by name
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
@@ -24,6 +24,9 @@
 #include "pybind_api/api_register.h"
 #include "pipeline/jit/parse/python_adapter.h"
 #include "utils/summary/event_writer.h"
+#include "utils/checkpoint/checkpoint_file.h"
+#include "utils/checkpoint/checkpoint_converter.h"
+#include "utils/checkpoint/delta_checkpoint.h"
 #include "utils/config_manager.h"
 #include "utils/mpi/mpi_config.h"
 #include "frontend/parallel/context.h"
@@ -48,6 +51,9 @@ using Pipeline = mindspore::pipeline::Pipeline;
 using PrimitivePy = mindspore::PrimitivePy;
 using MetaFuncGraph = mindspore::MetaFuncGraph;
 using EventWriter = mindspore::summary::EventWriter;
+using CheckpointWriter = mindspore::checkpoint::CheckpointWriter;
+using CheckpointReader = mindspore::checkpoint::CheckpointReader;
+using DeltaCheckpointWriter = mindspore::checkpoint::DeltaCheckpointWriter;
 using OpLib = mindspore::kernel::OpLib;
 using OpInfoLoaderPy = mindspore::kernel::OpInfoLoaderPy;
 using ParallelContext = mindspore::parallel::ParallelContext;
@@ -288,6 +294,36 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("Close", &EventWriter::Close, "Close the write.")
     .def("Shut", &EventWriter::Shut, "Final close the write.");
 
+  (void)py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter>>(m, "CheckpointWriter_")
+    .def(py::init<const std::string &, size_t>(), py::arg("file_name"), py::arg("num_threads") = 0)
+    .def("save", &CheckpointWriter::Save, py::call_guard<py::gil_scoped_release>(),
+         "Save the tensors into a native checkpoint.");
+  (void)py::class_<CheckpointReader, std::shared_ptr<CheckpointReader>>(m, "CheckpointReader_")
+    .def(py::init<const std::string &>())
+    .def("names", &CheckpointReader::GetNames, "Get the tensor names in the checkpoint.")
+    .def("get_tensor", &CheckpointReader::GetTensor, py::arg("name"), py::arg("verify") = false,
+         py::call_guard<py::gil_scoped_release>(), "Get a tensor mapped from the checkpoint.");
+  (void)py::class_<DeltaCheckpointWriter, std::shared_ptr<DeltaCheckpointWriter>>(m, "DeltaCheckpointWriter_")
+    .def(py::init<const std::string &, const std::string &>())
+    .def("collect", &DeltaCheckpointWriter::Collect, "Take the rows changed since the base checkpoint.")
+    .def("write", &DeltaCheckpointWriter::Write, py::call_guard<py::gil_scoped_release>(),
+         "Write the delta checkpoint.");
+  (void)m.def("reset_changed_rows", &mindspore::checkpoint::ResetChangedRows,
+              "Start tracking the changed rows of the tensors from a full checkpoint.");
+  (void)m.def("is_delta_checkpoint", &mindspore::checkpoint::IsDeltaCheckpoint,
+              "Whether the file is a delta checkpoint.");
+  (void)m.def("load_checkpoint_chain", &mindspore::checkpoint::LoadCheckpointChain, py::arg("file_name"),
+              py::arg("verify") = false, py::call_guard<py::gil_scoped_release>(),
+              "Load the tensors of a delta checkpoint chain.");
+  (void)m.def("compact_checkpoint", &mindspore::checkpoint::CompactCheckpoint,
+              py::call_guard<py::gil_scoped_release>(), "Write a delta checkpoint chain as a full checkpoint.");
+  (void)m.def("is_native_checkpoint", &mindspore::checkpoint::IsNativeCheckpoint,
+              "Whether the file is a native checkpoint.");
+  (void)m.def("convert_checkpoint_to_native", &mindspore::checkpoint::ConvertProtoToNative,
+              py::call_guard<py::gil_scoped_release>(), "Convert a protobuf checkpoint into the native format.");
+  (void)m.def("convert_checkpoint_to_proto", &mindspore::checkpoint::ConvertNativeToProto,
+              py::call_guard<py::gil_scoped_release>(), "Convert a native checkpoint into the protobuf format.");
+
   (void)py::class_<OpLib, std::shared_ptr<OpLib>>(m, "Oplib")
     .def(py::init())
     .def_static("reg_op", &OpLib::RegOp, "Register op info.");
@@ -28,6 +28,7 @@
 #include "ir/param_info.h"
 #include "pipeline/jit/pass.h"
 #include "pipeline/jit/parse/data_converter.h"
+#include "pipeline/jit/compile_cache.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
 #include "debug/dump_proto.h"
@@ -652,10 +653,22 @@ void Pipeline::Run() {
   MS_LOG(INFO) << "Pipeline run";
   MS_EXCEPTION_IF_NULL(resource_);
   FuncGraphPtr user_graph = nullptr;
+  std::shared_ptr<CompileCache> compile_cache = nullptr;
+  if (CompileCache::Enabled(actions_)) {
+    compile_cache = std::make_shared<CompileCache>(common::GetEnv(kCompileCacheDirEnv));
+  }
 
-  WITH(MsProfile::GetProfile())[&user_graph, this]() {
+  WITH(MsProfile::GetProfile())[&user_graph, &compile_cache, this]() {
     int64_t i = 0;
+    // A graph loaded from the compile cache skips the actions up to this one
+    std::string skip_until;
     for (auto &action : actions_) {
+      if (!skip_until.empty()) {
+        if (action.first == skip_until) {
+          skip_until.clear();
+        }
+        continue;
+      }
 #ifdef ENABLE_TIMELINE
       DumpTime &dump_time = DumpTime::GetInstance();
       dump_time.Record(action.first, GetTime(), true);
@@ -688,6 +701,14 @@ void Pipeline::Run() {
       if (!result) {
         MS_LOG(EXCEPTION) << "Pipeline running to end, failed in step:" << action.first;
       }
+      if (compile_cache != nullptr && action.first == "symbol_resolve") {
+        compile_cache->ComputeKey(resource_);
+        if (compile_cache->Load(resource_)) {
+          skip_until = "validate";
+        }
+      } else if (compile_cache != nullptr && action.first == "validate") {
+        compile_cache->Save(resource_);
+      }
       if (MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG) && resource_->func_graph() != nullptr) {
         auto graph = resource_->func_graph();
         if (graph != nullptr) {
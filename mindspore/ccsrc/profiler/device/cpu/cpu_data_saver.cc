@@ -0,0 +1,202 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profiler/device/cpu/cpu_data_saver.h"
+#include <fstream>
+#include <numeric>
+#include <set>
+#include <nlohmann/json.hpp>
+#include "sys/stat.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+OpDetailInfo::OpDetailInfo(std::shared_ptr<OpInfo> op_info, float proportion)
+    : op_info_(op_info), proportion_(proportion) {
+  // op_full_name is like 'xxx/xxx/{op_type}-op{node_id}'
+  op_full_name_ = op_info->op_name;
+  auto op_type_begin_iter = op_full_name_.rfind('/') + 1;
+  auto op_type_end_iter = op_full_name_.rfind('-');
+  op_type_ = op_full_name_.substr(op_type_begin_iter, op_type_end_iter - op_type_begin_iter);
+  op_name_ = op_full_name_.substr(op_type_begin_iter);
+  op_avg_time_ = op_info->op_host_cost_time / op_info->op_count;
+}
+
+void DataSaver::ParseOpInfo(const OpInfoMap &op_info_maps) {
+  op_detail_infos_.reserve(op_info_maps.size());
+  float total_time_sum = GetTotalOpTime(op_info_maps);
+  for (auto item : op_info_maps) {
+    op_timestamps_map_[item.first] = item.second.start_duration;
+    float proportion = item.second.op_host_cost_time / total_time_sum;
+    auto op_info = std::make_shared<OpInfo>(item.second);
+    OpDetailInfo op_detail_info = OpDetailInfo(op_info, proportion);
+    op_detail_infos_.emplace_back(op_detail_info);
+    AddOpDetailInfoForType(op_detail_info);
+  }
+  // update average time of op type
+  for (auto &op_type : op_type_infos_) {
+    op_type.second.avg_time_ = op_type.second.total_time_ / op_type.second.count_;
+  }
+  MS_LOG(DEBUG) << "Get " << op_detail_infos_.size() << " operation items.";
+  MS_LOG(DEBUG) << "Get " << op_type_infos_.size() << " operation type items.";
+}
+
+void DataSaver::AddOpDetailInfoForType(const OpDetailInfo &op_detail_info) {
+  // Construct OpType object according to op detail info
+  OpType op_type = OpType{op_detail_info.op_type_, op_detail_info.op_info_->op_count,
+                          op_detail_info.op_info_->op_host_cost_time, 0, op_detail_info.proportion_};
+  // Set the OpType into op_type_infos_ map
+  std::string type_name = op_detail_info.op_type_;
+  auto iter = op_type_infos_.find(type_name);
+  if (iter == op_type_infos_.end()) {
+    op_type_infos_.emplace(type_name, op_type);
+  } else {
+    iter->second += op_type;
+  }
+}
+
+float DataSaver::GetTotalOpTime(const OpInfoMap &op_info_maps) {
+  float sum = 0;
+  sum = std::accumulate(op_info_maps.begin(), op_info_maps.end(), sum,
+                        [](float i, auto iter) { return i + iter.second.op_host_cost_time; });
+  MS_LOG(DEBUG) << "The total op time is " << sum;
+  return sum;
+}
+
+void DataSaver::WriteFile(const std::string &out_path_dir, uint32_t device_id, const std::vector<CpuOpEvent> &events) {
+  if (out_path_dir.empty()) {
+    MS_LOG(WARNING) << "Output directory. Ignore the writing data.";
+    return;
+  }
+  if (op_detail_infos_.empty() || op_type_infos_.empty()) {
+    MS_LOG(WARNING) << "No operation detail infos to write.";
+    return;
+  }
+  device_id_ = std::to_string(device_id);
+  WriteOpDetail(out_path_dir);
+  WriteOpType(out_path_dir);
+  WriteOpTimestamp(out_path_dir);
+  WriteTimeline(out_path_dir, device_id, events);
+}
+
+void DataSaver::WriteOpType(const std::string &saver_base_dir) {
+  std::string file_path = saver_base_dir + "/cpu_op_type_info_" + device_id_ + ".csv";
+  std::ofstream ofs(file_path);
+  // check if the file is writable
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  // write op type info into file
+  ofs << OpType().GetHeader() << std::endl;
+  for (auto op_type_info : op_type_infos_) {
+    ofs << op_type_info.second << std::endl;
+  }
+  ofs.close();
+  ChangeFileMode(file_path);
+  MS_LOG(INFO) << "Write " << op_type_infos_.size() << " op type infos into file: " << file_path;
+}
+
+void DataSaver::WriteOpDetail(const std::string &saver_base_dir) {
+  std::string file_path = saver_base_dir + "/cpu_op_detail_info_" + device_id_ + ".csv";
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  // write op detail info into file
+  ofs << OpDetailInfo().GetHeader() << std::endl;
+  for (auto op_detail : op_detail_infos_) {
+    ofs << op_detail << std::endl;
+  }
+  ofs.close();
+  ChangeFileMode(file_path);
+  MS_LOG(INFO) << "Write " << op_detail_infos_.size() << " op detail infos into file: " << file_path;
+}
+
+void DataSaver::WriteOpTimestamp(const std::string &saver_base_dir) {
+  std::string file_path = saver_base_dir + "/cpu_op_execute_timestamp_" + device_id_ + ".txt";
+  std::ofstream ofs(file_path);
+  // check if the file is writable
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  // write op timestamp info into file
+  for (const auto &op_timestamp_info : op_timestamps_map_) {
+    ofs << op_timestamp_info.first << ";Ops;";
+    for (auto start_end : op_timestamp_info.second) {
+      ofs << start_end.start_timestamp << "," << start_end.duration << " ";
+    }
+    ofs << std::endl;
+  }
+  ofs.close();
+  ChangeFileMode(file_path);
+}
+
+void DataSaver::WriteTimeline(const std::string &saver_base_dir, uint32_t pid, const std::vector<CpuOpEvent> &events) {
+  std::string file_path = saver_base_dir + "/cpu_timeline_" + device_id_ + ".json";
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  // The events are written one by one, a trace of a long run would not fit into one json object in memory. Times
+  // are in us, as doubles since a float can not hold a host timestamp
+  ofs << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  nlohmann::json process = {{"name", "process_name"}, {"ph", "M"}, {"pid", pid}, {"args", {{"name", "CPU Ops"}}}};
+  ofs << process.dump();
+  std::set<uint32_t> threads;
+  for (const auto &event : events) {
+    auto begin = event.op_name.rfind('/') + 1;
+    nlohmann::json item = {{"name", event.op_name.substr(begin)},
+                           {"cat", "Ops"},
+                           {"ph", "X"},
+                           {"ts", static_cast<double>(event.start_time_stamp) / kTimeUnit},
+                           {"dur", static_cast<double>(event.end_time_stamp - event.start_time_stamp) / kTimeUnit},
+                           {"pid", pid},
+                           {"tid", event.thread_id},
+                           {"args",
+                            {{"op_full_name", event.op_name},
+                             {"input_shapes", event.input_shapes},
+                             {"bytes", event.bytes}}}};
+    ofs << "," << item.dump();
+    (void)threads.insert(event.thread_id);
+  }
+  for (auto thread_id : threads) {
+    nlohmann::json thread = {{"name", "thread_name"},
+                             {"ph", "M"},
+                             {"pid", pid},
+                             {"tid", thread_id},
+                             {"args", {{"name", "Thread " + std::to_string(thread_id)}}}};
+    ofs << "," << thread.dump();
+  }
+  ofs << "]}" << std::endl;
+  ofs.close();
+  ChangeFileMode(file_path);
+  MS_LOG(INFO) << "Write " << events.size() << " events into timeline file: " << file_path;
+}
+
+void DataSaver::ChangeFileMode(const std::string &file_path) {
+  if (chmod(common::SafeCStr(file_path), S_IRUSR) == -1) {
+    MS_LOG(WARNING) << "Modify file:" << file_path << " to rw fail.";
+    return;
+  }
+}
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
@@ -0,0 +1,197 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler/device/cpu/cpu_profiling.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "profiler/device/cpu/cpu_data_saver.h"
+#include "pybind_api/api_register.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+namespace {
+// Events kept per thread, a power of 2
+constexpr size_t kEventRingCapacity = 1 << 16;
+
+uint64_t GetHostTimeStamp() {
+  auto cur_sys_clock = std::chrono::system_clock::now();
+  uint64_t cur_time_stamp =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(cur_sys_clock.time_since_epoch()).count();
+  return cur_time_stamp;
+}
+
+// The ring of the calling thread, it is registered with the profiler on the first kernel the thread launches
+thread_local EventRing *thread_ring = nullptr;
+}  // namespace
+
+std::shared_ptr<CPUProfiler> CPUProfiler::profiler_inst_ = nullptr;
+
+EventRing::EventRing(size_t capacity, uint32_t thread_id)
+    : events_(capacity), mask_(capacity - 1), thread_id_(thread_id) {}
+
+uint64_t EventRing::Collect(std::vector<CpuOpEvent> *events) const {
+  uint64_t head = head_.load(std::memory_order_acquire);
+  uint64_t num = std::min<uint64_t>(head, events_.size());
+  for (uint64_t i = head - num; i < head; ++i) {
+    events->push_back(events_[i & mask_]);
+  }
+  return head - num;
+}
+
+std::shared_ptr<CPUProfiler> CPUProfiler::GetInstance() {
+  if (profiler_inst_ == nullptr) {
+    profiler_inst_ = std::shared_ptr<CPUProfiler>(new (std::nothrow) CPUProfiler());
+  }
+  return profiler_inst_;
+}
+
+void CPUProfiler::Init(const std::string &profileDataPath = "") {
+  MS_LOG(INFO) << "Initialize CPU Profiling";
+  if (!profile_data_path_.empty()) {
+    MS_LOG(EXCEPTION)
+      << "Repeated initialization, Please check whether you have created the Profiler object multiple times";
+  }
+  profile_data_path_ = profileDataPath;
+  MS_LOG(INFO) << "CPU start time(ns):" << GetHostTimeStamp();
+}
+
+void CPUProfiler::StepProfilingEnable(const bool enable_flag) {
+  MS_LOG(INFO) << "CPU Profiler enable flag:" << enable_flag;
+  enable_flag_.store(enable_flag, std::memory_order_relaxed);
+}
+
+EventRing *CPUProfiler::ThreadRing() {
+  if (thread_ring == nullptr) {
+    std::lock_guard<std::mutex> locker(rings_mutex_);
+    rings_.push_back(std::make_unique<EventRing>(kEventRingCapacity, static_cast<uint32_t>(rings_.size())));
+    thread_ring = rings_.back().get();
+  }
+  return thread_ring;
+}
+
+void CPUProfiler::OpDataProducerBegin(const std::string &op_name, const std::vector<std::vector<size_t>> &input_shapes,
+                                      uint64_t bytes) {
+  auto ring = ThreadRing();
+  ring->set_busy(true);
+  if (!enable_flag_.load()) {
+    ring->set_busy(false);
+    return;
+  }
+  auto event = ring->Next();
+  event->op_name = op_name;
+  event->bytes = bytes;
+  event->thread_id = ring->thread_id();
+  // The slot keeps the capacity of the strings of the events it held before, so a full ring stops allocating
+  event->input_shapes.clear();
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    if (i > 0) {
+      event->input_shapes += ';';
+    }
+    for (size_t j = 0; j < input_shapes[i].size(); ++j) {
+      if (j > 0) {
+        event->input_shapes += ',';
+      }
+      event->input_shapes += std::to_string(input_shapes[i][j]);
+    }
+  }
+  event->start_time_stamp = GetHostTimeStamp();
+}
+
+void CPUProfiler::OpDataProducerEnd() {
+  uint64_t end_time_stamp = GetHostTimeStamp();
+  auto ring = ThreadRing();
+  if (!ring->busy()) {
+    return;
+  }
+  ring->Next()->end_time_stamp = end_time_stamp;
+  ring->Commit();
+  ring->set_busy(false);
+}
+
+void CPUProfiler::OpsParser(const std::vector<CpuOpEvent> &events) {
+  for (const auto &event : events) {
+    float op_time_elapsed = (event.end_time_stamp - event.start_time_stamp) / kTimeUnit;
+    auto &op_info = op_info_map_[event.op_name];
+    op_info.op_name = event.op_name;
+    op_info.op_host_cost_time += op_time_elapsed;
+    op_info.op_count += 1;
+    op_info.start_duration.emplace_back(StartDuration({event.start_time_stamp, op_time_elapsed}));
+  }
+  MS_LOG(INFO) << "Get " << events.size() << " events of " << op_info_map_.size() << " ops.";
+}
+
+void CPUProfiler::Stop() {
+  MS_LOG(INFO) << "Stop CPU Profiling";
+  enable_flag_.store(false);
+  std::vector<CpuOpEvent> events;
+  {
+    std::lock_guard<std::mutex> locker(rings_mutex_);
+    for (const auto &ring : rings_) {
+      // Kernels launched before profiling was disabled finish their events first
+      while (ring->busy()) {
+        std::this_thread::yield();
+      }
+      uint64_t dropped = ring->Collect(&events);
+      if (dropped > 0) {
+        MS_LOG(WARNING) << "The oldest " << dropped << " events of thread " << ring->thread_id()
+                        << " were overwritten, " << kEventRingCapacity << " events are kept per thread.";
+      }
+    }
+  }
+  std::sort(events.begin(), events.end(), [](const CpuOpEvent &a, const CpuOpEvent &b) {
+    return a.start_time_stamp < b.start_time_stamp;
+  });
+  OpsParser(events);
+  SaveProfileData(events);
+  ClearInst();
+}
+
+void CPUProfiler::SaveProfileData(const std::vector<CpuOpEvent> &events) {
+  if (profile_data_path_.empty()) {
+    MS_LOG(WARNING) << "Profile data path is empty, skip save profile data.";
+    return;
+  }
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  DataSaver data_saver;
+  data_saver.ParseOpInfo(op_info_map_);
+  data_saver.WriteFile(profile_data_path_, context->get_param<uint32_t>(MS_CTX_DEVICE_ID), events);
+}
+
+void CPUProfiler::ClearInst() {
+  op_info_map_.clear();
+  profile_data_path_.clear();
+  std::lock_guard<std::mutex> locker(rings_mutex_);
+  for (const auto &ring : rings_) {
+    ring->Clear();
+  }
+}
+
+REGISTER_PYBIND_DEFINE(CPUProfiler_, ([](const py::module *m) {
+                         (void)py::class_<CPUProfiler, std::shared_ptr<CPUProfiler>>(*m, "CPUProfiler")
+                           .def_static("get_instance", &CPUProfiler::GetInstance, "CPUProfiler get_instance.")
+                           .def("init", &CPUProfiler::Init, py::arg("profile_data_path"), "init")
+                           .def("stop", &CPUProfiler::Stop, "stop")
+                           .def("step_profiling_enable", &CPUProfiler::StepProfilingEnable, py::arg("enable_flag"),
+                                "enable or disable step profiling");
+                       }));
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
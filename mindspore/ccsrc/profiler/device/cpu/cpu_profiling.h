@@ -0,0 +1,136 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CPU_PROFILING_H
+#define MINDSPORE_CPU_PROFILING_H
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+// One launch of a kernel, times are host nanoseconds
+struct CpuOpEvent {
+  std::string op_name;
+  std::string input_shapes;  // Like "2,3;3,4", one shape per input
+  uint64_t start_time_stamp = 0;
+  uint64_t end_time_stamp = 0;
+  uint64_t bytes = 0;  // Size of the inputs and outputs
+  uint32_t thread_id = 0;
+};
+
+// The events of one thread. The thread that owns the ring is its only writer, it fills the slot after the last event
+// and publishes it by moving head_, so recording takes no lock. The oldest events are overwritten when the ring is
+// full. The ring is busy from the start of an event until it is committed, and Stop reads the events only once
+// profiling is disabled and no ring is busy.
+class EventRing {
+ public:
+  EventRing(size_t capacity, uint32_t thread_id);
+
+  ~EventRing() = default;
+
+  CpuOpEvent *Next() { return &events_[head_.load(std::memory_order_relaxed) & mask_]; }
+
+  void Commit() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  // Append the events in the order they were recorded and return the number of events that were overwritten
+  uint64_t Collect(std::vector<CpuOpEvent> *events) const;
+
+  void Clear() { head_.store(0, std::memory_order_release); }
+
+  // Sequentially consistent, so that either a starting event sees profiling disabled or Stop sees the ring busy
+  void set_busy(bool busy) { busy_.store(busy); }
+  bool busy() const { return busy_.load(); }
+
+  uint32_t thread_id() const { return thread_id_; }
+
+ private:
+  std::vector<CpuOpEvent> events_;
+  uint64_t mask_;
+  uint32_t thread_id_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<bool> busy_{false};
+};
+
+struct StartDuration {
+  uint64_t start_timestamp = 0l;
+  float duration = 0l;
+};
+
+struct OpInfo {
+  std::string op_name;
+  float op_host_cost_time = 0;
+  int op_count = 0;
+  std::vector<StartDuration> start_duration;
+};
+
+const float kTimeUnit = 1000;
+
+class CPUProfiler {
+ public:
+  static std::shared_ptr<CPUProfiler> GetInstance();
+
+  ~CPUProfiler() = default;
+
+  CPUProfiler(const CPUProfiler &) = delete;
+
+  CPUProfiler &operator=(const CPUProfiler &) = delete;
+
+  void Init(const std::string &profileDataPath);
+
+  void Stop();
+
+  void StepProfilingEnable(const bool enable_flag);
+
+  bool GetEnableFlag() const { return enable_flag_.load(std::memory_order_relaxed); }
+
+  // Called around the launch of a kernel by the thread that launches it, bytes is the size of its inputs and outputs.
+  // An event started after profiling is disabled is not recorded
+  void OpDataProducerBegin(const std::string &op_name, const std::vector<std::vector<size_t>> &input_shapes,
+                           uint64_t bytes);
+
+  void OpDataProducerEnd();
+
+  std::string ProfileDataPath() const { return profile_data_path_; }
+
+ private:
+  CPUProfiler() = default;
+
+  EventRing *ThreadRing();
+
+  void OpsParser(const std::vector<CpuOpEvent> &events);
+
+  void SaveProfileData(const std::vector<CpuOpEvent> &events);
+
+  void ClearInst();
+
+  static std::shared_ptr<CPUProfiler> profiler_inst_;
+  std::atomic<bool> enable_flag_{false};
+  std::string profile_data_path_;
+  std::unordered_map<std::string, OpInfo> op_info_map_;
+  std::mutex rings_mutex_;                         // Guards rings_ when a thread registers its ring
+  std::vector<std::unique_ptr<EventRing>> rings_;  // Never shrinks, threads keep a pointer to their ring
+};
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CPU_PROFILING_H
@@ -33,6 +33,8 @@ constexpr char kEnvWorkerNum[] = "MS_WORKER_NUM";
 constexpr char kEnvSchedulerHost[] = "MS_SCHED_HOST";
 constexpr char kEnvSchedulerPort[] = "MS_SCHED_PORT";
 
+constexpr char kEnvRebalanceInterval[] = "MS_PS_EMBEDDING_REBALANCE_INTERVAL";
+
 constexpr char kDmlcCommType[] = "DMLC_PS_VAN_TYPE";
 constexpr char kDmlcInterface[] = "DMLC_INTERFACE";
 constexpr char kDmlcPServerNum[] = "DMLC_NUM_SERVER";
@@ -67,10 +69,18 @@ constexpr int64_t kInitEmbeddingsCmd = 20;
 constexpr int64_t kCheckReadyForPushCmd = 25;
 constexpr int64_t kCheckReadyForPullCmd = 26;
 constexpr int64_t kEmbeddingLookupCmd = 30;
+constexpr int64_t kEmbeddingStatsCmd = 31;
+constexpr int64_t kReplicateEmbeddingRowsCmd = 32;
+constexpr int64_t kDropEmbeddingReplicasCmd = 33;
 constexpr int64_t kFinalizeCmd = 40;
 
 constexpr size_t kInvalidKey = UINT64_MAX;
 constexpr int64_t kInvalidID = -1;
+constexpr uint64_t kLookupStatsReportInterval = 10000;
+// Most rows of one embedding table a server reports as hot, and most rows of one table that are replicated
+constexpr size_t kMaxHotRows = 1024;
+// Replicas are only added for a hot row while its servers carry more than this times the mean load
+constexpr double kHotRowLoadSlack = 1.1;
 
 using Key = ::ps::Key;
 using Keys = ::ps::SArray<Key>;
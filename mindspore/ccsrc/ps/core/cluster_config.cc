@@ -18,6 +18,8 @@
 
 #include <string>
 
+#include "ps/core/message_buffer_pool.h"
+
 namespace mindspore {
 namespace ps {
 namespace core {
@@ -31,6 +33,8 @@ uint32_t ClusterConfig::heartbeat_interval_ = 3;
 uint32_t ClusterConfig::heartbeat_timeout_ = 30;
 // Timeout period for cluster preparation is 300 seconds.
 uint32_t ClusterConfig::cluster_available_timeout_ = 300;
+// A received message of more than 4GB, metadata and payload each, is taken as a broken stream.
+uint64_t ClusterConfig::max_message_size_ = uint64_t(1) << 32;
 
 void ClusterConfig::Init(const uint32_t &worker_num, const uint32_t &server_num,
                          std::unique_ptr<std::string> scheduler_host, const uint16_t &scheduler_port) {
@@ -69,6 +73,16 @@ void ClusterConfig::set_cluster_available_timeout(const uint32_t &cluster_availa
   cluster_available_timeout_ = cluster_available_timeout;
 }
 
+uint64_t ClusterConfig::max_message_size() { return max_message_size_; }
+
+void ClusterConfig::set_max_message_size(const uint64_t &max_message_size) {
+  if (max_message_size == 0 || max_message_size > kMaxMessageBufferSize) {
+    MS_LOG(EXCEPTION) << "The max message size " << max_message_size << " should be in (0, " << kMaxMessageBufferSize
+                      << "]!";
+  }
+  max_message_size_ = max_message_size;
+}
+
 }  // namespace core
 }  // namespace ps
 }  // namespace mindspore
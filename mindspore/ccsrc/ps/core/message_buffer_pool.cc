@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/core/message_buffer_pool.h"
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+void MessageBuffer::set_size(size_t size) {
+  if (size > capacity_) {
+    MS_LOG(EXCEPTION) << "The message buffer size " << size << " exceeds its capacity " << capacity_;
+  }
+  size_ = size;
+}
+
+MessageBufferPool &MessageBufferPool::GetInstance() {
+  // Never destroyed, buffers may still be released by connections torn down during exit.
+  static MessageBufferPool *instance = new MessageBufferPool();
+  return *instance;
+}
+
+size_t MessageBufferPool::SizeClass(size_t size) {
+  if (size > kMaxMessageBufferSize) {
+    MS_LOG(EXCEPTION) << "The message buffer size " << size << " exceeds the limit " << kMaxMessageBufferSize;
+  }
+  size_t size_class = kMinMessageBufferSize;
+  while (size_class < size) {
+    size_class <<= 1;
+  }
+  return size_class;
+}
+
+MessageBufferPtr MessageBufferPool::Acquire(size_t size) {
+  size_t size_class = SizeClass(size);
+  MessageBuffer *buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = free_buffers_.find(size_class);
+    if (iter != free_buffers_.end() && !iter->second.empty()) {
+      buffer = iter->second.back().release();
+      iter->second.pop_back();
+      cached_bytes_ -= size_class;
+    }
+  }
+  if (buffer == nullptr) {
+    buffer = new MessageBuffer(size_class);
+  }
+  buffer->set_size(size);
+  return MessageBufferPtr(buffer, [this](MessageBuffer *released) { Release(released); });
+}
+
+void MessageBufferPool::Release(MessageBuffer *buffer) {
+  std::unique_ptr<MessageBuffer> holder(buffer);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cached_bytes_ + buffer->capacity() > kMaxCachedMessageBytes) {
+    return;
+  }
+  cached_bytes_ += buffer->capacity();
+  free_buffers_[buffer->capacity()].push_back(std::move(holder));
+}
+
+size_t MessageBufferPool::cached_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cached_bytes_;
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_CORE_MESSAGE_BUFFER_POOL_H_
+#define MINDSPORE_CCSRC_PS_CORE_MESSAGE_BUFFER_POOL_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+namespace core {
+constexpr size_t kMinMessageBufferSize = 4096;
+// No buffer is larger, so that the size class of any valid size is a power of two that fits in size_t
+constexpr size_t kMaxMessageBufferSize = size_t(1) << 40;
+constexpr size_t kMaxCachedMessageBytes = 256 << 20;
+
+// Byte buffer handed out by MessageBufferPool. The capacity is the size class of the buffer, size the bytes in use.
+class MessageBuffer {
+ public:
+  explicit MessageBuffer(size_t capacity) : data_(new unsigned char[capacity]), capacity_(capacity), size_(0) {}
+  ~MessageBuffer() = default;
+
+  unsigned char *data() const { return data_.get(); }
+  size_t capacity() const { return capacity_; }
+  size_t size() const { return size_; }
+  void set_size(size_t size);
+
+ private:
+  std::unique_ptr<unsigned char[]> data_;
+  size_t capacity_;
+  size_t size_;
+};
+using MessageBufferPtr = std::shared_ptr<MessageBuffer>;
+
+// Buffers of power of two size classes, shared by all tcp connections of the process. A buffer goes back to the pool
+// when its last MessageBufferPtr is released, so messages of a steady size stop allocating once the pool is warm.
+class MessageBufferPool {
+ public:
+  static MessageBufferPool &GetInstance();
+  MessageBufferPtr Acquire(size_t size);
+  size_t cached_bytes() const;
+
+ private:
+  MessageBufferPool() = default;
+  ~MessageBufferPool() = default;
+  MessageBufferPool(const MessageBufferPool &) = delete;
+  MessageBufferPool &operator=(const MessageBufferPool &) = delete;
+
+  void Release(MessageBuffer *buffer);
+  static size_t SizeClass(size_t size);
+
+  mutable std::mutex mutex_;
+  std::map<size_t, std::vector<std::unique_ptr<MessageBuffer>>> free_buffers_;
+  size_t cached_bytes_{0};
+};
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_CORE_MESSAGE_BUFFER_POOL_H_
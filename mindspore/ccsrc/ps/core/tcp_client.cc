@@ -171,8 +171,12 @@ void TcpClient::ReadCallback(struct bufferevent *bev, void *ctx) {
   struct evbuffer *input = bufferevent_get_input(const_cast<struct bufferevent *>(bev));
   MS_EXCEPTION_IF_NULL(input);
 
-  char read_buffer[4096];
+  if (!tcp_client->read_callback_) {
+    tcp_client->message_handler_.ReceiveMessage(input);
+    return;
+  }
 
+  char read_buffer[4096];
   while (EVBUFFER_LENGTH(input) > 0) {
     int read = evbuffer_remove(input, &read_buffer, sizeof(read_buffer));
     if (read == -1) {
@@ -249,15 +253,21 @@ void TcpClient::SetMessageCallback(const OnMessage &cb) { message_callback_ = cb
 
 void TcpClient::SendMessage(const CommMessage &message) const {
   MS_EXCEPTION_IF_NULL(buffer_event_);
-  uint32_t buf_size = message.ByteSizeLong();
-  std::vector<unsigned char> serialized(buf_size);
-  message.SerializeToArray(serialized.data(), static_cast<int>(buf_size));
-  if (evbuffer_add(bufferevent_get_output(buffer_event_), &buf_size, sizeof(buf_size)) == -1) {
-    MS_LOG(EXCEPTION) << "Event buffer add header failed!";
-  }
-  if (evbuffer_add(bufferevent_get_output(buffer_event_), serialized.data(), buf_size) == -1) {
-    MS_LOG(EXCEPTION) << "Event buffer add protobuf data failed!";
-  }
+  TcpMessageHandler::WriteMessage(bufferevent_get_output(buffer_event_), message);
+}
+
+void TcpClient::SetFramedMessageCallback(const OnFramedMessage &cb) {
+  framed_message_callback_ = cb;
+  message_handler_.SetFramedCallback([this](const CommMessage &meta, const MessageBufferPtr &payload) {
+    if (framed_message_callback_) {
+      framed_message_callback_(*this, meta, payload);
+    }
+  });
+}
+
+void TcpClient::SendMessage(const CommMessage &meta, const MessageBufferPtr &payload) const {
+  MS_EXCEPTION_IF_NULL(buffer_event_);
+  TcpMessageHandler::WriteFramedMessage(bufferevent_get_output(buffer_event_), meta, payload);
 }
 
 void TcpClient::StartTimer(const uint32_t &time) {
@@ -45,6 +45,7 @@ class TcpClient {
   using OnRead = std::function<void(const TcpClient &, const void *, size_t)>;
   using OnTimeout = std::function<void(const TcpClient &)>;
   using OnMessage = std::function<void(const TcpClient &, const CommMessage &)>;
+  using OnFramedMessage = std::function<void(const TcpClient &, const CommMessage &, const MessageBufferPtr &)>;
   using OnTimer = std::function<void(const TcpClient &)>;
 
   explicit TcpClient(const std::string &address, std::uint16_t port);
@@ -61,6 +62,8 @@ class TcpClient {
   void StartWithNoBlock();
   void SetMessageCallback(const OnMessage &cb);
   void SendMessage(const CommMessage &message) const;
+  void SetFramedMessageCallback(const OnFramedMessage &cb);
+  void SendMessage(const CommMessage &meta, const MessageBufferPtr &payload) const;
   void StartTimer(const uint32_t &time);
   void set_timer_callback(const OnTimer &timer);
   const event_base &eventbase();
@@ -75,6 +78,7 @@ class TcpClient {
 
  private:
   OnMessage message_callback_;
+  OnFramedMessage framed_message_callback_;
   TcpMessageHandler message_handler_;
 
   OnConnected connected_callback_;
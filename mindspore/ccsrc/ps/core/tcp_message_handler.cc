@@ -17,61 +17,222 @@
 #include "ps/core/tcp_message_handler.h"
 
 #include <arpa/inet.h>
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
+#include "ps/core/cluster_config.h"
+
 namespace mindspore {
 namespace ps {
 namespace core {
+namespace {
+void ReleasePayload(const void *, size_t, void *holder) { delete reinterpret_cast<MessageBufferPtr *>(holder); }
+}  // namespace
 
 void TcpMessageHandler::SetCallback(const messageReceive &message_receive) { message_callback_ = message_receive; }
 
+void TcpMessageHandler::SetFramedCallback(const framedMessageReceive &framed_message_receive) {
+  framed_message_callback_ = framed_message_receive;
+}
+
 void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
   MS_EXCEPTION_IF_NULL(buffer);
   auto buffer_data = reinterpret_cast<const unsigned char *>(buffer);
 
+  while (num > 0 && state_ != ReceiveState::kDiscard) {
+    size_t copy_len = std::min(num, RemainingLength());
+    int ret = memcpy_s(WritePosition(), copy_len, buffer_data, copy_len);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+    }
+    buffer_data += copy_len;
+    num -= copy_len;
+    Advance(copy_len);
+  }
+}
+
+void TcpMessageHandler::ReceiveMessage(struct evbuffer *buffer) {
+  MS_EXCEPTION_IF_NULL(buffer);
+  size_t num = evbuffer_get_length(buffer);
   while (num > 0) {
-    if (remaining_length_ == 0) {
-      for (int i = 0; i < 4 && num > 0; ++i) {
-        header_[++header_index_] = *(buffer_data + i);
-        --num;
-        if (header_index_ == 3) {
-          message_length_ = *reinterpret_cast<const uint32_t *>(header_);
-          remaining_length_ = message_length_;
-          message_buffer_.reset(new unsigned char[remaining_length_]);
-          buffer_data += (i + 1);
-          break;
+    if (state_ == ReceiveState::kDiscard) {
+      if (evbuffer_drain(buffer, num) == -1) {
+        MS_LOG(EXCEPTION) << "Can not drain data from the event buffer!";
+      }
+      return;
+    }
+    if (state_ == ReceiveState::kMeta && meta_received_ == 0 && num >= meta_length_) {
+      struct evbuffer_iovec vec {};
+      if (evbuffer_peek(buffer, meta_length_, nullptr, &vec, 1) == 1 && vec.iov_len >= meta_length_) {
+        OnMeta(vec.iov_base);
+        if (evbuffer_drain(buffer, meta_length_) == -1) {
+          MS_LOG(EXCEPTION) << "Can not drain data from the event buffer!";
         }
+        num -= meta_length_;
+        continue;
       }
     }
+    size_t copy_len = std::min(num, RemainingLength());
+    int read = evbuffer_remove(buffer, WritePosition(), copy_len);
+    if (read <= 0) {
+      MS_LOG(EXCEPTION) << "Can not drain data from the event buffer!";
+    }
+    num -= static_cast<size_t>(read);
+    Advance(static_cast<size_t>(read));
+  }
+}
 
-    if (remaining_length_ > 0 && num > 0) {
-      uint32_t copy_len = remaining_length_ <= num ? remaining_length_ : num;
-      remaining_length_ -= copy_len;
-      num -= copy_len;
+size_t TcpMessageHandler::RemainingLength() const {
+  if (state_ == ReceiveState::kHeader) {
+    return (is_framed_ ? kFramedMessageHeaderSize : kMessageHeaderSize) - header_length_;
+  } else if (state_ == ReceiveState::kMeta) {
+    return meta_length_ - meta_received_;
+  }
+  return payload_length_ - payload_received_;
+}
 
-      int ret = memcpy_s(message_buffer_.get() + last_copy_len_, copy_len, buffer_data, copy_len);
-      last_copy_len_ += copy_len;
-      buffer_data += copy_len;
-      if (ret != 0) {
-        MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-      }
+unsigned char *TcpMessageHandler::WritePosition() {
+  if (state_ == ReceiveState::kHeader) {
+    return header_ + header_length_;
+  } else if (state_ == ReceiveState::kMeta) {
+    return meta_buffer_->data() + meta_received_;
+  }
+  return payload_buffer_->data() + payload_received_;
+}
 
-      if (remaining_length_ == 0) {
-        CommMessage pb_message;
-        pb_message.ParseFromArray(message_buffer_.get(), message_length_);
-        if (message_callback_) {
-          message_callback_(pb_message);
-        }
-        message_buffer_.reset();
-        message_buffer_ = nullptr;
-        header_index_ = -1;
-        last_copy_len_ = 0;
+void TcpMessageHandler::Advance(size_t len) {
+  if (state_ == ReceiveState::kHeader) {
+    header_length_ += len;
+    if (header_length_ == kMessageHeaderSize) {
+      uint32_t length = 0;
+      if (memcpy_s(&length, sizeof(length), header_, kMessageHeaderSize) != 0) {
+        MS_LOG(EXCEPTION) << "Read the message header failed!";
       }
+      is_framed_ = (length & kFramedMessageFlag) != 0;
+      meta_length_ = length & ~kFramedMessageFlag;
+    }
+    if (header_length_ == (is_framed_ ? kFramedMessageHeaderSize : kMessageHeaderSize)) {
+      OnHeader();
+    }
+  } else if (state_ == ReceiveState::kMeta) {
+    meta_received_ += len;
+    if (meta_received_ == meta_length_) {
+      OnMeta(meta_buffer_->data());
+    }
+  } else {
+    payload_received_ += len;
+    if (payload_received_ == payload_length_) {
+      OnMessage();
     }
   }
 }
 
+void TcpMessageHandler::OnHeader() {
+  payload_length_ = 0;
+  if (is_framed_ && memcpy_s(&payload_length_, sizeof(payload_length_), header_ + kMessageHeaderSize,
+                             sizeof(payload_length_)) != 0) {
+    MS_LOG(EXCEPTION) << "Read the framed message header failed!";
+  }
+  uint64_t max_size = ClusterConfig::max_message_size();
+  if (meta_length_ > max_size || payload_length_ > max_size) {
+    MS_LOG(ERROR) << "Received a message of " << meta_length_ << " bytes of metadata and " << payload_length_
+                  << " bytes of payload, more than the max message size " << max_size
+                  << ", the rest of the stream is discarded!";
+    state_ = ReceiveState::kDiscard;
+    return;
+  }
+  state_ = ReceiveState::kMeta;
+  meta_received_ = 0;
+  if (meta_length_ == 0) {
+    OnMeta(nullptr);
+    return;
+  }
+  meta_buffer_ = MessageBufferPool::GetInstance().Acquire(meta_length_);
+}
+
+void TcpMessageHandler::OnMeta(const void *data) {
+  meta_.Clear();
+  if (meta_length_ > 0 && !meta_.ParseFromArray(data, static_cast<int>(meta_length_))) {
+    MS_LOG(ERROR) << "Parse the message of " << meta_length_ << " bytes failed!";
+  }
+  meta_buffer_ = nullptr;
+  if (payload_length_ > 0) {
+    payload_buffer_ = MessageBufferPool::GetInstance().Acquire(payload_length_);
+    payload_received_ = 0;
+    state_ = ReceiveState::kPayload;
+    return;
+  }
+  OnMessage();
+}
+
+void TcpMessageHandler::OnMessage() {
+  bool is_framed = is_framed_;
+  MessageBufferPtr payload = std::move(payload_buffer_);
+  state_ = ReceiveState::kHeader;
+  header_length_ = 0;
+  is_framed_ = false;
+  payload_buffer_ = nullptr;
+
+  if (is_framed && framed_message_callback_) {
+    if (payload == nullptr) {
+      payload = MessageBufferPool::GetInstance().Acquire(0);
+    }
+    framed_message_callback_(meta_, payload);
+    return;
+  }
+  if (is_framed && payload != nullptr) {
+    meta_.set_data(payload->data(), payload->size());
+  }
+  if (message_callback_) {
+    message_callback_(meta_);
+  }
+}
+
+void TcpMessageHandler::WriteMessage(struct evbuffer *output, const CommMessage &message) {
+  MS_EXCEPTION_IF_NULL(output);
+  uint32_t buf_size = message.ByteSizeLong();
+  std::vector<unsigned char> serialized(buf_size);
+  message.SerializeToArray(serialized.data(), static_cast<int>(buf_size));
+  if (evbuffer_add(output, &buf_size, sizeof(buf_size)) == -1) {
+    MS_LOG(EXCEPTION) << "Event buffer add header failed!";
+  }
+  if (evbuffer_add(output, serialized.data(), buf_size) == -1) {
+    MS_LOG(EXCEPTION) << "Event buffer add protobuf data failed!";
+  }
+}
+
+void TcpMessageHandler::WriteFramedMessage(struct evbuffer *output, const CommMessage &meta,
+                                           const MessageBufferPtr &payload) {
+  MS_EXCEPTION_IF_NULL(output);
+  uint32_t meta_size = meta.ByteSizeLong();
+  if ((meta_size & kFramedMessageFlag) != 0) {
+    MS_LOG(EXCEPTION) << "The meta message of " << meta_size << " bytes is too large!";
+  }
+  uint64_t payload_size = payload == nullptr ? 0 : payload->size();
+  uint32_t length = meta_size | kFramedMessageFlag;
+  unsigned char header[kFramedMessageHeaderSize];
+  if (memcpy_s(header, sizeof(header), &length, sizeof(length)) != 0 ||
+      memcpy_s(header + sizeof(length), sizeof(header) - sizeof(length), &payload_size, sizeof(payload_size)) != 0) {
+    MS_LOG(EXCEPTION) << "Build the framed message header failed!";
+  }
+  std::vector<unsigned char> serialized(meta_size);
+  meta.SerializeToArray(serialized.data(), static_cast<int>(meta_size));
+  if (evbuffer_add(output, header, sizeof(header)) == -1) {
+    MS_LOG(EXCEPTION) << "Event buffer add header failed!";
+  }
+  if (evbuffer_add(output, serialized.data(), meta_size) == -1) {
+    MS_LOG(EXCEPTION) << "Event buffer add protobuf data failed!";
+  }
+  if (payload_size == 0) {
+    return;
+  }
+  auto holder = new MessageBufferPtr(payload);
+  if (evbuffer_add_reference(output, payload->data(), payload_size, ReleasePayload, holder) == -1) {
+    delete holder;
+    MS_LOG(EXCEPTION) << "Event buffer add payload failed!";
+  }
+}
 }  // namespace core
 }  // namespace ps
 }  // namespace mindspore
@@ -17,6 +17,8 @@
 #ifndef MINDSPORE_CCSRC_PS_CORE_TCP_MESSAGE_HANDLER_H_
 #define MINDSPORE_CCSRC_PS_CORE_TCP_MESSAGE_HANDLER_H_
 
+#include <event2/buffer.h>
+
 #include <functional>
 #include <iostream>
 #include <string>
@@ -26,35 +28,74 @@
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
+#include "ps/core/message_buffer_pool.h"
 
 namespace mindspore {
 namespace ps {
 namespace core {
+// A plain message is sent as [uint32 length][CommMessage]. A framed message sets kFramedMessageFlag in the length and
+// is sent as [uint32 meta length | flag][uint64 payload length][CommMessage meta][payload], so the tensor payload
+// never goes through protobuf and is read from the socket buffer into a pooled buffer with a single copy. A message
+// whose metadata or payload is larger than ClusterConfig::max_message_size() is rejected before any buffer is taken
+// for it, and the rest of the stream is discarded since the next header can not be found.
+constexpr uint32_t kFramedMessageFlag = 0x80000000;
+constexpr size_t kMessageHeaderSize = sizeof(uint32_t);
+constexpr size_t kFramedMessageHeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+
 using messageReceive = std::function<void(const CommMessage &message)>;
+using framedMessageReceive = std::function<void(const CommMessage &meta, const MessageBufferPtr &payload)>;
 
 class TcpMessageHandler {
  public:
   TcpMessageHandler()
-      : is_parsed_(false),
-        message_buffer_(nullptr),
-        message_length_(0),
-        remaining_length_(0),
-        header_index_(-1),
-        last_copy_len_(0) {}
+      : state_(ReceiveState::kHeader),
+        header_length_(0),
+        is_framed_(false),
+        meta_length_(0),
+        meta_received_(0),
+        payload_length_(0),
+        payload_received_(0),
+        meta_buffer_(nullptr),
+        payload_buffer_(nullptr) {}
   virtual ~TcpMessageHandler() = default;
 
   void SetCallback(const messageReceive &cb);
+  // Without a framed callback, the payload of a framed message is copied into the data field of its meta message and
+  // delivered to the plain callback.
+  void SetFramedCallback(const framedMessageReceive &cb);
   void ReceiveMessage(const void *buffer, size_t num);
+  // Take the bytes straight out of a libevent input buffer, metadata is parsed in place when it is contiguous.
+  void ReceiveMessage(struct evbuffer *buffer);
+  // Whether an oversized message was received, nothing more is delivered then
+  bool discarding() const { return state_ == ReceiveState::kDiscard; }
+
+  static void WriteMessage(struct evbuffer *output, const CommMessage &message);
+  // The payload is referenced by the output buffer rather than copied, and kept alive until it has been written out.
+  static void WriteFramedMessage(struct evbuffer *output, const CommMessage &meta, const MessageBufferPtr &payload);
 
  private:
+  enum class ReceiveState { kHeader, kMeta, kPayload, kDiscard };
+
+  size_t RemainingLength() const;
+  unsigned char *WritePosition();
+  void Advance(size_t len);
+  void OnHeader();
+  void OnMeta(const void *data);
+  void OnMessage();
+
   messageReceive message_callback_;
-  bool is_parsed_;
-  std::unique_ptr<unsigned char> message_buffer_;
-  size_t message_length_;
-  uint32_t remaining_length_;
-  char header_[4];
-  int header_index_;
-  uint32_t last_copy_len_;
+  framedMessageReceive framed_message_callback_;
+  ReceiveState state_;
+  unsigned char header_[kFramedMessageHeaderSize];
+  size_t header_length_;
+  bool is_framed_;
+  uint32_t meta_length_;
+  uint32_t meta_received_;
+  uint64_t payload_length_;
+  uint64_t payload_received_;
+  MessageBufferPtr meta_buffer_;
+  MessageBufferPtr payload_buffer_;
+  CommMessage meta_;
 };
 }  // namespace core
 }  // namespace ps
@@ -39,10 +39,20 @@ void TcpConnection::InitConnection() {
       on_server_receive(*server_, *this, message);
     }
   });
+  if (server_->GetServerReceiveFramed()) {
+    tcp_message_handler_.SetFramedCallback([&](const CommMessage &meta, const MessageBufferPtr &payload) {
+      OnServerReceiveFramedMessage on_server_receive = server_->GetServerReceiveFramed();
+      if (on_server_receive) {
+        on_server_receive(*server_, *this, meta, payload);
+      }
+    });
+  }
 }
 
 void TcpConnection::OnReadHandler(const void *buffer, size_t num) { tcp_message_handler_.ReceiveMessage(buffer, num); }
 
+void TcpConnection::OnReadHandler(struct evbuffer *buffer) { tcp_message_handler_.ReceiveMessage(buffer); }
+
 void TcpConnection::SendMessage(const void *buffer, size_t num) const {
   if (bufferevent_write(buffer_event_, buffer, num) == -1) {
     MS_LOG(ERROR) << "Write message to buffer event failed!";
@@ -55,17 +65,13 @@ const evutil_socket_t &TcpConnection::GetFd() const { return fd_; }
 
 void TcpConnection::SendMessage(const CommMessage &message) const {
   MS_EXCEPTION_IF_NULL(buffer_event_);
-  uint32_t buf_size = message.ByteSizeLong();
-  std::vector<unsigned char> serialized(buf_size);
-  message.SerializeToArray(serialized.data(), static_cast<int>(buf_size));
-  if (evbuffer_add(bufferevent_get_output(const_cast<struct bufferevent *>(buffer_event_)), &buf_size,
-                   sizeof(buf_size)) == -1) {
-    MS_LOG(EXCEPTION) << "Event buffer add header failed!";
-  }
-  if (evbuffer_add(bufferevent_get_output(const_cast<struct bufferevent *>(buffer_event_)), serialized.data(),
-                   buf_size) == -1) {
-    MS_LOG(EXCEPTION) << "Event buffer add protobuf data failed!";
-  }
+  TcpMessageHandler::WriteMessage(bufferevent_get_output(const_cast<struct bufferevent *>(buffer_event_)), message);
+}
+
+void TcpConnection::SendMessage(const CommMessage &meta, const MessageBufferPtr &payload) const {
+  MS_EXCEPTION_IF_NULL(buffer_event_);
+  TcpMessageHandler::WriteFramedMessage(bufferevent_get_output(const_cast<struct bufferevent *>(buffer_event_)), meta,
+                                        payload);
 }
 
 TcpServer::TcpServer(const std::string &address, std::uint16_t port)
@@ -275,14 +281,8 @@ void TcpServer::ReadCallback(struct bufferevent *bev, void *connection) {
 
   auto conn = static_cast<class TcpConnection *>(connection);
   struct evbuffer *buf = bufferevent_get_input(bev);
-  char read_buffer[4096];
-  while (EVBUFFER_LENGTH(buf) > 0) {
-    int read = evbuffer_remove(buf, &read_buffer, sizeof(read_buffer));
-    if (read == -1) {
-      MS_LOG(EXCEPTION) << "Can not drain data from the event buffer!";
-    }
-    conn->OnReadHandler(read_buffer, static_cast<size_t>(read));
-  }
+  MS_EXCEPTION_IF_NULL(buf);
+  conn->OnReadHandler(buf);
 }
 
 void TcpServer::EventCallback(struct bufferevent *bev, std::int16_t events, void *data) {
@@ -327,6 +327,10 @@ void TcpServer::TimerCallback(evutil_socket_t, int16_t, void *arg) {
 
 void TcpServer::SendMessage(const TcpConnection &conn, const CommMessage &message) { conn.SendMessage(message); }
 
+void TcpServer::SendMessage(const TcpConnection &conn, const CommMessage &meta, const MessageBufferPtr &payload) {
+  conn.SendMessage(meta, payload);
+}
+
 void TcpServer::SendMessage(const CommMessage &message) {
   std::unique_lock<std::recursive_mutex> lock(connection_mutex_);
 
@@ -342,6 +346,10 @@ int TcpServer::ConnectionNum() const { return connections_.size(); }
 const std::map<evutil_socket_t, const TcpConnection *> &TcpServer::Connections() const { return connections_; }
 
 void TcpServer::SetMessageCallback(const OnServerReceiveMessage &cb) { message_callback_ = cb; }
+
+OnServerReceiveFramedMessage TcpServer::GetServerReceiveFramed() const { return framed_message_callback_; }
+
+void TcpServer::SetFramedMessageCallback(const OnServerReceiveFramedMessage &cb) { framed_message_callback_ = cb; }
 }  // namespace core
 }  // namespace ps
 }  // namespace mindspore
@@ -52,7 +52,9 @@ class TcpConnection {
   virtual void InitConnection();
   virtual void SendMessage(const void *buffer, size_t num) const;
   void SendMessage(const CommMessage &message) const;
+  void SendMessage(const CommMessage &meta, const MessageBufferPtr &payload) const;
   virtual void OnReadHandler(const void *buffer, size_t numBytes);
+  virtual void OnReadHandler(struct evbuffer *buffer);
   TcpServer *GetServer() const;
   const evutil_socket_t &GetFd() const;
 
@@ -65,6 +67,8 @@ class TcpConnection {
 
 using OnServerReceiveMessage =
   std::function<void(const TcpServer &tcp_server, const TcpConnection &conn, const CommMessage &)>;
+using OnServerReceiveFramedMessage = std::function<void(const TcpServer &tcp_server, const TcpConnection &conn,
+                                                        const CommMessage &, const MessageBufferPtr &)>;
 
 class TcpServer {
  public:
@@ -89,7 +93,10 @@ class TcpServer {
   void RemoveConnection(const evutil_socket_t &fd);
   OnServerReceiveMessage GetServerReceive() const;
   void SetMessageCallback(const OnServerReceiveMessage &cb);
+  OnServerReceiveFramedMessage GetServerReceiveFramed() const;
+  void SetFramedMessageCallback(const OnServerReceiveFramedMessage &cb);
   void SendMessage(const TcpConnection &conn, const CommMessage &message);
+  void SendMessage(const TcpConnection &conn, const CommMessage &meta, const MessageBufferPtr &payload);
   void SendMessage(const CommMessage &message);
   uint16_t BoundPort() const;
   int ConnectionNum() const;
@@ -117,6 +124,7 @@ class TcpServer {
   OnAccepted client_accept_;
   std::recursive_mutex connection_mutex_;
   OnServerReceiveMessage message_callback_;
+  OnServerReceiveFramedMessage framed_message_callback_;
   OnTimer on_timer_callback_;
 };
 }  // namespace core
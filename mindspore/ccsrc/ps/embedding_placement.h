@@ -0,0 +1,224 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_EMBEDDING_PLACEMENT_H_
+#define MINDSPORE_CCSRC_PS_EMBEDDING_PLACEMENT_H_
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "ps/ps.h"
+#include "ps/common.h"
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+// The servers of each replicated hot row of an embedding table, its owner first
+using HotRowServers = std::unordered_map<Key, std::vector<int64_t>>;
+
+// Where the rows of an embedding table live. The rows are split into even ranges, one per server, and with
+// MS_PS_EMBEDDING_REBALANCE_INTERVAL set the hottest rows get replicas on other servers.
+class EmbeddingPlacement {
+ public:
+  // The server owning the range of the row, -1 if the row is out of the table
+  static int64_t RowServer(const std::vector<::ps::Range> &ranges, uint64_t row) {
+    auto iter = std::lower_bound(ranges.begin(), ranges.end(), row,
+                                 [](const ::ps::Range &range, uint64_t id) { return range.end() < id; });
+    if (iter == ranges.end() || row < iter->begin()) {
+      return -1;
+    }
+    return iter - ranges.begin();
+  }
+
+  // Splits the ids of a lookup over the servers, each distinct id once. An id goes to the owner of its range, or with
+  // hot_rows set a replicated row goes to its servers in turn. Ids out of the table go nowhere.
+  static std::vector<std::vector<Key>> SliceLookupIds(const int *lookup_ids, size_t id_size,
+                                                      const std::vector<::ps::Range> &ranges,
+                                                      const HotRowServers *hot_rows, int64_t timestamp) {
+    std::vector<std::vector<Key>> server_ids(ranges.size());
+    std::unordered_set<uint64_t> unique_ids;
+    for (size_t i = 0; i < id_size; i++) {
+      auto lookup_id = static_cast<uint64_t>(lookup_ids[i]);
+      if (!unique_ids.insert(lookup_id).second) {
+        continue;
+      }
+      int64_t server = RowServer(ranges, lookup_id);
+      if (server < 0) {
+        continue;
+      }
+      if (hot_rows != nullptr) {
+        auto row_iter = hot_rows->find(lookup_id);
+        if (row_iter != hot_rows->end()) {
+          const auto &servers = row_iter->second;
+          server = servers[(lookup_id + static_cast<uint64_t>(timestamp)) % servers.size()];
+        }
+      }
+      server_ids[server].push_back(lookup_id);
+    }
+    return server_ids;
+  }
+
+  // Copies the rows the servers returned to the positions of their ids in outs. A server leaves out the rows it no
+  // longer holds, and sends no data at all when it holds none of them. Returns the positions no server returned.
+  template <typename T>
+  static std::vector<size_t> GatherLookupResult(const ::ps::SArray<int> &lookup_ids,
+                                                const std::vector<::ps::KVPairs<T>> &results, ::ps::SArray<T> *outs) {
+    MS_EXCEPTION_IF_NULL(outs);
+    if (lookup_ids.empty()) {
+      MS_LOG(EXCEPTION) << "Lookup id is empty.";
+    }
+    size_t row_len = outs->size() / lookup_ids.size();
+    std::unordered_map<Key, const T *> id_addr_map;
+    for (const auto &kvs : results) {
+      if (kvs.vals.size() < kvs.keys.size() * row_len) {
+        MS_LOG(EXCEPTION) << "The lookup result has " << kvs.vals.size() << " values for " << kvs.keys.size()
+                          << " rows of " << row_len;
+      }
+      for (size_t i = 0; i < kvs.keys.size(); i++) {
+        id_addr_map[kvs.keys[i]] = kvs.vals.data() + i * row_len;
+      }
+    }
+
+    std::vector<size_t> missed;
+    size_t row_bytes = row_len * sizeof(T);
+    for (size_t i = 0; i < lookup_ids.size(); i++) {
+      auto iter = id_addr_map.find(static_cast<Key>(lookup_ids[i]));
+      if (iter == id_addr_map.end()) {
+        missed.push_back(i);
+        continue;
+      }
+      if (row_bytes == 0) {
+        continue;
+      }
+      auto ret = memcpy_s(outs->data() + i * row_len, row_bytes, iter->second, row_bytes);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+      }
+    }
+    return missed;
+  }
+
+  // Takes the pushed rows out of the placement and returns, per server, the replicas of them it has to drop. A push
+  // updates the owner only, a replica left in place would serve the row stale until the next rebalance.
+  static std::vector<std::vector<Key>> DropPushedRows(const int *indices, size_t indice_size, size_t server_num,
+                                                      HotRowServers *hot_rows) {
+    MS_EXCEPTION_IF_NULL(hot_rows);
+    std::vector<std::vector<Key>> server_rows(server_num);
+    for (size_t i = 0; i < indice_size; i++) {
+      auto iter = hot_rows->find(static_cast<Key>(indices[i]));
+      if (iter == hot_rows->end()) {
+        continue;
+      }
+      for (size_t j = 1; j < iter->second.size(); j++) {
+        server_rows[iter->second[j]].push_back(iter->first);
+      }
+      hot_rows->erase(iter);
+    }
+    return server_rows;
+  }
+
+  // Places the hot rows of a table from the stats of every server: its load, its hottest rows with their hits and the
+  // replicated rows it holds. placed_rows is the current placement.
+  template <typename T>
+  static HotRowServers PlaceHotRows(const std::vector<::ps::Range> &ranges,
+                                    const std::map<int64_t, ::ps::KVPairs<T>> &stats,
+                                    const HotRowServers &placed_rows) {
+    size_t server_num = ranges.size();
+    std::vector<double> loads(server_num, 0);
+    std::unordered_map<Key, double> row_hits;
+    std::unordered_map<Key, size_t> row_copies;
+    for (const auto &server_stats : stats) {
+      const ::ps::KVPairs<T> &kvs = server_stats.second;
+      size_t hot_num = static_cast<size_t>(kvs.lens[0]);
+      loads[server_stats.first] = kvs.vals[0];
+      for (size_t i = 0; i < hot_num; i++) {
+        row_hits[kvs.keys[1 + i]] += kvs.vals[1 + i];
+      }
+      for (size_t i = 1 + hot_num; i < kvs.keys.size(); i++) {
+        row_copies[kvs.keys[i]]++;
+      }
+    }
+    double total = std::accumulate(loads.begin(), loads.end(), 0.0);
+    if (total <= 0) {
+      return {};
+    }
+
+    // Take the hot rows off the servers that served them, spread evenly over the owner and its replicas
+    std::vector<std::pair<double, Key>> hot_rows;
+    for (const auto &row : row_hits) {
+      int64_t owner = RowServer(ranges, row.first);
+      if (owner < 0) {
+        continue;
+      }
+      hot_rows.emplace_back(row.second, row.first);
+      auto placed = placed_rows.find(row.first);
+      if (placed == placed_rows.end() || row_copies.count(row.first) == 0) {
+        loads[owner] -= row.second;
+        continue;
+      }
+      for (auto server : placed->second) {
+        loads[server] -= row.second / placed->second.size();
+      }
+    }
+    for (auto &load : loads) {
+      load = std::max(load, 0.0);
+    }
+    std::sort(hot_rows.begin(), hot_rows.end(), std::greater<std::pair<double, Key>>());
+
+    // Put the rows back hottest first. A row gets the least loaded server as one more replica while that lowers the
+    // highest load among its servers and that load is above the mean
+    double target = total / server_num * kHotRowLoadSlack;
+    HotRowServers placement;
+    for (size_t i = 0; i < hot_rows.size(); i++) {
+      double hits = hot_rows[i].first;
+      Key row = hot_rows[i].second;
+      std::vector<int64_t> servers{RowServer(ranges, row)};
+      double max_load = loads[servers[0]];
+      bool replicate = i < kMaxHotRows && hits * kMaxHotRows >= total;
+      while (replicate && servers.size() < server_num && max_load + hits / servers.size() > target) {
+        int64_t candidate = -1;
+        for (int64_t s = 0; s < static_cast<int64_t>(server_num); s++) {
+          if (std::find(servers.begin(), servers.end(), s) == servers.end() &&
+              (candidate < 0 || loads[s] < loads[candidate])) {
+            candidate = s;
+          }
+        }
+        if (std::max(max_load, loads[candidate]) + hits / (servers.size() + 1) >= max_load + hits / servers.size()) {
+          break;
+        }
+        max_load = std::max(max_load, loads[candidate]);
+        servers.push_back(candidate);
+      }
+      for (auto server : servers) {
+        loads[server] += hits / servers.size();
+      }
+      if (servers.size() > 1) {
+        placement[row] = std::move(servers);
+      }
+    }
+    return placement;
+  }
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_EMBEDDING_PLACEMENT_H_
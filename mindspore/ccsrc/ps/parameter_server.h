@@ -24,6 +24,9 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <thread>
 #include <cmath>
@@ -32,6 +35,7 @@
 #include <list>
 #include <map>
 #include <functional>
+#include <algorithm>
 #include "ir/func_graph.h"
 #include "backend/session/session_basic.h"
 #include "backend/session/anf_runtime_algorithm.h"
@@ -82,6 +86,30 @@ class ParameterServer {
   ParameterServer(const ParameterServer &) = delete;
   ParameterServer &operator=(const ParameterServer &) = delete;
 
+  // A hot row of another server's shard that this server serves as well
+  struct ReplicaRow {
+    std::vector<T> data;
+    std::atomic<uint32_t> hits{0};
+  };
+
+  // State kept per weight key. The rw lock guards the weight data and its optimizer info, so lookups and pulls only
+  // wait for the update of the same table rather than for the global mutex_.
+  struct TableState {
+    std::shared_mutex rw_mutex;
+    std::atomic<uint64_t> lookup_count{0};
+    std::atomic<uint64_t> lookup_ids{0};
+    std::atomic<uint64_t> lookup_latency_us{0};
+    std::atomic<uint64_t> max_lookup_latency_us{0};
+    std::atomic<int64_t> report_start_us{0};
+    // Hits per row of the shard since the last stats, only counted for embedding tables whose rows are rebalanced
+    std::unique_ptr<std::atomic<uint32_t>[]> row_hits;
+    size_t local_rows{0};
+    int64_t row_offset{0};
+    // Replicated hot rows by row id, guarded by rw_mutex
+    std::unordered_map<Key, ReplicaRow> replica_rows;
+  };
+  using TableStatePtr = std::shared_ptr<TableState>;
+
   class ServerHandler {
    public:
     explicit ServerHandler(ParameterServer *ps) : ps_(ps) {}
@@ -100,6 +128,11 @@ class ParameterServer {
     void HandleCheckReadyForPush(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleCheckReadyForPull(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleEmbeddingLookup(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    void HandleEmbeddingStats(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    void HandleReplicateEmbeddingRows(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
+                                      ::ps::KVPairs<T> *res);
+    void HandleDropEmbeddingReplicas(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
+                                     ::ps::KVPairs<T> *res);
     void HandleFinalize(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
 
     ParameterServer *ps_;
@@ -125,12 +158,21 @@ class ParameterServer {
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res);
+  void ServeReplicaRows(const LookupIds &lookup_ids, TableState *state, size_t row_size, T *rows,
+                        std::vector<size_t> *missed);
+  void GetEmbeddingStats(const Key &key, bool decay, ::ps::KVPairs<T> *res);
+  void ReplicateEmbeddingRows(const Key &key, const LookupIds &rows, const Values &vals);
+  void DropEmbeddingReplicas(const Key &key, const LookupIds &rows);
   bool ReadyForUpdateWeights();
   bool ReadyForPush(const Key &key);
   bool ReadyForPull(const Key &key);
   void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
   std::mutex &mutex();
+  void InitTableState(const Key &key);
+  void RecordLookup(const Key &key, const TableStatePtr &state, size_t ids_num,
+                    const std::chrono::steady_clock::time_point &start_time);
+  void ReportLookupStats(const Key &key, TableState *state, bool total);
   void GetEmbeddingTableParamPtr();
   void SyncEmbeddingTables();
 
@@ -155,8 +197,9 @@ class ParameterServer {
   std::unordered_map<Key, bool> is_embedding_;
   std::unordered_map<Key, WeightPtr> grads_;
   std::unordered_map<Key, size_t> grads_accum_counter_;
-  std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
+  std::unordered_map<Key, std::shared_ptr<kernel::ps::EmbeddingLookUpPSKernel>> embedding_lookup_ops_;
   std::unordered_map<Key, uint64_t> tokens_;
+  std::unordered_map<Key, TableStatePtr> table_states_;
 
   std::mutex mutex_;
   std::condition_variable apply_grads_cv_;
@@ -193,6 +236,9 @@ void ParameterServer<T>::ServerHandler::Init() {
   handlers_[kCheckReadyForPushCmd] = &ServerHandler::HandleCheckReadyForPush;
   handlers_[kCheckReadyForPullCmd] = &ServerHandler::HandleCheckReadyForPull;
   handlers_[kEmbeddingLookupCmd] = &ServerHandler::HandleEmbeddingLookup;
+  handlers_[kEmbeddingStatsCmd] = &ServerHandler::HandleEmbeddingStats;
+  handlers_[kReplicateEmbeddingRowsCmd] = &ServerHandler::HandleReplicateEmbeddingRows;
+  handlers_[kDropEmbeddingReplicasCmd] = &ServerHandler::HandleDropEmbeddingReplicas;
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
 }
 
@@ -338,6 +384,33 @@ void ParameterServer<T>::ServerHandler::HandleEmbeddingLookup(const ::ps::KVMeta
   ps_->DoEmbeddingLookup(key, req_data.keys.segment(1, req_data.keys.size()), res);
 }
 
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandleEmbeddingStats(const ::ps::KVMeta &req_meta,
+                                                             const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
+  MS_EXCEPTION_IF_NULL(res);
+  const Key &key = req_data.keys[0];
+  bool decay = !req_data.vals.empty() && req_data.vals[0] > 0;
+  ps_->GetEmbeddingStats(key, decay, res);
+}
+
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandleReplicateEmbeddingRows(const ::ps::KVMeta &req_meta,
+                                                                     const ::ps::KVPairs<T> &req_data,
+                                                                     ::ps::KVPairs<T> *res) {
+  MS_EXCEPTION_IF_NULL(res);
+  const Key &key = req_data.keys[0];
+  ps_->ReplicateEmbeddingRows(key, req_data.keys.segment(1, req_data.keys.size()), req_data.vals);
+}
+
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandleDropEmbeddingReplicas(const ::ps::KVMeta &req_meta,
+                                                                    const ::ps::KVPairs<T> &req_data,
+                                                                    ::ps::KVPairs<T> *res) {
+  MS_EXCEPTION_IF_NULL(res);
+  const Key &key = req_data.keys[0];
+  ps_->DropEmbeddingReplicas(key, req_data.keys.segment(1, req_data.keys.size()));
+}
+
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleFinalize(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
                                                        ::ps::KVPairs<T> *res) {
@@ -462,6 +535,7 @@ void ParameterServer<T>::InitWeight(const Key &key, const WeightPtr &weight) {
     weights_[key] = weight;
     tokens_[key] = 0;
     is_embedding_[key] = false;
+    InitTableState(key);
   }
 }
 
@@ -479,8 +553,7 @@ void ParameterServer<T>::InitEmbeddingTable(
   const Key &key, const std::shared_ptr<std::vector<std::shared_ptr<std::vector<size_t>>>> &shapes) {
   MS_EXCEPTION_IF_NULL(shapes);
   if (weights_.count(key) == 0) {
-    std::shared_ptr<PServerKernel> lookup =
-      std::make_shared<kernel::ps::EmbeddingLookUpPSKernel>(rank_id_, pserver_num_, worker_num_);
+    auto lookup = std::make_shared<kernel::ps::EmbeddingLookUpPSKernel>(rank_id_, pserver_num_, worker_num_);
     lookup->InitKernel(shapes);
     embedding_lookup_ops_[key] = lookup;
 
@@ -499,6 +572,13 @@ void ParameterServer<T>::InitEmbeddingTable(
     weights_[key] = embedding;
     tokens_[key] = 0;
     is_embedding_[key] = true;
+    InitTableState(key);
+    if (Util::EmbeddingRebalanceInterval() > 0) {
+      auto &state = table_states_[key];
+      state->local_rows = input_shapes[0];
+      state->row_offset = lookup->offset();
+      state->row_hits.reset(new std::atomic<uint32_t>[state->local_rows]());
+    }
 
     grads_accum_counter_[key] = 0;
   }
@@ -514,10 +594,22 @@ void ParameterServer<T>::Finalize() {
   running_ = false;
   apply_grads_cv_.notify_one();
   SyncEmbeddingTables();
+  for (const auto &iter : table_states_) {
+    if (iter.second->lookup_count > 0) {
+      ReportLookupStats(iter.first, iter.second.get(), true);
+    }
+  }
 }
 
 template <typename T>
 void ParameterServer<T>::UpdateWeights() {
+  struct UpdateTask {
+    Key key;
+    std::shared_ptr<PServerKernel> optimizer;
+    std::shared_ptr<OptimizerInfo> optim_info;
+    std::vector<std::vector<size_t>> input_shapes;
+    TableStatePtr state;
+  };
   while (true) {
     std::unique_lock<std::mutex> lock(mutex_);
     apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
@@ -525,39 +617,53 @@ void ParameterServer<T>::UpdateWeights() {
       break;
     }
 
+    std::vector<UpdateTask> tasks;
     for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
       Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
-
       std::shared_ptr<PServerKernel> optimizer = nullptr;
       if (weight_key_to_optims_.count(key) > 0) {
         optimizer = optimizers_[key];
       }
       MS_EXCEPTION_IF_NULL(optimizer);
 
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-        std::vector<std::vector<size_t>> shapes = {};
-        std::vector<size_t> indices_shape = {};
-        indices_shape.emplace_back(optim_info->indice_size());
-        shapes.push_back(indices_shape);
-
-        if (original_optim_inputs_shape_.count(key) != 0) {
-          for (auto input_shapes : *(original_optim_inputs_shape_[key])) {
-            shapes.push_back(*input_shapes);
-          }
+      UpdateTask task{key, optimizer, optim_infos_[key], {}, table_states_[key]};
+      if (original_optim_inputs_shape_.count(key) != 0) {
+        for (auto input_shapes : *(original_optim_inputs_shape_[key])) {
+          task.input_shapes.push_back(*input_shapes);
         }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, rank_id_);
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
       }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
+      tasks.push_back(task);
+    }
+
+    // The optimizers run without mutex_, so lookups and pulls of other tables go on meanwhile. No push can come in
+    // before ResetGradAccumCount, since ReadyForPush stays false while every gradient is accumulated.
+    lock.unlock();
+    for (auto &task : tasks) {
+      const std::shared_ptr<OptimizerInfo> &optim_info = task.optim_info;
+      if (optim_info == nullptr) {
+        continue;
+      }
+      const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+      const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+      const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+
+      std::vector<std::vector<size_t>> shapes = {};
+      std::vector<size_t> indices_shape = {};
+      indices_shape.emplace_back(optim_info->indice_size());
+      shapes.push_back(indices_shape);
+      shapes.insert(shapes.end(), task.input_shapes.begin(), task.input_shapes.end());
+
+      std::unique_lock<std::shared_mutex> table_lock(task.state->rw_mutex);
+      task.optimizer->ReInit(shapes);
+      optim_info->ComputeMean(shapes, worker_num_, pserver_num_, rank_id_);
+      task.optimizer->Execute(inputs, workspaces, outputs);
+      optim_info->Reset();
+    }
+    lock.lock();
+
+    for (auto &task : tasks) {
+      if (!is_embedding_[task.key]) {
+        tokens_[task.key] = worker_num_;
       }
     }
     ResetGradAccumCount();
@@ -570,6 +676,8 @@ void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const
   const Key &key = keys[0];
   bool no_sparse_grad = values.size() == 1 && values[0] == -100;
   if (!no_sparse_grad) {
+    InitTableState(key);
+    std::unique_lock<std::shared_mutex> table_lock(table_states_[key]->rw_mutex);
     std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
 
     // Create or update the optimizer info
@@ -601,76 +709,233 @@ void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const
 
 template <typename T>
 WeightPtr ParameterServer<T>::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
-    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+  WeightPtr weight_ptr = nullptr;
+  TableStatePtr state = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (weights_.count(key) == 0) {
+      MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+    }
+    weight_ptr = weights_[key];
+    state = table_states_[key];
+    tokens_[key] -= 1;
   }
-  WeightPtr weight_ptr = weights_[key];
   MS_EXCEPTION_IF_NULL(weight_ptr);
+  MS_EXCEPTION_IF_NULL(state);
   WeightPtr copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
   MS_EXCEPTION_IF_NULL(copy_weight_ptr);
+  std::shared_lock<std::shared_mutex> table_lock(state->rw_mutex);
   copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
-  tokens_[key] -= 1;
   return copy_weight_ptr;
 }
 
 template <typename T>
 void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
-  if (weights_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding table key " << key;
-    return;
-  }
-  if (embedding_lookup_ops_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
-    return;
+  auto start_time = std::chrono::steady_clock::now();
+  WeightPtr table_ptr = nullptr;
+  std::shared_ptr<kernel::ps::EmbeddingLookUpPSKernel> table_lookup_op = nullptr;
+  TableStatePtr state = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (weights_.count(key) == 0) {
+      MS_LOG(ERROR) << "Invalid embedding table key " << key;
+      return;
+    }
+    if (embedding_lookup_ops_.count(key) == 0) {
+      MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
+      return;
+    }
+    table_ptr = weights_[key];
+    table_lookup_op = embedding_lookup_ops_[key];
+    state = table_states_[key];
   }
-  WeightPtr table_ptr = weights_[key];
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
   MS_EXCEPTION_IF_NULL(table_lookup_op);
-
-  // Update shapes of lookup operator
-  std::vector<std::vector<size_t>> shapes = {};
-  std::vector<size_t> indices_shape = {};
-  indices_shape.emplace_back(lookup_ids.size());
-  shapes.push_back(indices_shape);
-  table_lookup_op->ReInit(shapes);
-
-  const std::vector<size_t> output_shapes = table_lookup_op->output_sizes();
-  std::vector<kernel::AddressPtr> inputs;
-  AddressPtr embedding_table = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(embedding_table);
-  AddressPtr indices = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(indices);
-  inputs.push_back(embedding_table);
-  inputs.push_back(indices);
-  embedding_table->addr = table_ptr->data();
-  embedding_table->size = table_ptr->size() * sizeof(T);
+  MS_EXCEPTION_IF_NULL(state);
 
   std::unique_ptr<int[]> tmp_ids(new int[lookup_ids.size()]);
   MS_EXCEPTION_IF_NULL(tmp_ids);
   for (size_t i = 0; i < lookup_ids.size(); i++) {
     tmp_ids[i] = static_cast<int>(lookup_ids[i]);
   }
-  indices->addr = tmp_ids.get();
-  indices->size = lookup_ids.size() * sizeof(int);
-
-  std::vector<kernel::AddressPtr> workspaces;
-  std::vector<kernel::AddressPtr> outputs;
-  AddressPtr output = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(output);
-  std::shared_ptr<Values> addr = std::make_shared<Values>(output_shapes[0] / sizeof(T), 0);
+  size_t row_size = table_lookup_op->outer_dim_size();
+  std::shared_ptr<Values> addr = std::make_shared<Values>(row_size * lookup_ids.size(), 0);
   MS_EXCEPTION_IF_NULL(addr);
-
-  output->addr = addr->data();
-  output->size = output_shapes[0];
-  outputs.push_back(output);
-
-  table_lookup_op->Execute(inputs, workspaces, outputs);
+  std::vector<size_t> missed;
+  {
+    std::shared_lock<std::shared_mutex> table_lock(state->rw_mutex);
+    table_lookup_op->LookUp(table_ptr->data(), tmp_ids.get(), lookup_ids.size(), addr->data());
+    if (state->row_hits != nullptr) {
+      ServeReplicaRows(lookup_ids, state.get(), row_size, addr->data(), &missed);
+    }
+  }
+  if (!missed.empty()) {
+    // Rows that moved off this server since the worker's placement are left out, the worker asks their owner
+    Keys served_keys;
+    std::shared_ptr<Values> served = std::make_shared<Values>(row_size * (lookup_ids.size() - missed.size()), 0);
+    MS_EXCEPTION_IF_NULL(served);
+    size_t next_missed = 0;
+    for (size_t i = 0; i < lookup_ids.size(); i++) {
+      if (next_missed < missed.size() && missed[next_missed] == i) {
+        next_missed++;
+        continue;
+      }
+      size_t row_bytes = row_size * sizeof(T);
+      auto ret = memcpy_s(served->data() + served_keys.size() * row_size, row_bytes, addr->data() + i * row_size,
+                          row_bytes);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+      }
+      served_keys.push_back(lookup_ids[i]);
+    }
+    res->keys = served_keys;
+    addr = served;
+  }
   res->vals = *addr;
   res->lens.push_back(res->vals.size());
+  RecordLookup(key, state, lookup_ids.size(), start_time);
+}
+
+template <typename T>
+void ParameterServer<T>::ServeReplicaRows(const LookupIds &lookup_ids, TableState *state, size_t row_size, T *rows,
+                                          std::vector<size_t> *missed) {
+  MS_EXCEPTION_IF_NULL(state);
+  MS_EXCEPTION_IF_NULL(rows);
+  MS_EXCEPTION_IF_NULL(missed);
+  size_t row_bytes = row_size * sizeof(T);
+  for (size_t i = 0; i < lookup_ids.size(); i++) {
+    int64_t local_row = static_cast<int64_t>(lookup_ids[i]) - state->row_offset;
+    if (local_row >= 0 && static_cast<size_t>(local_row) < state->local_rows) {
+      state->row_hits[local_row].fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    auto iter = state->replica_rows.find(lookup_ids[i]);
+    if (iter == state->replica_rows.end()) {
+      missed->push_back(i);
+      continue;
+    }
+    iter->second.hits.fetch_add(1, std::memory_order_relaxed);
+    auto ret = memcpy_s(rows + i * row_size, row_bytes, iter->second.data.data(), row_bytes);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+    }
+  }
+}
+
+template <typename T>
+void ParameterServer<T>::GetEmbeddingStats(const Key &key, bool decay, ::ps::KVPairs<T> *res) {
+  MS_EXCEPTION_IF_NULL(res);
+  TableStatePtr state = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (table_states_.count(key) > 0) {
+      state = table_states_[key];
+    }
+  }
+  // The response is the table key, the hottest rows and then the replicated rows. vals holds the number of ids
+  // served and the hits of each hot row, lens the number of hot and of replicated rows.
+  std::vector<std::pair<uint32_t, Key>> hits;
+  std::vector<Key> replicas;
+  uint64_t served = 0;
+  if (state != nullptr && state->row_hits != nullptr) {
+    auto count = [decay, &hits, &served](std::atomic<uint32_t> *counter, Key row) {
+      uint32_t row_hits = counter->load(std::memory_order_relaxed);
+      if (decay) {
+        // Halving keeps the placement following recent lookups without forgetting a row at once
+        counter->store(row_hits / 2, std::memory_order_relaxed);
+      }
+      if (row_hits > 0) {
+        served += row_hits;
+        hits.emplace_back(row_hits, row);
+      }
+    };
+    std::shared_lock<std::shared_mutex> table_lock(state->rw_mutex);
+    for (size_t i = 0; i < state->local_rows; i++) {
+      count(&state->row_hits[i], static_cast<Key>(state->row_offset + static_cast<int64_t>(i)));
+    }
+    for (auto &iter : state->replica_rows) {
+      count(&iter.second.hits, iter.first);
+      replicas.push_back(iter.first);
+    }
+  }
+  size_t hot_num = std::min(hits.size(), kMaxHotRows);
+  std::partial_sort(hits.begin(), hits.begin() + hot_num, hits.end(),
+                    [](const std::pair<uint32_t, Key> &a, const std::pair<uint32_t, Key> &b) { return a > b; });
+
+  res->keys.push_back(key);
+  res->vals.push_back(static_cast<T>(served));
+  for (size_t i = 0; i < hot_num; i++) {
+    res->keys.push_back(hits[i].second);
+    res->vals.push_back(static_cast<T>(hits[i].first));
+  }
+  for (const auto &row : replicas) {
+    res->keys.push_back(row);
+  }
+  res->lens.push_back(static_cast<int>(hot_num));
+  res->lens.push_back(static_cast<int>(replicas.size()));
+}
+
+template <typename T>
+void ParameterServer<T>::ReplicateEmbeddingRows(const Key &key, const LookupIds &rows, const Values &vals) {
+  TableStatePtr state = nullptr;
+  size_t row_size = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (table_states_.count(key) == 0 || embedding_lookup_ops_.count(key) == 0) {
+      MS_LOG(ERROR) << "Invalid embedding table key " << key;
+      return;
+    }
+    state = table_states_[key];
+    row_size = embedding_lookup_ops_[key]->outer_dim_size();
+  }
+  MS_EXCEPTION_IF_NULL(state);
+  if (state->row_hits == nullptr) {
+    MS_LOG(ERROR) << "Rows of embedding table " << key << " are not rebalanced, set " << kEnvRebalanceInterval
+                  << " on the servers as well.";
+    return;
+  }
+  if (vals.size() != rows.size() * row_size) {
+    MS_LOG(ERROR) << "Replicated rows of embedding table " << key << " have " << vals.size() << " values, expect "
+                  << rows.size() * row_size;
+    return;
+  }
+  // The worker sends every replicated row of this server each time, rows left out are dropped
+  std::unordered_map<Key, ReplicaRow> replica_rows;
+  for (size_t i = 0; i < rows.size(); i++) {
+    auto &row = replica_rows[rows[i]];
+    row.data.assign(vals.data() + i * row_size, vals.data() + (i + 1) * row_size);
+  }
+  std::unique_lock<std::shared_mutex> table_lock(state->rw_mutex);
+  for (auto &iter : replica_rows) {
+    auto old_row = state->replica_rows.find(iter.first);
+    if (old_row != state->replica_rows.end()) {
+      iter.second.hits = old_row->second.hits.load();
+    }
+  }
+  state->replica_rows.swap(replica_rows);
+  MS_LOG(INFO) << "Server " << rank_id_ << " replicates " << state->replica_rows.size()
+               << " hot rows of embedding table " << key << ".";
+}
+
+template <typename T>
+void ParameterServer<T>::DropEmbeddingReplicas(const Key &key, const LookupIds &rows) {
+  TableStatePtr state = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (table_states_.count(key) == 0) {
+      MS_LOG(ERROR) << "Invalid embedding table key " << key;
+      return;
+    }
+    state = table_states_[key];
+  }
+  MS_EXCEPTION_IF_NULL(state);
+  // A worker is about to push these rows to their owners. Lookups of them miss here from now on and the worker
+  // looks them up on the owner, until the next rebalance replicates them again.
+  std::unique_lock<std::shared_mutex> table_lock(state->rw_mutex);
+  for (size_t i = 0; i < rows.size(); i++) {
+    (void)state->replica_rows.erase(rows[i]);
+  }
 }
 
 template <typename T>
@@ -710,6 +975,53 @@ inline std::mutex &ParameterServer<T>::mutex() {
   return mutex_;
 }
 
+template <typename T>
+void ParameterServer<T>::InitTableState(const Key &key) {
+  if (table_states_.count(key) == 0) {
+    auto state = std::make_shared<TableState>();
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    state->report_start_us = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+    table_states_[key] = state;
+  }
+}
+
+template <typename T>
+void ParameterServer<T>::RecordLookup(const Key &key, const TableStatePtr &state, size_t ids_num,
+                                      const std::chrono::steady_clock::time_point &start_time) {
+  uint64_t latency_us =
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+  state->lookup_ids += ids_num;
+  state->lookup_latency_us += latency_us;
+  uint64_t max_latency_us = state->max_lookup_latency_us.load();
+  while (latency_us > max_latency_us &&
+         !state->max_lookup_latency_us.compare_exchange_weak(max_latency_us, latency_us)) {
+  }
+  if (++state->lookup_count % kLookupStatsReportInterval == 0) {
+    ReportLookupStats(key, state.get(), false);
+  }
+}
+
+template <typename T>
+void ParameterServer<T>::ReportLookupStats(const Key &key, TableState *state, bool total) {
+  MS_EXCEPTION_IF_NULL(state);
+  int64_t now_us =
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  uint64_t count = state->lookup_count.load();
+  uint64_t avg_latency_us = count == 0 ? 0 : state->lookup_latency_us.load() / count;
+  if (total) {
+    MS_LOG(INFO) << "Embedding table " << key << " served " << count << " lookups of " << state->lookup_ids.load()
+                 << " ids, average latency " << avg_latency_us << "us, max latency "
+                 << state->max_lookup_latency_us.load() << "us.";
+    return;
+  }
+  // QPS is measured over the last report interval.
+  int64_t start_us = state->report_start_us.exchange(now_us);
+  double elapsed_s = static_cast<double>(std::max<int64_t>(now_us - start_us, 1)) / 1e6;
+  MS_LOG(INFO) << "Embedding table " << key << " lookup QPS " << kLookupStatsReportInterval / elapsed_s
+               << ", average latency " << avg_latency_us << "us, max latency " << state->max_lookup_latency_us.load()
+               << "us, total lookups " << count << ".";
+}
+
 template <typename T>
 void ParameterServer<T>::GetEmbeddingTableParamPtr() {
   MS_EXCEPTION_IF_NULL(func_graph_);
@@ -745,6 +1057,7 @@ void ParameterServer<T>::SyncEmbeddingTables() {
     float *new_tensor_data_ptr = reinterpret_cast<float *>(new_tensor->data_c());
     size_t new_tensor_size = static_cast<size_t>(new_tensor->data().nbytes());
     size_t embedding_table_size = weights_[key]->size() * sizeof(float);
+    std::shared_lock<std::shared_mutex> table_lock(table_states_[key]->rw_mutex);
     if (new_tensor_size != embedding_table_size) {
       MS_LOG(EXCEPTION) << "Shape of embedding table can't match. New tensor size:" << new_tensor_size
                         << ", embedding_table size:" << embedding_table_size;
@@ -15,6 +15,7 @@
  */
 
 #include "ps/util.h"
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include "ps/common.h"
@@ -113,6 +114,19 @@ std::string Util::optimizer_node_name(int64_t id) {
 
 bool Util::is_optimizer(std::string name) { return optimizer_to_ids.count(name) > 0; }
 
+uint64_t Util::EmbeddingRebalanceInterval() {
+  std::string interval = common::GetEnv(kEnvRebalanceInterval);
+  if (interval.empty()) {
+    return 0;
+  }
+  try {
+    return std::stoull(interval);
+  } catch (const std::exception &) {
+    MS_LOG(WARNING) << "Invalid " << kEnvRebalanceInterval << " " << interval << ", embedding rows are not rebalanced.";
+  }
+  return 0;
+}
+
 int64_t Util::LocalShard(int64_t first_dim, int64_t rank_id, int64_t server_num) {
   std::map<int64_t, int64_t> shard_dims = AllRankLocalShard(first_dim, rank_id, server_num);
   if (shard_dims.count(rank_id) == 0) {
@@ -30,6 +30,7 @@
 #include "ps/util.h"
 #include "backend/kernel_compiler/common_utils.h"
 #include "ps/ps_context.h"
+#include "ps/embedding_placement.h"
 
 namespace mindspore {
 namespace ps {
@@ -45,6 +46,7 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   explicit WorkerProxy(int64_t app_id, int64_t customer_id, int64_t lookup_customer_id, int64_t general_customer_id)
       : Worker(app_id, customer_id) {
     server_num_ = ::ps::NumServers();
+    rebalance_interval_ = Util::EmbeddingRebalanceInterval();
     PSContext::instance()->SetPSRankId(::ps::MyRank());
     using std::placeholders::_1;
     using std::placeholders::_2;
@@ -103,6 +105,15 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   void Send(::ps::Customer *customer, int64_t timestamp, bool push, bool pull, int64_t cmd, const ::ps::KVPairs<T> &kvs,
             const Slicer &slicer, std::map<int64_t, int64_t> attrs = {});
   void AddKeyByHashMod(const ::ps::Key &key);
+  std::vector<size_t> SendLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                                 ::ps::SArray<T> *outs, int64_t cmd, int64_t priority, bool owner_only);
+  void LookupMissedRows(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                        const std::vector<size_t> &missed, ::ps::SArray<T> *outs, int64_t cmd);
+  void RebalanceEmbeddingTable(const ::ps::Key &key, int64_t cmd);
+  std::map<int64_t, ::ps::KVPairs<T>> PullEmbeddingStats(const ::ps::Key &key, bool decay);
+  void ReplicateHotRows(const ::ps::Key &key, const HotRowServers &placement, int64_t cmd);
+  void DropPushedReplicas(const ::ps::Key &key, const ::ps::SArray<T> &vals, const ::ps::SArray<int> &lens,
+                          size_t indice_index);
 
   void PrepareSparseGradient(const size_t begin, const size_t end, const std::unordered_set<int> &distinct_ids,
                              const std::vector<std::pair<int, T *>> &indice_to_grad, const int *all_indice,
@@ -127,6 +138,17 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   std::unordered_map<int64_t, int64_t> expected_result_count_;
   std::unordered_map<::ps::Key, int64_t> key_to_server_id_;
   std::unordered_map<::ps::Key, size_t> embedding_row_cnt_;
+
+  // Frequency-aware placement of embedding rows, on when rebalance_interval_ is not 0. Every rebalance_interval_
+  // lookups of a table the servers report their hottest rows. Worker 0 replicates the hot rows of overloaded servers
+  // onto the least loaded ones, the other workers take the placement from the reports. A push drops the replicas
+  // of the rows it updates, so lookups never read a row older than the owner's.
+  uint64_t rebalance_interval_;
+  std::unordered_map<::ps::Key, uint64_t> lookup_count_;
+  std::unordered_map<::ps::Key, size_t> embedding_row_len_;
+  std::unordered_map<::ps::Key, HotRowServers> hot_row_servers_;
+  // Positions of the ids that no server returned, per lookup request
+  std::unordered_map<int64_t, std::vector<size_t>> lookup_misses_;
 };
 
 template <typename T>
@@ -169,17 +191,239 @@ template <typename T>
 void WorkerProxy<T>::EmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
                                      const ::ps::SArray<int> &lens, ::ps::SArray<T> *outs, int64_t cmd,
                                      const Callback &cb, int64_t priority) {
-  int64_t ts = AddLookupCB(keys, lookup_ids, outs, cmd, cb);
+  MS_EXCEPTION_IF_NULL(outs);
+  std::vector<size_t> missed = SendLookup(keys, lookup_ids, outs, cmd, priority, false);
+  const Key &key = keys[0];
+  if (!missed.empty() && hot_row_servers_.count(key) > 0) {
+    LookupMissedRows(keys, lookup_ids, missed, outs, cmd);
+  }
+  if (cb) {
+    cb();
+  }
+  if (rebalance_interval_ > 0 && !lookup_ids.empty()) {
+    embedding_row_len_[key] = outs->size() / lookup_ids.size();
+    if (++lookup_count_[key] % rebalance_interval_ == 0) {
+      RebalanceEmbeddingTable(key, cmd);
+    }
+  }
+}
+
+template <typename T>
+std::vector<size_t> WorkerProxy<T>::SendLookup(const ::ps::SArray<::ps::Key> &keys,
+                                               const ::ps::SArray<int> &lookup_ids, ::ps::SArray<T> *outs,
+                                               int64_t cmd, int64_t priority, bool owner_only) {
+  int64_t ts = AddLookupCB(keys, lookup_ids, outs, cmd, nullptr);
   ::ps::KVPairs<T> kvs;
   kvs.keys = keys;
   kvs.lens = lookup_ids;
   kvs.priority = priority;
   expected_result_count_[ts] = 0;
-  Send(lookup_customer_.get(), ts, true, true, cmd, kvs, lookup_slicer_);
+  std::map<int64_t, int64_t> attrs;
+  if (owner_only) {
+    attrs[0] = 1;
+  }
+  Send(lookup_customer_.get(), ts, true, true, cmd, kvs, lookup_slicer_, attrs);
   int64_t expect_rt_count = expected_result_count_[ts];
   lookup_customer_->AddResponse(ts, server_num_ - expect_rt_count);
   lookup_customer_->WaitRequest(ts);
   expected_result_count_.erase(ts);
+
+  std::vector<size_t> missed;
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto iter = lookup_misses_.find(ts);
+  if (iter != lookup_misses_.end()) {
+    missed.swap(iter->second);
+    lookup_misses_.erase(iter);
+  }
+  return missed;
+}
+
+template <typename T>
+void WorkerProxy<T>::LookupMissedRows(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                                      const std::vector<size_t> &missed, ::ps::SArray<T> *outs, int64_t cmd) {
+  // A replica may have dropped a row after worker 0 placed it elsewhere, such rows are looked up on their owner.
+  // Ids outside of the table are missed by every server and stay as they are.
+  size_t row_len = outs->size() / lookup_ids.size();
+  size_t row_cnt = embedding_row_cnt_[keys[0]];
+  std::vector<size_t> positions;
+  ::ps::SArray<int> missed_ids;
+  for (auto pos : missed) {
+    if (lookup_ids[pos] >= 0 && static_cast<size_t>(lookup_ids[pos]) < row_cnt) {
+      positions.push_back(pos);
+      missed_ids.push_back(lookup_ids[pos]);
+    }
+  }
+  if (positions.empty()) {
+    return;
+  }
+  ::ps::SArray<T> missed_rows(positions.size() * row_len, 0);
+  (void)SendLookup(keys, missed_ids, &missed_rows, cmd, 0, true);
+  size_t row_bytes = row_len * sizeof(T);
+  for (size_t i = 0; i < positions.size(); i++) {
+    auto ret = memcpy_s(outs->data() + positions[i] * row_len, row_bytes, missed_rows.data() + i * row_len, row_bytes);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+    }
+  }
+}
+
+template <typename T>
+void WorkerProxy<T>::RebalanceEmbeddingTable(const ::ps::Key &key, int64_t cmd) {
+  bool place = ::ps::MyRank() == 0;
+  std::map<int64_t, ::ps::KVPairs<T>> stats = PullEmbeddingStats(key, place);
+  const std::vector<::ps::Range> &ranges = *(embedding_table_ranges_[key]);
+  HotRowServers placement;
+  if (place) {
+    placement = EmbeddingPlacement::PlaceHotRows(ranges, stats, hot_row_servers_[key]);
+    MS_LOG(INFO) << "Embedding table " << key << " replicates " << placement.size() << " hot rows.";
+    // The replicas get their rows before any lookup is sent to them
+    ReplicateHotRows(key, placement, cmd);
+  } else {
+    for (const auto &server_stats : stats) {
+      const ::ps::KVPairs<T> &kvs = server_stats.second;
+      size_t hot_num = static_cast<size_t>(kvs.lens[0]);
+      for (size_t i = 1 + hot_num; i < kvs.keys.size(); i++) {
+        int64_t owner = EmbeddingPlacement::RowServer(ranges, kvs.keys[i]);
+        if (owner < 0 || owner == server_stats.first) {
+          continue;
+        }
+        auto &servers = placement[kvs.keys[i]];
+        if (servers.empty()) {
+          servers.push_back(owner);
+        }
+        servers.push_back(server_stats.first);
+      }
+    }
+  }
+  if (placement.empty()) {
+    hot_row_servers_.erase(key);
+  } else {
+    hot_row_servers_[key] = std::move(placement);
+  }
+}
+
+template <typename T>
+std::map<int64_t, ::ps::KVPairs<T>> WorkerProxy<T>::PullEmbeddingStats(const ::ps::Key &key, bool decay) {
+  std::map<int64_t, ::ps::KVPairs<T>> stats;
+  int64_t ts = general_customer_->NewRequest(::ps::kServerGroup);
+  general_callbacks_[ts] = [this, ts, &stats]() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stats.swap(gathered_response_[ts]);
+    gathered_response_.erase(ts);
+  };
+  ::ps::KVPairs<T> kvs;
+  kvs.keys.push_back(key);
+  kvs.vals.push_back(decay ? 1 : 0);
+  Send(general_customer_.get(), ts, false, true, kEmbeddingStatsCmd, kvs, broadcast_slicer_);
+  general_customer_->WaitRequest(ts);
+  expected_result_count_.erase(ts);
+
+  for (auto iter = stats.begin(); iter != stats.end();) {
+    const ::ps::KVPairs<T> &server_kvs = iter->second;
+    const ::ps::SArray<int> &lens = server_kvs.lens;
+    if (lens.size() != 2 || lens[0] < 0 || lens[1] < 0 || server_kvs.keys.size() != 1 + IntToSize(lens[0] + lens[1]) ||
+        server_kvs.vals.size() != 1 + IntToSize(lens[0])) {
+      MS_LOG(WARNING) << "Invalid embedding stats of table " << key << " from server " << iter->first;
+      iter = stats.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+  return stats;
+}
+
+template <typename T>
+void WorkerProxy<T>::ReplicateHotRows(const ::ps::Key &key, const HotRowServers &placement, int64_t cmd) {
+  // Replicas are copied from their owners, every push drops the replicas of its rows until this runs again
+  ::ps::SArray<int> rows;
+  for (const auto &row : placement) {
+    rows.push_back(static_cast<int>(row.first));
+  }
+  size_t row_len = embedding_row_len_[key];
+  ::ps::SArray<T> values(rows.size() * row_len, 0);
+  if (!rows.empty()) {
+    (void)SendLookup({key}, rows, &values, cmd, 0, true);
+  }
+
+  std::vector<::ps::KVPairs<T>> server_kvs(server_num_);
+  for (auto &kvs : server_kvs) {
+    kvs.keys.push_back(key);
+  }
+  for (size_t i = 0; i < rows.size(); i++) {
+    const auto &servers = placement.at(static_cast<Key>(rows[i]));
+    for (size_t j = 1; j < servers.size(); j++) {
+      auto &kvs = server_kvs[servers[j]];
+      kvs.keys.push_back(rows[i]);
+      for (size_t k = 0; k < row_len; k++) {
+        kvs.vals.push_back(values[i * row_len + k]);
+      }
+    }
+  }
+  // Every server gets its rows, an empty list drops the replicas it had
+  Slicer replica_slicer = [this, &server_kvs](int64_t timestamp, const ::ps::KVPairs<T> &,
+                                              const std::vector<::ps::Range> &, SlicedKVs *sliced,
+                                              const std::map<int64_t, int64_t> &) {
+    sliced->resize(server_num_);
+    for (int64_t i = 0; i < server_num_; i++) {
+      sliced->at(i).first = true;
+      sliced->at(i).second = server_kvs[i];
+      expected_result_count_[timestamp] += 1;
+    }
+  };
+  int64_t ts = general_customer_->NewRequest(::ps::kServerGroup);
+  ::ps::KVPairs<T> kvs;
+  kvs.keys.push_back(key);
+  Send(general_customer_.get(), ts, true, false, kReplicateEmbeddingRowsCmd, kvs, replica_slicer);
+  general_customer_->WaitRequest(ts);
+  expected_result_count_.erase(ts);
+}
+
+template <typename T>
+void WorkerProxy<T>::DropPushedReplicas(const ::ps::Key &key, const ::ps::SArray<T> &vals,
+                                        const ::ps::SArray<int> &lens, size_t indice_index) {
+  int64_t indice_offset = 0;
+  for (size_t i = 0; i < indice_index; i++) {
+    indice_offset += lens[i];
+  }
+  const int *indice_data = reinterpret_cast<const int *>(vals.data()) + indice_offset;
+  // This worker looks the pushed rows up on their owners from now on, the others miss on the replicas and retry there
+  std::vector<std::vector<Key>> server_rows = EmbeddingPlacement::DropPushedRows(
+    indice_data, IntToSize(lens[indice_index]), LongToSize(server_num_), &hot_row_servers_[key]);
+  if (hot_row_servers_[key].empty()) {
+    hot_row_servers_.erase(key);
+  }
+  if (std::all_of(server_rows.begin(), server_rows.end(), [](const std::vector<Key> &rows) { return rows.empty(); })) {
+    return;
+  }
+
+  Slicer drop_slicer = [this, key, &server_rows](int64_t timestamp, const ::ps::KVPairs<T> &,
+                                                 const std::vector<::ps::Range> &, SlicedKVs *sliced,
+                                                 const std::map<int64_t, int64_t> &) {
+    sliced->resize(server_num_);
+    for (int64_t i = 0; i < server_num_; i++) {
+      if (server_rows[i].empty()) {
+        sliced->at(i).first = false;
+        continue;
+      }
+      auto &kvs = sliced->at(i).second;
+      kvs.keys.push_back(key);
+      for (auto row : server_rows[i]) {
+        kvs.keys.push_back(row);
+      }
+      sliced->at(i).first = true;
+      expected_result_count_[timestamp] += 1;
+    }
+  };
+  // The replicas are gone before the push reaches the owners, so no lookup sees a replica older than its owner
+  int64_t ts = general_customer_->NewRequest(::ps::kServerGroup);
+  ::ps::KVPairs<T> kvs;
+  kvs.keys.push_back(key);
+  Send(general_customer_.get(), ts, true, false, kDropEmbeddingReplicasCmd, kvs, drop_slicer);
+  if (expected_result_count_[ts] < server_num_) {
+    general_customer_->AddResponse(ts, server_num_ - expected_result_count_[ts]);
+  }
+  general_customer_->WaitRequest(ts);
+  expected_result_count_.erase(ts);
 }
 
 template <typename T>
@@ -252,6 +496,9 @@ void WorkerProxy<T>::PushSparseData(const ::ps::SArray<::ps::Key> &keys, const :
   kvs.lens = lens;
   const int64_t cmd = 0;
   if (embedding_table_ranges_.count(keys[0])) {
+    if (hot_row_servers_.count(keys[0]) > 0) {
+      DropPushedReplicas(keys[0], vals, lens, indice_index);
+    }
     std::map<int64_t, int64_t> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
     Send(general_customer_.get(), ts, true, false, cmd, kvs, sparse_slicer_, attrs);
   } else {
@@ -304,52 +551,13 @@ int64_t WorkerProxy<T>::AddLookupCB(const ::ps::SArray<::ps::Key> &keys, const :
     auto &kvs = lookup_results_[ts];
     mutex_.unlock();
 
-    if (lookup_ids.empty()) {
-      MS_LOG(EXCEPTION) << "Lookup id is empty.";
-    }
-    int64_t single_id_len = SizeToLong(lookup_result->size() / lookup_ids.size());
-    std::unordered_map<Key, std::shared_ptr<std::pair<T *, int64_t>>> id_addr_map;
-    for (const auto &s : kvs) {
-      int64_t offset = 0;
-      for (size_t i = 0; i < s.keys.size(); i++) {
-        const Key &key = s.keys[i];
-        T *addr = s.vals.data() + offset;
-        offset += single_id_len;
-        id_addr_map[key] = std::make_shared<std::pair<T *, int64_t>>(std::make_pair(addr, single_id_len));
-        MS_EXCEPTION_IF_NULL(id_addr_map[key]);
-      }
-    }
-
-    T *result_addr = lookup_result->data();
-    MS_EXCEPTION_IF_NULL(result_addr);
-    int64_t offset = 0;
-    size_t dst_size = 0;
-    size_t src_size = 0;
-    void *dst_data = nullptr;
-    void *src_data = nullptr;
-    for (size_t i = 0; i < lookup_ids.size(); i++) {
-      if (id_addr_map.count(lookup_ids[i]) == 0) {
-        offset += single_id_len;
-        continue;
-      }
-      auto &pair = id_addr_map[static_cast<Key>(lookup_ids[i])];
-      int64_t size = single_id_len * sizeof(T);
-      dst_size = size;
-      src_size = size;
-      dst_data = result_addr + offset;
-      src_data = pair->first;
-      MS_EXCEPTION_IF_NULL(dst_data);
-      MS_EXCEPTION_IF_NULL(src_data);
-      auto ret = memcpy_s(dst_data, dst_size, src_data, src_size);
-      if (ret != 0) {
-        MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
-        return;
-      }
-      offset += single_id_len;
-    }
+    std::vector<size_t> missed = EmbeddingPlacement::GatherLookupResult(lookup_ids, kvs, lookup_result);
 
     mutex_.lock();
     lookup_results_.erase(ts);
+    if (!missed.empty()) {
+      lookup_misses_[ts] = std::move(missed);
+    }
     mutex_.unlock();
     if (cb) cb();
   };
@@ -400,30 +608,29 @@ void WorkerProxy<T>::LookupIdSlicer(int64_t timestamp, const ::ps::KVPairs<T> &s
   const Key &key = send.keys[0];
   const std::vector<::ps::Range> &ranges = *(embedding_table_ranges_[key]);
   sliced->resize(ranges.size());
-
   for (size_t i = 0; i < ranges.size(); i++) {
-    const ::ps::Range &range = ranges[i];
-    const auto &begin = range.begin();
-    const auto &end = range.end();
-    std::unordered_set<int64_t> unique_ids;
     auto &kvs = sliced->at(i).second;
-
     kvs.keys.push_back(key);
     kvs.vals.push_back(0.0f);
+  }
 
-    for (size_t j = 0; j < id_size; j++) {
-      auto lookup_id = static_cast<uint64_t>(lookup_ids[j]);
-      // If lookup_id is out of range, like negative number, unique_ids will not contain it.
-      // Servers always get lookup_ids in its embedding table range.
-      if (lookup_id >= begin && lookup_id <= end) {
-        unique_ids.insert(lookup_id);
-      }
-    }
-    for (const auto &lookup_id : unique_ids) {
+  // attrs[0] sends every id to the owner of its range, otherwise a replicated hot row goes to its servers in turn
+  const HotRowServers *hot_rows = nullptr;
+  auto hot_iter = hot_row_servers_.find(key);
+  if (attrs.count(0) == 0 && hot_iter != hot_row_servers_.end()) {
+    hot_rows = &hot_iter->second;
+  }
+  auto server_ids = EmbeddingPlacement::SliceLookupIds(lookup_ids, id_size, ranges, hot_rows, timestamp);
+  for (size_t i = 0; i < ranges.size(); i++) {
+    auto &kvs = sliced->at(i).second;
+    for (auto lookup_id : server_ids[i]) {
       kvs.keys.push_back(lookup_id);
       kvs.vals.push_back(0.0f);
     }
+  }
 
+  for (size_t i = 0; i < ranges.size(); i++) {
+    auto &kvs = sliced->at(i).second;
     if (kvs.keys.size() <= 1) {
       sliced->at(i).first = false;
     } else {
@@ -727,8 +934,8 @@ void WorkerProxy<T>::WorkerInitEmbeddingSlicer(int64_t timestamp, const ::ps::KV
 template <typename T>
 void WorkerProxy<T>::ProcessLookupResult(const ::ps::Message &msg) {
   int64_t ts = msg.meta.timestamp;
-  if (msg.meta.pull) {
-    CHECK_GE(msg.data.size(), (size_t)2);
+  // A server that holds none of the rows it was asked for replies without data, the rows are looked up again
+  if (msg.meta.pull && msg.data.size() >= (size_t)2) {
     ::ps::KVPairs<T> kvs;
     kvs.keys = msg.data[0];
     kvs.vals = msg.data[1];
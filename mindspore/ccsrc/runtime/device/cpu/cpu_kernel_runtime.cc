@@ -22,11 +22,15 @@
 #include <algorithm>
 #include <functional>
 #include "backend/kernel_compiler/kernel.h"
+#include "backend/kernel_compiler/cpu/sparse_optimizer_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "utils/ms_context.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/session/session_basic.h"
 #include "frontend/operator/ops.h"
+#include "profiler/device/cpu/cpu_profiling.h"
+#include "pybind_api/ir/primitive_py.h"
+#include "utils/checkpoint/dirty_row_tracker.h"
 #include "utils/shape_utils.h"
 #include "utils/profile.h"
 #include "utils/trace_base.h"
@@ -35,6 +39,67 @@ namespace mindspore {
 namespace device {
 namespace cpu {
 const size_t INIT_NODE_REF = 1;
+namespace {
+// Records the launch of a kernel with the shapes of its inputs and the bytes it reads and writes. The event also ends
+// when the kernel throws, CPUProfiler::Stop waits for the events in flight
+class ProfileOpScope {
+ public:
+  ProfileOpScope(const CNodePtr &kernel, const std::vector<kernel::AddressPtr> &inputs,
+                 const std::vector<kernel::AddressPtr> &outputs)
+      : profiler_(profiler::cpu::CPUProfiler::GetInstance()) {
+    MS_EXCEPTION_IF_NULL(profiler_);
+    profiling_ = profiler_->GetEnableFlag();
+    if (!profiling_) {
+      return;
+    }
+    std::vector<std::vector<size_t>> input_shapes;
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      input_shapes.push_back(AnfAlgo::GetPrevNodeOutputInferShape(kernel, i));
+    }
+    uint64_t bytes = 0;
+    for (const auto &address : inputs) {
+      bytes += address->size;
+    }
+    for (const auto &address : outputs) {
+      bytes += address->size;
+    }
+    profiler_->OpDataProducerBegin(kernel->fullname_with_scope(), input_shapes, bytes);
+  }
+
+  ~ProfileOpScope() {
+    if (profiling_) {
+      profiler_->OpDataProducerEnd();
+    }
+  }
+
+ private:
+  std::shared_ptr<profiler::cpu::CPUProfiler> profiler_;
+  bool profiling_{false};
+  DISABLE_COPY_AND_ASSIGN(ProfileOpScope)
+};
+
+// The sparse optimizers mark the rows they update for a delta checkpoint, any other kernel writing to an input in
+// place changes it as a whole
+void MarkWrittenInputs(const CNodePtr &kernel, const kernel::KernelMod *kernel_mod,
+                       const std::vector<kernel::AddressPtr> &inputs) {
+  auto &tracker = checkpoint::DirtyRowTracker::GetInstance();
+  if (!tracker.enabled() || dynamic_cast<const kernel::SparseOptimizerCPUKernel *>(kernel_mod) != nullptr) {
+    return;
+  }
+  auto prim = AnfAlgo::GetCNodePrimitive(kernel);
+  if (prim == nullptr || !prim->isa<PrimitivePy>()) {
+    return;
+  }
+  const auto &signatures = prim->cast<PrimitivePyPtr>()->signatures();
+  for (size_t i = 0; i < signatures.size() && i < inputs.size(); ++i) {
+    if (signatures[i].rw == SignatureEnumRW::kRWWrite) {
+      tracker.MarkAll(inputs[i]->addr);
+    }
+  }
+}
+}  // namespace
+
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
@@ -314,6 +379,148 @@ void CPUKernelRuntime::BindInputOutput(session::KernelGraph *kernel_graph, const
   BindOutputTensorAddressPtr(outputs);
 }
 
+CPULaunchPlanPtr CPUKernelRuntime::CreateLaunchPlan(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto &kernels = kernel_graph->execution_order();
+  if (kernels.size() != 1 || AnfAlgo::IsDynamicShape(kernels[0])) {
+    return nullptr;
+  }
+  auto plan = std::make_shared<CPULaunchPlan>();
+  plan->kernel = kernels[0];
+  plan->kernel_mod = AnfAlgo::GetKernelMod(plan->kernel);
+  MS_EXCEPTION_IF_NULL(plan->kernel_mod);
+  auto &input_nodes = kernel_graph->inputs();
+  plan->num_input_tensors = input_nodes.size();
+
+  size_t input_num = AnfAlgo::GetInputTensorNum(plan->kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto input = AnfAlgo::GetPrevNodeOutput(plan->kernel, i);
+    auto address = AnfAlgo::GetMutableOutputAddr(input.first, input.second);
+    MS_EXCEPTION_IF_NULL(address);
+    int64_t tensor_index = -1;
+    if (input.first->isa<Parameter>()) {
+      auto iter = std::find(input_nodes.begin(), input_nodes.end(), input.first);
+      if (iter == input_nodes.end() || input.first->cast<ParameterPtr>()->is_used_by_dynamic_kernel()) {
+        return nullptr;
+      }
+      tensor_index = iter - input_nodes.begin();
+    } else if (!input.first->isa<ValueNode>() || address->ptr_ == nullptr) {
+      return nullptr;
+    }
+    plan->input_slots.push_back({tensor_index, address});
+    auto kernel_input = std::make_shared<kernel::Address>();
+    kernel_input->addr = address->ptr_;
+    kernel_input->size = address->size_;
+    plan->inputs.push_back(kernel_input);
+  }
+
+  auto output_sizes = plan->kernel_mod->GetOutputSizeList();
+  std::vector<bool> graph_output(output_sizes.size(), false);
+  for (const auto &item : kernel_graph->outputs()) {
+    auto item_with_index = AnfAlgo::VisitKernelWithReturnType(item, 0, true);
+    auto &node = item_with_index.first;
+    auto index = item_with_index.second;
+    if (node != plan->kernel || index >= output_sizes.size() ||
+        kernel_graph->IsInternalOutput(node, SizeToInt(index))) {
+      return nullptr;
+    }
+    TypeId type = AnfAlgo::GetOutputInferDataType(node, index);
+    if (type != AnfAlgo::GetOutputDeviceDataType(node, index)) {
+      return nullptr;
+    }
+    auto shape = AnfAlgo::GetOutputInferShape(node, index);
+    ShapeVector tensor_shape(shape.begin(), shape.end());
+    size_t tensor_size =
+      std::accumulate(shape.begin(), shape.end(), GetTypeByte(TypeIdToType(type)), std::multiplies<size_t>());
+    if (tensor_size != output_sizes[index]) {
+      return nullptr;
+    }
+    plan->output_slots.push_back({index, type, tensor_shape, AnfAlgo::GetOutputFormat(node, index)});
+    graph_output[index] = true;
+  }
+
+  // Outputs that are not graph outputs and workspaces keep memory of their own across launches
+  auto new_address = [this, &plan](size_t size, bool allocate) {
+    auto address = std::make_shared<kernel::Address>();
+    address->addr = nullptr;
+    if (allocate && size > 0) {
+      address->addr = resource_manager_.MemMalloc(size);
+      plan->private_memory.push_back(address->addr);
+    }
+    address->size = size;
+    return address;
+  };
+  for (size_t i = 0; i < output_sizes.size(); ++i) {
+    plan->outputs.push_back(new_address(output_sizes[i], !graph_output[i]));
+  }
+  for (auto size : plan->kernel_mod->GetWorkspaceSizeList()) {
+    plan->workspaces.push_back(new_address(size, true));
+  }
+  return plan;
+}
+
+bool CPUKernelRuntime::RunLaunchPlan(CPULaunchPlan *plan, const std::vector<tensor::TensorPtr> &inputs,
+                                     VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(plan);
+  MS_EXCEPTION_IF_NULL(outputs);
+  if (inputs.size() != plan->num_input_tensors) {
+    return false;
+  }
+  for (const auto &slot : plan->input_slots) {
+    if (slot.tensor_index < 0) {
+      continue;
+    }
+    auto &tensor = inputs[slot.tensor_index];
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (GetTypeByte(TypeIdToType(tensor->data_type())) != GetTypeByte(TypeIdToType(slot.address->type_id_)) ||
+        LongToSize(tensor->data().nbytes()) != slot.address->size_) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < plan->input_slots.size(); ++i) {
+    const auto &slot = plan->input_slots[i];
+    if (slot.tensor_index < 0) {
+      plan->inputs[i]->addr = slot.address->ptr_;
+      continue;
+    }
+    auto &tensor = inputs[slot.tensor_index];
+    auto tensor_address = std::dynamic_pointer_cast<device::DeviceAddress>(tensor->device_address());
+    if (tensor_address != nullptr && tensor_address->DeviceType() != DeviceAddressType::kCPU) {
+      tensor->data_sync(false);
+    }
+    plan->inputs[i]->addr = tensor->data_c();
+  }
+  for (const auto &slot : plan->output_slots) {
+    auto tensor = std::make_shared<tensor::Tensor>(slot.type, slot.shape);
+    auto &output = plan->outputs[slot.kernel_output];
+    output->addr = tensor->data_c();
+    tensor->set_device_address(CreateDeviceAddress(output->addr, output->size, slot.format, slot.type));
+    tensor->set_sync_status(kNoNeedSync);
+    tensor->SetIsGraphOutput();
+    outputs->push_back(tensor);
+  }
+
+  {
+    ProfileOpScope profile_op(plan->kernel, plan->inputs, plan->outputs);
+    if (!plan->kernel_mod->Launch(plan->inputs, plan->workspaces, plan->outputs, 0)) {
+      MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(plan->kernel);
+    }
+  }
+  MarkWrittenInputs(plan->kernel, plan->kernel_mod, plan->inputs);
+  return true;
+}
+
+void CPUKernelRuntime::ReleaseLaunchPlan(CPULaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  for (auto ptr : plan->private_memory) {
+    resource_manager_.MemFree(ptr);
+  }
+  plan->private_memory.clear();
+  plan->workspaces.clear();
+  plan->outputs.clear();
+}
+
 void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list) {
   MS_EXCEPTION_IF_NULL(address);
   MS_EXCEPTION_IF_NULL(input_list);
@@ -370,7 +577,12 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_workspaces);
     }
-    auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+    bool ret = false;
+    {
+      ProfileOpScope profile_op(kernel, kernel_inputs, kernel_outputs);
+      ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+    }
+    MarkWrittenInputs(kernel, kernel_mod, kernel_inputs);
     resource_manager_.DecreaseAddressRefCount(kernel);
     if (!ret) {
       MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
@@ -30,6 +30,32 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// A graph of one kernel prepared to be launched again with tensors of the same shapes and types. The address lists
+// of the launch are built once, a launch only points them at the data of its tensors
+struct CPULaunchPlan {
+  struct InputSlot {
+    int64_t tensor_index;      // Position in the input tensors of the graph, -1 for a value node
+    DeviceAddressPtr address;  // The address of the value node or the parameter
+  };
+  struct OutputSlot {
+    size_t kernel_output;  // Output index of the kernel
+    TypeId type;
+    ShapeVector shape;
+    std::string format;
+  };
+  CNodePtr kernel;
+  kernel::KernelMod *kernel_mod{nullptr};
+  size_t num_input_tensors{0};
+  std::vector<InputSlot> input_slots;    // Per kernel input
+  std::vector<OutputSlot> output_slots;  // Per graph output
+  std::vector<kernel::AddressPtr> inputs;
+  std::vector<kernel::AddressPtr> workspaces;
+  std::vector<kernel::AddressPtr> outputs;
+  // Memory of the plan's own for workspaces and outputs that are not graph outputs, freed by ReleaseLaunchPlan
+  std::vector<void *> private_memory;
+};
+using CPULaunchPlanPtr = std::shared_ptr<CPULaunchPlan>;
+
 class CPUKernelRuntime : public KernelRuntime {
  public:
   CPUKernelRuntime() = default;
@@ -42,6 +68,12 @@ class CPUKernelRuntime : public KernelRuntime {
                            VectorRef *outputs, std::map<tensor::TensorPtr, session::KernelWithIndex> *tensor_to_node);
   void BindInputOutput(session::KernelGraph *kernel_graph, const std::vector<tensor::TensorPtr> &inputs,
                        VectorRef *outputs);
+  // Prepare a graph that has run once for launching again, nullptr when it is not a static graph of one kernel
+  CPULaunchPlanPtr CreateLaunchPlan(const session::KernelGraph *kernel_graph);
+  // Launch a prepared graph, false without launching when the inputs do not fit the plan
+  bool RunLaunchPlan(CPULaunchPlan *plan, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs);
+  // Free the memory of a plan that is evicted
+  void ReleaseLaunchPlan(CPULaunchPlan *plan);
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   bool GenDynamicKernel(const session::KernelGraph *graph) override { return true; }
@@ -14,60 +14,160 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <utility>
 #include "backend/session/anf_runtime_algorithm.h"
+#include "frontend/operator/ops.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
-  MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+namespace {
+constexpr size_t kMemAlignSize = 32;
+size_t GetAlignSize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+}  // namespace
+
+void CPUSimpleMemPlan::AddPlanBlock(DeviceAddress *address, size_t step) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->ptr_ != nullptr) {
+    return;
+  }
+  auto iter = block_index_.find(address);
+  if (iter != block_index_.end()) {
+    auto &block = blocks_[iter->second];
+    block.start = std::min(block.start, step);
+    block.end = std::max(block.end, step);
+    return;
+  }
+  MemPlanBlock block;
+  block.address = address;
+  block.size = GetAlignSize(address->size_);
+  block.start = step;
+  block.end = step;
+  block_index_[address] = blocks_.size();
+  blocks_.push_back(block);
+  naive_mem_size_ += block.size;
+}
+
+void CPUSimpleMemPlan::MarkOutputBlock(const session::KernelWithIndex &kernel_with_index, size_t last_step) {
+  auto &node = kernel_with_index.first;
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>()) {
+    return;
+  }
+  if (AnfAlgo::GetCNodeName(node) == prim::kPrimMakeTuple->name()) {
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      MarkOutputBlock(AnfAlgo::VisitKernelWithReturnType(cnode->input(i), 0), last_step);
     }
+    return;
+  }
+  if (!AnfAlgo::OutputAddrExist(node, kernel_with_index.second)) {
+    return;
+  }
+  auto address = AnfAlgo::GetMutableOutputAddr(node, kernel_with_index.second);
+  MS_EXCEPTION_IF_NULL(address);
+  auto iter = block_index_.find(address.get());
+  if (iter != block_index_.end()) {
+    blocks_[iter->second].end = last_step;
+  }
+}
 
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+void CPUSimpleMemPlan::MarkGraphOutputs(const session::KernelGraph *graph, size_t last_step) {
+  // Graph outputs and summary nodes are read after the whole graph has run, so they must not be reused.
+  for (const auto &output : graph->outputs()) {
+    MarkOutputBlock(AnfAlgo::VisitKernelWithReturnType(output, 0, true), last_step);
+  }
+  for (const auto &summary : graph->summary_nodes()) {
+    MarkOutputBlock(AnfAlgo::VisitKernelWithReturnType(summary.second.first, summary.second.second), last_step);
+  }
+}
+
+size_t CPUSimpleMemPlan::AssignOffsets(std::vector<MemPlanBlock> *blocks) {
+  MS_EXCEPTION_IF_NULL(blocks);
+  // Sweep the execution order like the best fit reuse of the device runtimes: at each step release the blocks whose
+  // lifetime has ended, then give the blocks starting there, largest first, the smallest free range that fits them
+  // or grow the top. Free ranges are merged with their neighbours, so each block costs O(log n).
+  std::vector<size_t> order(blocks->size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [blocks](size_t lhs, size_t rhs) {
+    const auto &left = (*blocks)[lhs];
+    const auto &right = (*blocks)[rhs];
+    return left.start < right.start || (left.start == right.start && left.size > right.size);
+  });
+  std::priority_queue<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>,
+                      std::greater<std::pair<size_t, size_t>>>
+    live_blocks;
+  std::map<size_t, size_t> free_by_offset;
+  std::set<std::pair<size_t, size_t>> free_by_size;
+  size_t top = 0;
+  size_t peak_size = 0;
+  auto release = [&free_by_offset, &free_by_size, &top](size_t offset, size_t size) {
+    auto next = free_by_offset.lower_bound(offset);
+    if (next != free_by_offset.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == offset) {
+        offset = prev->first;
+        size += prev->second;
+        free_by_size.erase({prev->second, prev->first});
+        free_by_offset.erase(prev);
       }
     }
-
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+    if (next != free_by_offset.end() && offset + size == next->first) {
+      size += next->second;
+      free_by_size.erase({next->second, next->first});
+      free_by_offset.erase(next);
+    }
+    if (offset + size == top) {
+      top = offset;
+      return;
+    }
+    free_by_offset[offset] = size;
+    free_by_size.emplace(size, offset);
+  };
+  for (auto index : order) {
+    auto &block = (*blocks)[index];
+    while (!live_blocks.empty() && live_blocks.top().first < block.start) {
+      const auto &ended = (*blocks)[live_blocks.top().second];
+      release(ended.offset, ended.size);
+      live_blocks.pop();
+    }
+    auto fit = free_by_size.lower_bound({block.size, 0});
+    if (fit != free_by_size.end()) {
+      size_t free_size = fit->first;
+      block.offset = fit->second;
+      free_by_size.erase(fit);
+      free_by_offset.erase(block.offset);
+      if (free_size > block.size) {
+        free_by_offset[block.offset + block.size] = free_size - block.size;
+        free_by_size.emplace(free_size - block.size, block.offset + block.size);
       }
+    } else {
+      block.offset = top;
+      top += block.size;
+      peak_size = std::max(peak_size, top);
     }
+    live_blocks.emplace(block.end, index);
   }
-
-  return total_mem_size;
+  return peak_size;
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
+  planned_graph_ = graph;
+  blocks_.clear();
+  block_index_.clear();
+  naive_mem_size_ = 0;
+  planned_mem_size_ = 0;
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  size_t last_step = kernels.empty() ? 0 : kernels.size() - 1;
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    auto &kernel = kernels[step];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -78,20 +178,19 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
       }
       auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
       MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+      if (address->ptr_ == nullptr && block_index_.find(address.get()) == block_index_.end()) {
+        // Produced outside of this execution order, keep it alive for the whole graph.
+        AddPlanBlock(address.get(), 0);
+        AddPlanBlock(address.get(), last_step);
       }
+      AddPlanBlock(address.get(), step);
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
       auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      AddPlanBlock(address.get(), step);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
@@ -99,12 +198,32 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
       auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      AddPlanBlock(address, step);
+    }
+  }
+  MarkGraphOutputs(graph, last_step);
+
+  planned_mem_size_ = std::max(AssignOffsets(&blocks_), kMemAlignSize);
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " cpu memory plan: " << blocks_.size()
+               << " blocks, naive size " << naive_mem_size_ << ", planned peak size " << planned_mem_size_;
+  return planned_mem_size_;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  if (graph != planned_graph_) {
+    (void)MemPlan(graph);
+  }
+  for (const auto &block : blocks_) {
+    MS_EXCEPTION_IF_NULL(block.address);
+    if (block.address->ptr_ == nullptr) {
+      block.address->ptr_ = base_ptr + block.offset;
     }
   }
+  planned_graph_ = nullptr;
+  blocks_.clear();
+  block_index_.clear();
 }
 }  // namespace cpu
 }  // namespace device
@@ -17,19 +17,47 @@
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
 #include <vector>
+#include <map>
+#include "backend/session/anf_runtime_algorithm.h"
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// Memory block that still needs an address, alive from the kernel at step `start` to the kernel at step `end`
+// (both inclusive) of the graph execution order.
+struct MemPlanBlock {
+  DeviceAddress *address{nullptr};
+  size_t size{0};
+  size_t offset{0};
+  size_t start{0};
+  size_t end{0};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
   ~CPUSimpleMemPlan() = default;
 
+  // Plan the offsets of all kernel outputs and workspaces by their lifetime and return the peak memory size.
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  size_t naive_mem_size() const { return naive_mem_size_; }
+  size_t planned_mem_size() const { return planned_mem_size_; }
+  // Set the offsets of the blocks so that blocks alive at the same step do not overlap, return the peak size.
+  static size_t AssignOffsets(std::vector<MemPlanBlock> *blocks);
+
+ private:
+  void AddPlanBlock(DeviceAddress *address, size_t step);
+  void MarkGraphOutputs(const session::KernelGraph *graph, size_t last_step);
+  void MarkOutputBlock(const session::KernelWithIndex &kernel_with_index, size_t last_step);
+
+  const session::KernelGraph *planned_graph_{nullptr};
+  std::vector<MemPlanBlock> blocks_;
+  std::map<DeviceAddress *, size_t> block_index_;
+  size_t naive_mem_size_{0};
+  size_t planned_mem_size_{0};
 };
 }  // namespace cpu
 }  // namespace device
@@ -135,10 +135,7 @@ bool KernelRuntime::DumpDataEnabledIteration() {
   }
 
   auto cur_iter = dump_json_parser.cur_dump_iter() + 1;
-  if (dump_json_parser.iteration() != 0) {
-    return cur_iter == dump_json_parser.iteration();
-  }
-  return true;
+  return dump_json_parser.IsDumpIter(cur_iter);
 }
 
 void KernelRuntime::AssignStaticMemory(session::KernelGraph *graph) {
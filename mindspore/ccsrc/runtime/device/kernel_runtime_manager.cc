@@ -16,11 +16,14 @@
 
 #include "runtime/device/kernel_runtime_manager.h"
 #include "utils/log_adapter.h"
+#include "debug/data_dump/dump_writer.h"
 
 namespace mindspore {
 namespace device {
 void KernelRuntimeManager::ClearRuntimeResource() {
   std::lock_guard<std::mutex> guard(lock_);
+  // The dump files still being written go to disk before the devices are released
+  DumpWriter::GetInstance().Flush();
   for (auto &iter : runtime_map_) {
     MS_LOG(INFO) << "Release device " << iter.first;
     MS_EXCEPTION_IF_NULL(iter.second);
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/checkpoint/checkpoint_converter.h"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "abstract/utils.h"
+#include "proto/checkpoint.pb.h"
+#include "utils/checkpoint/checkpoint_file.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+using google::protobuf::internal::WireFormatLite;
+
+// serialization.py splits the parameters larger than this into several values
+constexpr size_t kProtoSliceSize = 512 << 20;
+constexpr int kValueFieldNumber = 1;
+
+uint64_t ShapeSize(const ShapeVector &shape) {
+  uint64_t size = 1;
+  for (auto dim : shape) {
+    size *= static_cast<uint64_t>(dim);
+  }
+  return size;
+}
+}  // namespace
+
+void ConvertProtoToNative(const std::string &src_file, const std::string &dst_file) {
+  std::ifstream ifs(src_file, std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(EXCEPTION) << "Open checkpoint file " << src_file << " failed.";
+  }
+  google::protobuf::io::IstreamInputStream raw_input(&ifs);
+  const auto value_tag = WireFormatLite::MakeTag(kValueFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  std::vector<CheckpointEntry> entries;
+  std::vector<std::string> buffers;
+  while (true) {
+    // A fresh stream per value keeps every stream far below the 2 GB limit of protobuf, the values are appended
+    // messages of one repeated field
+    google::protobuf::io::CodedInputStream coded_input(&raw_input);
+    auto tag = coded_input.ReadTag();
+    if (tag == 0) {
+      break;
+    }
+    if (tag != value_tag) {
+      if (!WireFormatLite::SkipField(&coded_input, tag)) {
+        MS_LOG(EXCEPTION) << "Parse checkpoint file " << src_file << " failed.";
+      }
+      continue;
+    }
+    uint32_t len = 0;
+    if (!coded_input.ReadVarint32(&len)) {
+      MS_LOG(EXCEPTION) << "Parse checkpoint file " << src_file << " failed.";
+    }
+    auto limit = coded_input.PushLimit(static_cast<int>(len));
+    Checkpoint::Value value;
+    if (!value.ParseFromCodedStream(&coded_input) || !coded_input.ConsumedEntireMessage()) {
+      MS_LOG(EXCEPTION) << "Parse checkpoint file " << src_file << " failed.";
+    }
+    coded_input.PopLimit(limit);
+
+    // The slices of a parameter follow each other
+    auto content = value.mutable_tensor()->mutable_tensor_content();
+    if (!entries.empty() && entries.back().name == value.tag()) {
+      buffers.back().append(*content);
+      continue;
+    }
+    CheckpointEntry entry;
+    entry.name = value.tag();
+    entry.tensor_type = value.tensor().tensor_type();
+    // A scalar is saved with dims [0]
+    if (!(value.tensor().dims_size() == 1 && value.tensor().dims(0) == 0)) {
+      entry.shape.assign(value.tensor().dims().begin(), value.tensor().dims().end());
+    }
+    entries.push_back(entry);
+    buffers.push_back(std::move(*content));
+  }
+
+  std::vector<const void *> data;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    entries[i].nbytes = buffers[i].size();
+    auto itemsize = abstract::TypeIdSize(CheckpointTypeToTypeId(entries[i].tensor_type));
+    if (ShapeSize(entries[i].shape) * itemsize != entries[i].nbytes) {
+      MS_LOG(EXCEPTION) << "Parameter " << entries[i].name << " of checkpoint " << src_file << " has "
+                        << entries[i].nbytes << " bytes, which does not match its shape.";
+    }
+    data.push_back(buffers[i].data());
+  }
+  CheckpointWriter writer(dst_file);
+  writer.SaveRaw(&entries, data);
+}
+
+void ConvertNativeToProto(const std::string &src_file, const std::string &dst_file) {
+  CheckpointReader reader(src_file);
+  std::ofstream ofs(dst_file, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(EXCEPTION) << "Open file " << dst_file << " failed.";
+  }
+  for (const auto &entry : reader.entries()) {
+    if (!reader.VerifyEntry(entry)) {
+      MS_LOG(EXCEPTION) << "Tensor " << entry.name << " in checkpoint " << src_file << " is corrupted.";
+    }
+    auto itemsize = abstract::TypeIdSize(CheckpointTypeToTypeId(entry.tensor_type));
+    size_t slice_size = kProtoSliceSize / itemsize * itemsize;
+    auto data = static_cast<const char *>(reader.GetData(entry));
+    uint64_t begin = 0;
+    do {
+      size_t len = std::min<uint64_t>(slice_size, entry.nbytes - begin);
+      Checkpoint checkpoint;
+      auto value = checkpoint.add_value();
+      value->set_tag(entry.name);
+      auto tensor = value->mutable_tensor();
+      if (entry.shape.empty()) {
+        tensor->add_dims(0);
+      }
+      for (auto dim : entry.shape) {
+        tensor->add_dims(dim);
+      }
+      tensor->set_tensor_type(entry.tensor_type);
+      tensor->set_tensor_content(data + begin, len);
+      if (!checkpoint.SerializeToOstream(&ofs)) {
+        MS_LOG(EXCEPTION) << "Write checkpoint file " << dst_file << " failed.";
+      }
+      begin += len;
+    } while (begin < entry.nbytes);
+  }
+  ofs.close();
+  MS_LOG(INFO) << "Convert " << reader.entries().size() << " tensors of " << src_file << " into " << dst_file;
+}
+}  // namespace checkpoint
+}  // namespace mindspore
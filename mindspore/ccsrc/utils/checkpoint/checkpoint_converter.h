@@ -0,0 +1,30 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_CONVERTER_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_CONVERTER_H_
+
+#include <string>
+
+namespace mindspore {
+namespace checkpoint {
+// Convert between the native format and the checkpoint.proto files that serialization.py writes. The proto file is
+// read one value at a time, so files over the 2 GB limit of a single protobuf message convert as well.
+void ConvertProtoToNative(const std::string &src_file, const std::string &dst_file);
+void ConvertNativeToProto(const std::string &src_file, const std::string &dst_file);
+}  // namespace checkpoint
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_CONVERTER_H_
@@ -0,0 +1,452 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/checkpoint/checkpoint_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include "abstract/utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+constexpr size_t kMaxWriteThreads = 8;
+
+// The spelling serialization.py loads, UInt8 is what str(mstype.uint8) gives and is accepted as well
+const std::vector<std::pair<std::string, TypeId>> kCheckpointTypes = {
+  {"Bool", kNumberTypeBool},       {"Int8", kNumberTypeInt8},       {"Int16", kNumberTypeInt16},
+  {"Int32", kNumberTypeInt32},     {"Int64", kNumberTypeInt64},     {"Uint8", kNumberTypeUInt8},
+  {"Uint16", kNumberTypeUInt16},   {"Uint32", kNumberTypeUInt32},   {"Uint64", kNumberTypeUInt64},
+  {"UInt8", kNumberTypeUInt8},     {"UInt16", kNumberTypeUInt16},   {"UInt32", kNumberTypeUInt32},
+  {"UInt64", kNumberTypeUInt64},   {"Float16", kNumberTypeFloat16}, {"Float32", kNumberTypeFloat32},
+  {"Float64", kNumberTypeFloat64}};
+
+// zlib's crc32 is several times faster than the table driven crc32c of utils/system. The blocks and the index
+// stay far below the 4 GB length crc32 takes
+uint32_t BlockCrc(const char *data, size_t len) {
+  return static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef *>(data), static_cast<uInt>(len)));
+}
+
+uint64_t AlignUp(uint64_t offset) { return (offset + kDataAlignment - 1) / kDataAlignment * kDataAlignment; }
+
+size_t BlockNum(uint64_t nbytes, uint64_t block_size) { return (nbytes + block_size - 1) / block_size; }
+
+template <typename T>
+void AppendValue(std::string *out, T value) {
+  out->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void AppendString(std::string *out, const std::string &value) {
+  AppendValue<uint32_t>(out, value.size());
+  out->append(value);
+}
+
+// Index entry: name, tensor_type, ndim, dims, offset, nbytes, block crcs, all little endian
+std::string SerializeIndex(const std::vector<CheckpointEntry> &entries) {
+  std::string index;
+  for (const auto &entry : entries) {
+    AppendString(&index, entry.name);
+    AppendString(&index, entry.tensor_type);
+    AppendValue<uint32_t>(&index, entry.shape.size());
+    for (auto dim : entry.shape) {
+      AppendValue<int64_t>(&index, dim);
+    }
+    AppendValue<uint64_t>(&index, entry.offset);
+    AppendValue<uint64_t>(&index, entry.nbytes);
+    for (auto crc : entry.block_crcs) {
+      AppendValue<uint32_t>(&index, crc);
+    }
+  }
+  return index;
+}
+
+class IndexCursor {
+ public:
+  IndexCursor(const char *data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    Check(sizeof(T));
+    (void)memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  std::string ReadString() {
+    auto len = Read<uint32_t>();
+    Check(len);
+    std::string value(data_ + pos_, len);
+    pos_ += len;
+    return value;
+  }
+
+  bool AtEnd() const { return pos_ == size_; }
+
+ private:
+  void Check(size_t len) const {
+    if (len > size_ - pos_) {
+      MS_LOG(EXCEPTION) << "The checkpoint index is truncated.";
+    }
+  }
+
+  const char *data_;
+  size_t size_;
+  size_t pos_{0};
+};
+
+bool WriteAt(int fd, const char *data, size_t len, uint64_t offset) {
+  while (len > 0) {
+    auto written = pwrite(fd, data, len, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    len -= static_cast<size_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+  return true;
+}
+}  // namespace
+
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string &file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(EXCEPTION) << "Open checkpoint file " << file_name << " failed, errno " << errno;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      (void)close(fd);
+      MS_LOG(EXCEPTION) << "Stat checkpoint file " << file_name << " failed, errno " << errno;
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if (size_ < sizeof(CheckpointHeader)) {
+      (void)close(fd);
+      MS_LOG(EXCEPTION) << "Checkpoint file " << file_name << " is too small to be a native checkpoint.";
+    }
+    // Private and writable: a parameter that trains on the loaded data copies the pages it changes, the file is
+    // never written
+    auto addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(EXCEPTION) << "Map checkpoint file " << file_name << " failed, errno " << errno;
+    }
+    data_ = static_cast<char *>(addr);
+  }
+
+  ~MappedFile() { (void)munmap(data_, size_); }
+
+  char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  char *data_{nullptr};
+  size_t size_{0};
+};
+
+namespace {
+// Tensor data that lives in a mapped checkpoint, it keeps the mapping alive
+class MappedTensorData : public tensor::TensorData {
+ public:
+  MappedTensorData(const std::shared_ptr<MappedFile> &file, char *data, TypeId type, const ShapeVector &shape,
+                   size_t nbytes)
+      : file_(file), data_(data), shape_(shape), itemsize_(abstract::TypeIdSize(type)), nbytes_(nbytes) {}
+  ~MappedTensorData() override = default;
+
+  ssize_t size() const override { return static_cast<ssize_t>(nbytes_ / itemsize_); }
+  ssize_t itemsize() const override { return static_cast<ssize_t>(itemsize_); }
+  ssize_t nbytes() const override { return static_cast<ssize_t>(nbytes_); }
+  ssize_t ndim() const override { return static_cast<ssize_t>(shape_.size()); }
+  void *data() override { return data_; }
+  const void *const_data() const override { return data_; }
+
+  std::string ToString(const TypeId type, const ShapeVector &shape, bool use_comma) const override {
+    // Printing is rare, it goes through a copy
+    tensor::Tensor copy(type, shape, data_, nbytes_);
+    return copy.data().ToString(type, shape, use_comma);
+  }
+
+ private:
+  std::shared_ptr<MappedFile> file_;
+  char *data_;
+  ShapeVector shape_;
+  size_t itemsize_;
+  size_t nbytes_;
+};
+}  // namespace
+
+bool IsNativeCheckpoint(const std::string &file_name) {
+  std::ifstream ifs(file_name, std::ios::binary);
+  char magic[sizeof(kCheckpointMagic)] = {0};
+  if (!ifs.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return memcmp(magic, kCheckpointMagic, sizeof(magic)) == 0;
+}
+
+TypeId CheckpointTypeToTypeId(const std::string &tensor_type) {
+  auto iter = std::find_if(kCheckpointTypes.begin(), kCheckpointTypes.end(),
+                           [&tensor_type](const auto &item) { return item.first == tensor_type; });
+  if (iter == kCheckpointTypes.end()) {
+    MS_LOG(EXCEPTION) << "Unsupported checkpoint tensor type " << tensor_type;
+  }
+  return iter->second;
+}
+
+std::string TypeIdToCheckpointType(TypeId type_id) {
+  auto iter = std::find_if(kCheckpointTypes.begin(), kCheckpointTypes.end(),
+                           [type_id](const auto &item) { return item.second == type_id; });
+  if (iter == kCheckpointTypes.end()) {
+    MS_LOG(EXCEPTION) << "Unsupported checkpoint tensor type " << TypeIdLabel(type_id);
+  }
+  return iter->first;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string &file_name, size_t num_threads)
+    : file_name_(file_name), num_threads_(num_threads) {
+  if (num_threads_ == 0) {
+    num_threads_ = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), kMaxWriteThreads);
+  }
+}
+
+void CheckpointWriter::Save(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors) {
+  if (names.size() != tensors.size()) {
+    MS_LOG(EXCEPTION) << "Got " << names.size() << " names for " << tensors.size() << " tensors.";
+  }
+  std::vector<CheckpointEntry> entries(names.size());
+  std::vector<const void *> data(names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(tensors[i]);
+    tensors[i]->data_sync();
+    entries[i].name = names[i];
+    entries[i].tensor_type = TypeIdToCheckpointType(tensors[i]->data_type());
+    entries[i].shape = tensors[i]->shape();
+    entries[i].nbytes = tensors[i]->Size();
+    data[i] = tensors[i]->data_c();
+  }
+  SaveRaw(&entries, data);
+}
+
+void CheckpointWriter::SaveRaw(std::vector<CheckpointEntry> *entries, const std::vector<const void *> &data) {
+  MS_EXCEPTION_IF_NULL(entries);
+  if (entries->size() != data.size()) {
+    MS_LOG(EXCEPTION) << "Got " << data.size() << " buffers for " << entries->size() << " tensors.";
+  }
+  // Lay the tensors out, the index has a fixed size once the number of blocks is known
+  for (auto &entry : *entries) {
+    entry.block_crcs.assign(BlockNum(entry.nbytes, kBlockSize), 0);
+  }
+  uint64_t index_size = SerializeIndex(*entries).size();
+  uint64_t file_size = sizeof(CheckpointHeader) + index_size;
+  uint64_t offset = AlignUp(file_size);
+  std::vector<std::pair<size_t, size_t>> blocks;
+  std::unordered_map<std::string, size_t> names;
+  for (size_t i = 0; i < entries->size(); ++i) {
+    auto &entry = (*entries)[i];
+    if (!names.emplace(entry.name, i).second) {
+      MS_LOG(EXCEPTION) << "Duplicate tensor name " << entry.name << " in checkpoint " << file_name_;
+    }
+    entry.offset = offset;
+    file_size = std::max(file_size, offset + entry.nbytes);
+    offset = AlignUp(offset + entry.nbytes);
+    for (size_t block = 0; block < entry.block_crcs.size(); ++block) {
+      blocks.emplace_back(i, block);
+    }
+  }
+
+  std::string tmp_file_name = file_name_ + ".tmp";
+  int fd = open(tmp_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(EXCEPTION) << "Open file " << tmp_file_name << " failed, errno " << errno;
+  }
+  auto fail = [fd, &tmp_file_name](const std::string &what) {
+    auto error = errno;
+    (void)close(fd);
+    (void)unlink(tmp_file_name.c_str());
+    MS_LOG(EXCEPTION) << what << " " << tmp_file_name << " failed, errno " << error;
+  };
+  if (ftruncate(fd, static_cast<off_t>(file_size)) != 0) {
+    fail("Resize file");
+  }
+
+  // Every thread takes the next block, checksums it and writes it at its offset
+  std::atomic<size_t> next_block{0};
+  std::atomic<bool> write_failed{false};
+  auto write_blocks = [&]() {
+    for (size_t i = next_block++; i < blocks.size() && !write_failed; i = next_block++) {
+      auto &entry = (*entries)[blocks[i].first];
+      uint64_t begin = blocks[i].second * kBlockSize;
+      size_t len = std::min<uint64_t>(kBlockSize, entry.nbytes - begin);
+      auto block = static_cast<const char *>(data[blocks[i].first]) + begin;
+      entry.block_crcs[blocks[i].second] = BlockCrc(block, len);
+      if (!WriteAt(fd, block, len, entry.offset + begin)) {
+        write_failed = true;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(num_threads_, blocks.size()); ++i) {
+    threads.emplace_back(write_blocks);
+  }
+  write_blocks();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (write_failed) {
+    fail("Write tensor data to");
+  }
+
+  std::string index = SerializeIndex(*entries);
+  CheckpointHeader header;
+  (void)memcpy(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic));
+  header.version = kCheckpointVersion;
+  header.tensor_num = static_cast<uint32_t>(entries->size());
+  header.index_size = index.size();
+  header.file_size = file_size;
+  header.block_size = kBlockSize;
+  header.index_crc = BlockCrc(index.data(), index.size());
+  std::string head(reinterpret_cast<const char *>(&header), sizeof(header));
+  head += index;
+  if (!WriteAt(fd, head.data(), head.size(), 0)) {
+    fail("Write checkpoint index to");
+  }
+  if (close(fd) != 0) {
+    (void)unlink(tmp_file_name.c_str());
+    MS_LOG(EXCEPTION) << "Close file " << tmp_file_name << " failed, errno " << errno;
+  }
+  if (rename(tmp_file_name.c_str(), file_name_.c_str()) != 0) {
+    (void)unlink(tmp_file_name.c_str());
+    MS_LOG(EXCEPTION) << "Rename " << tmp_file_name << " to " << file_name_ << " failed, errno " << errno;
+  }
+  MS_LOG(INFO) << "Save " << entries->size() << " tensors into checkpoint " << file_name_ << ", " << file_size
+               << " bytes, " << blocks.size() << " blocks.";
+}
+
+CheckpointReader::CheckpointReader(const std::string &file_name)
+    : file_name_(file_name), file_(std::make_shared<MappedFile>(file_name)) {
+  CheckpointHeader header;
+  (void)memcpy(&header, file_->data(), sizeof(header));
+  if (memcmp(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic)) != 0) {
+    MS_LOG(EXCEPTION) << "File " << file_name << " is not a native checkpoint.";
+  }
+  if (header.version != kCheckpointVersion) {
+    MS_LOG(EXCEPTION) << "Checkpoint " << file_name << " has version " << header.version << ", only version "
+                      << kCheckpointVersion << " is supported.";
+  }
+  if (header.file_size != file_->size() || header.index_size > file_->size() - sizeof(header) ||
+      header.block_size == 0) {
+    MS_LOG(EXCEPTION) << "Checkpoint " << file_name << " is truncated or corrupted, expect " << header.file_size
+                      << " bytes but got " << file_->size();
+  }
+  auto index = file_->data() + sizeof(header);
+  if (BlockCrc(index, header.index_size) != header.index_crc) {
+    MS_LOG(EXCEPTION) << "The index of checkpoint " << file_name << " does not match its checksum.";
+  }
+  block_size_ = header.block_size;
+  ParseIndex(index, header.index_size, header.tensor_num);
+}
+
+void CheckpointReader::ParseIndex(const char *index, size_t index_size, uint32_t tensor_num) {
+  IndexCursor cursor(index, index_size);
+  entries_.resize(tensor_num);
+  for (uint32_t i = 0; i < tensor_num; ++i) {
+    auto &entry = entries_[i];
+    entry.name = cursor.ReadString();
+    entry.tensor_type = cursor.ReadString();
+    auto ndim = cursor.Read<uint32_t>();
+    uint64_t element_num = 1;
+    for (uint32_t j = 0; j < ndim; ++j) {
+      auto dim = cursor.Read<int64_t>();
+      if (dim < 0 || (dim > 0 && element_num > UINT64_MAX / static_cast<uint64_t>(dim))) {
+        MS_LOG(EXCEPTION) << "Tensor " << entry.name << " of checkpoint " << file_name_ << " has an invalid shape.";
+      }
+      entry.shape.push_back(dim);
+      element_num *= static_cast<uint64_t>(dim);
+    }
+    entry.offset = cursor.Read<uint64_t>();
+    entry.nbytes = cursor.Read<uint64_t>();
+    entry.block_crcs.resize(BlockNum(entry.nbytes, block_size_));
+    for (auto &crc : entry.block_crcs) {
+      crc = cursor.Read<uint32_t>();
+    }
+    auto itemsize = abstract::TypeIdSize(CheckpointTypeToTypeId(entry.tensor_type));
+    if (entry.nbytes != element_num * itemsize || entry.offset % kDataAlignment != 0 ||
+        entry.offset > file_->size() || entry.nbytes > file_->size() - entry.offset) {
+      MS_LOG(EXCEPTION) << "Tensor " << entry.name << " of checkpoint " << file_name_ << " is out of the file.";
+    }
+    if (!entry_ids_.emplace(entry.name, i).second) {
+      MS_LOG(EXCEPTION) << "Duplicate tensor name " << entry.name << " in checkpoint " << file_name_;
+    }
+  }
+  if (!cursor.AtEnd()) {
+    MS_LOG(EXCEPTION) << "The index of checkpoint " << file_name_ << " has trailing data.";
+  }
+}
+
+std::vector<std::string> CheckpointReader::GetNames() const {
+  std::vector<std::string> names;
+  names.reserve(entries_.size());
+  (void)std::transform(entries_.begin(), entries_.end(), std::back_inserter(names),
+                       [](const CheckpointEntry &entry) { return entry.name; });
+  return names;
+}
+
+const void *CheckpointReader::GetData(const CheckpointEntry &entry) const { return file_->data() + entry.offset; }
+
+bool CheckpointReader::VerifyEntry(const CheckpointEntry &entry) const {
+  auto data = file_->data() + entry.offset;
+  for (size_t block = 0; block < entry.block_crcs.size(); ++block) {
+    uint64_t begin = block * block_size_;
+    size_t len = std::min<uint64_t>(block_size_, entry.nbytes - begin);
+    if (BlockCrc(data + begin, len) != entry.block_crcs[block]) {
+      MS_LOG(ERROR) << "Block " << block << " of tensor " << entry.name << " in checkpoint " << file_name_
+                    << " does not match its checksum.";
+      return false;
+    }
+  }
+  return true;
+}
+
+tensor::TensorPtr CheckpointReader::GetTensor(const std::string &name, bool verify) const {
+  auto iter = entry_ids_.find(name);
+  if (iter == entry_ids_.end()) {
+    MS_LOG(EXCEPTION) << "Tensor " << name << " is not in checkpoint " << file_name_;
+  }
+  const auto &entry = entries_[iter->second];
+  if (verify && !VerifyEntry(entry)) {
+    MS_LOG(EXCEPTION) << "Tensor " << name << " in checkpoint " << file_name_ << " is corrupted.";
+  }
+  auto type_id = CheckpointTypeToTypeId(entry.tensor_type);
+  auto data =
+    std::make_shared<MappedTensorData>(file_, file_->data() + entry.offset, type_id, entry.shape, entry.nbytes);
+  return std::make_shared<tensor::Tensor>(type_id, entry.shape, data);
+}
+}  // namespace checkpoint
+}  // namespace mindspore
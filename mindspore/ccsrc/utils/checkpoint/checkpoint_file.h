@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_FILE_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_FILE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace checkpoint {
+// A native checkpoint file is laid out as
+//   header | index | tensor data
+// The index lists every tensor with its name, type, shape, offset and size, and the crc32 of each kBlockSize piece
+// of its data. The data of each tensor starts on a kDataAlignment boundary, so that a mapped file can be used in place.
+constexpr char kCheckpointMagic[8] = {'M', 'S', 'C', 'K', 'P', 'T', '\0', '\1'};
+constexpr uint32_t kCheckpointVersion = 1;
+constexpr size_t kDataAlignment = 4096;
+constexpr size_t kBlockSize = 64 << 20;
+
+struct CheckpointHeader {
+  char magic[sizeof(kCheckpointMagic)];
+  uint32_t version;
+  uint32_t tensor_num;
+  uint64_t index_size;
+  uint64_t file_size;
+  uint32_t block_size;
+  uint32_t index_crc;
+};
+
+struct CheckpointEntry {
+  std::string name;
+  // The type name used by checkpoint.proto, like Float32
+  std::string tensor_type;
+  ShapeVector shape;
+  uint64_t offset{0};
+  uint64_t nbytes{0};
+  std::vector<uint32_t> block_crcs;
+};
+
+bool IsNativeCheckpoint(const std::string &file_name);
+TypeId CheckpointTypeToTypeId(const std::string &tensor_type);
+std::string TypeIdToCheckpointType(TypeId type_id);
+
+// Writes a native checkpoint. The blocks of all tensors are written and checksummed in parallel straight from the
+// tensor buffers. The file is written under a temporary name and renamed when complete, so a reader never sees a
+// partial file and a file that is still mapped by a previous load is not overwritten in place.
+class CheckpointWriter {
+ public:
+  // num_threads 0 picks one per core, up to 8
+  explicit CheckpointWriter(const std::string &file_name, size_t num_threads = 0);
+  ~CheckpointWriter() = default;
+
+  void Save(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors);
+  // entries need name, tensor_type, shape and nbytes, data[i] holds the nbytes of entries[i]
+  void SaveRaw(std::vector<CheckpointEntry> *entries, const std::vector<const void *> &data);
+
+ private:
+  std::string file_name_;
+  size_t num_threads_;
+};
+
+class MappedFile;
+
+// Maps a native checkpoint. The tensors it returns share the mapped pages, a page is read from disk when it is
+// first touched and copied when it is first written, so loading a parameter costs no copy.
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(const std::string &file_name);
+  ~CheckpointReader() = default;
+
+  const std::vector<CheckpointEntry> &entries() const { return entries_; }
+  std::vector<std::string> GetNames() const;
+  bool HasTensor(const std::string &name) const { return entry_ids_.count(name) > 0; }
+  const void *GetData(const CheckpointEntry &entry) const;
+  // verify checks the crc of every block of the tensor, which reads all of its pages. Without it a page is only read
+  // when the tensor data is first used.
+  tensor::TensorPtr GetTensor(const std::string &name, bool verify = false) const;
+  bool VerifyEntry(const CheckpointEntry &entry) const;
+
+ private:
+  void ParseIndex(const char *index, size_t index_size, uint32_t tensor_num);
+
+  std::string file_name_;
+  std::shared_ptr<MappedFile> file_;
+  uint32_t block_size_{0};
+  std::vector<CheckpointEntry> entries_;
+  std::unordered_map<std::string, size_t> entry_ids_;
+};
+}  // namespace checkpoint
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_FILE_H_
@@ -0,0 +1,367 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/checkpoint/delta_checkpoint.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+#include "nlohmann/json.hpp"
+#include "securec/include/securec.h"
+#include "utils/checkpoint/checkpoint_file.h"
+#include "utils/checkpoint/dirty_row_tracker.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+constexpr int kManifestVersion = 1;
+
+struct ManifestTensor {
+  std::string name;
+  std::string type;
+  ShapeVector shape;
+};
+
+struct Manifest {
+  std::string base;
+  std::vector<ManifestTensor> tensors;
+};
+
+std::string DirName(const std::string &path) {
+  auto pos = path.rfind('/');
+  return pos == std::string::npos ? "" : path.substr(0, pos + 1);
+}
+
+bool FileExists(const std::string &file_name) {
+  struct stat file_stat;
+  return stat(file_name.c_str(), &file_stat) == 0;
+}
+
+Manifest ReadManifest(const std::string &file_name) {
+  auto manifest_file = file_name + kManifestSuffix;
+  std::ifstream ifs(manifest_file);
+  if (!ifs.is_open()) {
+    MS_LOG(EXCEPTION) << "Open manifest " << manifest_file << " failed.";
+  }
+  Manifest manifest;
+  try {
+    nlohmann::json content;
+    ifs >> content;
+    if (content.at("version").get<int>() != kManifestVersion) {
+      MS_LOG(EXCEPTION) << "Manifest " << manifest_file << " has version " << content.at("version")
+                        << ", only version " << kManifestVersion << " is supported.";
+    }
+    manifest.base = content.at("base").get<std::string>();
+    for (const auto &item : content.at("tensors")) {
+      manifest.tensors.push_back({item.at("name").get<std::string>(), item.at("type").get<std::string>(),
+                                  item.at("shape").get<ShapeVector>()});
+    }
+  } catch (const nlohmann::json::exception &e) {
+    MS_LOG(EXCEPTION) << "Parse manifest " << manifest_file << " failed: " << e.what();
+  }
+  if (manifest.base.empty()) {
+    MS_LOG(EXCEPTION) << "Manifest " << manifest_file << " has no base checkpoint.";
+  }
+  // A relative base lives next to the delta
+  if (manifest.base[0] != '/') {
+    manifest.base = DirName(file_name) + manifest.base;
+  }
+  return manifest;
+}
+
+void CheckTensor(const std::string &file_name, const ManifestTensor &item, const tensor::TensorPtr &tensor) {
+  MS_EXCEPTION_IF_NULL(tensor);
+  if (tensor->data_type() != CheckpointTypeToTypeId(item.type) || tensor->shape() != item.shape) {
+    MS_LOG(EXCEPTION) << "Tensor " << item.name << " of checkpoint " << file_name
+                      << " does not match the type and shape in its manifest.";
+  }
+}
+
+void ApplyRows(const std::string &file_name, const ManifestTensor &item, const tensor::TensorPtr &rows,
+               const tensor::TensorPtr &values, const tensor::TensorPtr &tensor) {
+  auto row_num = static_cast<size_t>(item.shape[0]);
+  size_t row_bytes = row_num == 0 ? 0 : tensor->Size() / row_num;
+  auto row_ids = static_cast<const int64_t *>(rows->data_c());
+  auto row_count = static_cast<size_t>(rows->DataSize());
+  if (rows->data_type() != kNumberTypeInt64 || values->data_type() != tensor->data_type() ||
+      values->Size() != row_count * row_bytes) {
+    MS_LOG(EXCEPTION) << "The changed rows of tensor " << item.name << " in checkpoint " << file_name
+                      << " do not match its shape.";
+  }
+  auto dst = static_cast<char *>(tensor->data_c());
+  auto src = static_cast<const char *>(values->data_c());
+  for (size_t i = 0; i < row_count && row_bytes > 0; ++i) {
+    if (row_ids[i] < 0 || static_cast<size_t>(row_ids[i]) >= row_num) {
+      MS_LOG(EXCEPTION) << "Row " << row_ids[i] << " of tensor " << item.name << " in checkpoint " << file_name
+                        << " is out of range.";
+    }
+    auto ret = memcpy_s(dst + row_ids[i] * row_bytes, row_bytes, src + i * row_bytes, row_bytes);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Copy row " << row_ids[i] << " of tensor " << item.name << " failed, ret " << ret;
+    }
+  }
+}
+}  // namespace
+
+bool IsDeltaCheckpoint(const std::string &file_name) { return FileExists(file_name + kManifestSuffix); }
+
+DeltaCheckpointWriter::DeltaCheckpointWriter(const std::string &file_name, const std::string &base_file_name)
+    : file_name_(file_name), base_file_name_(base_file_name) {
+  if (!IsNativeCheckpoint(base_file_name)) {
+    MS_LOG(EXCEPTION) << "The base " << base_file_name << " of a delta checkpoint must be a native checkpoint.";
+  }
+  if (base_file_name == file_name) {
+    MS_LOG(EXCEPTION) << "A delta checkpoint can not be based on itself: " << file_name;
+  }
+  if (DirName(base_file_name) == DirName(file_name)) {
+    base_file_name_ = base_file_name.substr(DirName(base_file_name).size());
+    return;
+  }
+  char real_path[PATH_MAX] = {0};
+  if (realpath(base_file_name.c_str(), real_path) == nullptr) {
+    MS_LOG(EXCEPTION) << "Get the real path of " << base_file_name << " failed, errno " << errno;
+  }
+  base_file_name_ = real_path;
+}
+
+void DeltaCheckpointWriter::Collect(const std::vector<std::string> &names,
+                                    const std::vector<tensor::TensorPtr> &tensors, bool copy) {
+  if (names.size() != tensors.size()) {
+    MS_LOG(EXCEPTION) << "Got " << names.size() << " names for " << tensors.size() << " tensors.";
+  }
+  auto &tracker = DirtyRowTracker::GetInstance();
+  tracker.Enable();
+  size_t delta_num = 0;
+  size_t row_num = 0;
+  std::unordered_set<const void *> addrs;
+  for (size_t i = 0; i < names.size(); ++i) {
+    auto &tensor = tensors[i];
+    MS_EXCEPTION_IF_NULL(tensor);
+    tensor->data_sync();
+    DeltaTensor item;
+    item.name = names[i];
+    item.type = tensor->data_type();
+    item.shape = tensor->shape();
+    item.addr = tensor->data_c();
+    (void)addrs.insert(item.addr);
+    item.delta = !item.shape.empty() &&
+                 tracker.TakeRows(item.addr, static_cast<size_t>(item.shape[0]), tensor->id(), &item.rows);
+    if (item.delta) {
+      size_t row_bytes = item.shape[0] == 0 ? 0 : tensor->Size() / static_cast<size_t>(item.shape[0]);
+      item.values.resize(item.rows.size() * row_bytes);
+      auto src = static_cast<const char *>(item.addr);
+      for (size_t j = 0; j < item.rows.size() && row_bytes > 0; ++j) {
+        auto ret = memcpy_s(item.values.data() + j * row_bytes, row_bytes, src + item.rows[j] * row_bytes, row_bytes);
+        if (ret != EOK) {
+          MS_LOG(EXCEPTION) << "Copy row " << item.rows[j] << " of tensor " << item.name << " failed, ret " << ret;
+        }
+      }
+      ++delta_num;
+      row_num += item.rows.size();
+    } else {
+      item.tensor = copy ? std::make_shared<tensor::Tensor>(item.type, item.shape, tensor->data_c(), tensor->Size())
+                         : tensor;
+    }
+    tensors_.push_back(std::move(item));
+  }
+  tracker.Retain(addrs);
+  MS_LOG(INFO) << "Delta checkpoint " << file_name_ << " takes " << row_num << " changed rows of " << delta_num
+               << " tensors, " << (tensors_.size() - delta_num) << " tensors in full.";
+}
+
+void DeltaCheckpointWriter::WriteManifest() const {
+  nlohmann::json content;
+  content["version"] = kManifestVersion;
+  content["base"] = base_file_name_;
+  content["tensors"] = nlohmann::json::array();
+  for (const auto &item : tensors_) {
+    content["tensors"].push_back(
+      {{"name", item.name}, {"type", TypeIdToCheckpointType(item.type)}, {"shape", item.shape}});
+  }
+  auto manifest_file = file_name_ + kManifestSuffix;
+  auto tmp_file = manifest_file + ".tmp";
+  {
+    std::ofstream ofs(tmp_file, std::ios::trunc);
+    if (!ofs.is_open()) {
+      MS_LOG(EXCEPTION) << "Open file " << tmp_file << " failed.";
+    }
+    ofs << content.dump(2);
+    ofs.close();
+    if (ofs.fail()) {
+      (void)unlink(tmp_file.c_str());
+      MS_LOG(EXCEPTION) << "Write file " << tmp_file << " failed.";
+    }
+  }
+  if (rename(tmp_file.c_str(), manifest_file.c_str()) != 0) {
+    (void)unlink(tmp_file.c_str());
+    MS_LOG(EXCEPTION) << "Rename " << tmp_file << " to " << manifest_file << " failed, errno " << errno;
+  }
+}
+
+void DeltaCheckpointWriter::MarkChangedAgain() const {
+  auto &tracker = DirtyRowTracker::GetInstance();
+  for (const auto &item : tensors_) {
+    if (item.delta) {
+      tracker.MarkRows(item.addr, static_cast<size_t>(item.shape[0]), item.rows.data(), item.rows.size());
+    } else {
+      tracker.MarkAll(item.addr);
+    }
+  }
+}
+
+void DeltaCheckpointWriter::Write() {
+  std::vector<CheckpointEntry> entries;
+  std::vector<const void *> data;
+  for (const auto &item : tensors_) {
+    CheckpointEntry entry;
+    entry.name = item.name;
+    entry.tensor_type = TypeIdToCheckpointType(item.type);
+    entry.shape = item.shape;
+    if (!item.delta) {
+      entry.nbytes = item.tensor->Size();
+      entries.push_back(entry);
+      data.push_back(item.tensor->data_c());
+      continue;
+    }
+    entry.shape[0] = static_cast<int64_t>(item.rows.size());
+    entry.nbytes = item.values.size();
+    entries.push_back(entry);
+    data.push_back(item.values.data());
+
+    CheckpointEntry rows_entry;
+    rows_entry.name = item.name + kRowsSuffix;
+    rows_entry.tensor_type = TypeIdToCheckpointType(kNumberTypeInt64);
+    rows_entry.shape = {static_cast<int64_t>(item.rows.size())};
+    rows_entry.nbytes = item.rows.size() * sizeof(int64_t);
+    entries.push_back(rows_entry);
+    data.push_back(item.rows.data());
+  }
+
+  // The manifest goes last, so it never describes a data file that is not in place yet. A stale manifest is
+  // removed first, and a delta left without its manifest is rejected by LoadCheckpointChain
+  auto manifest_file = file_name_ + kManifestSuffix;
+  if (unlink(manifest_file.c_str()) != 0 && errno != ENOENT) {
+    MarkChangedAgain();
+    MS_LOG(EXCEPTION) << "Remove manifest " << manifest_file << " failed, errno " << errno;
+  }
+  bool data_written = false;
+  try {
+    CheckpointWriter(file_name_).SaveRaw(&entries, data);
+    data_written = true;
+    WriteManifest();
+  } catch (const std::exception &) {
+    if (data_written) {
+      (void)unlink(file_name_.c_str());
+    }
+    MarkChangedAgain();
+    throw;
+  }
+}
+
+void ResetChangedRows(const std::vector<tensor::TensorPtr> &tensors) {
+  auto &tracker = DirtyRowTracker::GetInstance();
+  tracker.Enable();
+  std::unordered_set<const void *> addrs;
+  for (const auto &tensor : tensors) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    auto row_num = tensor->shape().empty() ? 0 : static_cast<size_t>(tensor->shape()[0]);
+    tracker.Track(tensor->data_c(), row_num, tensor->id());
+    (void)addrs.insert(tensor->data_c());
+  }
+  tracker.Retain(addrs);
+}
+
+std::vector<std::pair<std::string, tensor::TensorPtr>> LoadCheckpointChain(const std::string &file_name,
+                                                                           bool verify) {
+  CheckpointReader reader(file_name);
+  std::vector<std::pair<std::string, tensor::TensorPtr>> tensors;
+  if (!IsDeltaCheckpoint(file_name)) {
+    for (const auto &name : reader.GetNames()) {
+      if (name.size() > strlen(kRowsSuffix) &&
+          name.compare(name.size() - strlen(kRowsSuffix), std::string::npos, kRowsSuffix) == 0) {
+        MS_LOG(EXCEPTION) << "Checkpoint " << file_name << " holds delta rows " << name << " but has no manifest "
+                          << file_name << kManifestSuffix << ", it was not written completely.";
+      }
+      tensors.emplace_back(name, reader.GetTensor(name, verify));
+    }
+    return tensors;
+  }
+
+  auto manifest = ReadManifest(file_name);
+  std::unordered_map<std::string, tensor::TensorPtr> base_tensors;
+  bool base_loaded = false;
+  for (const auto &item : manifest.tensors) {
+    // A compacted delta holds every tensor in full
+    if (!reader.HasTensor(item.name + kRowsSuffix)) {
+      auto tensor = reader.GetTensor(item.name, verify);
+      CheckTensor(file_name, item, tensor);
+      tensors.emplace_back(item.name, tensor);
+      continue;
+    }
+    if (!base_loaded) {
+      for (auto &base_tensor : LoadCheckpointChain(manifest.base, verify)) {
+        base_tensors.insert(std::move(base_tensor));
+      }
+      base_loaded = true;
+    }
+    auto iter = base_tensors.find(item.name);
+    if (iter == base_tensors.end()) {
+      MS_LOG(EXCEPTION) << "Tensor " << item.name << " of delta checkpoint " << file_name << " is not in its base "
+                        << manifest.base;
+    }
+    CheckTensor(manifest.base, item, iter->second);
+    ApplyRows(file_name, item, reader.GetTensor(item.name + kRowsSuffix, verify), reader.GetTensor(item.name, verify),
+              iter->second);
+    tensors.emplace_back(item.name, iter->second);
+  }
+  return tensors;
+}
+
+void CompactCheckpoint(const std::string &src_file, const std::string &dst_file) {
+  struct stat src_stat;
+  if (stat(src_file.c_str(), &src_stat) != 0) {
+    MS_LOG(EXCEPTION) << "Stat checkpoint file " << src_file << " failed, errno " << errno;
+  }
+  // Compaction reads every page anyway, verifying keeps a corrupted block out of the new full checkpoint
+  auto tensors = LoadCheckpointChain(src_file, true);
+  std::vector<std::string> names;
+  std::vector<tensor::TensorPtr> values;
+  for (auto &item : tensors) {
+    names.push_back(item.first);
+    values.push_back(item.second);
+  }
+  // The writer renames over the source, which stays mapped until the tensors are released
+  CheckpointWriter(dst_file).Save(names, values);
+  if (dst_file != src_file) {
+    return;
+  }
+  (void)chmod(dst_file.c_str(), src_stat.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO));
+  struct timespec times[2] = {src_stat.st_atim, src_stat.st_mtim};
+  (void)utimensat(AT_FDCWD, dst_file.c_str(), times, 0);
+  if (unlink((dst_file + kManifestSuffix).c_str()) != 0) {
+    MS_LOG(EXCEPTION) << "Remove manifest " << dst_file << kManifestSuffix << " failed, errno " << errno;
+  }
+  MS_LOG(INFO) << "Compact checkpoint " << src_file << ", " << names.size() << " tensors.";
+}
+}  // namespace checkpoint
+}  // namespace mindspore
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_DELTA_CHECKPOINT_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_DELTA_CHECKPOINT_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace checkpoint {
+// A delta checkpoint is a native checkpoint holding, for every parameter that DirtyRowTracker tracks, only the rows
+// changed since its base: the entry <name> has those rows and the entry <name>:rows their indices. Every other
+// parameter is held in full. The manifest <file>.manifest next to it chains it to its base and lists the type and
+// shape of every parameter:
+//   {"version": 1, "base": "CKP-1_100.ckpt", "tensors": [{"name": "w", "type": "Float32", "shape": [1000, 8]}]}
+// The base is a native or another delta checkpoint, named relative to the directory of the delta when it lives there.
+constexpr char kManifestSuffix[] = ".manifest";
+constexpr char kRowsSuffix[] = ":rows";
+
+bool IsDeltaCheckpoint(const std::string &file_name);
+
+class DeltaCheckpointWriter {
+ public:
+  DeltaCheckpointWriter(const std::string &file_name, const std::string &base_file_name);
+  ~DeltaCheckpointWriter() = default;
+
+  // Takes the rows changed since the base. The rows, and with copy set the parameters saved in full, are copied so
+  // that the training can go on while Write runs.
+  void Collect(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors, bool copy);
+  // Writes the data and then the manifest. On failure the collected rows are marked changed again, so that the next
+  // delta on the same base still has them.
+  void Write();
+
+ private:
+  struct DeltaTensor {
+    std::string name;
+    TypeId type{kTypeUnknown};
+    ShapeVector shape;
+    // The buffer the rows were taken from
+    const void *addr{nullptr};
+    bool delta{false};
+    std::vector<int64_t> rows;
+    std::vector<char> values;
+    tensor::TensorPtr tensor;
+  };
+
+  void WriteManifest() const;
+  void MarkChangedAgain() const;
+
+  std::string file_name_;
+  std::string base_file_name_;
+  std::vector<DeltaTensor> tensors_;
+};
+
+// A full native checkpoint of the tensors is the base of the next delta: starts tracking the changed rows and forgets
+// those changed so far
+void ResetChangedRows(const std::vector<tensor::TensorPtr> &tensors);
+
+// Replays a checkpoint chain down to its full base, a full native checkpoint loads as it is. The data no delta
+// changes stays mapped from the files, a changed row copies only the pages it touches. verify checks the crc of every
+// block loaded, see CheckpointReader::GetTensor.
+std::vector<std::pair<std::string, tensor::TensorPtr>> LoadCheckpointChain(const std::string &file_name,
+                                                                           bool verify = false);
+
+// Writes the parameters of a checkpoint chain as a full native checkpoint. When dst_file is src_file the delta is
+// replaced in place keeping its mode and times, so the deltas based on it stay valid and the checkpoint files keep
+// their order, and its manifest is removed.
+void CompactCheckpoint(const std::string &src_file, const std::string &dst_file);
+}  // namespace checkpoint
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_DELTA_CHECKPOINT_H_
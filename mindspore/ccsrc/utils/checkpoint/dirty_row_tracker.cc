@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/checkpoint/dirty_row_tracker.h"
+
+namespace mindspore {
+namespace checkpoint {
+DirtyRowTracker &DirtyRowTracker::GetInstance() {
+  static DirtyRowTracker instance;
+  return instance;
+}
+
+void DirtyRowTracker::MarkAll(const void *addr) {
+  if (!enabled_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = bitmaps_.find(addr);
+  if (iter != bitmaps_.end()) {
+    SetAll(&iter->second);
+  }
+}
+
+void DirtyRowTracker::Track(const void *addr, size_t row_num, const std::string &owner) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TrackLocked(addr, row_num, owner);
+}
+
+void DirtyRowTracker::TrackLocked(const void *addr, size_t row_num, const std::string &owner) {
+  auto &bitmap = bitmaps_[addr];
+  bitmap.owner = owner;
+  bitmap.row_num = row_num;
+  bitmap.sparse = false;
+  bitmap.all = false;
+  bitmap.bits.assign((row_num + kBitsPerWord - 1) / kBitsPerWord, 0);
+}
+
+bool DirtyRowTracker::TakeRows(const void *addr, size_t row_num, const std::string &owner,
+                               std::vector<int64_t> *rows) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = bitmaps_.find(addr);
+  if (iter == bitmaps_.end() || !iter->second.sparse || iter->second.all || iter->second.owner != owner ||
+      iter->second.row_num != row_num) {
+    // The caller saves the buffer in full
+    TrackLocked(addr, row_num, owner);
+    return false;
+  }
+  auto &bitmap = iter->second;
+  rows->clear();
+  for (size_t word = 0; word < bitmap.bits.size(); ++word) {
+    for (auto bits = bitmap.bits[word]; bits != 0; bits &= bits - 1) {
+      rows->push_back(static_cast<int64_t>(word * kBitsPerWord + __builtin_ctzll(bits)));
+    }
+    bitmap.bits[word] = 0;
+  }
+  return true;
+}
+
+void DirtyRowTracker::Retain(const std::unordered_set<const void *> &addrs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto iter = bitmaps_.begin(); iter != bitmaps_.end();) {
+    if (addrs.count(iter->first) == 0) {
+      iter = bitmaps_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+}  // namespace checkpoint
+}  // namespace mindspore
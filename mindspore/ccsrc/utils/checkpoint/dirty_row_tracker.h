@@ -0,0 +1,104 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_DIRTY_ROW_TRACKER_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_DIRTY_ROW_TRACKER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mindspore {
+namespace checkpoint {
+// Remembers the rows of the parameters that the sparse optimizers changed since the last native checkpoint, so that
+// a delta checkpoint writes only those rows. The CPU kernels update a parameter in place and know it by the address
+// of its data only, so a buffer is tracked under its address together with the id of the tensor that was saved from
+// it. A buffer that was freed and reused by another tensor, or a tensor whose data was replaced, does not match and
+// is saved in full. Only a buffer that a row-sparse optimizer updated has its rows taken, every other one is taken
+// as fully changed. Other kernels that write a tracked buffer mark it as a whole. Tracking starts
+// with the first native checkpoint, MarkRows costs nothing before.
+class DirtyRowTracker {
+ public:
+  static DirtyRowTracker &GetInstance();
+
+  void Enable() { enabled_ = true; }
+  bool enabled() const { return enabled_; }
+
+  template <typename T>
+  void MarkRows(const void *addr, size_t row_num, const T *rows, size_t size) {
+    if (!enabled_) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = bitmaps_.find(addr);
+    if (iter == bitmaps_.end() || iter->second.all) {
+      return;
+    }
+    auto &bitmap = iter->second;
+    if (bitmap.row_num != row_num) {
+      // Another parameter of another shape uses the buffer now
+      SetAll(&bitmap);
+      return;
+    }
+    bitmap.sparse = true;
+    for (size_t i = 0; i < size; ++i) {
+      auto row = static_cast<size_t>(rows[i]);
+      if (rows[i] >= 0 && row < row_num) {
+        bitmap.bits[row / kBitsPerWord] |= uint64_t(1) << (row % kBitsPerWord);
+      }
+    }
+  }
+  // For a kernel that writes the whole buffer
+  void MarkAll(const void *addr);
+  // The buffer of the tensor owner was saved in full, its rows are tracked from now on
+  void Track(const void *addr, size_t row_num, const std::string &owner);
+  // Returns false if the buffer is not tracked for owner, no sparse optimizer updated it or it changed as a whole,
+  // the caller then saves it in full. Otherwise takes its changed rows, in order. Either way the buffer is tracked
+  // for owner and clean afterwards.
+  bool TakeRows(const void *addr, size_t row_num, const std::string &owner, std::vector<int64_t> *rows);
+  // Stops tracking the buffers that are not in addrs, after a checkpoint of all the parameters
+  void Retain(const std::unordered_set<const void *> &addrs);
+
+ private:
+  static constexpr size_t kBitsPerWord = 64;
+
+  struct RowBitmap {
+    std::string owner;
+    size_t row_num{0};
+    bool sparse{false};
+    bool all{false};
+    std::vector<uint64_t> bits;
+  };
+
+  DirtyRowTracker() = default;
+  ~DirtyRowTracker() = default;
+  static void SetAll(RowBitmap *bitmap) {
+    bitmap->all = true;
+    bitmap->bits.clear();
+  }
+  void TrackLocked(const void *addr, size_t row_num, const std::string &owner);
+
+  std::atomic<bool> enabled_{false};
+  std::mutex mutex_;
+  std::unordered_map<const void *, RowBitmap> bitmaps_;
+};
+}  // namespace checkpoint
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_DIRTY_ROW_TRACKER_H_
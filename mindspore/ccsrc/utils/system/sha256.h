@@ -21,6 +21,8 @@
 #include <iomanip>
 #include <fstream>
 #include <memory>
+#include <climits>
+#include "securec/include/securec.h"
 
 namespace mindspore {
 namespace system {
@@ -46,7 +48,7 @@ inline uint32_t sigma1(uint32_t x) { return (x >> 6 | x << 26) ^ (x >> 11 | x <<
 inline uint32_t sigma2(uint32_t x) { return (x >> 7 | x << 25) ^ (x >> 18 | x << 14) ^ (x >> 3); }
 inline uint32_t sigma3(uint32_t x) { return (x >> 17 | x << 15) ^ (x >> 19 | x << 13) ^ (x >> 10); }
 
-std::string LoadFilePath(const std::string &path) {
+inline std::string LoadFilePath(const std::string &path) {
   char real_path[PATH_MAX] = {0};
 #if defined(_WIN32) || defined(_WIN64)
   if (path.size() > PATH_MAX || _fullpath(real_path, path.c_str(), PATH_MAX) == nullptr) {
@@ -65,7 +67,7 @@ std::string LoadFilePath(const std::string &path) {
   return message;
 }
 
-bool Padding(std::string *message) {
+inline bool Padding(std::string *message) {
   uint64_t bits_message = message->size() * kBitNumber;
   const int remains = message->size() % kMessageBlockLength;
   // The length of the message needs to be stored in 8 bytes, supplemented at the end of the message.
@@ -85,7 +87,7 @@ bool Padding(std::string *message) {
   return true;
 }
 
-bool ProcessInner(const std::string &message, const int &bias, uint32_t *digest, const int &digest_size) {
+inline bool ProcessInner(const std::string &message, const int &bias, uint32_t *digest, const int &digest_size) {
   if (digest_size != 8) {  // The number of digests is fixed at 8
     return false;
   }
@@ -125,7 +127,7 @@ bool ProcessInner(const std::string &message, const int &bias, uint32_t *digest,
   return true;
 }
 
-std::string ConvertToString(uint32_t *input, const int &size) {
+inline std::string ConvertToString(uint32_t *input, const int &size) {
   std::ostringstream oss;
   oss << std::hex;
   for (int i = 0; i < size; ++i) {
@@ -137,7 +139,7 @@ std::string ConvertToString(uint32_t *input, const int &size) {
   return oss.str();
 }
 
-std::string Encrypt(const std::string &message) {
+inline std::string Encrypt(const std::string &message) {
   uint32_t digest[kDigestSize] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
   for (int i = 0; i < static_cast<int>(message.size()); i += kMessageBlockLength) {
@@ -148,7 +150,7 @@ std::string Encrypt(const std::string &message) {
   return ConvertToString(digest, kDigestSize);
 }
 
-std::string GetHashFromString(const std::string &data) {
+inline std::string GetHashFromString(const std::string &data) {
   std::string message = data;
   if (message.empty() || !Padding(&message)) {
     return "";
@@ -156,7 +158,7 @@ std::string GetHashFromString(const std::string &data) {
   return Encrypt(message);
 }
 
-std::string GetHashFromFile(const std::string &path) {
+inline std::string GetHashFromFile(const std::string &path) {
   std::string message = LoadFilePath(path);
   if (message.empty() || !Padding(&message)) {
     return "";
@@ -213,6 +213,11 @@ class _Context:
             raise ValueError(f"Max call depth must be greater than 0, but got {max_call_depth}")
         self.set_param(ms_ctx_param.max_call_depth, max_call_depth)
 
+    def set_cpu_thread_num(self, cpu_thread_num):
+        if cpu_thread_num < 0:
+            raise ValueError(f"Cpu thread num must be greater than or equal to 0, but got {cpu_thread_num}")
+        self.set_param(ms_ctx_param.cpu_thread_num, cpu_thread_num)
+
     def set_profiling_options(self, option):
         options = ["training_trace", "task_trace",
                    "task_trace:training_trace", "training_trace:task_trace", "op_trace"]
@@ -264,6 +269,7 @@ class _Context:
         'device_target': set_device_target,
         'device_id': set_device_id,
         'max_call_depth': set_max_call_depth,
+        'cpu_thread_num': set_cpu_thread_num,
         'profiling_options': set_profiling_options,
         'variable_memory_max_size': set_variable_memory_max_size,
         'max_device_memory': set_max_device_memory,
@@ -461,7 +467,8 @@ def _check_target_specific_cfgs(device, arg_key):
         'profiling_options': ['Ascend'],
         'print_file_path': ['Ascend'],
         'variable_memory_max_size': ['Ascend'],
-        'max_device_memory': ['GPU']
+        'max_device_memory': ['GPU'],
+        'cpu_thread_num': ['CPU']
     }
     # configs not in map device_cfgs are supposed to be suitable for all devices
     if not arg_key in device_cfgs:
@@ -479,7 +486,7 @@ def _check_target_specific_cfgs(device, arg_key):
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool, max_call_depth=int)
+                 enable_sparse=bool, max_call_depth=int, cpu_thread_num=int)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -501,10 +508,10 @@ def set_context(**kwargs):
 
     Some configurations are device specific, see the bellow table for details:
 
-    ===========================  ===========================  =================
-    Common(CPU/GPU/Ascend)       Ascend                       GPU
-    ===========================  ===========================  =================
-    check_bprop                  enable_auto_mixed_precision  max_device_memory
+    ===========================  ===========================  =================  ==============
+    Common(CPU/GPU/Ascend)       Ascend                       GPU                CPU
+    ===========================  ===========================  =================  ==============
+    check_bprop                  enable_auto_mixed_precision  max_device_memory  cpu_thread_num
     device_id                    enable_dump                  enable_graph_kernel
     device_target                save_dump_path
     enable_sparse                enable_graph_kernel
@@ -513,7 +520,7 @@ def set_context(**kwargs):
     reserve_class_name_in_scope  profiling_options
     save_graphs                  variable_memory_max_size
     save_graphs_path             print_file_path
-    ===========================  ===========================  =================
+    ===========================  ===========================  =================  ==============
 
     Args:
         mode (int): Running in GRAPH_MODE(0) or PYNATIVE_MODE(1). Default: PYNATIVE_MODE(1).
@@ -555,6 +562,8 @@ def set_context(**kwargs):
             suffix to the file. Default: ''.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
         max_call_depth(int): Specify the maximum depth of function call. Default: 1000.
+        cpu_thread_num(int): Number of threads used by the intra-op thread pool of CPU kernels, 0 means the number
+            of hardware threads. Currently, it is only supported on CPU. Default: 0.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -576,6 +585,7 @@ def set_context(**kwargs):
         >>> context.set_context(max_device_memory="3.5GB")
         >>> context.set_context(print_file_path="print.pb")
         >>> context.set_context(max_call_depth=80)
+        >>> context.set_context(cpu_thread_num=8)
     """
     ctx = _context()
     # set device target first
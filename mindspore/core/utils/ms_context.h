@@ -83,6 +83,7 @@ enum MsCtxParam : unsigned {
   // paramater of type uint32
   MS_CTX_TYPE_UINT32_BEGIN = MS_CTX_TYPE_INT_END,
   MS_CTX_DEVICE_ID = MS_CTX_TYPE_UINT32_BEGIN,
+  MS_CTX_CPU_THREAD_NUM,
   MS_CTX_GE_REF,
   MS_CTX_MAX_CALL_DEPTH,
   MS_CTX_TSD_REF,
@@ -22,7 +22,9 @@ import mindspore._c_dataengine as cde
 
 __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'set_num_parallel_workers',
            'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval', 'load',
-           'get_callback_timeout']
+           'get_callback_timeout', 'set_lock_free_connector', 'get_lock_free_connector',
+           'set_mindrecord_mmap', 'get_mindrecord_mmap', 'set_enable_autotune', 'get_enable_autotune',
+           'set_autotune_interval', 'get_autotune_interval']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -198,6 +200,138 @@ def get_callback_timeout():
     return _config.get_callback_timeout()
 
 
+def set_lock_free_connector(enable):
+    """
+    Set whether the connectors between operations use lock free queues. This takes effect for the pipelines
+    created after the call.
+
+    Args:
+        enable (bool): Whether to use lock free queues.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Use lock free queues for the connectors of the pipelines created from now on.
+        >>> ds.config.set_lock_free_connector(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean.")
+    _config.set_lock_free_connector(enable)
+
+
+def get_lock_free_connector():
+    """
+    Get whether the connectors between operations use lock free queues.
+
+    Returns:
+        Bool, whether lock free queues are used.
+    """
+    return _config.get_lock_free_connector()
+
+
+def set_mindrecord_mmap(enable):
+    """
+    Set whether MindDataset maps the MindRecord files into memory. Mapped files are read without a copy per row,
+    and numeric columns are handed out as tensors over the read-only mapped pages. A map operation copies the
+    columns it processes, since its operations may modify them in place. This takes effect for the pipelines created
+    after the call.
+
+    Args:
+        enable (bool): Whether to map MindRecord files into memory.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Map the MindRecord files of the pipelines created from now on.
+        >>> ds.config.set_mindrecord_mmap(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean.")
+    _config.set_mindrecord_mmap(enable)
+
+
+def get_mindrecord_mmap():
+    """
+    Get whether MindDataset maps the MindRecord files into memory.
+
+    Returns:
+        Bool, whether MindRecord files are mapped.
+    """
+    return _config.get_mindrecord_mmap()
+
+
+def set_enable_autotune(enable):
+    """
+    Set whether pipelines adjust themselves while they run. An autotuned pipeline finds the operation that keeps
+    the consumer of the pipeline waiting and gives more workers to map and batch operations, starting from their
+    num_parallel_workers and within the CPU cores and memory of the machine. When the pipeline ends, the
+    configuration it ended with is logged together with advice for the settings that can not be changed while it
+    runs. This takes effect for the pipelines launched after the call.
+
+    Args:
+        enable (bool): Whether to autotune pipelines.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Autotune the pipelines launched from now on.
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a boolean.")
+    _config.set_enable_autotune(enable)
+
+
+def get_enable_autotune():
+    """
+    Get whether pipelines adjust themselves while they run.
+
+    Returns:
+        Bool, whether pipelines are autotuned.
+    """
+    return _config.get_enable_autotune()
+
+
+def set_autotune_interval(interval):
+    """
+    Set the interval (in milliseconds) between two adjustments of an autotuned pipeline.
+
+    Args:
+        interval (int): Interval (in milliseconds) between two adjustments.
+
+    Raises:
+        ValueError: If interval is invalid (<= 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> # Adjust autotuned pipelines every 500 milliseconds.
+        >>> ds.config.set_autotune_interval(500)
+    """
+    if interval <= 0 or interval > INT32_MAX:
+        raise ValueError("Interval given is not within the required range.")
+    _config.set_autotune_interval(interval)
+
+
+def get_autotune_interval():
+    """
+    Get the interval (in milliseconds) between two adjustments of an autotuned pipeline.
+
+    Returns:
+        Int, interval (in milliseconds) between two adjustments.
+    """
+    return _config.get_autotune_interval()
+
+
 def __str__():
     """
     String representation of the configurations.
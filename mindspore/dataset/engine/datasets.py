@@ -3805,6 +3805,10 @@ class TFRecordDataset(SourceDataset):
         shard_equal_rows (bool, optional): Get equal rows for all shards(default=False). If shard_equal_rows
             is false, number of rows of each shard may be not equal.
         cache (DatasetCache, optional): Tensor cache to use. (default=None which means no cache is used).
+        compression_type (str, optional): Compression of the files, "GZIP", "ZLIB" or "" for none
+            (default=None, detected from the first bytes of each file).
+        verify_crc (bool, optional): Check the crc of every record that is read (default=False).
+            The first record of each file is always checked.
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -3851,14 +3855,21 @@ class TFRecordDataset(SourceDataset):
         shard_id = replace_none(self.shard_id, 0)
         num_samples = replace_none(self.num_samples, 0)
 
+        if self.compression_type is None:
+            compression_type = "AUTO"
+        else:
+            compression_type = self.compression_type if self.compression_type else "NONE"
+
         return cde.TFRecordNode(self.dataset_files, schema, self.columns_list, num_samples,
                                 shuffle_flag,
                                 num_shards, shard_id,
-                                self.shard_equal_rows, cc).SetNumWorkers(self.num_parallel_workers)
+                                self.shard_equal_rows, cc, compression_type,
+                                self.verify_crc).SetNumWorkers(self.num_parallel_workers)
 
     @check_tfrecorddataset
     def __init__(self, dataset_files, schema=None, columns_list=None, num_samples=None, num_parallel_workers=None,
-                 shuffle=Shuffle.GLOBAL, num_shards=None, shard_id=None, shard_equal_rows=False, cache=None):
+                 shuffle=Shuffle.GLOBAL, num_shards=None, shard_id=None, shard_equal_rows=False, cache=None,
+                 compression_type=None, verify_crc=False):
         super().__init__(num_parallel_workers=num_parallel_workers)
         # todo push down to c++
         self.dataset_files = self._find_files(dataset_files)
@@ -3902,6 +3913,8 @@ class TFRecordDataset(SourceDataset):
         self.sampler = _select_sampler(self.num_samples, sampler, sampler_shuffle, num_shards, shard_id,
                                        non_mappable=True)
         self.shard_equal_rows = replace_none(shard_equal_rows, False)
+        self.compression_type = compression_type
+        self.verify_crc = replace_none(verify_crc, False)
 
     def get_args(self):
         args = super().get_args()
@@ -3924,6 +3937,8 @@ class TFRecordDataset(SourceDataset):
         args["num_shards"] = self.num_shards
         args["shard_id"] = self.shard_id
         args["shard_equal_rows"] = self.shard_equal_rows
+        args["compression_type"] = self.compression_type
+        args["verify_crc"] = self.verify_crc
         args["cache"] = self.cache.cache_client if self.cache is not None else None
         args["sampler"] = self.sampler
         return args
@@ -131,7 +131,7 @@ def check_tfrecorddataset(method):
 
         nreq_param_int = ['num_samples', 'num_parallel_workers', 'num_shards', 'shard_id']
         nreq_param_list = ['columns_list']
-        nreq_param_bool = ['shard_equal_rows']
+        nreq_param_bool = ['shard_equal_rows', 'verify_crc']
 
         dataset_files = param_dict.get('dataset_files')
         if not isinstance(dataset_files, (str, list)):
@@ -141,6 +141,10 @@ def check_tfrecorddataset(method):
         validate_dataset_param_value(nreq_param_list, param_dict, list)
         validate_dataset_param_value(nreq_param_bool, param_dict, bool)
 
+        compression_type = param_dict.get('compression_type')
+        if compression_type is not None:
+            check_valid_str(compression_type, ["", "GZIP", "ZLIB"], "compression_type")
+
         check_sampler_shuffle_shard_options(param_dict)
 
         cache = param_dict.get('cache')
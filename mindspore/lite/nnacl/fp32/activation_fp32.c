@@ -17,9 +17,15 @@
 #include "nnacl/fp32/activation_fp32.h"
 #include <float.h>
 #include "nnacl/errorcode.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 int Fp32Relu(const float *src, int length, float *dst) {
   int i = 0;
+#ifdef ENABLE_X86_64_AVX
+  i = ActivationX86(ActType_Relu, src, length, dst);
+#endif
 #ifdef ENABLE_ARM
   float32x4_t zero_4 = vdupq_n_f32(0.0f);
   for (; i < length - 4; i += 4) {
@@ -34,6 +40,9 @@ int Fp32Relu(const float *src, int length, float *dst) {
 
 int Fp32Relu6(const float *src, int length, float *dst) {
   int i = 0;
+#ifdef ENABLE_X86_64_AVX
+  i = ActivationX86(ActType_Relu6, src, length, dst);
+#endif
 #ifdef ENABLE_ARM
   float32x4_t zero_4 = vdupq_n_f32(0.0f);
   float32x4_t six_4 = vdupq_n_f32(6.0f);
@@ -74,7 +83,11 @@ int LRelu(const float *src, int length, float *dst, float alpha) {
 int Sigmoid(const float *src, int length, float *dst) {
   const float upper_bound = 16.619047164916992188f;
   const float lower_bound = -9.0f;
-  for (int i = 0; i < length; ++i) {
+  int i = 0;
+#ifdef ENABLE_X86_64_AVX
+  i = ActivationX86(ActType_Sigmod, src, length, dst);
+#endif
+  for (; i < length; ++i) {
     float input_val = src[i];
     float result;
     if (input_val > upper_bound) {
@@ -17,6 +17,9 @@
 #include "nnacl/fp32/arithmetic_fp32.h"
 #include <math.h>
 #include <float.h>
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 #define ACCURACY_DATA 0.00000001
 
@@ -27,6 +30,10 @@ int ElementOptMul(const float *input0, const float *input1, float *output, const
   float32x4_t vin1_opt = vdupq_n_f32(input1[0]);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Mul, ActType_No, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -61,6 +68,10 @@ int ElementOptMulRelu(const float *input0, const float *input1, float *output, c
   float32x4_t zeros = vdupq_n_f32(0.0f);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Mul, ActType_Relu, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -96,6 +107,10 @@ int ElementOptMulRelu6(const float *input0, const float *input1, float *output,
   float32x4_t bounds = vdupq_n_f32(6.0f);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Mul, ActType_Relu6, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -231,6 +246,10 @@ int ElementOptSub(const float *input0, const float *input1, float *output, const
   float32x4_t vin1_opt = vdupq_n_f32(input1[0]);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Sub, ActType_No, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -265,6 +284,10 @@ int ElementOptSubRelu(const float *input0, const float *input1, float *output, c
   float32x4_t zeros = vdupq_n_f32(0.0f);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Sub, ActType_Relu, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -300,6 +323,10 @@ int ElementOptSubRelu6(const float *input0, const float *input1, float *output,
   float32x4_t bounds = vdupq_n_f32(6.0f);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Sub, ActType_Relu6, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -333,6 +360,10 @@ int ElementOptAdd(const float *input0, const float *input1, float *output, const
   float32x4_t vin1_opt = vdupq_n_f32(input1[0]);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Add, ActType_No, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -400,6 +431,10 @@ int ElementOptAddRelu(const float *input0, const float *input1, float *output, c
   float32x4_t zeros = vdupq_n_f32(0.0f);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Add, ActType_Relu, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -435,6 +470,10 @@ int ElementOptAddRelu6(const float *input0, const float *input1, float *output,
   float32x4_t bounds = vdupq_n_f32(6.0f);
 #endif
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementOptArithmeticX86(SimdArith_Add, ActType_Relu6, input0, input1, output, element_size,
+                                  param->in_elements_num0_ == 1);
+#endif
   if (param->in_elements_num0_ == 1) {
 #ifdef ENABLE_NEON
     for (; index <= element_size - 4; index += C4NUM) {
@@ -464,15 +503,22 @@ int ElementOptAddRelu6(const float *input0, const float *input1, float *output,
 
 int ElementOptDiv(const float *input0, const float *input1, float *output, const int element_size,
                   const ArithmeticParameter *param) {
+  int index = 0;
   if (param->in_elements_num0_ == 1) {
-    for (int index = 0; index < element_size; index++) {
+#ifdef ENABLE_X86_64_AVX
+    index = ElementOptArithmeticX86(SimdArith_Div, ActType_No, input0, input1, output, element_size, true);
+#endif
+    for (; index < element_size; index++) {
       output[index] = input0[0] / input1[index];
     }
   } else {
     if (input1[0] == 0) {
       return NNACL_ERRCODE_DIVISOR_ZERO;
     }
-    for (int index = 0; index < element_size; index++) {
+#ifdef ENABLE_X86_64_AVX
+    index = ElementOptArithmeticX86(SimdArith_Div, ActType_No, input0, input1, output, element_size, false);
+#endif
+    for (; index < element_size; index++) {
       output[index] = input0[index] / input1[0];
     }
   }
@@ -481,13 +527,20 @@ int ElementOptDiv(const float *input0, const float *input1, float *output, const
 
 int ElementOptDivRelu(const float *input0, const float *input1, float *output, const int element_size,
                       const ArithmeticParameter *param) {
+  int index = 0;
   if (param->in_elements_num0_ == 1) {
-    for (int index = 0; index < element_size; index++) {
+#ifdef ENABLE_X86_64_AVX
+    index = ElementOptArithmeticX86(SimdArith_Div, ActType_Relu, input0, input1, output, element_size, true);
+#endif
+    for (; index < element_size; index++) {
       output[index] = input0[0] / input1[index];
       output[index] = output[index] > 0 ? output[index] : 0;
     }
   } else {
-    for (int index = 0; index < element_size; index++) {
+#ifdef ENABLE_X86_64_AVX
+    index = ElementOptArithmeticX86(SimdArith_Div, ActType_Relu, input0, input1, output, element_size, false);
+#endif
+    for (; index < element_size; index++) {
       output[index] = input0[index] / input1[0];
       output[index] = output[index] > 0 ? output[index] : 0;
     }
@@ -497,12 +550,19 @@ int ElementOptDivRelu(const float *input0, const float *input1, float *output, c
 
 int ElementOptDivRelu6(const float *input0, const float *input1, float *output, const int element_size,
                        const ArithmeticParameter *param) {
+  int index = 0;
   if (param->in_elements_num0_ == 1) {
-    for (int index = 0; index < element_size; index++) {
+#ifdef ENABLE_X86_64_AVX
+    index = ElementOptArithmeticX86(SimdArith_Div, ActType_Relu6, input0, input1, output, element_size, true);
+#endif
+    for (; index < element_size; index++) {
       output[index] = MSMIN(MSMAX(input0[0] / input1[index], 0), 6);
     }
   } else {
-    for (int index = 0; index < element_size; index++) {
+#ifdef ENABLE_X86_64_AVX
+    index = ElementOptArithmeticX86(SimdArith_Div, ActType_Relu6, input0, input1, output, element_size, false);
+#endif
+    for (; index < element_size; index++) {
       output[index] = MSMIN(MSMAX(input0[index] / input1[0], 0), 6);
     }
   }
@@ -511,6 +571,9 @@ int ElementOptDivRelu6(const float *input0, const float *input1, float *output,
 
 int ElementMul(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Mul, ActType_No, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   for (; index <= element_size - 4; index += C4NUM) {
     float32x4_t vin0 = vld1q_f32(input0 + index);
@@ -527,6 +590,9 @@ int ElementMul(const float *input0, const float *input1, float *output, const in
 
 int ElementMulRelu(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Mul, ActType_Relu, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   float32x4_t zeros = vdupq_n_f32(0.0f);
   for (; index <= element_size - 4; index += C4NUM) {
@@ -546,6 +612,9 @@ int ElementMulRelu(const float *input0, const float *input1, float *output, cons
 
 int ElementMulRelu6(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Mul, ActType_Relu6, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   float32x4_t zeros = vdupq_n_f32(0.0f);
   float32x4_t bounds = vdupq_n_f32(6.0f);
@@ -623,6 +692,9 @@ int BroadcastMul(const float *input0, const float *input1, float *tile_input0, f
 
 int ElementAdd(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Add, ActType_No, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   for (; index <= element_size - 4; index += C4NUM) {
     float32x4_t vin0 = vld1q_f32(input0 + index);
@@ -639,6 +711,9 @@ int ElementAdd(const float *input0, const float *input1, float *output, const in
 
 int ElementAddRelu(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Add, ActType_Relu, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   float32x4_t zeros = vdupq_n_f32(0.0f);
   for (; index <= element_size - 4; index += C4NUM) {
@@ -658,6 +733,9 @@ int ElementAddRelu(const float *input0, const float *input1, float *output, cons
 
 int ElementAddRelu6(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Add, ActType_Relu6, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   float32x4_t zeros = vdupq_n_f32(0.0f);
   float32x4_t bounds = vdupq_n_f32(6.0f);
@@ -711,6 +789,9 @@ int BroadcastAddInt8(const int8_t *input0, const int8_t *input1, int8_t *tile_in
 
 int ElementSub(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Sub, ActType_No, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   for (; index <= element_size - 4; index += C4NUM) {
     float32x4_t vin0 = vld1q_f32(input0 + index);
@@ -743,6 +824,9 @@ int ElementSubInt(const int *input0, const int *input1, int *output, const int e
 
 int ElementSubRelu(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Sub, ActType_Relu, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   float32x4_t zeros = vdupq_n_f32(0.0f);
   for (; index <= element_size - 4; index += C4NUM) {
@@ -762,6 +846,9 @@ int ElementSubRelu(const float *input0, const float *input1, float *output, cons
 
 int ElementSubRelu6(const float *input0, const float *input1, float *output, const int element_size) {
   int index = 0;
+#ifdef ENABLE_X86_64_AVX
+  index = ElementArithmeticX86(SimdArith_Sub, ActType_Relu6, input0, input1, output, element_size);
+#endif
 #ifdef ENABLE_NEON
   float32x4_t zeros = vdupq_n_f32(0.0f);
   float32x4_t bounds = vdupq_n_f32(6.0f);
@@ -786,14 +873,22 @@ int BroadcastSub(const float *input0, const float *input1, float *tile_input0, f
 }
 
 int ElementDiv(const float *input0, const float *input1, float *output, const int element_size) {
-  for (int i = 0; i < element_size; i++) {
+  int i = 0;
+#ifdef ENABLE_X86_64_AVX
+  i = ElementArithmeticX86(SimdArith_Div, ActType_No, input0, input1, output, element_size);
+#endif
+  for (; i < element_size; i++) {
     output[i] = input0[i] / input1[i];
   }
   return NNACL_OK;
 }
 
 int ElementDivRelu(const float *input0, const float *input1, float *output, const int element_size) {
-  for (int i = 0; i < element_size; i++) {
+  int i = 0;
+#ifdef ENABLE_X86_64_AVX
+  i = ElementArithmeticX86(SimdArith_Div, ActType_Relu, input0, input1, output, element_size);
+#endif
+  for (; i < element_size; i++) {
     float res = input0[i] / input1[i];
     output[i] = res > 0 ? res : 0;
   }
@@ -801,7 +896,11 @@ int ElementDivRelu(const float *input0, const float *input1, float *output, cons
 }
 
 int ElementDivRelu6(const float *input0, const float *input1, float *output, const int element_size) {
-  for (int i = 0; i < element_size; i++) {
+  int i = 0;
+#ifdef ENABLE_X86_64_AVX
+  i = ElementArithmeticX86(SimdArith_Div, ActType_Relu6, input0, input1, output, element_size);
+#endif
+  for (; i < element_size; i++) {
     output[i] = MSMIN(MSMAX(input0[i] / input1[i], 0), 6);
   }
   return NNACL_OK;
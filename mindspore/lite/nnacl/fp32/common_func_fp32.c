@@ -15,6 +15,9 @@
  */
 
 #include "nnacl/fp32/common_func_fp32.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 void PostConvFuncComm(const float *src_ptr_, float *out_ptr, const float *bias_ptr, size_t output_channel,
                       size_t plane_size, size_t plane_stride, size_t oc_stride, ActType relu_type, int size) {
@@ -43,6 +46,11 @@ void PostConvFuncComm(const float *src_ptr_, float *out_ptr, const float *bias_p
 
 void PostConvFuncFp32C8(const float *c8_out_ptr, float *out_ptr, const float *bias_ptr, size_t output_channel,
                         size_t plane_size, size_t stride, size_t relu_type) {
+#ifdef ENABLE_X86_64_AVX
+  if (PostConvFuncC8X86(c8_out_ptr, out_ptr, bias_ptr, output_channel, plane_size, stride, relu_type)) {
+    return;
+  }
+#endif
 #if !defined(ENABLE_ARM) && !defined(ENABLE_X86_64_SSE)
   PostConvFuncComm(c8_out_ptr, out_ptr, bias_ptr, output_channel, plane_size, plane_size, stride, relu_type, C8NUM);
 #else
@@ -70,6 +78,11 @@ void PostConvFuncFp32C4(const float *c4_out_ptr, float *out_ptr, const float *bi
 
 #if !defined(ENABLE_ARM) && !defined(ENABLE_X86_64_SSE)
 void WinogradTransLeft(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+#ifdef ENABLE_X86_64_AVX
+  if (WinogradTransLeftX86(S, B, M, w, h, k, length)) {
+    return;
+  }
+#endif
   const int unitStep = 4 * length;
   for (int y = 0; y < h; ++y) {
     float *dstY = M + y * w * unitStep;
@@ -93,6 +106,11 @@ void WinogradTransLeft(const float *S, const float *B, float *M, size_t w, size_
 
 // M = S * B , M = w*h * l, S = k*h * l, B = w*k
 void WinogradTransRight(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+#ifdef ENABLE_X86_64_AVX
+  if (WinogradTransRightX86(S, B, M, w, h, k, length)) {
+    return;
+  }
+#endif
   const int unitStep = 4 * length;
   for (int y = 0; y < h; ++y) {
     float *dstY = M + y * w * unitStep;
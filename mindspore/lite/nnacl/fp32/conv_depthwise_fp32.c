@@ -17,6 +17,9 @@
 #include "nnacl/fp32/conv_depthwise_fp32.h"
 #include "nnacl/fp32/common_func_fp32.h"
 #include "nnacl/winograd_transform.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 #ifdef ENABLE_ARM64
 #include <arm_neon.h>
 #endif
@@ -285,6 +288,14 @@ void ConvDwSWFp32(float *output_data, const float *input_data, const float *weig
         int in_w_start = sliding->left_ * conv_param->stride_w_ - conv_param->pad_l_;
         const float *in_t = src_data + in_h_start * sliding->in_h_step_ + in_w_start * sliding->block_channel_;
         float *out_t = dst_data + sliding->top_ * sliding->out_h_step_ + sliding->left_ * sliding->block_channel_;
+#ifdef ENABLE_X86_64_AVX
+        if (ConvDwCenterX86(out_t, in_t, weight, bias, sliding->bottom_ - sliding->top_,
+                            sliding->right_ - sliding->left_, conv_param->kernel_h_, conv_param->kernel_w_,
+                            sliding->out_h_step_, sliding->block_channel_, sliding->in_sh_step_, sliding->in_sw_step_,
+                            sliding->in_kh_step_, sliding->in_kw_step_, relu, relu6)) {
+          continue;
+        }
+#endif
 #if defined(ENABLE_ARM) || defined(ENABLE_X86_64_SSE)
         ConvDwFp32Center(out_t, in_t, weight, bias, sliding->bottom_ - sliding->top_, sliding->right_ - sliding->left_,
                          conv_param->kernel_h_, conv_param->kernel_w_, sliding->out_h_step_ * sizeof(float),
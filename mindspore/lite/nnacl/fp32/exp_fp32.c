@@ -18,6 +18,9 @@
 #include <math.h>
 #include <string.h>
 #include "nnacl/errorcode.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 int Exp(const float *input_data, float *output_data, const ExpParameter *parameter, int task_id) {
   if (parameter->scale_ == 1) {
@@ -40,6 +43,9 @@ int Exp(const float *input_data, float *output_data, const ExpParameter *paramet
 void ExpFp32(const float *src, float *dst, int num) {
   int i = 0;
   const float param[] = {log(2.0f), 1.0f / 120, 1.0f / 24, 1.0f / 6, 1.0f / 2, 1.0f};
+#ifdef ENABLE_X86_64_AVX
+  i = ExpX86(src, dst, num);
+#endif
 #ifdef ENABLE_ARM64
   float32x4_t maxv = vdupq_n_f32(88.0f);
   float32x4_t minv = vdupq_n_f32(-88.0f);
@@ -17,6 +17,9 @@
 #include <math.h>
 #include "nnacl/errorcode.h"
 #include "nnacl/op_base.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 int LayerNorm(int outer_size, int inner_size, const float *src_data, const float *gamma_data, const float *beta_data,
               bool affine, float epsilon, float *dst_data, int tid, int thread_num) {
@@ -29,6 +32,11 @@ int LayerNorm(int outer_size, int inner_size, const float *src_data, const float
   for (int j = tid; j < outer_size; j += thread_num) {
     const float *src = src_data + j * inner_size;
     float *dst = dst_data + j * inner_size;
+#ifdef ENABLE_X86_64_AVX
+    if (LayerNormRowX86(src, gamma_data, beta_data, affine, epsilon, dst, inner_size)) {
+      continue;
+    }
+#endif
     float mean = 0.0f;
     float square_mean = 0.0f;
     for (int i = 0; i < inner_size; i++) {
@@ -15,6 +15,9 @@
  */
 
 #include "nnacl/fp32/matmul_fp32.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 void RowMajor2ColMajor(const float *src_ptr, float *dst_ptr, int row, int col) {
   for (int r = 0; r < row; ++r) {
@@ -671,12 +674,22 @@ void MatMulOpt(const float *a, const float *b, float *c, const float *bias, ActT
     MatmulFloatNeon32Opt(a, b, c, bias, (int)act_type, deep, row, col, stride, (int)(out_type));
   }
 #elif ENABLE_X86_64_SSE
+#ifdef ENABLE_X86_64_AVX
+  if (MatMulX86(a, b, c, bias, act_type, deep, row, col, stride, out_type, C4NUM)) {
+    return;
+  }
+#endif
   if (out_type == OutType_C8) {
     MatmulFloatSse64(a, b, c, bias, (int)act_type, deep, row, col, stride, 0, 0);
   } else {
     MatmulFloatSse64Opt(a, b, c, bias, (int)act_type, deep, row, col, stride, (int)(out_type));
   }
 #else
+#ifdef ENABLE_X86_64_AVX
+  if (MatMulX86(a, b, c, bias, act_type, deep, row, col, stride, out_type, C12NUM)) {
+    return;
+  }
+#endif
   MatMul12x8(a, b, c, bias, act_type, deep, row, col, stride, out_type);
 #endif
 }
@@ -17,6 +17,9 @@
 #include "nnacl/fp32/pooling_fp32.h"
 #include <float.h>
 #include "nnacl/errorcode.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 int AvgPooling(const float *input_ptr, float *output_ptr, const PoolingParameter *pooling_param, int task_id,
                float minf, float maxf) {
@@ -58,7 +61,18 @@ int AvgPooling(const float *input_ptr, float *output_ptr, const PoolingParameter
         int real_win_w_start = MSMAX(0, -in_w_index);
         int real_win_w_end = MSMIN(win_w, in_w - in_w_index);
 
-        for (int ci = 0; ci < c4; ci++) {
+        int c4_start = 0;
+#ifdef ENABLE_X86_64_AVX
+        int real_win_h = MSMAX(0, real_win_h_end - real_win_h_start);
+        int real_win_w = MSMAX(0, real_win_w_end - real_win_w_start);
+        int win_count = pooling_param->avg_mode_ == 1 ? window : real_win_h * real_win_w;
+        const float *src_win_ptr =
+          src_plane_ptr + ((in_h_index + real_win_h_start) * in_w + in_w_index + real_win_w_start) * channel;
+        c4_start = AvgPoolingPixelX86(src_win_ptr, dst_plane_ptr, channel, in_w * channel, real_win_h, real_win_w,
+                                      win_count, minf, maxf) /
+                   C4NUM;
+#endif
+        for (int ci = c4_start; ci < c4; ci++) {
           const float *src_c_ptr = src_plane_ptr + ci * C4NUM;
           float *dst_c_ptr = dst_plane_ptr + ci * C4NUM;
 #ifdef ENABLE_NEON
@@ -184,7 +198,17 @@ void MaxPooling(const float *input_ptr, float *output_ptr, const PoolingParamete
         int real_win_w_start = MSMAX(0, -in_w_index);
         int real_win_w_end = MSMIN(win_w, in_w - in_w_index);
 
-        for (int ci = 0; ci < c4; ci++) {
+        int c4_start = 0;
+#ifdef ENABLE_X86_64_AVX
+        int real_win_h = MSMAX(0, real_win_h_end - real_win_h_start);
+        int real_win_w = MSMAX(0, real_win_w_end - real_win_w_start);
+        const float *src_win_ptr =
+          src_plane_ptr + ((in_h_index + real_win_h_start) * in_w + in_w_index + real_win_w_start) * channel;
+        c4_start = MaxPoolingPixelX86(src_win_ptr, dst_plane_ptr, channel, in_w * channel, real_win_h, real_win_w, minf,
+                                      maxf) /
+                   C4NUM;
+#endif
+        for (int ci = c4_start; ci < c4; ci++) {
           const float *src_c_ptr = src_plane_ptr + ci * C4NUM;
           float *dst_c_ptr = dst_plane_ptr + ci * C4NUM;
 #ifdef ENABLE_NEON
@@ -16,6 +16,9 @@
 #include "nnacl/fp32/softmax_fp32.h"
 #include <math.h>
 #include "nnacl/fp32/exp_fp32.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 void SoftmaxNorm(const float *src, float *dst, int batch, int channel) {
   int cur_batch_offset = 0;
@@ -82,6 +85,11 @@ void SumAndDiv(const float *src, float *dst, int batch, int channel) {
 }
 
 void SoftmaxLastAxis(const float *src, float *dst, int batch, int channel) {
+#ifdef ENABLE_X86_64_AVX
+  if (SoftmaxLastAxisX86(src, dst, batch, channel)) {
+    return;
+  }
+#endif
   SoftmaxNorm(src, dst, batch, channel);
   ExpFp32(dst, dst, batch * channel);
   SumAndDiv(dst, dst, batch, channel);
@@ -18,6 +18,9 @@
 #include <string.h>
 #include "nnacl/int8/conv_int8.h"
 #include "nnacl/pack.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 void PackWeightKHWToHWKFp32(const void *src, void *dst, int plane, int channel) {
   return PackNCHWToNHWCFp32(src, dst, 1, plane, channel);
@@ -741,6 +744,11 @@ void PackNCHWToNHWCInt8(const void *src, void *dst, int batch, int plane, int ch
 
 #ifndef ENABLE_X86_64_SSE
 void PackNHWCToNCHWFp32(const void *src, void *dst, int batches, int plane, int channel) {
+#ifdef ENABLE_X86_64_AVX
+  if (PackNHWCToNCHWFp32X86(src, dst, batches, plane, channel)) {
+    return;
+  }
+#endif
   int hw8 = plane / C8NUM * C8NUM;
   int c8 = channel / C8NUM * C8NUM;
   int batch = plane * channel;
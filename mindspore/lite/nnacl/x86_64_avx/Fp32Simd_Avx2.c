@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_X86_64_AVX
+#include <immintrin.h>
+#include "nnacl/x86_64_avx/avx_fp32_kernels.h"
+
+static inline float ReduceAddAvx2(__m256 v) {
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+}
+
+static inline float ReduceMaxAvx2(__m256 v) {
+  __m128 max = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+  max = _mm_max_ss(max, _mm_shuffle_ps(max, max, 1));
+  return _mm_cvtss_f32(max);
+}
+
+#define MS_SIMD_WIDTH C8NUM
+#define MS_FLOAT_SIMD __m256
+#define MS_INT_SIMD __m256i
+#define SIMD_FUNC(name) name##Avx2
+#define MS_SIMD_LD _mm256_loadu_ps
+#define MS_SIMD_ST _mm256_storeu_ps
+#define MS_SIMD_SET1 _mm256_set1_ps
+#define MS_SIMD_ZERO _mm256_setzero_ps
+#define MS_SIMD_ADD _mm256_add_ps
+#define MS_SIMD_SUB _mm256_sub_ps
+#define MS_SIMD_MUL _mm256_mul_ps
+#define MS_SIMD_DIV _mm256_div_ps
+#define MS_SIMD_MAX _mm256_max_ps
+#define MS_SIMD_MIN _mm256_min_ps
+#define MS_SIMD_FMADD _mm256_fmadd_ps
+#define MS_SIMD_FLOOR _mm256_floor_ps
+#define MS_SIMD_CVTT_EPI32 _mm256_cvttps_epi32
+#define MS_SIMD_ADD_EPI32 _mm256_add_epi32
+#define MS_SIMD_SET1_EPI32 _mm256_set1_epi32
+#define MS_SIMD_SLLI_EPI32 _mm256_slli_epi32
+#define MS_SIMD_CAST_PS _mm256_castsi256_ps
+#define MS_SIMD_REDUCE_ADD ReduceAddAvx2
+#define MS_SIMD_REDUCE_MAX ReduceMaxAvx2
+
+#include "nnacl/x86_64_avx/simd_fp32_template.h"
+#endif
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_X86_64_AVX
+#include <immintrin.h>
+#include "nnacl/x86_64_avx/avx_fp32_kernels.h"
+
+static inline __m512 FloorAvx512(__m512 v) { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+#define MS_SIMD_WIDTH C16NUM
+#define MS_FLOAT_SIMD __m512
+#define MS_INT_SIMD __m512i
+#define SIMD_FUNC(name) name##Avx512
+#define MS_SIMD_LD _mm512_loadu_ps
+#define MS_SIMD_ST _mm512_storeu_ps
+#define MS_SIMD_SET1 _mm512_set1_ps
+#define MS_SIMD_ZERO _mm512_setzero_ps
+#define MS_SIMD_ADD _mm512_add_ps
+#define MS_SIMD_SUB _mm512_sub_ps
+#define MS_SIMD_MUL _mm512_mul_ps
+#define MS_SIMD_DIV _mm512_div_ps
+#define MS_SIMD_MAX _mm512_max_ps
+#define MS_SIMD_MIN _mm512_min_ps
+#define MS_SIMD_FMADD _mm512_fmadd_ps
+#define MS_SIMD_FLOOR FloorAvx512
+#define MS_SIMD_CVTT_EPI32 _mm512_cvttps_epi32
+#define MS_SIMD_ADD_EPI32 _mm512_add_epi32
+#define MS_SIMD_SET1_EPI32 _mm512_set1_epi32
+#define MS_SIMD_SLLI_EPI32 _mm512_slli_epi32
+#define MS_SIMD_CAST_PS _mm512_castsi512_ps
+#define MS_SIMD_REDUCE_ADD _mm512_reduce_add_ps
+#define MS_SIMD_REDUCE_MAX _mm512_reduce_max_ps
+
+#include "nnacl/x86_64_avx/simd_fp32_template.h"
+#endif
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_X86_64_AVX
+#include <immintrin.h>
+#include "nnacl/matmul_parameter.h"
+#include "nnacl/x86_64_avx/avx_fp32_kernels.h"
+
+static inline __m256i ColMaskAvx2(int col_remain) {
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32(col_remain), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+static inline void MulAdd4RowsAvx2(const float *a, __m256 b, __m256 *acc) {
+  acc[0] = _mm256_fmadd_ps(_mm256_broadcast_ss(a), b, acc[0]);
+  acc[1] = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 1), b, acc[1]);
+  acc[2] = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 2), b, acc[2]);
+  acc[3] = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 3), b, acc[3]);
+}
+
+// One row tile of a times one 8 column block of b, the sums stay in registers over the whole depth
+static void MatMulTile4x8Avx2(const float *a, const float *b, int deep, __m256 *acc) {
+  __m256 sum[C4NUM] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+  for (int d = 0; d < deep; ++d) {
+    MulAdd4RowsAvx2(a + d * C4NUM, _mm256_loadu_ps(b + d * C8NUM), sum);
+  }
+  for (int r = 0; r < C4NUM; ++r) {
+    acc[r] = sum[r];
+  }
+}
+
+static void MatMulTile12x8Avx2(const float *a, const float *b, int deep, __m256 *acc) {
+  __m256 sum[C12NUM];
+  for (int r = 0; r < C12NUM; ++r) {
+    sum[r] = _mm256_setzero_ps();
+  }
+  for (int d = 0; d < deep; ++d) {
+    __m256 b_vec = _mm256_loadu_ps(b + d * C8NUM);
+    const float *a_d = a + d * C12NUM;
+    MulAdd4RowsAvx2(a_d, b_vec, sum);
+    MulAdd4RowsAvx2(a_d + 4, b_vec, sum + 4);
+    MulAdd4RowsAvx2(a_d + 8, b_vec, sum + 8);
+  }
+  for (int r = 0; r < C12NUM; ++r) {
+    acc[r] = sum[r];
+  }
+}
+
+static inline __m256 ActivateAvx2(__m256 value, int act_type) {
+  if (act_type == ActType_Relu6) {
+    value = _mm256_min_ps(value, _mm256_set1_ps(6.0f));
+  }
+  if (act_type != ActType_No) {
+    value = _mm256_max_ps(value, _mm256_setzero_ps());
+  }
+  return value;
+}
+
+void MatMulAvx2(const float *a, const float *b, float *c, const float *bias, int act_type, int deep, int row, int col,
+                size_t stride, int out_type, int row_tile) {
+  __m256 acc[C12NUM];
+  int row_up = UP_ROUND(row, row_tile);
+  for (int r = 0; r < row; r += row_tile) {
+    const float *a_tile = a + r * deep;
+    int row_num = out_type == OutType_C8 ? row_tile : MSMIN(row_tile, row - r);
+    for (int cb = 0; cb < col; cb += C8NUM) {
+      int col_remain = col - cb;
+      __m256i mask = ColMaskAvx2(col_remain);
+      if (row_tile == C12NUM) {
+        MatMulTile12x8Avx2(a_tile, b + cb * deep, deep, acc);
+      } else {
+        MatMulTile4x8Avx2(a_tile, b + cb * deep, deep, acc);
+      }
+      __m256 bias_vec = _mm256_setzero_ps();
+      if (bias != NULL) {
+        bias_vec = col_remain >= C8NUM ? _mm256_loadu_ps(bias + cb) : _mm256_maskload_ps(bias + cb, mask);
+      }
+      if (out_type == OutType_C8) {
+        // Padded rows and columns are written too, like the other kernels do
+        float *dst = c + cb * row_up + r * C8NUM;
+        for (int i = 0; i < row_num; ++i) {
+          _mm256_storeu_ps(dst + i * C8NUM, ActivateAvx2(_mm256_add_ps(acc[i], bias_vec), act_type));
+        }
+      } else {
+        float *dst = c + r * stride + cb;
+        for (int i = 0; i < row_num; ++i) {
+          __m256 value = ActivateAvx2(_mm256_add_ps(acc[i], bias_vec), act_type);
+          if (col_remain >= C8NUM) {
+            _mm256_storeu_ps(dst + i * stride, value);
+          } else {
+            _mm256_maskstore_ps(dst + i * stride, mask, value);
+          }
+        }
+      }
+    }
+  }
+}
+
+void PostConvFuncC8Avx2(const float *c8_out, float *out, const float *bias, size_t output_channel, size_t plane_size,
+                        size_t stride, size_t relu_type) {
+  __m256 zero = _mm256_setzero_ps();
+  __m256 six = _mm256_set1_ps(6.0f);
+  for (size_t oc = 0; oc < output_channel; oc += C8NUM) {
+    int oc_remain = (int)(output_channel - oc);
+    __m256i mask = ColMaskAvx2(oc_remain);
+    const float *src = c8_out + oc * plane_size;
+    float *dst = out + oc;
+    __m256 bias_vec = zero;
+    if (bias != NULL) {
+      bias_vec = oc_remain >= C8NUM ? _mm256_loadu_ps(bias + oc) : _mm256_maskload_ps(bias + oc, mask);
+    }
+    for (size_t hw = 0; hw < plane_size; ++hw) {
+      __m256 value = _mm256_add_ps(_mm256_loadu_ps(src + hw * C8NUM), bias_vec);
+      if (relu_type == ActType_Relu || relu_type == ActType_Relu6) {
+        value = _mm256_max_ps(value, zero);
+      }
+      if (relu_type == ActType_Relu6) {
+        value = _mm256_min_ps(value, six);
+      }
+      if (oc_remain >= C8NUM) {
+        _mm256_storeu_ps(dst + hw * stride, value);
+      } else {
+        _mm256_maskstore_ps(dst + hw * stride, mask, value);
+      }
+    }
+  }
+}
+#endif
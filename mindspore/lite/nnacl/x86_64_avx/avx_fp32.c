@@ -0,0 +1,212 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#include "nnacl/matmul_parameter.h"
+#include "nnacl/x86_64_avx/avx_fp32_kernels.h"
+
+// This file is built with the baseline flags, it must not use avx itself.
+
+static int cpu_simd_level = -1;
+static int max_simd_level = X86Simd_Avx512;
+
+static X86SimdLevel DetectX86SimdLevel(void) {
+  __builtin_cpu_init();
+  // __builtin_cpu_supports also checks that the os saves the ymm and zmm registers
+  if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+    return X86Simd_None;
+  }
+  if (!__builtin_cpu_supports("avx512f")) {
+    return X86Simd_Avx2;
+  }
+  return X86Simd_Avx512;
+}
+
+X86SimdLevel GetX86SimdLevel(void) {
+  // Every thread computes the same value, so racing on the first call is harmless
+  if (cpu_simd_level < 0) {
+    cpu_simd_level = DetectX86SimdLevel();
+  }
+  return (X86SimdLevel)MSMIN(cpu_simd_level, max_simd_level);
+}
+
+void SetX86SimdLevel(X86SimdLevel level) { max_simd_level = level; }
+
+int ElementArithmeticX86(SimdArithmeticOp op, ActType act, const float *input0, const float *input1, float *output,
+                         int element_size) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      return ElementArithmeticAvx512(op, act, input0, input1, output, element_size);
+    case X86Simd_Avx2:
+      return ElementArithmeticAvx2(op, act, input0, input1, output, element_size);
+    default:
+      return 0;
+  }
+}
+
+int ElementOptArithmeticX86(SimdArithmeticOp op, ActType act, const float *input0, const float *input1, float *output,
+                            int element_size, bool first_scalar) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      return ElementOptArithmeticAvx512(op, act, input0, input1, output, element_size, first_scalar);
+    case X86Simd_Avx2:
+      return ElementOptArithmeticAvx2(op, act, input0, input1, output, element_size, first_scalar);
+    default:
+      return 0;
+  }
+}
+
+int ActivationX86(ActType type, const float *src, int length, float *dst) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      return ActivationAvx512(type, src, length, dst);
+    case X86Simd_Avx2:
+      return ActivationAvx2(type, src, length, dst);
+    default:
+      return 0;
+  }
+}
+
+int ExpX86(const float *src, float *dst, int num) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      return ExpAvx512(src, dst, num);
+    case X86Simd_Avx2:
+      return ExpAvx2(src, dst, num);
+    default:
+      return 0;
+  }
+}
+
+bool SoftmaxLastAxisX86(const float *src, float *dst, int batch, int channel) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      SoftmaxLastAxisAvx512(src, dst, batch, channel);
+      return true;
+    case X86Simd_Avx2:
+      SoftmaxLastAxisAvx2(src, dst, batch, channel);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool LayerNormRowX86(const float *src, const float *gamma, const float *beta, bool affine, float epsilon, float *dst,
+                     int inner_size) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      LayerNormRowAvx512(src, gamma, beta, affine, epsilon, dst, inner_size);
+      return true;
+    case X86Simd_Avx2:
+      LayerNormRowAvx2(src, gamma, beta, affine, epsilon, dst, inner_size);
+      return true;
+    default:
+      return false;
+  }
+}
+
+int AvgPoolingPixelX86(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w, int count,
+                       float minf, float maxf) {
+  if (count == 0) {
+    return 0;
+  }
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      return AvgPoolingPixelAvx512(src, dst, channel, in_row_stride, win_h, win_w, count, minf, maxf);
+    case X86Simd_Avx2:
+      return AvgPoolingPixelAvx2(src, dst, channel, in_row_stride, win_h, win_w, count, minf, maxf);
+    default:
+      return 0;
+  }
+}
+
+int MaxPoolingPixelX86(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w, float minf,
+                       float maxf) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      return MaxPoolingPixelAvx512(src, dst, channel, in_row_stride, win_h, win_w, minf, maxf);
+    case X86Simd_Avx2:
+      return MaxPoolingPixelAvx2(src, dst, channel, in_row_stride, win_h, win_w, minf, maxf);
+    default:
+      return 0;
+  }
+}
+
+bool MatMulX86(const float *a, const float *b, float *c, const float *bias, ActType act_type, int deep, int row,
+               int col, size_t stride, int out_type, int row_tile) {
+  if (GetX86SimdLevel() < X86Simd_Avx2 || (out_type != OutType_C8 && out_type != OutType_Nhwc) ||
+      (row_tile != C4NUM && row_tile != C12NUM)) {
+    return false;
+  }
+  MatMulAvx2(a, b, c, bias, act_type, deep, row, col, stride, out_type, row_tile);
+  return true;
+}
+
+bool PostConvFuncC8X86(const float *c8_out, float *out, const float *bias, size_t output_channel, size_t plane_size,
+                       size_t stride, size_t relu_type) {
+  if (GetX86SimdLevel() < X86Simd_Avx2) {
+    return false;
+  }
+  PostConvFuncC8Avx2(c8_out, out, bias, output_channel, plane_size, stride, relu_type);
+  return true;
+}
+
+bool ConvDwCenterX86(float *dst, const float *src, const float *weight, const float *bias, int height, int width,
+                     int kernel_h, int kernel_w, int out_h_step, int block_channel, int in_sh_step, int in_sw_step,
+                     int in_kh_step, int in_kw_step, bool is_relu, bool is_relu6) {
+  if (GetX86SimdLevel() < X86Simd_Avx2) {
+    return false;
+  }
+  ConvDwCenterAvx2(dst, src, weight, bias, height, width, kernel_h, kernel_w, out_h_step, block_channel, in_sh_step,
+                   in_sw_step, in_kh_step, in_kw_step, is_relu, is_relu6);
+  return true;
+}
+
+bool WinogradTransLeftX86(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      WinogradTransLeftAvx512(S, B, M, w, h, k, length);
+      return true;
+    case X86Simd_Avx2:
+      WinogradTransLeftAvx2(S, B, M, w, h, k, length);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool WinogradTransRightX86(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+  switch (GetX86SimdLevel()) {
+    case X86Simd_Avx512:
+      WinogradTransRightAvx512(S, B, M, w, h, k, length);
+      return true;
+    case X86Simd_Avx2:
+      WinogradTransRightAvx2(S, B, M, w, h, k, length);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool PackNHWCToNCHWFp32X86(const void *src, void *dst, int batches, int plane, int channel) {
+  if (GetX86SimdLevel() < X86Simd_Avx2) {
+    return false;
+  }
+  PackNHWCToNCHWFp32Avx2((const float *)src, (float *)dst, batches, plane, channel);
+  return true;
+}
+#endif
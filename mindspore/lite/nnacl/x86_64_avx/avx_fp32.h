@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_X86_64_AVX_AVX_FP32_H_
+#define MINDSPORE_LITE_NNACL_X86_64_AVX_AVX_FP32_H_
+
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/op_base.h"
+
+// The files of x86_64_avx are built with -mavx2 -mfma or -mavx512f, the rest of nnacl with the baseline flags. The
+// functions below are the only entry points: they check the cpu once and then run the widest kernel it supports, so
+// a single binary runs on every x86_64 host. Element wise functions return how many leading elements they handled
+// and leave the tail, or everything on an older cpu, to the caller. The other functions return false when the caller
+// has to run its own implementation.
+
+typedef enum X86SimdLevel { X86Simd_None = 0, X86Simd_Avx2 = 1, X86Simd_Avx512 = 2 } X86SimdLevel;
+
+typedef enum SimdArithmeticOp { SimdArith_Add, SimdArith_Sub, SimdArith_Mul, SimdArith_Div } SimdArithmeticOp;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+X86SimdLevel GetX86SimdLevel(void);
+// Caps the level used by the kernels, e.g. to compare the code paths. The level can not be raised above what the
+// cpu supports.
+void SetX86SimdLevel(X86SimdLevel level);
+
+int ElementArithmeticX86(SimdArithmeticOp op, ActType act, const float *input0, const float *input1, float *output,
+                         int element_size);
+// One of the inputs is a single value, input0 if first_scalar is true, otherwise input1.
+int ElementOptArithmeticX86(SimdArithmeticOp op, ActType act, const float *input0, const float *input1, float *output,
+                            int element_size, bool first_scalar);
+// Supports ActType_Relu, ActType_Relu6 and ActType_Sigmod.
+int ActivationX86(ActType type, const float *src, int length, float *dst);
+int ExpX86(const float *src, float *dst, int num);
+
+bool SoftmaxLastAxisX86(const float *src, float *dst, int batch, int channel);
+bool LayerNormRowX86(const float *src, const float *gamma, const float *beta, bool affine, float epsilon, float *dst,
+                     int inner_size);
+
+// Pooling of one nhwc output pixel. src points to the first input pixel of the window inside the image, the window
+// has win_h rows of win_w pixels. Return the number of leading channels written to dst.
+int AvgPoolingPixelX86(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w, int count,
+                       float minf, float maxf);
+int MaxPoolingPixelX86(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w, float minf,
+                       float maxf);
+
+// a is packed by row_tile rows (C4NUM or C12NUM) and b by C8NUM columns, like MatMulOpt expects them.
+// OutType_TileC8 is not handled.
+bool MatMulX86(const float *a, const float *b, float *c, const float *bias, ActType act_type, int deep, int row,
+               int col, size_t stride, int out_type, int row_tile);
+// Same layouts as PostConvFuncFp32C8, stride is in floats.
+bool PostConvFuncC8X86(const float *c8_out, float *out, const float *bias, size_t output_channel, size_t plane_size,
+                       size_t stride, size_t relu_type);
+// Same arguments as ConvDwCenter, steps are in floats.
+bool ConvDwCenterX86(float *dst, const float *src, const float *weight, const float *bias, int height, int width,
+                     int kernel_h, int kernel_w, int out_h_step, int block_channel, int in_sh_step, int in_sw_step,
+                     int in_kh_step, int in_kw_step, bool is_relu, bool is_relu6);
+bool WinogradTransLeftX86(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length);
+bool WinogradTransRightX86(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length);
+bool PackNHWCToNCHWFp32X86(const void *src, void *dst, int batches, int plane, int channel);
+#ifdef __cplusplus
+}
+#endif
+#endif  // ENABLE_X86_64_AVX
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_AVX_AVX_FP32_H_
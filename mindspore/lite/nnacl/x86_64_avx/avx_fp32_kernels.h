@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_X86_64_AVX_AVX_FP32_KERNELS_H_
+#define MINDSPORE_LITE_NNACL_X86_64_AVX_AVX_FP32_KERNELS_H_
+
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/op_base.h"
+#include "nnacl/x86_64_avx/avx_fp32.h"
+
+// Kernels for one instruction set. Only avx_fp32.c calls them, after it has checked the cpu.
+
+#define DECLARE_SIMD_FP32_KERNELS(SUFFIX)                                                                           \
+  int ElementArithmetic##SUFFIX(int op, int act, const float *input0, const float *input1, float *output,          \
+                                int element_size);                                                                 \
+  int ElementOptArithmetic##SUFFIX(int op, int act, const float *input0, const float *input1, float *output,       \
+                                   int element_size, bool first_scalar);                                           \
+  int Activation##SUFFIX(int type, const float *src, int length, float *dst);                                      \
+  int Exp##SUFFIX(const float *src, float *dst, int num);                                                          \
+  void SoftmaxLastAxis##SUFFIX(const float *src, float *dst, int batch, int channel);                              \
+  void LayerNormRow##SUFFIX(const float *src, const float *gamma, const float *beta, bool affine, float epsilon,   \
+                            float *dst, int inner_size);                                                           \
+  int AvgPoolingPixel##SUFFIX(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w,  \
+                              int count, float minf, float maxf);                                                  \
+  int MaxPoolingPixel##SUFFIX(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w,  \
+                              float minf, float maxf);                                                             \
+  void WinogradTransLeft##SUFFIX(const float *S, const float *B, float *M, size_t w, size_t h, size_t k,           \
+                                 size_t length);                                                                   \
+  void WinogradTransRight##SUFFIX(const float *S, const float *B, float *M, size_t w, size_t h, size_t k,          \
+                                  size_t length);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+DECLARE_SIMD_FP32_KERNELS(Avx2)
+DECLARE_SIMD_FP32_KERNELS(Avx512)
+
+// The packed layouts below are 8 floats wide, so they have an avx2 kernel only.
+void MatMulAvx2(const float *a, const float *b, float *c, const float *bias, int act_type, int deep, int row, int col,
+                size_t stride, int out_type, int row_tile);
+void PostConvFuncC8Avx2(const float *c8_out, float *out, const float *bias, size_t output_channel, size_t plane_size,
+                        size_t stride, size_t relu_type);
+void ConvDwCenterAvx2(float *dst, const float *src, const float *weight, const float *bias, int height, int width,
+                      int kernel_h, int kernel_w, int out_h_step, int block_channel, int in_sh_step, int in_sw_step,
+                      int in_kh_step, int in_kw_step, bool is_relu, bool is_relu6);
+void PackNHWCToNCHWFp32Avx2(const float *src, float *dst, int batches, int plane, int channel);
+#ifdef __cplusplus
+}
+#endif
+#endif  // ENABLE_X86_64_AVX
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_AVX_AVX_FP32_KERNELS_H_
@@ -0,0 +1,298 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Kernels written once against the MS_SIMD_* macros. Fp32Simd_Avx2.c and Fp32Simd_Avx512.c define the macros for
+// their vector width and include this file, SIMD_FUNC appends the instruction set to the function names.
+// No include guard on purpose.
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+// Cephes expf: exp(x) = 2^n * exp(r) with n = round(x / ln2) and |r| <= ln2 / 2
+static inline MS_FLOAT_SIMD SIMD_FUNC(ExpVec)(MS_FLOAT_SIMD x) {
+  x = MS_SIMD_MIN(MS_SIMD_MAX(x, MS_SIMD_SET1(-88.0f)), MS_SIMD_SET1(88.0f));
+  MS_FLOAT_SIMD fx = MS_SIMD_FLOOR(MS_SIMD_FMADD(x, MS_SIMD_SET1(1.44269504088896341f), MS_SIMD_SET1(0.5f)));
+  x = MS_SIMD_FMADD(fx, MS_SIMD_SET1(-0.693359375f), x);
+  x = MS_SIMD_FMADD(fx, MS_SIMD_SET1(2.12194440e-4f), x);
+  MS_FLOAT_SIMD y = MS_SIMD_SET1(1.9875691500E-4f);
+  y = MS_SIMD_FMADD(y, x, MS_SIMD_SET1(1.3981999507E-3f));
+  y = MS_SIMD_FMADD(y, x, MS_SIMD_SET1(8.3334519073E-3f));
+  y = MS_SIMD_FMADD(y, x, MS_SIMD_SET1(4.1665795894E-2f));
+  y = MS_SIMD_FMADD(y, x, MS_SIMD_SET1(1.6666665459E-1f));
+  y = MS_SIMD_FMADD(y, x, MS_SIMD_SET1(5.0000001201E-1f));
+  y = MS_SIMD_FMADD(y, MS_SIMD_MUL(x, x), MS_SIMD_ADD(x, MS_SIMD_SET1(1.0f)));
+  MS_INT_SIMD n = MS_SIMD_ADD_EPI32(MS_SIMD_CVTT_EPI32(fx), MS_SIMD_SET1_EPI32(127));
+  return MS_SIMD_MUL(y, MS_SIMD_CAST_PS(MS_SIMD_SLLI_EPI32(n, 23)));
+}
+
+#define SIMD_ARITH_LOOP(CALC)                                                \
+  for (; index <= element_size - MS_SIMD_WIDTH; index += MS_SIMD_WIDTH) {    \
+    MS_SIMD_ST(output + index, CALC);                                        \
+  }
+
+// The activation is chosen outside of the loops
+#define SIMD_ARITH_ACT_LOOPS(OP, IN0, IN1)                                   \
+  if (act == ActType_Relu) {                                                 \
+    SIMD_ARITH_LOOP(MS_SIMD_MAX(OP(IN0, IN1), zero))                         \
+  } else if (act == ActType_Relu6) {                                         \
+    SIMD_ARITH_LOOP(MS_SIMD_MIN(MS_SIMD_MAX(OP(IN0, IN1), zero), six))       \
+  } else {                                                                   \
+    SIMD_ARITH_LOOP(OP(IN0, IN1))                                            \
+  }
+
+#define SIMD_ARITH_OPS(IN0, IN1)                      \
+  switch (op) {                                       \
+    case SimdArith_Add:                               \
+      SIMD_ARITH_ACT_LOOPS(MS_SIMD_ADD, IN0, IN1)     \
+      break;                                          \
+    case SimdArith_Sub:                               \
+      SIMD_ARITH_ACT_LOOPS(MS_SIMD_SUB, IN0, IN1)     \
+      break;                                          \
+    case SimdArith_Mul:                               \
+      SIMD_ARITH_ACT_LOOPS(MS_SIMD_MUL, IN0, IN1)     \
+      break;                                          \
+    case SimdArith_Div:                               \
+      SIMD_ARITH_ACT_LOOPS(MS_SIMD_DIV, IN0, IN1)     \
+      break;                                          \
+    default:                                          \
+      break;                                          \
+  }
+
+int SIMD_FUNC(ElementArithmetic)(int op, int act, const float *input0, const float *input1, float *output,
+                                 int element_size) {
+  MS_FLOAT_SIMD zero = MS_SIMD_ZERO();
+  MS_FLOAT_SIMD six = MS_SIMD_SET1(6.0f);
+  int index = 0;
+  SIMD_ARITH_OPS(MS_SIMD_LD(input0 + index), MS_SIMD_LD(input1 + index))
+  return index;
+}
+
+int SIMD_FUNC(ElementOptArithmetic)(int op, int act, const float *input0, const float *input1, float *output,
+                                    int element_size, bool first_scalar) {
+  MS_FLOAT_SIMD zero = MS_SIMD_ZERO();
+  MS_FLOAT_SIMD six = MS_SIMD_SET1(6.0f);
+  int index = 0;
+  if (first_scalar) {
+    MS_FLOAT_SIMD vin0 = MS_SIMD_SET1(input0[0]);
+    SIMD_ARITH_OPS(vin0, MS_SIMD_LD(input1 + index))
+  } else {
+    MS_FLOAT_SIMD vin1 = MS_SIMD_SET1(input1[0]);
+    SIMD_ARITH_OPS(MS_SIMD_LD(input0 + index), vin1)
+  }
+  return index;
+}
+
+int SIMD_FUNC(Activation)(int type, const float *src, int length, float *dst) {
+  MS_FLOAT_SIMD zero = MS_SIMD_ZERO();
+  MS_FLOAT_SIMD one = MS_SIMD_SET1(1.0f);
+  MS_FLOAT_SIMD six = MS_SIMD_SET1(6.0f);
+  int i = 0;
+  if (type == ActType_Relu) {
+    for (; i <= length - MS_SIMD_WIDTH; i += MS_SIMD_WIDTH) {
+      MS_SIMD_ST(dst + i, MS_SIMD_MAX(MS_SIMD_LD(src + i), zero));
+    }
+  } else if (type == ActType_Relu6) {
+    for (; i <= length - MS_SIMD_WIDTH; i += MS_SIMD_WIDTH) {
+      MS_SIMD_ST(dst + i, MS_SIMD_MIN(MS_SIMD_MAX(MS_SIMD_LD(src + i), zero), six));
+    }
+  } else if (type == ActType_Sigmod) {
+    for (; i <= length - MS_SIMD_WIDTH; i += MS_SIMD_WIDTH) {
+      MS_FLOAT_SIMD exp_neg = SIMD_FUNC(ExpVec)(MS_SIMD_SUB(zero, MS_SIMD_LD(src + i)));
+      MS_SIMD_ST(dst + i, MS_SIMD_DIV(one, MS_SIMD_ADD(one, exp_neg)));
+    }
+  }
+  return i;
+}
+
+int SIMD_FUNC(Exp)(const float *src, float *dst, int num) {
+  int i = 0;
+  for (; i <= num - MS_SIMD_WIDTH; i += MS_SIMD_WIDTH) {
+    MS_SIMD_ST(dst + i, SIMD_FUNC(ExpVec)(MS_SIMD_LD(src + i)));
+  }
+  return i;
+}
+
+void SIMD_FUNC(SoftmaxLastAxis)(const float *src, float *dst, int batch, int channel) {
+  for (int b = 0; b < batch; ++b, src += channel, dst += channel) {
+    float max = src[0];
+    int j = 0;
+    if (channel >= MS_SIMD_WIDTH) {
+      MS_FLOAT_SIMD max_vec = MS_SIMD_LD(src);
+      for (j = MS_SIMD_WIDTH; j <= channel - MS_SIMD_WIDTH; j += MS_SIMD_WIDTH) {
+        max_vec = MS_SIMD_MAX(max_vec, MS_SIMD_LD(src + j));
+      }
+      max = MS_SIMD_REDUCE_MAX(max_vec);
+    }
+    for (; j < channel; ++j) {
+      max = MSMAX(max, src[j]);
+    }
+
+    MS_FLOAT_SIMD max_vec = MS_SIMD_SET1(max);
+    MS_FLOAT_SIMD sum_vec = MS_SIMD_ZERO();
+    int k = 0;
+    for (; k <= channel - MS_SIMD_WIDTH; k += MS_SIMD_WIDTH) {
+      MS_FLOAT_SIMD exp_vec = SIMD_FUNC(ExpVec)(MS_SIMD_SUB(MS_SIMD_LD(src + k), max_vec));
+      MS_SIMD_ST(dst + k, exp_vec);
+      sum_vec = MS_SIMD_ADD(sum_vec, exp_vec);
+    }
+    float sum = MS_SIMD_REDUCE_ADD(sum_vec);
+    for (; k < channel; ++k) {
+      dst[k] = expf(src[k] - max);
+      sum += dst[k];
+    }
+
+    float div = 1.0f / sum;
+    MS_FLOAT_SIMD div_vec = MS_SIMD_SET1(div);
+    for (k = 0; k <= channel - MS_SIMD_WIDTH; k += MS_SIMD_WIDTH) {
+      MS_SIMD_ST(dst + k, MS_SIMD_MUL(MS_SIMD_LD(dst + k), div_vec));
+    }
+    for (; k < channel; ++k) {
+      dst[k] *= div;
+    }
+  }
+}
+
+void SIMD_FUNC(LayerNormRow)(const float *src, const float *gamma, const float *beta, bool affine, float epsilon,
+                             float *dst, int inner_size) {
+  MS_FLOAT_SIMD sum_vec = MS_SIMD_ZERO();
+  MS_FLOAT_SIMD square_sum_vec = MS_SIMD_ZERO();
+  int i = 0;
+  for (; i <= inner_size - MS_SIMD_WIDTH; i += MS_SIMD_WIDTH) {
+    MS_FLOAT_SIMD src_vec = MS_SIMD_LD(src + i);
+    sum_vec = MS_SIMD_ADD(sum_vec, src_vec);
+    square_sum_vec = MS_SIMD_FMADD(src_vec, src_vec, square_sum_vec);
+  }
+  float mean = MS_SIMD_REDUCE_ADD(sum_vec);
+  float square_mean = MS_SIMD_REDUCE_ADD(square_sum_vec);
+  for (; i < inner_size; ++i) {
+    mean += src[i];
+    square_mean += src[i] * src[i];
+  }
+  mean /= (float)inner_size;
+  square_mean /= (float)inner_size;
+  const float deno = 1 / sqrtf(square_mean - mean * mean + epsilon);
+
+  MS_FLOAT_SIMD mean_vec = MS_SIMD_SET1(mean);
+  MS_FLOAT_SIMD deno_vec = MS_SIMD_SET1(deno);
+  i = 0;
+  if (affine) {
+    for (; i <= inner_size - MS_SIMD_WIDTH; i += MS_SIMD_WIDTH) {
+      MS_FLOAT_SIMD norm = MS_SIMD_MUL(MS_SIMD_SUB(MS_SIMD_LD(src + i), mean_vec), deno_vec);
+      MS_SIMD_ST(dst + i, MS_SIMD_FMADD(norm, MS_SIMD_LD(gamma + i), MS_SIMD_LD(beta + i)));
+    }
+    for (; i < inner_size; ++i) {
+      dst[i] = (src[i] - mean) * deno * gamma[i] + beta[i];
+    }
+  } else {
+    for (; i <= inner_size - MS_SIMD_WIDTH; i += MS_SIMD_WIDTH) {
+      MS_SIMD_ST(dst + i, MS_SIMD_MUL(MS_SIMD_SUB(MS_SIMD_LD(src + i), mean_vec), deno_vec));
+    }
+    for (; i < inner_size; ++i) {
+      dst[i] = (src[i] - mean) * deno;
+    }
+  }
+}
+
+int SIMD_FUNC(AvgPoolingPixel)(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w,
+                               int count, float minf, float maxf) {
+  MS_FLOAT_SIMD count_vec = MS_SIMD_SET1((float)count);
+  MS_FLOAT_SIMD min_vec = MS_SIMD_SET1(minf);
+  MS_FLOAT_SIMD max_vec = MS_SIMD_SET1(maxf);
+  int c = 0;
+  for (; c <= channel - MS_SIMD_WIDTH; c += MS_SIMD_WIDTH) {
+    MS_FLOAT_SIMD sum = MS_SIMD_ZERO();
+    for (int h = 0; h < win_h; ++h) {
+      const float *src_w = src + h * in_row_stride + c;
+      for (int w = 0; w < win_w; ++w) {
+        sum = MS_SIMD_ADD(sum, MS_SIMD_LD(src_w + w * channel));
+      }
+    }
+    MS_FLOAT_SIMD avg = MS_SIMD_DIV(sum, count_vec);
+    MS_SIMD_ST(dst + c, MS_SIMD_MIN(MS_SIMD_MAX(avg, min_vec), max_vec));
+  }
+  return c;
+}
+
+int SIMD_FUNC(MaxPoolingPixel)(const float *src, float *dst, int channel, int in_row_stride, int win_h, int win_w,
+                               float minf, float maxf) {
+  MS_FLOAT_SIMD min_vec = MS_SIMD_SET1(minf);
+  MS_FLOAT_SIMD max_vec = MS_SIMD_SET1(maxf);
+  int c = 0;
+  for (; c <= channel - MS_SIMD_WIDTH; c += MS_SIMD_WIDTH) {
+    MS_FLOAT_SIMD max = MS_SIMD_SET1(-FLT_MAX);
+    for (int h = 0; h < win_h; ++h) {
+      const float *src_w = src + h * in_row_stride + c;
+      for (int w = 0; w < win_w; ++w) {
+        max = MS_SIMD_MAX(max, MS_SIMD_LD(src_w + w * channel));
+      }
+    }
+    MS_SIMD_ST(dst + c, MS_SIMD_MIN(MS_SIMD_MAX(max, min_vec), max_vec));
+  }
+  return c;
+}
+
+// dst += src * b over length floats
+static inline void SIMD_FUNC(MulAdd)(float *dst, const float *src, float b, int length) {
+  MS_FLOAT_SIMD b_vec = MS_SIMD_SET1(b);
+  int j = 0;
+  for (; j <= length - MS_SIMD_WIDTH; j += MS_SIMD_WIDTH) {
+    MS_SIMD_ST(dst + j, MS_SIMD_FMADD(MS_SIMD_LD(src + j), b_vec, MS_SIMD_LD(dst + j)));
+  }
+  for (; j < length; ++j) {
+    dst[j] += src[j] * b;
+  }
+}
+
+void SIMD_FUNC(WinogradTransLeft)(const float *S, const float *B, float *M, size_t w, size_t h, size_t k,
+                                  size_t length) {
+  const int unit_step = 4 * length;
+  for (int y = 0; y < h; ++y) {
+    float *dst_y = M + y * w * unit_step;
+    for (int x = 0; x < w; ++x) {
+      float *dst_x = dst_y + x * unit_step;
+      const float *src_x = S + x * unit_step;
+      memset(dst_x, 0, unit_step * sizeof(float));
+      for (int i = 0; i < k; ++i) {
+        float b = B[i * h + y];
+        if (0.0f == b) {
+          continue;
+        }
+        SIMD_FUNC(MulAdd)(dst_x, src_x + i * w * unit_step, b, unit_step);
+      }
+    }
+  }
+}
+
+void SIMD_FUNC(WinogradTransRight)(const float *S, const float *B, float *M, size_t w, size_t h, size_t k,
+                                   size_t length) {
+  const int unit_step = 4 * length;
+  for (int y = 0; y < h; ++y) {
+    float *dst_y = M + y * w * unit_step;
+    const float *src_y = S + y * k * unit_step;
+    for (int x = 0; x < w; ++x) {
+      float *dst_x = dst_y + x * unit_step;
+      memset(dst_x, 0, unit_step * sizeof(float));
+      for (int i = 0; i < k; ++i) {
+        float b = B[i * h + x];
+        if (0.0f == b) {
+          continue;
+        }
+        SIMD_FUNC(MulAdd)(dst_x, src_y + i * unit_step, b, unit_step);
+      }
+    }
+  }
+}
@@ -18,8 +18,16 @@
 #include <nmmintrin.h>
 #include "nnacl/pack.h"
 #include "nnacl/int8/conv_int8.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 void PackNHWCToNCHWFp32(const void *src, void *dst, int batches, int plane, int channel) {
+#ifdef ENABLE_X86_64_AVX
+  if (PackNHWCToNCHWFp32X86(src, dst, batches, plane, channel)) {
+    return;
+  }
+#endif
   int hw8 = plane / C8NUM * C8NUM;
   int c8 = channel / C8NUM * C8NUM;
   int batch = plane * channel;
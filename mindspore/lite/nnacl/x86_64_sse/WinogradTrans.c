@@ -16,8 +16,16 @@
 #ifdef ENABLE_X86_64_SSE
 #include <nmmintrin.h>
 #include "nnacl/fp32/common_func_fp32.h"
+#ifdef ENABLE_X86_64_AVX
+#include "nnacl/x86_64_avx/avx_fp32.h"
+#endif
 
 void WinogradTransLeft(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+#ifdef ENABLE_X86_64_AVX
+  if (WinogradTransLeftX86(S, B, M, w, h, k, length)) {
+    return;
+  }
+#endif
   size_t len_c4 = length * 4;
   size_t S_step = length * w * 4;
   for (int h1 = 0; h1 < h; ++h1) {
@@ -127,6 +135,11 @@ void WinogradTransLeft(const float *S, const float *B, float *M, size_t w, size_
 }
 
 void WinogradTransRight(const float *S, const float *B, float *M, size_t w, size_t h, size_t k, size_t length) {
+#ifdef ENABLE_X86_64_AVX
+  if (WinogradTransRightX86(S, B, M, w, h, k, length)) {
+    return;
+  }
+#endif
   size_t len_c4 = length * 4;
   size_t k_step = len_c4 * k;
   for (int h1 = 0; h1 < h; ++h1) {
@@ -14,38 +14,175 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <utility>
 #include "src/runtime/parallel_executor.h"
 #include "src/runtime/runtime_api.h"
 
-#define MAX_THREAD_NUM 8
 namespace mindspore::lite {
-ParallelExecutor::~ParallelExecutor() { DestroyThreadPool(thread_pool_); }
+ParallelExecutor::~ParallelExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
 int ParallelExecutor::Prepare(const std::vector<mindspore::kernel::LiteKernel *> &kernels) {
-  thread_pool_ = CreateLiteThreadPool(MAX_THREAD_NUM, NO_BIND);
-  if (thread_pool_ == nullptr) {
-    MS_LOG(ERROR) << "Memory error: fail to new ThreadPool";
-    return RET_ERROR;
+  if (!threads_.empty()) {
+    return RET_OK;
+  }
+  // Each kernel may occupy intra_op_num cores through ParallelLaunch, the calling worker being one of them
+  size_t intra_op_num = 1;
+  if (!kernels.empty() && kernels.front()->context() != nullptr && kernels.front()->context()->thread_num_ > 1) {
+    intra_op_num = static_cast<size_t>(kernels.front()->context()->thread_num_);
+  }
+  size_t core_num = std::max(std::thread::hardware_concurrency(), 1u);
+  worker_num_ = core_num > intra_op_num ? core_num - intra_op_num + 1 : 1;
+  queues_.clear();
+  for (size_t i = 0; i < worker_num_; ++i) {
+    queues_.emplace_back(std::make_unique<WorkQueue>());
+  }
+  // The thread calling Run is worker 0
+  for (size_t i = 1; i < worker_num_; ++i) {
+    threads_.emplace_back(&ParallelExecutor::WorkerLoop, this, i);
   }
   return RET_OK;
 }
 
-static int RunKernel(void *data, int index) {
-  auto *executor = reinterpret_cast<ParallelExecutor *>(data);
-  auto kernel = executor->GetReadyKernel(index);
-  auto ret = kernel->Run();
-  executor->SetResult(index, ret);
-  if (0 != ret) {
-    MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
-    return 0;
+void ParallelExecutor::WorkerLoop(size_t worker_id) {
+  uint64_t last_run_id = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [this, last_run_id] { return stop_ || run_id_ != last_run_id; });
+      if (stop_) {
+        return;
+      }
+      last_run_id = run_id_;
+    }
+    RunUntilDone(worker_id);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --busy_workers_;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void ParallelExecutor::RunUntilDone(size_t worker_id) {
+  kernel::LiteKernel *kernel = nullptr;
+  while (remaining_ > 0 && result_ == RET_OK) {
+    if (PopOrSteal(worker_id, &kernel)) {
+      auto ret = RunKernel(worker_id, kernel);
+      if (ret != RET_OK) {
+        SetResult(ret);
+      }
+      if (--in_flight_ == 0) {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        work_cv_.notify_all();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Nothing queued and nothing running means the kernels left can never become ready
+    work_cv_.wait(lock, [this] {
+      return stop_ || queued_ > 0 || in_flight_ == 0 || remaining_ == 0 || result_ != RET_OK;
+    });
+    if (stop_ || in_flight_ == 0) {
+      return;
+    }
+  }
+}
+
+void ParallelExecutor::Push(size_t worker_id, kernel::LiteKernel *kernel) {
+  ++in_flight_;
+  {
+    std::lock_guard<std::mutex> lock(queues_[worker_id]->mutex);
+    queues_[worker_id]->kernels.push_back(kernel);
+  }
+  ++queued_;
+  // Taking the lock orders the increment before the check of any worker about to wait. Workers between runs wait on
+  // the same condition variable, so wake all of them to be sure one that can take the kernel is woken.
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  work_cv_.notify_all();
+}
+
+bool ParallelExecutor::PopOrSteal(size_t worker_id, kernel::LiteKernel **kernel) {
+  {
+    auto &own = *queues_[worker_id];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.kernels.empty()) {
+      *kernel = own.kernels.back();
+      own.kernels.pop_back();
+      --queued_;
+      return true;
+    }
+  }
+  for (size_t i = 1; i < worker_num_; ++i) {
+    auto &victim = *queues_[(worker_id + i) % worker_num_];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.kernels.empty()) {
+      *kernel = victim.kernels.front();
+      victim.kernels.pop_front();
+      --queued_;
+      return true;
+    }
   }
+  return false;
+}
 
-  ret = kernel->FreeWorkTensor();
+int ParallelExecutor::RunKernel(size_t worker_id, kernel::LiteKernel *kernel) {
+  MS_ASSERT(nullptr != kernel);
+  int ret = RET_OK;
+  {
+    std::lock_guard<std::mutex> lock(bookkeeping_mutex_);
+    ret = kernel->PreProcess();
+  }
   if (RET_OK != ret) {
-    MS_LOG(ERROR) << "FreeWorkTensor failed, name: " << kernel->name();
+    MS_LOG(ERROR) << "PreProcess kernel failed, name: " << kernel->name();
+    return ret;
+  }
+  ret = kernel->Run(before_, after_);
+  if (RET_OK != ret) {
+    MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
     return ret;
   }
-  return 0;
+  {
+    std::lock_guard<std::mutex> lock(bookkeeping_mutex_);
+    ret = kernel->PostProcess();
+  }
+  if (RET_OK != ret) {
+    MS_LOG(ERROR) << "PostProcess kernel failed, name: " << kernel->name();
+    return ret;
+  }
+
+  for (auto out : kernel->out_kernels()) {
+    auto iter = kernel_index_.find(out);
+    if (iter == kernel_index_.end()) {
+      continue;
+    }
+    if (--pending_inputs_[iter->second] == 0) {
+      Push(worker_id, out);
+    }
+  }
+  if (--remaining_ == 0) {
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    work_cv_.notify_all();
+  }
+  return RET_OK;
+}
+
+void ParallelExecutor::SetResult(int ret) {
+  int expected = RET_OK;
+  result_.compare_exchange_strong(expected, ret);
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  work_cv_.notify_all();
 }
 
 int ParallelExecutor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
@@ -62,50 +199,87 @@ int ParallelExecutor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor
       return RET_ERROR;
     }
   }
-  kernel::LiteKernelUtil::InitTensorRefCount(kernels);
-
-  for (auto kernel : kernels) {
-    if (kernel->in_kernels().empty()) {
-      readyKernels.emplace_back(kernel);
-      continue;
+  if (queues_.empty()) {
+    auto ret = Prepare(kernels);
+    if (RET_OK != ret) {
+      return ret;
     }
-    refCount[kernel] = kernel->in_kernels().size();
   }
-  std::vector<kernel::LiteKernel *> newReadyKernels;
-  while (!readyKernels.empty()) {
-    results.resize(readyKernels.size(), RET_OK);
-    if (0 != ParallelLaunch(thread_pool_, RunKernel, this, readyKernels.size())) {
-      MS_LOG(ERROR) << "ParallelLaunch failed ";
-      return RET_ERROR;
-    }
+  if (kernels.empty()) {
+    return RET_OK;
+  }
+  kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+#ifdef SUPPORT_TRAIN
+  for (auto out_tensor : out_tensors) {  // increase RefCount of output tensors, such that Run will not free them
+    out_tensor->set_ref_count(out_tensor->ref_count() + 1);
+  }
+#endif
 
-    if (std::find_if(results.begin(), results.end(), [](const int &ret) { return (ret != 0); }) != results.end()) {
-      return RET_ERROR;
+  kernel_index_.clear();
+  pending_inputs_ = std::make_unique<std::atomic<int>[]>(kernels.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    kernel_index_[kernels[i]] = i;
+  }
+  // Only inputs produced by kernels of this run are waited for
+  std::vector<kernel::LiteKernel *> ready_kernels;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    auto &in_kernels = kernels[i]->in_kernels();
+    auto pending = std::count_if(in_kernels.begin(), in_kernels.end(),
+                                 [this](kernel::LiteKernel *in) { return kernel_index_.count(in) > 0; });
+    pending_inputs_[i] = static_cast<int>(pending);
+    if (pending == 0) {
+      ready_kernels.push_back(kernels[i]);
     }
-    newReadyKernels.clear();
-    for (auto completed : readyKernels) {
-      for (auto out : completed->out_kernels()) {
-        auto iter = refCount.find(out);
-        if (iter == refCount.end()) {
-          continue;
-        }
-        (iter->second)--;
-        if (iter->second <= 0) {
-          newReadyKernels.emplace_back(iter->first);
-          refCount.erase(iter);
-        }
-      }
+  }
+  before_ = nullptr;
+  if (before != nullptr) {
+    before_ = [this, &before](std::vector<tensor::MSTensor *> inputs, std::vector<tensor::MSTensor *> outputs,
+                              const CallBackParam &param) {
+      std::lock_guard<std::mutex> lock(bookkeeping_mutex_);
+      return before(inputs, outputs, param);
+    };
+  }
+  after_ = nullptr;
+  if (after != nullptr) {
+    after_ = [this, &after](std::vector<tensor::MSTensor *> inputs, std::vector<tensor::MSTensor *> outputs,
+                            const CallBackParam &param) {
+      std::lock_guard<std::mutex> lock(bookkeeping_mutex_);
+      return after(inputs, outputs, param);
+    };
+  }
+  remaining_ = static_cast<int>(kernels.size());
+  result_ = RET_OK;
+  queued_ = 0;
+  in_flight_ = 0;
+  for (size_t i = 0; i < ready_kernels.size(); ++i) {
+    Push(i % worker_num_, ready_kernels[i]);
+  }
 
-      auto ret = completed->FreeWorkTensor();
-      if (RET_OK != ret) {
-        MS_LOG(ERROR) << "FreeWorkTensor failed, name: " << completed->name();
-        return ret;
-      }
-    }
-    readyKernels.clear();
-    readyKernels = std::move(newReadyKernels);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    busy_workers_ = worker_num_ - 1;
+    ++run_id_;
+  }
+  work_cv_.notify_all();
+  RunUntilDone(0);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
   }
 
+  // Drop what was left in the deques after a failure
+  for (auto &queue : queues_) {
+    queue->kernels.clear();
+  }
+  before_ = nullptr;
+  after_ = nullptr;
+  if (result_ != RET_OK) {
+    return result_;
+  }
+  if (remaining_ != 0) {
+    MS_LOG(ERROR) << remaining_ << " kernels never became ready, the graph has a cycle or dangling inputs";
+    return RET_ERROR;
+  }
   return RET_OK;
 }
 
@@ -17,6 +17,12 @@
 #ifndef MINDSPORE_LITE_SRC_RUNTIME_PARALLEL_EXECUTOR_H_
 #define MINDSPORE_LITE_SRC_RUNTIME_PARALLEL_EXECUTOR_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 #include "src/runtime/allocator.h"
@@ -25,6 +31,10 @@
 #include "src/executor.h"
 
 namespace mindspore::lite {
+// Runs each kernel as soon as all of its input kernels are done. Ready kernels go to the deque of the worker that
+// made them ready, which runs them last in first out, while idle workers steal from the other end of other deques.
+// The number of workers leaves room for the intra-op thread pool of the kernels, and a kernel that calls
+// ParallelLaunch while that pool is busy runs its tasks on its own worker.
 class ParallelExecutor : public Executor {
  public:
   ParallelExecutor() = default;
@@ -35,14 +45,43 @@ class ParallelExecutor : public Executor {
   int Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
           const KernelCallBack &before = nullptr, const KernelCallBack &after = nullptr) override;
-  inline kernel::LiteKernel *GetReadyKernel(const int index) const { return readyKernels.at(index); }
-  inline void SetResult(const int index, const int result) { results.at(index) = result; }
+
+  size_t worker_num() const { return worker_num_; }
 
  private:
-  std::unordered_map<kernel::LiteKernel *, size_t> refCount;
-  std::vector<kernel::LiteKernel *> readyKernels;
-  std::vector<int> results;
-  struct ThreadPool *thread_pool_ = nullptr;
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<kernel::LiteKernel *> kernels;
+  };
+
+  void WorkerLoop(size_t worker_id);
+  void RunUntilDone(size_t worker_id);
+  void Push(size_t worker_id, kernel::LiteKernel *kernel);
+  bool PopOrSteal(size_t worker_id, kernel::LiteKernel **kernel);
+  int RunKernel(size_t worker_id, kernel::LiteKernel *kernel);
+  void SetResult(int ret);
+
+  size_t worker_num_ = 1;
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> threads_;
+
+  // State of the current Run. Workers wait on work_cv_ for a new run_id_ or for ready kernels.
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  uint64_t run_id_ = 0;
+  size_t busy_workers_ = 0;
+  bool stop_ = false;
+  std::atomic<int> queued_{0};
+  std::atomic<int> in_flight_{0};  // kernels queued or running
+  std::atomic<int> remaining_{0};
+  std::atomic<int> result_{RET_OK};
+  std::unordered_map<kernel::LiteKernel *, size_t> kernel_index_;
+  std::unique_ptr<std::atomic<int>[]> pending_inputs_;
+  // PreProcess, PostProcess and the callbacks touch shared tensors and allocators, so they run one at a time
+  std::mutex bookkeeping_mutex_;
+  KernelCallBack before_;
+  KernelCallBack after_;
 };
 
 }  // namespace mindspore::lite
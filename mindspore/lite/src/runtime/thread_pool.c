@@ -78,6 +78,7 @@ typedef struct ThreadPool {
   int thread_num;
   BindMode mode;
   atomic_bool is_alive;
+  atomic_bool is_busy;  // a launch is distributing tasks to the threads
 } ThreadPool;
 
 Thread *GetThread(struct ThreadPool *thread_pool, int thread_id) {
@@ -701,10 +702,21 @@ int AddTask(struct ThreadPool *thread_pool, int func(void *, int), void *content
     }
     return RET_TP_OK;
   }
+  // the task queues have a single producer, so a launch from another thread while the pool is busy (for example
+  // kernels run concurrently by an inter-op executor) runs on the calling thread instead of oversubscribing the cores
+  bool expected = false;
+  if (!atomic_compare_exchange_strong(&thread_pool->is_busy, &expected, true)) {
+    for (int i = 0; i < task_num; ++i) {
+      func(content, i);
+    }
+    return RET_TP_OK;
+  }
   Task task;
   task.func = func;
   task.content = content;
-  return DistributeTask(thread_pool, &task, task_num);
+  int ret = DistributeTask(thread_pool, &task, task_num);
+  atomic_store(&thread_pool->is_busy, false);
+  return ret;
 }
 
 int ParallelLaunch(struct ThreadPool *thread_pool, int (*func)(void *, int), void *content, int task_num) {
@@ -818,6 +830,7 @@ ThreadPool *CreateThreadPool(int thread_num, int mode) {
   }
   thread_pool->thread_num = thread_num > MAX_THREAD_NUM ? MAX_THREAD_NUM : thread_num;
   thread_pool->is_alive = ATOMIC_VAR_INIT(true);
+  thread_pool->is_busy = ATOMIC_VAR_INIT(false);
   thread_pool->mode = mode;
   thread_pool->thread_list = NULL;
   if (thread_num > 1) {
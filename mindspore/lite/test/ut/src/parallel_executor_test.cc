@@ -0,0 +1,153 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "src/runtime/parallel_executor.h"
+
+using mindspore::kernel::LiteKernel;
+using mindspore::lite::InnerContext;
+using mindspore::lite::ParallelExecutor;
+using mindspore::lite::Tensor;
+
+namespace mindspore {
+// A kernel that checks its inputs are done, sleeps and records when it finished
+class SleepKernel : public LiteKernel {
+ public:
+  SleepKernel(const std::string &name, int sleep_ms, const InnerContext *ctx, std::atomic<int> *order)
+      : LiteKernel(nullptr, {}, {}, ctx, nullptr), sleep_ms_(sleep_ms), order_(order) {
+    name_ = name;
+  }
+
+  int Run() override {
+    for (auto in : in_kernels()) {
+      if (static_cast<SleepKernel *>(in)->done_at_ < 0) {
+        return lite::RET_ERROR;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms_));
+    done_at_ = (*order_)++;
+    return ret_;
+  }
+
+  int done_at_ = -1;
+  int ret_ = lite::RET_OK;
+
+ private:
+  int sleep_ms_;
+  std::atomic<int> *order_;
+};
+
+class ParallelExecutorTest : public mindspore::CommonTest {
+ public:
+  ParallelExecutorTest() = default;
+
+  SleepKernel *AddKernel(const std::string &name, int sleep_ms) {
+    kernels_.emplace_back(std::make_unique<SleepKernel>(name, sleep_ms, &ctx_, &order_));
+    return kernels_.back().get();
+  }
+
+  static void Link(SleepKernel *from, SleepKernel *to) {
+    auto outs = from->out_kernels();
+    outs.push_back(to);
+    from->set_out_kernels(outs);
+    auto ins = to->in_kernels();
+    ins.push_back(from);
+    to->set_in_kernels(ins);
+  }
+
+  std::vector<LiteKernel *> Kernels() {
+    std::vector<LiteKernel *> kernels;
+    for (auto &kernel : kernels_) {
+      kernel->done_at_ = -1;
+      kernels.push_back(kernel.get());
+    }
+    return kernels;
+  }
+
+  InnerContext ctx_;
+  std::atomic<int> order_{0};
+  std::vector<std::unique_ptr<SleepKernel>> kernels_;
+};
+
+TEST_F(ParallelExecutorTest, RunsKernelsAfterTheirInputs) {
+  // A slow branch next to a chain of short kernels, joined at the end
+  auto slow = AddKernel("slow", 20);
+  std::vector<SleepKernel *> chain;
+  for (int i = 0; i < 5; ++i) {
+    chain.push_back(AddKernel("chain" + std::to_string(i), 2));
+    if (i > 0) {
+      Link(chain[i - 1], chain[i]);
+    }
+  }
+  auto join = AddKernel("join", 0);
+  Link(slow, join);
+  Link(chain.back(), join);
+
+  ParallelExecutor executor;
+  auto kernels = Kernels();
+  ASSERT_EQ(executor.Prepare(kernels), lite::RET_OK);
+  ASSERT_GE(executor.worker_num(), 1);
+  std::vector<Tensor *> inputs;
+  std::vector<Tensor *> outputs;
+  for (int i = 0; i < 10; ++i) {
+    kernels = Kernels();
+    ASSERT_EQ(executor.Run(inputs, outputs, kernels), lite::RET_OK);
+    for (auto &kernel : kernels_) {
+      ASSERT_GE(kernel->done_at_, 0);
+    }
+    ASSERT_GT(join->done_at_, slow->done_at_);
+    ASSERT_GT(join->done_at_, chain.back()->done_at_);
+  }
+}
+
+TEST_F(ParallelExecutorTest, StopsOnKernelFailure) {
+  auto first = AddKernel("first", 0);
+  auto failing = AddKernel("failing", 0);
+  auto last = AddKernel("last", 0);
+  Link(first, failing);
+  Link(failing, last);
+  failing->ret_ = lite::RET_ERROR;
+
+  ParallelExecutor executor;
+  auto kernels = Kernels();
+  std::vector<Tensor *> inputs;
+  std::vector<Tensor *> outputs;
+  ASSERT_EQ(executor.Run(inputs, outputs, kernels), lite::RET_ERROR);
+  ASSERT_EQ(last->done_at_, -1);
+}
+
+TEST_F(ParallelExecutorTest, DetectsKernelsThatNeverBecomeReady) {
+  auto a = AddKernel("a", 0);
+  auto b = AddKernel("b", 0);
+  auto c = AddKernel("c", 0);
+  Link(a, b);
+  Link(b, c);
+  Link(c, b);
+
+  ParallelExecutor executor;
+  auto kernels = Kernels();
+  std::vector<Tensor *> inputs;
+  std::vector<Tensor *> outputs;
+  ASSERT_EQ(executor.Run(inputs, outputs, kernels), lite::RET_ERROR);
+  ASSERT_GE(a->done_at_, 0);
+}
+}  // namespace mindspore
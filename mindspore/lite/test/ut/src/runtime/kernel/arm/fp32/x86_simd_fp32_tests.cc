@@ -0,0 +1,222 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_X86_64_AVX
+#include <cfloat>
+#include <cmath>
+#include <vector>
+#include "src/common/log_adapter.h"
+#include "common/common_test.h"
+#include "mindspore/lite/nnacl/x86_64_avx/avx_fp32.h"
+#include "mindspore/lite/nnacl/fp32/activation_fp32.h"
+#include "mindspore/lite/nnacl/fp32/arithmetic_fp32.h"
+#include "mindspore/lite/nnacl/fp32/common_func_fp32.h"
+#include "mindspore/lite/nnacl/fp32/conv_depthwise_fp32.h"
+#include "mindspore/lite/nnacl/fp32/exp_fp32.h"
+#include "mindspore/lite/nnacl/fp32/layer_norm_fp32.h"
+#include "mindspore/lite/nnacl/fp32/matmul_fp32.h"
+#include "mindspore/lite/nnacl/fp32/pooling_fp32.h"
+#include "mindspore/lite/nnacl/fp32/softmax_fp32.h"
+#include "mindspore/lite/nnacl/matmul_parameter.h"
+#include "mindspore/lite/nnacl/pack.h"
+
+namespace mindspore {
+
+class TestX86SimdFp32 : public mindspore::CommonTest {
+ public:
+  TestX86SimdFp32() {}
+  void SetUp() override { host_level_ = GetX86SimdLevel(); }
+  void TearDown() override { SetX86SimdLevel(X86Simd_Avx512); }
+
+  // Runs func once on the scalar path and once on every simd level of the host, the outputs have to match.
+  template <typename Func>
+  void CompareLevels(Func func, std::vector<float> *out, float err) {
+    SetX86SimdLevel(X86Simd_None);
+    func();
+    std::vector<float> expect = *out;
+    for (int level = X86Simd_Avx2; level <= host_level_; ++level) {
+      SetX86SimdLevel(static_cast<X86SimdLevel>(level));
+      std::fill(out->begin(), out->end(), 0.0f);
+      func();
+      for (size_t i = 0; i < expect.size(); ++i) {
+        ASSERT_LE(std::fabs(expect[i] - out->at(i)), err * (1.0f + std::fabs(expect[i]))) << "level " << level;
+      }
+    }
+  }
+
+  static std::vector<float> Sequence(int size, int period, float scale, float offset) {
+    std::vector<float> data(size);
+    for (int i = 0; i < size; ++i) {
+      data[i] = (i * 7 % period) * scale + offset;
+    }
+    return data;
+  }
+
+  int host_level_ = X86Simd_None;
+};
+
+TEST_F(TestX86SimdFp32, ElementAddTail) {
+  const int size = 37;
+  auto in0 = Sequence(size, 13, 0.5f, -3.0f);
+  auto in1 = Sequence(size, 11, 0.25f, -1.0f);
+  std::vector<float> out(size);
+  CompareLevels([&]() { ElementAdd(in0.data(), in1.data(), out.data(), size); }, &out, 0.0f);
+  CompareLevels([&]() { ElementDivRelu6(in0.data(), in1.data(), out.data(), size); }, &out, 1e-6f);
+}
+
+TEST_F(TestX86SimdFp32, Activation) {
+  const int size = 53;
+  auto in = Sequence(size, 17, 1.0f, -8.0f);
+  std::vector<float> out(size);
+  CompareLevels([&]() { Fp32Relu6(in.data(), size, out.data()); }, &out, 0.0f);
+  CompareLevels([&]() { Sigmoid(in.data(), size, out.data()); }, &out, 1e-5f);
+}
+
+TEST_F(TestX86SimdFp32, SoftmaxLastAxis) {
+  const int batch = 3;
+  const int channel = 21;
+  auto in = Sequence(batch * channel, 19, 0.5f, -4.0f);
+  std::vector<float> out(batch * channel);
+  CompareLevels([&]() { SoftmaxLastAxis(in.data(), out.data(), batch, channel); }, &out, 1e-5f);
+}
+
+TEST_F(TestX86SimdFp32, LayerNorm) {
+  const int outer = 2;
+  const int inner = 27;
+  auto in = Sequence(outer * inner, 23, 0.3f, -2.0f);
+  auto gamma = Sequence(inner, 5, 0.2f, 0.5f);
+  auto beta = Sequence(inner, 3, 0.1f, -0.1f);
+  std::vector<float> out(outer * inner);
+  CompareLevels(
+    [&]() { LayerNorm(outer, inner, in.data(), gamma.data(), beta.data(), true, 1e-5f, out.data(), 0, 1); }, &out,
+    1e-4f);
+}
+
+TEST_F(TestX86SimdFp32, MatMulNhwc) {
+  const int row = 14;
+  const int col = 19;
+  const int deep = 9;
+  auto a = Sequence(UP_ROUND(row, C12NUM) * deep, 13, 0.25f, -1.0f);
+  auto b = Sequence(UP_ROUND(col, C8NUM) * deep, 11, 0.5f, -2.0f);
+  auto bias = Sequence(UP_ROUND(col, C8NUM), 7, 1.0f, -3.0f);
+  std::vector<float> out(row * col);
+  CompareLevels(
+    [&]() { MatMulOpt(a.data(), b.data(), out.data(), bias.data(), ActType_Relu, deep, row, col, col, OutType_Nhwc); },
+    &out, 1e-5f);
+}
+
+TEST_F(TestX86SimdFp32, PackNHWCToNCHW) {
+  const int batch = 2;
+  const int plane = 19;
+  const int channel = 11;
+  auto in = Sequence(batch * plane * channel, 101, 1.0f, 0.0f);
+  std::vector<float> out(batch * plane * channel);
+  CompareLevels([&]() { PackNHWCToNCHWFp32(in.data(), out.data(), batch, plane, channel); }, &out, 0.0f);
+}
+
+TEST_F(TestX86SimdFp32, Exp) {
+  const int size = 45;
+  auto in = Sequence(size, 29, 0.7f, -10.0f);
+  std::vector<float> out(size);
+  // The scalar polynomial is only accurate to about 4e-5, the vector one is closer to expf
+  CompareLevels([&]() { ExpFp32(in.data(), out.data(), size); }, &out, 5e-5f);
+}
+
+TEST_F(TestX86SimdFp32, Pooling) {
+  // 3x3 windows with stride 2 and padding, so the windows at the border are cut
+  PoolingParameter param = {};
+  param.window_h_ = 3;
+  param.window_w_ = 3;
+  param.stride_h_ = 2;
+  param.stride_w_ = 2;
+  param.pad_u_ = 1;
+  param.pad_l_ = 1;
+  param.input_batch_ = param.output_batch_ = 2;
+  param.input_h_ = 7;
+  param.input_w_ = 9;
+  param.output_h_ = 4;
+  param.output_w_ = 5;
+  param.thread_num_ = 1;
+  for (int channel : {4, 13, 21}) {
+    param.input_channel_ = param.output_channel_ = channel;
+    auto in = Sequence(2 * 7 * 9 * channel, 37, 0.5f, -9.0f);
+    std::vector<float> out(2 * 4 * 5 * channel);
+    CompareLevels([&]() { MaxPooling(in.data(), out.data(), &param, 0, -FLT_MAX, FLT_MAX); }, &out, 0.0f);
+    CompareLevels([&]() { MaxPooling(in.data(), out.data(), &param, 0, 0.0f, 6.0f); }, &out, 0.0f);
+    for (int avg_mode : {0, 1}) {
+      param.avg_mode_ = avg_mode;
+      CompareLevels([&]() { ASSERT_EQ(AvgPooling(in.data(), out.data(), &param, 0, -FLT_MAX, FLT_MAX), 0); }, &out,
+                    1e-6f);
+    }
+  }
+}
+
+TEST_F(TestX86SimdFp32, WinogradTrans) {
+  // unitStep is 4 * length floats, so length 3 and 5 leave a tail of 4 floats after the 8 wide loop
+  const size_t w = 3;
+  const size_t h = 4;
+  const size_t k = 5;
+  auto b = Sequence(k * h, 7, 0.5f, -1.0f);
+  b[3] = 0.0f;
+  for (size_t length : {1, 2, 3, 5}) {
+    auto s = Sequence(k * h * 4 * length, 31, 0.25f, -3.0f);
+    std::vector<float> out(w * h * 4 * length);
+    CompareLevels([&]() { WinogradTransLeft(s.data(), b.data(), out.data(), w, h, k, length); }, &out, 1e-6f);
+    CompareLevels([&]() { WinogradTransRight(s.data(), b.data(), out.data(), w, h, k, length); }, &out, 1e-6f);
+  }
+}
+
+TEST_F(TestX86SimdFp32, PostConvFuncC8) {
+  const int plane = 7;
+  for (int channel : {8, 13, 21}) {
+    const int stride = channel + 3;
+    auto in = Sequence(UP_ROUND(channel, C8NUM) * plane, 17, 1.0f, -8.0f);
+    auto bias = Sequence(channel, 5, 0.5f, -1.0f);
+    std::vector<float> out(plane * stride);
+    for (int act : {ActType_No, ActType_Relu, ActType_Relu6}) {
+      CompareLevels([&]() { PostConvFuncFp32C8(in.data(), out.data(), bias.data(), channel, plane, stride, act); },
+                    &out, 1e-6f);
+    }
+    CompareLevels([&]() { PostConvFuncFp32C8(in.data(), out.data(), nullptr, channel, plane, stride, ActType_No); },
+                  &out, 0.0f);
+  }
+}
+
+TEST_F(TestX86SimdFp32, ConvDwCenter) {
+  // An odd output width leaves one pixel after the two pixel loop of the center
+  ConvParameter param = {};
+  param.kernel_h_ = param.kernel_w_ = 3;
+  param.stride_h_ = param.stride_w_ = 1;
+  param.dilation_h_ = param.dilation_w_ = 1;
+  param.pad_u_ = param.pad_d_ = param.pad_l_ = param.pad_r_ = 1;
+  param.input_batch_ = param.output_batch_ = 1;
+  param.input_h_ = param.output_h_ = 6;
+  param.input_w_ = param.output_w_ = 9;
+  param.input_channel_ = param.output_channel_ = 13;
+  param.thread_num_ = 1;
+  SlidingWindowParam sliding;
+  InitSlidingParamConvDw(&sliding, &param, C4NUM);
+  auto in = Sequence(6 * 9 * sliding.block_channel_, 23, 0.25f, -2.0f);
+  auto weight = Sequence(sliding.c_block_ * sliding.kernel_step_, 11, 0.5f, -2.5f);
+  auto bias = Sequence(sliding.block_channel_, 3, 0.5f, -0.5f);
+  std::vector<float> out(6 * 9 * sliding.block_channel_);
+  for (auto act : {ActType_No, ActType_Relu, ActType_Relu6}) {
+    param.act_type_ = act;
+    CompareLevels([&]() { ConvDwSWFp32(out.data(), in.data(), weight.data(), bias.data(), &param, &sliding, 0); },
+                  &out, 1e-5f);
+  }
+}
+}  // namespace mindspore
+#endif
@@ -776,6 +776,93 @@ class GpuTimelineGenerator(BaseTimelineGenerator):
         # Update timeline summary info
         self._timeline_summary['num_of_streams'] += len(stream_count_dict.keys())
 
+class CpuTimelineGenerator(BaseTimelineGenerator):
+    """Generate cpu Timeline data from file, with the work of the dataset ops laid beside the kernels."""
+    _display_filename = 'cpu_timeline_display_{}.json'
+    _timeline_summary_filename = 'cpu_timeline_summary_{}.json'
+    _cpu_timeline_file_path = 'cpu_timeline_{}.json'
+    _dataset_op_execute_time_file_path = 'dataset_op_execute_timestamp_{}.txt'
+    _dataset_pid = 8000  # pid of the dataset ops on the timeline
+
+    def __init__(self, profiling_dir, device_id):
+        self._profiling_dir = profiling_dir
+        self._device_id = device_id
+        self._timeline_meta = []
+        self._timeline_summary = {
+            'total_time': 0,
+            'num_of_streams': 0,
+            'num_of_ops': 0,
+            'op_exe_times': 0
+            }
+
+    def _get_file_path(self, file_name):
+        """Generate the path of a file in the profiling dir."""
+        file_path = os.path.join(
+            self._profiling_dir,
+            file_name.format(self._device_id)
+        )
+        return validate_and_normalize_path(file_path)
+
+    def _load_timeline_data(self):
+        """Load the events of the kernels from the chrome trace written by the cpu profiler."""
+        file_path = self._get_file_path(self._cpu_timeline_file_path)
+        if not os.path.exists(file_path):
+            logger.error("Failed to find cpu timeline file.")
+            raise ProfilerFileNotFoundException('cpu timeline file')
+        try:
+            with open(file_path, 'r') as f_obj:
+                return json.load(f_obj).get('traceEvents', [])
+        except (IOError, OSError, json.JSONDecodeError) as err:
+            logger.error('Error occurred when load cpu timeline file: %s', err)
+            raise ProfilerIOException
+
+    def _load_dataset_op_data(self):
+        """Load the work of the dataset op workers, the file is only there when a dataset pipeline ran."""
+        file_path = self._get_file_path(self._dataset_op_execute_time_file_path)
+        if not os.path.exists(file_path):
+            return []
+        # the times are in us like the ones of the kernels
+        worker_tids = {}
+        dataset_timeline = []
+        try:
+            with open(file_path, 'r') as f_obj:
+                for line in f_obj:
+                    op_list = line.strip('\n').split(' ')
+                    if len(op_list) != 4:
+                        continue
+                    op_name, worker_id, start, end = op_list
+                    tid = worker_tids.setdefault((op_name, worker_id), len(worker_tids))
+                    dataset_timeline.append({'name': op_name, 'cat': 'Dataset', 'ph': 'X', 'pid': self._dataset_pid,
+                                             'tid': tid, 'ts': int(start), 'dur': int(end) - int(start),
+                                             'args': {'worker_id': int(worker_id)}})
+        except (IOError, OSError, ValueError) as err:
+            logger.error('Error occurred when load dataset op timeline data intermediate file: %s', err)
+            raise ProfilerIOException
+
+        dataset_timeline.append({'name': 'process_name', 'ph': 'M', 'pid': self._dataset_pid,
+                                 'args': {'name': 'Dataset Pipeline'}})
+        for (op_name, worker_id), tid in worker_tids.items():
+            dataset_timeline.append({'name': 'thread_name', 'ph': 'M', 'pid': self._dataset_pid, 'tid': tid,
+                                     'args': {'name': '%s worker %s' % (op_name, worker_id)}})
+        return dataset_timeline
+
+    def init_timeline(self):
+        """Init timeline metadata, adding all collected info."""
+        op_names = set()
+        threads = set()
+        for event in self._load_timeline_data():
+            if event.get('ph') == 'X':
+                op_names.add(event['args']['op_full_name'])
+                threads.add(event['tid'])
+                # convert the time unit of dur from 1us to 1ms
+                self._timeline_summary['total_time'] += event['dur'] / 1000
+                self._timeline_summary['op_exe_times'] += 1
+            self._timeline_meta.append(event)
+        self._timeline_summary['num_of_ops'] = len(op_names)
+        self._timeline_summary['num_of_streams'] = len(threads)
+        self._timeline_meta.extend(self._load_dataset_op_data())
+
+
 class AscendTimelineGenerator(BaseTimelineGenerator):
     """Generate ascend Timeline data from file."""
     _display_filename = 'ascend_timeline_display_{}.json'
@@ -29,7 +29,8 @@ from mindspore.profiler.parser.aicpu_data_parser import DataPreProcessParser
 from mindspore.profiler.parser.framework_parser import FrameworkParser
 from mindspore.profiler.parser.hwts_log_parser import HWTSLogParser
 from mindspore.profiler.parser.integrator import Integrator
-from mindspore.profiler.parser.integrator import GpuTimelineGenerator, AscendTimelineGenerator
+from mindspore.profiler.parser.integrator import GpuTimelineGenerator, AscendTimelineGenerator, \
+    CpuTimelineGenerator
 from mindspore.profiler.parser.minddata_parser import MinddataParser
 from mindspore.profiler.parser.minddata_pipeline_parser import \
     MinddataPipelineParser
@@ -51,8 +52,9 @@ class Profiler:
     Performance profiling API.
 
     This API enables MindSpore users to profile the performance of neural network.
-    Profiler supports Ascend and GPU, both of them are used in the same way,
-    but only output_path in args works on GPU.
+    Profiler supports Ascend, GPU and CPU, all of them are used in the same way,
+    but only output_path in args works on GPU and CPU. On CPU every kernel launch is recorded
+    with its input shapes, and the work of the dataset ops is laid beside the kernels on the timeline.
 
     Args:
         output_path (str): Output data path.
@@ -104,6 +106,15 @@ class Profiler:
 
             if kwargs:
                 logger.warning("Params not be supported yet on GPU.")
+        elif self._device_target and self._device_target == "CPU":
+            from mindspore._c_expression import CPUProfiler
+            self._cpu_profiler = CPUProfiler.get_instance()
+            self._cpu_profiler.init(self._output_path)
+            self._cpu_profiler.step_profiling_enable(True)
+            os.environ['DEVICE_ID'] = str(self._dev_id)
+
+            if kwargs:
+                logger.warning("Params not be supported yet on CPU.")
         elif self._device_target and self._device_target == "Ascend":
             optypes_not_deal = kwargs.pop("optypes_not_deal", "Variable")
             if not isinstance(optypes_not_deal, str):
@@ -168,6 +179,19 @@ class Profiler:
 
             os.environ['PROFILING_MODE'] = str("false")
 
+        elif self._device_target and self._device_target == "CPU":
+            self._cpu_profiler.stop()
+
+            # parse minddata pipeline operator and queue for CPU
+            try:
+                pipeline_parser = MinddataPipelineParser(self._output_path, self._dev_id, self._output_path)
+                pipeline_parser.parse()
+            except ProfilerException as err:
+                logger.warning(err.message)
+
+            self._generate_cpu_timeline()
+            os.environ['PROFILING_MODE'] = str("false")
+
         elif self._device_target and self._device_target == "Ascend":
             release()
 
@@ -336,6 +360,45 @@ class Profiler:
             logger.warning('Fail to write timeline data: %s', err)
             raise RuntimeError('Fail to write timeline data.')
 
+    def _generate_cpu_timeline(self):
+        """Used for cpu, generate timeline info of the kernels and the dataset ops, write to json format file."""
+        try:
+            size_limit = 100 * 1024 * 1024  # 100MB
+            timeline_generator = CpuTimelineGenerator(self._output_path, self._dev_id)
+            timeline_generator.init_timeline()
+            timeline_generator.write_timeline(size_limit)
+            timeline_generator.write_timeline_summary()
+        except (ProfilerIOException, ProfilerFileNotFoundException, RuntimeError) as err:
+            logger.warning('Fail to write timeline data: %s', err)
+            raise RuntimeError('Fail to write timeline data.')
+
+    def pause(self):
+        """
+        Stop recording the kernels until resume is called, on GPU and CPU.
+
+        Examples:
+            >>> profiler = Profiler()
+            >>> profiler.pause()
+            >>> model.train(1, warmup_dataset)
+            >>> profiler.resume()
+            >>> model.train(1, dataset)
+            >>> profiler.analyse()
+        """
+        self._step_profiling_enable(False)
+
+    def resume(self):
+        """Record the kernels again after pause, on GPU and CPU."""
+        self._step_profiling_enable(True)
+
+    def _step_profiling_enable(self, enable_flag):
+        """Switch the recording of the kernels."""
+        if self._device_target == "GPU":
+            self._gpu_profiler.step_profiling_enable(enable_flag)
+        elif self._device_target == "CPU":
+            self._cpu_profiler.step_profiling_enable(enable_flag)
+        else:
+            logger.warning("Pause and resume are not supported on %s.", self._device_target)
+
     def _get_profiling_job_id(self):
         """Get profiling job id, which was generated by ada service.
 
@@ -480,7 +543,7 @@ class Profiler:
             dev_id = "0"
             logger.error("Fail to get DEVICE_ID, use 0 instead.")
 
-        if device_target and device_target not in ["Ascend", "GPU"]:
+        if device_target and device_target not in ["Ascend", "GPU", "CPU"]:
             msg = "Profiling: unsupported backend: %s" % device_target
             raise RuntimeError(msg)
 
@@ -23,8 +23,9 @@ from . import amp
 from .amp import build_train_network
 from .loss_scale_manager import LossScaleManager, FixedLossScaleManager, DynamicLossScaleManager
 from .serialization import save_checkpoint, load_checkpoint, load_param_into_net, export, parse_print,\
-    build_searched_strategy, merge_sliced_parameter
+    build_searched_strategy, merge_sliced_parameter, convert_checkpoint, compact_delta_checkpoint
 
 __all__ = ["Model", "DatasetHelper", "amp", "connect_network_with_dataset", "build_train_network", "LossScaleManager",
            "FixedLossScaleManager", "DynamicLossScaleManager", "save_checkpoint", "load_checkpoint",
-           "load_param_into_net", "export", "parse_print", "build_searched_strategy", "merge_sliced_parameter"]
+           "load_param_into_net", "export", "parse_print", "build_searched_strategy", "merge_sliced_parameter",
+           "convert_checkpoint", "compact_delta_checkpoint"]
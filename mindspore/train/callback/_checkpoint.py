@@ -24,7 +24,8 @@ from mindspore import log as logger
 from mindspore import nn
 from mindspore._checkparam import Validator
 from mindspore.train._utils import _make_directory
-from mindspore.train.serialization import save_checkpoint, _save_graph
+from mindspore.train.serialization import save_checkpoint, _save_graph, compact_delta_checkpoint, \
+    _is_delta_base, _get_checkpoint_chain, MANIFEST_SUFFIX
 from mindspore.parallel._ps_context import _is_role_pserver, _get_ps_mode_rank
 from ._callback import Callback, set_cur_net
 
@@ -92,9 +93,15 @@ class CheckpointConfig:
         async_save (bool): Whether asynchronous execution saves the checkpoint to a file. Default: False.
         saved_network (Cell): Network to be saved in checkpoint file. If the saved_network has no relation
             with the network in training, the initial value of saved_network will be saved. Default: None.
+        ckpt_format (str): The checkpoint file format, "PROTOBUF" or "NATIVE". Default: "PROTOBUF".
+        delta_save (bool): Whether to save delta checkpoints, which hold only the embedding rows the sparse
+            optimizers on CPU changed since the previous checkpoint. Needs ckpt_format "NATIVE". Default: False.
+        max_delta_num (int): The number of delta checkpoints saved in a row, the last of them is then compacted
+            into a full checkpoint in the background. A delta checkpoint is compacted before the checkpoint it is
+            based on is removed. Default: 4.
 
     Raises:
-        ValueError: If the input_param is None or 0.
+        ValueError: If the input_param is None or 0, or if delta_save is set with ckpt_format "PROTOBUF".
 
     Examples:
         >>> class LeNet5(nn.Cell):
@@ -135,7 +142,10 @@ class CheckpointConfig:
                  keep_checkpoint_per_n_minutes=0,
                  integrated_save=True,
                  async_save=False,
-                 saved_network=None):
+                 saved_network=None,
+                 ckpt_format="PROTOBUF",
+                 delta_save=False,
+                 max_delta_num=4):
 
         if save_checkpoint_steps is not None:
             save_checkpoint_steps = Validator.check_non_negative_int(save_checkpoint_steps)
@@ -169,6 +179,11 @@ class CheckpointConfig:
         self._integrated_save = Validator.check_bool(integrated_save)
         self._async_save = Validator.check_bool(async_save)
         self._saved_network = saved_network
+        self._ckpt_format = Validator.check_string(ckpt_format, ("PROTOBUF", "NATIVE"), "ckpt_format")
+        self._delta_save = Validator.check_bool(delta_save)
+        self._max_delta_num = Validator.check_positive_int(max_delta_num)
+        if self._delta_save and self._ckpt_format != "NATIVE":
+            raise ValueError("The delta_save needs ckpt_format 'NATIVE', but got {}.".format(self._ckpt_format))
 
     @property
     def save_checkpoint_steps(self):
@@ -205,6 +220,21 @@ class CheckpointConfig:
         """Get the value of _saved_network"""
         return self._saved_network
 
+    @property
+    def ckpt_format(self):
+        """Get the value of _ckpt_format"""
+        return self._ckpt_format
+
+    @property
+    def delta_save(self):
+        """Get the value of _delta_save"""
+        return self._delta_save
+
+    @property
+    def max_delta_num(self):
+        """Get the value of _max_delta_num"""
+        return self._max_delta_num
+
     def get_checkpoint_policy(self):
         """Get the policy of checkpoint."""
         checkpoint_policy = {'save_checkpoint_steps': self.save_checkpoint_steps,
@@ -238,6 +268,8 @@ class ModelCheckpoint(Callback):
         self._last_time = time.time()
         self._last_time_for_keep = time.time()
         self._last_triggered_step = 0
+        # The delta checkpoints saved since the last full one
+        self._delta_num = 0
 
         if _check_file_name_prefix(prefix):
             self._prefix = prefix
@@ -295,6 +327,7 @@ class ModelCheckpoint(Callback):
             for thread in thread_list:
                 if thread.getName() == "asyn_save_ckpt":
                     thread.join()
+            _join_compact_threads()
 
         from mindspore.parallel._cell_wrapper import destroy_allgather_cell
         destroy_allgather_cell()
@@ -322,6 +355,8 @@ class ModelCheckpoint(Callback):
         step_num_in_epoch = int((cb_params.cur_step_num - 1) % cb_params.batch_num + 1)
 
         if save_ckpt:
+            # The checkpoints a compaction rewrites are not removed meanwhile
+            _join_compact_threads()
             cur_ckpoint_file = self._prefix + "-" + str(cb_params.cur_epoch_num) + "_" \
                                + str(step_num_in_epoch) + ".ckpt"
             # update checkpoint file list.
@@ -348,8 +383,19 @@ class ModelCheckpoint(Callback):
                 cb_params.train_network.exec_checkpoint_graph()
 
             network = self._config.saved_network if self._config.saved_network is not None else cb_params.train_network
+            base_file = None
+            if self._config.delta_save and self._latest_ckpt_file_name and \
+                    os.path.exists(self._latest_ckpt_file_name) and _is_delta_base(self._latest_ckpt_file_name):
+                base_file = self._latest_ckpt_file_name
             save_checkpoint(network, cur_file, self._config.integrated_save,
-                            self._config.async_save)
+                            self._config.async_save, self._config.ckpt_format, base_file)
+            if base_file is None:
+                self._delta_num = 0
+            else:
+                self._delta_num += 1
+                if self._delta_num >= self._config.max_delta_num:
+                    compact_delta_checkpoint(cur_file, async_compact=True)
+                    self._delta_num = 0
 
             self._latest_ckpt_file_name = cur_file
 
@@ -359,6 +405,13 @@ class ModelCheckpoint(Callback):
         return self._latest_ckpt_file_name
 
 
+def _join_compact_threads():
+    """Wait for the delta checkpoints compacting in the background."""
+    for thread in threading.enumerate():
+        if thread.getName() == "compact_ckpt":
+            thread.join()
+
+
 class CheckpointManager:
     """Manage checkpoint files according to train_config of checkpoint."""
     def __init__(self):
@@ -389,8 +442,24 @@ class CheckpointManager:
                     self._ckpoint_filelist.append(directory + '/' + filename)
 
     def remove_ckpoint_file(self, file_name):
-        """Remove the specified checkpoint file from this checkpoint manager and also from the directory."""
+        """
+        Remove the specified checkpoint file from this checkpoint manager and also from the directory.
+
+        The delta checkpoints based on it are compacted into full checkpoints first, so they can still be loaded.
+        """
+        real_name = os.path.realpath(file_name)
+        for ck_file in self._ckpoint_filelist:
+            chain = _get_checkpoint_chain(ck_file)
+            if len(chain) < 2 or chain[1] != real_name:
+                continue
+            try:
+                compact_delta_checkpoint(ck_file)
+            except (RuntimeError, OSError):
+                logger.warning("Failed to compact the ckpt file %s, its base %s is kept.", ck_file, file_name)
+                return
         try:
+            if os.path.exists(file_name + MANIFEST_SUFFIX):
+                os.remove(file_name + MANIFEST_SUFFIX)
             os.chmod(file_name, stat.S_IWRITE)
             os.remove(file_name)
             self._ckpoint_filelist.remove(file_name)
@@ -16,6 +16,9 @@
 import os
 import stat
 import math
+import json
+import shutil
+import threading
 from threading import Thread, Lock
 import numpy as np
 
@@ -28,6 +31,9 @@ from mindspore.common.tensor import Tensor
 from mindspore.common.initializer import initializer
 from mindspore.common.parameter import Parameter
 from mindspore.common.api import _executor
+from mindspore._c_expression import CheckpointWriter_, CheckpointReader_, DeltaCheckpointWriter_, \
+    is_native_checkpoint, is_delta_checkpoint, convert_checkpoint_to_native, convert_checkpoint_to_proto, \
+    reset_changed_rows, load_checkpoint_chain, compact_checkpoint
 from mindspore.common import dtype as mstype
 from mindspore._checkparam import check_input_data, Validator
 from mindspore.compression.export import quant_export
@@ -45,6 +51,10 @@ tensor_to_np_type = {"Int8": np.int8, "Uint8": np.uint8, "Int16": np.int16, "Uin
 
 _ckpt_mutex = Lock()
 SLICE_SIZE = 512 * 1024 * 1024
+CKPT_FORMATS = ("PROTOBUF", "NATIVE")
+MANIFEST_SUFFIX = ".manifest"
+# The native checkpoint the changed rows are tracked from, the base a delta checkpoint can be saved on
+_last_native_ckpt = None
 
 
 def _special_process_par(par, new_par):
@@ -141,7 +151,44 @@ def _exec_save(ckpt_file_name, data_list):
         raise e
 
 
-def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False):
+def _exec_save_native(ckpt_file_name, names, tensors):
+    """Execute save native checkpoint into file process."""
+
+    global _last_native_ckpt
+    try:
+        with _ckpt_mutex:
+            CheckpointWriter_(ckpt_file_name).save(names, tensors)
+        os.chmod(ckpt_file_name, stat.S_IRUSR)
+
+    except BaseException as e:
+        logger.error("Failed to save the checkpoint file %s.", ckpt_file_name)
+        with _ckpt_mutex:
+            if _last_native_ckpt == ckpt_file_name:
+                _last_native_ckpt = None
+        raise e
+
+
+def _exec_save_delta(ckpt_file_name, base_ckpt_file_name, writer):
+    """Execute save delta checkpoint into file process."""
+
+    global _last_native_ckpt
+    try:
+        with _ckpt_mutex:
+            writer.write()
+        os.chmod(ckpt_file_name, stat.S_IRUSR)
+        os.chmod(ckpt_file_name + MANIFEST_SUFFIX, stat.S_IRUSR)
+
+    except BaseException as e:
+        logger.error("Failed to save the checkpoint file %s.", ckpt_file_name)
+        # The writer marked the rows changed again, the next delta can still be based on the previous checkpoint
+        with _ckpt_mutex:
+            if _last_native_ckpt == ckpt_file_name:
+                _last_native_ckpt = base_ckpt_file_name
+        raise e
+
+
+def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False, ckpt_format="PROTOBUF",
+                    base_ckpt_file_name=None):
     """
     Saves checkpoint info to a specified file.
 
@@ -152,16 +199,33 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
         ckpt_file_name (str): Checkpoint file name. If the file name already exists, it will be overwritten.
         integrated_save (bool): Whether to integrated save in automatic model parallel scene. Default: True
         async_save (bool): Whether asynchronous execution saves the checkpoint to a file. Default: False
+        ckpt_format (str): The file format, "PROTOBUF" or "NATIVE". A native checkpoint is written in parallel
+            straight from the tensor buffers, and is mapped instead of parsed when loaded, which makes large models
+            much faster to save and load. Default: "PROTOBUF".
+        base_ckpt_file_name (str): Save a delta checkpoint on this native checkpoint, which must be the last native
+            checkpoint saved. The embedding tables updated by the sparse optimizers on CPU are saved as the rows
+            changed since the base, the other parameters in full. load_checkpoint replays the chain of deltas down
+            to the full checkpoint, so all of them have to be kept. Default: None, save a full checkpoint.
 
     Raises:
         TypeError: If the parameter save_obj is not nn.Cell or list type.And if the parameter integrated_save and
                    async_save are not bool type.
+        ValueError: If ckpt_format is not "PROTOBUF" or "NATIVE", or if base_ckpt_file_name is not the last native
+                    checkpoint saved.
     """
 
     if not isinstance(save_obj, nn.Cell) and not isinstance(save_obj, list):
         raise TypeError("The parameter save_obj should be nn.Cell or list, but got {}".format(type(save_obj)))
     integrated_save = Validator.check_bool(integrated_save)
     async_save = Validator.check_bool(async_save)
+    ckpt_format = Validator.check_string(ckpt_format, CKPT_FORMATS, "ckpt_format")
+    if base_ckpt_file_name is not None:
+        Validator.check_value_type("base_ckpt_file_name", base_ckpt_file_name, [str], "save_checkpoint")
+        if ckpt_format != "NATIVE":
+            raise ValueError("A delta checkpoint needs ckpt_format 'NATIVE', but got {}.".format(ckpt_format))
+        if _last_native_ckpt is None or os.path.realpath(base_ckpt_file_name) != os.path.realpath(_last_native_ckpt):
+            raise ValueError("A delta checkpoint must be based on the last native checkpoint saved {}, but got {}."
+                             .format(_last_native_ckpt, base_ckpt_file_name))
 
     logger.info("Execute save checkpoint process.")
 
@@ -184,6 +248,15 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
             param_list.append(each_param)
         save_obj = param_list
 
+    if base_ckpt_file_name is not None:
+        _save_delta(save_obj, ckpt_file_name, base_ckpt_file_name, async_save)
+        logger.info("Save checkpoint process finish.")
+        return
+    if ckpt_format == "NATIVE":
+        _save_native(save_obj, ckpt_file_name, async_save)
+        logger.info("Save checkpoint process finish.")
+        return
+
     data_list = {}
     with _ckpt_mutex:
         for param in save_obj:
@@ -212,6 +285,78 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=F
     logger.info("Save checkpoint process finish.")
 
 
+def _save_native(save_obj, ckpt_file_name, async_save):
+    """Saves the parameters into a native checkpoint."""
+    global _last_native_ckpt
+    names = []
+    tensors = []
+    with _ckpt_mutex:
+        for param in save_obj:
+            if isinstance(param["data"], Parameter):
+                param["data"].init_data()
+            names.append(param["name"])
+            tensors.append(param["data"])
+        # The next delta checkpoint can be based on this one
+        reset_changed_rows(tensors)
+        _last_native_ckpt = ckpt_file_name
+        if async_save:
+            # The training goes on updating the parameters, so the asynchronous save writes a snapshot
+            tensors = [Tensor(tensor.asnumpy().copy()) for tensor in tensors]
+
+    if async_save:
+        thr = Thread(target=_exec_save_native, args=(ckpt_file_name, names, tensors), name="asyn_save_ckpt")
+        thr.start()
+    else:
+        _exec_save_native(ckpt_file_name, names, tensors)
+
+
+def _save_delta(save_obj, ckpt_file_name, base_ckpt_file_name, async_save):
+    """Saves the rows changed since the base checkpoint into a delta checkpoint."""
+    global _last_native_ckpt
+    with _ckpt_mutex:
+        names = []
+        tensors = []
+        for param in save_obj:
+            if isinstance(param["data"], Parameter):
+                param["data"].init_data()
+            names.append(param["name"])
+            tensors.append(param["data"])
+        writer = DeltaCheckpointWriter_(ckpt_file_name, base_ckpt_file_name)
+        writer.collect(names, tensors, async_save)
+        _last_native_ckpt = ckpt_file_name
+
+    if async_save:
+        thr = Thread(target=_exec_save_delta, args=(ckpt_file_name, base_ckpt_file_name, writer),
+                     name="asyn_save_ckpt")
+        thr.start()
+    else:
+        _exec_save_delta(ckpt_file_name, base_ckpt_file_name, writer)
+
+
+def _is_delta_base(ckpt_file_name):
+    """Whether a delta checkpoint can be saved on the checkpoint file."""
+    with _ckpt_mutex:
+        return _last_native_ckpt is not None and \
+            os.path.realpath(ckpt_file_name) == os.path.realpath(_last_native_ckpt)
+
+
+def _get_checkpoint_chain(ckpt_file_name):
+    """Gets the checkpoints a delta checkpoint replays when loaded, the delta itself first."""
+    chain = [os.path.realpath(ckpt_file_name)]
+    while True:
+        try:
+            with open(chain[-1] + MANIFEST_SUFFIX, "r") as f:
+                base = json.load(f)["base"]
+        except (OSError, ValueError, KeyError):
+            # A full checkpoint, or a delta that was compacted meanwhile
+            break
+        base = os.path.realpath(os.path.join(os.path.dirname(chain[-1]), base))
+        if base in chain:
+            break
+        chain.append(base)
+    return chain
+
+
 def _check_param_prefix(filter_prefix, param_name):
     """Checks whether the prefix of parameter name matches the given filter_prefix."""
     for prefix in filter_prefix:
@@ -221,7 +366,7 @@ def _check_param_prefix(filter_prefix, param_name):
     return False
 
 
-def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=None):
+def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=None, verify_checkpoint=False):
     """
     Loads checkpoint info from a specified file.
 
@@ -232,12 +377,16 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
                            in the param_dict into net with the same suffix. Default: False
         filter_prefix (Union[str, list[str], tuple[str]]): Parameters starting with the filter_prefix
             will not be loaded. Default: None.
+        verify_checkpoint (bool): Whether to check the checksums of a native checkpoint while loading it. This reads
+            the whole file, otherwise the parameters are only read when they are used. Protobuf checkpoints are
+            not affected. Default: False.
 
     Returns:
         Dict, key is parameter name, value is a Parameter.
 
     Raises:
         ValueError: Checkpoint file is incorrect.
+        RuntimeError: verify_checkpoint is True and a native checkpoint does not match its checksums.
 
     Examples:
         >>> ckpt_file_name = "./checkpoint/LeNet5-2_1875.ckpt"
@@ -268,7 +417,15 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
                 raise TypeError(f"The type of filter_prefix must be str, list[str] or tuple[str], "
                                 f"but got {str(type(prefix))} at index {index}.")
 
+    verify_checkpoint = Validator.check_bool(verify_checkpoint)
+
     logger.info("Execute load checkpoint process.")
+    if is_native_checkpoint(ckpt_file_name):
+        parameter_dict = _load_native_checkpoint(ckpt_file_name, filter_prefix, verify_checkpoint)
+        if net is not None:
+            load_param_into_net(net, parameter_dict, strict_load)
+        return parameter_dict
+
     checkpoint_list = Checkpoint()
 
     try:
@@ -327,6 +484,115 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     return parameter_dict
 
 
+def _load_native_checkpoint(ckpt_file_name, filter_prefix, verify):
+    """Loads the parameters of a native checkpoint, the tensors share the pages of the mapped file."""
+    parameter_dict = {}
+    try:
+        if is_delta_checkpoint(ckpt_file_name):
+            for name, tensor in load_checkpoint_chain(ckpt_file_name, verify):
+                if filter_prefix is not None and _check_param_prefix(filter_prefix, name):
+                    continue
+                parameter_dict[name] = Parameter(Tensor(tensor), name=name)
+        else:
+            reader = CheckpointReader_(ckpt_file_name)
+            for name in reader.names():
+                if filter_prefix is not None and _check_param_prefix(filter_prefix, name):
+                    continue
+                parameter_dict[name] = Parameter(Tensor(reader.get_tensor(name, verify)), name=name)
+        logger.info("Load checkpoint process finish.")
+
+    except BaseException as e:
+        logger.error("Failed to load the checkpoint file `%s`.", ckpt_file_name)
+        raise RuntimeError(e.__str__())
+
+    if not parameter_dict:
+        raise ValueError(f"The loaded parameter dict is empty after filtering, please check filter_prefix.")
+    return parameter_dict
+
+
+def convert_checkpoint(src_file_name, dst_file_name, ckpt_format="NATIVE"):
+    """
+    Converts a checkpoint file into another format. A delta checkpoint converts into a full checkpoint.
+
+    Args:
+        src_file_name (str): The checkpoint file to convert, in either format.
+        dst_file_name (str): The converted checkpoint file. If the file name already exists, it will be overwritten.
+        ckpt_format (str): The format to convert into, "PROTOBUF" or "NATIVE". Default: "NATIVE".
+
+    Raises:
+        ValueError: If the source file does not exist or ckpt_format is not "PROTOBUF" or "NATIVE".
+        RuntimeError: If the source file can not be converted.
+
+    Examples:
+        >>> convert_checkpoint("./checkpoint/LeNet5-2_1875.ckpt", "./checkpoint/LeNet5-2_1875_native.ckpt")
+    """
+    Validator.check_value_type("src_file_name", src_file_name, [str], "convert_checkpoint")
+    Validator.check_value_type("dst_file_name", dst_file_name, [str], "convert_checkpoint")
+    ckpt_format = Validator.check_string(ckpt_format, CKPT_FORMATS, "ckpt_format", "convert_checkpoint")
+    if not os.path.exists(src_file_name):
+        raise ValueError("The checkpoint file is not exist.")
+
+    try:
+        with _ckpt_mutex:
+            if os.path.exists(dst_file_name):
+                os.remove(dst_file_name)
+            native = is_native_checkpoint(src_file_name)
+            if ckpt_format == "NATIVE" and not native:
+                convert_checkpoint_to_native(src_file_name, dst_file_name)
+            elif ckpt_format == "NATIVE" and is_delta_checkpoint(src_file_name):
+                compact_checkpoint(src_file_name, dst_file_name)
+            elif ckpt_format == "PROTOBUF" and is_delta_checkpoint(src_file_name):
+                compact_checkpoint(src_file_name, dst_file_name + ".tmp")
+                convert_checkpoint_to_proto(dst_file_name + ".tmp", dst_file_name)
+                os.remove(dst_file_name + ".tmp")
+            elif ckpt_format == "PROTOBUF" and native:
+                convert_checkpoint_to_proto(src_file_name, dst_file_name)
+            else:
+                shutil.copyfile(src_file_name, dst_file_name)
+        os.chmod(dst_file_name, stat.S_IRUSR)
+
+    except BaseException as e:
+        logger.error("Failed to convert the checkpoint file %s.", src_file_name)
+        raise RuntimeError(e.__str__())
+
+
+def compact_delta_checkpoint(ckpt_file_name, async_compact=False):
+    """
+    Rewrites a delta checkpoint as a full checkpoint in place.
+
+    The file keeps its name and modification time, so the delta checkpoints based on it stay valid, and the
+    checkpoints it was based on are no longer needed to load it.
+
+    Args:
+        ckpt_file_name (str): The delta checkpoint file name.
+        async_compact (bool): Whether to compact in a background thread. The compaction runs after the
+            asynchronous saves in flight either way. Default: False.
+
+    Examples:
+        >>> compact_delta_checkpoint("./checkpoint/CKP-2_1875.ckpt")
+    """
+    Validator.check_value_type("ckpt_file_name", ckpt_file_name, [str], "compact_delta_checkpoint")
+    async_compact = Validator.check_bool(async_compact)
+    save_threads = [thread for thread in threading.enumerate() if thread.getName() == "asyn_save_ckpt"]
+    if not async_compact:
+        _exec_compact(ckpt_file_name, save_threads)
+        return
+    thr = Thread(target=_exec_compact, args=(ckpt_file_name, save_threads), name="compact_ckpt")
+    thr.start()
+
+
+def _exec_compact(ckpt_file_name, save_threads):
+    """Execute compact delta checkpoint process."""
+    for thread in save_threads:
+        thread.join()
+    try:
+        if is_delta_checkpoint(ckpt_file_name):
+            compact_checkpoint(ckpt_file_name, ckpt_file_name)
+    except BaseException as e:
+        logger.error("Failed to compact the checkpoint file %s.", ckpt_file_name)
+        raise e
+
+
 def load_param_into_net(net, parameter_dict, strict_load=False):
     """
     Loads parameters into network.
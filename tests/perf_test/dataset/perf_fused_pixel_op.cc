@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Images per second through the usual post decode tail of an ImageNet pipeline for 224x224 images, run op by op
+// and as one FusedPixelOp. Build it against the minddata sources and run it without arguments.
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/fused_pixel_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+constexpr int kNumImages = 500;
+
+// The ImageNet normalization as used by the resnet50 model implementation
+std::vector<std::shared_ptr<TensorOp>> ImageNetTail(bool to_fp16) {
+  std::vector<std::shared_ptr<TensorOp>> ops;
+  ops.push_back(std::make_shared<RandomHorizontalFlipOp>(0.5));
+  ops.push_back(std::make_shared<NormalizeOp>(123.675, 116.28, 103.53, 58.395, 57.12, 57.375));
+  ops.push_back(std::make_shared<HwcToChwOp>());
+  if (to_fp16) {
+    ops.push_back(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16)));
+  }
+  return ops;
+}
+
+Status RunUnfused(const std::vector<std::shared_ptr<TensorOp>> &ops, const std::shared_ptr<Tensor> &input,
+                  std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> in = input;
+  for (auto &op : ops) {
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(op->Compute(in, &out));
+    in = out;
+  }
+  *output = in;
+  return Status::OK();
+}
+
+Status RandomImage(int64_t height, int64_t width, std::shared_ptr<Tensor> *image) {
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({height, width, 3}), DataType(DataType::DE_UINT8), image));
+  uint32_t state = 12345;
+  for (auto itr = (*image)->begin<uint8_t>(); itr != (*image)->end<uint8_t>(); ++itr) {
+    state = state * 1664525 + 1013904223;
+    *itr = static_cast<uint8_t>(state >> 24);
+  }
+  return Status::OK();
+}
+
+Status Run() {
+  std::shared_ptr<Tensor> image;
+  RETURN_IF_NOT_OK(RandomImage(224, 224, &image));
+  for (bool to_fp16 : {false, true}) {
+    auto ops = ImageNetTail(to_fp16);
+    FusedPixelOp fused;
+    for (auto &op : ImageNetTail(to_fp16)) {
+      fused.Append(op);
+    }
+    std::shared_ptr<Tensor> out;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNumImages; ++i) {
+      RETURN_IF_NOT_OK(RunUnfused(ops, image, &out));
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNumImages; ++i) {
+      RETURN_IF_NOT_OK(fused.Compute(image, &out));
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("Flip, Normalize, HwcToChw%s: %.0f images/sec unfused, %.0f images/sec fused\n",
+           to_fp16 ? ", TypeCast(float16)" : "", kNumImages / std::chrono::duration<double>(mid - start).count(),
+           kNumImages / std::chrono::duration<double>(end - mid).count());
+  }
+  return Status::OK();
+}
+}  // namespace
+
+int main() {
+  Status rc = Run();
+  if (rc.IsError()) {
+    printf("%s\n", rc.ToString().c_str());
+    return 1;
+  }
+  return 0;
+}
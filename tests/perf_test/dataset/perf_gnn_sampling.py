@@ -0,0 +1,80 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test sampling performance of mindspore.dataset.GraphData on one and several workers"""
+import os
+import time
+import numpy as np
+
+import mindspore.dataset as ds
+from mindspore.mindrecord import FileWriter
+
+NUM_NODES = 100000
+DEGREE = 20
+
+graph_schema = {
+    "first_id": {"type": "int64"},
+    "second_id": {"type": "int64"},
+    "third_id": {"type": "int64"},
+    "type": {"type": "int32"},
+    "attribute": {"type": "string"},
+    "node_feature_index": {"type": "int32", "shape": [-1]},
+    "edge_feature_index": {"type": "int32", "shape": [-1]},
+    "node_feature_1": {"type": "int32", "shape": [-1]}
+}
+
+
+def write_graph(mindrecord):
+    """write a graph of NUM_NODES nodes with DEGREE random neighbors each"""
+    for suffix in ["", ".db"]:
+        if os.path.exists(mindrecord + suffix):
+            os.remove(mindrecord + suffix)
+    writer = FileWriter(mindrecord, 1)
+    writer.add_schema(graph_schema, "mindrecord_graph_schema")
+    nodes = [{"first_id": i, "second_id": 0, "third_id": 0, "type": 1, "attribute": 'n',
+              "node_feature_index": np.array([1], dtype=np.int32),
+              "edge_feature_index": np.array([-1], dtype=np.int32),
+              "node_feature_1": np.array([i % 100], dtype=np.int32)} for i in range(NUM_NODES)]
+    writer.write_raw_data(nodes)
+    dst = np.random.RandomState(1).randint(0, NUM_NODES, NUM_NODES * DEGREE)
+    edges = [{"first_id": i, "second_id": i // DEGREE, "third_id": int(dst[i]), "type": 0, "attribute": 'e',
+              "node_feature_index": np.array([-1], dtype=np.int32),
+              "edge_feature_index": np.array([-1], dtype=np.int32),
+              "node_feature_1": np.array([0], dtype=np.int32)} for i in range(NUM_NODES * DEGREE)]
+    writer.write_raw_data(edges)
+    writer.commit()
+
+
+def sample(mindrecord, num_workers):
+    """print the nodes per second each query samples"""
+    ds.config.set_seed(5)
+    graph = ds.GraphData(mindrecord, num_workers)
+    node_list = list(range(NUM_NODES))
+    queries = {
+        "get_sampled_neighbors [10, 5]": lambda: graph.get_sampled_neighbors(node_list, [10, 5], [1, 1]),
+        "get_neg_sampled_neighbors 5": lambda: graph.get_neg_sampled_neighbors(node_list, 5, 1),
+        "random_walk 10 steps": lambda: graph.random_walk(node_list, [1] * 10, 2.0, 0.5, -1)
+    }
+    for name, query in queries.items():
+        start = time.time()
+        query()
+        end = time.time()
+        print("{} on {} workers: {:.0f} nodes/sec".format(name, num_workers, NUM_NODES / (end - start)))
+
+
+if __name__ == '__main__':
+    mindrecord_test = './perf_gnn_sampling.mindrecord'
+    write_graph(mindrecord_test)
+    sample(mindrecord_test, 1)
+    sample(mindrecord_test, 8)
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Items per second through Queue and LockFreeQueue, and through a Connector built on either of them, for different
+// numbers of producers and consumers. Items are small so the cost is dominated by the queue.
+// Build it against the minddata sources and run it without arguments.
+#include <chrono>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/util/lock_free_queue.h"
+#include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/task_manager.h"
+
+using mindspore::dataset::Connector;
+using mindspore::dataset::LockFreeQueue;
+using mindspore::dataset::Queue;
+using mindspore::dataset::Status;
+using mindspore::dataset::TaskGroup;
+using mindspore::dataset::TaskManager;
+
+namespace {
+constexpr int kQueueCapacity = 16;
+constexpr int64_t kItemsPerProducer = 200000;
+
+double QueueItemsPerSec(Queue<int64_t> *que, int num_producers, int num_consumers) {
+  TaskGroup vg;
+  int64_t total = kItemsPerProducer * num_producers;
+  auto start = std::chrono::steady_clock::now();
+  for (int p = 0; p < num_producers; ++p) {
+    vg.CreateAsyncTask("Producer", [que]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t i = 0; i < kItemsPerProducer; ++i) {
+        RETURN_IF_NOT_OK(que->Add(i));
+      }
+      return Status::OK();
+    });
+  }
+  for (int c = 0; c < num_consumers; ++c) {
+    // Spread the items over the consumers, the first consumer takes the remainder.
+    int64_t count = total / num_consumers + (c == 0 ? total % num_consumers : 0);
+    vg.CreateAsyncTask("Consumer", [que, count]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t i = 0; i < count; ++i) {
+        int64_t v = 0;
+        RETURN_IF_NOT_OK(que->PopFront(&v));
+      }
+      return Status::OK();
+    });
+  }
+  vg.join_all();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return total / elapsed.count();
+}
+
+double ConnectorItemsPerSec(bool lock_free, int num_producers) {
+  Connector<int64_t> conn(num_producers, 1, kQueueCapacity, lock_free);
+  TaskGroup vg;
+  int64_t total = kItemsPerProducer * num_producers;
+  auto start = std::chrono::steady_clock::now();
+  for (int p = 0; p < num_producers; ++p) {
+    vg.CreateAsyncTask("Producer", [&conn, p]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t i = 0; i < kItemsPerProducer; ++i) {
+        RETURN_IF_NOT_OK(conn.Push(p, i));
+      }
+      return Status::OK();
+    });
+  }
+  for (int64_t i = 0; i < total; ++i) {
+    int64_t v = 0;
+    if (conn.Pop(0, &v).IsError()) {
+      break;
+    }
+  }
+  vg.join_all();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return total / elapsed.count();
+}
+}  // namespace
+
+int main() {
+  const std::vector<std::pair<int, int>> configs = {{1, 1}, {2, 1}, {4, 1}, {2, 2}, {4, 4}, {8, 8}};
+  for (auto &config : configs) {
+    Queue<int64_t> blocking(kQueueCapacity);
+    LockFreeQueue<int64_t> lock_free(kQueueCapacity);
+    double blocking_rate = QueueItemsPerSec(&blocking, config.first, config.second);
+    double lock_free_rate = QueueItemsPerSec(&lock_free, config.first, config.second);
+    printf("queue producers %d consumers %d: blocking %.2fM items/s, lock free %.2fM items/s\n", config.first,
+           config.second, blocking_rate / 1e6, lock_free_rate / 1e6);
+  }
+  for (int num_producers : {1, 2, 4, 8}) {
+    double blocking_rate = ConnectorItemsPerSec(false, num_producers);
+    double lock_free_rate = ConnectorItemsPerSec(true, num_producers);
+    printf("connector producers %d consumers 1: blocking %.2fM items/s, lock free %.2fM items/s\n", num_producers,
+           blocking_rate / 1e6, lock_free_rate / 1e6);
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test tokenizing performance of mindspore.dataset.text.WordpieceTokenizer"""
+import string
+import time
+import numpy as np
+
+import mindspore.dataset as ds
+import mindspore.dataset.text as text
+
+VOCAB_SIZE = 30000
+NUM_SENTENCES = 2000
+WORDS_PER_SENTENCE = 64
+
+
+def build_vocab(rnd):
+    """a vocab of VOCAB_SIZE words and sub words, the size of the BERT vocab"""
+    words = ["[UNK]"]
+    seen = set()
+    while len(words) < VOCAB_SIZE:
+        word = "##" if len(words) % 3 == 0 else ""
+        word += "".join(rnd.choice(list(string.ascii_lowercase), rnd.randint(2, 7)))
+        if word not in seen:
+            seen.add(word)
+            words.append(word)
+    return words
+
+
+def build_sentences(rnd, words):
+    """sentences of words made of the vocab words"""
+    sentences = []
+    for _ in range(NUM_SENTENCES):
+        sentence = []
+        for _ in range(WORDS_PER_SENTENCE):
+            word = ""
+            while len(word) < 8:
+                piece = words[rnd.randint(1, len(words))]
+                word += piece[2:] if piece.startswith("##") else piece
+            sentence.append(word)
+        sentences.append(np.array(sentence))
+    return sentences
+
+
+def use_wordpiece_tokenizer(words, sentences):
+    data_set = ds.GeneratorDataset(lambda: ((sentence,) for sentence in sentences), ["text"], shuffle=False)
+    tokenizer_op = text.WordpieceTokenizer(vocab=text.Vocab.from_list(words), unknown_token="[UNK]")
+    data_set = data_set.map(operations=tokenizer_op, input_columns=["text"])
+    start = time.time()
+    num_tokens = 0
+    for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True):
+        num_tokens += item["text"].size
+    end = time.time()
+    print("WordpieceTokenizer: {} tokens from {} words, {:.0f} tokens/sec".format(
+        num_tokens, NUM_SENTENCES * WORDS_PER_SENTENCE, num_tokens / (end - start)))
+
+
+if __name__ == '__main__':
+    random_state = np.random.RandomState(1)
+    vocab_words = build_vocab(random_state)
+    use_wordpiece_tokenizer(vocab_words, build_sentences(random_state, vocab_words))
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Rows per second of ShardReader::GetNextRefById on a MindRecord file read by stream and by mmap, over many epochs
+// so the file is in the page cache. Build it against the mindrecord sources and run it as:
+// perf_shard_reader_mmap <mindrecord file> [epochs]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "minddata/mindrecord/include/shard_reader.h"
+
+using mindspore::mindrecord::ShardReader;
+using mindspore::mindrecord::ShardReadMode;
+using mindspore::mindrecord::SUCCESS;
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    printf("usage: %s <mindrecord file> [epochs]\n", argv[0]);
+    return 1;
+  }
+  std::string file_name = argv[1];
+  int epochs = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  for (auto read_mode : {ShardReadMode::kStream, ShardReadMode::kMmap}) {
+    ShardReader dataset;
+    dataset.SetReadMode(read_mode);
+    if (dataset.Open({file_name}, true, 1) != SUCCESS || dataset.Launch(true) != SUCCESS) {
+      printf("failed to open %s\n", file_name.c_str());
+      return 1;
+    }
+    int num_rows = dataset.GetNumRows();
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int epoch = 0; epoch < epochs; ++epoch) {
+      for (int row_id = 0; row_id < num_rows; ++row_id) {
+        auto row = dataset.GetNextRefById(row_id, 0);
+        const auto &blob_ref = std::get<0>(row.second[0]);
+        checksum += blob_ref.size > 0 ? blob_ref.data[blob_ref.size - 1] : 0;
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    dataset.Close();
+    printf("%s read %.0f rows/s, checksum %lu\n", read_mode == ShardReadMode::kMmap ? "mmap" : "stream",
+           num_rows * epochs / elapsed.count(), static_cast<unsigned long>(checksum));
+  }
+  return 0;
+}
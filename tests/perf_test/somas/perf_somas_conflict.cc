@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Time and peak memory of the SOMAS conflict computation on a synthetic graph of n tensors, one per node.
+// Build it against the somas sources and run it as: perf_somas_conflict <num_tensors>
+#include <sys/resource.h>
+#include <algorithm>
+#include <any>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// The graph is built directly in the Somas lists, without a kernel graph
+#define private public
+#include "backend/optimizer/somas/somas.h"
+#undef private
+
+using mindspore::somas::kCommonNode;
+using mindspore::somas::kLifeLongGraphAll;
+using mindspore::somas::Somas;
+using mindspore::somas::SomasNode;
+using mindspore::somas::SomasStream;
+using mindspore::somas::SomasTensor;
+
+namespace {
+constexpr int64_t kNumStreams = 4;
+constexpr size_t kNodesPerChunk = 64;
+
+// The nodes run in chunks of kNodesPerChunk on kNumStreams streams, streams 0 and 1 are grouped. Each tensor has
+// one to three consumers, mostly in the next 32 nodes and sometimes up to 512 nodes later, 1% of them are lifelong.
+void BuildGraph(size_t num_tensors, Somas *somas) {
+  for (int64_t s = 0; s < kNumStreams; s++) {
+    somas->streams_list_.push_back(std::make_shared<SomasStream>(s));
+  }
+  std::mt19937 rnd(7);
+  for (size_t i = 0; i < num_tensors; i++) {
+    auto stream = somas->streams_list_[(i / kNodesPerChunk) % kNumStreams];
+    auto node = std::make_shared<SomasNode>(i, kCommonNode, stream);
+    somas->nodes_list_.push_back(node);
+    auto tensor = std::make_shared<SomasTensor>(i, node, stream, 1024 + rnd() % 4096);
+    tensor->lifetime_.start_ = i;
+    tensor->lifetime_.end_ = i;
+    if (rnd() % 100 == 0) {
+      tensor->lifelong_value_ = kLifeLongGraphAll;
+    }
+    somas->tensors_list_.push_back(tensor);
+    somas->tensors_map_[i] = tensor;
+    stream->tensors_.push_back(tensor);
+    node->tensors_.insert(tensor);
+  }
+  for (size_t i = 0; i < num_tensors; i++) {
+    auto tensor = somas->tensors_list_[i];
+    size_t uses = 1 + rnd() % 3;
+    for (size_t u = 0; u < uses; u++) {
+      size_t dst_id = i + 1 + (rnd() % 8 == 0 ? rnd() % 512 : rnd() % 32);
+      if (dst_id >= num_tensors) {
+        continue;
+      }
+      auto dst = somas->nodes_list_[dst_id];
+      tensor->destinations_.insert(dst);
+      tensor->destinationStreams_.insert(dst->GetStream());
+      tensor->lifetime_.end_ = std::max(tensor->lifetime_.end_, dst_id);
+      dst->ancestor_nodes_.insert(somas->nodes_list_[i]);
+      if (dst->GetStream() != tensor->GetSourceStream()) {
+        tensor->between_streams_ = true;
+        dst->GetStream()->ancestor_streams_.insert(tensor->GetSourceStream());
+      }
+    }
+  }
+  somas->streams_groups_ = {{0, 1}};
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t num_tensors = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+  Somas somas;
+  BuildGraph(num_tensors, &somas);
+  auto start = std::chrono::steady_clock::now();
+  somas.ComputeConflictPairs();
+  auto end = std::chrono::steady_clock::now();
+  size_t conflicts = 0;
+  for (size_t i = 0; i < num_tensors; i++) {
+    conflicts += somas.cannot_reuse_->CountRow(i);
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  printf("%zu tensors: %zu conflicts in %.1f s, peak rss %ld MB\n", num_tensors, conflicts,
+         std::chrono::duration<double>(end - start).count(), usage.ru_maxrss / 1024);
+  return 0;
+}
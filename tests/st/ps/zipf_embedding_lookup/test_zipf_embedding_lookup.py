@@ -0,0 +1,116 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import os
+import sys
+import time
+import argparse
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.common import dtype as mstype
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Adam
+from mindspore.common import set_seed
+from mindspore.ops import operations as P
+from mindspore.parallel._ps_context import _is_role_pserver
+
+parser = argparse.ArgumentParser(description="test_zipf_embedding_lookup")
+parser.add_argument("--device_target", type=str, default="Ascend")
+parser.add_argument("--vocab_size", type=int, default=200000)
+parser.add_argument("--embedding_size", type=int, default=64)
+parser.add_argument("--batch_size", type=int, default=1024)
+parser.add_argument("--field_size", type=int, default=16)
+parser.add_argument("--zipf_a", type=float, default=1.2)
+parser.add_argument("--warmup_steps", type=int, default=10)
+parser.add_argument("--steps", type=int, default=200)
+args, _ = parser.parse_known_args()
+device_target = args.device_target
+context.set_context(
+    mode=context.GRAPH_MODE, device_target=device_target, enable_sparse=True
+)
+context.set_ps_context(enable_ps=True)
+
+
+class EmbeddingNet(nn.Cell):
+    def __init__(self, vocab_size, embedding_size):
+        super(EmbeddingNet, self).__init__()
+        self.embedding = nn.EmbeddingLookup(vocab_size, embedding_size)
+        self.reduce_sum = P.ReduceSum()
+        self.fc = nn.Dense(embedding_size, 1)
+
+    def construct(self, x):
+        x = self.embedding(x)
+        x = self.reduce_sum(x, 1)
+        x = self.fc(x)
+        return x
+
+
+def zipf_ids(batch_size, field_size, vocab_size, a):
+    # The smallest ids are the hottest, so they all fall into the row range of the first server
+    ids = (np.random.zipf(a, (batch_size, field_size)) - 1) % vocab_size
+    return Tensor(ids.astype(np.int32))
+
+
+def run_zipf_embedding_lookup():
+    net = EmbeddingNet(args.vocab_size, args.embedding_size)
+    net.embedding.embedding_table.set_param_ps()
+
+    optimizer = Adam(filter(lambda x: x.requires_grad, net.get_parameters()))
+    optimizer.target = 'CPU'
+    net_with_criterion = WithLossCell(net, nn.MSELoss())
+    train_network = TrainOneStepCell(net_with_criterion, optimizer)
+    train_network.set_train()
+
+    label = Tensor(np.zeros((args.batch_size, 1), np.float32))
+    batches = [zipf_ids(args.batch_size, args.field_size, args.vocab_size, args.zipf_a) for _ in range(16)]
+    if _is_role_pserver():
+        train_network(batches[0], label)
+        sys.exit()
+
+    for i in range(args.warmup_steps):
+        train_network(batches[i % len(batches)], label)
+    start = time.time()
+    for i in range(args.steps):
+        loss = train_network(batches[i % len(batches)], label).asnumpy()
+    elapsed = time.time() - start
+    ids_per_second = args.steps * args.batch_size * args.field_size / elapsed
+    print("zipf a {}, rebalance interval {}: {:.2f} ms per step, {:.0f} looked up ids per second, loss {}".format(
+        args.zipf_a, os.environ.get("MS_PS_EMBEDDING_REBALANCE_INTERVAL", "0"), elapsed * 1000 / args.steps,
+        ids_per_second, loss))
+    assert np.all(np.isfinite(loss))
+    check_replica_rows(net)
+
+
+def check_replica_rows(net):
+    """Looks up the hottest rows repeatedly without training, replicated rows go to every server holding them."""
+    hot_ids = Tensor(np.arange(args.batch_size * args.field_size).reshape(args.batch_size, args.field_size)
+                     .astype(np.int32) % 64)
+    interval = int(os.environ.get("MS_PS_EMBEDDING_REBALANCE_INTERVAL", "0"))
+    # A rebalance refreshes the replicas from their owners, nothing updates the table after it
+    for _ in range(interval):
+        net.embedding(hot_ids)
+    expected = net.embedding(hot_ids).asnumpy()
+    server_num = int(os.environ.get("MS_SERVER_NUM", "1"))
+    for _ in range(server_num):
+        assert np.array_equal(net.embedding(hot_ids).asnumpy(), expected)
+
+
+if __name__ == "__main__":
+    set_seed(0)
+    np.random.seed(0)
+    run_zipf_embedding_lookup()
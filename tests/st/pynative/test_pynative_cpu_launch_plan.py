@@ -0,0 +1,79 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test repeated single ops launched from the launch plan on CPU """
+import numpy as np
+import pytest
+
+from mindspore import Tensor, context
+from mindspore.ops import operations as P
+
+
+def setup_module():
+    context.set_context(mode=context.PYNATIVE_MODE, device_target="CPU")
+
+
+def softmax_cross_entropy(logits, labels):
+    exp = np.exp(logits - logits.max(axis=1, keepdims=True))
+    prob = exp / exp.sum(axis=1, keepdims=True)
+    loss = -(labels * np.log(prob + 1e-20)).sum(axis=1)
+    return loss, prob - labels
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_repeated_op_outputs():
+    add = P.TensorAdd()
+    x = np.random.randn(4, 8).astype(np.float32)
+    y = np.random.randn(4, 8).astype(np.float32)
+    first = add(Tensor(x), Tensor(y))
+    # The second run takes the launch plan and must not write into the output of the first
+    second = add(Tensor(y), Tensor(y))
+    assert np.allclose(first.asnumpy(), x + y)
+    assert np.allclose(second.asnumpy(), y + y)
+    assert np.allclose(add(Tensor(x), Tensor(y)).asnumpy(), first.asnumpy())
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_repeated_op_with_workspace():
+    op = P.SoftmaxCrossEntropyWithLogits()
+    labels = np.eye(4, 6).astype(np.float32)
+    for _ in range(3):
+        logits = np.random.randn(4, 6).astype(np.float32)
+        loss, backprop = op(Tensor(logits), Tensor(labels))
+        expect_loss, expect_backprop = softmax_cross_entropy(logits, labels)
+        assert np.allclose(loss.asnumpy(), expect_loss, rtol=1e-4, atol=1e-5)
+        assert np.allclose(backprop.asnumpy(), expect_backprop, rtol=1e-4, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_repeated_op_shape_change():
+    add = P.TensorAdd()
+    # Shapes alternate between the planned one and others, each run must match the full path
+    for shape in [(2, 3), (2, 3), (5, 7), (2, 3), (5, 7), (1,), (2, 3)]:
+        x = np.random.randn(*shape).astype(np.float32)
+        y = np.random.randn(*shape).astype(np.float32)
+        out = add(Tensor(x), Tensor(y))
+        assert out.shape == shape
+        assert np.allclose(out.asnumpy(), x + y)
+    # A type change of the same shape
+    x = np.random.randint(0, 10, (2, 3)).astype(np.int32)
+    out = add(Tensor(x), Tensor(x))
+    assert out.asnumpy().dtype == np.int32
+    assert np.array_equal(out.asnumpy(), x + x)
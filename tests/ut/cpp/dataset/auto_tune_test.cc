@@ -0,0 +1,240 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
+#include "minddata/dataset/engine/db_connector.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+std::shared_ptr<RepeatOp> Repeat(int repeat_cnt);
+
+std::shared_ptr<TFReaderOp> TFReader(std::string schema, int rows_per_buf, int num_works);
+
+std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+
+std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                           bool shuf = false, std::shared_ptr<SamplerRT> sampler = nullptr,
+                                           std::map<std::string, int32_t> map = {}, bool decode = false);
+
+// Passes its input on after a while, a map op with it keeps its consumer waiting
+class SlowOp : public TensorOp {
+ public:
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    *output = input;
+    return Status::OK();
+  }
+
+  std::string Name() const override { return "SlowOp"; }
+};
+
+class MindDataTestAutoTune : public UT::DatasetOpTesting {
+ protected:
+  // Runs a tree and prints each row to a string. on_row is called with the index of each row before it is fetched.
+  static std::vector<std::string> Run(const std::shared_ptr<ExecutionTree> &tree,
+                                      const std::function<void(int32_t)> &on_row) {
+    std::vector<std::string> rows;
+    EXPECT_OK(tree->Prepare());
+    EXPECT_OK(tree->Launch());
+    DatasetIterator di(tree);
+    TensorRow row;
+    on_row(0);
+    EXPECT_OK(di.FetchNextTensorRow(&row));
+    while (!row.empty()) {
+      std::ostringstream ss;
+      for (auto &tensor : row) {
+        ss << *tensor << "\n";
+      }
+      rows.push_back(ss.str());
+      on_row(static_cast<int32_t>(rows.size()));
+      EXPECT_OK(di.FetchNextTensorRow(&row));
+    }
+    return rows;
+  }
+
+  std::shared_ptr<MapOp> Map(int32_t num_workers, std::shared_ptr<TensorOp> func = nullptr) {
+    std::shared_ptr<MapOp> map_op;
+    if (func == nullptr) {
+      func = std::make_shared<TypeCastOp>(DataType(DataType::DE_INT64));
+    }
+    std::vector<std::shared_ptr<TensorOp>> funcs = {func};
+    EXPECT_OK(MapOp::Builder()
+                .SetInColNames({"label"})
+                .SetOutColNames({})
+                .SetTensorFuncs(funcs)
+                .SetNumWorkers(num_workers)
+                .Build(&map_op));
+    return map_op;
+  }
+
+  std::shared_ptr<BatchOp> Batch(int32_t batch_size, int32_t num_workers) {
+    std::shared_ptr<BatchOp> batch_op;
+    EXPECT_OK(BatchOp::Builder(batch_size).SetNumWorkers(num_workers).Build(&batch_op));
+    return batch_op;
+  }
+};
+
+TEST_F(MindDataTestAutoTune, TestActiveProducersBuffer) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestActiveProducersBuffer.";
+  // Four producers fill round robin, then only two, then three
+  DbConnector connector(4, 1, 8);
+  auto add = [&connector](int32_t producer, int32_t id, DataBuffer::BufferFlags flags) {
+    ASSERT_OK(connector.Add(producer, std::make_unique<DataBuffer>(id, flags)));
+  };
+  for (int32_t id = 0; id < 4; ++id) {
+    add(id % 4, id, DataBuffer::kDeBFlagNone);
+  }
+  add(0, 2, DataBuffer::kDeBFlagActiveProducers);
+  for (int32_t id = 4; id < 8; ++id) {
+    add(id % 2, id, DataBuffer::kDeBFlagNone);
+  }
+  add(0, 3, DataBuffer::kDeBFlagActiveProducers);
+  for (int32_t id = 8; id < 11; ++id) {
+    add((id - 8) % 3, id, DataBuffer::kDeBFlagNone);
+  }
+  add(0, 0, DataBuffer::kDeBFlagEOF);
+
+  std::unique_ptr<DataBuffer> buffer;
+  for (int32_t id = 0; id < 11; ++id) {
+    ASSERT_OK(connector.PopWithRetry(0, &buffer));
+    EXPECT_EQ(buffer->buffer_flags(), DataBuffer::kDeBFlagNone);
+    EXPECT_EQ(buffer->id(), id);
+  }
+  ASSERT_OK(connector.PopWithRetry(0, &buffer));
+  EXPECT_TRUE(buffer->eof());
+  EXPECT_EQ(connector.out_buffers_count(), 12);
+}
+
+TEST_F(MindDataTestAutoTune, TestFindBottleneck) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestFindBottleneck.";
+  // The root is not starved
+  EXPECT_EQ(AutoTune::FindBottleneck({}), -1);
+  EXPECT_EQ(AutoTune::FindBottleneck({0.6, 0.0, 0.0}), -1);
+  // The first op that reads a backed up queue
+  EXPECT_EQ(AutoTune::FindBottleneck({0.0, 0.9, 0.9}), 0);
+  EXPECT_EQ(AutoTune::FindBottleneck({0.1, 0.3, 0.8}), 1);
+  // The whole path waits for the leaf
+  EXPECT_EQ(AutoTune::FindBottleneck({0.0, 0.1, 0.0}), 2);
+  EXPECT_EQ(AutoTune::FindBottleneck({0.1}), 0);
+}
+
+TEST_F(MindDataTestAutoTune, TestMapActiveWorkers) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestMapActiveWorkers.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  auto expect = Run(Build({ImageFolder(4, 2, 8, folder_path), Repeat(2), Map(4)}), [](int32_t) {});
+  EXPECT_EQ(expect.size(), 88);
+
+  // Changing the workers while the tree runs keeps the order of the rows
+  auto map_op = Map(4);
+  map_op->SetActiveWorkers(1);
+  EXPECT_EQ(map_op->active_workers(), 1);
+  std::map<int32_t, int32_t> changes = {{5, 3}, {20, 4}, {33, 2}, {50, 1}, {70, 4}};
+  auto actual = Run(Build({ImageFolder(4, 2, 8, folder_path), Repeat(2), map_op}), [&map_op, &changes](int32_t row) {
+    auto itr = changes.find(row);
+    if (itr != changes.end()) {
+      map_op->SetActiveWorkers(itr->second);
+    }
+  });
+  EXPECT_EQ(actual, expect);
+
+  // Out of range counts are clamped
+  map_op->SetActiveWorkers(0);
+  EXPECT_EQ(map_op->active_workers(), 1);
+  map_op->SetActiveWorkers(9);
+  EXPECT_EQ(map_op->active_workers(), 4);
+}
+
+TEST_F(MindDataTestAutoTune, TestBatchActiveWorkers) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestBatchActiveWorkers.";
+  std::string schema_file = datasets_root_path_ + "/testBatchDataset/test.data";
+  auto expect = Run(Build({TFReader(schema_file, 2, 4), Repeat(2), Batch(2, 4)}), [](int32_t) {});
+  EXPECT_EQ(expect.size(), 12);
+
+  auto batch_op = Batch(2, 4);
+  std::map<int32_t, int32_t> changes = {{1, 2}, {4, 3}, {7, 1}, {9, 4}};
+  auto actual = Run(Build({TFReader(schema_file, 2, 4), Repeat(2), batch_op}), [&batch_op, &changes](int32_t row) {
+    auto itr = changes.find(row);
+    if (itr != changes.end()) {
+      batch_op->SetActiveWorkers(itr->second);
+    }
+  });
+  EXPECT_EQ(actual, expect);
+}
+
+TEST_F(MindDataTestAutoTune, TestCpuBudget) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestCpuBudget.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  auto map_op = Map(4);
+  auto batch_op = Batch(4, 5);
+  auto tree = Build({ImageFolder(4, 2, 8, folder_path), map_op, batch_op});
+  ASSERT_OK(tree->Prepare());
+  // The map and batch workers are cut down in proportion to fit into 3 cores
+  AutoTune auto_tune(tree.get(), 3);
+  auto_tune.Init();
+  EXPECT_EQ(map_op->active_workers(), 1);
+  EXPECT_EQ(batch_op->active_workers(), 1);
+  auto_tune.LogConfiguration();
+  EXPECT_GT(AutoTune::ResidentMemory(), 0);
+}
+
+TEST_F(MindDataTestAutoTune, TestStarvedMapGainsWorkers) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestStarvedMapGainsWorkers.";
+  int32_t num_cores = static_cast<int32_t>(std::thread::hardware_concurrency());
+  if (num_cores < 2) {
+    MS_LOG(INFO) << "One CPU core, there is nothing to grow to.";
+    return;
+  }
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  auto expect = Run(Build({ImageFolder(4, 2, 8, folder_path), Map(1, std::make_shared<SlowOp>()), Repeat(2)}),
+                    [](int32_t) {});
+  EXPECT_EQ(expect.size(), 88);
+
+  auto cfg = GlobalContext::config_manager();
+  bool enable_autotune = cfg->enable_autotune();
+  uint32_t autotune_interval = cfg->autotune_interval();
+  int32_t sampling_interval = cfg->monitor_sampling_interval();
+  cfg->set_enable_autotune(true);
+  cfg->set_autotune_interval(40);
+  cfg->set_monitor_sampling_interval(10);
+  auto map_op = Map(1, std::make_shared<SlowOp>());
+  auto actual = Run(Build({ImageFolder(4, 2, 8, folder_path), map_op, Repeat(2)}), [](int32_t) {});
+  cfg->set_enable_autotune(enable_autotune);
+  cfg->set_autotune_interval(autotune_interval);
+  cfg->set_monitor_sampling_interval(sampling_interval);
+
+  // The map op starved the consumer with the one worker it was built with and got more of the ones launched for it
+  EXPECT_EQ(actual, expect);
+  EXPECT_EQ(map_op->num_workers(), num_cores);
+  EXPECT_GT(map_op->active_workers(), 1);
+}
@@ -46,7 +46,7 @@ public:
   // two layer. You can set different num of threads on layer 1 and 2, and layer 3
   // that does the serialization to _ouput vector needs to be single thread.
   // A random sleep/delay can be introduced for each thread. See run().
-  Status Run_test_1();
+  Status Run_test_1(bool lock_free = false);
 
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
@@ -123,6 +123,14 @@ TEST_F(MindDataTestConnector, Test2) {
 }
 
 
+// Test3: the same chain as Test1, with lock free queues inside both connectors.
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3.";
+  Status rc = this->Run_test_1(true);
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
@@ -172,7 +180,7 @@ Status MindDataTestConnector::Run_test_0() {
   return ValidateOutput(output);
 }
 
-Status MindDataTestConnector::Run_test_1() {
+Status MindDataTestConnector::Run_test_1(bool lock_free) {
   std::vector<uint32_t> output;
   Status rc;
   wp.Clear();
@@ -188,11 +196,13 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     lock_free);
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     lock_free);
 
   rc = conn1->Register(tg_.get());
   RETURN_IF_NOT_OK(rc);
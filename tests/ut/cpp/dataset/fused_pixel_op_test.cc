@@ -0,0 +1,191 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/data/to_float16_op.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/fused_pixel_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/random_vertical_flip_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestFusedPixelOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedPixelOp() : CVOpCommon() {}
+
+  // The ImageNet normalization as used by the resnet50 model implementation
+  static std::vector<std::shared_ptr<TensorOp>> ImageNetTail(float flip_probability, bool to_fp16) {
+    std::vector<std::shared_ptr<TensorOp>> ops;
+    ops.push_back(std::make_shared<RandomHorizontalFlipOp>(flip_probability));
+    ops.push_back(std::make_shared<NormalizeOp>(123.675, 116.28, 103.53, 58.395, 57.12, 57.375));
+    ops.push_back(std::make_shared<HwcToChwOp>());
+    if (to_fp16) {
+      ops.push_back(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16)));
+    }
+    return ops;
+  }
+
+  static std::shared_ptr<FusedPixelOp> Fuse(const std::vector<std::shared_ptr<TensorOp>> &ops) {
+    auto fused = std::make_shared<FusedPixelOp>();
+    for (auto &op : ops) {
+      EXPECT_TRUE(fused->Append(op));
+    }
+    EXPECT_TRUE(fused->Worthwhile());
+    return fused;
+  }
+
+  static Status RunUnfused(const std::vector<std::shared_ptr<TensorOp>> &ops, const std::shared_ptr<Tensor> &input,
+                           std::shared_ptr<Tensor> *output) {
+    std::shared_ptr<Tensor> in = input;
+    for (auto &op : ops) {
+      std::shared_ptr<Tensor> out;
+      RETURN_IF_NOT_OK(op->Compute(in, &out));
+      in = out;
+    }
+    *output = in;
+    return Status::OK();
+  }
+
+  template <typename T>
+  static void ExpectNear(const std::shared_ptr<Tensor> &expect, const std::shared_ptr<Tensor> &actual, float err) {
+    ASSERT_EQ(expect->shape(), actual->shape());
+    ASSERT_EQ(expect->type(), actual->type());
+    auto expect_itr = expect->begin<T>();
+    auto actual_itr = actual->begin<T>();
+    for (; expect_itr != expect->end<T>(); ++expect_itr, ++actual_itr) {
+      float e = static_cast<float>(*expect_itr);
+      float a = static_cast<float>(*actual_itr);
+      ASSERT_LE(std::fabs(e - a), err * (1.0f + std::fabs(e)));
+    }
+  }
+
+  std::shared_ptr<Tensor> RandomImage(int64_t height, int64_t width) {
+    std::shared_ptr<Tensor> image;
+    EXPECT_OK(Tensor::CreateEmpty(TensorShape({height, width, 3}), DataType(DataType::DE_UINT8), &image));
+    uint32_t state = 12345;
+    for (auto itr = image->begin<uint8_t>(); itr != image->end<uint8_t>(); ++itr) {
+      state = state * 1664525 + 1013904223;
+      *itr = static_cast<uint8_t>(state >> 24);
+    }
+    return image;
+  }
+};
+
+TEST_F(MindDataTestFusedPixelOp, TestRescaleNormalizeHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestRescaleNormalizeHwcToChw.";
+  std::vector<std::shared_ptr<TensorOp>> ops;
+  ops.push_back(std::make_shared<RescaleOp>(1.0 / 255, 0.0));
+  ops.push_back(std::make_shared<NormalizeOp>(0.485, 0.456, 0.406, 0.229, 0.224, 0.225));
+  ops.push_back(std::make_shared<HwcToChwOp>());
+  ops.push_back(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT32)));
+  std::shared_ptr<Tensor> expect;
+  ASSERT_OK(RunUnfused(ops, input_tensor_, &expect));
+  auto fused = Fuse(ops);
+  EXPECT_EQ(fused->NumOps(), 4);
+  EXPECT_TRUE(fused->Deterministic());
+  std::shared_ptr<Tensor> actual;
+  ASSERT_OK(fused->Compute(input_tensor_, &actual));
+  ExpectNear<float>(expect, actual, 1e-5);
+}
+
+TEST_F(MindDataTestFusedPixelOp, TestFlips) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestFlips.";
+  // With probability 1 the flips are known, both the layouts with and without HwcToChw are checked
+  for (bool to_chw : {false, true}) {
+    std::vector<std::shared_ptr<TensorOp>> ops;
+    ops.push_back(std::make_shared<RandomVerticalFlipOp>(1.0));
+    ops.push_back(std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0));
+    ops.push_back(std::make_shared<RandomHorizontalFlipOp>(1.0));
+    if (to_chw) {
+      ops.push_back(std::make_shared<HwcToChwOp>());
+    }
+    std::shared_ptr<Tensor> expect;
+    ASSERT_OK(RunUnfused(ops, input_tensor_, &expect));
+    auto fused = Fuse(ops);
+    EXPECT_FALSE(fused->Deterministic());
+    std::shared_ptr<Tensor> actual;
+    ASSERT_OK(fused->Compute(input_tensor_, &actual));
+    ExpectNear<float>(expect, actual, 1e-5);
+  }
+}
+
+TEST_F(MindDataTestFusedPixelOp, TestToFloat16) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestToFloat16.";
+  std::vector<std::shared_ptr<TensorOp>> ops;
+  ops.push_back(std::make_shared<RescaleOp>(1.0 / 255, -0.5));
+  ops.push_back(std::make_shared<HwcToChwOp>());
+  ops.push_back(std::make_shared<ToFloat16Op>());
+  std::shared_ptr<Tensor> expect;
+  ASSERT_OK(RunUnfused(ops, input_tensor_, &expect));
+  std::shared_ptr<Tensor> actual;
+  ASSERT_OK(Fuse(ops)->Compute(input_tensor_, &actual));
+  ExpectNear<float16>(expect, actual, 1e-3);
+
+  // Values outside of the float16 range fail like they do in ToFloat16Op
+  ops[0] = std::make_shared<RescaleOp>(1000.0, 0.0);
+  EXPECT_TRUE(Fuse(ops)->Compute(input_tensor_, &actual).IsError());
+}
+
+TEST_F(MindDataTestFusedPixelOp, TestFallback) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestFallback.";
+  // A <H,W> image is not handled by the single pass, the original ops run instead
+  std::vector<std::shared_ptr<TensorOp>> ops;
+  ops.push_back(std::make_shared<RescaleOp>(0.5, 1.0));
+  ops.push_back(std::make_shared<HwcToChwOp>());
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>{1, 2, 3, 4, 5, 6}, TensorShape({2, 3}), &input));
+  std::shared_ptr<Tensor> expect;
+  ASSERT_OK(RunUnfused(ops, input, &expect));
+  std::shared_ptr<Tensor> actual;
+  ASSERT_OK(Fuse(ops)->Compute(input, &actual));
+  ExpectNear<float>(expect, actual, 0);
+}
+
+TEST_F(MindDataTestFusedPixelOp, TestAppend) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedPixelOp-TestAppend.";
+  FusedPixelOp fused;
+  // A cast needs float values to cast
+  EXPECT_FALSE(fused.Append(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT32))));
+  EXPECT_TRUE(fused.Append(std::make_shared<HwcToChwOp>()));
+  EXPECT_FALSE(fused.Worthwhile());
+  // Normalize works on <H,W,C> images only
+  EXPECT_FALSE(fused.Append(std::make_shared<NormalizeOp>(1.0, 1.0, 1.0, 1.0, 1.0, 1.0)));
+  EXPECT_FALSE(fused.Append(std::make_shared<HwcToChwOp>()));
+  EXPECT_EQ(fused.NumOps(), 1);
+
+  FusedPixelOp to_fp16;
+  EXPECT_TRUE(to_fp16.Append(std::make_shared<RescaleOp>(1.0, 0.0)));
+  EXPECT_TRUE(to_fp16.Append(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16))));
+  EXPECT_FALSE(to_fp16.Append(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT32))));
+  EXPECT_FALSE(to_fp16.Append(std::make_shared<ToFloat16Op>()));
+  EXPECT_FALSE(to_fp16.Append(std::make_shared<TypeCastOp>(DataType(DataType::DE_INT32))));
+  std::vector<DataType> types;
+  EXPECT_OK(to_fp16.OutputType({DataType(DataType::DE_UINT8)}, types));
+  EXPECT_EQ(types[0], DataType(DataType::DE_FLOAT16));
+}
+
@@ -14,16 +14,25 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
 #include <string>
+#include <tuple>
 #include <memory>
 #include <unordered_set>
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
+#include "minddata/dataset/engine/gnn/local_edge.h"
+#include "minddata/dataset/engine/gnn/local_node.h"
 
 using namespace mindspore::dataset;
 using namespace mindspore::dataset::gnn;
@@ -266,3 +275,166 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestGraphCsr) {
+  // Nodes 10 to 13 of type 1 and node 20 of type 2. Feature 1 is known for 10 and 11, edge feature 5 weighs the edges
+  std::unordered_map<NodeIdType, std::shared_ptr<Node>> nodes;
+  for (NodeIdType id : {13, 10, 12, 11}) {
+    nodes[id] = std::make_shared<LocalNode>(id, 1);
+  }
+  nodes[20] = std::make_shared<LocalNode>(20, 2);
+  auto feature = [](FeatureType type, const std::vector<int32_t> &value) {
+    std::shared_ptr<Tensor> tensor;
+    EXPECT_OK(Tensor::CreateFromVector(value, &tensor));
+    return std::make_shared<Feature>(type, tensor);
+  };
+  ASSERT_OK(nodes[10]->UpdateFeature(feature(1, {1, 2})));
+  ASSERT_OK(nodes[11]->UpdateFeature(feature(1, {3, 4})));
+  std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_features = {{1, feature(1, {0, 0})}};
+  std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> edges;
+  std::vector<std::tuple<NodeIdType, NodeIdType, int32_t>> links = {{10, 13, 1}, {10, 11, 2}, {10, 12, 7},
+                                                                    {10, 20, 1}, {11, 10, 1}, {12, 11, 3}};
+  for (const auto &link : links) {
+    EdgeIdType id = static_cast<EdgeIdType>(edges.size());
+    edges[id] = std::make_shared<LocalEdge>(id, 0, nodes[std::get<0>(link)], nodes[std::get<1>(link)]);
+    ASSERT_OK(edges[id]->UpdateFeature(feature(5, {std::get<2>(link)})));
+  }
+
+  GraphCsr csr;
+  ASSERT_OK(csr.Build(nodes, edges, default_features, 5));
+  EXPECT_EQ(csr.num_nodes(), 5);
+  EXPECT_TRUE(csr.weighted());
+  int32_t index = 0;
+  EXPECT_TRUE(csr.GetIndex(14, &index).IsError());
+  ASSERT_OK(csr.GetIndex(10, &index));
+  // Neighbors are sorted and split by their type
+  int64_t num = 0;
+  const int32_t *neighbors = csr.GetNeighbors(index, 1, &num);
+  ASSERT_EQ(num, 3);
+  EXPECT_EQ(csr.GetId(neighbors[0]), 11);
+  EXPECT_EQ(csr.GetId(neighbors[1]), 12);
+  EXPECT_EQ(csr.GetId(neighbors[2]), 13);
+  EXPECT_EQ(csr.GetWeights(index, 1)[1], 7.0);
+  neighbors = csr.GetNeighbors(index, 2, &num);
+  ASSERT_EQ(num, 1);
+  EXPECT_EQ(csr.GetId(neighbors[0]), 20);
+
+  // Weighted sampling follows the weights 2, 7 and 1
+  std::mt19937 rnd(1);
+  std::vector<int32_t> scratch;
+  std::vector<NodeIdType> samples(10000);
+  csr.SampleNeighbors(index, 1, static_cast<int32_t>(samples.size()), &rnd, &scratch, samples.data());
+  std::map<NodeIdType, int32_t> counts;
+  for (auto id : samples) {
+    counts[id]++;
+  }
+  EXPECT_NEAR(counts[11], 2000, 300);
+  EXPECT_NEAR(counts[12], 7000, 300);
+  EXPECT_NEAR(counts[13], 1000, 300);
+
+  // Unweighted sampling draws every neighbor once before any is drawn again
+  GraphCsr unweighted;
+  ASSERT_OK(unweighted.Build(nodes, edges, default_features));
+  EXPECT_EQ(unweighted.GetWeights(index, 1), nullptr);
+  unweighted.SampleNeighbors(index, 1, 6, &rnd, &scratch, samples.data());
+  counts.clear();
+  for (int32_t i = 0; i < 6; ++i) {
+    counts[samples[i]]++;
+  }
+  EXPECT_EQ(counts, (std::map<NodeIdType, int32_t>{{11, 2}, {12, 2}, {13, 2}}));
+  ASSERT_OK(csr.GetIndex(13, &index));
+  unweighted.SampleNeighbors(index, 1, 2, &rnd, &scratch, samples.data());
+  EXPECT_EQ(samples[0], kDefaultNodeId);
+
+  // Features are kept in a column
+  DataType type;
+  TensorShape shape = TensorShape::CreateUnknownRankShape();
+  EXPECT_TRUE(csr.HasFeature(1, &type, &shape));
+  EXPECT_EQ(type, DataType(DataType::DE_INT32));
+  EXPECT_EQ(shape, TensorShape({2}));
+  EXPECT_EQ(csr.GetFeature(1, index, &num), nullptr);
+  ASSERT_OK(csr.GetIndex(11, &index));
+  const int32_t *value = reinterpret_cast<const int32_t *>(csr.GetFeature(1, index, &num));
+  ASSERT_EQ(num, 8);
+  EXPECT_EQ(value[1], 4);
+}
+
+TEST_F(MindDataTestGNNGraph, TestParallelSampling) {
+  // A synthetic graph of 2000 nodes with 10 random neighbors each, enough nodes for several chunks
+  const NodeIdType kNumNodes = 2000;
+  const int32_t kDegree = 10;
+  std::vector<std::shared_ptr<Node>> nodes;
+  nodes.reserve(kNumNodes);
+  for (NodeIdType id = 0; id < kNumNodes; ++id) {
+    nodes.push_back(std::make_shared<LocalNode>(id, 1));
+  }
+  std::vector<std::shared_ptr<Edge>> edges;
+  edges.reserve(kNumNodes * kDegree);
+  std::mt19937 rnd(1);
+  std::uniform_int_distribution<NodeIdType> distribution(0, kNumNodes - 1);
+  for (NodeIdType src = 0; src < kNumNodes; ++src) {
+    for (int32_t i = 0; i < kDegree; ++i) {
+      EdgeIdType id = static_cast<EdgeIdType>(edges.size());
+      edges.push_back(std::make_shared<LocalEdge>(id, 0, nodes[src], nodes[distribution(rnd)]));
+    }
+  }
+  std::vector<NodeIdType> node_list(kNumNodes);
+  std::iota(node_list.begin(), node_list.end(), 0);
+
+  // A seed gives the same results on any number of workers
+  auto config = GlobalContext::config_manager();
+  uint32_t original_seed = config->seed();
+  config->set_seed(5);
+  GraphDataImpl serial("", 1);
+  GraphDataImpl parallel("", 8);
+  config->set_seed(original_seed);
+  ASSERT_OK(serial.InitFromMemory(nodes, edges));
+  ASSERT_OK(parallel.InitFromMemory(nodes, edges));
+
+  std::vector<NodeType> meta_path(10, 1);
+  std::vector<std::function<Status(GraphDataImpl *, std::shared_ptr<Tensor> *)>> queries = {
+    [&node_list](GraphDataImpl *graph, std::shared_ptr<Tensor> *out) {
+      return graph->GetSampledNeighbors(node_list, {10, 5}, {1, 1}, out);
+    },
+    [&node_list](GraphDataImpl *graph, std::shared_ptr<Tensor> *out) {
+      return graph->GetNegSampledNeighbors(node_list, 5, 1, out);
+    },
+    [&node_list, &meta_path](GraphDataImpl *graph, std::shared_ptr<Tensor> *out) {
+      return graph->RandomWalk(node_list, meta_path, 2.0, 0.5, -1, out);
+    }};
+  std::vector<std::shared_ptr<Tensor>> results;
+  for (const auto &query : queries) {
+    std::shared_ptr<Tensor> expect;
+    std::shared_ptr<Tensor> actual;
+    ASSERT_OK(query(&serial, &expect));
+    ASSERT_OK(query(&parallel, &actual));
+    EXPECT_TRUE(*expect == *actual);
+    results.push_back(actual);
+  }
+
+  // Rows start with the node, the samples of the first hop and the walks follow edges, the negative samples do not
+  std::shared_ptr<Tensor> neighbors;
+  ASSERT_OK(parallel.GetAllNeighbors({7}, 1, &neighbors));
+  std::unordered_set<NodeIdType> neighbor_set(neighbors->begin<NodeIdType>(), neighbors->end<NodeIdType>());
+  EXPECT_EQ(results[0]->shape(), TensorShape({kNumNodes, 61}));
+  EXPECT_EQ(results[1]->shape(), TensorShape({kNumNodes, 6}));
+  EXPECT_EQ(results[2]->shape(), TensorShape({kNumNodes, 11}));
+  for (const auto &result : results) {
+    NodeIdType value = 0;
+    ASSERT_OK(result->GetItemAt(&value, {7, 0}));
+    EXPECT_EQ(value, 7);
+  }
+  for (dsize_t i = 1; i <= 10; ++i) {
+    NodeIdType value = 0;
+    ASSERT_OK(results[0]->GetItemAt(&value, {7, i}));
+    EXPECT_EQ(neighbor_set.count(value), 1);
+  }
+  for (dsize_t i = 1; i <= 5; ++i) {
+    NodeIdType value = 0;
+    ASSERT_OK(results[1]->GetItemAt(&value, {7, i}));
+    EXPECT_EQ(neighbor_set.count(value), 0);
+  }
+  NodeIdType step = 0;
+  ASSERT_OK(results[2]->GetItemAt(&step, {7, 1}));
+  EXPECT_EQ(neighbor_set.count(step), 1);
+}
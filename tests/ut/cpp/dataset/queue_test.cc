@@ -17,10 +17,13 @@
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/util/task_manager.h"
+#include "minddata/dataset/util/lock_free_queue.h"
 #include "minddata/dataset/util/queue.h"
 #include <atomic>
 #include <chrono>
 #include <random>
+#include <thread>
+#include <vector>
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -177,3 +180,165 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, TestLockFreeQueue1) {
+  // Same as Test1 but through the lock free queue, using a Queue pointer.
+  std::unique_ptr<Queue<std::shared_ptr<int>>> que = std::make_unique<LockFreeQueue<std::shared_ptr<int>>>(3);
+  std::shared_ptr<int> a = std::make_shared<int>(20);
+  Status rc = que->Add(a);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(a.use_count(), 2);
+  ASSERT_EQ(que->size(), 1);
+  std::shared_ptr<int> b;
+  rc = que->PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 20);
+  ASSERT_EQ(a.use_count(), 2);
+  ASSERT_TRUE(que->empty());
+  rc = que->Add(std::move(a));
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(a, nullptr);
+  // Reset drops the element that is still in the queue.
+  que->Reset();
+  ASSERT_TRUE(que->empty());
+  ASSERT_EQ(b.use_count(), 1);
+}
+
+TEST_F(MindDataTestQueue, TestLockFreeQueue2) {
+  LockFreeQueue<std::unique_ptr<int>> que(2);
+  Status rc = que.EmplaceBack(new int(40));
+  ASSERT_TRUE(rc.IsOk());
+  std::unique_ptr<int> b;
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 40);
+  // Wrap around the ring a few times.
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(que.Add(std::make_unique<int>(i)).IsOk());
+    ASSERT_TRUE(que.Add(std::make_unique<int>(i + 100)).IsOk());
+    ASSERT_EQ(que.size(), que.capacity());
+    ASSERT_TRUE(que.PopFront(&b).IsOk());
+    ASSERT_EQ(*b, i);
+    ASSERT_TRUE(que.PopFront(&b).IsOk());
+    ASSERT_EQ(*b, i + 100);
+  }
+}
+
+TEST_F(MindDataTestQueue, TestLockFreeQueue3) {
+  // Several producers and consumers on a small queue, so both sides spin and park. Every element has to come out
+  // exactly once, and the elements of each producer have to come out in the order they were added.
+  const int num_producers = 4;
+  const int num_consumers = 3;
+  const int num_per_producer = 20000;
+  LockFreeQueue<int64_t> que(4);
+  TaskGroup producers;
+  TaskGroup consumers;
+  std::vector<std::vector<int64_t>> popped(num_consumers);
+  for (int p = 0; p < num_producers; ++p) {
+    ASSERT_OK(producers.CreateAsyncTask("Producer", [&que, p]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t i = 0; i < num_per_producer; ++i) {
+        RETURN_IF_NOT_OK(que.Add(p * num_per_producer + i));
+      }
+      return Status::OK();
+    }));
+  }
+  for (int c = 0; c < num_consumers; ++c) {
+    ASSERT_OK(consumers.CreateAsyncTask("Consumer", [&que, &popped, c]() -> Status {
+      TaskManager::FindMe()->Post();
+      // Consumers stop on the -1 sentinels added after all producers finish.
+      while (true) {
+        int64_t v;
+        RETURN_IF_NOT_OK(que.PopFront(&v));
+        if (v < 0) {
+          break;
+        }
+        popped[c].push_back(v);
+      }
+      return Status::OK();
+    }));
+  }
+  ASSERT_OK(producers.join_all());
+  for (int c = 0; c < num_consumers; ++c) {
+    ASSERT_OK(que.Add(-1));
+  }
+  ASSERT_OK(consumers.join_all());
+  std::vector<int> seen(num_producers * num_per_producer, 0);
+  for (auto &values : popped) {
+    std::vector<int64_t> last(num_producers, -1);
+    for (auto v : values) {
+      seen[v]++;
+      ASSERT_GT(v, last[v / num_per_producer]);
+      last[v / num_per_producer] = v;
+    }
+  }
+  for (auto count : seen) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+TEST_F(MindDataTestQueue, TestLockFreeQueue4) {
+  // A consumer parked on an empty lock free queue is woken up by an interrupt.
+  TaskGroup vg;
+  LockFreeQueue<int> que(3);
+  ASSERT_TRUE(que.Register(&vg).IsOk());
+  vg.CreateAsyncTask("LockFreePop", [&que]() -> Status {
+    TaskManager::FindMe()->Post();
+    int v;
+    Status rc = que.PopFront(&v);
+    EXPECT_TRUE(rc.IsInterrupted());
+    return rc;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  vg.GetIntrpService()->InterruptAll();
+  vg.join_all(Task::WaitFlag::kNonBlocking);
+}
+
+TEST_F(MindDataTestQueue, TestLockFreeQueue5) {
+  // A producer blocks on a full queue until a consumer makes room, and the elements come out in the order they
+  // were added.
+  TaskGroup vg;
+  LockFreeQueue<int> que(2);
+  ASSERT_OK(que.Add(0));
+  ASSERT_OK(que.Add(1));
+  std::atomic<int> num_added(2);
+  ASSERT_OK(vg.CreateAsyncTask("LockFreeAdd", [&que, &num_added]() -> Status {
+    TaskManager::FindMe()->Post();
+    for (int i = 2; i < 6; ++i) {
+      RETURN_IF_NOT_OK(que.Add(i));
+      num_added++;
+    }
+    return Status::OK();
+  }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(num_added, 2);
+  ASSERT_EQ(que.size(), que.capacity());
+  for (int i = 0; i < 6; ++i) {
+    int v;
+    ASSERT_OK(que.PopFront(&v));
+    ASSERT_EQ(v, i);
+  }
+  ASSERT_OK(vg.join_all());
+  ASSERT_EQ(num_added, 6);
+  ASSERT_TRUE(que.empty());
+}
+
+TEST_F(MindDataTestQueue, TestLockFreeQueue6) {
+  // A consumer blocks on an empty queue until a producer adds an element.
+  TaskGroup vg;
+  LockFreeQueue<int> que(2);
+  std::atomic<int> popped(-1);
+  ASSERT_OK(vg.CreateAsyncTask("LockFreePop", [&que, &popped]() -> Status {
+    TaskManager::FindMe()->Post();
+    int v;
+    RETURN_IF_NOT_OK(que.PopFront(&v));
+    popped = v;
+    return Status::OK();
+  }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(popped, -1);
+  ASSERT_OK(que.Add(7));
+  ASSERT_OK(vg.join_all());
+  ASSERT_EQ(popped, 7);
+  ASSERT_TRUE(que.empty());
+}
@@ -17,8 +17,10 @@
 #include "common/common.h"
 #include "common/cvop_common.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
 #include "minddata/dataset/core/config_manager.h"
 #include "utils/log_adapter.h"
 
@@ -154,3 +156,49 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "RandomCropDecodeResizeOp test 2 finished";
 }
+
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestScaledDecode) {
+  MS_LOG(INFO) << "starting RandomCropDecodeResizeOp test 3";
+  EXPECT_EQ(JpegScaleNum(4032, 2268, 224, 224), 1);
+  EXPECT_EQ(JpegScaleNum(4032, 2268, 718, 884), 4);
+  EXPECT_EQ(JpegScaleNum(1000, 800, 500, 400), 4);
+  EXPECT_EQ(JpegScaleNum(1000, 800, 501, 400), 8);
+
+  // The image is 4032x2268, decoding at 1/4 gives 1008x567
+  std::shared_ptr<Tensor> scaled;
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &scaled, 0, 0, 0, 0, 2));
+  EXPECT_EQ(scaled->shape(), TensorShape({567, 1008, 3}));
+  // A crop window in full size pixels covers the scaled pixels it touches
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &scaled, 101, 43, 800, 401, 2));
+  EXPECT_EQ(scaled->shape(), TensorShape({101, 201, 3}));
+  EXPECT_TRUE(JpegCropAndDecode(raw_input_tensor_, &scaled, 3500, 0, 600, 100, 2).IsError());
+
+  // Decode and resize at once stays close to decoding at full size and resizing
+  constexpr int target_height = 300;
+  constexpr int target_width = 500;
+  ResizeOp resize(target_height, target_width);
+  DecodeResizeOp decode_resize(resize);
+  std::shared_ptr<Tensor> decode_resize_output;
+  std::shared_ptr<Tensor> resize_output;
+  ASSERT_OK(decode_resize.Compute(raw_input_tensor_, &decode_resize_output));
+  ASSERT_OK(resize.Compute(input_tensor_, &resize_output));
+  ASSERT_EQ(decode_resize_output->shape(), resize_output->shape());
+  cv::Mat output1 = CVTensor::AsCVTensor(decode_resize_output)->mat();
+  cv::Mat output2 = CVTensor::AsCVTensor(resize_output)->mat();
+  long int mse_sum = 0;
+  long int count = 0;
+  for (int i = 0; i < target_height; i++) {
+    for (int j = 0; j < target_width; j++) {
+      int a = static_cast<int>(output1.at<cv::Vec3b>(i, j)[1]);
+      int b = static_cast<int>(output2.at<cv::Vec3b>(i, j)[1]);
+      mse_sum += std::abs(a - b);
+      if (a != b) {
+        count++;
+      }
+    }
+  }
+  double mse = count > 0 ? static_cast<double>(mse_sum) / count : mse_sum;
+  MS_LOG(INFO) << "mse: " << mse << std::endl;
+  EXPECT_LT(mse, kMseThreshold);
+  MS_LOG(INFO) << "RandomCropDecodeResizeOp test 3 finished";
+}
@@ -21,6 +21,12 @@
 #include "gtest/gtest.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 
@@ -102,4 +108,40 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResize_fusion_enabled) {
   auto func_it = tfuncs.begin();
   EXPECT_EQ((*func_it)->Name(), kRandomCropDecodeResizeOp);
   EXPECT_EQ(++func_it, tfuncs.end());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, DecodeResize_FusedPixelOp_fusion_enabled) {
+  MS_LOG(INFO) << "Doing DecodeResize_FusedPixelOp_fusion";
+  std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                             bool shuf = false, std::shared_ptr<SamplerRT> sampler = nullptr,
+                                             std::map<std::string, int32_t> map = {}, bool decode = false);
+  std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+  Status rc;
+  // Decode and Resize fuse into a scaled decode, the run of per pixel ops after them into FusedPixelOp
+  std::vector<std::shared_ptr<TensorOp>> func_list;
+  func_list.push_back(std::make_shared<DecodeOp>());
+  func_list.push_back(std::make_shared<ResizeOp>(32, 32));
+  func_list.push_back(std::make_shared<RandomHorizontalFlipOp>());
+  func_list.push_back(std::make_shared<RescaleOp>(1.0 / 255, 0.0));
+  func_list.push_back(std::make_shared<NormalizeOp>(0.485, 0.456, 0.406, 0.229, 0.224, 0.225));
+  func_list.push_back(std::make_shared<HwcToChwOp>());
+  func_list.push_back(std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16)));
+  std::shared_ptr<MapOp> map_op;
+  MapOp::Builder map_builder;
+  map_builder.SetInColNames({}).SetOutColNames({}).SetTensorFuncs(func_list).SetNumWorkers(4);
+  rc = map_builder.Build(&map_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto tree = Build({ImageFolder(16, 2, 32, "./", false), map_op});
+  rc = tree->SetOptimize(true);
+  EXPECT_TRUE(rc);
+  rc = tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  auto it = tree->begin();
+  ++it;
+  auto *m_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(m_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 2);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeResizeOp);
+  EXPECT_EQ(tfuncs[1]->Name(), kFusedPixelOp);
+  EXPECT_FALSE(tfuncs[1]->Deterministic());
+}
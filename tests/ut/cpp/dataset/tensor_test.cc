@@ -15,6 +15,7 @@
  */
 #include <memory>
 #include <string>
+#include <vector>
 #include "minddata/dataset/core/client.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -536,3 +537,40 @@ TEST_F(MindDataTestTensorDE, TensorEmpty) {
   t2->Invalidate();
   ASSERT_TRUE(!t2->HasData());
 }
+
+TEST_F(MindDataTestTensorDE, TensorBorrowedMemory) {
+  auto owner = std::make_shared<std::vector<int32_t>>(std::vector<int32_t>{1, 2, 3, 4, 5, 6});
+  std::weak_ptr<std::vector<int32_t>> weak_owner = owner;
+  TensorPtr t;
+  Status rc = Tensor::CreateFromBorrowedMemory(TensorShape({2, 3}), DataType(DataType::DE_INT32),
+                                               reinterpret_cast<uchar *>(owner->data()), owner, &t);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(t->GetBuffer(), reinterpret_cast<uchar *>(owner->data()));
+  ASSERT_EQ(t->SizeInBytes(), 6 * sizeof(int32_t));
+  int32_t value = 0;
+  ASSERT_TRUE(t->GetItemAt<int32_t>(&value, {1, 2}).IsOk());
+  ASSERT_EQ(value, 6);
+
+  ASSERT_TRUE(t->IsBorrowed());
+
+  // A copy owns its data, writing to it leaves the borrowed memory untouched
+  TensorPtr copied;
+  ASSERT_TRUE(Tensor::CreateFromTensor(t, &copied).IsOk());
+  ASSERT_FALSE(copied->IsBorrowed());
+  ASSERT_TRUE(copied->SetItemAt<int32_t>({0, 0}, 7).IsOk());
+  ASSERT_EQ((*owner)[0], 1);
+
+  // The tensor keeps the memory alive and does not free it itself
+  owner.reset();
+  ASSERT_FALSE(weak_owner.expired());
+  t.reset();
+  ASSERT_TRUE(weak_owner.expired());
+
+  auto bytes = std::make_shared<std::vector<uint8_t>>(16);
+  rc = Tensor::CreateFromBorrowedMemory(TensorShape({2}), DataType(DataType::DE_INT32), bytes->data() + 1, bytes, &t);
+  ASSERT_TRUE(rc.IsError());
+  rc = Tensor::CreateFromBorrowedMemory(TensorShape({2}), DataType(DataType::DE_STRING), bytes->data(), bytes, &t);
+  ASSERT_TRUE(rc.IsError());
+  rc = Tensor::CreateFromBorrowedMemory(TensorShape({2}), DataType(DataType::DE_INT32), bytes->data(), nullptr, &t);
+  ASSERT_TRUE(rc.IsError());
+}
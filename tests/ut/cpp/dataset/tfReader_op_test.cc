@@ -13,7 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <sys/stat.h>
+#include <utime.h>
+#include <zlib.h>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -23,6 +28,7 @@
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "utils/system/crc32c.h"
 
 namespace common = mindspore::common;
 
@@ -35,6 +41,31 @@ class MindDataTestTFReaderOp : public UT::DatasetOpTesting {
 
 };
 
+namespace {
+// Writes data to a file compressed with gzip or zlib
+void WriteCompressed(const std::string &data, const std::string &filename, TFRecordCompression compression) {
+  if (compression == TFRecordCompression::kGzip) {
+    gzFile gz_file = gzopen(filename.c_str(), "wb");
+    ASSERT_NE(gz_file, nullptr);
+    ASSERT_EQ(gzwrite(gz_file, data.data(), data.size()), data.size());
+    ASSERT_EQ(gzclose(gz_file), Z_OK);
+    return;
+  }
+  uLongf size = compressBound(data.size());
+  std::vector<Bytef> compressed(size);
+  ASSERT_EQ(compress2(compressed.data(), &size, reinterpret_cast<const Bytef *>(data.data()), data.size(),
+                      Z_DEFAULT_COMPRESSION),
+            Z_OK);
+  std::ofstream out(filename, std::ios::binary);
+  out.write(reinterpret_cast<const char *>(compressed.data()), size);
+}
+
+std::string ReadFile(const std::string &filename) {
+  std::ifstream in(filename, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
 TEST_F(MindDataTestTFReaderOp, TestTFReaderBasic1) {
   // Start with an empty execution tree
   auto my_tree = std::make_shared<ExecutionTree>();
@@ -731,3 +762,257 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderInvalidFiles) {
   rc = builder.Build(&my_tfreader_op);
   ASSERT_TRUE(!rc.IsOk());
 }
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordIndexSeek) {
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+
+  std::shared_ptr<const TFRecordIndex> index;
+  Status rc = TFRecordIndex::Get(dataset_path, TFRecordCompression::kAuto, &index);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(index->NumRows(), 12);
+
+  TFRecordReader reader;
+  rc = reader.Open(dataset_path, TFRecordCompression::kNone);
+  ASSERT_TRUE(rc.IsOk());
+  std::vector<std::string> records;
+  std::string record;
+  bool eof = false;
+  while (true) {
+    ASSERT_EQ(reader.Tell(), index->RowOffset(records.size()));
+    rc = reader.ReadRecord(&record, true, &eof);
+    ASSERT_TRUE(rc.IsOk());
+    if (eof) {
+      break;
+    }
+    records.push_back(record);
+  }
+  ASSERT_EQ(records.size(), 12);
+
+  // Seek backwards and forwards to single rows
+  for (int64_t row : {7, 2, 11, 0}) {
+    rc = reader.Seek(index->RowOffset(row));
+    ASSERT_TRUE(rc.IsOk());
+    rc = reader.ReadRecord(&record, true, &eof);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(record, records[row]);
+  }
+
+  int64_t num_rows = 0;
+  rc = TFReaderOp::CountTotalRows(&num_rows, {dataset_path, dataset_path}, 2);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(num_rows, 24);
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFReaderShardEqualRowsVerifyCrc) {
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+
+  // Shards of equal rows seek to the first row of their range, the two shards have to read every row once
+  int row_count = 0;
+  for (int32_t device_id = 0; device_id < 2; device_id++) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TFReaderOp> my_tfreader_op;
+    TFReaderOp::Builder builder;
+    builder.SetDatasetFilesList({dataset_path})
+      .SetRowsPerBuffer(16)
+      .SetNumWorkers(1)
+      .SetNumDevices(2)
+      .SetDeviceId(device_id)
+      .SetShardEqualRows(true)
+      .SetVerifyCrc(true);
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {});
+    builder.SetDataSchema(std::move(schema));
+    Status rc = builder.Build(&my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+
+    rc = my_tree->AssociateNode(my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->AssignRoot(my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->Prepare();
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->Launch();
+    ASSERT_TRUE(rc.IsOk());
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    int shard_rows = 0;
+    while (!tensor_list.empty()) {
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+      shard_rows++;
+    }
+    ASSERT_EQ(shard_rows, 6);
+    row_count += shard_rows;
+  }
+
+  ASSERT_EQ(row_count, 12);
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFReaderCompressed) {
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  std::string data = ReadFile(dataset_path);
+  std::shared_ptr<const TFRecordIndex> plain_index;
+  Status rc = TFRecordIndex::Get(dataset_path, TFRecordCompression::kNone, &plain_index);
+  ASSERT_TRUE(rc.IsOk());
+
+  for (auto compression : {TFRecordCompression::kGzip, TFRecordCompression::kZlib}) {
+    std::string file = compression == TFRecordCompression::kGzip ? "/tmp/tfReaderCompressedTest.gz"
+                                                                   : "/tmp/tfReaderCompressedTest.zlib";
+    WriteCompressed(data, file, compression);
+
+    // Offsets are positions in the uncompressed stream, the same as in the plain file
+    std::shared_ptr<const TFRecordIndex> index;
+    rc = TFRecordIndex::Get(file, TFRecordCompression::kAuto, &index);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(index->NumRows(), 12);
+    for (int64_t row = 0; row <= 12; row++) {
+      ASSERT_EQ(index->RowOffset(row), plain_index->RowOffset(row));
+    }
+
+    TFRecordReader plain_reader;
+    ASSERT_TRUE(plain_reader.Open(dataset_path, TFRecordCompression::kNone).IsOk());
+    TFRecordReader reader;
+    ASSERT_TRUE(reader.Open(file, TFRecordCompression::kAuto).IsOk());
+    std::string record;
+    std::string expected;
+    bool eof = false;
+    for (int64_t row : {7, 2, 11, 0}) {
+      ASSERT_TRUE(plain_reader.Seek(index->RowOffset(row)).IsOk());
+      ASSERT_TRUE(plain_reader.ReadRecord(&expected, true, &eof).IsOk());
+      ASSERT_TRUE(reader.Seek(index->RowOffset(row)).IsOk());
+      ASSERT_TRUE(reader.ReadRecord(&record, true, &eof).IsOk());
+      ASSERT_EQ(record, expected);
+    }
+
+    // The op reads every row of the compressed file
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TFReaderOp> my_tfreader_op;
+    TFReaderOp::Builder builder;
+    builder.SetDatasetFilesList({file})
+      .SetRowsPerBuffer(16)
+      .SetNumWorkers(1)
+      .SetCompressionType(compression)
+      .SetVerifyCrc(true);
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {});
+    builder.SetDataSchema(std::move(schema));
+    rc = builder.Build(&my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->AssociateNode(my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->AssignRoot(my_tfreader_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->Prepare();
+    ASSERT_TRUE(rc.IsOk());
+    rc = my_tree->Launch();
+    ASSERT_TRUE(rc.IsOk());
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    int row_count = 0;
+    while (!tensor_list.empty()) {
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+      row_count++;
+    }
+    ASSERT_EQ(row_count, 12);
+    (void)remove(file.c_str());
+  }
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordCompressionByContent) {
+  // kAuto looks at the first bytes, the names of these files say otherwise
+  std::string data = ReadFile(datasets_root_path_ + "/testTFTestAllTypes/test.data");
+  std::string gzip_file = "/tmp/tfReaderContentGzipTest.data";
+  std::string zlib_file = "/tmp/tfReaderContentZlibTest.data";
+  std::string plain_file = "/tmp/tfReaderContentPlainTest.gz";
+  WriteCompressed(data, gzip_file, TFRecordCompression::kGzip);
+  WriteCompressed(data, zlib_file, TFRecordCompression::kZlib);
+  {
+    std::ofstream out(plain_file, std::ios::binary);
+    out << data;
+  }
+  ASSERT_EQ(TFRecordReader::ResolveCompression(gzip_file, TFRecordCompression::kAuto), TFRecordCompression::kGzip);
+  ASSERT_EQ(TFRecordReader::ResolveCompression(zlib_file, TFRecordCompression::kAuto), TFRecordCompression::kZlib);
+  ASSERT_EQ(TFRecordReader::ResolveCompression(plain_file, TFRecordCompression::kAuto), TFRecordCompression::kNone);
+  // A set compression is taken as it is
+  ASSERT_EQ(TFRecordReader::ResolveCompression(plain_file, TFRecordCompression::kZlib), TFRecordCompression::kZlib);
+  for (const auto &file : {gzip_file, zlib_file, plain_file}) {
+    std::shared_ptr<const TFRecordIndex> index;
+    Status rc = TFRecordIndex::Get(file, TFRecordCompression::kAuto, &index);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(index->NumRows(), 12);
+    (void)remove(file.c_str());
+  }
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordIndexCompressionKey) {
+  // The same file read with another compression gets an index of its own
+  std::string file = "/tmp/tfReaderCompressionKeyTest.data";
+  WriteCompressed(ReadFile(datasets_root_path_ + "/testTFTestAllTypes/test.data"), file, TFRecordCompression::kZlib);
+  std::shared_ptr<const TFRecordIndex> index;
+  Status rc = TFRecordIndex::Get(file, TFRecordCompression::kZlib, &index);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(index->NumRows(), 12);
+  rc = TFRecordIndex::Get(file, TFRecordCompression::kNone, &index);
+  ASSERT_FALSE(rc.IsOk());
+  (void)remove(file.c_str());
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordSidecarCompressed) {
+  // Empty records compress so well that the file has far fewer bytes than rows
+  const int64_t num_rows = 20000;
+  uint64_t length = 0;
+  char header[sizeof(uint64_t) + sizeof(uint32_t)];
+  (void)memcpy(header, &length, sizeof(length));
+  uint32_t length_crc = mindspore::system::Crc32c::GetMaskCrc32cValue(header, sizeof(length));
+  (void)memcpy(header + sizeof(length), &length_crc, sizeof(length_crc));
+  uint32_t data_crc = mindspore::system::Crc32c::GetMaskCrc32cValue(header, 0);
+  std::string record(header, sizeof(header));
+  record.append(reinterpret_cast<const char *>(&data_crc), sizeof(data_crc));
+  std::string data;
+  for (int64_t i = 0; i < num_rows; i++) {
+    data += record;
+  }
+  std::string file = "/tmp/tfReaderSidecarTest.gz";
+  std::string copy = "/tmp/tfReaderSidecarCopyTest.gz";
+  WriteCompressed(data, file, TFRecordCompression::kGzip);
+
+  setenv("MINDDATA_TFRECORD_INDEX", "true", 1);
+  std::shared_ptr<const TFRecordIndex> index;
+  Status rc = TFRecordIndex::Get(file, TFRecordCompression::kAuto, &index);
+  unsetenv("MINDDATA_TFRECORD_INDEX");
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(index->NumRows(), num_rows);
+  struct stat file_stat;
+  ASSERT_EQ(stat(file.c_str(), &file_stat), 0);
+  ASSERT_GT(num_rows, file_stat.st_size);
+
+  // A file of the same size and mtime with the same sidecar can not be indexed, so its index comes from the sidecar
+  {
+    std::ofstream out(copy, std::ios::binary);
+    out << std::string(file_stat.st_size, '\0');
+  }
+  struct utimbuf times = {file_stat.st_atime, file_stat.st_mtime};
+  ASSERT_EQ(utime(copy.c_str(), &times), 0);
+  {
+    std::ofstream out(TFRecordIndex::SidecarPath(copy), std::ios::binary);
+    out << ReadFile(TFRecordIndex::SidecarPath(file));
+  }
+  rc = TFRecordIndex::Get(copy, TFRecordCompression::kGzip, &index);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(index->NumRows(), num_rows);
+  ASSERT_EQ(index->RowOffset(num_rows), static_cast<int64_t>(data.size()));
+
+  // A sidecar of another compression does not apply
+  rc = TFRecordIndex::Get(copy, TFRecordCompression::kZlib, &index);
+  ASSERT_FALSE(rc.IsOk());
+  for (const auto &path : {file, copy, TFRecordIndex::SidecarPath(file), TFRecordIndex::SidecarPath(copy)}) {
+    (void)remove(path.c_str());
+  }
+}
@@ -14,8 +14,12 @@
  * limitations under the License.
  */
 #include <memory>
+#include <random>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "common/common.h"
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
@@ -26,6 +30,8 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
+#include "minddata/dataset/text/vocab.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +364,132 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestVocabLookup) {
+  MS_LOG(INFO) << "Doing TestVocabLookup.";
+  std::unordered_map<WordType, WordIdType> words;
+  for (int32_t i = 0; i < 1000; ++i) {
+    words["word" + std::to_string(i)] = i + 2;
+  }
+  words[""] = 0;
+  std::shared_ptr<Vocab> vocab;
+  ASSERT_OK(Vocab::BuildFromUnorderedMap(words, &vocab));
+  EXPECT_EQ(vocab->size(), 1001);
+  for (const auto &p : words) {
+    EXPECT_EQ(vocab->Lookup(std::string_view(p.first)), p.second);
+  }
+  // A view into a longer string is looked up without copying it
+  std::string text = "word12 word999";
+  EXPECT_EQ(vocab->Lookup(std::string_view(text).substr(7)), 1001);
+  EXPECT_EQ(vocab->Lookup(std::string_view(text).substr(0, 5)), 3);
+  EXPECT_EQ(vocab->Lookup("word1000"), Vocab::kNoTokenExists);
+  EXPECT_EQ(vocab->vocab(), words);
+
+  // Appended words get the next id, words that exist keep theirs
+  Vocab appended;
+  appended.append_word("a");
+  appended.append_word("b");
+  appended.append_word("a");
+  EXPECT_EQ(appended.size(), 2);
+  EXPECT_EQ(appended.Lookup("b"), 1);
+  EXPECT_EQ(appended.word(1), "b");
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  std::vector<std::string> words = {"my",  "favor", "##ite", "book", "is",  "love",  "un",
+                                    "##aff", "##able", "##a", "[UNK]", "汽", "##车", "##车子"};
+  std::shared_ptr<Vocab> vocab;
+  ASSERT_OK(Vocab::BuildFromVector(words, {}, true, &vocab));
+  std::shared_ptr<Tensor> input;
+  std::vector<std::string> text = {"my", "favorite", "book", "I", "unaffable", "汽车子", "汽车"};
+  ASSERT_OK(Tensor::CreateFromVector(text, &input));
+  auto op = std::make_unique<WordpieceTokenizerOp>(vocab, "##", 100, "[UNK]", false);
+  TensorRow output;
+  ASSERT_OK(op->Compute(TensorRow(0, {input}), &output));
+  ASSERT_EQ(output.size(), 1);
+  // The longest word of the vocab is taken, a word that can not be split is unknown
+  std::vector<std::string> expect = {"my", "favor", "##ite", "book", "[UNK]", "un", "##aff", "##able",
+                                     "汽", "##车子", "汽", "##车"};
+  ASSERT_EQ(output[0]->Size(), expect.size());
+  for (dsize_t i = 0; i < static_cast<dsize_t>(expect.size()); ++i) {
+    CheckEqual(output[0], {i}, expect[i]);
+  }
+
+  // Offsets of the sub words in bytes
+  op = std::make_unique<WordpieceTokenizerOp>(vocab, "##", 100, "", true);
+  output.clear();
+  ASSERT_OK(op->Compute(TensorRow(0, {input}), &output));
+  ASSERT_EQ(output.size(), 3);
+  CheckEqual(output[0], {4}, "I");
+  uint32_t offset = 0;
+  ASSERT_OK(output[1]->GetItemAt(&offset, {2}));
+  EXPECT_EQ(offset, 5);
+  ASSERT_OK(output[2]->GetItemAt(&offset, {9}));
+  EXPECT_EQ(offset, 9);
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizerRandomVocab) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizerRandomVocab.";
+  // A vocab of random words and sub words, and words made of them
+  std::mt19937 rnd(1);
+  std::uniform_int_distribution<int32_t> letter('a', 'c');
+  std::uniform_int_distribution<int32_t> length(1, 4);
+  std::vector<std::string> words = {"[UNK]"};
+  std::unordered_set<std::string> seen;
+  while (words.size() < 100) {
+    std::string word = words.size() % 3 == 0 ? "##" : "";
+    for (int32_t i = length(rnd); i > 0; --i) {
+      word += static_cast<char>(letter(rnd));
+    }
+    if (seen.insert(word).second) {
+      words.push_back(word);
+    }
+  }
+  std::shared_ptr<Vocab> vocab;
+  ASSERT_OK(Vocab::BuildFromVector(words, {}, true, &vocab));
+  std::uniform_int_distribution<size_t> pick(1, words.size() - 1);
+  std::vector<std::string> sentence;
+  for (int32_t i = 0; i < 500; ++i) {
+    std::string word;
+    while (word.size() < 8) {
+      const std::string &piece = words[pick(rnd)];
+      word += piece[0] == '#' ? piece.substr(2) : piece;
+    }
+    sentence.push_back(word);
+  }
+
+  // The tokens are the greedy longest match from the start of each word, a word with no match is unknown
+  std::vector<std::string> expected;
+  for (const auto &word : sentence) {
+    std::vector<std::string> pieces;
+    size_t start = 0;
+    while (start < word.size()) {
+      std::string piece;
+      for (size_t end = word.size(); end > start; --end) {
+        std::string candidate = (start == 0 ? "" : "##") + word.substr(start, end - start);
+        if (seen.count(candidate) != 0) {
+          piece = candidate;
+          break;
+        }
+      }
+      if (piece.empty()) {
+        pieces = {"[UNK]"};
+        break;
+      }
+      start += start == 0 ? piece.size() : piece.size() - 2;
+      pieces.push_back(piece);
+    }
+    expected.insert(expected.end(), pieces.begin(), pieces.end());
+  }
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromVector(sentence, &input));
+  WordpieceTokenizerOp op(vocab, "##", 100, "[UNK]", false);
+  TensorRow output;
+  ASSERT_OK(op.Compute(TensorRow(0, {input}), &output));
+  ASSERT_EQ(output[0]->Size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    CheckEqual(output[0], {static_cast<dsize_t>(i)}, expected[i]);
+  }
+}
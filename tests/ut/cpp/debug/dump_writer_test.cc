@@ -0,0 +1,194 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <zlib.h>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/system/file_system.h"
+#include "utils/system/env.h"
+#define private public
+#include "debug/data_dump/dump_json_parser.h"
+#include "debug/data_dump/dump_writer.h"
+#undef private
+
+namespace mindspore {
+class TestDumpWriter : public UT::Common {
+ public:
+  TestDumpWriter() {}
+
+  void TearDown() override {
+    // The writer is a singleton, the other dump tests expect it synchronous and uncompressed
+    auto &writer = DumpWriter::GetInstance();
+    writer.Flush();
+    writer.config_ = DumpWriterConfig();
+  }
+};
+
+TEST_F(TestDumpWriter, test_AsyncCompressedWrite) {
+  auto &writer = DumpWriter::GetInstance();
+  DumpWriterConfig config;
+  config.async = true;
+  config.buffer_size = 64 << 10;
+  config.compression = DumpCompression::kZlib;
+  writer.Init(config);
+
+  std::vector<int> data(4096);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = i % 10;
+  }
+  std::vector<std::string> filenames;
+  for (int i = 0; i < 32; i++) {
+    filenames.push_back("/tmp/dumpWriterTestFile" + std::to_string(i));
+    ASSERT_TRUE(DumpJsonParser::DumpToFile(filenames.back(), data.data(), data.size() * sizeof(int)));
+  }
+  writer.Flush();
+  ASSERT_EQ(writer.used_bytes_, 0);
+  ASSERT_LE(writer.free_bytes_, config.buffer_size);
+
+  std::shared_ptr<system::FileSystem> fs = system::Env::GetFileSystem();
+  for (const auto &filename : filenames) {
+    auto gz_filename = filename + ".gz";
+    gzFile gz_file = gzopen(gz_filename.c_str(), "rb");
+    ASSERT_NE(gz_file, nullptr);
+    std::vector<int> read_back(data.size() + 1);
+    int read_size = gzread(gz_file, read_back.data(), read_back.size() * sizeof(int));
+    (void)gzclose(gz_file);
+    ASSERT_EQ(read_size, data.size() * sizeof(int));
+    read_back.pop_back();
+    ASSERT_EQ(read_back, data);
+    fs->DeleteFile(gz_filename);
+  }
+}
+
+TEST_F(TestDumpWriter, test_DropWhenFull) {
+  auto &writer = DumpWriter::GetInstance();
+  writer.config_.async = true;
+  writer.config_.buffer_size = 1024;
+  writer.config_.full_policy = DumpFullPolicy::kDrop;
+  // Fill the budget by hand so that the next write can not get a buffer
+  {
+    std::lock_guard<std::mutex> lock(writer.mutex_);
+    writer.used_bytes_ = writer.config_.buffer_size;
+  }
+  int data[16] = {0};
+  char filename[] = "/tmp/dumpWriterDroppedFile";
+  ASSERT_TRUE(writer.Write(filename, data, sizeof(data)));
+  ASSERT_EQ(writer.dropped_, 1);
+  ASSERT_FALSE(system::Env::GetFileSystem()->FileExist(filename));
+  {
+    std::lock_guard<std::mutex> lock(writer.mutex_);
+    writer.used_bytes_ = 0;
+  }
+  writer.Flush();
+  ASSERT_EQ(writer.dropped_, 0);
+}
+
+TEST_F(TestDumpWriter, test_EndIteration) {
+  auto &writer = DumpWriter::GetInstance();
+  DumpWriterConfig config;
+  config.async = true;
+  config.buffer_size = 64 << 10;
+  config.full_policy = DumpFullPolicy::kDrop;
+  writer.Init(config);
+  writer.config_ = config;
+
+  std::vector<int> data(1024, 1);
+  std::vector<std::string> filenames;
+  for (uint32_t iter = 1; iter <= 3; iter++) {
+    for (int i = 0; i < 4; i++) {
+      filenames.push_back("/tmp/dumpWriterIterationFile" + std::to_string(iter) + "_" + std::to_string(i));
+      ASSERT_TRUE(writer.Write(filenames.back(), data.data(), data.size() * sizeof(int)));
+    }
+    ASSERT_EQ(writer.EndIteration(iter), 0);
+    // Only the writes of the iteration just ended may still be pending
+    std::lock_guard<std::mutex> lock(writer.mutex_);
+    ASSERT_TRUE(writer.pending_writes_.empty() || writer.pending_writes_.begin()->first + 1 == writer.epoch_);
+  }
+
+  // The drops are reported for the iteration they happened in
+  writer.Flush();
+  {
+    std::lock_guard<std::mutex> lock(writer.mutex_);
+    writer.used_bytes_ = writer.config_.buffer_size;
+  }
+  ASSERT_TRUE(writer.Write("/tmp/dumpWriterIterationDropped0", data.data(), data.size() * sizeof(int)));
+  ASSERT_TRUE(writer.Write("/tmp/dumpWriterIterationDropped1", data.data(), data.size() * sizeof(int)));
+  {
+    std::lock_guard<std::mutex> lock(writer.mutex_);
+    writer.used_bytes_ = 0;
+  }
+  ASSERT_EQ(writer.EndIteration(4), 2);
+  ASSERT_EQ(writer.EndIteration(5), 0);
+
+  writer.Flush();
+  std::shared_ptr<system::FileSystem> fs = system::Env::GetFileSystem();
+  ASSERT_FALSE(fs->FileExist("/tmp/dumpWriterIterationDropped0"));
+  for (const auto &filename : filenames) {
+    ASSERT_TRUE(fs->FileExist(filename));
+    fs->DeleteFile(filename);
+  }
+}
+
+TEST_F(TestDumpWriter, test_IterationSampling) {
+  auto &parser = DumpJsonParser::GetInstance();
+  auto iteration = parser.iteration_;
+  auto iteration_interval = parser.iteration_interval_;
+
+  parser.iteration_ = 0;
+  parser.iteration_interval_ = 0;
+  ASSERT_TRUE(parser.IsDumpIter(1));
+  ASSERT_TRUE(parser.IsDumpIter(7));
+
+  parser.iteration_ = 3;
+  ASSERT_FALSE(parser.IsDumpIter(2));
+  ASSERT_TRUE(parser.IsDumpIter(3));
+  ASSERT_FALSE(parser.IsDumpIter(4));
+
+  parser.iteration_interval_ = 5;
+  ASSERT_FALSE(parser.IsDumpIter(2));
+  ASSERT_TRUE(parser.IsDumpIter(3));
+  ASSERT_FALSE(parser.IsDumpIter(4));
+  ASSERT_TRUE(parser.IsDumpIter(8));
+  ASSERT_TRUE(parser.IsDumpIter(13));
+
+  parser.iteration_ = 0;
+  ASSERT_TRUE(parser.IsDumpIter(1));
+  ASSERT_FALSE(parser.IsDumpIter(5));
+  ASSERT_TRUE(parser.IsDumpIter(6));
+
+  parser.iteration_ = iteration;
+  parser.iteration_interval_ = iteration_interval;
+}
+
+TEST_F(TestDumpWriter, test_KernelsRegex) {
+  auto &parser = DumpJsonParser::GetInstance();
+  auto dump_mode = parser.dump_mode_;
+  parser.dump_mode_ = 1;
+  parser.kernels_regex_.emplace_back("Conv2D-op[0-9]+$");
+  ASSERT_TRUE(parser.NeedDump("Default/network/Conv2D-op12"));
+  ASSERT_FALSE(parser.NeedDump("Default/network/ReLU-op13"));
+  // Answered from the cache the second time
+  ASSERT_EQ(parser.regex_match_cache_.size(), 2);
+  ASSERT_TRUE(parser.NeedDump("Default/network/Conv2D-op12"));
+  ASSERT_EQ(parser.regex_match_cache_.size(), 2);
+
+  parser.kernels_regex_.clear();
+  parser.regex_match_cache_.clear();
+  parser.dump_mode_ = dump_mode;
+}
+}  // namespace mindspore
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "profiler/device/cpu/cpu_profiling.h"
+#undef private
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+class TestCPUProfiling : public UT::Common {
+ public:
+  TestCPUProfiling() {}
+};
+
+TEST_F(TestCPUProfiling, test_EventRingWraparound) {
+  EventRing ring(4, 3);
+  std::vector<CpuOpEvent> events;
+  ASSERT_EQ(ring.Collect(&events), 0);
+  ASSERT_TRUE(events.empty());
+
+  for (uint64_t i = 0; i < 6; i++) {
+    ring.Next()->start_time_stamp = i;
+    ring.Commit();
+  }
+  // The two oldest events were overwritten, the others come in the order they were recorded
+  ASSERT_EQ(ring.Collect(&events), 2);
+  ASSERT_EQ(events.size(), 4);
+  for (uint64_t i = 0; i < 4; i++) {
+    ASSERT_EQ(events[i].start_time_stamp, i + 2);
+  }
+
+  ring.Clear();
+  events.clear();
+  ASSERT_EQ(ring.Collect(&events), 0);
+  ASSERT_TRUE(events.empty());
+  ASSERT_EQ(ring.thread_id(), 3);
+}
+
+TEST_F(TestCPUProfiling, test_StopWaitsForEventsInFlight) {
+  auto profiler = CPUProfiler::GetInstance();
+  profiler->StepProfilingEnable(true);
+  std::atomic<bool> begun{false};
+  std::atomic<bool> ended{false};
+  EventRing *ring = nullptr;
+  std::thread producer([&]() {
+    profiler->OpDataProducerBegin("Default/MatMul-op0", {{2, 3}, {3, 4}}, 96);
+    ring = profiler->ThreadRing();
+    begun = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ended = true;
+    profiler->OpDataProducerEnd();
+  });
+  while (!begun) {
+    std::this_thread::yield();
+  }
+  profiler->Stop();
+  ASSERT_TRUE(ended);
+  producer.join();
+  ASSERT_FALSE(ring->busy());
+
+  // Events started after Stop are not recorded
+  std::thread late_producer([&]() {
+    profiler->OpDataProducerBegin("Default/MatMul-op0", {}, 0);
+    profiler->OpDataProducerEnd();
+  });
+  late_producer.join();
+  std::vector<CpuOpEvent> events;
+  for (const auto &thread_ring : profiler->rings_) {
+    ASSERT_EQ(thread_ring->Collect(&events), 0);
+  }
+  ASSERT_TRUE(events.empty());
+}
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() {}
+
+  static MemPlanBlock Block(size_t size, size_t start, size_t end) {
+    MemPlanBlock block;
+    block.size = size;
+    block.start = start;
+    block.end = end;
+    return block;
+  }
+
+  // Blocks alive at the same step must not share memory, and all of them fit in the peak size
+  static void CheckNoOverlap(const std::vector<MemPlanBlock> &blocks, size_t peak_size) {
+    for (size_t i = 0; i < blocks.size(); i++) {
+      const auto &block = blocks[i];
+      ASSERT_LE(block.offset + block.size, peak_size);
+      for (size_t j = i + 1; j < blocks.size(); j++) {
+        const auto &other = blocks[j];
+        if (block.start <= other.end && other.start <= block.end) {
+          ASSERT_TRUE(block.offset + block.size <= other.offset || other.offset + other.size <= block.offset)
+            << "blocks " << i << " and " << j << " overlap";
+        }
+      }
+    }
+  }
+};
+
+TEST_F(TestCPUSimpleMemPlan, test_ReuseChain) {
+  // Each kernel reads the output of the one before, only two outputs are alive at a time
+  std::vector<MemPlanBlock> blocks = {Block(64, 0, 1), Block(64, 1, 2), Block(64, 2, 3), Block(64, 3, 3)};
+  size_t peak_size = CPUSimpleMemPlan::AssignOffsets(&blocks);
+  ASSERT_EQ(peak_size, 128);
+  CheckNoOverlap(blocks, peak_size);
+  ASSERT_EQ(blocks[0].offset, blocks[2].offset);
+  ASSERT_EQ(blocks[1].offset, blocks[3].offset);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_ReuseFreedRanges) {
+  // A large block and a whole graph output, the smaller blocks after it fit in its range
+  std::vector<MemPlanBlock> blocks = {Block(256, 0, 1), Block(32, 0, 4), Block(96, 2, 3), Block(160, 2, 2),
+                                      Block(224, 4, 4)};
+  size_t peak_size = CPUSimpleMemPlan::AssignOffsets(&blocks);
+  ASSERT_EQ(peak_size, 288);
+  CheckNoOverlap(blocks, peak_size);
+  // The freed range is merged again once its parts are released
+  ASSERT_EQ(blocks[4].offset, blocks[0].offset);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_RandomLifetimes) {
+  std::mt19937 rnd(1);
+  std::uniform_int_distribution<size_t> size(1, 64);
+  std::uniform_int_distribution<size_t> step(0, 199);
+  std::uniform_int_distribution<size_t> lifetime(0, 10);
+  std::vector<MemPlanBlock> blocks;
+  size_t naive_size = 0;
+  for (size_t i = 0; i < 2000; i++) {
+    size_t start = step(rnd);
+    blocks.push_back(Block(size(rnd) * 32, start, std::min<size_t>(start + lifetime(rnd), 199)));
+    naive_size += blocks.back().size;
+  }
+  size_t peak_size = CPUSimpleMemPlan::AssignOffsets(&blocks);
+  CheckNoOverlap(blocks, peak_size);
+  // The peak is at least the memory alive at the busiest step, and far below the naive size
+  size_t live_size = 0;
+  for (size_t s = 0; s < 200; s++) {
+    size_t step_size = 0;
+    for (const auto &block : blocks) {
+      step_size += block.start <= s && s <= block.end ? block.size : 0;
+    }
+    live_size = std::max(live_size, step_size);
+  }
+  ASSERT_GE(peak_size, live_size);
+  ASSERT_LT(peak_size, naive_size / 4);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
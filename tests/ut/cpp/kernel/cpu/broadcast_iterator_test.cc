@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class BroadcastIteratorTest : public UT::Common {
+ public:
+  BroadcastIteratorTest() = default;
+};
+
+TEST_F(BroadcastIteratorTest, SameShape) {
+  std::vector<float> a{1, 2, 3, 4, 5, 6};
+  std::vector<float> b{6, 5, 4, 3, 2, 1};
+  std::vector<float> out(6, 0);
+  BroadcastIterator iter({2, 3}, {2, 3}, {2, 3});
+  iter.Run(a.data(), b.data(), out.data(), 0, 6, [](float x, float y) { return x - y; });
+  std::vector<float> expect{-5, -3, -1, 1, 3, 5};
+  EXPECT_EQ(out, expect);
+}
+
+TEST_F(BroadcastIteratorTest, ScalarOperand) {
+  std::vector<int> a{1, 2, 3, 4};
+  std::vector<int> b{10};
+  std::vector<int> out(4, 0);
+  BroadcastIterator iter({2, 2}, {}, {2, 2});
+  iter.Run(a.data(), b.data(), out.data(), 0, 4, [](int x, int y) { return x - y; });
+  std::vector<int> expect{-9, -8, -7, -6};
+  EXPECT_EQ(out, expect);
+}
+
+TEST_F(BroadcastIteratorTest, GeneralBroadcastInChunks) {
+  // a with shape (2, 1, 3) and b with shape (4, 1) broadcast to (2, 4, 3)
+  std::vector<int> a{0, 1, 2, 3, 4, 5};
+  std::vector<int> b{0, 10, 20, 30};
+  std::vector<int> out(24, -1);
+  BroadcastIterator iter({2, 1, 3}, {4, 1}, {2, 4, 3});
+  auto op = [](int x, int y) { return x + y; };
+  for (size_t start = 0; start < out.size(); start += 5) {
+    iter.Run(a.data(), b.data(), out.data(), start, std::min(start + 5, out.size()), op);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t k = 0; k < 3; ++k) {
+        EXPECT_EQ(out[i * 12 + j * 3 + k], a[i * 3 + k] + b[j]);
+      }
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+class CPUThreadPoolTest : public UT::Common {
+ public:
+  CPUThreadPoolTest() = default;
+  void SetUp() override { CPUThreadPool::GetInstance().SetThreadNum(4); }
+  void TearDown() override { CPUThreadPool::GetInstance().SetThreadNum(0); }
+};
+
+TEST_F(CPUThreadPoolTest, ParallelForCoverEveryElementOnce) {
+  auto &pool = CPUThreadPool::GetInstance();
+  for (size_t count : {1, 7, 128, 1000, 100003}) {
+    std::vector<int> data(count, 0);
+    pool.ParallelFor(count, 16, [&data](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        data[i] += 1;
+      }
+    });
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(data[i], 1);
+    }
+  }
+}
+
+TEST_F(CPUThreadPoolTest, NestedParallelForRunSerially) {
+  auto &pool = CPUThreadPool::GetInstance();
+  std::atomic<size_t> sum{0};
+  pool.ParallelFor(64, 1, [&pool, &sum](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      pool.ParallelFor(10, 1, [&sum](size_t inner_start, size_t inner_end) { sum += inner_end - inner_start; });
+    }
+  });
+  EXPECT_EQ(sum.load(), 640);
+}
+
+TEST_F(CPUThreadPoolTest, ExceptionInTaskIsRethrown) {
+  auto &pool = CPUThreadPool::GetInstance();
+  auto task = [](size_t start, size_t end) {
+    if (start == 0) {
+      throw std::runtime_error("task failed");
+    }
+  };
+  EXPECT_THROW(pool.ParallelFor(1000, 1, task), std::runtime_error);
+  std::atomic<size_t> sum{0};
+  pool.ParallelFor(1000, 1, [&sum](size_t start, size_t end) { sum += end - start; });
+  EXPECT_EQ(sum.load(), 1000);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class ReduceCpuKernelTest : public UT::Common {
+ public:
+  ReduceCpuKernelTest() = default;
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  void InitReduce(ReduceCPUKernel *reduce, size_t reduce_type, const std::vector<size_t> &shape,
+                  const std::vector<size_t> &axis) {
+    reduce->reduce_type_ = reduce_type;
+    reduce->shape_ = shape;
+    reduce->axis_ = axis;
+    reduce->left_dims_ = 1;
+    reduce->stride_ = 1;
+    for (size_t i = 0; i < shape.size(); ++i) {
+      reduce->left_dims_ *= shape[i];
+    }
+    for (auto i : axis) {
+      reduce->stride_ *= shape[i];
+    }
+    reduce->left_dims_ /= reduce->stride_;
+    reduce->SimplifyShape();
+  }
+};
+
+TEST_F(ReduceCpuKernelTest, ReduceSumMiddleAxis) {
+  // shape (2, 3, 2), reduce axis 1
+  std::vector<float> input{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  std::vector<float> output(4, 0);
+  ReduceCPUKernel reduce;
+  InitReduce(&reduce, 2, {2, 3, 2}, {1});
+  std::vector<AddressPtr> inputs{CreateKernelAddress(input.data(), input.size() * sizeof(float))};
+  std::vector<AddressPtr> outputs{CreateKernelAddress(output.data(), output.size() * sizeof(float))};
+  reduce.LaunchKernel<float>(inputs, outputs);
+  std::vector<float> expect{6, 9, 24, 27};
+  EXPECT_EQ(output, expect);
+}
+
+TEST_F(ReduceCpuKernelTest, ReduceMaxOuterAndInnerAxis) {
+  // shape (2, 3, 2), reduce axis 0 and 2
+  std::vector<int> input{0, 7, 2, -3, 4, 5, 6, 1, -8, 9, 10, 11};
+  std::vector<int> output(3, 0);
+  ReduceCPUKernel reduce;
+  InitReduce(&reduce, 0, {2, 3, 2}, {0, 2});
+  std::vector<AddressPtr> inputs{CreateKernelAddress(input.data(), input.size() * sizeof(int))};
+  std::vector<AddressPtr> outputs{CreateKernelAddress(output.data(), output.size() * sizeof(int))};
+  reduce.LaunchKernel<int>(inputs, outputs);
+  std::vector<int> expect{7, 9, 11};
+  EXPECT_EQ(output, expect);
+}
+
+TEST_F(ReduceCpuKernelTest, ReduceSumLargeVector) {
+  std::vector<double> input(100003, 1.0);
+  double output = 0;
+  ReduceCPUKernel reduce;
+  InitReduce(&reduce, 2, {input.size()}, {0});
+  std::vector<AddressPtr> inputs{CreateKernelAddress(input.data(), input.size() * sizeof(double))};
+  std::vector<AddressPtr> outputs{CreateKernelAddress(&output, sizeof(double))};
+  reduce.LaunchKernel<double>(inputs, outputs);
+  EXPECT_EQ(output, 100003.0);
+}
+}  // namespace kernel
+}  // namespace mindspore
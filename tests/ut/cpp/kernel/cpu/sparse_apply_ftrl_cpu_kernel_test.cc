@@ -21,6 +21,7 @@
 #include "backend/kernel_compiler/cpu/sparse_apply_ftrl_cpu_kernel.h"
 #undef private
 #undef protected
+#include "utils/checkpoint/dirty_row_tracker.h"
 
 namespace mindspore {
 namespace kernel {
@@ -162,5 +163,54 @@ TEST_F(SparseApplyFtrlCpuKernelTest, sparse_test2) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.551445) < 1e-6);
   }
 }
+
+TEST_F(SparseApplyFtrlCpuKernelTest, changed_rows_test) {
+  for (size_t i = 0; i < 4 * 3 * 3; ++i) {
+    var_.push_back(1.0);
+    accum_.push_back(1.0);
+    linear_.push_back(1.0);
+  }
+  for (size_t i = 0; i < 3 * 3 * 3; ++i) {
+    grad_.push_back(1.0);
+  }
+  sparse_ftrl_->indices_size_ = 3;
+  sparse_ftrl_->var_first_dim_size_ = 4;
+  sparse_ftrl_->var_outer_dim_size_ = 9;
+  sparse_ftrl_->indices_data_type_ = kNumberTypeInt64;
+
+  // The parameters were saved in a native checkpoint
+  auto &tracker = checkpoint::DirtyRowTracker::GetInstance();
+  tracker.Enable();
+  tracker.Track(var_.data(), 4, "var");
+  tracker.Track(accum_.data(), 4, "accum");
+  tracker.Track(linear_.data(), 4, "linear");
+
+  std::vector<int64_t> indices{3, 3, 1};
+  CreateInputAddress(indices);
+  std::vector<float> new_grad(3 * 3 * 3);
+  std::vector<int64_t> new_indices(3);
+  std::vector<float> tmp_grad(3 * 3 * 3);
+  std::vector<int64_t> tmp_indices(3);
+  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices);
+  sparse_ftrl_->Launch(inputs_, workspace_, outputs_);
+  std::vector<int64_t> rows;
+  ASSERT_TRUE(tracker.TakeRows(var_.data(), 4, "var", &rows));
+  EXPECT_EQ(rows, std::vector<int64_t>({1, 3}));
+  ASSERT_TRUE(tracker.TakeRows(accum_.data(), 4, "accum", &rows));
+  EXPECT_EQ(rows, std::vector<int64_t>({1, 3}));
+  ASSERT_TRUE(tracker.TakeRows(linear_.data(), 4, "linear", &rows));
+  EXPECT_EQ(rows, std::vector<int64_t>({1, 3}));
+  for (size_t i = 0; i < 3 * 3; ++i) {
+    EXPECT_EQ(var_[i], 1.0);
+  }
+
+  // A kernel writing var as a whole, like Assign, makes the next checkpoint save it in full
+  tracker.MarkAll(var_.data());
+  sparse_ftrl_->Launch(inputs_, workspace_, outputs_);
+  EXPECT_FALSE(tracker.TakeRows(var_.data(), 4, "var", &rows));
+  ASSERT_TRUE(tracker.TakeRows(accum_.data(), 4, "accum", &rows));
+  EXPECT_EQ(rows, std::vector<int64_t>({1, 3}));
+  tracker.Retain({});
+}
 }  // namespace kernel
 }  // namespace mindspore
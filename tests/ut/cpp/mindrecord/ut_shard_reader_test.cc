@@ -194,5 +194,39 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+TEST_F(TestShardReader, TestShardReaderMmapMatchesStream) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet by mmap"));
+  std::string file_name = "./imagenet.shard01";
+
+  ShardReader stream_reader;
+  ASSERT_EQ(stream_reader.Open({file_name}, true, 1), SUCCESS);
+  ASSERT_EQ(stream_reader.Launch(true), SUCCESS);
+  ShardReader mmap_reader;
+  mmap_reader.SetReadMode(ShardReadMode::kMmap);
+  ASSERT_EQ(mmap_reader.Open({file_name}, true, 1), SUCCESS);
+  ASSERT_EQ(mmap_reader.Launch(true), SUCCESS);
+  ASSERT_EQ(stream_reader.GetNumRows(), mmap_reader.GetNumRows());
+
+  for (int row_id = 0; row_id < stream_reader.GetNumRows(); ++row_id) {
+    auto expected = stream_reader.GetNextById(row_id, 0);
+    auto actual = mmap_reader.GetNextRefById(row_id, 0);
+    ASSERT_EQ(expected.second.size(), 1);
+    ASSERT_EQ(actual.second.size(), 1);
+    const auto &blob = std::get<0>(expected.second[0]);
+    const auto &blob_ref = std::get<0>(actual.second[0]);
+    ASSERT_NE(blob_ref.owner, nullptr);
+    ASSERT_EQ(blob_ref.size, blob.size());
+    ASSERT_EQ(memcmp(blob_ref.data, blob.data(), blob.size()), 0);
+    ASSERT_EQ(std::get<1>(actual.second[0]), std::get<1>(expected.second[0]));
+  }
+
+  // A row handed out by reference stays readable after the reader is closed
+  auto kept = mmap_reader.GetNextRefById(0, 0);
+  auto expected = stream_reader.GetNextById(0, 0);
+  mmap_reader.Close();
+  stream_reader.Close();
+  const auto &blob_ref = std::get<0>(kept.second[0]);
+  ASSERT_EQ(memcmp(blob_ref.data, std::get<0>(expected.second[0]).data(), blob_ref.size), 0);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract/abstract_value.h"
+#include "common/common_test.h"
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "pipeline/jit/compile_cache.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestCompileCache : public UT::Common {
+ public:
+  TestCompileCache() {}
+  void SetUp() {}
+  void TearDown() { (void)unsetenv(kCompileCacheDirEnv); }
+
+  // A graph computing Add(Mul(x, c), w) of the input x, the constant c and the weight w of the given shape
+  static ResourcePtr MakeResource(const std::vector<int64_t> &weight_shape, float constant = 2) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    x->set_name("x");
+    x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, weight_shape));
+    auto w = func_graph->add_parameter();
+    w->set_name("w");
+    auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, weight_shape);
+    w->set_default_param(weight);
+    w->set_abstract(weight->ToAbstract());
+    auto c = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, weight_shape);
+    auto c_data = static_cast<float *>(c->data_c());
+    for (int i = 0; i < c->DataSize(); ++i) {
+      c_data[i] = constant;
+    }
+    auto c_node = NewValueNode(c);
+    c_node->set_abstract(c->ToAbstract());
+    auto mul = func_graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Mul")), x, c_node});
+    mul->set_abstract(x->abstract());
+    auto add = func_graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Add")), mul, w});
+    add->set_abstract(x->abstract());
+    func_graph->set_output(add);
+    ResourcePtr resource = std::make_shared<Resource>();
+    resource->manager()->AddFuncGraph(func_graph, true);
+    resource->set_func_graph(func_graph);
+    return resource;
+  }
+
+  static std::vector<ActionItem> Actions(const std::vector<std::string> &names) {
+    std::vector<ActionItem> actions;
+    for (auto &name : names) {
+      actions.emplace_back(std::make_pair(name, [](const ResourcePtr &) { return true; }));
+    }
+    return actions;
+  }
+};
+
+TEST_F(TestCompileCache, test_enabled) {
+  auto actions = Actions({"parse", "symbol_resolve", "optimize", "validate", "task_emit", "execute"});
+  (void)unsetenv(kCompileCacheDirEnv);
+  EXPECT_FALSE(CompileCache::Enabled(actions));
+  (void)setenv(kCompileCacheDirEnv, "./compile_cache_test", 1);
+  EXPECT_TRUE(CompileCache::Enabled(actions));
+  // The export phases stop at validate and are not cached
+  EXPECT_FALSE(CompileCache::Enabled(Actions({"parse", "symbol_resolve", "optimize", "validate"})));
+}
+
+TEST_F(TestCompileCache, test_key) {
+  auto resource = MakeResource({2, 3});
+  resource->set_args_spec({std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{4})});
+  CompileCache cache("./compile_cache_test");
+  cache.ComputeKey(resource);
+  std::string key = cache.key();
+  ASSERT_EQ(key.size(), 64u);
+
+  // The same graph and arguments give the same key
+  CompileCache same("./compile_cache_test");
+  same.ComputeKey(resource);
+  EXPECT_EQ(same.key(), key);
+
+  // Other arguments or weight shapes give another key
+  resource->set_args_spec({std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{5})});
+  same.ComputeKey(resource);
+  EXPECT_NE(same.key(), key);
+  auto other = MakeResource({3, 2});
+  other->set_args_spec({std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{4})});
+  same.ComputeKey(other);
+  EXPECT_NE(same.key(), key);
+
+  // The anf_ir proto of a constant has no data, another value of it still gives another key
+  auto scaled = MakeResource({2, 3}, 3);
+  scaled->set_args_spec({std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{4})});
+  same.ComputeKey(scaled);
+  EXPECT_NE(same.key(), key);
+
+  // Nothing is cached under the key yet
+  EXPECT_FALSE(cache.Load(resource));
+}
+
+TEST_F(TestCompileCache, test_save_and_load) {
+  const std::string dir = "/tmp";
+  auto resource = MakeResource({2, 3});
+  CompileCache cache(dir);
+  cache.ComputeKey(resource);
+  cache.Save(resource);
+  std::string path = dir + "/" + cache.key() + ".mindir";
+
+  // A new process resolves the same graph with weights of its own
+  auto resolved = MakeResource({2, 3});
+  auto weight = resolved->func_graph()->parameters()[1]->cast<ParameterPtr>()->default_param();
+  CompileCache loader(dir);
+  loader.ComputeKey(resolved);
+  ASSERT_EQ(loader.key(), cache.key());
+  ASSERT_TRUE(loader.Load(resolved));
+
+  // The inputs come first and the weights after them, bound to the weights of the resolved graph
+  auto params = resolved->func_graph()->parameters();
+  ASSERT_EQ(params.size(), 2u);
+  ASSERT_FALSE(params[0]->cast<ParameterPtr>()->has_default());
+  auto w = params[1]->cast<ParameterPtr>();
+  ASSERT_EQ(w->name(), "w");
+  EXPECT_EQ(w->default_param(), weight);
+  EXPECT_EQ(resolved->func_graph()->hyper_param_count(), 1u);
+
+  // The constant keeps its data
+  bool found = false;
+  for (auto &node : TopoSort(resolved->func_graph()->get_return())) {
+    auto c = GetValueNode<tensor::TensorPtr>(node);
+    if (c != nullptr) {
+      found = true;
+      EXPECT_EQ(static_cast<float *>(c->data_c())[0], 2);
+    }
+  }
+  EXPECT_TRUE(found);
+
+  // A graph with another constant does not hit the file
+  auto scaled = MakeResource({2, 3}, 3);
+  CompileCache miss(dir);
+  miss.ComputeKey(scaled);
+  EXPECT_FALSE(miss.Load(scaled));
+  (void)std::remove(path.c_str());
+}
+}  // namespace pipeline
+}  // namespace mindspore
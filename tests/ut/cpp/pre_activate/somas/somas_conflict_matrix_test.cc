@@ -0,0 +1,129 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/optimizer/somas/somas_solver_pre.h"
+
+namespace mindspore {
+namespace somas {
+class TestConflictMatrix : public UT::Common {
+ public:
+  TestConflictMatrix() {}
+
+  // A matrix of size n with random conflicts, and the same conflicts as plain bools
+  static void RandomMatrix(ConflictMatrix *matrix, std::vector<std::vector<bool>> *expected, uint32_t seed) {
+    std::mt19937 rng(seed);
+    size_t n = matrix->Rows();
+    expected->assign(n, std::vector<bool>(n, true));
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < n; j++) {
+        if (rng() % 3 == 0) {
+          matrix->Reset(i, j);
+          (*expected)[i][j] = false;
+        }
+      }
+    }
+  }
+
+  static void CheckEqual(const ConflictMatrix &matrix, const std::vector<std::vector<bool>> &expected) {
+    size_t n = matrix.Rows();
+    for (size_t i = 0; i < n; i++) {
+      size_t count = 0;
+      for (size_t j = 0; j < n; j++) {
+        ASSERT_EQ(matrix(i, j), expected[i][j]) << i << ", " << j;
+        count += expected[i][j] ? 1 : 0;
+      }
+      // The unused bits of the last word stay clear
+      ASSERT_EQ(matrix.CountRow(i), count);
+    }
+  }
+};
+
+TEST_F(TestConflictMatrix, test_TransposeBlock) {
+  std::mt19937_64 rng(1);
+  uint64_t block[ConflictMatrix::kWordBits];
+  uint64_t original[ConflictMatrix::kWordBits];
+  for (size_t i = 0; i < ConflictMatrix::kWordBits; i++) {
+    block[i] = original[i] = rng();
+  }
+  ConflictMatrix::TransposeBlock(block);
+  for (size_t i = 0; i < ConflictMatrix::kWordBits; i++) {
+    for (size_t j = 0; j < ConflictMatrix::kWordBits; j++) {
+      ASSERT_EQ((block[j] >> i) & 1, (original[i] >> j) & 1);
+    }
+  }
+  ConflictMatrix::TransposeBlock(block);
+  for (size_t i = 0; i < ConflictMatrix::kWordBits; i++) {
+    ASSERT_EQ(block[i], original[i]);
+  }
+}
+
+TEST_F(TestConflictMatrix, test_CountRow) {
+  ConflictMatrix matrix(70);
+  ASSERT_EQ(matrix.Bands(), 2);
+  ASSERT_EQ(matrix.CountRow(0), 70);
+  matrix.Reset(0, 3);
+  matrix.Reset(0, 69);
+  ASSERT_EQ(matrix.CountRow(0), 68);
+  matrix.Set(0, 69);
+  ASSERT_EQ(matrix.CountRow(0), 69);
+  ASSERT_EQ(matrix.CountRow(69), 70);
+}
+
+TEST_F(TestConflictMatrix, test_SymmetrizeBand) {
+  // Sizes below, at and past the 64 bit words
+  for (size_t n : {1, 5, 63, 64, 65, 130, 200}) {
+    ConflictMatrix matrix(n);
+    std::vector<std::vector<bool>> expected;
+    RandomMatrix(&matrix, &expected, n);
+    for (size_t band = 0; band < matrix.Bands(); band++) {
+      matrix.SymmetrizeBand(band);
+    }
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < n; j++) {
+        expected[i][j] = expected[i][j] && expected[j][i];
+      }
+    }
+    CheckEqual(matrix, expected);
+  }
+}
+
+TEST_F(TestConflictMatrix, test_CopyRowAndColumn) {
+  const size_t n = 100;
+  ConflictMatrix matrix(n);
+  std::vector<std::vector<bool>> expected;
+  RandomMatrix(&matrix, &expected, 7);
+
+  matrix.CopyRow(3, 70);
+  expected[3] = expected[70];
+  CheckEqual(matrix, expected);
+
+  matrix.CopyColumn(99, 1);
+  matrix.CopyColumn(2, 64);
+  for (size_t k = 0; k < n; k++) {
+    expected[k][99] = expected[k][1];
+    expected[k][2] = expected[k][64];
+  }
+  CheckEqual(matrix, expected);
+
+  // A copy keeps its own bits
+  ConflictMatrix copy(matrix);
+  copy.Reset(0, 0);
+  ASSERT_TRUE(matrix(0, 0) == expected[0][0]);
+}
+}  // namespace somas
+}  // namespace mindspore
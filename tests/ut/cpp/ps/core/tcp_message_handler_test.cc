@@ -15,10 +15,14 @@
  */
 
 #include "ps/core/tcp_message_handler.h"
+#include "ps/core/cluster_config.h"
 #include "common/common_test.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace mindspore {
 namespace ps {
@@ -158,6 +162,119 @@ TEST_F(TestTcpMessageHandler, 4_Header_4088_Data_4_Header_4088_data) {
   handler.ReceiveMessage(result, 4088);
 }
 
+TEST_F(TestTcpMessageHandler, Framed_Message_In_Pieces_Without_Framed_Callback) {
+  TcpMessageHandler handler;
+  int received = 0;
+  handler.SetCallback([&received](const CommMessage &message) {
+    EXPECT_EQ(message.pb_meta().request_id(), 7);
+    EXPECT_EQ(message.data(), std::string(10000, 'a'));
+    ++received;
+  });
+
+  CommMessage meta;
+  meta.mutable_pb_meta()->set_request_id(7);
+  MessageBufferPtr payload = MessageBufferPool::GetInstance().Acquire(10000);
+  memset_s(payload->data(), payload->size(), 'a', payload->size());
+  struct evbuffer *buffer = evbuffer_new();
+  TcpMessageHandler::WriteFramedMessage(buffer, meta, payload);
+  TcpMessageHandler::WriteFramedMessage(buffer, meta, payload);
+  size_t length = evbuffer_get_length(buffer);
+  std::vector<unsigned char> bytes(length);
+  evbuffer_remove(buffer, bytes.data(), length);
+  evbuffer_free(buffer);
+
+  // Split inside the headers, the metadata and the payloads.
+  size_t pos = 0;
+  size_t step = 3;
+  while (pos < length) {
+    size_t num = std::min(step, length - pos);
+    handler.ReceiveMessage(bytes.data() + pos, num);
+    pos += num;
+    step = step * 7 % 4093 + 1;
+  }
+  EXPECT_EQ(received, 2);
+}
+
+TEST_F(TestTcpMessageHandler, Plain_And_Framed_Message_From_Event_Buffer) {
+  TcpMessageHandler handler;
+  int plain_received = 0;
+  int framed_received = 0;
+  handler.SetCallback([&plain_received](const CommMessage &message) {
+    EXPECT_EQ(message.data().size(), 1000);
+    ++plain_received;
+  });
+  handler.SetFramedCallback([&framed_received](const CommMessage &meta, const MessageBufferPtr &payload) {
+    EXPECT_EQ(meta.pb_meta().request_id(), 3);
+    EXPECT_EQ(payload->size(), 70000);
+    EXPECT_EQ(payload->data()[69999], 'b');
+    ++framed_received;
+  });
+
+  CommMessage message;
+  message.set_data(std::string(1000, 'a'));
+  CommMessage meta;
+  meta.mutable_pb_meta()->set_request_id(3);
+  MessageBufferPtr payload = MessageBufferPool::GetInstance().Acquire(70000);
+  memset_s(payload->data(), payload->size(), 'b', payload->size());
+  struct evbuffer *buffer = evbuffer_new();
+  TcpMessageHandler::WriteMessage(buffer, message);
+  TcpMessageHandler::WriteFramedMessage(buffer, meta, payload);
+  TcpMessageHandler::WriteMessage(buffer, message);
+  handler.ReceiveMessage(buffer);
+  EXPECT_EQ(evbuffer_get_length(buffer), 0);
+  evbuffer_free(buffer);
+  EXPECT_EQ(plain_received, 2);
+  EXPECT_EQ(framed_received, 1);
+}
+
+TEST_F(TestTcpMessageHandler, Oversized_Framed_Message_Is_Rejected) {
+  TcpMessageHandler handler;
+  int received = 0;
+  handler.SetCallback([&received](const CommMessage &) { ++received; });
+
+  // A payload length that would overflow the size classes of the buffer pool
+  uint32_t length = kFramedMessageFlag;
+  uint64_t payload_length = (uint64_t(1) << 63) + 1;
+  unsigned char header[kFramedMessageHeaderSize + 1];
+  memcpy_s(header + 1, sizeof(length), &length, sizeof(length));
+  memcpy_s(header + 1 + sizeof(length), sizeof(payload_length), &payload_length, sizeof(payload_length));
+  // Read from an unaligned position
+  handler.ReceiveMessage(header + 1, kFramedMessageHeaderSize);
+  EXPECT_TRUE(handler.discarding());
+
+  // Whatever follows is dropped
+  CommMessage message;
+  message.set_data(std::string(100, 'a'));
+  struct evbuffer *buffer = evbuffer_new();
+  TcpMessageHandler::WriteMessage(buffer, message);
+  handler.ReceiveMessage(buffer);
+  EXPECT_EQ(evbuffer_get_length(buffer), 0);
+  evbuffer_free(buffer);
+  EXPECT_EQ(received, 0);
+  EXPECT_ANY_THROW(MessageBufferPool::GetInstance().Acquire(payload_length));
+}
+
+TEST_F(TestTcpMessageHandler, Message_Above_Configured_Max_Is_Rejected) {
+  uint64_t max_message_size = ClusterConfig::max_message_size();
+  ClusterConfig::set_max_message_size(4096);
+  TcpMessageHandler handler;
+  int received = 0;
+  handler.SetCallback([&received](const CommMessage &) { ++received; });
+
+  CommMessage message;
+  message.set_data(std::string(1000, 'a'));
+  CommMessage large;
+  large.set_data(std::string(5000, 'a'));
+  struct evbuffer *buffer = evbuffer_new();
+  TcpMessageHandler::WriteMessage(buffer, message);
+  TcpMessageHandler::WriteMessage(buffer, large);
+  TcpMessageHandler::WriteMessage(buffer, message);
+  handler.ReceiveMessage(buffer);
+  evbuffer_free(buffer);
+  ClusterConfig::set_max_message_size(max_message_size);
+  EXPECT_EQ(received, 1);
+  EXPECT_TRUE(handler.discarding());
+}
 }  // namespace comm
 }  // namespace ps
 }  // namespace mindspore
\ No newline at end of file
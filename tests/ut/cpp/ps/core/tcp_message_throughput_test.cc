@@ -0,0 +1,145 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/core/tcp_client.h"
+#include "ps/core/tcp_server.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+// Loopback throughput of plain protobuf messages against framed messages carrying a raw payload. The server acks
+// every message with its payload size, the client keeps a window of messages in flight. Both event loops are polled
+// on the test thread, so no loop has to be torn down from another thread.
+class TestTcpMessageThroughput : public UT::Common {
+ public:
+  TestTcpMessageThroughput() = default;
+  virtual ~TestTcpMessageThroughput() = default;
+
+  void SetUp() override {
+    server_ = std::make_unique<TcpServer>("127.0.0.1", 0);
+    server_->SetMessageCallback([](const TcpServer &server, const TcpConnection &conn, const CommMessage &message) {
+      CommMessage ack;
+      ack.mutable_pb_meta()->set_request_id(message.data().size());
+      const_cast<TcpServer &>(server).SendMessage(conn, ack);
+    });
+    server_->SetFramedMessageCallback(
+      [](const TcpServer &server, const TcpConnection &conn, const CommMessage &, const MessageBufferPtr &payload) {
+        CommMessage ack;
+        ack.mutable_pb_meta()->set_request_id(payload->size());
+        const_cast<TcpServer &>(server).SendMessage(conn, ack);
+      });
+    server_->Init();
+
+    client_ = std::make_unique<TcpClient>("127.0.0.1", server_->BoundPort());
+    client_->SetMessageCallback([this](const TcpClient &, const CommMessage &ack) {
+      EXPECT_EQ(ack.pb_meta().request_id(), message_size_);
+      ++acked_;
+      if (sent_ < message_num_) {
+        Send();
+      }
+    });
+    client_->Init();
+  }
+
+  void TearDown() override {
+    client_->Stop();
+    TcpClient::StopEventBase();
+    server_->Stop();
+  }
+
+  void Send() {
+    if (framed_) {
+      client_->SendMessage(meta_, payload_);
+    } else {
+      client_->SendMessage(message_);
+    }
+    ++sent_;
+  }
+
+  // Returns the throughput in GB/s.
+  double RunRound(size_t message_size, size_t message_num, bool framed) {
+    message_size_ = message_size;
+    message_num_ = message_num;
+    framed_ = framed;
+    sent_ = 0;
+    acked_ = 0;
+    if (framed) {
+      payload_ = MessageBufferPool::GetInstance().Acquire(message_size);
+      memset_s(payload_->data(), payload_->size(), 1, payload_->size());
+    } else {
+      message_.set_data(std::string(message_size, 1));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kWindowSize && sent_ < message_num_; ++i) {
+      Send();
+    }
+    while (acked_ < message_num_ && std::chrono::steady_clock::now() - start < std::chrono::seconds(kTimeoutSeconds)) {
+      server_->StartWithNoBlock();
+      client_->StartWithNoBlock();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(acked_, message_num_);
+    payload_ = nullptr;
+    message_.clear_data();
+    return static_cast<double>(message_size * acked_) / elapsed.count() / (1 << 30);
+  }
+
+  static constexpr size_t kWindowSize = 4;
+  static constexpr size_t kBytesPerRound = 64 << 20;
+  static constexpr int kTimeoutSeconds = 60;
+
+  std::unique_ptr<TcpServer> server_;
+  std::unique_ptr<TcpClient> client_;
+  CommMessage message_;
+  CommMessage meta_;
+  MessageBufferPtr payload_;
+  size_t message_size_{0};
+  size_t message_num_{0};
+  size_t sent_{0};
+  size_t acked_{0};
+  bool framed_{false};
+};
+
+TEST_F(TestTcpMessageThroughput, PlainAndFramedMessages) {
+  // Let the connection get established before timing.
+  auto start = std::chrono::steady_clock::now();
+  while (server_->ConnectionNum() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+    server_->StartWithNoBlock();
+    client_->StartWithNoBlock();
+  }
+  ASSERT_EQ(server_->ConnectionNum(), 1);
+
+  std::vector<size_t> message_sizes{1 << 10, 16 << 10, 256 << 10, 4 << 20, 64 << 20};
+  for (size_t message_size : message_sizes) {
+    size_t message_num = std::max(kBytesPerRound / message_size, kWindowSize);
+    double plain = RunRound(message_size, message_num, false);
+    double framed = RunRound(message_size, message_num, true);
+    std::cout << "message size " << std::setw(9) << message_size << " bytes, plain " << std::fixed
+              << std::setprecision(3) << plain << " GB/s, framed " << framed << " GB/s" << std::endl;
+  }
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,205 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <map>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/embedding_placement.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingPlacement : public UT::Common {
+ public:
+  TestEmbeddingPlacement() {}
+  void SetUp() override {
+    // 1000 rows over 4 servers
+    ranges_ = {::ps::Range(0, 249), ::ps::Range(250, 499), ::ps::Range(500, 749), ::ps::Range(750, 999)};
+  }
+
+  // The stats a server reports: its load, its hot rows with their hits and the replicated rows it holds
+  static ::ps::KVPairs<float> ServerStats(float load, const std::vector<std::pair<Key, float>> &hot_rows,
+                                          const std::vector<Key> &replica_rows) {
+    ::ps::KVPairs<float> kvs;
+    kvs.keys.push_back(0);
+    kvs.vals.push_back(load);
+    for (const auto &row : hot_rows) {
+      kvs.keys.push_back(row.first);
+      kvs.vals.push_back(row.second);
+    }
+    for (auto row : replica_rows) {
+      kvs.keys.push_back(row);
+    }
+    kvs.lens.push_back(static_cast<int>(hot_rows.size()));
+    kvs.lens.push_back(static_cast<int>(replica_rows.size()));
+    return kvs;
+  }
+
+  // The reply of a server holding the given rows, row r has every value r
+  static ::ps::KVPairs<float> ServerReply(const std::vector<Key> &rows, size_t row_len) {
+    ::ps::KVPairs<float> kvs;
+    for (auto row : rows) {
+      kvs.keys.push_back(row);
+      for (size_t i = 0; i < row_len; i++) {
+        kvs.vals.push_back(static_cast<float>(row));
+      }
+    }
+    return kvs;
+  }
+
+  std::vector<::ps::Range> ranges_;
+};
+
+TEST_F(TestEmbeddingPlacement, test_RowServer) {
+  ASSERT_EQ(EmbeddingPlacement::RowServer(ranges_, 0), 0);
+  ASSERT_EQ(EmbeddingPlacement::RowServer(ranges_, 250), 1);
+  ASSERT_EQ(EmbeddingPlacement::RowServer(ranges_, 749), 2);
+  ASSERT_EQ(EmbeddingPlacement::RowServer(ranges_, 999), 3);
+  ASSERT_EQ(EmbeddingPlacement::RowServer(ranges_, 1000), -1);
+}
+
+TEST_F(TestEmbeddingPlacement, test_SliceLookupIds) {
+  std::vector<int> ids = {3, 3, 5, 600, -1, 999, 1000};
+  auto server_ids = EmbeddingPlacement::SliceLookupIds(ids.data(), ids.size(), ranges_, nullptr, 0);
+  ASSERT_EQ(server_ids.size(), 4);
+  ASSERT_EQ(server_ids[0], std::vector<Key>({3, 5}));
+  ASSERT_TRUE(server_ids[1].empty());
+  ASSERT_EQ(server_ids[2], std::vector<Key>({600}));
+  ASSERT_EQ(server_ids[3], std::vector<Key>({999}));
+
+  // A replicated row goes to its servers in turn
+  HotRowServers hot_rows = {{3, {0, 1, 3}}};
+  std::vector<int64_t> servers;
+  for (int64_t ts = 0; ts < 3; ts++) {
+    server_ids = EmbeddingPlacement::SliceLookupIds(ids.data(), ids.size(), ranges_, &hot_rows, ts);
+    for (size_t s = 0; s < server_ids.size(); s++) {
+      if (std::find(server_ids[s].begin(), server_ids[s].end(), 3) != server_ids[s].end()) {
+        servers.push_back(s);
+      }
+    }
+    ASSERT_NE(std::find(server_ids[0].begin(), server_ids[0].end(), 5), server_ids[0].end());
+  }
+  std::sort(servers.begin(), servers.end());
+  ASSERT_EQ(servers, std::vector<int64_t>({0, 1, 3}));
+}
+
+TEST_F(TestEmbeddingPlacement, test_PlaceHotRows) {
+  // Row 3 takes most lookups of the table, all of them on server 0
+  std::map<int64_t, ::ps::KVPairs<float>> stats;
+  stats[0] = ServerStats(10000, {{3, 8000}, {5, 10}}, {});
+  stats[1] = ServerStats(1000, {}, {});
+  stats[2] = ServerStats(1000, {}, {});
+  stats[3] = ServerStats(1000, {}, {});
+  auto placement = EmbeddingPlacement::PlaceHotRows(ranges_, stats, {});
+  ASSERT_EQ(placement.size(), 1);
+  const auto &servers = placement.at(3);
+  ASSERT_GT(servers.size(), 1);
+  // The owner comes first and every server holds the row once
+  ASSERT_EQ(servers[0], 0);
+  std::vector<int64_t> sorted(servers);
+  std::sort(sorted.begin(), sorted.end());
+  ASSERT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+  // An even load keeps the rows on their owners
+  for (auto &server_stats : stats) {
+    server_stats.second = ServerStats(1000, {}, {});
+  }
+  stats[0] = ServerStats(1000, {{3, 100}}, {});
+  ASSERT_TRUE(EmbeddingPlacement::PlaceHotRows(ranges_, stats, placement).empty());
+}
+
+TEST_F(TestEmbeddingPlacement, test_GatherPartialMiss) {
+  const size_t row_len = 4;
+  ::ps::SArray<int> ids;
+  for (int id : {3, 600, 5, 3}) {
+    ids.push_back(id);
+  }
+  // The server a stale placement sent row 600 to has dropped it
+  std::vector<::ps::KVPairs<float>> results = {ServerReply({3, 5}, row_len), ServerReply({}, row_len)};
+  ::ps::SArray<float> outs(ids.size() * row_len, -1);
+  auto missed = EmbeddingPlacement::GatherLookupResult(ids, results, &outs);
+  ASSERT_EQ(missed, std::vector<size_t>({1}));
+  for (size_t i = 0; i < ids.size(); i++) {
+    float expected = i == 1 ? -1 : static_cast<float>(ids[i]);
+    for (size_t j = 0; j < row_len; j++) {
+      ASSERT_EQ(outs[i * row_len + j], expected);
+    }
+  }
+}
+
+TEST_F(TestEmbeddingPlacement, test_GatherAllMiss) {
+  const size_t row_len = 2;
+  ::ps::SArray<int> ids;
+  for (int id : {7, 8}) {
+    ids.push_back(id);
+  }
+  // Every server replied without data
+  std::vector<::ps::KVPairs<float>> results;
+  ::ps::SArray<float> outs(ids.size() * row_len, 0);
+  auto missed = EmbeddingPlacement::GatherLookupResult(ids, results, &outs);
+  ASSERT_EQ(missed, std::vector<size_t>({0, 1}));
+
+  // The rows looked up again on their owners fill the result
+  results = {ServerReply({7, 8}, row_len)};
+  missed = EmbeddingPlacement::GatherLookupResult(ids, results, &outs);
+  ASSERT_TRUE(missed.empty());
+  ASSERT_EQ(outs[0], 7);
+  ASSERT_EQ(outs[3], 8);
+}
+
+TEST_F(TestEmbeddingPlacement, test_PushThenPull) {
+  const size_t row_len = 2;
+  HotRowServers hot_rows = {{3, {0, 1, 2}}, {600, {2, 3}}};
+  HotRowServers other_worker_rows = hot_rows;
+  // Pushing row 3 drops its replicas on servers 1 and 2, row 600 keeps its replica
+  std::vector<int> pushed = {3, 7, 3};
+  auto server_rows = EmbeddingPlacement::DropPushedRows(pushed.data(), pushed.size(), ranges_.size(), &hot_rows);
+  ASSERT_EQ(server_rows.size(), 4);
+  ASSERT_TRUE(server_rows[0].empty());
+  ASSERT_EQ(server_rows[1], std::vector<Key>({3}));
+  ASSERT_EQ(server_rows[2], std::vector<Key>({3}));
+  ASSERT_TRUE(server_rows[3].empty());
+  ASSERT_EQ(hot_rows.size(), 1);
+  ASSERT_EQ(hot_rows.count(600), 1);
+
+  // The pushing worker looks row 3 up on its owner at once
+  std::vector<int> ids = {3};
+  for (int64_t ts = 0; ts < 3; ts++) {
+    auto server_ids = EmbeddingPlacement::SliceLookupIds(ids.data(), ids.size(), ranges_, &hot_rows, ts);
+    ASSERT_EQ(server_ids[0], std::vector<Key>({3}));
+  }
+
+  // Another worker still sends row 3 to server 1, which no longer holds it. The owner has applied the push, the
+  // lookup retried there returns the new row and not the replica taken before the push.
+  ::ps::SArray<int> lookup_ids;
+  lookup_ids.push_back(3);
+  auto server_ids = EmbeddingPlacement::SliceLookupIds(ids.data(), ids.size(), ranges_, &other_worker_rows, 1);
+  ASSERT_EQ(server_ids[1], std::vector<Key>({3}));
+  ::ps::SArray<float> outs(row_len, 0);
+  std::vector<::ps::KVPairs<float>> results = {ServerReply({}, row_len)};
+  auto missed = EmbeddingPlacement::GatherLookupResult(lookup_ids, results, &outs);
+  ASSERT_EQ(missed, std::vector<size_t>({0}));
+  ::ps::KVPairs<float> owner_reply = ServerReply({3}, row_len);
+  for (auto &val : owner_reply.vals) {
+    val += 0.5;
+  }
+  results = {owner_reply};
+  missed = EmbeddingPlacement::GatherLookupResult(lookup_ids, results, &outs);
+  ASSERT_TRUE(missed.empty());
+  ASSERT_EQ(outs[0], 3.5);
+  ASSERT_EQ(outs[1], 3.5);
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/checkpoint/checkpoint_file.h"
+#include "utils/system/env.h"
+
+namespace mindspore {
+namespace checkpoint {
+class TestCheckpointFile : public UT::Common {
+ public:
+  TestCheckpointFile() {}
+};
+
+TEST_F(TestCheckpointFile, test_SaveAndLoad) {
+  std::string file_name = "/tmp/checkpointFileTest.ckpt";
+  auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{3, 1000});
+  auto weight_data = static_cast<float *>(weight->data_c());
+  for (int i = 0; i < 3000; i++) {
+    weight_data[i] = i * 0.5;
+  }
+  auto step = std::make_shared<tensor::Tensor>(static_cast<int64_t>(42), kInt64);
+  CheckpointWriter(file_name, 2).Save({"weight", "step"}, {weight, step});
+  ASSERT_TRUE(IsNativeCheckpoint(file_name));
+
+  CheckpointReader reader(file_name);
+  ASSERT_EQ(reader.GetNames(), std::vector<std::string>({"weight", "step"}));
+  for (const auto &entry : reader.entries()) {
+    ASSERT_EQ(entry.offset % kDataAlignment, 0);
+  }
+  auto loaded_weight = reader.GetTensor("weight");
+  ASSERT_EQ(loaded_weight->data_type(), kNumberTypeFloat32);
+  ASSERT_EQ(loaded_weight->shape(), ShapeVector({3, 1000}));
+  auto loaded_data = static_cast<float *>(loaded_weight->data_c());
+  for (int i = 0; i < 3000; i++) {
+    ASSERT_EQ(loaded_data[i], weight_data[i]);
+  }
+  // Writes go to private copies of the mapped pages, the file keeps its content
+  loaded_data[0] = -1;
+  CheckpointReader another_reader(file_name);
+  ASSERT_TRUE(another_reader.VerifyEntry(another_reader.entries()[0]));
+
+  auto loaded_step = reader.GetTensor("step");
+  ASSERT_EQ(loaded_step->data_type(), kNumberTypeInt64);
+  ASSERT_TRUE(loaded_step->shape().empty());
+  ASSERT_EQ(*static_cast<int64_t *>(loaded_step->data_c()), 42);
+  system::Env::GetFileSystem()->DeleteFile(file_name);
+}
+
+TEST_F(TestCheckpointFile, test_DetectCorruption) {
+  std::string file_name = "/tmp/checkpointFileCorruptedTest.ckpt";
+  std::vector<int32_t> data(1024, 7);
+  std::vector<CheckpointEntry> entries(1);
+  entries[0].name = "bias";
+  entries[0].tensor_type = "Int32";
+  entries[0].shape = {1024};
+  entries[0].nbytes = data.size() * sizeof(int32_t);
+  CheckpointWriter(file_name).SaveRaw(&entries, {data.data()});
+  {
+    std::fstream file(file_name, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(entries[0].offset + 100);
+    file.put(1);
+  }
+  CheckpointReader reader(file_name);
+  ASSERT_FALSE(reader.VerifyEntry(reader.entries()[0]));
+  ASSERT_ANY_THROW(reader.GetTensor("bias", true));
+  // Without verify the data is not read when the tensor is mapped
+  ASSERT_NE(reader.GetTensor("bias"), nullptr);
+  system::Env::GetFileSystem()->DeleteFile(file_name);
+}
+
+TEST_F(TestCheckpointFile, test_RejectOtherFiles) {
+  std::string file_name = "/tmp/checkpointFileInvalidTest.ckpt";
+  {
+    std::ofstream file(file_name, std::ios::binary);
+    file << "not a native checkpoint, but long enough to hold a header";
+  }
+  ASSERT_FALSE(IsNativeCheckpoint(file_name));
+  ASSERT_ANY_THROW(CheckpointReader reader(file_name));
+  system::Env::GetFileSystem()->DeleteFile(file_name);
+}
+}  // namespace checkpoint
+}  // namespace mindspore
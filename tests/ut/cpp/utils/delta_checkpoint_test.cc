@@ -0,0 +1,167 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/checkpoint/checkpoint_file.h"
+#include "utils/checkpoint/delta_checkpoint.h"
+#include "utils/checkpoint/dirty_row_tracker.h"
+#include "utils/system/env.h"
+
+namespace mindspore {
+namespace checkpoint {
+class TestDeltaCheckpoint : public UT::Common {
+ public:
+  TestDeltaCheckpoint() {}
+};
+
+TEST_F(TestDeltaCheckpoint, test_TrackRows) {
+  auto &tracker = DirtyRowTracker::GetInstance();
+  tracker.Enable();
+  std::vector<float> table(100 * 4);
+  std::vector<int> rows = {70, 3, 3, 64, -1, 100};
+  // The rows of a buffer are tracked once it was saved
+  tracker.MarkRows(table.data(), 100, rows.data(), rows.size());
+  std::vector<int64_t> taken;
+  ASSERT_FALSE(tracker.TakeRows(table.data(), 100, "table", &taken));
+  tracker.MarkRows(table.data(), 100, rows.data(), rows.size());
+  ASSERT_TRUE(tracker.TakeRows(table.data(), 100, "table", &taken));
+  ASSERT_EQ(taken, std::vector<int64_t>({3, 64, 70}));
+  ASSERT_TRUE(tracker.TakeRows(table.data(), 100, "table", &taken));
+  ASSERT_TRUE(taken.empty());
+
+  // A buffer updated as a whole is saved in full once, then tracked again
+  tracker.MarkAll(table.data());
+  ASSERT_FALSE(tracker.TakeRows(table.data(), 100, "table", &taken));
+  tracker.MarkRows(table.data(), 100, rows.data(), 1);
+  ASSERT_TRUE(tracker.TakeRows(table.data(), 100, "table", &taken));
+  ASSERT_EQ(taken, std::vector<int64_t>({70}));
+
+  // Another tensor reusing the buffer is saved in full, even with the same number of rows
+  tracker.MarkRows(table.data(), 100, rows.data(), rows.size());
+  ASSERT_FALSE(tracker.TakeRows(table.data(), 100, "other", &taken));
+  std::vector<float> untracked(8);
+  ASSERT_FALSE(tracker.TakeRows(untracked.data(), 2, "untracked", &taken));
+
+  // Buffers no checkpoint saves any more are dropped
+  tracker.Retain({untracked.data()});
+  tracker.MarkRows(table.data(), 100, rows.data(), rows.size());
+  ASSERT_FALSE(tracker.TakeRows(table.data(), 100, "other", &taken));
+}
+
+TEST_F(TestDeltaCheckpoint, test_SaveAndLoadChain) {
+  std::string base_file = "/tmp/deltaCheckpointBaseTest.ckpt";
+  std::string delta_file = "/tmp/deltaCheckpointTest.ckpt";
+  auto table = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{1000, 8});
+  auto table_data = static_cast<float *>(table->data_c());
+  for (int i = 0; i < 8000; i++) {
+    table_data[i] = i;
+  }
+  auto bias = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{8});
+  auto bias_data = static_cast<float *>(bias->data_c());
+  for (int i = 0; i < 8; i++) {
+    bias_data[i] = i;
+  }
+  std::vector<std::string> names = {"table", "bias"};
+  std::vector<tensor::TensorPtr> tensors = {table, bias};
+  CheckpointWriter(base_file).Save(names, tensors);
+  ResetChangedRows(tensors);
+
+  // What a sparse optimizer does to the table, the bias is not tracked and saved in full
+  std::vector<int64_t> rows = {999, 5};
+  DirtyRowTracker::GetInstance().MarkRows(table_data, 1000, rows.data(), rows.size());
+  for (auto row : rows) {
+    table_data[row * 8] = -1;
+  }
+  bias_data[0] = -1;
+  DeltaCheckpointWriter writer(delta_file, base_file);
+  writer.Collect(names, tensors, true);
+  // Changes after the collection belong to the next delta
+  table_data[5 * 8 + 1] = -2;
+  writer.Write();
+  ASSERT_TRUE(IsDeltaCheckpoint(delta_file));
+  CheckpointReader delta_reader(delta_file);
+  ASSERT_TRUE(delta_reader.HasTensor(std::string("table") + kRowsSuffix));
+  ASSERT_EQ(delta_reader.GetTensor("table")->shape(), ShapeVector({2, 8}));
+
+  auto loaded = LoadCheckpointChain(delta_file);
+  ASSERT_EQ(loaded.size(), 2);
+  ASSERT_EQ(loaded[0].first, "table");
+  ASSERT_EQ(loaded[0].second->shape(), ShapeVector({1000, 8}));
+  auto loaded_table = static_cast<float *>(loaded[0].second->data_c());
+  for (int i = 0; i < 8000; i++) {
+    float expected = (i == 5 * 8 || i == 999 * 8) ? -1 : i;
+    ASSERT_EQ(loaded_table[i], expected);
+  }
+  ASSERT_EQ(static_cast<float *>(loaded[1].second->data_c())[0], -1);
+  // The base file keeps its content
+  CheckpointReader base_reader(base_file);
+  ASSERT_EQ(static_cast<float *>(base_reader.GetTensor("table")->data_c())[5 * 8], 5 * 8);
+
+  // A delta whose manifest was never written does not load as a full checkpoint
+  system::Env::GetFileSystem()->DeleteFile(delta_file + kManifestSuffix);
+  ASSERT_FALSE(IsDeltaCheckpoint(delta_file));
+  ASSERT_ANY_THROW(LoadCheckpointChain(delta_file));
+  system::Env::GetFileSystem()->DeleteFile(base_file);
+  system::Env::GetFileSystem()->DeleteFile(delta_file);
+}
+
+TEST_F(TestDeltaCheckpoint, test_CompactInPlace) {
+  std::string base_file = "/tmp/deltaCheckpointCompactBaseTest.ckpt";
+  std::string delta_file = "/tmp/deltaCheckpointCompactTest.ckpt";
+  auto table = std::make_shared<tensor::Tensor>(kNumberTypeInt32, ShapeVector{64, 2});
+  auto table_data = static_cast<int32_t *>(table->data_c());
+  for (int i = 0; i < 128; i++) {
+    table_data[i] = i;
+  }
+  std::vector<tensor::TensorPtr> tensors = {table};
+  CheckpointWriter(base_file).Save({"table"}, tensors);
+  ResetChangedRows(tensors);
+  std::vector<int64_t> rows = {1};
+  DirtyRowTracker::GetInstance().MarkRows(table_data, 64, rows.data(), rows.size());
+  table_data[2] = 100;
+  DeltaCheckpointWriter writer(delta_file, base_file);
+  writer.Collect({"table"}, tensors, false);
+  writer.Write();
+
+  struct stat before;
+  ASSERT_EQ(stat(delta_file.c_str(), &before), 0);
+  CompactCheckpoint(delta_file, delta_file);
+  struct stat after;
+  ASSERT_EQ(stat(delta_file.c_str(), &after), 0);
+  ASSERT_EQ(after.st_mtim.tv_sec, before.st_mtim.tv_sec);
+  ASSERT_EQ(after.st_mtim.tv_nsec, before.st_mtim.tv_nsec);
+  ASSERT_FALSE(IsDeltaCheckpoint(delta_file));
+
+  // The compacted checkpoint loads without its base
+  system::Env::GetFileSystem()->DeleteFile(base_file);
+  auto loaded = LoadCheckpointChain(delta_file);
+  ASSERT_EQ(loaded.size(), 1);
+  auto loaded_table = static_cast<int32_t *>(loaded[0].second->data_c());
+  for (int i = 0; i < 128; i++) {
+    ASSERT_EQ(loaded_table[i], i == 2 ? 100 : i);
+  }
+  system::Env::GetFileSystem()->DeleteFile(delta_file);
+}
+
+TEST_F(TestDeltaCheckpoint, test_RejectInvalidBase) {
+  std::string base_file = "/tmp/deltaCheckpointMissingBaseTest.ckpt";
+  ASSERT_ANY_THROW(DeltaCheckpointWriter("/tmp/deltaCheckpointInvalidTest.ckpt", base_file));
+}
+}  // namespace checkpoint
+}  // namespace mindspore
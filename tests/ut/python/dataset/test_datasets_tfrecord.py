@@ -15,6 +15,9 @@
 """
 Test TFRecordDataset Ops
 """
+import gzip
+import os
+import zlib
 import numpy as np
 import pytest
 
@@ -312,6 +315,43 @@ def test_tf_wrong_schema():
     assert exception_occurred, "test_tf_wrong_schema failed."
 
 
+def test_tfrecord_compressed():
+    logger.info("test_tfrecord_compressed")
+
+    def read_column(files, **kwargs):
+        data = ds.TFRecordDataset(files, SCHEMA_FILE, shuffle=False, **kwargs)
+        return [row["col_sint64"].tolist() for row in data.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    expected = read_column(FILES)
+    assert len(expected) == 12
+    with open(FILES[0], "rb") as f:
+        plain = f.read()
+
+    # The compression is told by the content, the file names say the opposite
+    files = {"tfrecord_compressed_gzip.data": (gzip.compress(plain), "GZIP"),
+             "tfrecord_compressed_zlib.data": (zlib.compress(plain), "ZLIB"),
+             "tfrecord_compressed_plain.gz": (plain, "")}
+    try:
+        for file_name, (content, compression_type) in files.items():
+            with open(file_name, "wb") as f:
+                f.write(content)
+            assert read_column([file_name]) == expected
+            assert read_column([file_name], compression_type=compression_type, verify_crc=True) == expected
+            data = ds.TFRecordDataset([file_name], SCHEMA_FILE, compression_type=compression_type)
+            assert data.get_dataset_size() == 12
+    finally:
+        for file_name in files:
+            if os.path.exists(file_name):
+                os.remove(file_name)
+
+    with pytest.raises(ValueError) as info:
+        _ = ds.TFRecordDataset(FILES, SCHEMA_FILE, compression_type="BZIP2")
+    assert "compression_type" in str(info.value)
+    with pytest.raises(TypeError) as info:
+        _ = ds.TFRecordDataset(FILES, SCHEMA_FILE, verify_crc=1)
+    assert "verify_crc" in str(info.value)
+
+
 if __name__ == '__main__':
     test_tfrecord_shape()
     test_tfrecord_read_all_dataset()
@@ -331,3 +371,4 @@ if __name__ == '__main__':
     test_tfrecord_schema_columns_list()
     test_tfrecord_invalid_files()
     test_tf_wrong_schema()
+    test_tfrecord_compressed()
@@ -0,0 +1,85 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test the cpu timeline generator module."""
+import json
+import os
+import shutil
+import tempfile
+
+from mindspore.profiler.parser.integrator import CpuTimelineGenerator
+
+CPU_TIMELINE = {
+    'displayTimeUnit': 'ns',
+    'traceEvents': [
+        {'name': 'process_name', 'ph': 'M', 'pid': 0, 'args': {'name': 'CPU Ops'}},
+        {'name': 'Conv2D-op1', 'cat': 'Ops', 'ph': 'X', 'ts': 1000.5, 'dur': 20.0, 'pid': 0, 'tid': 0,
+         'args': {'op_full_name': 'Default/Conv2D-op1', 'input_shapes': '1,3;3,3', 'bytes': 96}},
+        {'name': 'ReLU-op2', 'cat': 'Ops', 'ph': 'X', 'ts': 1021.0, 'dur': 5.0, 'pid': 0, 'tid': 0,
+         'args': {'op_full_name': 'Default/ReLU-op2', 'input_shapes': '1,3', 'bytes': 24}},
+        {'name': 'Conv2D-op1', 'cat': 'Ops', 'ph': 'X', 'ts': 1030.0, 'dur': 20.0, 'pid': 0, 'tid': 1,
+         'args': {'op_full_name': 'Default/Conv2D-op1', 'input_shapes': '1,3;3,3', 'bytes': 96}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': 0, 'args': {'name': 'Thread 0'}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': 1, 'args': {'name': 'Thread 1'}}
+    ]
+}
+
+
+class TestCpuTimelineGenerator:
+    """Test the class of `CpuTimelineGenerator`."""
+    def setup_method(self):
+        """Initialization before test case execution."""
+        self._profiling_dir = tempfile.mkdtemp(prefix='test_cpu_timeline_generator_')
+        with open(os.path.join(self._profiling_dir, 'cpu_timeline_0.json'), 'w') as file:
+            json.dump(CPU_TIMELINE, file)
+
+    def teardown_method(self) -> None:
+        """Clear up after test case execution."""
+        shutil.rmtree(self._profiling_dir)
+
+    def _generate(self):
+        """Generate the timeline and load the display file."""
+        generator = CpuTimelineGenerator(self._profiling_dir, '0')
+        generator.init_timeline()
+        generator.write_timeline()
+        generator.write_timeline_summary()
+        with open(os.path.join(self._profiling_dir, 'cpu_timeline_display_0.json'), 'r') as file:
+            timeline = json.load(file)
+        with open(os.path.join(self._profiling_dir, 'cpu_timeline_summary_0.json'), 'r') as file:
+            summary = json.load(file)
+        return timeline, summary
+
+    def test_kernels(self):
+        """Test the timeline of the kernels alone."""
+        timeline, summary = self._generate()
+        assert timeline == CPU_TIMELINE['traceEvents']
+        assert summary['num_of_ops'] == 2
+        assert summary['num_of_streams'] == 2
+        assert summary['op_exe_times'] == 3
+        assert abs(summary['total_time'] - 0.045) < 1e-9
+
+    def test_dataset_ops(self):
+        """Test that the work of the dataset ops is laid beside the kernels."""
+        with open(os.path.join(self._profiling_dir, 'dataset_op_execute_timestamp_0.txt'), 'w') as file:
+            file.write('MapOp(ID:2) 0 900 990\n')
+            file.write('BatchOp(ID:1) 0 995 1000\n')
+            file.write('MapOp(ID:2) 1 910 1005\n')
+        timeline, summary = self._generate()
+        assert summary['op_exe_times'] == 3
+        dataset_events = [event for event in timeline if event['pid'] == 8000 and event['ph'] == 'X']
+        assert [(event['name'], event['tid'], event['ts'], event['dur']) for event in dataset_events] == [
+            ('MapOp(ID:2)', 0, 900, 90), ('BatchOp(ID:1)', 1, 995, 5), ('MapOp(ID:2)', 2, 910, 95)]
+        thread_names = {event['tid']: event['args']['name'] for event in timeline
+                        if event['pid'] == 8000 and event['name'] == 'thread_name'}
+        assert thread_names == {0: 'MapOp(ID:2) worker 0', 1: 'BatchOp(ID:1) worker 0', 2: 'MapOp(ID:2) worker 1'}
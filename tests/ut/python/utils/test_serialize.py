@@ -31,7 +31,7 @@ from mindspore.nn.optim.momentum import Momentum
 from mindspore.ops import operations as P
 from mindspore.train.callback import _CheckpointManager
 from mindspore.train.serialization import save_checkpoint, load_checkpoint, load_param_into_net, \
-     export, _save_graph
+     export, convert_checkpoint, _save_graph
 from ..ut_filter import non_graph_engine
 
 context.set_context(mode=context.GRAPH_MODE, print_file_path="print/print.pb")
@@ -136,6 +136,89 @@ def test_load_checkpoint():
     assert isinstance(par_dict, dict)
 
 
+def test_save_and_load_native_checkpoint():
+    """ test save_checkpoint and load_checkpoint in the native format"""
+    weight = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    parameter_list = [{'name': "weight", 'data': Tensor(weight)},
+                      {'name': "global_step", 'data': Tensor(np.array(7).astype(np.int32))}]
+    save_checkpoint(parameter_list, "./native.ckpt", ckpt_format="NATIVE")
+
+    par_dict = load_checkpoint("./native.ckpt")
+    assert len(par_dict) == 2
+    assert par_dict['weight'].name == 'weight'
+    assert par_dict['weight'].data.dtype == mstype.float32
+    assert np.array_equal(par_dict['weight'].data.asnumpy(), weight)
+    assert par_dict['global_step'].data.shape == ()
+    assert par_dict['global_step'].data.asnumpy() == 7
+
+    par_dict = load_checkpoint("./native.ckpt", filter_prefix="global")
+    assert list(par_dict.keys()) == ['weight']
+
+
+def test_load_native_checkpoint_verify():
+    """ test load_checkpoint only checks the checksums of a native checkpoint when asked to"""
+    weight = np.full([4, 1024], 3.0, np.float32)
+    save_checkpoint([{'name': "weight", 'data': Tensor(weight)}], "./native_corrupted.ckpt", ckpt_format="NATIVE")
+    with open("./native_corrupted.ckpt", "r+b") as f:
+        content = f.read()
+        f.seek(content.index(weight.tobytes()) + 100)
+        f.write(b'\x01')
+
+    par_dict = load_checkpoint("./native_corrupted.ckpt")
+    assert par_dict['weight'].data.shape == (4, 1024)
+    with pytest.raises(RuntimeError):
+        load_checkpoint("./native_corrupted.ckpt", verify_checkpoint=True)
+    with pytest.raises(TypeError):
+        load_checkpoint("./native_corrupted.ckpt", verify_checkpoint=1)
+    os.remove("./native_corrupted.ckpt")
+
+
+def test_save_checkpoint_error_format():
+    with pytest.raises(ValueError):
+        save_checkpoint([], "./native.ckpt", ckpt_format="H5")
+
+
+def test_convert_checkpoint():
+    """ test convert_checkpoint between the protobuf and the native format"""
+    ckpt_file_name = os.path.join(_cur_dir, './parameters.ckpt')
+    convert_checkpoint(ckpt_file_name, "./converted.ckpt", ckpt_format="NATIVE")
+    native_dict = load_checkpoint("./converted.ckpt")
+    proto_dict = load_checkpoint(ckpt_file_name)
+    assert native_dict.keys() == proto_dict.keys()
+    for name, param in proto_dict.items():
+        assert np.array_equal(native_dict[name].data.asnumpy(), param.data.asnumpy())
+
+    convert_checkpoint("./converted.ckpt", "./converted_proto.ckpt", ckpt_format="PROTOBUF")
+    par_dict = load_checkpoint("./converted_proto.ckpt")
+    assert np.array_equal(par_dict['param'].data.asnumpy(), proto_dict['param'].data.asnumpy())
+
+
+def test_save_and_load_delta_checkpoint():
+    """ test save_checkpoint and load_checkpoint of a delta checkpoint"""
+    weight = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    parameter_list = [{'name': "weight", 'data': Tensor(weight)}]
+    save_checkpoint(parameter_list, "./delta_base.ckpt", ckpt_format="NATIVE")
+    save_checkpoint(parameter_list, "./delta.ckpt", ckpt_format="NATIVE", base_ckpt_file_name="./delta_base.ckpt")
+    assert os.path.exists("./delta.ckpt.manifest")
+
+    par_dict = load_checkpoint("./delta.ckpt")
+    assert np.array_equal(par_dict['weight'].data.asnumpy(), weight)
+
+    convert_checkpoint("./delta.ckpt", "./delta_compacted.ckpt", ckpt_format="NATIVE")
+    assert not os.path.exists("./delta_compacted.ckpt.manifest")
+    par_dict = load_checkpoint("./delta_compacted.ckpt")
+    assert np.array_equal(par_dict['weight'].data.asnumpy(), weight)
+
+
+def test_save_delta_checkpoint_error_base():
+    parameter_list = [{'name': "weight", 'data': Tensor(np.ones([4, 8]).astype(np.float32))}]
+    save_checkpoint(parameter_list, "./delta_base.ckpt", ckpt_format="NATIVE")
+    with pytest.raises(ValueError):
+        save_checkpoint(parameter_list, "./delta.ckpt", ckpt_format="NATIVE", base_ckpt_file_name="./native.ckpt")
+    with pytest.raises(ValueError):
+        save_checkpoint(parameter_list, "./delta.ckpt", base_ckpt_file_name="./delta_base.ckpt")
+
+
 def test_checkpoint_manager():
     """ test_checkpoint_manager """
     ckp_mgr = _CheckpointManager()
@@ -185,6 +268,40 @@ def test_checkpoint_manager():
         os.remove(_cur_dir + '/time_file1.ckpt')
 
 
+def test_checkpoint_manager_rotation_with_deltas():
+    """ test that the deltas on the oldest checkpoint stay loadable when it is removed """
+    weight = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    parameter_list = [{'name': "weight", 'data': Tensor(weight)}]
+    files = [os.path.realpath(os.path.join(_cur_dir, 'rotation-%d.ckpt' % i)) for i in range(3)]
+    save_checkpoint(parameter_list, files[0], ckpt_format="NATIVE")
+    for i in range(1, 3):
+        save_checkpoint(parameter_list, files[i], ckpt_format="NATIVE", base_ckpt_file_name=files[i - 1])
+    cur_time = int(time.time())
+    for i, file_name in enumerate(files):
+        os.utime(file_name, (cur_time + i, cur_time + i))
+
+    ckp_mgr = _CheckpointManager()
+    ckp_mgr.update_ckpoint_filelist(_cur_dir, "rotation")
+    assert ckp_mgr.ckpoint_num == 3
+    ckp_mgr.remove_oldest_ckpoint_file()
+    ckp_mgr.update_ckpoint_filelist(_cur_dir, "rotation")
+    assert ckp_mgr.ckpoint_num == 2
+    assert not os.path.exists(files[0])
+    # The delta on the removed checkpoint is compacted and keeps its place in the rotation
+    assert not os.path.exists(files[1] + ".manifest")
+    assert os.path.getmtime(files[1]) == cur_time + 1
+    assert os.path.exists(files[2] + ".manifest")
+    for file_name in files[1:]:
+        assert np.array_equal(load_checkpoint(file_name)['weight'].data.asnumpy(), weight)
+
+    ckp_mgr.remove_oldest_ckpoint_file()
+    ckp_mgr.update_ckpoint_filelist(_cur_dir, "rotation")
+    assert ckp_mgr.ckpoint_num == 1
+    assert np.array_equal(load_checkpoint(files[2])['weight'].data.asnumpy(), weight)
+    ckp_mgr.remove_oldest_ckpoint_file()
+    assert not os.path.exists(files[2])
+
+
 def test_load_param_into_net_error_net():
     parameter_dict = {}
     one_param = Parameter(Tensor(np.ones(shape=(64, 3, 7, 7)), dtype=mstype.float32),
@@ -380,7 +497,8 @@ def test_print():
 
 
 def teardown_module():
-    files = ['parameters.ckpt', 'new_ckpt.ckpt', 'empty.ckpt']
+    files = ['parameters.ckpt', 'new_ckpt.ckpt', 'empty.ckpt', 'native.ckpt', 'converted.ckpt', 'converted_proto.ckpt',
+             'delta_base.ckpt', 'delta.ckpt', 'delta.ckpt.manifest', 'delta_compacted.ckpt']
     for item in files:
         file_name = './' + item
         if not os.path.exists(file_name):